@@ -1494,15 +1494,25 @@ ags_bulk_member_real_change_port(AgsBulkMember *bulk_member,
     AgsEffectBulk *effect_bulk;
     AgsTask *task;
 
+    AgsTaskLauncher *task_launcher;
+
     effect_bulk = (AgsEffectBulk *) gtk_widget_get_ancestor(GTK_WIDGET(bulk_member),
 							    AGS_TYPE_EFFECT_BULK);
+
+    task_launcher = ags_concurrency_provider_get_task_launcher(AGS_CONCURRENCY_PROVIDER(application_context));
     
     task = (AgsTask *) g_object_new(bulk_member->task_type,
 				    bulk_member->control_port, port_data,
 				    NULL);
 
-    ags_ui_provider_schedule_task(AGS_UI_PROVIDER(application_context),
-				  task);
+    /* dragging the control only writes the newest value */
+    ags_task_launcher_add_task_coalesced(task_launcher,
+					 task,
+					 bulk_member);
+
+    g_object_unref(task);
+
+    g_object_unref(task_launcher);
   }
 }
 
@@ -21,6 +21,7 @@
 #include <ags/X/ags_effect_bulk_callbacks.h>
 
 #include <ags/X/ags_ui_provider.h>
+#include <ags/X/ags_meter_dispatcher.h>
 #include <ags/X/ags_window.h>
 #include <ags/X/ags_plugin_browser.h>
 #include <ags/X/ags_bulk_member.h>
@@ -1245,9 +1246,9 @@ ags_effect_bulk_add_ladspa_plugin(AgsEffectBulk *effect_bulk,
 	effect_bulk->queued_drawing = g_list_prepend(effect_bulk->queued_drawing,
 						     child_widget);
 
-	g_timeout_add(AGS_UI_PROVIDER_DEFAULT_TIMEOUT * 1000.0,
-		      (GSourceFunc) ags_effect_bulk_indicator_queue_draw_timeout,
-		      (gpointer) child_widget);
+	ags_meter_dispatcher_add(ags_meter_dispatcher_get_instance(),
+				 child_widget,
+				 (GSourceFunc) ags_effect_bulk_indicator_queue_draw_timeout);
       }
 
 #ifdef AGS_DEBUG
@@ -1664,7 +1665,9 @@ ags_effect_bulk_add_dssi_plugin(AgsEffectBulk *effect_bulk,
 			    child_widget, ags_effect_bulk_indicator_queue_draw_timeout);
 	effect_bulk->queued_drawing = g_list_prepend(effect_bulk->queued_drawing,
 						     child_widget);
-	g_timeout_add(AGS_UI_PROVIDER_DEFAULT_TIMEOUT * 1000.0, (GSourceFunc) ags_effect_bulk_indicator_queue_draw_timeout, (gpointer) child_widget);
+	ags_meter_dispatcher_add(ags_meter_dispatcher_get_instance(),
+				 child_widget,
+				 (GSourceFunc) ags_effect_bulk_indicator_queue_draw_timeout);
       }
 
       gtk_table_attach(effect_bulk->table,
@@ -2142,9 +2145,9 @@ ags_effect_bulk_add_lv2_plugin(AgsEffectBulk *effect_bulk,
 	effect_bulk->queued_drawing = g_list_prepend(effect_bulk->queued_drawing,
 						     child_widget);
 
-	g_timeout_add(AGS_UI_PROVIDER_DEFAULT_TIMEOUT * 1000.0,
-		      (GSourceFunc) ags_effect_bulk_indicator_queue_draw_timeout,
-		      (gpointer) child_widget);
+	ags_meter_dispatcher_add(ags_meter_dispatcher_get_instance(),
+				 child_widget,
+				 (GSourceFunc) ags_effect_bulk_indicator_queue_draw_timeout);
       }
 
 #ifdef AGS_DEBUG
@@ -2768,15 +2771,10 @@ ags_effect_bulk_indicator_queue_draw_timeout(GtkWidget *widget)
     val = 0.0;
     
     while(list != NULL){
-      GValue value = {0,};
-
-      g_value_init(&value,
-		   G_TYPE_FLOAT);
-
-      ags_port_safe_read(AGS_BULK_PORT(list->data)->port,
-			 &value);
-
-      val += g_value_get_float(&value);
+      val += ags_meter_dispatcher_read(ags_meter_dispatcher_get_instance(),
+				       widget,
+				       (GObject *) AGS_BULK_PORT(list->data)->port,
+				       AGS_METER_SNAPSHOT_ENTRY_PORT);
       
       list = list->next;
     }
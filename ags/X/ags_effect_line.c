@@ -21,6 +21,7 @@
 #include <ags/X/ags_effect_line_callbacks.h>
 
 #include <ags/X/ags_ui_provider.h>
+#include <ags/X/ags_meter_dispatcher.h>
 #include <ags/X/ags_window.h>
 #include <ags/X/ags_machine.h>
 #include <ags/X/ags_effect_pad.h>
@@ -524,6 +525,8 @@ ags_effect_line_init(AgsEffectLine *effect_line)
 
   effect_line->channel = NULL;
 
+  effect_line->message_subscriber = ags_message_subscriber_alloc((GObject *) effect_line);
+
   effect_line->label = (GtkLabel *) g_object_new(GTK_TYPE_LABEL,
 						 NULL);
   gtk_box_pack_start(GTK_BOX(effect_line),
@@ -676,6 +679,10 @@ ags_effect_line_dispose(GObject *gobject)
   effect_line = AGS_EFFECT_LINE(gobject);
 
   if(effect_line->channel != NULL){
+    ags_message_delivery_unsubscribe(ags_message_delivery_get_instance(),
+				     (GObject *) effect_line->channel,
+				     effect_line->message_subscriber);
+    
     g_object_unref(effect_line->channel);
 
     effect_line->channel = NULL;
@@ -704,6 +711,11 @@ ags_effect_line_finalize(GObject *gobject)
 		      effect_line,
 		      NULL);
 
+  ags_message_delivery_unsubscribe(ags_message_delivery_get_instance(),
+				   NULL,
+				   effect_line->message_subscriber);
+  ags_message_subscriber_free(effect_line->message_subscriber);
+
   /* remove of the queued drawing hash */
   list = effect_line->queued_drawing;
 
@@ -961,6 +973,10 @@ ags_effect_line_real_set_channel(AgsEffectLine *effect_line, AgsChannel *channel
   }
   
   if(effect_line->channel != NULL){    
+    ags_message_delivery_unsubscribe(ags_message_delivery_get_instance(),
+				     (GObject *) effect_line->channel,
+				     effect_line->message_subscriber);
+
     g_object_unref(G_OBJECT(effect_line->channel));
   }
 
@@ -976,6 +992,10 @@ ags_effect_line_real_set_channel(AgsEffectLine *effect_line, AgsChannel *channel
     effect_line->samplerate = channel->samplerate;
     effect_line->buffer_size = channel->buffer_size;
     effect_line->format = channel->format;
+
+    ags_message_delivery_subscribe(ags_message_delivery_get_instance(),
+				   (GObject *) channel,
+				   effect_line->message_subscriber);
   }
   
   effect_line->channel = channel;
@@ -1607,9 +1627,9 @@ ags_effect_line_add_ladspa_plugin(AgsEffectLine *effect_line,
 	effect_line->queued_drawing = g_list_prepend(effect_line->queued_drawing,
 						     child_widget);
 
-	g_timeout_add(AGS_UI_PROVIDER_DEFAULT_TIMEOUT * 1000.0,
-		      (GSourceFunc) ags_effect_line_indicator_queue_draw_timeout,
-		      (gpointer) child_widget);
+	ags_meter_dispatcher_add(ags_meter_dispatcher_get_instance(),
+				 child_widget,
+				 (GSourceFunc) ags_effect_line_indicator_queue_draw_timeout);
       }
 
 #ifdef AGS_DEBUG
@@ -2288,9 +2308,9 @@ ags_effect_line_add_lv2_plugin(AgsEffectLine *effect_line,
 	effect_line->queued_drawing = g_list_prepend(effect_line->queued_drawing,
 						     child_widget);
 	
-	g_timeout_add(AGS_UI_PROVIDER_DEFAULT_TIMEOUT * 1000.0,
-		      (GSourceFunc) ags_effect_line_indicator_queue_draw_timeout,
-		      (gpointer) child_widget);
+	ags_meter_dispatcher_add(ags_meter_dispatcher_get_instance(),
+				 child_widget,
+				 (GSourceFunc) ags_effect_line_indicator_queue_draw_timeout);
       }
 
 #ifdef AGS_DEBUG
@@ -2825,103 +2845,48 @@ ags_effect_line_find_next_grouped(GList *effect_line)
 void
 ags_effect_line_check_message(AgsEffectLine *effect_line)
 {
-  AgsChannel *channel;
-    
-  AgsMessageDelivery *message_delivery;
-
-  GList *start_message_envelope, *message_envelope;
+  AgsMessage *start_message, *message;
 
   if(!AGS_IS_EFFECT_LINE(effect_line)){
     return;
   }
-
-  /* retrieve message */
-  message_delivery = ags_message_delivery_get_instance();
-
-  channel = effect_line->channel;
-	  
-  message_envelope =
-    start_message_envelope = ags_message_delivery_find_sender(message_delivery,
-							      "libgsequencer",
-							      (GObject *) channel);
   
-  while(message_envelope != NULL){
-    xmlNode *root_node;
-
-    root_node = xmlDocGetRootElement(AGS_MESSAGE_ENVELOPE(message_envelope->data)->doc);
-      
-    if(!xmlStrncmp(root_node->name,
-		   "ags-command",
-		   12)){
-      if(!xmlStrncmp(xmlGetProp(root_node,
-				"method"),
-		     "AgsChannel::set-samplerate",
-		     27)){
-	guint samplerate;
-	gint position;
-	  
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "samplerate");
-	samplerate = g_value_get_uint(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
-	/* set samplerate */
-	g_object_set(effect_line,
-		     "samplerate", samplerate,
-		     NULL);
-      }else if(!xmlStrncmp(xmlGetProp(root_node,
-				      "method"),
-			   "AgsChannel::set-buffer-size",
-			   28)){
-	guint buffer_size;
-	gint position;
-	  
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "buffer-size");
-	buffer_size = g_value_get_uint(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
-	/* set buffer size */
-	g_object_set(effect_line,
-		     "buffer-size", buffer_size,
-		     NULL);
-      }else if(!xmlStrncmp(xmlGetProp(root_node,
-				      "method"),
-			   "AgsChannel::set-format",
-			   23)){
-	guint format;
-	gint position;
-	  
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "format");
-	format = g_value_get_uint(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
-	/* set format */
-	g_object_set(effect_line,
-		     "format", format,
-		     NULL);
-      }else if(!xmlStrncmp(xmlGetProp(root_node,
-				      "method"),
-			   "AgsChannel::done",
-			   16)){
-	AgsRecallID *recall_id;
-
-	gint position;
-
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "recall-id");
-	  
-	recall_id = g_value_get_object(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
+  /* drain pending messages of channel */
+  message =
+    start_message = ags_message_subscriber_drain(effect_line->message_subscriber);
+    
+  while(message != NULL){
+    if(message->sender != (GObject *) effect_line->channel){
+      message = message->next;
 
-	/* done */
-	ags_effect_line_done(effect_line,
-			     (GObject *) recall_id);
-      }
+      continue;
     }
     
-    message_envelope = message_envelope->next;
+    if(message->method == g_intern_static_string("AgsChannel::set-samplerate")){
+      /* set samplerate */
+      g_object_set(effect_line,
+		   "samplerate", (guint) message->value[0].uint_value,
+		   NULL);
+    }else if(message->method == g_intern_static_string("AgsChannel::set-buffer-size")){
+      /* set buffer size */
+      g_object_set(effect_line,
+		   "buffer-size", (guint) message->value[0].uint_value,
+		   NULL);
+    }else if(message->method == g_intern_static_string("AgsChannel::set-format")){
+      /* set format */
+      g_object_set(effect_line,
+		   "format", (guint) message->value[0].uint_value,
+		   NULL);
+    }else if(message->method == g_intern_static_string("AgsChannel::done")){
+      /* done */
+      ags_effect_line_done(effect_line,
+			   (GObject *) message->value[0].pointer_value);
+    }
+      
+    message = message->next;
   }
-
-  g_list_free_full(start_message_envelope,
-		   g_object_unref);
+    
+  ags_message_free_all(start_message);
 }
 
 /**
@@ -2968,8 +2933,6 @@ ags_effect_line_indicator_queue_draw_timeout(GtkWidget *widget)
 	gdouble range;
 	gdouble peak;
 	gboolean success;
-	
-	GValue value = {0,};
 
 	GRecMutex *port_mutex;
 	GRecMutex *plugin_port_mutex;
@@ -3049,12 +3012,10 @@ ags_effect_line_indicator_queue_draw_timeout(GtkWidget *widget)
 	range = upper - lower;
       
 	/* play port - read value */
-	g_value_init(&value, G_TYPE_FLOAT);
-	ags_port_safe_read(current,
-			   &value);
-      
-	peak = g_value_get_float(&value);
-	g_value_unset(&value);
+	peak = ags_meter_dispatcher_read(ags_meter_dispatcher_get_instance(),
+					 widget,
+					 (GObject *) current,
+					 AGS_METER_SNAPSHOT_ENTRY_PORT);
 
 	if(line_member->conversion != NULL){
 	  peak = ags_conversion_convert(line_member->conversion,
@@ -3076,12 +3037,10 @@ ags_effect_line_indicator_queue_draw_timeout(GtkWidget *widget)
 	current = line_member->recall_port;
 
 	/* recall port - read value */
-	g_value_init(&value, G_TYPE_FLOAT);
-	ags_port_safe_read(current,
-			   &value);
-      
-	peak = g_value_get_float(&value);
-	g_value_unset(&value);
+	peak = ags_meter_dispatcher_read(ags_meter_dispatcher_get_instance(),
+					 widget,
+					 (GObject *) current,
+					 AGS_METER_SNAPSHOT_ENTRY_PORT);
 
 	if(line_member->conversion != NULL){
 	  peak = ags_conversion_convert(line_member->conversion,
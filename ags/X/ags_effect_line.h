@@ -75,6 +75,8 @@ struct _AgsEffectLine
 
   AgsChannel *channel;
 
+  AgsMessageSubscriber *message_subscriber;
+
   GtkLabel *label;
   GtkToggleButton *group;
   
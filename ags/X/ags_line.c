@@ -21,6 +21,7 @@
 #include <ags/X/ags_line_callbacks.h>
 
 #include <ags/X/ags_ui_provider.h>
+#include <ags/X/ags_meter_dispatcher.h>
 #include <ags/X/ags_window.h>
 #include <ags/X/ags_machine.h>
 #include <ags/X/ags_pad.h>
@@ -545,6 +546,8 @@ ags_line_init(AgsLine *line)
 
   line->channel = NULL;
 
+  line->message_subscriber = ags_message_subscriber_alloc((GObject *) line);
+
   //  gtk_widget_set_can_focus(line,
   //			   TRUE);
 
@@ -738,6 +741,10 @@ ags_line_dispose(GObject *gobject)
 
   /* channel */
   if(line->channel != NULL){
+    ags_message_delivery_unsubscribe(ags_message_delivery_get_instance(),
+				     (GObject *) line->channel,
+				     line->message_subscriber);
+    
     g_object_unref(line->channel);
 
     line->channel = NULL;
@@ -765,6 +772,11 @@ ags_line_finalize(GObject *gobject)
 		      G_CALLBACK(ags_line_check_message_callback),
 		      line,
 		      NULL);
+
+  ags_message_delivery_unsubscribe(ags_message_delivery_get_instance(),
+				   NULL,
+				   line->message_subscriber);
+  ags_message_subscriber_free(line->message_subscriber);
   
   /* remove indicator widget */
   if(line->indicator != NULL){
@@ -1052,6 +1064,10 @@ ags_line_real_set_channel(AgsLine *line, AgsChannel *channel)
   }
   
   if(line->channel != NULL){    
+    ags_message_delivery_unsubscribe(ags_message_delivery_get_instance(),
+				     (GObject *) line->channel,
+				     line->message_subscriber);
+
     g_object_unref(G_OBJECT(line->channel));
   }
 
@@ -1067,6 +1083,10 @@ ags_line_real_set_channel(AgsLine *line, AgsChannel *channel)
     line->samplerate = channel->samplerate;
     line->buffer_size = channel->buffer_size;
     line->format = channel->format;
+
+    ags_message_delivery_subscribe(ags_message_delivery_get_instance(),
+				   (GObject *) channel,
+				   line->message_subscriber);
   }
   
   line->channel = channel;
@@ -1693,9 +1713,9 @@ ags_line_add_ladspa_plugin(AgsLine *line,
 			    child_widget, ags_line_indicator_queue_draw_timeout);
 	line->queued_drawing = g_list_prepend(line->queued_drawing,
 					      child_widget);
-	g_timeout_add(1000 / 30,
-		      (GSourceFunc) ags_line_indicator_queue_draw_timeout,
-		      (gpointer) child_widget);
+	ags_meter_dispatcher_add(ags_meter_dispatcher_get_instance(),
+				 child_widget,
+				 (GSourceFunc) ags_line_indicator_queue_draw_timeout);
       }
       
 #ifdef AGS_DEBUG
@@ -2355,9 +2375,9 @@ ags_line_add_lv2_plugin(AgsLine *line,
 
 	line->queued_drawing = g_list_prepend(line->queued_drawing,
 					      child_widget);
-	g_timeout_add(1000 / 30,
-		      (GSourceFunc) ags_line_indicator_queue_draw_timeout,
-		      (gpointer) child_widget);
+	ags_meter_dispatcher_add(ags_meter_dispatcher_get_instance(),
+				 child_widget,
+				 (GSourceFunc) ags_line_indicator_queue_draw_timeout);
       }
 
 #ifdef AGS_DEBUG
@@ -2894,108 +2914,48 @@ ags_line_find_next_grouped(GList *line)
 void
 ags_line_check_message(AgsLine *line)
 {
-  AgsChannel *channel;
-    
-  AgsMessageDelivery *message_delivery;
-
-  GList *start_message_envelope, *message_envelope;
+  AgsMessage *start_message, *message;
 
-  if(!AGS_LINE(line)){
+  if(!AGS_IS_LINE(line)){
     return;
   }
   
-  /* retrieve message delivery */
-  message_delivery = ags_message_delivery_get_instance();
-
-  channel = line->channel;
-  
-  message_envelope =
-    start_message_envelope = ags_message_delivery_find_sender(message_delivery,
-							      "libgsequencer",
-							      (GObject *) channel);
+  /* drain pending messages of channel */
+  message =
+    start_message = ags_message_subscriber_drain(line->message_subscriber);
     
-  while(message_envelope != NULL){
-    xmlNode *root_node;
+  while(message != NULL){
+    if(message->sender != (GObject *) line->channel){
+      message = message->next;
 
-    root_node = xmlDocGetRootElement(AGS_MESSAGE_ENVELOPE(message_envelope->data)->doc);
-      
-    if(!xmlStrncmp(root_node->name,
-		   "ags-command",
-		   12)){
-      if(!xmlStrncmp(xmlGetProp(root_node,
-				"method"),
-		     "AgsChannel::set-samplerate",
-		     27)){
-	guint samplerate;
-	gint position;
-	  
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "samplerate");
-	samplerate = g_value_get_uint(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
-	/* set samplerate */
-	g_object_set(line,
-		     "samplerate", samplerate,
-		     NULL);
-      }else if(!xmlStrncmp(xmlGetProp(root_node,
-				      "method"),
-			   "AgsChannel::set-buffer-size",
-			   28)){
-	guint buffer_size;
-	gint position;
-	  
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "buffer-size");
-	buffer_size = g_value_get_uint(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
-	/* set buffer size */
-	g_object_set(line,
-		     "buffer-size", buffer_size,
-		     NULL);
-      }else if(!xmlStrncmp(xmlGetProp(root_node,
-				      "method"),
-			   "AgsChannel::set-format",
-			   23)){
-	guint format;
-	gint position;
-	  
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "format");
-	format = g_value_get_uint(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
-	/* set format */
-	g_object_set(line,
-		     "format", format,
-		     NULL);
-      }else if(!xmlStrncmp(xmlGetProp(root_node,
-				      "method"),
-			   "AgsChannel::stop",
-			   18)){
-	GList *recall_id;
-
-	gint sound_scope;
-	gint position;
-
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "recall-id");
-	  
-	recall_id = g_value_get_pointer(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "sound-scope");
-	sound_scope = g_value_get_int(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-	  
-	/* stop */
-	ags_line_stop(line,
-		      recall_id, sound_scope);
-      }
+      continue;
+    }
+    
+    if(message->method == g_intern_static_string("AgsChannel::set-samplerate")){
+      /* set samplerate */
+      g_object_set(line,
+		   "samplerate", (guint) message->value[0].uint_value,
+		   NULL);
+    }else if(message->method == g_intern_static_string("AgsChannel::set-buffer-size")){
+      /* set buffer size */
+      g_object_set(line,
+		   "buffer-size", (guint) message->value[0].uint_value,
+		   NULL);
+    }else if(message->method == g_intern_static_string("AgsChannel::set-format")){
+      /* set format */
+      g_object_set(line,
+		   "format", (guint) message->value[0].uint_value,
+		   NULL);
+    }else if(message->method == g_intern_static_string("AgsChannel::stop")){
+      /* stop */
+      ags_line_stop(line,
+		    message->value[0].pointer_value, (gint) message->value[1].int_value);
     }
       
-    message_envelope = message_envelope->next;
+    message = message->next;
   }
     
-  g_list_free_full(start_message_envelope,
-		   (GDestroyNotify) g_object_unref);
+  ags_message_free_all(start_message);
 }
 
 /**
@@ -3042,8 +3002,6 @@ ags_line_indicator_queue_draw_timeout(GtkWidget *widget)
 	gdouble range;
 	gdouble peak;
 	gboolean success;
-	
-	GValue value = {0,};
 
 	GRecMutex *port_mutex;
 	GRecMutex *plugin_port_mutex;
@@ -3122,12 +3080,10 @@ ags_line_indicator_queue_draw_timeout(GtkWidget *widget)
 	range = upper - lower;
       
 	/* play port - read value */
-	g_value_init(&value, G_TYPE_FLOAT);
-	ags_port_safe_read(current,
-			   &value);
-      
-	peak = g_value_get_float(&value);
-	g_value_unset(&value);
+	peak = ags_meter_dispatcher_read(ags_meter_dispatcher_get_instance(),
+					 widget,
+					 (GObject *) current,
+					 AGS_METER_SNAPSHOT_ENTRY_PORT);
 
 	if(line_member->conversion != NULL){
 	  peak = ags_conversion_convert(line_member->conversion,
@@ -3149,12 +3105,10 @@ ags_line_indicator_queue_draw_timeout(GtkWidget *widget)
 	current = line_member->recall_port;
 
 	/* recall port - read value */
-	g_value_init(&value, G_TYPE_FLOAT);
-	ags_port_safe_read(current,
-			   &value);
-      
-	peak = g_value_get_float(&value);
-	g_value_unset(&value);
+	peak = ags_meter_dispatcher_read(ags_meter_dispatcher_get_instance(),
+					 widget,
+					 (GObject *) current,
+					 AGS_METER_SNAPSHOT_ENTRY_PORT);
 
 	if(line_member->conversion != NULL){
 	  peak = ags_conversion_convert(line_member->conversion,
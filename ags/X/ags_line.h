@@ -74,6 +74,8 @@ struct _AgsLine
   gchar *name;
 
   AgsChannel *channel;
+
+  AgsMessageSubscriber *message_subscriber;
   
   GtkWidget *pad;
 
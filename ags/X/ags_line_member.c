@@ -1502,6 +1502,8 @@ ags_line_member_real_change_port(AgsLineMember *line_member,
 
     AgsTask *task;
 
+    AgsTaskLauncher *task_launcher;
+
     AgsApplicationContext *application_context;
 
     window = (AgsWindow *) gtk_widget_get_ancestor((GtkWidget *) line_member,
@@ -1509,12 +1511,20 @@ ags_line_member_real_change_port(AgsLineMember *line_member,
   
     application_context = ags_application_context_get_instance();
 
+    task_launcher = ags_concurrency_provider_get_task_launcher(AGS_CONCURRENCY_PROVIDER(application_context));
+
     task = (AgsTask *) g_object_new(line_member->task_type,
 				    line_member->control_port, port_data,
 				    NULL);
 
-    ags_ui_provider_schedule_task(AGS_UI_PROVIDER(application_context),
-				  (AgsTask *) task);
+    /* dragging the control only writes the newest value */
+    ags_task_launcher_add_task_coalesced(task_launcher,
+					 task,
+					 line_member);
+
+    g_object_unref(task);
+
+    g_object_unref(task_launcher);
   }
 }
 
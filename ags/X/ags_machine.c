@@ -484,6 +484,11 @@ ags_machine_init(AgsMachine *machine)
   machine->audio->machine_widget = (GObject *) machine;
 
   machine->active_playback = NULL;
+
+  machine->message_subscriber = ags_message_subscriber_alloc((GObject *) machine);
+  ags_message_delivery_subscribe(ags_message_delivery_get_instance(),
+				 (GObject *) machine->audio,
+				 machine->message_subscriber);
   
   /* AgsAudio related forwarded signals */
   g_signal_connect_after(G_OBJECT(machine), "resize-audio-channels",
@@ -737,6 +742,10 @@ ags_machine_set_property(GObject *gobject,
 	GList *pad;
 	GList *list;
 
+	ags_message_delivery_unsubscribe(ags_message_delivery_get_instance(),
+					 (GObject *) machine->audio,
+					 machine->message_subscriber);
+	
 	g_object_unref(G_OBJECT(machine->audio));
 
 	if(audio == NULL){
@@ -767,6 +776,10 @@ ags_machine_set_property(GObject *gobject,
 	g_object_ref(G_OBJECT(audio));
 	machine->audio = audio;
 
+	ags_message_delivery_subscribe(ags_message_delivery_get_instance(),
+				       (GObject *) audio,
+				       machine->message_subscriber);
+
 	if(reset){
 	  AgsChannel *start_input, *start_output;
 	  AgsChannel *input, *next_pad_input, *output, *next_pad_output;
@@ -1137,6 +1150,12 @@ ags_machine_finalize(GObject *gobject)
 		      machine,
 		      NULL);
 
+  /* unsubscribe audio and channels */
+  ags_message_delivery_unsubscribe(ags_message_delivery_get_instance(),
+				   NULL,
+				   machine->message_subscriber);
+  ags_message_subscriber_free(machine->message_subscriber);
+
   g_object_disconnect(gobject,
 		      "any_signal::resize-audio-channels",
 		      G_CALLBACK(ags_machine_resize_audio_channels_callback),
@@ -2212,6 +2231,10 @@ ags_machine_playback_set_active(AgsMachine *machine,
 		 "channel", &channel,
 		 NULL);
 
+    ags_message_delivery_subscribe(ags_message_delivery_get_instance(),
+				   (GObject *) channel,
+				   machine->message_subscriber);
+
     start_channel = ags_start_channel_new(channel,
 					  AGS_SOUND_SCOPE_PLAYBACK);
     g_signal_connect_after(G_OBJECT(start_channel), "launch",
@@ -2258,6 +2281,10 @@ ags_machine_playback_set_active(AgsMachine *machine,
     g_object_get(playback,
 		 "channel", &channel,
 		 NULL);
+
+    ags_message_delivery_unsubscribe(ags_message_delivery_get_instance(),
+				     (GObject *) channel,
+				     machine->message_subscriber);
     
     cancel_channel = ags_cancel_channel_new(channel,
 					    AGS_SOUND_SCOPE_PLAYBACK);
@@ -2942,199 +2969,81 @@ ags_machine_copy_pattern(AgsMachine *machine)
 void
 ags_machine_check_message(AgsMachine *machine)
 {
-  AgsMessageDelivery *message_delivery;
-
-  GList *start_message_envelope, *message_envelope;
-  GList *start_active_playback, *active_playback;
+  AgsMessage *start_message, *message;
+  
+  GList *active_playback;
 
   if(!AGS_IS_MACHINE(machine)){
     return;
   }
 
-  /* retrieve message */
-  message_delivery = ags_message_delivery_get_instance();
-
-  message_envelope =
-    start_message_envelope = ags_message_delivery_find_sender(message_delivery,
-							      "libgsequencer",
-							      (GObject *) machine->audio);
+  /* drain pending messages of audio and active playback channels */
+  message =
+    start_message = ags_message_subscriber_drain(machine->message_subscriber);
   
-  while(message_envelope != NULL){
-    xmlNode *root_node;
-
-    root_node = xmlDocGetRootElement(AGS_MESSAGE_ENVELOPE(message_envelope->data)->doc);
-      
-    if(!xmlStrncmp(root_node->name,
-		   "ags-command",
-		   12)){
-      if(!xmlStrncmp(xmlGetProp(root_node,
-				"method"),
-		     "AgsAudio::set-samplerate",
-		     25)){
-	guint samplerate;
-	gint position;
-	  
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "samplerate");
-	samplerate = g_value_get_uint(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
+  while(message != NULL){
+    if(message->sender == (GObject *) machine->audio){
+      if(message->method == g_intern_static_string("AgsAudio::set-samplerate")){
 	/* set samplerate */
 	g_object_set(machine,
-		     "samplerate", samplerate,
+		     "samplerate", (guint) message->value[0].uint_value,
 		     NULL);
-      }else if(!xmlStrncmp(xmlGetProp(root_node,
-				      "method"),
-			   "AgsAudio::set-buffer-size",
-			   26)){
-	guint buffer_size;
-	gint position;
-	  
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "buffer-size");
-	buffer_size = g_value_get_uint(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
+      }else if(message->method == g_intern_static_string("AgsAudio::set-buffer-size")){
 	/* set buffer size */
 	g_object_set(machine,
-		     "buffer-size", buffer_size,
+		     "buffer-size", (guint) message->value[0].uint_value,
 		     NULL);
-      }else if(!xmlStrncmp(xmlGetProp(root_node,
-				      "method"),
-			   "AgsAudio::set-format",
-			   21)){
-	guint format;
-	gint position;
-	  
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "format");
-	format = g_value_get_uint(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
+      }else if(message->method == g_intern_static_string("AgsAudio::set-format")){
 	/* set format */
 	g_object_set(machine,
-		     "format", format,
+		     "format", (guint) message->value[0].uint_value,
 		     NULL);
-      }else if(!xmlStrncmp(xmlGetProp(root_node,
-				      "method"),
-			   "AgsAudio::set-audio-channels",
-			   29)){
-	guint audio_channels, audio_channels_old;
-	gint position;
-	  
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "audio-channels");
-	audio_channels = g_value_get_uint(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "audio-channels-old");
-	audio_channels_old = g_value_get_uint(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
+      }else if(message->method == g_intern_static_string("AgsAudio::set-audio-channels")){
 	/* resize audio channels */
 	ags_machine_resize_audio_channels(machine,
-					  audio_channels, audio_channels_old);
-      }else if(!xmlStrncmp(xmlGetProp(root_node,
-				      "method"),
-			   "AgsAudio::set-pads",
-			   19)){
-	GType channel_type;
-	  
-	guint pads, pads_old;
-	gint position;
-
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "channel-type");
-	channel_type = g_value_get_ulong(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-	  
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "pads");
-	pads = g_value_get_uint(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "pads-old");
-	pads_old = g_value_get_uint(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
+					  (guint) message->value[0].uint_value, (guint) message->value[1].uint_value);
+      }else if(message->method == g_intern_static_string("AgsAudio::set-pads")){
 	/* resize pads */
 	ags_machine_resize_pads(machine,
-				channel_type,
-				pads, pads_old);
-      }else if(!xmlStrncmp(xmlGetProp(root_node,
-				      "method"),
-			   "AgsAudio::stop",
-			   15)){
-	GList *recall_id;
-
-	gint sound_scope;
-	gint position;
-	  
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "recall-id");
-	recall_id = g_value_get_pointer(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-
-	position = ags_strv_index(AGS_MESSAGE_ENVELOPE(message_envelope->data)->parameter_name,
-				  "sound-scope");
-	sound_scope = g_value_get_int(&(AGS_MESSAGE_ENVELOPE(message_envelope->data)->value[position]));
-	  
+				(GType) message->value[0].uint_value,
+				(guint) message->value[1].uint_value, (guint) message->value[2].uint_value);
+      }else if(message->method == g_intern_static_string("AgsAudio::stop")){
 	/* stop */
 	ags_machine_stop(machine,
-			 recall_id, sound_scope);
+			 message->value[0].pointer_value, (gint) message->value[1].int_value);
       }
-    }
-    
-    message_envelope = message_envelope->next;
-  }
-      
-  g_list_free_full(start_message_envelope,
-		   (GDestroyNotify) g_object_unref);
-
-  /*  */
-  active_playback =
-    start_active_playback = g_list_copy(machine->active_playback);
+    }else if(message->method == g_intern_static_string("AgsChannel::stop")){
+      active_playback = machine->active_playback;
 
-  while(active_playback != NULL){
-    AgsChannel *channel;
-    AgsPlayback *playback;
+      while(active_playback != NULL){
+	AgsChannel *channel;
 
-    playback = active_playback->data;
-    g_object_ref(playback);
-    
-    g_object_get(playback,
-		 "channel", &channel,
-		 NULL);
-    
-    message_envelope =
-      start_message_envelope = ags_message_delivery_find_sender(message_delivery,
-								"libgsequencer",
-								(GObject *) channel);
-
-    while(message_envelope != NULL){
-      xmlNode *root_node;
+	g_object_get(active_playback->data,
+		     "channel", &channel,
+		     NULL);
 
-      root_node = xmlDocGetRootElement(AGS_MESSAGE_ENVELOPE(message_envelope->data)->doc);
-      
-      if(!xmlStrncmp(root_node->name,
-		     "ags-command",
-		     12)){
-	if(!xmlStrncmp(xmlGetProp(root_node,
-				  "method"),
-		       "AgsChannel::stop",
-		       18)){
+	if(message->sender == (GObject *) channel){
+	  g_object_unref(channel);
+	  
 	  ags_machine_playback_set_active(machine,
-					  playback,
+					  active_playback->data,
 					  FALSE);
+
+	  break;
+	}
+
+	if(channel != NULL){
+	  g_object_unref(channel);
 	}
-      }
 	
-      message_envelope = message_envelope->next;
+	active_playback = active_playback->next;
+      }
     }
-      
-    g_list_free_full(start_message_envelope,
-		     (GDestroyNotify) g_object_unref);
-
-    g_object_unref(channel);
-    g_object_unref(playback);
-      
-    active_playback = active_playback->next;
+    
+    message = message->next;
   }
 
-  g_list_free(start_active_playback);
+  ags_message_free_all(start_message);
 }
 
 /**
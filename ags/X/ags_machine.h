@@ -134,6 +134,8 @@ struct _AgsMachine
   AgsAudio *audio;
 
   GList *active_playback;
+
+  AgsMessageSubscriber *message_subscriber;
   
   GtkToggleButton *play;
 
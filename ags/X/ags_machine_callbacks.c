@@ -168,11 +168,22 @@ ags_machine_popup_hide_activate_callback(GtkWidget *widget, AgsMachine *machine)
 void
 ags_machine_popup_show_activate_callback(GtkWidget *widget, AgsMachine *machine)
 {
+  GtkWidget *child;
+  
   GList *start_list;
 
   start_list = gtk_container_get_children((GtkContainer *) machine);  
 
-  gtk_widget_show(gtk_bin_get_child(GTK_BIN(start_list->data)));
+  child = gtk_bin_get_child(GTK_BIN(start_list->data));
+  
+  if(gtk_widget_get_no_show_all(child)){
+    /* deferred by ags_simple_file_read_machine() */
+    gtk_widget_set_no_show_all(child,
+			       FALSE);
+    gtk_widget_show_all(child);
+  }else{
+    gtk_widget_show(child);
+  }
 
   g_list_free(start_list);
 }
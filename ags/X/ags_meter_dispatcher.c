@@ -0,0 +1,521 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/X/ags_meter_dispatcher.h>
+
+void ags_meter_dispatcher_class_init(AgsMeterDispatcherClass *meter_dispatcher);
+void ags_meter_dispatcher_init (AgsMeterDispatcher *meter_dispatcher);
+void ags_meter_dispatcher_finalize(GObject *gobject);
+
+void ags_meter_dispatcher_registration_free(AgsMeterDispatcherRegistration *registration);
+
+guint ags_meter_dispatcher_slot_key_hash(gconstpointer key);
+gboolean ags_meter_dispatcher_slot_key_equal(gconstpointer a,
+					     gconstpointer b);
+
+void ags_meter_dispatcher_widget_destroy_callback(GtkWidget *widget,
+						  AgsMeterDispatcher *meter_dispatcher);
+gboolean ags_meter_dispatcher_tick_callback(GtkWidget *widget,
+					    GdkFrameClock *frame_clock,
+					    AgsMeterDispatcher *meter_dispatcher);
+
+/**
+ * SECTION:ags_meter_dispatcher
+ * @short_description: frame clocked meter dispatcher
+ * @title: AgsMeterDispatcher
+ * @section_id:
+ * @include: ags/X/ags_meter_dispatcher.h
+ *
+ * #AgsMeterDispatcher is a singleton driven by the frame clock of the main
+ * window. Per frame it fans out the most recent #AgsMeterSnapshot to the
+ * registered widgets that are mapped, instead of every indicator installing
+ * its own timeout.
+ */
+
+static gpointer ags_meter_dispatcher_parent_class = NULL;
+
+AgsMeterDispatcher *ags_meter_dispatcher = NULL;
+
+GType
+ags_meter_dispatcher_get_type (void)
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_meter_dispatcher = 0;
+
+    static const GTypeInfo ags_meter_dispatcher_info = {
+      sizeof (AgsMeterDispatcherClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_meter_dispatcher_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof (AgsMeterDispatcher),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_meter_dispatcher_init,
+    };
+
+    ags_type_meter_dispatcher = g_type_register_static(G_TYPE_OBJECT,
+						       "AgsMeterDispatcher",
+						       &ags_meter_dispatcher_info,
+						       0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_meter_dispatcher);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_meter_dispatcher_class_init(AgsMeterDispatcherClass *meter_dispatcher)
+{
+  GObjectClass *gobject;
+
+  ags_meter_dispatcher_parent_class = g_type_class_peek_parent(meter_dispatcher);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) meter_dispatcher;
+
+  gobject->finalize = ags_meter_dispatcher_finalize;
+}
+
+void
+ags_meter_dispatcher_init(AgsMeterDispatcher *meter_dispatcher)
+{
+  meter_dispatcher->flags = 0;
+
+  meter_dispatcher->widget = NULL;
+  meter_dispatcher->tick_id = 0;
+
+  meter_dispatcher->last_generation = 0;
+
+  meter_dispatcher->registration = NULL;
+  meter_dispatcher->lookup = g_hash_table_new(g_direct_hash,
+					      g_direct_equal);
+
+  meter_dispatcher->removed = NULL;
+}
+
+void
+ags_meter_dispatcher_finalize(GObject *gobject)
+{
+  AgsMeterDispatcher *meter_dispatcher;
+
+  meter_dispatcher = AGS_METER_DISPATCHER(gobject);
+
+  if(meter_dispatcher->widget != NULL &&
+     meter_dispatcher->tick_id != 0){
+    gtk_widget_remove_tick_callback(meter_dispatcher->widget,
+				    meter_dispatcher->tick_id);
+  }
+
+  while(meter_dispatcher->registration != NULL){
+    ags_meter_dispatcher_remove(meter_dispatcher,
+				((AgsMeterDispatcherRegistration *) meter_dispatcher->registration->data)->widget);
+  }
+
+  g_hash_table_destroy(meter_dispatcher->lookup);
+
+  g_list_free_full(meter_dispatcher->removed,
+		   (GDestroyNotify) ags_meter_dispatcher_registration_free);
+
+  /* singleton */
+  if(meter_dispatcher == ags_meter_dispatcher){
+    ags_meter_dispatcher = NULL;
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_meter_dispatcher_parent_class)->finalize(gobject);
+}
+
+void
+ags_meter_dispatcher_registration_free(AgsMeterDispatcherRegistration *registration)
+{
+  if(registration == NULL){
+    return;
+  }
+
+  g_hash_table_destroy(registration->slot);
+
+  g_free(registration);
+}
+
+guint
+ags_meter_dispatcher_slot_key_hash(gconstpointer key)
+{
+  return(g_direct_hash(AGS_METER_DISPATCHER_SLOT_KEY(key)->source) ^ (31 * AGS_METER_DISPATCHER_SLOT_KEY(key)->entry_type));
+}
+
+gboolean
+ags_meter_dispatcher_slot_key_equal(gconstpointer a,
+				    gconstpointer b)
+{
+  return((AGS_METER_DISPATCHER_SLOT_KEY(a)->source == AGS_METER_DISPATCHER_SLOT_KEY(b)->source &&
+	  AGS_METER_DISPATCHER_SLOT_KEY(a)->entry_type == AGS_METER_DISPATCHER_SLOT_KEY(b)->entry_type) ? TRUE: FALSE);
+}
+
+void
+ags_meter_dispatcher_widget_destroy_callback(GtkWidget *widget,
+					     AgsMeterDispatcher *meter_dispatcher)
+{
+  ags_meter_dispatcher_remove(meter_dispatcher,
+			      widget);
+}
+
+gboolean
+ags_meter_dispatcher_tick_callback(GtkWidget *widget,
+				   GdkFrameClock *frame_clock,
+				   AgsMeterDispatcher *meter_dispatcher)
+{
+  AgsMeterDispatcherRegistration *registration;
+
+  GList *start_list, *list;
+
+  guint generation;
+
+  /* nothing new published since last frame */
+  generation = ags_meter_snapshot_get_generation(ags_meter_snapshot_get_instance());
+
+  if(generation == meter_dispatcher->last_generation){
+    return(G_SOURCE_CONTINUE);
+  }
+
+  meter_dispatcher->last_generation = generation;
+
+  /* fan out to mapped widgets */
+  meter_dispatcher->flags |= AGS_METER_DISPATCHER_DISPATCHING;
+
+  list =
+    start_list = g_list_copy(meter_dispatcher->registration);
+
+  while(list != NULL){
+    registration = list->data;
+
+    if(!registration->removed &&
+       gtk_widget_get_mapped(registration->widget)){
+      if(!registration->func(registration->widget)){
+	ags_meter_dispatcher_remove(meter_dispatcher,
+				    registration->widget);
+      }
+    }
+
+    list = list->next;
+  }
+
+  g_list_free(start_list);
+
+  meter_dispatcher->flags &= (~AGS_METER_DISPATCHER_DISPATCHING);
+
+  /* free registrations removed during dispatching */
+  g_list_free_full(meter_dispatcher->removed,
+		   (GDestroyNotify) ags_meter_dispatcher_registration_free);
+
+  meter_dispatcher->removed = NULL;
+
+  return(G_SOURCE_CONTINUE);
+}
+
+/**
+ * ags_meter_dispatcher_attach:
+ * @meter_dispatcher: the #AgsMeterDispatcher
+ * @widget: the #GtkWidget providing the frame clock
+ *
+ * Attach @meter_dispatcher to the frame clock of @widget.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_meter_dispatcher_attach(AgsMeterDispatcher *meter_dispatcher,
+			    GtkWidget *widget)
+{
+  if(!AGS_IS_METER_DISPATCHER(meter_dispatcher) ||
+     !GTK_IS_WIDGET(widget)){
+    return;
+  }
+
+  if(meter_dispatcher->widget != NULL){
+    gtk_widget_remove_tick_callback(meter_dispatcher->widget,
+				    meter_dispatcher->tick_id);
+  }
+
+  meter_dispatcher->widget = widget;
+  meter_dispatcher->tick_id = gtk_widget_add_tick_callback(widget,
+							   (GtkTickCallback) ags_meter_dispatcher_tick_callback,
+							   meter_dispatcher,
+							   NULL);
+}
+
+/**
+ * ags_meter_dispatcher_add:
+ * @meter_dispatcher: the #AgsMeterDispatcher
+ * @widget: the #GtkWidget
+ * @func: the #GSourceFunc to invoke with @widget per frame
+ *
+ * Add @widget to @meter_dispatcher. @func is invoked with @widget for every frame
+ * a new snapshot was published and @widget is mapped. As with g_timeout_add() the
+ * registration is removed as soon as @func returns %FALSE, it is removed as well
+ * if @widget is destroyed.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_meter_dispatcher_add(AgsMeterDispatcher *meter_dispatcher,
+			 GtkWidget *widget,
+			 GSourceFunc func)
+{
+  AgsMeterDispatcherRegistration *registration;
+
+  if(!AGS_IS_METER_DISPATCHER(meter_dispatcher) ||
+     !GTK_IS_WIDGET(widget) ||
+     func == NULL){
+    return;
+  }
+
+  registration = g_hash_table_lookup(meter_dispatcher->lookup,
+				     widget);
+
+  if(registration != NULL){
+    registration->func = func;
+
+    return;
+  }
+
+  registration = (AgsMeterDispatcherRegistration *) g_malloc(sizeof(AgsMeterDispatcherRegistration));
+
+  registration->widget = widget;
+  registration->func = func;
+
+  registration->handler = g_signal_connect(widget, "destroy",
+					   G_CALLBACK(ags_meter_dispatcher_widget_destroy_callback), meter_dispatcher);
+
+  registration->slot = g_hash_table_new_full(ags_meter_dispatcher_slot_key_hash,
+					     ags_meter_dispatcher_slot_key_equal,
+					     g_free,
+					     NULL);
+
+  registration->removed = FALSE;
+
+  meter_dispatcher->registration = g_list_prepend(meter_dispatcher->registration,
+						  registration);
+  g_hash_table_insert(meter_dispatcher->lookup,
+		      widget,
+		      registration);
+}
+
+/**
+ * ags_meter_dispatcher_remove:
+ * @meter_dispatcher: the #AgsMeterDispatcher
+ * @widget: the #GtkWidget
+ *
+ * Remove @widget from @meter_dispatcher and unsubscribe its snapshot slots.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_meter_dispatcher_remove(AgsMeterDispatcher *meter_dispatcher,
+			    GtkWidget *widget)
+{
+  AgsMeterSnapshot *meter_snapshot;
+  AgsMeterDispatcherRegistration *registration;
+
+  GHashTableIter iter;
+  gpointer slot;
+
+  if(!AGS_IS_METER_DISPATCHER(meter_dispatcher)){
+    return;
+  }
+
+  registration = g_hash_table_lookup(meter_dispatcher->lookup,
+				     widget);
+
+  if(registration == NULL){
+    return;
+  }
+
+  meter_snapshot = ags_meter_snapshot_get_instance();
+
+  g_hash_table_remove(meter_dispatcher->lookup,
+		      widget);
+  meter_dispatcher->registration = g_list_remove(meter_dispatcher->registration,
+						 registration);
+
+  g_signal_handler_disconnect(widget,
+			      registration->handler);
+
+  /* unsubscribe */
+  g_hash_table_iter_init(&iter,
+			 registration->slot);
+
+  while(g_hash_table_iter_next(&iter, NULL, &slot)){
+    ags_meter_snapshot_unsubscribe(meter_snapshot,
+				   GPOINTER_TO_UINT(slot) - 1);
+  }
+
+  g_hash_table_remove_all(registration->slot);
+
+  registration->removed = TRUE;
+
+  if((AGS_METER_DISPATCHER_DISPATCHING & (meter_dispatcher->flags)) != 0){
+    meter_dispatcher->removed = g_list_prepend(meter_dispatcher->removed,
+					       registration);
+  }else{
+    ags_meter_dispatcher_registration_free(registration);
+  }
+}
+
+/**
+ * ags_meter_dispatcher_read:
+ * @meter_dispatcher: the #AgsMeterDispatcher
+ * @widget: the registered #GtkWidget
+ * @source: the source #GObject
+ * @entry_type: the #AgsMeterSnapshotEntryType-enum
+ *
+ * Read the published value of @source on behalf of @widget. The source is
+ * subscribed on first use and unsubscribed as @widget is removed. It falls
+ * back to reading @source directly if @widget is not registered.
+ *
+ * Returns: the value
+ *
+ * Since: 3.5.0
+ */
+gdouble
+ags_meter_dispatcher_read(AgsMeterDispatcher *meter_dispatcher,
+			  GtkWidget *widget,
+			  GObject *source,
+			  guint entry_type)
+{
+  AgsMeterSnapshot *meter_snapshot;
+  AgsMeterDispatcherRegistration *registration;
+
+  AgsMeterDispatcherSlotKey key;
+  
+  gpointer ptr;
+
+  guint slot;
+
+  if(source == NULL){
+    return(0.0);
+  }
+
+  meter_snapshot = ags_meter_snapshot_get_instance();
+
+  registration = NULL;
+
+  if(AGS_IS_METER_DISPATCHER(meter_dispatcher)){
+    registration = g_hash_table_lookup(meter_dispatcher->lookup,
+				       widget);
+  }
+
+  if(registration == NULL){
+    /* not dispatched - read directly */
+    if(entry_type == AGS_METER_SNAPSHOT_ENTRY_PORT &&
+       AGS_IS_PORT(source)){
+      gdouble value;
+
+      GValue port_value = {0,};
+
+      g_value_init(&port_value, G_TYPE_FLOAT);
+      ags_port_safe_read((AgsPort *) source,
+			 &port_value);
+
+      value = g_value_get_float(&port_value);
+      g_value_unset(&port_value);
+
+      return(value);
+    }else if(entry_type == AGS_METER_SNAPSHOT_ENTRY_SOUNDCARD &&
+	     AGS_IS_SOUNDCARD(source)){
+      return((gdouble) ags_soundcard_get_note_offset(AGS_SOUNDCARD(source)));
+    }
+
+    return(0.0);
+  }
+
+  /* the same source might be read as different entry types */
+  key.source = source;
+  key.entry_type = entry_type;
+  
+  ptr = g_hash_table_lookup(registration->slot,
+			    &key);
+
+  if(ptr == NULL){
+    AgsMeterDispatcherSlotKey *slot_key;
+    
+    slot = ags_meter_snapshot_subscribe(meter_snapshot,
+					source,
+					entry_type);
+
+    if(slot == AGS_METER_SNAPSHOT_INVALID_SLOT){
+      return(0.0);
+    }
+
+    slot_key = (AgsMeterDispatcherSlotKey *) g_malloc(sizeof(AgsMeterDispatcherSlotKey));
+
+    slot_key->source = source;
+    slot_key->entry_type = entry_type;
+    
+    g_hash_table_insert(registration->slot,
+			slot_key,
+			GUINT_TO_POINTER(slot + 1));
+  }else{
+    slot = GPOINTER_TO_UINT(ptr) - 1;
+  }
+
+  return(ags_meter_snapshot_read(meter_snapshot,
+				 slot));
+}
+
+/**
+ * ags_meter_dispatcher_get_instance:
+ *
+ * Get instance.
+ *
+ * Returns: (transfer none): the #AgsMeterDispatcher
+ *
+ * Since: 3.5.0
+ */
+AgsMeterDispatcher*
+ags_meter_dispatcher_get_instance()
+{
+  if(ags_meter_dispatcher == NULL){
+    ags_meter_dispatcher = ags_meter_dispatcher_new();
+  }
+
+  return(ags_meter_dispatcher);
+}
+
+/**
+ * ags_meter_dispatcher_new:
+ *
+ * Create a new instance of #AgsMeterDispatcher
+ *
+ * Returns: the new #AgsMeterDispatcher
+ *
+ * Since: 3.5.0
+ */
+AgsMeterDispatcher*
+ags_meter_dispatcher_new()
+{
+  AgsMeterDispatcher *meter_dispatcher;
+
+  meter_dispatcher = (AgsMeterDispatcher *) g_object_new(AGS_TYPE_METER_DISPATCHER,
+							 NULL);
+
+  return(meter_dispatcher);
+}
@@ -0,0 +1,136 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_METER_DISPATCHER_H__
+#define __AGS_METER_DISPATCHER_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <gtk/gtk.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_METER_DISPATCHER                (ags_meter_dispatcher_get_type())
+#define AGS_METER_DISPATCHER(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_METER_DISPATCHER, AgsMeterDispatcher))
+#define AGS_METER_DISPATCHER_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_METER_DISPATCHER, AgsMeterDispatcherClass))
+#define AGS_IS_METER_DISPATCHER(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_METER_DISPATCHER))
+#define AGS_IS_METER_DISPATCHER_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_METER_DISPATCHER))
+#define AGS_METER_DISPATCHER_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_METER_DISPATCHER, AgsMeterDispatcherClass))
+
+typedef struct _AgsMeterDispatcher AgsMeterDispatcher;
+typedef struct _AgsMeterDispatcherClass AgsMeterDispatcherClass;
+typedef struct _AgsMeterDispatcherRegistration AgsMeterDispatcherRegistration;
+typedef struct _AgsMeterDispatcherSlotKey AgsMeterDispatcherSlotKey;
+
+#define AGS_METER_DISPATCHER_SLOT_KEY(ptr) ((AgsMeterDispatcherSlotKey *)(ptr))
+
+/**
+ * AgsMeterDispatcherFlags:
+ * @AGS_METER_DISPATCHER_DISPATCHING: the dispatcher is currently fanning out a frame
+ *
+ * Enum values to control the behavior or indicate internal state of #AgsMeterDispatcher by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_METER_DISPATCHER_DISPATCHING   = 1,
+}AgsMeterDispatcherFlags;
+
+/**
+ * AgsMeterDispatcherRegistration:
+ * @widget: the #GtkWidget
+ * @func: the #GSourceFunc to invoke with @widget
+ * @handler: the destroy handler id
+ * @slot: the subscribed #AgsMeterSnapshot slots of @widget keyed by #AgsMeterDispatcherSlotKey
+ * @removed: %TRUE if removed during dispatching
+ *
+ * #AgsMeterDispatcherRegistration holds a widget to be updated per frame.
+ */
+struct _AgsMeterDispatcherRegistration
+{
+  GtkWidget *widget;
+  GSourceFunc func;
+
+  gulong handler;
+
+  GHashTable *slot;
+
+  gboolean removed;
+};
+
+/**
+ * AgsMeterDispatcherSlotKey:
+ * @source: the #GObject read
+ * @entry_type: the #AgsMeterSnapshotEntryType read
+ *
+ * #AgsMeterDispatcherSlotKey identifies a subscribed #AgsMeterSnapshot slot.
+ */
+struct _AgsMeterDispatcherSlotKey
+{
+  GObject *source;
+  guint entry_type;
+};
+
+struct _AgsMeterDispatcher
+{
+  GObject gobject;
+
+  guint flags;
+
+  GtkWidget *widget;
+  guint tick_id;
+
+  guint last_generation;
+
+  GList *registration;
+  GHashTable *lookup;
+
+  GList *removed;
+};
+
+struct _AgsMeterDispatcherClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_meter_dispatcher_get_type(void);
+
+void ags_meter_dispatcher_attach(AgsMeterDispatcher *meter_dispatcher,
+				 GtkWidget *widget);
+
+void ags_meter_dispatcher_add(AgsMeterDispatcher *meter_dispatcher,
+			      GtkWidget *widget,
+			      GSourceFunc func);
+void ags_meter_dispatcher_remove(AgsMeterDispatcher *meter_dispatcher,
+				 GtkWidget *widget);
+
+gdouble ags_meter_dispatcher_read(AgsMeterDispatcher *meter_dispatcher,
+				  GtkWidget *widget,
+				  GObject *source,
+				  guint entry_type);
+
+AgsMeterDispatcher* ags_meter_dispatcher_get_instance();
+AgsMeterDispatcher* ags_meter_dispatcher_new();
+
+G_END_DECLS
+
+#endif /*__AGS_METER_DISPATCHER_H__*/
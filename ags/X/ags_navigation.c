@@ -21,6 +21,7 @@
 #include <ags/X/ags_navigation_callbacks.h>
 
 #include <ags/X/ags_ui_provider.h>
+#include <ags/X/ags_meter_dispatcher.h>
 #include <ags/X/ags_window.h>
 #include <ags/X/ags_notation_editor.h>
 
@@ -261,7 +262,9 @@ ags_navigation_init(AgsNavigation *navigation)
 	       "label", "0000:00.000",
 	       NULL);
   gtk_box_pack_start((GtkBox *) hbox, (GtkWidget *) navigation->duration_time, FALSE, FALSE, 2);
-  g_timeout_add((guint) floor(AGS_UI_PROVIDER_DEFAULT_TIMEOUT * 1000.0), (GSourceFunc) ags_navigation_duration_time_queue_draw, (gpointer) navigation);
+  ags_meter_dispatcher_add(ags_meter_dispatcher_get_instance(),
+			   (GtkWidget *) navigation,
+			   (GSourceFunc) ags_navigation_duration_time_queue_draw);
 
   navigation->duration_tact = NULL;
   //  navigation->duration_tact = (GtkSpinButton *) gtk_spin_button_new_with_range(0.0, AGS_NOTATION_EDITOR_MAX_CONTROLS, 1.0);
@@ -833,6 +836,8 @@ ags_navigation_duration_time_queue_draw(GtkWidget *widget)
 
   gchar *str;
 
+  gdouble note_offset;
+  
   navigation = AGS_NAVIGATION(widget);
 
   application_context = ags_application_context_get_instance();
@@ -840,6 +845,18 @@ ags_navigation_duration_time_queue_draw(GtkWidget *widget)
   default_soundcard = ags_sound_provider_get_default_soundcard(AGS_SOUND_PROVIDER(application_context));
 
   if(default_soundcard != NULL){
+    /* playback position - published by the engine once per period */
+    note_offset = ags_meter_dispatcher_read(ags_meter_dispatcher_get_instance(),
+					    widget,
+					    default_soundcard,
+					    AGS_METER_SNAPSHOT_ENTRY_SOUNDCARD);
+
+    if(note_offset == navigation->note_offset){
+      return(TRUE);
+    }
+
+    navigation->note_offset = note_offset;
+    
     str = ags_soundcard_get_uptime(AGS_SOUNDCARD(default_soundcard));
     
     g_object_set(navigation->duration_time,
@@ -65,16 +65,25 @@ ags_navigation_bpm_callback(GtkWidget *widget,
 {
   AgsApplyBpm *apply_bpm;
 
+  AgsTaskLauncher *task_launcher;
+
   AgsApplicationContext *application_context;
   
   application_context = ags_application_context_get_instance();
 
-  /* get task thread */
+  task_launcher = ags_concurrency_provider_get_task_launcher(AGS_CONCURRENCY_PROVIDER(application_context));
+
+  /* spinning the bpm only applies the newest value */
   apply_bpm = ags_apply_bpm_new(application_context,
 				gtk_spin_button_get_value(navigation->bpm));
   
-  ags_ui_provider_schedule_task(AGS_UI_PROVIDER(application_context),
-				(AgsTask *) apply_bpm);
+  ags_task_launcher_add_task_coalesced(task_launcher,
+				       (AgsTask *) apply_bpm,
+				       application_context);
+
+  g_object_unref(apply_bpm);
+
+  g_object_unref(task_launcher);
 }
 
 void
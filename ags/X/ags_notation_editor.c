@@ -751,6 +751,8 @@ ags_notation_editor_add_note(AgsNotationEditor *notation_editor,
 			    new_note,
 			    FALSE);
 
+      ags_notation_update_snapshot(notation);
+
       g_list_free_full(start_list_notation,
 		       g_object_unref);
 
@@ -820,6 +822,8 @@ ags_notation_editor_delete_note(AgsNotationEditor *notation_editor,
 	notation = list_notation->data;
 	ags_notation_remove_note_at_position(notation,
 					     x, y);
+
+	ags_notation_update_snapshot(notation);
       }
 
       g_list_free_full(start_list_notation,
@@ -1442,6 +1446,8 @@ ags_notation_editor_paste_notation_all(AgsNotationEditor *notation_editor,
 						  TRUE, position_x,
 						  TRUE, position_y,
 						  match_channel, no_duplicates);
+
+      ags_notation_update_snapshot(notation);
 		    
       /* get boundaries */
       child = notation_node->children;
@@ -1495,6 +1501,8 @@ ags_notation_editor_paste_notation_all(AgsNotationEditor *notation_editor,
 					 FALSE, 0,
 					 FALSE, 0);
 
+      ags_notation_update_snapshot(notation);
+
       /* get boundaries */
       child = notation_node->children;
       current_x = 0;
@@ -1913,6 +1921,8 @@ ags_notation_editor_cut(AgsNotationEditor *notation_editor)
 	notation_node = ags_notation_cut_selection(AGS_NOTATION(list_notation->data));
 	xmlAddChild(notation_list_node,
 		    notation_node);
+
+	ags_notation_update_snapshot(list_notation->data);
 	
 	list_notation = list_notation->next;
       }
@@ -81,10 +81,11 @@ ags_pad_mute_clicked_callback(GtkWidget *widget, AgsPad *pad)
 
   AgsSetMuted *set_muted;
 
+  AgsTaskLauncher *task_launcher;
+
   AgsApplicationContext *application_context;
 
   GList *list, *list_start;
-  GList *start_task;
 
   gboolean is_output;
 
@@ -93,8 +94,7 @@ ags_pad_mute_clicked_callback(GtkWidget *widget, AgsPad *pad)
   
   application_context = ags_application_context_get_instance();
 
-  /*  */
-  start_task = NULL;
+  task_launcher = ags_concurrency_provider_get_task_launcher(AGS_CONCURRENCY_PROVIDER(application_context));
 
   if(gtk_toggle_button_get_active(pad->mute)){
     if(gtk_toggle_button_get_active(pad->solo)){
@@ -113,11 +113,13 @@ ags_pad_mute_clicked_callback(GtkWidget *widget, AgsPad *pad)
     next_current = NULL;
     
     while(current != next_pad){
-      /* instantiate set muted task */
+      /* instantiate set muted task, toggling repeatedly only applies the newest */
       set_muted = ags_set_muted_new((GObject *) current,
 				    TRUE);
-      start_task = g_list_prepend(start_task,
-				  set_muted);
+      ags_task_launcher_add_task_coalesced(task_launcher,
+					   (AgsTask *) set_muted,
+					   current);
+      g_object_unref(set_muted);
 
       /* iterate */
       next_current = ags_channel_next(current);
@@ -166,11 +168,13 @@ ags_pad_mute_clicked_callback(GtkWidget *widget, AgsPad *pad)
     next_current = NULL;
     
     while(current != next_pad){
-      /* instantiate set muted task */
+      /* instantiate set muted task, toggling repeatedly only applies the newest */
       set_muted = ags_set_muted_new((GObject *) current,
 				    FALSE);
-      start_task = g_list_prepend(start_task,
-				  set_muted);
+      ags_task_launcher_add_task_coalesced(task_launcher,
+					   (AgsTask *) set_muted,
+					   current);
+      g_object_unref(set_muted);
       
       /* iterate */
       next_current = ags_channel_next(current);
@@ -189,8 +193,7 @@ ags_pad_mute_clicked_callback(GtkWidget *widget, AgsPad *pad)
     }
   }
 
-  ags_ui_provider_schedule_task_all(AGS_UI_PROVIDER(application_context),
-				    start_task);
+  g_object_unref(task_launcher);
 }
 
 void
@@ -27,6 +27,7 @@
 #endif
 
 #include <ags/X/ags_ui_provider.h>
+#include <ags/X/ags_meter_dispatcher.h>
 
 #include <ags/X/machine/ags_panel.h>
 #include <ags/X/machine/ags_mixer.h>
@@ -191,6 +192,10 @@ ags_window_init(AgsWindow *window)
   g_signal_connect(application_context, "setup-completed",
 		   G_CALLBACK(ags_window_setup_completed_callback), window);
 
+  /* meters are fanned out by the frame clock of the main window */
+  ags_meter_dispatcher_attach(ags_meter_dispatcher_get_instance(),
+			      (GtkWidget *) window);
+
   error = NULL;
 
   str = g_strdup_printf("%s%s", DESTDIR, "/gsequencer/icons/jumper.png");
@@ -2189,6 +2189,9 @@ ags_xorg_application_context_clean_message(AgsUiProvider *ui_provider)
 									"libgsequencer");
 
   while(message_queue != NULL){
+    /* pending messages are dropped without creating their envelope */
+    ags_message_queue_discard_message(message_queue->data);
+    
     message_queue_mutex = AGS_MESSAGE_QUEUE_GET_OBJ_MUTEX(message_queue->data);
 
     g_rec_mutex_lock(message_queue_mutex);
@@ -2903,6 +2906,13 @@ ags_xorg_application_context_setup(AgsApplicationContext *application_context)
 
   task_launcher = ags_concurrency_provider_get_task_launcher(AGS_CONCURRENCY_PROVIDER(application_context));
 
+  /* timing monitor */
+#ifndef AGS_W32API
+  ags_timing_monitor_dump_on_signal(ags_timing_monitor_get_instance(),
+				    SIGUSR2,
+				    NULL);
+#endif
+
   /* signals */
   atexit(ags_xorg_application_context_signal_cleanup);
 
@@ -2266,7 +2266,9 @@ ags_automation_edit_draw_automation(AgsAutomationEdit *automation_edit, cairo_t
   gchar *control_name;
 
   gdouble opacity;
+  gdouble zoom_factor;
   guint x0, x1;
+  guint viewport_x0, viewport_x1;
   guint offset;
   guint line;
   gint i;    
@@ -2301,6 +2303,18 @@ ags_automation_edit_draw_automation(AgsAutomationEdit *automation_edit, cairo_t
   x0 = gtk_range_get_value(GTK_RANGE(automation_edit->hscrollbar));
   x1 = (gtk_range_get_value(GTK_RANGE(automation_edit->hscrollbar)) + allocation.width);
 
+  /* zoom */
+  zoom_factor = exp2(6.0 - (double) gtk_combo_box_get_active((GtkComboBox *) automation_editor->automation_toolbar->zoom));
+
+  /* visible region in acceleration x, see ags_automation_edit_draw_acceleration() */
+  if(AGS_AUTOMATION_EDITOR_MAX_CONTROLS > allocation.width){
+    viewport_x0 = (guint) (zoom_factor * gtk_range_get_value(GTK_RANGE(automation_edit->hscrollbar)));
+  }else{
+    viewport_x0 = 0;
+  }
+
+  viewport_x1 = viewport_x0 + (guint) (zoom_factor * (gdouble) allocation.width);
+  
   /* draw automation */
   timestamp = ags_timestamp_new();
 
@@ -2327,6 +2341,8 @@ ags_automation_edit_draw_automation(AgsAutomationEdit *automation_edit, cairo_t
 
       GList *start_list_acceleration, *list_acceleration;
 
+      GRecMutex *automation_mutex;
+
       automation = AGS_AUTOMATION(list_automation->data);
 
       g_object_get(automation,
@@ -2358,9 +2374,37 @@ ags_automation_edit_draw_automation(AgsAutomationEdit *automation_edit, cairo_t
 	continue;
       }
 
-      g_object_get(automation,
-		   "acceleration", &start_list_acceleration,
-		   NULL);
+      /* cull by range, the accelerations are sorted by x */
+      automation_mutex = AGS_AUTOMATION_GET_OBJ_MUTEX(automation);
+
+      g_rec_mutex_lock(automation_mutex);
+
+      start_list_acceleration = NULL;
+      
+      list_acceleration = automation->acceleration;
+
+      while(list_acceleration != NULL){
+	if(list_acceleration->next != NULL &&
+	   AGS_ACCELERATION(list_acceleration->next->data)->x < viewport_x0){
+	  list_acceleration = list_acceleration->next;
+
+	  continue;
+	}
+
+	start_list_acceleration = g_list_prepend(start_list_acceleration,
+						 g_object_ref(list_acceleration->data));
+
+	/* the first beyond the visible region completes the area of the one before */
+	if(AGS_ACCELERATION(list_acceleration->data)->x > viewport_x1){
+	  break;
+	}
+	
+	list_acceleration = list_acceleration->next;
+      }
+
+      g_rec_mutex_unlock(automation_mutex);
+
+      start_list_acceleration = g_list_reverse(start_list_acceleration);
       
       list_acceleration = start_list_acceleration;
 
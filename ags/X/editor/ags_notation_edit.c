@@ -58,6 +58,14 @@ void ags_notation_edit_show_all(GtkWidget *widget);
 
 gboolean ags_notation_edit_auto_scroll_timeout(GtkWidget *widget);
 
+void ags_notation_edit_draw_tile(AgsNotationEdit *notation_edit,
+				 AgsNotationEditTile *tile,
+				 GPtrArray *note,
+				 guint tile_x0, guint tile_x1,
+				 GdkRGBA *fg_color, GdkRGBA *fg_color_selected,
+				 gdouble zoom_factor,
+				 gdouble opacity);
+
 /**
  * SECTION:ags_notation_edit
  * @short_description: edit notes
@@ -66,6 +74,11 @@ gboolean ags_notation_edit_auto_scroll_timeout(GtkWidget *widget);
  * @include: ags/X/editor/ags_notation_edit.h
  *
  * The #AgsNotationEdit lets you edit notes.
+ *
+ * Notes are rendered to offscreen tiles of #AGS_NOTATION_EDIT_TILE_WIDTH
+ * pixels, only the notes within the visible time range are visited. A
+ * tile is redrawn if the notes of its time range change, cursor, selection
+ * and position are drawn on top.
  */
 
 enum{
@@ -261,6 +274,11 @@ ags_notation_edit_init(AgsNotationEdit *notation_edit)
 
   notation_edit->current_note = NULL;
 
+  notation_edit->tile_layout = 0;
+  notation_edit->tile = g_hash_table_new_full(g_int64_hash, g_int64_equal,
+					      NULL,
+					      (GDestroyNotify) ags_notation_edit_tile_free);
+
   notation_edit->ruler = ags_ruler_new();
   g_object_set(notation_edit->ruler,
 	       "step", (guint) (gui_scale_factor * AGS_RULER_DEFAULT_STEP),
@@ -350,6 +368,8 @@ ags_notation_edit_finalize(GObject *gobject)
   g_hash_table_remove(ags_notation_edit_auto_scroll,
 		      notation_edit);
 
+  g_hash_table_destroy(notation_edit->tile);
+
   /* call parent */
   G_OBJECT_CLASS(ags_notation_edit_parent_class)->finalize(gobject);
 }
@@ -1836,25 +1856,174 @@ ags_notation_edit_draw_note(AgsNotationEdit *notation_edit,
   g_boxed_free(GDK_TYPE_RGBA, fg_color_selected);
 }
 
+/**
+ * ags_notation_edit_tile_alloc:
+ * @index: the tile index
+ * @width: the width in pixels
+ * @height: the height in pixels
+ *
+ * Allocate #AgsNotationEditTile-struct with a transparent surface.
+ *
+ * Returns: the newly allocated #AgsNotationEditTile-struct
+ *
+ * Since: 3.5.0
+ */
+AgsNotationEditTile*
+ags_notation_edit_tile_alloc(gint64 index,
+			     guint width, guint height)
+{
+  AgsNotationEditTile *tile;
+
+  tile = (AgsNotationEditTile *) g_malloc(sizeof(AgsNotationEditTile));
+
+  tile->index = index;
+  tile->signature = 0;
+
+  tile->surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+					     width, height);
+
+  return(tile);
+}
+
+/**
+ * ags_notation_edit_tile_free:
+ * @tile: the #AgsNotationEditTile-struct
+ *
+ * Free @tile and its surface.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_notation_edit_tile_free(AgsNotationEditTile *tile)
+{
+  if(tile == NULL){
+    return;
+  }
+
+  if(tile->surface != NULL){
+    cairo_surface_destroy(tile->surface);
+  }
+
+  g_free(tile);
+}
+
+void
+ags_notation_edit_draw_tile(AgsNotationEdit *notation_edit,
+			    AgsNotationEditTile *tile,
+			    GPtrArray *note,
+			    guint tile_x0, guint tile_x1,
+			    GdkRGBA *fg_color, GdkRGBA *fg_color_selected,
+			    gdouble zoom_factor,
+			    gdouble opacity)
+{
+  cairo_t *tile_cr;
+
+  guint i;
+
+  tile_cr = cairo_create(tile->surface);
+
+  /* clear */
+  cairo_set_operator(tile_cr,
+		     CAIRO_OPERATOR_CLEAR);
+  cairo_paint(tile_cr);
+
+  cairo_set_operator(tile_cr,
+		     CAIRO_OPERATOR_OVER);
+  
+  for(i = 0; i < note->len; i++){
+    AgsNote *current_note;
+    
+    double x, y;
+    double width, height;
+
+    current_note = AGS_NOTE(g_ptr_array_index(note, i));
+
+    if(current_note->x[1] < tile_x0 ||
+       current_note->x[0] > tile_x1){
+      continue;
+    }
+    
+    x = ((double) current_note->x[0]) * ((double) notation_edit->control_width) / zoom_factor - (double) (tile->index * AGS_NOTATION_EDIT_TILE_WIDTH);
+    y = ((double) current_note->y) * ((double) notation_edit->control_height);
+
+    width = ((double) (current_note->x[1] - current_note->x[0])) * ((double) notation_edit->control_width) / zoom_factor;
+    height = ((double) notation_edit->control_height);
+
+    x += ((double) notation_edit->control_margin_x);
+    y += ((double) notation_edit->control_margin_y);
+  
+    width -= (2.0 * (double) notation_edit->control_margin_x);
+    height -= (2.0 * (double) notation_edit->control_margin_y);
+
+    /* draw note */
+    cairo_set_source_rgba(tile_cr,
+			  fg_color->red,
+			  fg_color->blue,
+			  fg_color->green,
+			  opacity * fg_color->alpha);
+  
+    cairo_rectangle(tile_cr,
+		    x, y,
+		    width, height);
+    cairo_fill(tile_cr);
+
+    /* check note selected */
+    if((AGS_NOTE_IS_SELECTED & (current_note->flags)) != 0){
+      cairo_set_source_rgba(tile_cr,
+			    fg_color_selected->red,
+			    fg_color_selected->blue,
+			    fg_color_selected->green,
+			    opacity / 3.0);
+    
+      cairo_rectangle(tile_cr,
+		      x - (double) notation_edit->selected_note_border, y - (double) notation_edit->selected_note_border,
+		      width + (2.0 * (double) notation_edit->selected_note_border), height + (2.0 * (double) notation_edit->selected_note_border));
+      cairo_fill(tile_cr);
+    }
+  }
+
+  cairo_destroy(tile_cr);
+}
+
 void
 ags_notation_edit_draw_notation(AgsNotationEdit *notation_edit, cairo_t *cr)
 {
   AgsNotationEditor *notation_editor;
   AgsNotationToolbar *notation_toolbar;
 
+  GtkStyleContext *notation_edit_style_context;
+
   GtkAllocation allocation;
   
   AgsTimestamp *timestamp;
   AgsTimestamp *current_timestamp;    
+
+  GdkRGBA *fg_color;
+  GdkRGBA *fg_color_selected;
+
+  GHashTableIter iter;
   
   GList *start_list_notation, *list_notation;
 
+  GPtrArray *note;
+  
   gdouble opacity;
-  gdouble zoom, zoom_factor;
+  gdouble zoom_factor;
+  double viewport_x, viewport_y;
+  double scroll_x;
+  guint channel_count;
+  guint content_height;
+  guint tile_layout;
+  gint64 tile_first, tile_last;
+  gint64 index;
+  guint border;
   guint x0, x1;
-  guint offset;
   guint audio_channel;
   gint i;    
+
+  gpointer tile;
+  
+  GValue value = {0,};
   
   if(!AGS_IS_NOTATION_EDIT(notation_edit)){
     return;
@@ -1871,17 +2040,92 @@ ags_notation_edit_draw_notation(AgsNotationEdit *notation_edit, cairo_t *cr)
   gtk_widget_get_allocation(GTK_WIDGET(notation_edit->drawing_area),
 			    &allocation);
 
+  g_object_get(notation_editor->selected_machine->audio,
+	       "input-pads", &channel_count,
+	       NULL);
+
+  content_height = channel_count * notation_edit->control_height;
+
+  if(content_height == 0){
+    return;
+  }
+  
+  /* style context - once for all notes */
+  notation_edit_style_context = gtk_widget_get_style_context(GTK_WIDGET(notation_edit->drawing_area));
+
+  gtk_style_context_get_property(notation_edit_style_context,
+				 "color",
+				 GTK_STATE_FLAG_NORMAL,
+				 &value);
+
+  fg_color = g_value_dup_boxed(&value);
+  g_value_unset(&value);
+
+  gtk_style_context_get_property(notation_edit_style_context,
+				 "color",
+				 GTK_STATE_FLAG_SELECTED,
+				 &value);
+
+  fg_color_selected = g_value_dup_boxed(&value);
+  g_value_unset(&value);
+
   opacity = gtk_spin_button_get_value(notation_editor->notation_toolbar->opacity);
 
   /* zoom */
-  zoom = exp2((double) gtk_combo_box_get_active((GtkComboBox *) notation_toolbar->zoom) - 2.0);
   zoom_factor = exp2(6.0 - (double) gtk_combo_box_get_active((GtkComboBox *) notation_toolbar->zoom));
 
-  /* get visisble region */
-  x0 = (zoom_factor * gtk_range_get_value(GTK_RANGE(notation_edit->hscrollbar))) / notation_edit->control_width;
-  x1 = ((zoom_factor * gtk_range_get_value(GTK_RANGE(notation_edit->hscrollbar))) / notation_edit->control_width) + (allocation.width * zoom);
+  /* get offset */
+  if((AGS_NOTATION_EDITOR_MAX_CONTROLS * notation_edit->control_width) > allocation.width){
+    viewport_x = zoom_factor * gtk_range_get_value(GTK_RANGE(notation_edit->hscrollbar));
+  }else{
+    viewport_x = 0.0;
+  }
+  
+  if(content_height > allocation.height){
+    viewport_y = gtk_range_get_value(GTK_RANGE(notation_edit->vscrollbar));
+  }else{
+    viewport_y = 0.0;
+  }
+
+  scroll_x = viewport_x / zoom_factor;
+  
+  /* tiles are valid as long the layout doesn't change */
+  tile_layout = 17;
+  tile_layout = tile_layout * 31 + (guint) (zoom_factor * 1024.0);
+  tile_layout = tile_layout * 31 + notation_edit->control_width;
+  tile_layout = tile_layout * 31 + notation_edit->control_height;
+  tile_layout = tile_layout * 31 + notation_edit->control_margin_x;
+  tile_layout = tile_layout * 31 + notation_edit->control_margin_y;
+  tile_layout = tile_layout * 31 + notation_edit->selected_note_border;
+  tile_layout = tile_layout * 31 + content_height;
+  tile_layout = tile_layout * 31 + (guint) (opacity * 1024.0);
+  tile_layout = tile_layout * 31 + (guint) (fg_color->red * 255.0) + ((guint) (fg_color->green * 255.0) << 8) + ((guint) (fg_color->blue * 255.0) << 16) + ((guint) (fg_color->alpha * 255.0) << 24);
+  tile_layout = tile_layout * 31 + (guint) (fg_color_selected->red * 255.0) + ((guint) (fg_color_selected->green * 255.0) << 8) + ((guint) (fg_color_selected->blue * 255.0) << 16);
+
+  if(tile_layout != notation_edit->tile_layout){
+    g_hash_table_remove_all(notation_edit->tile);
+
+    notation_edit->tile_layout = tile_layout;
+  }
   
-  /* draw notation */
+  /* get visible tiles and their note range */
+  tile_first = (gint64) floor(scroll_x / (double) AGS_NOTATION_EDIT_TILE_WIDTH);
+  tile_last = (gint64) floor((scroll_x + (double) allocation.width) / (double) AGS_NOTATION_EDIT_TILE_WIDTH);
+
+  border = (guint) ceil((double) notation_edit->selected_note_border * zoom_factor / (double) notation_edit->control_width) + 1;
+  
+  x0 = (guint) floor((double) (tile_first * AGS_NOTATION_EDIT_TILE_WIDTH) * zoom_factor / (double) notation_edit->control_width);
+  x1 = (guint) ceil((double) ((tile_last + 1) * AGS_NOTATION_EDIT_TILE_WIDTH) * zoom_factor / (double) notation_edit->control_width) + border;
+
+  if(x0 > border){
+    x0 -= border;
+  }else{
+    x0 = 0;
+  }
+  
+  /* collect visible notes */
+  note = g_ptr_array_new_with_free_func(g_object_unref);
+
   timestamp = ags_timestamp_new();
 
   timestamp->flags &= (~AGS_TIMESTAMP_UNIX);
@@ -1903,8 +2147,11 @@ ags_notation_edit_draw_notation(AgsNotationEdit *notation_edit, cairo_t *cr)
     while(list_notation != NULL){
       AgsNotation *notation;
 
-      GList *start_list_note, *list_note;
+      AgsNotationSnapshot *snapshot;
 
+      guint first;
+      guint j;
+      
       notation = AGS_NOTATION(list_notation->data);
 
       g_object_get(notation,
@@ -1930,23 +2177,28 @@ ags_notation_edit_draw_notation(AgsNotationEdit *notation_edit, cairo_t *cr)
 	continue;
       }
 
-      g_object_get(notation,
-		   "note", &start_list_note,
-		   NULL);
+      /* the snapshot is sorted by x0, edits are published before drawing */
+      if(g_atomic_int_get(&(notation->snapshot_dirty)) ||
+	 g_atomic_pointer_get(&(notation->snapshot)) == NULL){
+	ags_notation_update_snapshot(notation);
+      }
       
-      list_note = start_list_note;
-
-      while(list_note != NULL){
-	ags_notation_edit_draw_note(notation_edit,
-				    list_note->data,
-				    cr,
-				    opacity);
-
-	list_note = list_note->next;
+      snapshot = ags_notation_acquire_snapshot(notation);
+
+      if(snapshot != NULL){
+	/* binary search the first note that might reach x0 */
+	first = ags_notation_snapshot_find_offset(snapshot,
+						  (x0 > snapshot->max_length) ? x0 - snapshot->max_length: 0);
+
+	for(j = first; j < snapshot->n_notes && snapshot->x0[j] <= x1; j++){
+	  if(snapshot->x1[j] >= x0){
+	    g_ptr_array_add(note,
+			    g_object_ref(snapshot->note[j]));
+	  }
+	}
       }
 
-      g_list_free_full(start_list_note,
-		       g_object_unref);
+      ags_notation_release_snapshot(notation);
       
       list_notation = list_notation->next;
     }
@@ -1958,6 +2210,96 @@ ags_notation_edit_draw_notation(AgsNotationEdit *notation_edit, cairo_t *cr)
 		   g_object_unref);
 
   g_object_unref(timestamp);
+  
+  /* draw tiles - redraw only if the notes within changed */
+  for(index = tile_first; index <= tile_last; index++){
+    guint tile_x0, tile_x1;
+    guint signature;
+    guint j;
+    
+    double tile_x;
+    
+    tile_x0 = (guint) floor((double) (index * AGS_NOTATION_EDIT_TILE_WIDTH) * zoom_factor / (double) notation_edit->control_width);
+    tile_x1 = (guint) ceil((double) ((index + 1) * AGS_NOTATION_EDIT_TILE_WIDTH) * zoom_factor / (double) notation_edit->control_width) + border;
+
+    if(tile_x0 > border){
+      tile_x0 -= border;
+    }else{
+      tile_x0 = 0;
+    }
+
+    signature = 17;
+    
+    for(j = 0; j < note->len; j++){
+      AgsNote *current_note;
+
+      current_note = AGS_NOTE(g_ptr_array_index(note, j));
+
+      if(current_note->x[1] < tile_x0 ||
+	 current_note->x[0] > tile_x1){
+	continue;
+      }
+
+      signature = signature * 31 + current_note->x[0];
+      signature = signature * 31 + current_note->x[1];
+      signature = signature * 31 + current_note->y;
+      signature = signature * 31 + (((AGS_NOTE_IS_SELECTED & (current_note->flags)) != 0) ? 1: 0);
+    }
+    
+    tile = g_hash_table_lookup(notation_edit->tile,
+			       &index);
+
+    if(tile == NULL){
+      tile = ags_notation_edit_tile_alloc(index,
+					  AGS_NOTATION_EDIT_TILE_WIDTH, content_height);
+      AGS_NOTATION_EDIT_TILE(tile)->signature = ~signature;
+      
+      g_hash_table_insert(notation_edit->tile,
+			  &(AGS_NOTATION_EDIT_TILE(tile)->index), tile);
+    }
+
+    if(AGS_NOTATION_EDIT_TILE(tile)->signature != signature){
+      ags_notation_edit_draw_tile(notation_edit,
+				  tile,
+				  note,
+				  tile_x0, tile_x1,
+				  fg_color, fg_color_selected,
+				  zoom_factor,
+				  opacity);
+
+      AGS_NOTATION_EDIT_TILE(tile)->signature = signature;
+    }
+
+    /* composite */
+    tile_x = (double) (index * AGS_NOTATION_EDIT_TILE_WIDTH) - scroll_x;
+    
+    cairo_set_source_surface(cr,
+			     AGS_NOTATION_EDIT_TILE(tile)->surface,
+			     tile_x, -1.0 * viewport_y);
+    cairo_rectangle(cr,
+		    tile_x, 0.0,
+		    (double) AGS_NOTATION_EDIT_TILE_WIDTH, (double) allocation.height);
+    cairo_fill(cr);
+  }
+
+  /* drop tiles out of sight */
+  if(g_hash_table_size(notation_edit->tile) > AGS_NOTATION_EDIT_MAX_TILES){
+    g_hash_table_iter_init(&iter,
+			   notation_edit->tile);
+    
+    while(g_hash_table_iter_next(&iter, NULL, &tile)){
+      if(AGS_NOTATION_EDIT_TILE(tile)->index < tile_first ||
+	 AGS_NOTATION_EDIT_TILE(tile)->index > tile_last){
+	g_hash_table_iter_remove(&iter);
+      }
+    }
+  }
+  
+  g_ptr_array_free(note,
+		   TRUE);
+  
+  g_boxed_free(GDK_TYPE_RGBA, fg_color);
+  g_boxed_free(GDK_TYPE_RGBA, fg_color_selected);
 }
 
 void
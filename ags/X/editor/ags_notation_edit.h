@@ -38,6 +38,8 @@ G_BEGIN_DECLS
 #define AGS_IS_NOTATION_EDIT_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_NOTATION_EDIT))
 #define AGS_NOTATION_EDIT_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_NOTATION_EDIT, AgsNotationEditClass))
 
+#define AGS_NOTATION_EDIT_TILE(ptr) ((AgsNotationEditTile *)(ptr))
+
 #define AGS_NOTATION_EDIT_DEFAULT_CONTROL_WIDTH (64)
 #define AGS_NOTATION_EDIT_DEFAULT_CONTROL_HEIGHT (14)
 
@@ -55,8 +57,12 @@ G_BEGIN_DECLS
 #define AGS_NOTATION_EDIT_MAX_ZOOM (4.0)
 #define AGS_NOTATION_EDIT_MAX_ZOOM_CONTROL_WIDTH (64.0 * AGS_NOTATION_EDIT_DEFAULT_CONTROL_WIDTH)
 
+#define AGS_NOTATION_EDIT_TILE_WIDTH (256)
+#define AGS_NOTATION_EDIT_MAX_TILES (64)
+
 typedef struct _AgsNotationEdit AgsNotationEdit;
 typedef struct _AgsNotationEditClass AgsNotationEditClass;
+typedef struct _AgsNotationEditTile AgsNotationEditTile;
 
 typedef enum{
   AGS_NOTATION_EDIT_CONNECTED             = 1,
@@ -85,6 +91,23 @@ typedef enum{
   AGS_NOTATION_EDIT_KEY_R_SHIFT         = 1 <<  3,
 }AgsNotationEditKeyMask;
 
+/**
+ * AgsNotationEditTile:
+ * @index: the tile index, the tile starts at @index times #AGS_NOTATION_EDIT_TILE_WIDTH pixels
+ * @signature: the signature of the notes drawn
+ * @surface: the offscreen surface of the notes
+ *
+ * #AgsNotationEditTile caches the rendered notes of a time range, it is
+ * redrawn only if the notes within its range change.
+ */
+struct _AgsNotationEditTile
+{
+  gint64 index;
+  guint signature;
+  
+  cairo_surface_t *surface;
+};
+
 struct _AgsNotationEdit
 {
   GtkTable table;
@@ -115,6 +138,9 @@ struct _AgsNotationEdit
   guint selection_y1;
 
   AgsNote *current_note;
+
+  guint tile_layout;
+  GHashTable *tile;
   
   AgsRuler *ruler;
 
@@ -140,6 +166,10 @@ void ags_notation_edit_draw_position(AgsNotationEdit *notation_edit, cairo_t *cr
 void ags_notation_edit_draw_cursor(AgsNotationEdit *notation_edit, cairo_t *cr);
 void ags_notation_edit_draw_selection(AgsNotationEdit *notation_edit, cairo_t *cr);
 
+AgsNotationEditTile* ags_notation_edit_tile_alloc(gint64 index,
+						  guint width, guint height);
+void ags_notation_edit_tile_free(AgsNotationEditTile *tile);
+
 void ags_notation_edit_draw_note(AgsNotationEdit *notation_edit,
 				 AgsNote *note,
 				 cairo_t *cr,
@@ -1610,10 +1610,7 @@ ags_wave_edit_draw_buffer(AgsWaveEdit *wave_edit,
 
   GObject *soundcard;
   
-  cairo_t *i_cr;
-  cairo_surface_t *surface;
-
-  unsigned char *image_data, *bg_data;
+  AgsBufferPeak *peak;
   
   guint samplerate;
   guint buffer_size;
@@ -1624,7 +1621,11 @@ ags_wave_edit_draw_buffer(AgsWaveEdit *wave_edit,
   gdouble width, height;
   double zoom, zoom_factor;
   gdouble delay_factor;
-  guint wave_data_width;
+  gdouble frames_per_pixel;
+  gdouble buffer_x0, buffer_x1;
+  guint level;
+  guint n_peaks;
+  guint decimation;
   guint i;
 
   GValue value = {0};
@@ -1701,35 +1702,39 @@ ags_wave_edit_draw_buffer(AgsWaveEdit *wave_edit,
 
   x_cut = x0;
 
-  if(((((double) (x) / samplerate * (bpm / 60.0) / delay_factor) * 64.0)) / zoom_factor - x_cut < 0.0 ||
-     ((((double) (x) / samplerate * (bpm / 60.0) / delay_factor) * 64.0)) / zoom_factor - x_cut > allocation.width){
+  frames_per_pixel = ((gdouble) samplerate / (bpm / 60.0) * delay_factor / 64.0) * zoom_factor;
+  
+  buffer_x0 = ((((double) (x) / samplerate * (bpm / 60.0) / delay_factor) * 64.0)) / zoom_factor - x_cut;
+  buffer_x1 = ((((double) (x + buffer_size) / samplerate * (bpm / 60.0) / delay_factor) * 64.0)) / zoom_factor - x_cut;
+  
+  if(buffer_x1 < 0.0 ||
+     buffer_x0 > allocation.width){
     g_boxed_free(GDK_TYPE_RGBA, fg_color);
     g_boxed_free(GDK_TYPE_RGBA, fg_color_selected);
 
     return;
   }
+
+  /* peaks of the level matching zoom */
+  level = ags_buffer_find_peak_level(buffer,
+				     frames_per_pixel);
   
-  wave_data_width = buffer_size;
+  g_rec_mutex_lock(buffer_mutex);
 
-  /*
-  if(wave_edit->stride != cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, wave_data_width)){
-    if(wave_edit->wave_data != NULL){
-      free(wave_edit->wave_data);
-    }
+  peak = ags_buffer_get_peak(buffer,
+			     level,
+			     &n_peaks,
+			     &decimation);
 
-    wave_edit->stride = cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, wave_data_width);
-    wave_edit->wave_data = malloc(wave_edit->stride * AGS_WAVE_EDIT_DEFAULT_HEIGHT);
-  }
-  
-  surface = cairo_image_surface_create_for_data(wave_edit->wave_data,
-						CAIRO_FORMAT_ARGB32,
-						wave_data_width,
-						AGS_WAVE_EDIT_DEFAULT_HEIGHT,
-						wave_edit->stride);
+  if(peak == NULL){
+    g_rec_mutex_unlock(buffer_mutex);
 
-  i_cr = cairo_create(surface);
-  */
+    g_boxed_free(GDK_TYPE_RGBA, fg_color);
+    g_boxed_free(GDK_TYPE_RGBA, fg_color_selected);
 
+    return;
+  }
+  
   /* draw buffer */
   cairo_set_source_rgba(cr,
 			fg_color->red,
@@ -1739,66 +1744,56 @@ ags_wave_edit_draw_buffer(AgsWaveEdit *wave_edit,
   
   cairo_set_line_width(cr, 1.0);
 
-  //  cairo_scale(cr,
-  //	      1.0 / (zoom_factor * (((60.0 / bpm) * ((double) buffer_size / (double) samplerate)) * AGS_WAVE_EDIT_X_RESOLUTION)), 1.0);
-  
-  for(i = 0; i < buffer_size; i += (zoom_factor * 16)){
+  for(i = 0; i < n_peaks; i++){
+    double x_peak;
     double y0, y1;
 
-    y0 = 0.0;
-    y1 = 0.0;
+    x_peak = buffer_x0 + (double) (i * decimation) / frames_per_pixel;
 
-    g_rec_mutex_lock(buffer_mutex);
-
-    switch(format){
-    case AGS_SOUNDCARD_SIGNED_8_BIT:
-    {
-      y1 = (double) ((gint8 *) buffer->data)[i] / exp2(7.0);
-    }
-    break;
-    case AGS_SOUNDCARD_SIGNED_16_BIT:
-    {
-      y1 = (double) ((gint16 *) buffer->data)[i] / exp2(15.0);
-    }
-    break;
-    case AGS_SOUNDCARD_SIGNED_24_BIT:
-    {
-      y1 = (double) ((gint32 *) buffer->data)[i] / exp2(23.0);
-    }
-    break;
-    case AGS_SOUNDCARD_SIGNED_32_BIT:
-    {
-      y1 = (double) ((gint32 *) buffer->data)[i] / exp2(31.0);
-    }
-    break;
-    case AGS_SOUNDCARD_SIGNED_64_BIT:
-    {
-      y1 = (double) ((gint64 *) buffer->data)[i] / exp2(63.0);
-    }
-    break;
-    case AGS_SOUNDCARD_FLOAT:
-    {
-      y1 = (double) ((gfloat *) buffer->data)[i];
-    }
-    break;
-    case AGS_SOUNDCARD_DOUBLE:
-    {
-      y1 = (double) ((gdouble *) buffer->data)[i];
+    if(x_peak < 0.0){
+      continue;
     }
-    break;
+
+    if(x_peak > width){
+      break;
     }
+    
+    y0 = (((double) peak[i].min + 1.0) * height) / 2.0;
+    y1 = (((double) peak[i].max + 1.0) * height) / 2.0;
+    
+    cairo_move_to(cr,
+		  x_peak, y0 - 0.5);
+    cairo_line_to(cr,
+		  x_peak, y1 + 0.5);
+  }
 
-    g_rec_mutex_unlock(buffer_mutex);
+  cairo_stroke(cr);
+
+  /* draw RMS above */
+  for(i = 0; i < n_peaks; i++){
+    double x_peak;
+    double y0, y1;
 
-    y0 = 0.5 * height;
-    y1 = (((y1 + 1.0) * height) / 2.0);
+    x_peak = buffer_x0 + (double) (i * decimation) / frames_per_pixel;
+
+    if(x_peak < 0.0){
+      continue;
+    }
+
+    if(x_peak > width){
+      break;
+    }
+    
+    y0 = ((1.0 - (double) peak[i].rms) * height) / 2.0;
+    y1 = ((1.0 + (double) peak[i].rms) * height) / 2.0;
     
     cairo_move_to(cr,
-		  ((((double) (x + i) / samplerate * (bpm / 60.0) / delay_factor) * 64.0)) / zoom_factor - x_cut, y0);
+		  x_peak, y0);
     cairo_line_to(cr,
-		  ((((double) (x + i) / samplerate * (bpm / 60.0) / delay_factor) * 64.0)) / zoom_factor - x_cut, y1);
-    cairo_stroke(cr);
-  }  
+		  x_peak, y1);
+  }
+
+  cairo_stroke(cr);
   
   /* check buffer selected */
   if(ags_buffer_test_flags(buffer, AGS_BUFFER_IS_SELECTED)){
@@ -1811,74 +1806,222 @@ ags_wave_edit_draw_buffer(AgsWaveEdit *wave_edit,
 
     cairo_set_line_width(cr, 1.0 + (double) wave_edit->selected_buffer_border);
 
-    for(i = 0; i < buffer_size; i += (zoom_factor * 16)){
+    for(i = 0; i < n_peaks; i++){
+      double x_peak;
       double y0, y1;
 
-      y0 = 0.0;
-      y1 = 0.0;
-
-      g_rec_mutex_lock(buffer_mutex);
+      x_peak = buffer_x0 + (double) (i * decimation) / frames_per_pixel;
 
-      switch(format){
-      case AGS_SOUNDCARD_SIGNED_8_BIT:
-      {
-	y1 = (double) ((gint8 *) buffer->data)[i] / exp2(7.0);
-      }
-      break;
-      case AGS_SOUNDCARD_SIGNED_16_BIT:
-      {
-	y1 = (double) ((gint16 *) buffer->data)[i] / exp2(15.0);
-      }
-      break;
-      case AGS_SOUNDCARD_SIGNED_24_BIT:
-      {
-	y1 = (double) ((gint32 *) buffer->data)[i] / exp2(23.0);
-      }
-      break;
-      case AGS_SOUNDCARD_SIGNED_32_BIT:
-      {
-	y1 = (double) ((gint32 *) buffer->data)[i] / exp2(31.0);
-      }
-      break;
-      case AGS_SOUNDCARD_SIGNED_64_BIT:
-      {
-	y1 = (double) ((gint64 *) buffer->data)[i] / exp2(63.0);
+      if(x_peak < 0.0){
+	continue;
       }
-      break;
-      case AGS_SOUNDCARD_FLOAT:
-      {
-	y1 = (double) ((gfloat *) buffer->data)[i];
-      }
-      break;
-      case AGS_SOUNDCARD_DOUBLE:
-      {
-	y1 = (double) ((gdouble *) buffer->data)[i];
-      }
-      break;
-      }
-
-      g_rec_mutex_unlock(buffer_mutex);
 
-      y0 = 0.5 * height;
-      y1 = (((y1 + 1.0) * height) / 2.0);
+      if(x_peak > width){
+	break;
+      }
+    
+      y0 = (((double) peak[i].min + 1.0) * height) / 2.0;
+      y1 = (((double) peak[i].max + 1.0) * height) / 2.0;
     
       cairo_move_to(cr,
-		    ((((double) (x + i) / samplerate * (bpm / 60.0) / delay_factor) * 64.0)) / zoom_factor - x_cut, y0);
+		    x_peak, y0 - 0.5);
       cairo_line_to(cr,
-		    ((((double) (x + i) / samplerate * (bpm / 60.0) / delay_factor) * 64.0)) / zoom_factor - x_cut, y1);
-      cairo_stroke(cr);
-    }  
+		    x_peak, y1 + 0.5);
+    }
+
+    cairo_stroke(cr);
   }
-  
 
-  /* draw buffer */
-  //  cairo_set_source_surface(cr, surface,
-  //			   (bpm / (60.0 * (x / samplerate))) * AGS_WAVE_EDIT_X_RESOLUTION, 0.0);
+  g_rec_mutex_unlock(buffer_mutex);
 
   g_boxed_free(GDK_TYPE_RGBA, fg_color);
   g_boxed_free(GDK_TYPE_RGBA, fg_color_selected);
 }
 
+void
+ags_wave_edit_draw_peak(AgsWaveEdit *wave_edit,
+			AgsWave *wave,
+			cairo_t *cr,
+			gdouble bpm,
+			gdouble opacity)
+{
+  AgsWaveEditor *wave_editor;
+  AgsWaveToolbar *wave_toolbar;
+
+  GtkStyleContext *wave_edit_style_context;
+
+  GtkAllocation allocation;
+
+  GdkRGBA *fg_color;
+
+  GObject *soundcard;
+  
+  AgsBufferPeak *peak;
+  AgsBufferPeak *visible_peak;
+  
+  gdouble *visible_x;
+  
+  guint samplerate;
+  guint x0;
+  guint x_cut;
+  gdouble width, height;
+  double zoom_factor;
+  gdouble delay_factor;
+  gdouble frames_per_pixel;
+  guint level;
+  guint n_peaks;
+  guint buffers_per_peak;
+  guint first;
+  guint n_visible;
+  guint i;
+
+  GValue value = {0};
+
+  GRecMutex *wave_mutex;
+
+  if(!AGS_IS_WAVE_EDIT(wave_edit) ||
+     !AGS_IS_WAVE(wave)){
+    return;
+  }
+
+  wave_editor = (AgsWaveEditor *) gtk_widget_get_ancestor((GtkWidget *) wave_edit,
+							  AGS_TYPE_WAVE_EDITOR);
+
+  if(wave_editor->selected_machine == NULL){
+    return;
+  }
+
+  wave_toolbar = wave_editor->wave_toolbar;
+
+  /* style context */
+  wave_edit_style_context = gtk_widget_get_style_context(GTK_WIDGET(wave_edit->drawing_area));
+
+  gtk_style_context_get_property(wave_edit_style_context,
+				 "color",
+				 GTK_STATE_FLAG_NORMAL,
+				 &value);
+
+  fg_color = g_value_dup_boxed(&value);
+  g_value_unset(&value);
+  
+  gtk_widget_get_allocation(GTK_WIDGET(wave_edit->drawing_area),
+			    &allocation);
+
+  wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+  
+  g_object_get(wave_editor->selected_machine->audio,
+	       "output-soundcard", &soundcard,
+	       NULL);
+
+  g_object_unref(soundcard);
+  
+  /* zoom */
+  zoom_factor = exp2(6.0 - (double) gtk_combo_box_get_active((GtkComboBox *) wave_toolbar->zoom));
+
+  delay_factor = ags_soundcard_get_delay_factor(AGS_SOUNDCARD(soundcard));
+  
+  /* get visisble region */
+  x0 = gtk_range_get_value(GTK_RANGE(wave_edit->hscrollbar));
+
+  x_cut = x0;
+
+  /* width and height */
+  width = (gdouble) allocation.width;
+  height = (gdouble) allocation.height;
+
+  g_object_get(wave,
+	       "samplerate", &samplerate,
+	       NULL);
+  
+  frames_per_pixel = ((gdouble) samplerate / (bpm / 60.0) * delay_factor / 64.0) * zoom_factor;
+
+  /* copy the visible peaks of the level matching zoom */
+  level = ags_wave_find_peak_level(wave,
+				   frames_per_pixel);
+
+  visible_peak = NULL;
+  visible_x = NULL;
+  
+  n_visible = 0;
+  
+  g_rec_mutex_lock(wave_mutex);
+
+  peak = ags_wave_get_peak(wave,
+			   level,
+			   &n_peaks,
+			   &buffers_per_peak);
+
+  if(peak != NULL){
+    first = ags_wave_find_buffer_index(wave,
+				       (guint64) ((gdouble) x_cut * frames_per_pixel)) / buffers_per_peak;
+
+    if(first < n_peaks){
+      visible_peak = (AgsBufferPeak *) g_malloc((n_peaks - first) * sizeof(AgsBufferPeak));
+      visible_x = (gdouble *) g_malloc((n_peaks - first) * sizeof(gdouble));
+    }
+    
+    for(i = first; i < n_peaks; i++){
+      double x_peak;
+
+      x_peak = ((((double) (wave->buffer_index[i * buffers_per_peak].x) / samplerate * (bpm / 60.0) / delay_factor) * 64.0)) / zoom_factor - x_cut;
+
+      if(x_peak > width){
+	break;
+      }
+
+      visible_peak[n_visible] = peak[i];
+      visible_x[n_visible] = x_peak;
+
+      n_visible++;
+    }
+  }
+  
+  g_rec_mutex_unlock(wave_mutex);
+  
+  /* draw peaks */
+  cairo_set_source_rgba(cr,
+			fg_color->red,
+			fg_color->blue,
+			fg_color->green,
+			opacity * fg_color->alpha);
+  
+  cairo_set_line_width(cr, 1.0);
+
+  for(i = 0; i < n_visible; i++){
+    double y0, y1;
+
+    y0 = (((double) visible_peak[i].min + 1.0) * height) / 2.0;
+    y1 = (((double) visible_peak[i].max + 1.0) * height) / 2.0;
+    
+    cairo_move_to(cr,
+		  visible_x[i], y0 - 0.5);
+    cairo_line_to(cr,
+		  visible_x[i], y1 + 0.5);
+  }
+
+  cairo_stroke(cr);
+
+  /* draw RMS above */
+  for(i = 0; i < n_visible; i++){
+    double y0, y1;
+
+    y0 = ((1.0 - (double) visible_peak[i].rms) * height) / 2.0;
+    y1 = ((1.0 + (double) visible_peak[i].rms) * height) / 2.0;
+    
+    cairo_move_to(cr,
+		  visible_x[i], y0);
+    cairo_line_to(cr,
+		  visible_x[i], y1);
+  }
+
+  cairo_stroke(cr);
+  
+  g_free(visible_peak);
+  g_free(visible_x);
+  
+  g_boxed_free(GDK_TYPE_RGBA, fg_color);
+}
+
 void
 ags_wave_edit_draw_wave(AgsWaveEdit *wave_edit, cairo_t *cr)
 {
@@ -1894,10 +2037,10 @@ ags_wave_edit_draw_wave(AgsWaveEdit *wave_edit, cairo_t *cr)
   GtkAllocation allocation;
 
   GList *start_list_wave, *list_wave;
-  GList *start_list_buffer, *list_buffer;
 
   double zoom, zoom_factor;
   gdouble delay_factor;
+  gdouble frames_per_pixel;
   gdouble opacity;
   guint line;
   guint samplerate;
@@ -1961,7 +2104,9 @@ ags_wave_edit_draw_wave(AgsWaveEdit *wave_edit, cairo_t *cr)
     GList *start_list_buffer, *list_buffer;
 
     guint current_line;
+    guint buffer_size;
     guint64 offset;
+    guint64 visible_x0, visible_x1;
     
     wave = AGS_WAVE(list_wave->data);
 
@@ -1969,6 +2114,7 @@ ags_wave_edit_draw_wave(AgsWaveEdit *wave_edit, cairo_t *cr)
 		 "timestamp", &current_timestamp,
 		 "line", &current_line,
 		 "samplerate", &samplerate,
+		 "buffer-size", &buffer_size,
 		 NULL);
 
     g_object_unref(current_timestamp);
@@ -1986,9 +2132,29 @@ ags_wave_edit_draw_wave(AgsWaveEdit *wave_edit, cairo_t *cr)
       break;
     }
 
-    g_object_get(wave,
-		 "buffer", &start_list_buffer,
-		 NULL);
+    /* visible frames */
+    frames_per_pixel = ((gdouble) samplerate / (bpm / 60.0) * delay_factor / 64.0) * zoom_factor;
+
+    visible_x0 = (guint64) ((gdouble) x_cut * frames_per_pixel);
+    visible_x1 = (guint64) ((gdouble) (x_cut + allocation.width) * frames_per_pixel);
+
+    if((gdouble) buffer_size <= frames_per_pixel){
+      /* a buffer fits within a pixel, draw the peaks of the wave and the selection above */
+      ags_wave_edit_draw_peak(wave_edit,
+			      wave,
+			      cr,
+			      bpm,
+			      opacity);
+      
+      start_list_buffer = ags_wave_find_region(wave,
+					       visible_x0, visible_x1,
+					       TRUE);
+    }else{
+      /* starts at the first visible buffer */
+      start_list_buffer = ags_wave_find_region(wave,
+					       visible_x0, visible_x1,
+					       FALSE);
+    }
       
     list_buffer = start_list_buffer;
 
@@ -2003,8 +2169,7 @@ ags_wave_edit_draw_wave(AgsWaveEdit *wave_edit, cairo_t *cr)
       list_buffer = list_buffer->next;
     }
 
-    g_list_free_full(start_list_buffer,
-		     g_object_unref);
+    g_list_free(start_list_buffer);
       
     /* iterate */
     list_wave = list_wave->next;
@@ -160,6 +160,11 @@ void ags_wave_edit_draw_buffer(AgsWaveEdit *wave_edit,
 			       cairo_t *cr,
 			       gdouble bpm,
 			       gdouble opacity);
+void ags_wave_edit_draw_peak(AgsWaveEdit *wave_edit,
+			     AgsWave *wave,
+			     cairo_t *cr,
+			     gdouble bpm,
+			     gdouble opacity);
 void ags_wave_edit_draw_wave(AgsWaveEdit *wave_edit, cairo_t *cr);
 
 void ags_wave_edit_draw(AgsWaveEdit *wave_edit, cairo_t *cr);
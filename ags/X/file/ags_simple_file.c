@@ -74,9 +74,12 @@
 #include <libinstpatch/libinstpatch.h>
 #endif
 
+#include <string.h>
+
 #include <libxml/parser.h>
 #include <libxml/xlink.h>
 #include <libxml/xpath.h>
+#include <libxml/xpathInternals.h>
 #include <libxml/valid.h>
 #include <libxml/xmlIO.h>
 #include <libxml/xmlmemory.h>
@@ -94,6 +97,11 @@ void ags_simple_file_get_property(GObject *gobject,
 				  GParamSpec *param_spec);
 void ags_simple_file_finalize(GObject *gobject);
 
+gboolean ags_simple_file_xpath_id_predicate(gchar *xpath,
+					    gchar **name, gchar **id);
+xmlXPathObject* ags_simple_file_eval_xpath(AgsSimpleFile *simple_file,
+					   gchar *xpath);
+
 void ags_simple_file_real_open(AgsSimpleFile *simple_file,
 			       GError **error);
 void ags_simple_file_real_open_from_data(AgsSimpleFile *simple_file,
@@ -107,6 +115,7 @@ void ags_simple_file_real_write(AgsSimpleFile *simple_file);
 void ags_simple_file_real_write_resolve(AgsSimpleFile *simple_file);
 
 void ags_simple_file_real_read(AgsSimpleFile *simple_file);
+void ags_simple_file_read_preload(AgsSimpleFile *simple_file, xmlNode *root_node);
 void ags_simple_file_real_read_resolve(AgsSimpleFile *simple_file);
 void ags_simple_file_real_read_start(AgsSimpleFile *simple_file);
 
@@ -603,6 +612,26 @@ ags_simple_file_init(AgsSimpleFile *simple_file)
   simple_file->doc = NULL;
 
   simple_file->id_ref = NULL;
+
+  simple_file->id_ref_node = g_hash_table_new(g_direct_hash,
+					      g_direct_equal);
+  simple_file->id_ref_reference = g_hash_table_new_full(g_direct_hash,
+							g_direct_equal,
+							NULL,
+							(GDestroyNotify) g_list_free);
+  simple_file->id_ref_id = g_hash_table_new_full(g_str_hash,
+						 g_str_equal,
+						 g_free,
+						 (GDestroyNotify) g_list_free);
+
+  simple_file->xpath_context = NULL;
+  simple_file->xpath_expression = g_hash_table_new_full(g_str_hash,
+							g_str_equal,
+							g_free,
+							(GDestroyNotify) xmlXPathFreeCompExpr);
+
+  simple_file->resource_preloader = NULL;
+  
   simple_file->lookup = NULL;
   simple_file->launch = NULL;
 }
@@ -722,6 +751,24 @@ ags_simple_file_get_property(GObject *gobject,
 void
 ags_simple_file_finalize(GObject *gobject)
 {
+  AgsSimpleFile *simple_file;
+
+  simple_file = (AgsSimpleFile *) gobject;
+
+  if(simple_file->xpath_context != NULL){
+    xmlXPathFreeContext(simple_file->xpath_context);
+  }
+
+  g_hash_table_destroy(simple_file->xpath_expression);
+
+  g_hash_table_destroy(simple_file->id_ref_node);
+  g_hash_table_destroy(simple_file->id_ref_reference);
+  g_hash_table_destroy(simple_file->id_ref_id);
+
+  if(simple_file->resource_preloader != NULL){
+    g_object_unref(simple_file->resource_preloader);
+  }
+  
   //TODO:JK: implement me
 }
 
@@ -741,53 +788,201 @@ ags_simple_file_str2md5(gchar *content, guint content_length)
 void
 ags_simple_file_add_id_ref(AgsSimpleFile *simple_file, GObject *id_ref)
 {
+  AgsFileIdRef *file_id_ref;
+  
+  GList *start_list;
+
   if(simple_file == NULL ||
      id_ref == NULL){
     return;
   }
+
+  file_id_ref = AGS_FILE_ID_REF(id_ref);
   
   g_object_ref(id_ref);
   simple_file->id_ref = g_list_prepend(simple_file->id_ref,
 				       id_ref);
+
+  /* index by node - the most recent id ref wins */
+  g_hash_table_insert(simple_file->id_ref_node,
+		      file_id_ref->node,
+		      file_id_ref);
+
+  /* index by reference - in order of addition */
+  start_list = g_hash_table_lookup(simple_file->id_ref_reference,
+				   file_id_ref->ref);
+
+  if(start_list == NULL){
+    g_hash_table_insert(simple_file->id_ref_reference,
+			file_id_ref->ref,
+			g_list_prepend(NULL,
+				       file_id_ref));
+  }else{
+    /* appending keeps the head stored in the table */
+    g_list_append(start_list,
+		  file_id_ref);
+  }
+
+  /* index by id attribute */
+  if(file_id_ref->node != NULL){
+    xmlChar *id;
+
+    id = xmlGetProp(file_id_ref->node,
+		    AGS_SIMPLE_FILE_ID_PROP);
+
+    if(id != NULL){
+      start_list = g_hash_table_lookup(simple_file->id_ref_id,
+				       id);
+
+      if(start_list == NULL){
+	g_hash_table_insert(simple_file->id_ref_id,
+			    g_strdup(id),
+			    g_list_prepend(NULL,
+					   file_id_ref->node));
+      }else if(g_list_find(start_list, file_id_ref->node) == NULL){
+	g_list_append(start_list,
+		      file_id_ref->node);
+      }
+      
+      xmlFree(id);
+    }
+  }
 }
 
 GObject*
 ags_simple_file_find_id_ref_by_node(AgsSimpleFile *simple_file, xmlNode *node)
 {
-  AgsFileIdRef *file_id_ref;
-  GList *list;
-
   if(simple_file == NULL ||
      node == NULL){
     return(NULL);
   }
+
+  return(g_hash_table_lookup(simple_file->id_ref_node,
+			     node));
+}
+
+gboolean
+ags_simple_file_xpath_id_predicate(gchar *xpath,
+				   gchar **name, gchar **id)
+{
+  gchar *predicate;
+  gchar *id_start, *id_end;
+
+  /* an element name or wildcard step with an id predicate */
+  if(!g_str_has_prefix(xpath, "//")){
+    return(FALSE);
+  }
+
+  predicate = strstr(xpath, "[@id='");
+
+  if(predicate == NULL ||
+     predicate == xpath + 2 ||
+     strpbrk(xpath + 2, "/[@") != predicate){
+    return(FALSE);
+  }
+
+  id_start = predicate + 6;
+  id_end = strchr(id_start, '\'');
+
+  if(id_end == NULL ||
+     strcmp(id_end, "']") != 0){
+    return(FALSE);
+  }
+
+  name[0] = g_strndup(xpath + 2,
+		      predicate - xpath - 2);
+  id[0] = g_strndup(id_start,
+		    id_end - id_start);
   
-  list = simple_file->id_ref;
+  return(TRUE);
+}
 
-  while(list != NULL){
-    file_id_ref = AGS_FILE_ID_REF(list->data);
+xmlXPathObject*
+ags_simple_file_eval_xpath(AgsSimpleFile *simple_file,
+			   gchar *xpath)
+{
+  xmlXPathCompExpr *xpath_expression;
+  xmlXPathObject *xpath_object;
+
+  gchar *name, *id;
+  gchar *pattern;
+
+  /* id predicates share one compiled pattern per element name */
+  name = NULL;
+  id = NULL;
+  
+  if(ags_simple_file_xpath_id_predicate(xpath,
+					&name, &id)){
+    pattern = g_strdup_printf("//%s[@id=$id]", name);
+  }else{
+    pattern = g_strdup(xpath);
+  }
 
-    if(file_id_ref->node == node){
-      return((GObject *) file_id_ref);
+  /* the context is bound to the document */
+  if(simple_file->xpath_context == NULL ||
+     simple_file->xpath_context->doc != simple_file->doc){
+    if(simple_file->xpath_context != NULL){
+      xmlXPathFreeContext(simple_file->xpath_context);
     }
+    
+    simple_file->xpath_context = xmlXPathNewContext(simple_file->doc);
+  }
 
-    list = list->next;
+  xpath_object = NULL;
+  
+  if(simple_file->xpath_context == NULL){
+    g_warning("Error: unable to create new XPath context");
+
+    g_free(name);
+    g_free(id);
+    g_free(pattern);
+    
+    return(NULL);
   }
 
-  return(NULL);
+  simple_file->xpath_context->node = simple_file->root_node;
+  
+  xpath_expression = g_hash_table_lookup(simple_file->xpath_expression,
+					 pattern);
+
+  if(xpath_expression == NULL){
+    xpath_expression = xmlXPathCompile(pattern);
+
+    if(xpath_expression != NULL){
+      g_hash_table_insert(simple_file->xpath_expression,
+			  g_strdup(pattern),
+			  xpath_expression);
+    }
+  }
+
+  if(xpath_expression != NULL){
+    if(id != NULL){
+      xmlXPathRegisterVariable(simple_file->xpath_context,
+			       "id",
+			       xmlXPathNewString(id));
+    }
+    
+    xpath_object = xmlXPathCompiledEval(xpath_expression,
+					simple_file->xpath_context);
+  }
+
+  g_free(name);
+  g_free(id);
+  g_free(pattern);
+  
+  return(xpath_object);
 }
 
 GList*
 ags_simple_file_find_id_ref_by_xpath(AgsSimpleFile *simple_file, gchar *xpath)
 {
-  AgsFileIdRef *file_id_ref;
-
-  xmlXPathContext *xpath_context; 
   xmlXPathObject *xpath_object;
   xmlNode **node;
 
   GList *list;
 
+  gchar *name, *id;
+
   gboolean success;
   guint i;
 
@@ -799,50 +994,81 @@ ags_simple_file_find_id_ref_by_xpath(AgsSimpleFile *simple_file, gchar *xpath)
 
   xpath = &(xpath[6]);
 
-  /* Create xpath evaluation context */
-  xpath_context = xmlXPathNewContext(simple_file->doc);
+  /* id index */
+  list = NULL;
+  success = FALSE;
+
+  name = NULL;
+  id = NULL;
+  
+  if(ags_simple_file_xpath_id_predicate(xpath,
+					&name, &id)){
+    GList *start_node, *current_node;
 
-  if(xpath_context == NULL) {
-    g_warning("Error: unable to create new XPath context");
+    current_node =
+      start_node = g_hash_table_lookup(simple_file->id_ref_id,
+				       id);
 
-    return(NULL);
-  }
+    while(current_node != NULL){
+      if(!g_strcmp0(name, "*") ||
+	 !xmlStrcmp(((xmlNode *) current_node->data)->name, name)){
+	GObject *gobject;
+
+	success = TRUE;
+	gobject = ags_simple_file_find_id_ref_by_node(simple_file,
+						      current_node->data);
 
-  xpath_context->node = simple_file->root_node;
+	if(gobject != NULL){
+	  list = g_list_prepend(list,
+				gobject);
+	}
+      }
+      
+      current_node = current_node->next;
+    }
+    
+    g_free(name);
+    g_free(id);
+
+    if(success){
+      return(list);
+    }
+  }
 
   /* Evaluate xpath expression */
-  xpath_object = xmlXPathEval(xpath, xpath_context);
+  xpath_object = ags_simple_file_eval_xpath(simple_file,
+					    xpath);
 
   if(xpath_object == NULL) {
     g_warning("Error: unable to evaluate xpath expression \"%s\"", xpath);
-    xmlXPathFreeContext(xpath_context); 
 
     return(NULL);
   }
-
-  node = xpath_object->nodesetval->nodeTab;
-
-  list = NULL;
-  success = FALSE;
   
-  for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
-    if(node[i]->type == XML_ELEMENT_NODE){
-      GObject *gobject;
+  if(xpath_object->nodesetval != NULL){
+    node = xpath_object->nodesetval->nodeTab;
+  
+    for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
+      if(node[i]->type == XML_ELEMENT_NODE){
+	GObject *gobject;
 
-      success = TRUE;
-      gobject = ags_simple_file_find_id_ref_by_node(simple_file,
-						    node[i]);
+	success = TRUE;
+	gobject = ags_simple_file_find_id_ref_by_node(simple_file,
+						      node[i]);
 
-      if(gobject != NULL){
-	list = g_list_prepend(list,
-			      gobject);
+	if(gobject != NULL){
+	  list = g_list_prepend(list,
+				gobject);
+	}
       }
     }
   }
-
+  
   if(!success){
-    g_message("no xpath match [%d]: %s", xpath_object->nodesetval->nodeNr, xpath);
+    g_message("no xpath match [%d]: %s", ((xpath_object->nodesetval != NULL) ? xpath_object->nodesetval->nodeNr: 0), xpath);
   }
+
+  xmlXPathFreeObject(xpath_object);
   
   return(list);
 }
@@ -850,30 +1076,12 @@ ags_simple_file_find_id_ref_by_xpath(AgsSimpleFile *simple_file, gchar *xpath)
 GList*
 ags_simple_file_find_id_ref_by_reference(AgsSimpleFile *simple_file, gpointer ref)
 {
-  AgsFileIdRef *file_id_ref;
-  
-  GList *list;
-  GList *ref_list;
-  
   if(simple_file == NULL || ref == NULL){
     return(NULL);
   }
 
-  list = simple_file->id_ref;
-  ref_list = NULL;
-  
-  while(list != NULL){
-    file_id_ref = AGS_FILE_ID_REF(list->data);
-
-    if(file_id_ref->ref == ref){
-      ref_list = g_list_prepend(ref_list,
-				file_id_ref);
-    }
-
-    list = list->next;
-  }
-
-  return(ref_list);
+  return(g_list_copy(g_hash_table_lookup(simple_file->id_ref_reference,
+					 ref)));
 }
 
 void
@@ -1056,6 +1264,12 @@ ags_simple_file_close(AgsSimpleFile *simple_file)
   }
   
   /* free the document */
+  if(simple_file->xpath_context != NULL){
+    xmlXPathFreeContext(simple_file->xpath_context);
+
+    simple_file->xpath_context = NULL;
+  }
+  
   xmlFreeDoc(simple_file->doc);
 
   /*
@@ -1166,6 +1380,107 @@ ags_simple_file_write_resolve(AgsSimpleFile *simple_file)
   g_object_unref(G_OBJECT(simple_file));
 }
 
+void
+ags_simple_file_read_preload(AgsSimpleFile *simple_file, xmlNode *root_node)
+{
+  AgsApplicationContext *application_context;
+
+  xmlNode *node;
+
+  application_context = ags_application_context_get_instance();
+
+  if(simple_file->resource_preloader == NULL){
+    GObject *default_soundcard;
+
+    default_soundcard = ags_sound_provider_get_default_soundcard(AGS_SOUND_PROVIDER(application_context));
+    
+    simple_file->resource_preloader = ags_resource_preloader_new(default_soundcard);
+
+    if(default_soundcard != NULL){
+      g_object_unref(default_soundcard);
+    }
+  }
+
+  /* walk the tree without recursion */
+  node = root_node->children;
+
+  while(node != NULL){
+    if(node->type == XML_ELEMENT_NODE){
+      xmlChar *filename, *effect;
+
+      filename = xmlGetProp(node,
+			    "plugin-file");
+
+      if(filename == NULL){
+	filename = xmlGetProp(node,
+			      "filename");
+      }
+
+      effect = xmlGetProp(node,
+			  "effect");
+
+      if(filename != NULL){
+	if(effect != NULL){
+	  /* LADSPA, DSSI or LV2 plugin */
+	  ags_resource_preloader_add(simple_file->resource_preloader,
+				     AGS_RESOURCE_PRELOADER_PLUGIN,
+				     filename);
+	}else if(!xmlStrncmp(node->name,
+			     "ags-sf-line",
+			     12) &&
+		 !g_ascii_strncasecmp(filename,
+				      "file://",
+				      7)){
+	  /* audio file of line */
+	  ags_resource_preloader_add(simple_file->resource_preloader,
+				     AGS_RESOURCE_PRELOADER_AUDIO_FILE,
+				     &(filename[7]));
+	}else if(!xmlStrncmp(node->name,
+			     "ags-sf-machine",
+			     15) &&
+		 (g_str_has_suffix(filename, ".sf2") ||
+		  g_str_has_suffix(filename, ".dls") ||
+		  g_str_has_suffix(filename, ".gig") ||
+		  g_str_has_suffix(filename, ".sfz"))){
+	  /* Soundfont2 or SFZ of machine */
+	  ags_resource_preloader_add(simple_file->resource_preloader,
+				     AGS_RESOURCE_PRELOADER_AUDIO_CONTAINER,
+				     filename);
+	}
+      }
+
+      if(filename != NULL){
+	xmlFree(filename);
+      }
+
+      if(effect != NULL){
+	xmlFree(effect);
+      }
+    }
+
+    /* iterate - depth first */
+    if(node->type == XML_ELEMENT_NODE &&
+       node->children != NULL){
+      node = node->children;
+
+      continue;
+    }
+
+    while(node != NULL &&
+	  node->next == NULL){
+      node = node->parent;
+
+      if(node == root_node){
+	node = NULL;
+      }
+    }
+
+    if(node != NULL){
+      node = node->next;
+    }
+  }
+}
+
 void
 ags_simple_file_real_read(AgsSimpleFile *simple_file)
 {
@@ -1187,6 +1502,11 @@ ags_simple_file_real_read(AgsSimpleFile *simple_file)
   /* read config then window */
   ags_application_context_register_types(application_context);
 
+  /* load resources while the window is built */
+  ags_simple_file_read_preload(simple_file,
+			       root_node);
+  ags_resource_preloader_start(simple_file->resource_preloader);
+
 #if 0
   while(child != NULL){
     if(child->type == XML_ELEMENT_NODE){
@@ -1237,8 +1557,12 @@ ags_simple_file_real_read(AgsSimpleFile *simple_file)
   g_message("XML simple file connected");
 
   /* start */
+  ags_resource_preloader_join(simple_file->resource_preloader);
+  
   ags_simple_file_read_start(simple_file);
 
+  ags_resource_preloader_release(simple_file->resource_preloader);
+
   /* set file ready */
   ags_ui_provider_set_file_ready(AGS_UI_PROVIDER(application_context),
 				 TRUE);
@@ -2271,6 +2595,38 @@ ags_simple_file_read_machine(AgsSimpleFile *simple_file, xmlNode *node, AgsMachi
     ags_audio_unset_behaviour_flags(gobject->audio, (AGS_SOUND_BEHAVIOUR_REVERSE_MAPPING));
   }
 
+  if(str != NULL){
+    xmlFree(str);
+  }
+
+  /* hidden - the widgets are shown not until requested */
+  str = xmlGetProp(node,
+		   "hidden");
+  
+  if(str != NULL &&
+     !g_ascii_strncasecmp(str,
+			  "true",
+			  5)){
+    GtkWidget *child;
+    
+    GList *start_list;
+
+    start_list = gtk_container_get_children((GtkContainer *) gobject);
+
+    child = NULL;
+    
+    if(start_list != NULL){
+      child = gtk_bin_get_child(GTK_BIN(start_list->data));
+    }
+    
+    if(child != NULL){
+      gtk_widget_set_no_show_all(child,
+				 TRUE);
+    }
+    
+    g_list_free(start_list);
+  }
+
   if(str != NULL){
     xmlFree(str);
   }
@@ -2669,6 +3025,8 @@ ags_simple_file_read_machine(AgsSimpleFile *simple_file, xmlNode *node, AgsMachi
       }else if(!xmlStrncmp(child->name,
 			   (xmlChar *) "ags-sf-notation-list",
 			   21)){
+	GList *list;
+
 	gchar *version;
 
 	guint major, minor;
@@ -2696,6 +3054,14 @@ ags_simple_file_read_machine(AgsSimpleFile *simple_file, xmlNode *node, AgsMachi
 					     child,
 					     &(gobject->audio->notation));
 	}
+
+	list = gobject->audio->notation;
+
+	while(list != NULL){
+	  ags_notation_update_snapshot(list->data);
+
+	  list = list->next;
+	}
       }else if(!xmlStrncmp(child->name,
 			   (xmlChar *) "ags-sf-preset-list",
 			   21)){
@@ -5104,6 +5470,7 @@ ags_simple_file_read_line_launch(AgsFileLaunch *file_launch,
 			  7)){
     AgsAudioFile *audio_file;
     AgsAudioFileLink *file_link;
+    AgsAudioSignal *audio_signal;
     
     GList *audio_signal_list;
     
@@ -5128,16 +5495,29 @@ ags_simple_file_read_line_launch(AgsFileLaunch *file_launch,
       xmlFree(str);
     }
 
-    /* read audio signal */
-    audio_file = ags_audio_file_new(filename,
-				    machine->audio->output_soundcard,
-				    file_channel);
+    /* preloaded audio signal */
+    audio_signal = ags_resource_preloader_take_audio_signal(AGS_SIMPLE_FILE(file_launch->file)->resource_preloader,
+							    machine->audio->output_soundcard,
+							    filename,
+							    file_channel);
+
+    audio_signal_list = NULL;
 
-    ags_audio_file_open(audio_file);
-    ags_audio_file_read_audio_signal(audio_file);
+    if(audio_signal == NULL){
+      /* read audio signal */
+      audio_file = ags_audio_file_new(filename,
+				      machine->audio->output_soundcard,
+				      file_channel);
 
-    /* add audio signal */
-    audio_signal_list = audio_file->audio_signal;
+      ags_audio_file_open(audio_file);
+      ags_audio_file_read_audio_signal(audio_file);
+
+      /* add audio signal */
+      audio_signal_list = audio_file->audio_signal;
+    }else{
+      audio_signal_list = g_list_prepend(audio_signal_list,
+					 audio_signal);
+    }
 
     file_link = g_object_new(AGS_TYPE_AUDIO_FILE_LINK,
 			     "filename", filename,
@@ -5155,6 +5535,12 @@ ags_simple_file_read_line_launch(AgsFileLaunch *file_launch,
       ags_recycling_add_audio_signal(channel->first_recycling,
 				     audio_signal_list->data);
     }
+
+    if(audio_signal != NULL){
+      g_list_free(audio_signal_list);
+      
+      g_object_unref(audio_signal);
+    }
   }else{
     if(str != NULL){
       xmlFree(str);
@@ -5290,6 +5676,7 @@ ags_simple_file_read_channel_line_launch(AgsFileLaunch *file_launch,
 			  7)){
     AgsAudioFile *audio_file;
     AgsAudioFileLink *file_link;
+    AgsAudioSignal *audio_signal;
     
     GList *audio_signal_list;
     
@@ -5314,16 +5701,29 @@ ags_simple_file_read_channel_line_launch(AgsFileLaunch *file_launch,
       xmlFree(str);
     }
 
-    /* read audio signal */
-    audio_file = ags_audio_file_new(filename,
-				    channel->output_soundcard,
-				    file_channel);
+    /* preloaded audio signal */
+    audio_signal = ags_resource_preloader_take_audio_signal(AGS_SIMPLE_FILE(file_launch->file)->resource_preloader,
+							    channel->output_soundcard,
+							    filename,
+							    file_channel);
+
+    audio_signal_list = NULL;
 
-    ags_audio_file_open(audio_file);
-    ags_audio_file_read_audio_signal(audio_file);
+    if(audio_signal == NULL){
+      /* read audio signal */
+      audio_file = ags_audio_file_new(filename,
+				      channel->output_soundcard,
+				      file_channel);
 
-    /* add audio signal */
-    audio_signal_list = audio_file->audio_signal;
+      ags_audio_file_open(audio_file);
+      ags_audio_file_read_audio_signal(audio_file);
+
+      /* add audio signal */
+      audio_signal_list = audio_file->audio_signal;
+    }else{
+      audio_signal_list = g_list_prepend(audio_signal_list,
+					 audio_signal);
+    }
 
     file_link = g_object_new(AGS_TYPE_AUDIO_FILE_LINK,
 			     "filename", filename,
@@ -5341,6 +5741,12 @@ ags_simple_file_read_channel_line_launch(AgsFileLaunch *file_launch,
       ags_recycling_add_audio_signal(channel->first_recycling,
 				     audio_signal_list->data);
     }
+
+    if(audio_signal != NULL){
+      g_list_free(audio_signal_list);
+      
+      g_object_unref(audio_signal);
+    }
   }else{
     if(str != NULL){
       xmlFree(str);
@@ -8509,6 +8915,19 @@ ags_simple_file_write_machine(AgsSimpleFile *simple_file, xmlNode *parent, AgsMa
 	       "true");
   }
 
+  /* hidden */
+  list = gtk_container_get_children((GtkContainer *) machine);
+
+  if(list != NULL &&
+     gtk_bin_get_child(GTK_BIN(list->data)) != NULL &&
+     !gtk_widget_get_visible(gtk_bin_get_child(GTK_BIN(list->data)))){
+    xmlNewProp(node,
+	       "hidden",
+	       "true");
+  }
+
+  g_list_free(list);
+
   /* channels and pads */
   str = (xmlChar *) g_strdup_printf("%d",
 				    machine->audio->audio_channels);
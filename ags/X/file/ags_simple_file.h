@@ -24,6 +24,7 @@
 #include <glib-object.h>
 
 #include <libxml/tree.h>
+#include <libxml/xpath.h>
 
 #include <gtk/gtk.h>
 
@@ -94,6 +95,16 @@ struct _AgsSimpleFile
   xmlNode *root_node;
 
   GList *id_ref;
+
+  GHashTable *id_ref_node;
+  GHashTable *id_ref_reference;
+  GHashTable *id_ref_id;
+
+  xmlXPathContext *xpath_context;
+  GHashTable *xpath_expression;
+
+  AgsResourcePreloader *resource_preloader;
+  
   GList *lookup;
   GList *launch;
 };
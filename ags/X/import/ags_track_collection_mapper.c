@@ -527,6 +527,8 @@ ags_track_collection_mapper_apply(AgsApplicable *applicable)
   
   while(imported_notation != NULL){
     g_object_ref(imported_notation->data);
+
+    ags_notation_update_snapshot(imported_notation->data);
     
     imported_notation = imported_notation->next;
   }
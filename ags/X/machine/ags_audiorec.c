@@ -21,6 +21,7 @@
 #include <ags/X/machine/ags_audiorec_callbacks.h>
 
 #include <ags/X/ags_ui_provider.h>
+#include <ags/X/ags_meter_dispatcher.h>
 #include <ags/X/ags_window.h>
 
 #include <string.h>
@@ -357,7 +358,9 @@ ags_audiorec_init(AgsAudiorec *audiorec)
 
   g_hash_table_insert(ags_audiorec_indicator_queue_draw,
 		      audiorec, ags_audiorec_indicator_queue_draw_timeout);
-  g_timeout_add(AGS_UI_PROVIDER_DEFAULT_TIMEOUT * 1000.0, (GSourceFunc) ags_audiorec_indicator_queue_draw_timeout, (gpointer) audiorec);
+  ags_meter_dispatcher_add(ags_meter_dispatcher_get_instance(),
+			   (GtkWidget *) audiorec,
+			   (GSourceFunc) ags_audiorec_indicator_queue_draw_timeout);
 }
 
 void
@@ -933,11 +936,13 @@ ags_audiorec_indicator_queue_draw_timeout(AgsAudiorec *audiorec)
       AgsPort *current;
 
       GList *start_port;
+      GList *start_loudness_port, *start_true_peak_port;
+
+      gchar *str;
       
       gdouble average_peak;
       gdouble peak;
-	
-      GValue value = {0,};
+      gdouble loudness, true_peak;
 	
       child = list->data;
       
@@ -954,12 +959,10 @@ ags_audiorec_indicator_queue_draw_timeout(AgsAudiorec *audiorec)
       }
       
       /* recall port - read value */
-      g_value_init(&value, G_TYPE_FLOAT);
-      ags_port_safe_read(current,
-			 &value);
-      
-      peak = g_value_get_float(&value);
-      g_value_unset(&value);
+      peak = ags_meter_dispatcher_read(ags_meter_dispatcher_get_instance(),
+				       (GtkWidget *) audiorec,
+				       (GObject *) current,
+				       AGS_METER_SNAPSHOT_ENTRY_PORT);
 
       /* calculate peak */
       average_peak += peak;
@@ -972,6 +975,39 @@ ags_audiorec_indicator_queue_draw_timeout(AgsAudiorec *audiorec)
       gtk_adjustment_set_value(adjustment,
 			       10.0 * average_peak);
 
+      /* loudness and true-peak */
+      start_loudness_port = ags_channel_collect_all_channel_ports_by_specifier_and_context(channel,
+											  "./loudness[0]",
+											  FALSE);
+      start_true_peak_port = ags_channel_collect_all_channel_ports_by_specifier_and_context(channel,
+											   "./true-peak[0]",
+											   FALSE);
+
+      if(start_loudness_port != NULL &&
+	 start_true_peak_port != NULL){
+	loudness = ags_meter_dispatcher_read(ags_meter_dispatcher_get_instance(),
+					     (GtkWidget *) audiorec,
+					     (GObject *) start_loudness_port->data,
+					     AGS_METER_SNAPSHOT_ENTRY_PORT);
+	true_peak = ags_meter_dispatcher_read(ags_meter_dispatcher_get_instance(),
+					      (GtkWidget *) audiorec,
+					      (GObject *) start_true_peak_port->data,
+					      AGS_METER_SNAPSHOT_ENTRY_PORT);
+
+	str = g_strdup_printf("%.1f LUFS, %.1f dBTP",
+			      loudness,
+			      true_peak);
+	gtk_widget_set_tooltip_text(child,
+				    str);
+
+	g_free(str);
+      }
+
+      g_list_free_full(start_loudness_port,
+		       g_object_unref);
+      g_list_free_full(start_true_peak_port,
+		       g_object_unref);
+      
       /* queue draw */
       gtk_widget_queue_draw(child);
 
@@ -21,6 +21,7 @@
 #include <ags/X/machine/ags_drum_input_line_callbacks.h>
 
 #include <ags/X/ags_ui_provider.h>
+#include <ags/X/ags_meter_dispatcher.h>
 #include <ags/X/ags_window.h>
 #include <ags/X/ags_line_callbacks.h>
 #include <ags/X/ags_line_member.h>
@@ -145,7 +146,9 @@ ags_drum_input_line_init(AgsDrumInputLine *drum_input_line)
   AGS_LINE(drum_input_line)->indicator = widget;
   g_hash_table_insert(ags_line_indicator_queue_draw,
 		      widget, ags_line_indicator_queue_draw_timeout);
-  g_timeout_add(AGS_UI_PROVIDER_DEFAULT_TIMEOUT * 1000.0, (GSourceFunc) ags_line_indicator_queue_draw_timeout, (gpointer) widget);
+  ags_meter_dispatcher_add(ags_meter_dispatcher_get_instance(),
+			   widget,
+			   (GSourceFunc) ags_line_indicator_queue_draw_timeout);
 
   //TODO:JK: fix me
   //  g_object_set(G_OBJECT(line_member),
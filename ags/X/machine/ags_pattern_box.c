@@ -21,6 +21,7 @@
 #include <ags/X/machine/ags_pattern_box_callbacks.h>
 
 #include <ags/X/ags_ui_provider.h>
+#include <ags/X/ags_meter_dispatcher.h>
 #include <ags/X/ags_window.h>
 #include <ags/X/ags_machine.h>
 #include <ags/X/ags_pad.h>
@@ -267,7 +268,9 @@ ags_pattern_box_init(AgsPatternBox *pattern_box)
 
   g_hash_table_insert(ags_pattern_box_led_queue_draw,
 		      pattern_box, ags_pattern_box_led_queue_draw_timeout);
-  g_timeout_add((guint) floor(AGS_UI_PROVIDER_DEFAULT_TIMEOUT * 1000.0), (GSourceFunc) ags_pattern_box_led_queue_draw_timeout, (gpointer) pattern_box);
+  ags_meter_dispatcher_add(ags_meter_dispatcher_get_instance(),
+			   (GtkWidget *) pattern_box,
+			   (GSourceFunc) ags_pattern_box_led_queue_draw_timeout);
   
   /* pattern */
   pattern_box->pattern = (GtkHBox *) gtk_hbox_new(FALSE, 0);
@@ -807,19 +810,7 @@ ags_pattern_box_led_queue_draw_timeout(AgsPatternBox *pattern_box)
 			 pattern_box) != NULL){
     AgsMachine *machine;
 
-    AgsAudio *audio;
-    AgsRecallID *recall_id;
-    AgsRecyclingContext *recycling_context;
-    
-    AgsFxPatternAudio *play_fx_pattern_audio;
-    AgsFxPatternAudioProcessor *play_fx_pattern_audio_processor;
-
-    GList *start_list, *list;
-    GList *start_recall, *recall;
-    
     guint64 active_led_new;
-
-    GRecMutex *play_fx_pattern_audio_processor_mutex;
     
     machine = (AgsMachine *) gtk_widget_get_ancestor((GtkWidget *) pattern_box,
 						     AGS_TYPE_MACHINE);
@@ -828,90 +819,11 @@ ags_pattern_box_led_queue_draw_timeout(AgsPatternBox *pattern_box)
       return(TRUE);
     }
     
-    audio = machine->audio;
-    
-    /* get some recalls */
-    recall_id = NULL;
-    g_object_get(audio,
-		 "recall-id", &start_list,
-		 NULL);
-
-    list = start_list;
-    
-    while(list != NULL){
-      AgsRecyclingContext *current;
-
-      g_object_get(list->data,
-		   "recycling-context", &current,
-		   NULL);
-
-      g_object_unref(current);
-
-      if(current != NULL){
-	g_object_get(current,
-		     "parent", &current,
-		     NULL);
-
-	if(current != NULL){
-	  g_object_unref(current);
-	}
-	
-	if(current == NULL &&
-	   ags_recall_id_check_sound_scope(list->data, AGS_SOUND_SCOPE_SEQUENCER)){
-	  recall_id = list->data;
-
-	  g_object_get(audio,
-		       "play", &start_recall,
-		       NULL);
-
-	  play_fx_pattern_audio = NULL;
-	  play_fx_pattern_audio_processor = NULL;
-    
-	  recall = ags_recall_find_type(start_recall,
-					AGS_TYPE_FX_PATTERN_AUDIO);
-    
-	  if(recall != NULL){
-	    play_fx_pattern_audio = AGS_FX_PATTERN_AUDIO(recall->data);
-	  }
-    
-	  recall = ags_recall_find_type_with_recycling_context(start_recall,
-							       AGS_TYPE_FX_PATTERN_AUDIO_PROCESSOR,
-							       (GObject *) recall_id->recycling_context);
-    
-	  if(recall != NULL){
-	    play_fx_pattern_audio_processor = AGS_FX_PATTERN_AUDIO_PROCESSOR(recall->data);
-	  }
-
-	  g_list_free_full(start_recall,
-			   g_object_unref);
-
-	  if(play_fx_pattern_audio == NULL ||
-	     play_fx_pattern_audio_processor == NULL){
-	    recall_id = NULL;
-	  }else{
-	    break;
-	  }
-	}
-      }
-
-      list = list->next;
-    }
-
-    g_list_free_full(start_list,
-		     g_object_unref);
-    
-    if(recall_id == NULL){      
-      return(TRUE);
-    }
-    
-    /* active led */
-    play_fx_pattern_audio_processor_mutex = AGS_RECALL_GET_OBJ_MUTEX(play_fx_pattern_audio_processor);
-
-    g_rec_mutex_lock(play_fx_pattern_audio_processor_mutex);
-
-    active_led_new = play_fx_pattern_audio_processor->offset_counter;
-    
-    g_rec_mutex_unlock(play_fx_pattern_audio_processor_mutex);
+    /* active led - published by the engine once per period */
+    active_led_new = (guint64) ags_meter_dispatcher_read(ags_meter_dispatcher_get_instance(),
+							 (GtkWidget *) pattern_box,
+							 (GObject *) machine->audio,
+							 AGS_METER_SNAPSHOT_ENTRY_PUSHED);
 
     pattern_box->active_led = (guint) (active_led_new % pattern_box->n_controls);
 
@@ -49,6 +49,8 @@
 
 #include <ags/audio/midi/ags_midi_file.h>
 
+#include <ags/audio/osc/ags_osc_address_trie.h>
+
 #include <ags/audio/recall/ags_count_beats_audio_run.h>
 
 #include <ags/audio/fx/ags_fx_playback_audio_processor.h>
@@ -1823,13 +1825,26 @@ ags_audio_set_property(GObject *gobject,
   {
     gchar *audio_name;
 
+    gboolean is_renamed;
+    
     audio_name = g_value_get_string(value);
 
     g_rec_mutex_lock(audio_mutex);
-      
-    audio->audio_name = g_strdup(audio_name);
 
+    is_renamed = (g_strcmp0(audio->audio_name, audio_name) != 0) ? TRUE: FALSE;
+
+    if(is_renamed){
+      g_free(audio->audio_name);
+      
+      audio->audio_name = g_strdup(audio_name);
+    }
+    
     g_rec_mutex_unlock(audio_mutex);
+
+    /* OSC addresses of the old and the new name resolve differently */
+    if(is_renamed){
+      ags_osc_address_trie_invalidate();
+    }
   }
   break;
   case PROP_OUTPUT_SOUNDCARD:
@@ -6216,8 +6231,8 @@ ags_audio_real_set_audio_channels(AgsAudio *audio,
   AgsChannel *start_channel, *channel, *nth_channel, *next_channel;
 
   AgsMessageDelivery *message_delivery;
+  AgsMessage *typed_message;
 
-  GList *start_message_queue;
 
   guint bank_dim[3];
 
@@ -6556,65 +6571,23 @@ ags_audio_real_set_audio_channels(AgsAudio *audio,
   /* emit message */
   message_delivery = ags_message_delivery_get_instance();
 
-  start_message_queue = ags_message_delivery_find_sender_namespace(message_delivery,
-								   "libags-audio");
-
-  if(start_message_queue != NULL){
-    AgsMessageEnvelope *message;
-
-    xmlDoc *doc;
-    xmlNode *root_node;
-
-    /* specify message body */
-    doc = xmlNewDoc("1.0");
+  /* post to subscribers and the libags-audio message queue */
+  typed_message = ags_message_alloc((GObject *) audio,
+				    "AgsAudio::set-audio-channels",
+				    2);
 
-    root_node = xmlNewNode(NULL,
-			   "ags-command");
-    xmlDocSetRootElement(doc, root_node);    
+  typed_message->sender_namespace = "libags-audio";
 
-    xmlNewProp(root_node,
-	       "method",
-	       "AgsAudio::set-audio-channels");
+  typed_message->parameter_name[0] = "audio-channels";
+  typed_message->value_type[0] = G_TYPE_UINT;
+  typed_message->value[0].uint_value = audio_channels;
 
-    /* add message */
-    message = ags_message_envelope_new((GObject *) audio,
-				       NULL,
-				       doc);
+  typed_message->parameter_name[1] = "audio-channels-old";
+  typed_message->value_type[1] = G_TYPE_UINT;
+  typed_message->value[1].uint_value = audio_channels_old;
 
-    /* set parameter */
-    message->n_params = 2;
-
-    message->parameter_name = (gchar **) malloc(3 * sizeof(gchar *));
-    message->value = g_new0(GValue,
-			    2);
-
-    /* audio channels */
-    message->parameter_name[0] = "audio-channels";
-    
-    g_value_init(&(message->value[0]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[0]),
-		     audio_channels);
-
-    /* audio channels old */
-    message->parameter_name[1] = "audio-channels-old";
-    
-    g_value_init(&(message->value[1]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[1]),
-		     audio_channels_old);
-    
-    /* terminate string vector */
-    message->parameter_name[2] = NULL;
-    
-    /* add message */
-    ags_message_delivery_add_message_envelope(message_delivery,
-					      "libags-audio",
-					      message);
-
-    g_list_free_full(start_message_queue,
-		     (GDestroyNotify) g_object_unref);
-  }
+  ags_message_delivery_post(message_delivery,
+			    typed_message);
 }
 
 /**
@@ -6651,6 +6624,9 @@ ags_audio_set_audio_channels(AgsAudio *audio,
 		audio_signals[SET_AUDIO_CHANNELS], 0,
 		audio_channels, audio_channels_old);
   g_object_unref((GObject *) audio);
+
+  /* invalidate OSC addresses */
+  ags_osc_address_trie_invalidate();
 }
 
 /**
@@ -7166,6 +7142,9 @@ ags_audio_set_pads_remove_notes(AgsAudio *audio,
 							   note->data);
 	  
 	g_object_unref(note->data);
+
+	g_atomic_int_set(&(AGS_NOTATION(notation->data)->snapshot_dirty),
+			 TRUE);
       }
 
       note = note->next;
@@ -7313,8 +7292,8 @@ ags_audio_real_set_pads(AgsAudio *audio,
   AgsPlaybackDomain *playback_domain;
   
   AgsMessageDelivery *message_delivery;
+  AgsMessage *typed_message;
 
-  GList *start_message_queue;
   
   guint bank_dim[3];
 
@@ -7813,72 +7792,27 @@ ags_audio_real_set_pads(AgsAudio *audio,
   /* emit message */
   message_delivery = ags_message_delivery_get_instance();
 
-  start_message_queue = ags_message_delivery_find_sender_namespace(message_delivery,
-								   "libags-audio");
+  /* post to subscribers and the libags-audio message queue */
+  typed_message = ags_message_alloc((GObject *) audio,
+				    "AgsAudio::set-pads",
+				    3);
 
-  if(start_message_queue != NULL){
-    AgsMessageEnvelope *message;
-
-    xmlDoc *doc;
-    xmlNode *root_node;
+  typed_message->sender_namespace = "libags-audio";
 
-    /* specify message body */
-    doc = xmlNewDoc("1.0");
+  typed_message->parameter_name[0] = "channel-type";
+  typed_message->value_type[0] = G_TYPE_ULONG;
+  typed_message->value[0].uint_value = channel_type;
 
-    root_node = xmlNewNode(NULL,
-			   "ags-command");
-    xmlDocSetRootElement(doc, root_node);    
+  typed_message->parameter_name[1] = "pads";
+  typed_message->value_type[1] = G_TYPE_UINT;
+  typed_message->value[1].uint_value = pads;
 
-    xmlNewProp(root_node,
-	       "method",
-	       "AgsAudio::set-pads");
+  typed_message->parameter_name[2] = "pads-old";
+  typed_message->value_type[2] = G_TYPE_UINT;
+  typed_message->value[2].uint_value = pads_old;
 
-    /* add message */
-    message = ags_message_envelope_new((GObject *) audio,
-				       NULL,
-				       doc);
-    /* set parameter */
-    message->n_params = 3;
-
-    message->parameter_name = (gchar *) malloc(4 * sizeof(gchar *));
-    message->value = g_new0(GValue,
-			    3);
-
-    /* channel type */
-    message->parameter_name[0] = "channel-type";
-    
-    g_value_init(&(message->value[0]),
-		 G_TYPE_ULONG);
-    g_value_set_ulong(&(message->value[0]),
-		      channel_type);
-
-    /* pads */
-    message->parameter_name[1] = "pads";
-    
-    g_value_init(&(message->value[1]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[1]),
-		     pads);
-
-    /* pads old */
-    message->parameter_name[2] = "pads-old";
-    
-    g_value_init(&(message->value[2]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[2]),
-		     pads_old);
-
-    /* terminate string vector */
-    message->parameter_name[3] = NULL;
-    
-    /* add message */
-    ags_message_delivery_add_message_envelope(message_delivery,
-					      "libags-audio",
-					      message);
-
-    g_list_free_full(start_message_queue,
-		     (GDestroyNotify) g_object_unref);
-  }
+  ags_message_delivery_post(message_delivery,
+			    typed_message);
 }
 
 /**
@@ -7918,6 +7852,9 @@ ags_audio_set_pads(AgsAudio *audio,
 		channel_type,
 		pads, pads_old);
   g_object_unref((GObject *) audio);  
+
+  /* invalidate OSC addresses */
+  ags_osc_address_trie_invalidate();
 }
 
 /**
@@ -8677,8 +8614,8 @@ ags_audio_real_set_samplerate(AgsAudio *audio, guint samplerate)
   
   AgsThread *audio_thread;
   AgsMessageDelivery *message_delivery;
+  AgsMessage *typed_message;
 
-  GList *start_message_queue;
   GList *start_list, *list;
 
   gdouble frequency;
@@ -8759,65 +8696,23 @@ ags_audio_real_set_samplerate(AgsAudio *audio, guint samplerate)
   /* emit message */
   message_delivery = ags_message_delivery_get_instance();
 
-  start_message_queue = ags_message_delivery_find_sender_namespace(message_delivery,
-								   "libags-audio");
-
-  if(start_message_queue != NULL){
-    AgsMessageEnvelope *message;
-
-    xmlDoc *doc;
-    xmlNode *root_node;
-
-    /* specify message body */
-    doc = xmlNewDoc("1.0");
+  /* post to subscribers and the libags-audio message queue */
+  typed_message = ags_message_alloc((GObject *) audio,
+				    "AgsAudio::set-samplerate",
+				    2);
 
-    root_node = xmlNewNode(NULL,
-			   "ags-command");
-    xmlDocSetRootElement(doc, root_node);    
+  typed_message->sender_namespace = "libags-audio";
 
-    xmlNewProp(root_node,
-	       "method",
-	       "AgsAudio::set-samplerate");
+  typed_message->parameter_name[0] = "samplerate";
+  typed_message->value_type[0] = G_TYPE_UINT;
+  typed_message->value[0].uint_value = samplerate;
 
-    /* add message */
-    message = ags_message_envelope_new((GObject *) audio,
-				       NULL,
-				       doc);
-
-    /* set parameter */
-    message->n_params = 2;
-
-    message->parameter_name = (gchar **) malloc(3 * sizeof(gchar *));
-    message->value = g_new0(GValue,
-			    2);
+  typed_message->parameter_name[1] = "old-samplerate";
+  typed_message->value_type[1] = G_TYPE_UINT;
+  typed_message->value[1].uint_value = old_samplerate;
 
-    /* samplerate */
-    message->parameter_name[0] = "samplerate";
-    
-    g_value_init(&(message->value[0]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[0]),
-		     samplerate);
-
-    /* old samplerate */
-    message->parameter_name[1] = "old-samplerate";
-    
-    g_value_init(&(message->value[1]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[1]),
-		     old_samplerate);
-
-    /* terminate string vector */
-    message->parameter_name[2] = NULL;
-    
-    /* add message */
-    ags_message_delivery_add_message_envelope(message_delivery,
-					      "libags-audio",
-					      message);
-
-    g_list_free_full(start_message_queue,
-		     (GDestroyNotify) g_object_unref);
-  }
+  ags_message_delivery_post(message_delivery,
+			    typed_message);
 }
 
 /**
@@ -8902,8 +8797,8 @@ ags_audio_real_set_buffer_size(AgsAudio *audio, guint buffer_size)
 
   AgsThread *audio_thread;
   AgsMessageDelivery *message_delivery;
+  AgsMessage *typed_message;
 
-  GList *start_message_queue;
   GList *start_list, *list;
   
   gdouble frequency;
@@ -8984,65 +8879,23 @@ ags_audio_real_set_buffer_size(AgsAudio *audio, guint buffer_size)
   /* emit message */
   message_delivery = ags_message_delivery_get_instance();
 
-  start_message_queue = ags_message_delivery_find_sender_namespace(message_delivery,
-								   "libags-audio");
-
-  if(start_message_queue != NULL){
-    AgsMessageEnvelope *message;
-
-    xmlDoc *doc;
-    xmlNode *root_node;
+  /* post to subscribers and the libags-audio message queue */
+  typed_message = ags_message_alloc((GObject *) audio,
+				    "AgsAudio::set-buffer-size",
+				    2);
 
-    /* specify message body */
-    doc = xmlNewDoc("1.0");
-
-    root_node = xmlNewNode(NULL,
-			   "ags-command");
-    xmlDocSetRootElement(doc, root_node);    
-
-    xmlNewProp(root_node,
-	       "method",
-	       "AgsAudio::set-buffer-size");
+  typed_message->sender_namespace = "libags-audio";
 
-    /* add message */
-    message = ags_message_envelope_new((GObject *) audio,
-				       NULL,
-				       doc);
-
-    /* set parameter */
-    message->n_params = 2;
-
-    message->parameter_name = (gchar **) malloc(3 * sizeof(gchar *));
-    message->value = g_new0(GValue,
-			    2);
-
-    /* buffer_size */
-    message->parameter_name[0] = "buffer-size";
-    
-    g_value_init(&(message->value[0]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[0]),
-		     buffer_size);
-
-    /* old buffer_size */
-    message->parameter_name[1] = "old-buffer-size";
-    
-    g_value_init(&(message->value[1]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[1]),
-		     old_buffer_size);
+  typed_message->parameter_name[0] = "buffer-size";
+  typed_message->value_type[0] = G_TYPE_UINT;
+  typed_message->value[0].uint_value = buffer_size;
 
-    /* terminate string vector */
-    message->parameter_name[2] = NULL;
-    
-    /* add message */
-    ags_message_delivery_add_message_envelope(message_delivery,
-					      "libags-audio",
-					      message);
+  typed_message->parameter_name[1] = "old-buffer-size";
+  typed_message->value_type[1] = G_TYPE_UINT;
+  typed_message->value[1].uint_value = old_buffer_size;
 
-    g_list_free_full(start_message_queue,
-		     (GDestroyNotify) g_object_unref);
-  }
+  ags_message_delivery_post(message_delivery,
+			    typed_message);
 }
 
 /**
@@ -9125,8 +8978,8 @@ ags_audio_real_set_format(AgsAudio *audio, guint format)
   AgsChannel *start_output, *start_input;
   
   AgsMessageDelivery *message_delivery;
+  AgsMessage *typed_message;
 
-  GList *start_message_queue;
   GList *start_list, *list;
 
   guint old_format;
@@ -9185,65 +9038,23 @@ ags_audio_real_set_format(AgsAudio *audio, guint format)
   /* emit message */
   message_delivery = ags_message_delivery_get_instance();
 
-  start_message_queue = ags_message_delivery_find_sender_namespace(message_delivery,
-								   "libags-audio");
-
-  if(start_message_queue != NULL){
-    AgsMessageEnvelope *message;
-
-    xmlDoc *doc;
-    xmlNode *root_node;
-
-    /* specify message body */
-    doc = xmlNewDoc("1.0");
-
-    root_node = xmlNewNode(NULL,
-			   "ags-command");
-    xmlDocSetRootElement(doc, root_node);    
-
-    xmlNewProp(root_node,
-	       "method",
-	       "AgsAudio::set-format");
-
-    /* add message */
-    message = ags_message_envelope_new((GObject *) audio,
-				       NULL,
-				       doc);
-
-    /* set parameter */
-    message->n_params = 2;
-
-    message->parameter_name = (gchar **) malloc(3 * sizeof(gchar *));
-    message->value = g_new0(GValue,
-			    2);
+  /* post to subscribers and the libags-audio message queue */
+  typed_message = ags_message_alloc((GObject *) audio,
+				    "AgsAudio::set-format",
+				    2);
 
-    /* format */
-    message->parameter_name[0] = "format";
-    
-    g_value_init(&(message->value[0]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[0]),
-		     format);
+  typed_message->sender_namespace = "libags-audio";
 
-    /* old format */
-    message->parameter_name[1] = "old-format";
-    
-    g_value_init(&(message->value[1]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[1]),
-		     old_format);
+  typed_message->parameter_name[0] = "format";
+  typed_message->value_type[0] = G_TYPE_UINT;
+  typed_message->value[0].uint_value = format;
 
-    /* terminate string vector */
-    message->parameter_name[2] = NULL;
-    
-    /* add message */
-    ags_message_delivery_add_message_envelope(message_delivery,
-					      "libags-audio",
-					      message);
+  typed_message->parameter_name[1] = "old-format";
+  typed_message->value_type[1] = G_TYPE_UINT;
+  typed_message->value[1].uint_value = old_format;
 
-    g_list_free_full(start_message_queue,
-		     (GDestroyNotify) g_object_unref);
-  }
+  ags_message_delivery_post(message_delivery,
+			    typed_message);
 }
 
 /**
@@ -12250,6 +12061,9 @@ ags_audio_add_recall(AgsAudio *audio, GObject *recall,
 		   NULL);
     }
   }
+
+  /* invalidate OSC addresses */
+  ags_osc_address_trie_invalidate();
 }
 
 /**
@@ -12327,6 +12141,9 @@ ags_audio_insert_recall(AgsAudio *audio, GObject *recall,
 		   NULL);
     }
   }
+
+  /* invalidate OSC addresses */
+  ags_osc_address_trie_invalidate();
 }
 
 /**
@@ -12396,6 +12213,9 @@ ags_audio_remove_recall(AgsAudio *audio, GObject *recall,
     g_object_unref(G_OBJECT(recall));
   }
 #endif
+
+  /* invalidate OSC addresses */
+  ags_osc_address_trie_invalidate();
 }
 
 void
@@ -14202,11 +14022,11 @@ ags_audio_real_stop(AgsAudio *audio,
   AgsThread *audio_thread;
   AgsThread *channel_thread;
   AgsMessageDelivery *message_delivery;
+  AgsMessage *typed_message;
 
   AgsApplicationContext *application_context;
 
   GList *list;
-  GList *start_message_queue;
   GList *start_output_playback, *output_playback;
   GList *sequencer, *notation, *wave, *midi;
   
@@ -14412,65 +14232,24 @@ ags_audio_real_stop(AgsAudio *audio,
   /* emit message */
   message_delivery = ags_message_delivery_get_instance();
 
-  start_message_queue = ags_message_delivery_find_sender_namespace(message_delivery,
-								   "libags-audio");
-
-  if(start_message_queue != NULL){
-    AgsMessageEnvelope *message;
-
-    xmlDoc *doc;
-    xmlNode *root_node;
-
-    /* specify message body */
-    doc = xmlNewDoc("1.0");
-
-    root_node = xmlNewNode(NULL,
-			   "ags-command");
-    xmlDocSetRootElement(doc, root_node);    
+  /* post to subscribers and the libags-audio message queue */
+  typed_message = ags_message_alloc((GObject *) audio,
+				    "AgsAudio::stop",
+				    2);
 
-    xmlNewProp(root_node,
-	       "method",
-	       "AgsAudio::stop");
+  typed_message->sender_namespace = "libags-audio";
 
-    /* add message */
-    message = ags_message_envelope_new((GObject *) audio,
-				       NULL,
-				       doc);
+  ags_message_set_object_list(typed_message,
+			      0,
+			      "recall-id",
+			      recall_id);
 
-    /* set parameter */
-    message->n_params = 2;
-
-    message->parameter_name = (gchar **) malloc(3 * sizeof(gchar *));
-    message->value = g_new0(GValue,
-			    2);
+  typed_message->parameter_name[1] = "sound-scope";
+  typed_message->value_type[1] = G_TYPE_INT;
+  typed_message->value[1].int_value = sound_scope;
 
-    /* recall id */
-    message->parameter_name[0] = "recall-id";
-    
-    g_value_init(&(message->value[0]),
-		 G_TYPE_POINTER);
-    g_value_set_pointer(&(message->value[0]),
-			recall_id);
-
-    /* sound scope */
-    message->parameter_name[1] = "sound-scope";
-    
-    g_value_init(&(message->value[1]),
-		 G_TYPE_INT);
-    g_value_set_int(&(message->value[1]),
-		    sound_scope);
-
-    /* terminate string vector */
-    message->parameter_name[2] = NULL;
-
-    /* add message */
-    ags_message_delivery_add_message_envelope(message_delivery,
-					      "libags-audio",
-					      message);
-
-    g_list_free_full(start_message_queue,
-		     (GDestroyNotify) g_object_unref);
-  }
+  ags_message_delivery_post(message_delivery,
+			    typed_message);
 }
 
 /**
@@ -1823,6 +1823,13 @@ ags_audio_application_context_setup(AgsApplicationContext *application_context)
 
   task_launcher = ags_concurrency_provider_get_task_launcher(AGS_CONCURRENCY_PROVIDER(application_context));
 
+  /* timing monitor */
+#ifndef AGS_W32API
+  ags_timing_monitor_dump_on_signal(ags_timing_monitor_get_instance(),
+				    SIGUSR2,
+				    NULL);
+#endif
+
 #if 0  //NOTE:JK: huh zombies might come to here
   atexit(ags_audio_application_context_signal_cleanup);
 
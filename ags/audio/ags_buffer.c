@@ -26,6 +26,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 
 void ags_buffer_class_init(AgsBufferClass *buffer);
 void ags_buffer_init(AgsBuffer *buffer);
@@ -39,6 +40,11 @@ void ags_buffer_get_property(GObject *gobject,
 			     GParamSpec *param_spec);
 void ags_buffer_finalize(GObject *gobject);
 
+void ags_buffer_free_peak(AgsBuffer *buffer);
+gdouble ags_buffer_peak_sample(void *data,
+			       guint format,
+			       guint offset);
+
 /**
  * SECTION:ags_buffer
  * @short_description: Buffer class.
@@ -47,6 +53,11 @@ void ags_buffer_finalize(GObject *gobject);
  * @include: ags/audio/ags_buffer.h
  *
  * #AgsBuffer represents a tone.
+ *
+ * For display every buffer keeps a min/max/RMS peak pyramid, level n
+ * summarizes #AGS_BUFFER_PEAK_DECIMATION times 2 to the power of n frames.
+ * Writers mark the modified range by ags_buffer_invalidate_peak() and
+ * the pyramid is updated lazily for this range only.
  */
 
 enum{
@@ -259,6 +270,15 @@ ags_buffer_init(AgsBuffer *buffer)
 
   buffer->data = ags_stream_alloc(buffer->buffer_size,
 				  buffer->format);
+
+  /* peak */
+  buffer->peak_levels = 0;
+  buffer->peak = NULL;
+
+  buffer->peak_dirty_start = 0;
+  buffer->peak_dirty_end = buffer->buffer_size;
+
+  buffer->peak_serial = 0;
 }
 
 void
@@ -340,6 +360,8 @@ ags_buffer_set_property(GObject *gobject,
 
       buffer->data = g_value_get_pointer(value);
 
+      ags_buffer_free_peak(buffer);
+      
       g_rec_mutex_unlock(buffer_mutex);
     }
     break;
@@ -451,6 +473,8 @@ ags_buffer_finalize(GObject *gobject)
   if(buffer->data != NULL){
     free(buffer->data);
   }
+
+  ags_buffer_free_peak(buffer);
   
   /* call parent */
   G_OBJECT_CLASS(ags_buffer_parent_class)->finalize(gobject);
@@ -862,6 +886,8 @@ ags_buffer_set_buffer_size(AgsBuffer *buffer,
     memset(buffer->data + old_buffer_size, 0, (buffer_size - old_buffer_size) * word_size);
   }
 
+  ags_buffer_free_peak(buffer);
+
   g_rec_mutex_unlock(buffer_mutex);
 }
 
@@ -942,6 +968,8 @@ ags_buffer_set_format(AgsBuffer *buffer,
 
   buffer->format = format;
 
+  ags_buffer_free_peak(buffer);
+
   g_rec_mutex_unlock(buffer_mutex);
 }
 
@@ -979,6 +1007,392 @@ ags_buffer_get_data(AgsBuffer *buffer)
   return(data);
 }
 
+void
+ags_buffer_free_peak(AgsBuffer *buffer)
+{
+  guint i;
+  
+  if(buffer->peak != NULL){
+    for(i = 0; i < buffer->peak_levels; i++){
+      g_free(buffer->peak[i]);
+    }
+
+    g_free(buffer->peak);
+  }
+
+  buffer->peak_levels = 0;
+  buffer->peak = NULL;
+
+  buffer->peak_dirty_start = 0;
+  buffer->peak_dirty_end = buffer->buffer_size;
+
+  g_atomic_int_inc(&(buffer->peak_serial));
+}
+
+gdouble
+ags_buffer_peak_sample(void *data,
+		       guint format,
+		       guint offset)
+{
+  gdouble sample;
+
+  sample = 0.0;
+  
+  switch(format){
+  case AGS_SOUNDCARD_SIGNED_8_BIT:
+  {
+    sample = (gdouble) ((gint8 *) data)[offset] / exp2(7.0);
+  }
+  break;
+  case AGS_SOUNDCARD_SIGNED_16_BIT:
+  {
+    sample = (gdouble) ((gint16 *) data)[offset] / exp2(15.0);
+  }
+  break;
+  case AGS_SOUNDCARD_SIGNED_24_BIT:
+  {
+    sample = (gdouble) ((gint32 *) data)[offset] / exp2(23.0);
+  }
+  break;
+  case AGS_SOUNDCARD_SIGNED_32_BIT:
+  {
+    sample = (gdouble) ((gint32 *) data)[offset] / exp2(31.0);
+  }
+  break;
+  case AGS_SOUNDCARD_SIGNED_64_BIT:
+  {
+    sample = (gdouble) ((gint64 *) data)[offset] / exp2(63.0);
+  }
+  break;
+  case AGS_SOUNDCARD_FLOAT:
+  {
+    sample = (gdouble) ((gfloat *) data)[offset];
+  }
+  break;
+  case AGS_SOUNDCARD_DOUBLE:
+  {
+    sample = ((gdouble *) data)[offset];
+  }
+  break;
+  }
+
+  return(sample);
+}
+
+/**
+ * ags_buffer_invalidate_peak:
+ * @buffer: the #AgsBuffer
+ * @offset: the first modified frame
+ * @count: the count of modified frames
+ * 
+ * Mark the peaks of @count frames at @offset outdated, call it after
+ * writing the data of @buffer. This is cheap and safe to call from the
+ * audio thread.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_buffer_invalidate_peak(AgsBuffer *buffer,
+			   guint offset, guint count)
+{
+  guint end;
+  
+  GRecMutex *buffer_mutex;
+
+  if(!AGS_IS_BUFFER(buffer) ||
+     count == 0){
+    return;
+  }
+      
+  /* get buffer mutex */
+  buffer_mutex = AGS_BUFFER_GET_OBJ_MUTEX(buffer);
+
+  /* invalidate */
+  g_rec_mutex_lock(buffer_mutex);
+
+  end = offset + count;
+
+  if(end > buffer->buffer_size){
+    end = buffer->buffer_size;
+  }
+  
+  if(offset < buffer->peak_dirty_start){
+    buffer->peak_dirty_start = offset;
+  }
+
+  if(end > buffer->peak_dirty_end){
+    buffer->peak_dirty_end = end;
+  }
+
+  /* tells the peaks of the wave to update */
+  g_atomic_int_inc(&(buffer->peak_serial));
+  
+  g_rec_mutex_unlock(buffer_mutex);
+}
+
+/**
+ * ags_buffer_update_peak:
+ * @buffer: the #AgsBuffer
+ * 
+ * Update the outdated peaks of @buffer, the levels above the first one
+ * are computed of the level below.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_buffer_update_peak(AgsBuffer *buffer)
+{
+  AgsBufferPeak *peak, *child_peak;
+
+  guint buffer_size;
+  guint decimation;
+  guint n_peaks, n_child_peaks;
+  guint start, end;
+  guint offset, frame_end;
+  guint level;
+  guint i, j;
+  
+  GRecMutex *buffer_mutex;
+
+  if(!AGS_IS_BUFFER(buffer)){
+    return;
+  }
+      
+  /* get buffer mutex */
+  buffer_mutex = AGS_BUFFER_GET_OBJ_MUTEX(buffer);
+
+  g_rec_mutex_lock(buffer_mutex);
+
+  buffer_size = buffer->buffer_size;
+  
+  if(buffer_size == 0 ||
+     buffer->data == NULL ||
+     (buffer->peak != NULL &&
+      buffer->peak_dirty_start >= buffer->peak_dirty_end)){
+    g_rec_mutex_unlock(buffer_mutex);
+
+    return;
+  }
+  
+  /* allocate - the top level summarizes the whole buffer */
+  if(buffer->peak == NULL){
+    buffer->peak_levels = 1;
+
+    while((AGS_BUFFER_PEAK_DECIMATION << (buffer->peak_levels - 1)) < buffer_size){
+      buffer->peak_levels += 1;
+    }
+
+    buffer->peak = (AgsBufferPeak **) g_malloc(buffer->peak_levels * sizeof(AgsBufferPeak *));
+
+    for(level = 0; level < buffer->peak_levels; level++){
+      decimation = AGS_BUFFER_PEAK_DECIMATION << level;
+      
+      buffer->peak[level] = (AgsBufferPeak *) g_malloc0(((buffer_size + decimation - 1) / decimation) * sizeof(AgsBufferPeak));
+    }
+
+    buffer->peak_dirty_start = 0;
+    buffer->peak_dirty_end = buffer_size;
+  }
+
+  /* first level of data */
+  start = buffer->peak_dirty_start / AGS_BUFFER_PEAK_DECIMATION;
+  end = (buffer->peak_dirty_end + AGS_BUFFER_PEAK_DECIMATION - 1) / AGS_BUFFER_PEAK_DECIMATION;
+
+  peak = buffer->peak[0];
+  
+  for(i = start; i < end; i++){
+    gdouble sample;
+    gdouble min, max;
+    gdouble sum;
+    
+    offset = i * AGS_BUFFER_PEAK_DECIMATION;
+    frame_end = offset + AGS_BUFFER_PEAK_DECIMATION;
+
+    if(frame_end > buffer_size){
+      frame_end = buffer_size;
+    }
+
+    min = 1.0;
+    max = -1.0;
+    
+    sum = 0.0;
+    
+    for(j = offset; j < frame_end; j++){
+      sample = ags_buffer_peak_sample(buffer->data,
+				      buffer->format,
+				      j);
+
+      if(sample < min){
+	min = sample;
+      }
+
+      if(sample > max){
+	max = sample;
+      }
+
+      sum += sample * sample;
+    }
+
+    peak[i].min = (gfloat) min;
+    peak[i].max = (gfloat) max;
+    peak[i].rms = (gfloat) sqrt(sum / (gdouble) (frame_end - offset));
+  }
+
+  /* upper levels of the level below */
+  for(level = 1; level < buffer->peak_levels; level++){
+    decimation = AGS_BUFFER_PEAK_DECIMATION << level;
+
+    n_peaks = (buffer_size + decimation - 1) / decimation;
+    n_child_peaks = (buffer_size + (decimation / 2) - 1) / (decimation / 2);
+    
+    start = start / 2;
+    end = (end + 1) / 2;
+
+    if(end > n_peaks){
+      end = n_peaks;
+    }
+    
+    peak = buffer->peak[level];
+    child_peak = buffer->peak[level - 1];
+
+    for(i = start; i < end; i++){
+      peak[i] = child_peak[2 * i];
+
+      if(2 * i + 1 < n_child_peaks){
+	if(child_peak[2 * i + 1].min < peak[i].min){
+	  peak[i].min = child_peak[2 * i + 1].min;
+	}
+
+	if(child_peak[2 * i + 1].max > peak[i].max){
+	  peak[i].max = child_peak[2 * i + 1].max;
+	}
+
+	peak[i].rms = (gfloat) sqrt(0.5 * ((gdouble) child_peak[2 * i].rms * (gdouble) child_peak[2 * i].rms +
+					   (gdouble) child_peak[2 * i + 1].rms * (gdouble) child_peak[2 * i + 1].rms));
+      }
+    }
+  }
+
+  buffer->peak_dirty_start = buffer_size;
+  buffer->peak_dirty_end = 0;
+  
+  g_rec_mutex_unlock(buffer_mutex);
+}
+
+/**
+ * ags_buffer_find_peak_level:
+ * @buffer: the #AgsBuffer
+ * @frames_per_pixel: the frames a pixel of the display covers
+ * 
+ * Find the coarsest peak level of @buffer that still has a peak per
+ * pixel.
+ * 
+ * Returns: the level to pass to ags_buffer_get_peak()
+ * 
+ * Since: 3.5.0
+ */
+guint
+ags_buffer_find_peak_level(AgsBuffer *buffer,
+			   gdouble frames_per_pixel)
+{
+  guint buffer_size;
+  guint level;
+  
+  GRecMutex *buffer_mutex;
+
+  if(!AGS_IS_BUFFER(buffer)){
+    return(0);
+  }
+      
+  /* get buffer mutex */
+  buffer_mutex = AGS_BUFFER_GET_OBJ_MUTEX(buffer);
+
+  g_rec_mutex_lock(buffer_mutex);
+
+  buffer_size = buffer->buffer_size;
+  
+  g_rec_mutex_unlock(buffer_mutex);
+
+  level = 0;
+  
+  while((gdouble) (AGS_BUFFER_PEAK_DECIMATION << (level + 1)) <= frames_per_pixel &&
+	(AGS_BUFFER_PEAK_DECIMATION << level) < buffer_size){
+    level++;
+  }
+  
+  return(level);
+}
+
+/**
+ * ags_buffer_get_peak:
+ * @buffer: the #AgsBuffer
+ * @level: the level, see ags_buffer_find_peak_level()
+ * @n_peaks: (out): return location of the count of peaks
+ * @decimation: (out): return location of the frames per peak
+ * 
+ * Get the peaks of @level, outdated peaks are updated first. The
+ * peaks are owned by @buffer, keep it locked while reading them.
+ * 
+ * Returns: (transfer none): the #AgsBufferPeak-struct array or %NULL
+ * 
+ * Since: 3.5.0
+ */
+AgsBufferPeak*
+ags_buffer_get_peak(AgsBuffer *buffer,
+		    guint level,
+		    guint *n_peaks,
+		    guint *decimation)
+{
+  AgsBufferPeak *peak;
+
+  guint current_decimation;
+  
+  GRecMutex *buffer_mutex;
+
+  if(n_peaks != NULL){
+    n_peaks[0] = 0;
+  }
+
+  if(decimation != NULL){
+    decimation[0] = 0;
+  }
+  
+  if(!AGS_IS_BUFFER(buffer)){
+    return(NULL);
+  }
+      
+  /* get buffer mutex */
+  buffer_mutex = AGS_BUFFER_GET_OBJ_MUTEX(buffer);
+
+  g_rec_mutex_lock(buffer_mutex);
+
+  ags_buffer_update_peak(buffer);
+
+  peak = NULL;
+  
+  if(buffer->peak != NULL){
+    if(level >= buffer->peak_levels){
+      level = buffer->peak_levels - 1;
+    }
+
+    current_decimation = AGS_BUFFER_PEAK_DECIMATION << level;
+    
+    peak = buffer->peak[level];
+    
+    if(n_peaks != NULL){
+      n_peaks[0] = (buffer->buffer_size + current_decimation - 1) / current_decimation;
+    }
+
+    if(decimation != NULL){
+      decimation[0] = current_decimation;
+    }
+  }
+  
+  g_rec_mutex_unlock(buffer_mutex);
+  
+  return(peak);
+}
+
 /**
  * ags_buffer_duplicate:
  * @buffer: an #AgsBuffer
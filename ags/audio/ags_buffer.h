@@ -38,10 +38,15 @@ G_BEGIN_DECLS
 
 #define AGS_BUFFER_GET_OBJ_MUTEX(obj) (&(((AgsBuffer *) obj)->obj_mutex))
 
+#define AGS_BUFFER_PEAK(ptr) ((AgsBufferPeak *)(ptr))
+
 #define AGS_BUFFER_DEFAULT_TICKS_PER_QUARTER_BUFFER (16.0)
 
+#define AGS_BUFFER_PEAK_DECIMATION (16)
+
 typedef struct _AgsBuffer AgsBuffer;
 typedef struct _AgsBufferClass AgsBufferClass;
+typedef struct _AgsBufferPeak AgsBufferPeak;
 
 /**
  * AgsBufferFlags:
@@ -54,6 +59,22 @@ typedef enum{
   AGS_BUFFER_IS_SELECTED     = 1,
 }AgsBufferFlags;
 
+/**
+ * AgsBufferPeak:
+ * @min: the minimum sample
+ * @max: the maximum sample
+ * @rms: the root mean square
+ *
+ * #AgsBufferPeak summarizes a range of frames, the samples are normalized
+ * to -1.0 to 1.0.
+ */
+struct _AgsBufferPeak
+{
+  gfloat min;
+  gfloat max;
+  gfloat rms;
+};
+
 struct _AgsBuffer
 {
   GObject gobject;
@@ -72,6 +93,14 @@ struct _AgsBuffer
   guint format;
   
   void *data;
+
+  guint peak_levels;
+  AgsBufferPeak **peak;
+
+  guint peak_dirty_start;
+  guint peak_dirty_end;
+
+  volatile gint peak_serial;
 };
 
 struct _AgsBufferClass
@@ -110,6 +139,17 @@ void ags_buffer_set_format(AgsBuffer *buffer,
 
 gpointer ags_buffer_get_data(AgsBuffer *buffer);
 
+void ags_buffer_invalidate_peak(AgsBuffer *buffer,
+				guint offset, guint count);
+void ags_buffer_update_peak(AgsBuffer *buffer);
+
+guint ags_buffer_find_peak_level(AgsBuffer *buffer,
+				 gdouble frames_per_pixel);
+AgsBufferPeak* ags_buffer_get_peak(AgsBuffer *buffer,
+				   guint level,
+				   guint *n_peaks,
+				   guint *decimation);
+
 AgsBuffer* ags_buffer_duplicate(AgsBuffer *buffer);
 
 AgsBuffer* ags_buffer_new();
@@ -59,6 +59,8 @@
 #include <ags/audio/file/ags_audio_file_link.h>
 #include <ags/audio/file/ags_audio_file.h>
 
+#include <ags/audio/osc/ags_osc_address_trie.h>
+
 #include <ags/audio/recall/ags_play_channel_run.h>
 
 #include <ags/audio/fx/ags_fx_playback_channel_processor.h>
@@ -7148,8 +7150,8 @@ ags_channel_real_set_samplerate(AgsChannel *channel, guint samplerate)
   
   AgsThread *channel_thread;
   AgsMessageDelivery *message_delivery;
+  AgsMessage *typed_message;
 
-  GList *start_message_queue;
 
   gdouble frequency;
   guint old_samplerate;
@@ -7212,65 +7214,23 @@ ags_channel_real_set_samplerate(AgsChannel *channel, guint samplerate)
   /* emit message */
   message_delivery = ags_message_delivery_get_instance();
 
-  start_message_queue = ags_message_delivery_find_sender_namespace(message_delivery,
-								   "libags-audio");
-
-  if(start_message_queue != NULL){
-    AgsMessageEnvelope *message;
-
-    xmlDoc *doc;
-    xmlNode *root_node;
-
-    /* specify message body */
-    doc = xmlNewDoc("1.0");
-
-    root_node = xmlNewNode(NULL,
-			   "ags-command");
-    xmlDocSetRootElement(doc, root_node);    
-
-    xmlNewProp(root_node,
-	       "method",
-	       "AgsChannel::set-samplerate");
-
-    /* add message */
-    message = ags_message_envelope_new((GObject *) channel,
-				       NULL,
-				       doc);
-
-    /* set parameter */
-    message->n_params = 2;
+  /* post to subscribers and the libags-audio message queue */
+  typed_message = ags_message_alloc((GObject *) channel,
+				    "AgsChannel::set-samplerate",
+				    2);
 
-    message->parameter_name = (gchar **) malloc(3 * sizeof(gchar *));
-    message->value = g_new0(GValue,
-			    2);
+  typed_message->sender_namespace = "libags-audio";
 
-    /* samplerate */
-    message->parameter_name[0] = "samplerate";
-    
-    g_value_init(&(message->value[0]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[0]),
-		     samplerate);
+  typed_message->parameter_name[0] = "samplerate";
+  typed_message->value_type[0] = G_TYPE_UINT;
+  typed_message->value[0].uint_value = samplerate;
 
-    /* old samplerate */
-    message->parameter_name[1] = "old-samplerate";
-    
-    g_value_init(&(message->value[1]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[1]),
-		     old_samplerate);
+  typed_message->parameter_name[1] = "old-samplerate";
+  typed_message->value_type[1] = G_TYPE_UINT;
+  typed_message->value[1].uint_value = old_samplerate;
 
-    /* terminate string vector */
-    message->parameter_name[2] = NULL;
-    
-    /* add message */
-    ags_message_delivery_add_message_envelope(message_delivery,
-					      "libags-audio",
-					      message);
-
-    g_list_free_full(start_message_queue,
-		     (GDestroyNotify) g_object_unref);
-  }
+  ags_message_delivery_post(message_delivery,
+			    typed_message);
 }
 
 /**
@@ -7329,8 +7289,8 @@ ags_channel_real_set_buffer_size(AgsChannel *channel, guint buffer_size)
   
   AgsThread *channel_thread;
   AgsMessageDelivery *message_delivery;
+  AgsMessage *typed_message;
 
-  GList *start_message_queue;
 
   gdouble frequency;
   guint old_buffer_size;
@@ -7393,65 +7353,23 @@ ags_channel_real_set_buffer_size(AgsChannel *channel, guint buffer_size)
   /* emit message */
   message_delivery = ags_message_delivery_get_instance();
 
-  start_message_queue = ags_message_delivery_find_sender_namespace(message_delivery,
-								   "libags-audio");
+  /* post to subscribers and the libags-audio message queue */
+  typed_message = ags_message_alloc((GObject *) channel,
+				    "AgsChannel::set-buffer-size",
+				    2);
 
-  if(start_message_queue != NULL){
-    AgsMessageEnvelope *message;
+  typed_message->sender_namespace = "libags-audio";
 
-    xmlDoc *doc;
-    xmlNode *root_node;
+  typed_message->parameter_name[0] = "buffer-size";
+  typed_message->value_type[0] = G_TYPE_UINT;
+  typed_message->value[0].uint_value = buffer_size;
 
-    /* specify message body */
-    doc = xmlNewDoc("1.0");
-
-    root_node = xmlNewNode(NULL,
-			   "ags-command");
-    xmlDocSetRootElement(doc, root_node);    
+  typed_message->parameter_name[1] = "old-buffer-size";
+  typed_message->value_type[1] = G_TYPE_UINT;
+  typed_message->value[1].uint_value = old_buffer_size;
 
-    xmlNewProp(root_node,
-	       "method",
-	       "AgsChannel::set-buffer-size");
-
-    /* add message */
-    message = ags_message_envelope_new((GObject *) channel,
-				       NULL,
-				       doc);
-
-    /* set parameter */
-    message->n_params = 2;
-
-    message->parameter_name = (gchar **) malloc(3 * sizeof(gchar *));
-    message->value = g_new0(GValue,
-			    2);
-
-    /* buffer_size */
-    message->parameter_name[0] = "buffer-size";
-    
-    g_value_init(&(message->value[0]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[0]),
-		     buffer_size);
-
-    /* old buffer_size */
-    message->parameter_name[1] = "old-buffer-size";
-    
-    g_value_init(&(message->value[1]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[1]),
-		     old_buffer_size);
-
-    /* terminate string vector */
-    message->parameter_name[2] = NULL;
-    
-    /* add message */
-    ags_message_delivery_add_message_envelope(message_delivery,
-					      "libags-audio",
-					      message);
-
-    g_list_free_full(start_message_queue,
-		     (GDestroyNotify) g_object_unref);
-  }
+  ags_message_delivery_post(message_delivery,
+			    typed_message);
 }
 
 /**
@@ -7508,8 +7426,8 @@ ags_channel_real_set_format(AgsChannel *channel, guint format)
   AgsRecycling *recycling;
 
   AgsMessageDelivery *message_delivery;
+  AgsMessage *typed_message;
 
-  GList *start_message_queue;
 
   guint old_format;
   
@@ -7544,65 +7462,23 @@ ags_channel_real_set_format(AgsChannel *channel, guint format)
   /* emit message */
   message_delivery = ags_message_delivery_get_instance();
 
-  start_message_queue = ags_message_delivery_find_sender_namespace(message_delivery,
-								   "libags-audio");
+  /* post to subscribers and the libags-audio message queue */
+  typed_message = ags_message_alloc((GObject *) channel,
+				    "AgsChannel::set-format",
+				    2);
 
-  if(start_message_queue != NULL){
-    AgsMessageEnvelope *message;
+  typed_message->sender_namespace = "libags-audio";
 
-    xmlDoc *doc;
-    xmlNode *root_node;
+  typed_message->parameter_name[0] = "format";
+  typed_message->value_type[0] = G_TYPE_UINT;
+  typed_message->value[0].uint_value = format;
 
-    /* specify message body */
-    doc = xmlNewDoc("1.0");
+  typed_message->parameter_name[1] = "old-format";
+  typed_message->value_type[1] = G_TYPE_UINT;
+  typed_message->value[1].uint_value = old_format;
 
-    root_node = xmlNewNode(NULL,
-			   "ags-command");
-    xmlDocSetRootElement(doc, root_node);    
-
-    xmlNewProp(root_node,
-	       "method",
-	       "AgsChannel::set-format");
-
-    /* add message */
-    message = ags_message_envelope_new((GObject *) channel,
-				       NULL,
-				       doc);
-
-    /* set parameter */
-    message->n_params = 2;
-
-    message->parameter_name = (gchar **) malloc(3 * sizeof(gchar *));
-    message->value = g_new0(GValue,
-			    2);
-
-    /* format */
-    message->parameter_name[0] = "format";
-    
-    g_value_init(&(message->value[0]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[0]),
-		     format);
-
-    /* old format */
-    message->parameter_name[1] = "old-format";
-    
-    g_value_init(&(message->value[1]),
-		 G_TYPE_UINT);
-    g_value_set_uint(&(message->value[1]),
-		     old_format);
-
-    /* terminate string vector */
-    message->parameter_name[2] = NULL;
-    
-    /* add message */
-    ags_message_delivery_add_message_envelope(message_delivery,
-					      "libags-audio",
-					      message);
-
-    g_list_free_full(start_message_queue,
-		     (GDestroyNotify) g_object_unref);
-  }
+  ags_message_delivery_post(message_delivery,
+			    typed_message);
 }
 
 /**
@@ -8564,6 +8440,9 @@ ags_channel_add_recall(AgsChannel *channel, GObject *recall,
 		   NULL);
     }
   }
+
+  /* invalidate OSC addresses */
+  ags_osc_address_trie_invalidate();
 }
 
 /**
@@ -8672,6 +8551,9 @@ ags_channel_insert_recall(AgsChannel *channel, GObject *recall,
 		   NULL);
     }
   }
+
+  /* invalidate OSC addresses */
+  ags_osc_address_trie_invalidate();
 }
 
 /**
@@ -8746,6 +8628,9 @@ ags_channel_remove_recall(AgsChannel *channel, GObject *recall,
 
     g_object_unref(G_OBJECT(recall));
   }
+
+  /* invalidate OSC addresses */
+  ags_osc_address_trie_invalidate();
 }
 
 GList*
@@ -11891,11 +11776,11 @@ ags_channel_real_stop(AgsChannel *channel,
   AgsThread *audio_thread;
   AgsThread *channel_thread;
   AgsMessageDelivery *message_delivery;
+  AgsMessage *typed_message;
 
   AgsApplicationContext *application_context;
 
   GList *list;
-  GList *start_message_queue;
 
   gint i;
 
@@ -12003,63 +11888,24 @@ ags_channel_real_stop(AgsChannel *channel,
   /* emit message */
   message_delivery = ags_message_delivery_get_instance();
 
-  start_message_queue = ags_message_delivery_find_sender_namespace(message_delivery,
-								   "libags-audio");
+  /* post to subscribers and the libags-audio message queue */
+  typed_message = ags_message_alloc((GObject *) channel,
+				    "AgsChannel::stop",
+				    2);
 
-  if(start_message_queue != NULL){
-    AgsMessageEnvelope *message;
+  typed_message->sender_namespace = "libags-audio";
 
-    xmlDoc *doc;
-    xmlNode *root_node;
-
-    /* specify message body */
-    doc = xmlNewDoc("1.0");
-
-    root_node = xmlNewNode(NULL,
-			   "ags-command");
-    xmlDocSetRootElement(doc, root_node);    
-
-    xmlNewProp(root_node,
-	       "method",
-	       "AgsChannel::stop");
-
-    /* add message */
-    message = ags_message_envelope_new((GObject *) channel,
-				       NULL,
-				       doc);
-
-    /* set parameter */
-    message->n_params = 2;
-
-    message->parameter_name = (gchar **) malloc(3 * sizeof(gchar *));
-    message->value = g_new0(GValue,
-			    2);
-    
-    /* recall id */
-    message->parameter_name[0] = "recall-id";
-    g_value_init(&(message->value[0]),
-		 G_TYPE_POINTER);
-    g_value_set_pointer(&(message->value[0]),
-			recall_id);
-    
-    /* sound scope */
-    message->parameter_name[1] = "sound-scope";
-    g_value_init(&(message->value[1]),
-		 G_TYPE_INT);
-    g_value_set_int(&(message->value[1]),
-		    sound_scope);
-    
-    /* terminate string vector */
-    message->parameter_name[2] = NULL;
+  ags_message_set_object_list(typed_message,
+			      0,
+			      "recall-id",
+			      recall_id);
 
-    /* add message */
-    ags_message_delivery_add_message_envelope(message_delivery,
-					      "libags-audio",
-					      message);
+  typed_message->parameter_name[1] = "sound-scope";
+  typed_message->value_type[1] = G_TYPE_INT;
+  typed_message->value[1].int_value = sound_scope;
 
-    g_list_free_full(start_message_queue,
-		     (GDestroyNotify) g_object_unref);
-  }
+  ags_message_delivery_post(message_delivery,
+			    typed_message);
 }
 
 /**
@@ -0,0 +1,945 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <ags/audio/ags_fft_plan_cache.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+void ags_fft_plan_cache_class_init(AgsFFTPlanCacheClass *fft_plan_cache);
+void ags_fft_plan_cache_init(AgsFFTPlanCache *fft_plan_cache);
+void ags_fft_plan_cache_finalize(GObject *gobject);
+
+guint ags_fft_plan_key_hash(gconstpointer ptr);
+gboolean ags_fft_plan_key_equal(gconstpointer a,
+				gconstpointer b);
+
+fftw_plan ags_fft_plan_cache_create_plan(AgsFFTPlan *fft_plan,
+					 unsigned int planner_flags);
+AgsFFTPlan* ags_fft_plan_cache_find_plan(AgsFFTPlanCache *fft_plan_cache,
+					 guint transform,
+					 guint n,
+					 guint howmany,
+					 fftw_r2r_kind kind,
+					 gint alignment);
+
+gpointer ags_fft_plan_cache_measure_thread(gpointer data);
+
+/**
+ * SECTION:ags_fft_plan_cache
+ * @short_description: process wide FFTW plans
+ * @title: AgsFFTPlanCache
+ * @section_id:
+ * @include: ags/audio/ags_fft_plan_cache.h
+ *
+ * #AgsFFTPlanCache shares FFTW plans by transform, size, batch count, kind
+ * and alignment, so analysis and pitch instances of equal size plan once.
+ *
+ * A new plan is taken from wisdom if possible, otherwise it starts as
+ * estimated plan and a separate thread replaces it by a measured one. The
+ * wisdom is saved in the user's gsequencer directory and loaded the next
+ * time. A new plan always has an estimated plan at least, if a measure is
+ * running it waits for the planner. The time of a measure is limited by
+ * %AGS_FFT_PLAN_CACHE_DEFAULT_MEASURE_TIME_LIMIT to keep that wait short.
+ */
+
+static gpointer ags_fft_plan_cache_parent_class = NULL;
+
+AgsFFTPlanCache *ags_fft_plan_cache = NULL;
+
+static GMutex ags_fft_plan_cache_planner_mutex;
+
+GType
+ags_fft_plan_cache_get_type (void)
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_fft_plan_cache = 0;
+
+    static const GTypeInfo ags_fft_plan_cache_info = {
+      sizeof (AgsFFTPlanCacheClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_fft_plan_cache_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof (AgsFFTPlanCache),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_fft_plan_cache_init,
+    };
+
+    ags_type_fft_plan_cache = g_type_register_static(G_TYPE_OBJECT,
+						     "AgsFFTPlanCache",
+						     &ags_fft_plan_cache_info,
+						     0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_fft_plan_cache);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_fft_plan_cache_class_init(AgsFFTPlanCacheClass *fft_plan_cache)
+{
+  GObjectClass *gobject;
+
+  ags_fft_plan_cache_parent_class = g_type_class_peek_parent(fft_plan_cache);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) fft_plan_cache;
+
+  gobject->finalize = ags_fft_plan_cache_finalize;
+}
+
+void
+ags_fft_plan_cache_init(AgsFFTPlanCache *fft_plan_cache)
+{
+  fft_plan_cache->flags = 0;
+
+  /* fft plan cache mutex */
+  g_rec_mutex_init(&(fft_plan_cache->obj_mutex));
+
+  /* plan */
+  fft_plan_cache->plan = g_hash_table_new_full(ags_fft_plan_key_hash, ags_fft_plan_key_equal,
+					       NULL,
+					       NULL);
+
+  fft_plan_cache->pending = NULL;
+  fft_plan_cache->retired = NULL;
+
+  /* wisdom */
+#ifndef AGS_W32API
+  fft_plan_cache->wisdom_filename = g_build_filename(g_get_home_dir(),
+						     AGS_DEFAULT_DIRECTORY,
+						     AGS_FFT_PLAN_CACHE_DEFAULT_WISDOM_FILENAME,
+						     NULL);
+#else
+  fft_plan_cache->wisdom_filename = g_build_filename(g_get_user_config_dir(),
+						     "gsequencer",
+						     AGS_FFT_PLAN_CACHE_DEFAULT_WISDOM_FILENAME,
+						     NULL);
+#endif
+}
+
+void
+ags_fft_plan_cache_finalize(GObject *gobject)
+{
+  AgsFFTPlanCache *fft_plan_cache;
+
+  GHashTableIter iter;
+
+  GList *list;
+
+  gpointer fft_plan;
+  
+  fft_plan_cache = AGS_FFT_PLAN_CACHE(gobject);
+
+  /* destroy plans */
+  g_mutex_lock(&ags_fft_plan_cache_planner_mutex);
+
+  g_hash_table_iter_init(&iter,
+			 fft_plan_cache->plan);
+
+  while(g_hash_table_iter_next(&iter, &fft_plan, NULL)){
+    if(AGS_FFT_PLAN(fft_plan)->plan != NULL){
+      fftw_destroy_plan((fftw_plan) AGS_FFT_PLAN(fft_plan)->plan);
+    }
+  }
+
+  list = fft_plan_cache->retired;
+
+  while(list != NULL){
+    fftw_destroy_plan((fftw_plan) list->data);
+
+    list = list->next;
+  }
+
+  g_mutex_unlock(&ags_fft_plan_cache_planner_mutex);
+
+  g_list_free(fft_plan_cache->retired);
+  g_list_free(fft_plan_cache->pending);
+
+  /* free entries */
+  g_hash_table_iter_init(&iter,
+			 fft_plan_cache->plan);
+
+  while(g_hash_table_iter_next(&iter, &fft_plan, NULL)){
+    AGS_FFT_PLAN(fft_plan)->plan = NULL;
+    
+    ags_fft_plan_free(fft_plan);
+  }
+  
+  g_hash_table_destroy(fft_plan_cache->plan);
+
+  g_free(fft_plan_cache->wisdom_filename);
+  
+  if(fft_plan_cache == ags_fft_plan_cache){
+    ags_fft_plan_cache = NULL;
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_fft_plan_cache_parent_class)->finalize(gobject);
+}
+
+guint
+ags_fft_plan_key_hash(gconstpointer ptr)
+{
+  AgsFFTPlan *fft_plan;
+
+  fft_plan = (AgsFFTPlan *) ptr;
+
+  return(((((fft_plan->transform * 31) + fft_plan->n) * 31 + fft_plan->howmany) * 31 + (guint) fft_plan->kind) * 31 + (guint) fft_plan->alignment);
+}
+
+gboolean
+ags_fft_plan_key_equal(gconstpointer a,
+		       gconstpointer b)
+{
+  AgsFFTPlan *fft_plan_a, *fft_plan_b;
+
+  fft_plan_a = (AgsFFTPlan *) a;
+  fft_plan_b = (AgsFFTPlan *) b;
+
+  return((fft_plan_a->transform == fft_plan_b->transform &&
+	  fft_plan_a->n == fft_plan_b->n &&
+	  fft_plan_a->howmany == fft_plan_b->howmany &&
+	  fft_plan_a->kind == fft_plan_b->kind &&
+	  fft_plan_a->alignment == fft_plan_b->alignment) ? TRUE: FALSE);
+}
+
+/**
+ * ags_fft_plan_alloc:
+ * @n: the transform size
+ * @howmany: the count of contiguous transforms
+ * @kind: the #fftw_r2r_kind
+ * @alignment: the alignment, see fftw_alignment_of()
+ *
+ * Allocate #AgsFFTPlan-struct of %AGS_FFT_PLAN_R2R without plan.
+ *
+ * Returns: the newly allocated #AgsFFTPlan-struct
+ *
+ * Since: 3.5.0
+ */
+AgsFFTPlan*
+ags_fft_plan_alloc(guint n,
+		   guint howmany,
+		   fftw_r2r_kind kind,
+		   gint alignment)
+{
+  AgsFFTPlan *fft_plan;
+
+  fft_plan = (AgsFFTPlan *) malloc(sizeof(AgsFFTPlan));
+
+  fft_plan->transform = AGS_FFT_PLAN_R2R;
+
+  fft_plan->n = n;
+  fft_plan->howmany = howmany;
+  fft_plan->kind = kind;
+  fft_plan->alignment = alignment;
+
+  fft_plan->measured = FALSE;
+  fft_plan->plan = NULL;
+
+  return(fft_plan);
+}
+
+/**
+ * ags_fft_plan_free:
+ * @fft_plan: the #AgsFFTPlan-struct
+ *
+ * Free @fft_plan and destroy its plan.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_fft_plan_free(AgsFFTPlan *fft_plan)
+{
+  if(fft_plan == NULL){
+    return;
+  }
+
+  if(fft_plan->plan != NULL){
+    g_mutex_lock(&ags_fft_plan_cache_planner_mutex);
+
+    fftw_destroy_plan((fftw_plan) fft_plan->plan);
+
+    g_mutex_unlock(&ags_fft_plan_cache_planner_mutex);
+  }
+  
+  free(fft_plan);
+}
+
+/**
+ * ags_fft_plan_execute_r2r:
+ * @fft_plan: the #AgsFFTPlan-struct
+ * @in: the input array of @fft_plan's n times howmany
+ * @out: the output array of @fft_plan's n times howmany
+ *
+ * Execute @fft_plan on @in and @out. Both arrays need the alignment of
+ * @fft_plan, nothing is done if it doesn't match or the plan isn't ready.
+ * Safe to call from the audio thread.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_fft_plan_execute_r2r(AgsFFTPlan *fft_plan,
+			 double *in,
+			 double *out)
+{
+  fftw_plan plan;
+  
+  if(fft_plan == NULL ||
+     in == NULL ||
+     out == NULL){
+    return;
+  }
+
+  plan = (fftw_plan) g_atomic_pointer_get(&(fft_plan->plan));
+  
+  if(plan == NULL ||
+     fftw_alignment_of(in) != fft_plan->alignment ||
+     fftw_alignment_of(out) != fft_plan->alignment){
+    return;
+  }
+
+  fftw_execute_r2r(plan,
+		   in,
+		   out);
+}
+
+/**
+ * ags_fft_plan_execute_dft_r2c:
+ * @fft_plan: the #AgsFFTPlan-struct of %AGS_FFT_PLAN_DFT_R2C
+ * @in: the real input array of @fft_plan's n
+ * @out: the complex output array of @fft_plan's n / 2 + 1
+ *
+ * Execute the forward transform @fft_plan on @in and @out. Both arrays
+ * need the alignment of @fft_plan. Safe to call from the audio thread.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_fft_plan_execute_dft_r2c(AgsFFTPlan *fft_plan,
+			     double *in,
+			     fftw_complex *out)
+{
+  fftw_plan plan;
+  
+  if(fft_plan == NULL ||
+     fft_plan->transform != AGS_FFT_PLAN_DFT_R2C ||
+     in == NULL ||
+     out == NULL){
+    return;
+  }
+
+  plan = (fftw_plan) g_atomic_pointer_get(&(fft_plan->plan));
+  
+  if(plan == NULL ||
+     fftw_alignment_of(in) != fft_plan->alignment ||
+     fftw_alignment_of((double *) out) != fft_plan->alignment){
+    return;
+  }
+
+  fftw_execute_dft_r2c(plan,
+		       in,
+		       out);
+}
+
+/**
+ * ags_fft_plan_execute_dft_c2r:
+ * @fft_plan: the #AgsFFTPlan-struct of %AGS_FFT_PLAN_DFT_C2R
+ * @in: the complex input array of @fft_plan's n / 2 + 1, it is overwritten
+ * @out: the real output array of @fft_plan's n
+ *
+ * Execute the backward transform @fft_plan on @in and @out. Both arrays
+ * need the alignment of @fft_plan. Safe to call from the audio thread.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_fft_plan_execute_dft_c2r(AgsFFTPlan *fft_plan,
+			     fftw_complex *in,
+			     double *out)
+{
+  fftw_plan plan;
+  
+  if(fft_plan == NULL ||
+     fft_plan->transform != AGS_FFT_PLAN_DFT_C2R ||
+     in == NULL ||
+     out == NULL){
+    return;
+  }
+
+  plan = (fftw_plan) g_atomic_pointer_get(&(fft_plan->plan));
+  
+  if(plan == NULL ||
+     fftw_alignment_of((double *) in) != fft_plan->alignment ||
+     fftw_alignment_of(out) != fft_plan->alignment){
+    return;
+  }
+
+  fftw_execute_dft_c2r(plan,
+		       in,
+		       out);
+}
+
+fftw_plan
+ags_fft_plan_cache_create_plan(AgsFFTPlan *fft_plan,
+			       unsigned int planner_flags)
+{
+  fftw_plan plan;
+
+  double *in, *out;
+  guchar *in_data, *out_data;
+
+  gint n;
+  guint size;
+
+  /* large enough for n real or n / 2 + 1 complex values */
+  size = (fft_plan->n + 2) * fft_plan->howmany * sizeof(double);
+
+  /* scratch arrays with the alignment of the plan, measuring overwrites them */
+  in_data = (guchar *) fftw_malloc(size + 64);
+  out_data = (guchar *) fftw_malloc(size + 64);
+
+  in = (double *) (in_data + fft_plan->alignment);
+  out = (double *) (out_data + fft_plan->alignment);
+
+  memset(in, 0, size);
+  memset(out, 0, size);
+  
+  n = (gint) fft_plan->n;
+
+  if(fft_plan->transform == AGS_FFT_PLAN_DFT_R2C){
+    plan = fftw_plan_dft_r2c_1d(n,
+				in, (fftw_complex *) out,
+				planner_flags);
+  }else if(fft_plan->transform == AGS_FFT_PLAN_DFT_C2R){
+    plan = fftw_plan_dft_c2r_1d(n,
+				(fftw_complex *) in, out,
+				planner_flags);
+  }else if(fft_plan->howmany == 1){
+    plan = fftw_plan_r2r_1d(n,
+			    in, out,
+			    fft_plan->kind,
+			    planner_flags);
+  }else{
+    plan = fftw_plan_many_r2r(1, &n, (gint) fft_plan->howmany,
+			      in, NULL, 1, n,
+			      out, NULL, 1, n,
+			      &(fft_plan->kind),
+			      planner_flags);
+  }
+
+  fftw_free(in_data);
+  fftw_free(out_data);
+
+  return(plan);
+}
+
+AgsFFTPlan*
+ags_fft_plan_cache_find_plan(AgsFFTPlanCache *fft_plan_cache,
+			     guint transform,
+			     guint n,
+			     guint howmany,
+			     fftw_r2r_kind kind,
+			     gint alignment)
+{
+  AgsFFTPlan key;
+  AgsFFTPlan *fft_plan;
+
+  fftw_plan plan;
+  
+  gboolean do_measure;
+  
+  GRecMutex *fft_plan_cache_mutex;
+
+  if(!AGS_IS_FFT_PLAN_CACHE(fft_plan_cache) ||
+     n == 0 ||
+     howmany == 0){
+    return(NULL);
+  }
+
+  fft_plan_cache_mutex = AGS_FFT_PLAN_CACHE_GET_OBJ_MUTEX(fft_plan_cache);
+
+  key.transform = transform;
+  key.n = n;
+  key.howmany = howmany;
+  key.kind = kind;
+  key.alignment = alignment;
+
+  do_measure = FALSE;
+  
+  g_rec_mutex_lock(fft_plan_cache_mutex);
+
+  fft_plan = g_hash_table_lookup(fft_plan_cache->plan,
+				 &key);
+
+  if(fft_plan == NULL){
+    fft_plan = ags_fft_plan_alloc(n,
+				  howmany,
+				  kind,
+				  alignment);
+    fft_plan->transform = transform;
+
+    /* wait for a running measure, it is time limited */
+    g_mutex_lock(&ags_fft_plan_cache_planner_mutex);
+
+    plan = ags_fft_plan_cache_create_plan(fft_plan,
+					  FFTW_MEASURE | FFTW_WISDOM_ONLY);
+
+    if(plan != NULL){
+      fft_plan->measured = TRUE;
+    }else{
+      plan = ags_fft_plan_cache_create_plan(fft_plan,
+					    FFTW_ESTIMATE);
+    }
+
+    fft_plan->plan = plan;
+      
+    g_mutex_unlock(&ags_fft_plan_cache_planner_mutex);
+
+    if(!fft_plan->measured){
+      fft_plan_cache->pending = g_list_append(fft_plan_cache->pending,
+					      fft_plan);
+
+      do_measure = TRUE;
+    }
+    
+    g_hash_table_add(fft_plan_cache->plan,
+		     fft_plan);
+  }
+  
+  g_rec_mutex_unlock(fft_plan_cache_mutex);
+
+  if(do_measure){
+    ags_fft_plan_cache_measure_async(fft_plan_cache);
+  }
+  
+  return(fft_plan);
+}
+
+/**
+ * ags_fft_plan_cache_find_r2r:
+ * @fft_plan_cache: the #AgsFFTPlanCache
+ * @n: the transform size
+ * @howmany: the count of contiguous transforms, 1 for a single channel
+ * @kind: the #fftw_r2r_kind, e.g. FFTW_R2HC
+ * @alignment: the alignment of the arrays, see fftw_alignment_of()
+ *
+ * Find the shared plan, create it if not present. A created plan is
+ * estimated until the measured one is ready. The plan is owned by
+ * @fft_plan_cache and stays valid for its life time.
+ *
+ * Returns: (transfer none): the #AgsFFTPlan-struct
+ *
+ * Since: 3.5.0
+ */
+AgsFFTPlan*
+ags_fft_plan_cache_find_r2r(AgsFFTPlanCache *fft_plan_cache,
+			    guint n,
+			    guint howmany,
+			    fftw_r2r_kind kind,
+			    gint alignment)
+{
+  return(ags_fft_plan_cache_find_plan(fft_plan_cache,
+				      AGS_FFT_PLAN_R2R,
+				      n,
+				      howmany,
+				      kind,
+				      alignment));
+}
+
+/**
+ * ags_fft_plan_cache_find_dft_r2c:
+ * @fft_plan_cache: the #AgsFFTPlanCache
+ * @n: the transform size
+ * @alignment: the alignment of the arrays, see fftw_alignment_of()
+ *
+ * Find the shared real to complex forward plan, create it if not present.
+ *
+ * Returns: (transfer none): the #AgsFFTPlan-struct
+ *
+ * Since: 3.5.0
+ */
+AgsFFTPlan*
+ags_fft_plan_cache_find_dft_r2c(AgsFFTPlanCache *fft_plan_cache,
+				guint n,
+				gint alignment)
+{
+  return(ags_fft_plan_cache_find_plan(fft_plan_cache,
+				      AGS_FFT_PLAN_DFT_R2C,
+				      n,
+				      1,
+				      FFTW_R2HC,
+				      alignment));
+}
+
+/**
+ * ags_fft_plan_cache_find_dft_c2r:
+ * @fft_plan_cache: the #AgsFFTPlanCache
+ * @n: the transform size
+ * @alignment: the alignment of the arrays, see fftw_alignment_of()
+ *
+ * Find the shared complex to real backward plan, create it if not present.
+ *
+ * Returns: (transfer none): the #AgsFFTPlan-struct
+ *
+ * Since: 3.5.0
+ */
+AgsFFTPlan*
+ags_fft_plan_cache_find_dft_c2r(AgsFFTPlanCache *fft_plan_cache,
+				guint n,
+				gint alignment)
+{
+  return(ags_fft_plan_cache_find_plan(fft_plan_cache,
+				      AGS_FFT_PLAN_DFT_C2R,
+				      n,
+				      1,
+				      FFTW_HC2R,
+				      alignment));
+}
+
+/**
+ * ags_fft_plan_cache_measure:
+ * @fft_plan_cache: the #AgsFFTPlanCache
+ *
+ * Measure all pending plans and save the wisdom, this might take
+ * long. Replaced estimated plans are kept until @fft_plan_cache is
+ * finalized, since other threads might still execute them.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_fft_plan_cache_measure(AgsFFTPlanCache *fft_plan_cache)
+{
+  AgsFFTPlan *fft_plan;
+
+  fftw_plan plan, old_plan;
+
+  gboolean wisdom_changed;
+  
+  GRecMutex *fft_plan_cache_mutex;
+
+  if(!AGS_IS_FFT_PLAN_CACHE(fft_plan_cache)){
+    return;
+  }
+
+  fft_plan_cache_mutex = AGS_FFT_PLAN_CACHE_GET_OBJ_MUTEX(fft_plan_cache);
+
+  while(TRUE){
+    /* pop pending */
+    g_rec_mutex_lock(fft_plan_cache_mutex);
+
+    fft_plan = NULL;
+    
+    if(fft_plan_cache->pending != NULL){
+      fft_plan = fft_plan_cache->pending->data;
+
+      fft_plan_cache->pending = g_list_delete_link(fft_plan_cache->pending,
+						   fft_plan_cache->pending);
+    }
+    
+    g_rec_mutex_unlock(fft_plan_cache_mutex);
+
+    if(fft_plan == NULL){
+      break;
+    }
+
+    /* measure, time limited since new plans wait for the planner */
+    g_mutex_lock(&ags_fft_plan_cache_planner_mutex);
+
+    fftw_set_timelimit(AGS_FFT_PLAN_CACHE_DEFAULT_MEASURE_TIME_LIMIT);
+    
+    plan = ags_fft_plan_cache_create_plan(fft_plan,
+					  FFTW_MEASURE);
+
+    fftw_set_timelimit(FFTW_NO_TIMELIMIT);
+    
+    g_mutex_unlock(&ags_fft_plan_cache_planner_mutex);
+
+    if(plan == NULL){
+      continue;
+    }
+
+    /* replace */
+    g_rec_mutex_lock(fft_plan_cache_mutex);
+
+    old_plan = (fftw_plan) fft_plan->plan;
+
+    g_atomic_pointer_set(&(fft_plan->plan),
+			 plan);
+    g_atomic_int_set(&(fft_plan->measured),
+		     TRUE);
+
+    if(old_plan != NULL){
+      fft_plan_cache->retired = g_list_prepend(fft_plan_cache->retired,
+					       old_plan);
+    }
+
+    fft_plan_cache->flags |= AGS_FFT_PLAN_CACHE_WISDOM_CHANGED;
+    
+    g_rec_mutex_unlock(fft_plan_cache_mutex);
+  }
+
+  /* save wisdom */
+  g_rec_mutex_lock(fft_plan_cache_mutex);
+
+  wisdom_changed = ((AGS_FFT_PLAN_CACHE_WISDOM_CHANGED & (fft_plan_cache->flags)) != 0) ? TRUE: FALSE;
+  
+  fft_plan_cache->flags &= (~AGS_FFT_PLAN_CACHE_WISDOM_CHANGED);
+
+  g_rec_mutex_unlock(fft_plan_cache_mutex);
+
+  if(wisdom_changed){
+    ags_fft_plan_cache_save_wisdom(fft_plan_cache);
+  }
+}
+
+gpointer
+ags_fft_plan_cache_measure_thread(gpointer data)
+{
+  AgsFFTPlanCache *fft_plan_cache;
+
+  gboolean has_pending;
+  
+  GRecMutex *fft_plan_cache_mutex;
+
+  fft_plan_cache = AGS_FFT_PLAN_CACHE(data);
+
+  fft_plan_cache_mutex = AGS_FFT_PLAN_CACHE_GET_OBJ_MUTEX(fft_plan_cache);
+
+  ags_fft_plan_cache_measure(fft_plan_cache);
+
+  g_rec_mutex_lock(fft_plan_cache_mutex);
+
+  fft_plan_cache->flags &= (~AGS_FFT_PLAN_CACHE_MEASURE_RUNNING);
+
+  has_pending = (fft_plan_cache->pending != NULL) ? TRUE: FALSE;
+  
+  g_rec_mutex_unlock(fft_plan_cache_mutex);
+
+  /* plans added after the measure finished */
+  if(has_pending){
+    ags_fft_plan_cache_measure_async(fft_plan_cache);
+  }
+  
+  g_object_unref(fft_plan_cache);
+
+  g_thread_exit(NULL);
+
+  return(NULL);
+}
+
+/**
+ * ags_fft_plan_cache_measure_async:
+ * @fft_plan_cache: the #AgsFFTPlanCache
+ *
+ * Measure the pending plans of @fft_plan_cache by a separate thread,
+ * unless a measure is already running.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_fft_plan_cache_measure_async(AgsFFTPlanCache *fft_plan_cache)
+{
+  GThread *thread;
+
+  gboolean is_running;
+
+  GRecMutex *fft_plan_cache_mutex;
+
+  if(!AGS_IS_FFT_PLAN_CACHE(fft_plan_cache)){
+    return;
+  }
+
+  fft_plan_cache_mutex = AGS_FFT_PLAN_CACHE_GET_OBJ_MUTEX(fft_plan_cache);
+
+  g_rec_mutex_lock(fft_plan_cache_mutex);
+
+  is_running = ((AGS_FFT_PLAN_CACHE_MEASURE_RUNNING & (fft_plan_cache->flags)) != 0) ? TRUE: FALSE;
+
+  fft_plan_cache->flags |= AGS_FFT_PLAN_CACHE_MEASURE_RUNNING;
+
+  g_rec_mutex_unlock(fft_plan_cache_mutex);
+
+  if(is_running){
+    return;
+  }
+
+  g_object_ref(fft_plan_cache);
+
+  thread = g_thread_new("Advanced Gtk+ Sequencer - fft plan cache",
+			ags_fft_plan_cache_measure_thread,
+			fft_plan_cache);
+  g_thread_unref(thread);
+}
+
+/**
+ * ags_fft_plan_cache_load_wisdom:
+ * @fft_plan_cache: the #AgsFFTPlanCache
+ *
+ * Load the wisdom file of @fft_plan_cache.
+ *
+ * Returns: %TRUE on success, otherwise %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_fft_plan_cache_load_wisdom(AgsFFTPlanCache *fft_plan_cache)
+{
+  gchar *wisdom_filename;
+
+  gboolean success;
+  
+  GRecMutex *fft_plan_cache_mutex;
+
+  if(!AGS_IS_FFT_PLAN_CACHE(fft_plan_cache)){
+    return(FALSE);
+  }
+
+  fft_plan_cache_mutex = AGS_FFT_PLAN_CACHE_GET_OBJ_MUTEX(fft_plan_cache);
+
+  g_rec_mutex_lock(fft_plan_cache_mutex);
+
+  wisdom_filename = g_strdup(fft_plan_cache->wisdom_filename);
+  
+  g_rec_mutex_unlock(fft_plan_cache_mutex);
+
+  success = FALSE;
+  
+  if(wisdom_filename != NULL &&
+     g_file_test(wisdom_filename,
+		 G_FILE_TEST_EXISTS)){
+    g_mutex_lock(&ags_fft_plan_cache_planner_mutex);
+
+    success = (fftw_import_wisdom_from_filename(wisdom_filename) != 0) ? TRUE: FALSE;
+    
+    g_mutex_unlock(&ags_fft_plan_cache_planner_mutex);
+  }
+
+  g_free(wisdom_filename);
+  
+  return(success);
+}
+
+/**
+ * ags_fft_plan_cache_save_wisdom:
+ * @fft_plan_cache: the #AgsFFTPlanCache
+ *
+ * Save the accumulated wisdom to the wisdom file of @fft_plan_cache.
+ *
+ * Returns: %TRUE on success, otherwise %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_fft_plan_cache_save_wisdom(AgsFFTPlanCache *fft_plan_cache)
+{
+  gchar *wisdom_filename;
+  gchar *path;
+  
+  gboolean success;
+  
+  GRecMutex *fft_plan_cache_mutex;
+
+  if(!AGS_IS_FFT_PLAN_CACHE(fft_plan_cache)){
+    return(FALSE);
+  }
+
+  fft_plan_cache_mutex = AGS_FFT_PLAN_CACHE_GET_OBJ_MUTEX(fft_plan_cache);
+
+  g_rec_mutex_lock(fft_plan_cache_mutex);
+
+  wisdom_filename = g_strdup(fft_plan_cache->wisdom_filename);
+  
+  g_rec_mutex_unlock(fft_plan_cache_mutex);
+
+  if(wisdom_filename == NULL){
+    return(FALSE);
+  }
+
+  path = g_path_get_dirname(wisdom_filename);
+
+  success = FALSE;
+  
+  if(!g_mkdir_with_parents(path,
+			   0755)){
+    g_mutex_lock(&ags_fft_plan_cache_planner_mutex);
+
+    success = (fftw_export_wisdom_to_filename(wisdom_filename) != 0) ? TRUE: FALSE;
+    
+    g_mutex_unlock(&ags_fft_plan_cache_planner_mutex);
+  }
+
+  g_free(path);
+  g_free(wisdom_filename);
+  
+  return(success);
+}
+
+/**
+ * ags_fft_plan_cache_get_instance:
+ *
+ * Get instance, the wisdom is loaded the first time.
+ *
+ * Returns: (transfer none): the #AgsFFTPlanCache
+ *
+ * Since: 3.5.0
+ */
+AgsFFTPlanCache*
+ags_fft_plan_cache_get_instance()
+{
+  static GMutex mutex;
+
+  g_mutex_lock(&mutex);
+
+  if(ags_fft_plan_cache == NULL){
+    ags_fft_plan_cache = ags_fft_plan_cache_new();
+
+    ags_fft_plan_cache_load_wisdom(ags_fft_plan_cache);
+  }
+
+  g_mutex_unlock(&mutex);
+
+  return(ags_fft_plan_cache);
+}
+
+/**
+ * ags_fft_plan_cache_new:
+ *
+ * Create a new instance of #AgsFFTPlanCache
+ *
+ * Returns: the new #AgsFFTPlanCache
+ *
+ * Since: 3.5.0
+ */
+AgsFFTPlanCache*
+ags_fft_plan_cache_new()
+{
+  AgsFFTPlanCache *fft_plan_cache;
+
+  fft_plan_cache = (AgsFFTPlanCache *) g_object_new(AGS_TYPE_FFT_PLAN_CACHE,
+						   NULL);
+
+  return(fft_plan_cache);
+}
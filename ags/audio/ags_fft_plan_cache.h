@@ -0,0 +1,166 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __AGS_FFT_PLAN_CACHE_H__
+#define __AGS_FFT_PLAN_CACHE_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+#include <fftw3.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_FFT_PLAN_CACHE                (ags_fft_plan_cache_get_type())
+#define AGS_FFT_PLAN_CACHE(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_FFT_PLAN_CACHE, AgsFFTPlanCache))
+#define AGS_FFT_PLAN_CACHE_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_FFT_PLAN_CACHE, AgsFFTPlanCacheClass))
+#define AGS_IS_FFT_PLAN_CACHE(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_FFT_PLAN_CACHE))
+#define AGS_IS_FFT_PLAN_CACHE_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_FFT_PLAN_CACHE))
+#define AGS_FFT_PLAN_CACHE_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_FFT_PLAN_CACHE, AgsFFTPlanCacheClass))
+
+#define AGS_FFT_PLAN_CACHE_GET_OBJ_MUTEX(obj) (&(((AgsFFTPlanCache *) obj)->obj_mutex))
+
+#define AGS_FFT_PLAN(ptr) ((AgsFFTPlan *)(ptr))
+
+#define AGS_FFT_PLAN_CACHE_DEFAULT_WISDOM_FILENAME "fftw-wisdom"
+#define AGS_FFT_PLAN_CACHE_DEFAULT_MEASURE_TIME_LIMIT (0.25)
+
+typedef struct _AgsFFTPlanCache AgsFFTPlanCache;
+typedef struct _AgsFFTPlanCacheClass AgsFFTPlanCacheClass;
+typedef struct _AgsFFTPlan AgsFFTPlan;
+
+/**
+ * AgsFFTPlanCacheFlags:
+ * @AGS_FFT_PLAN_CACHE_MEASURE_RUNNING: an asynchronous measure is in progress
+ * @AGS_FFT_PLAN_CACHE_WISDOM_CHANGED: new wisdom wasn't saved, yet
+ *
+ * Enum values to control the behavior or indicate internal state of #AgsFFTPlanCache by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_FFT_PLAN_CACHE_MEASURE_RUNNING        = 1,
+  AGS_FFT_PLAN_CACHE_WISDOM_CHANGED         = 1 <<  1,
+}AgsFFTPlanCacheFlags;
+
+/**
+ * AgsFFTPlanTransform:
+ * @AGS_FFT_PLAN_R2R: real to real transform of #fftw_r2r_kind
+ * @AGS_FFT_PLAN_DFT_R2C: real to complex forward transform
+ * @AGS_FFT_PLAN_DFT_C2R: complex to real backward transform
+ *
+ * Enum values of the transform planned by #AgsFFTPlan.
+ */
+typedef enum{
+  AGS_FFT_PLAN_R2R,
+  AGS_FFT_PLAN_DFT_R2C,
+  AGS_FFT_PLAN_DFT_C2R,
+}AgsFFTPlanTransform;
+
+/**
+ * AgsFFTPlan:
+ * @transform: the #AgsFFTPlanTransform
+ * @n: the transform size
+ * @howmany: the count of contiguous transforms executed at once
+ * @kind: the #fftw_r2r_kind, only used by %AGS_FFT_PLAN_R2R
+ * @alignment: the alignment of the arrays, see fftw_alignment_of()
+ * @measured: %TRUE if @plan was measured
+ * @plan: the current #fftw_plan, %NULL until planned
+ *
+ * #AgsFFTPlan is a shared plan of #AgsFFTPlanCache. It starts with an
+ * estimated plan, that is replaced as soon the measured plan is ready.
+ */
+struct _AgsFFTPlan
+{
+  guint transform;
+
+  guint n;
+  guint howmany;
+  fftw_r2r_kind kind;
+  gint alignment;
+
+  volatile gint measured;
+  volatile gpointer plan;
+};
+
+struct _AgsFFTPlanCache
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  GHashTable *plan;
+
+  GList *pending;
+  GList *retired;
+
+  gchar *wisdom_filename;
+};
+
+struct _AgsFFTPlanCacheClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_fft_plan_cache_get_type(void);
+
+AgsFFTPlan* ags_fft_plan_alloc(guint n,
+			       guint howmany,
+			       fftw_r2r_kind kind,
+			       gint alignment);
+void ags_fft_plan_free(AgsFFTPlan *fft_plan);
+
+void ags_fft_plan_execute_r2r(AgsFFTPlan *fft_plan,
+			      double *in,
+			      double *out);
+void ags_fft_plan_execute_dft_r2c(AgsFFTPlan *fft_plan,
+				  double *in,
+				  fftw_complex *out);
+void ags_fft_plan_execute_dft_c2r(AgsFFTPlan *fft_plan,
+				  fftw_complex *in,
+				  double *out);
+
+AgsFFTPlan* ags_fft_plan_cache_find_r2r(AgsFFTPlanCache *fft_plan_cache,
+					guint n,
+					guint howmany,
+					fftw_r2r_kind kind,
+					gint alignment);
+AgsFFTPlan* ags_fft_plan_cache_find_dft_r2c(AgsFFTPlanCache *fft_plan_cache,
+					    guint n,
+					    gint alignment);
+AgsFFTPlan* ags_fft_plan_cache_find_dft_c2r(AgsFFTPlanCache *fft_plan_cache,
+					    guint n,
+					    gint alignment);
+
+void ags_fft_plan_cache_measure(AgsFFTPlanCache *fft_plan_cache);
+void ags_fft_plan_cache_measure_async(AgsFFTPlanCache *fft_plan_cache);
+
+gboolean ags_fft_plan_cache_load_wisdom(AgsFFTPlanCache *fft_plan_cache);
+gboolean ags_fft_plan_cache_save_wisdom(AgsFFTPlanCache *fft_plan_cache);
+
+AgsFFTPlanCache* ags_fft_plan_cache_get_instance();
+AgsFFTPlanCache* ags_fft_plan_cache_new();
+
+G_END_DECLS
+
+#endif /*__AGS_FFT_PLAN_CACHE_H__*/
@@ -0,0 +1,847 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/ags_level_util.h>
+
+#include <ags/audio/ags_audio_buffer_util.h>
+
+#include <math.h>
+#include <string.h>
+
+/**
+ * SECTION:ags_level_util
+ * @short_description: level util
+ * @title: AgsLevelUtil
+ * @section_id:
+ * @include: ags/audio/ags_level_util.h
+ *
+ * #AgsLevelUtil analyses interleaved audio of any channel count in a single
+ * pass. Every call to ags_level_util_analyse() yields sample peak, RMS and
+ * 4x oversampled true-peak of each channel, as well as the K-weighted
+ * momentary, short-term and integrated loudness as specified by ITU-R BS.1770
+ * and EBU R128.
+ *
+ * The results are published to a ring of #AgsLevelUtilBlock, so metering
+ * recalls, OSC monitors and the export can read them without computing
+ * anything themselves. There is a single writer, readers obtain the most
+ * recent blocks by ags_level_util_get_block().
+ */
+
+void ags_level_util_compute_coefficient(AgsLevelUtil *level_util);
+void ags_level_util_run(AgsLevelUtil *level_util,
+			AgsLevelUtilBlock *block,
+			guint count,
+			gboolean do_peak);
+void ags_level_util_sub_block_done(AgsLevelUtil *level_util);
+
+gdouble ags_level_util_energy_to_loudness(gdouble energy);
+
+/**
+ * ags_level_util_alloc:
+ * @audio_channels: the audio channels
+ * @samplerate: the samplerate
+ *
+ * Allocate #AgsLevelUtil-struct.
+ *
+ * Returns: the newly allocated #AgsLevelUtil-struct
+ *
+ * Since: 3.5.0
+ */
+AgsLevelUtil*
+ags_level_util_alloc(guint audio_channels,
+		     guint samplerate)
+{
+  AgsLevelUtil *ptr;
+
+  gdouble *data;
+
+  guint i, j;
+
+  if(audio_channels == 0){
+    audio_channels = 1;
+  }
+
+  ptr = (AgsLevelUtil *) g_malloc(sizeof(AgsLevelUtil));
+
+  ptr->audio_channels = audio_channels;
+  ptr->samplerate = 0;
+
+  ptr->scratch_size = AGS_LEVEL_UTIL_DEFAULT_SCRATCH_SIZE;
+  ptr->scratch = (gdouble *) g_malloc(audio_channels * ptr->scratch_size * sizeof(gdouble));
+
+  /* loudness weight, 5.1 as L R C LFE Ls Rs */
+  ptr->channel_weight = (gdouble *) g_malloc(audio_channels * sizeof(gdouble));
+
+  for(i = 0; i < audio_channels; i++){
+    ptr->channel_weight[i] = 1.0;
+  }
+
+  if(audio_channels == 6){
+    ptr->channel_weight[3] = 0.0;
+    ptr->channel_weight[4] = 1.41;
+    ptr->channel_weight[5] = 1.41;
+  }
+
+  /* true-peak - windowed sinc polyphase interpolator */
+  ptr->true_peak_coefficient = (gdouble *) g_malloc(AGS_LEVEL_UTIL_OVERSAMPLING * AGS_LEVEL_UTIL_TRUE_PEAK_TAPS * sizeof(gdouble));
+
+  for(i = 0; i < AGS_LEVEL_UTIL_OVERSAMPLING; i++){
+    gdouble sum;
+
+    sum = 0.0;
+
+    for(j = 0; j < AGS_LEVEL_UTIL_TRUE_PEAK_TAPS; j++){
+      gdouble t;
+      gdouble coefficient;
+
+      t = (gdouble) j - (gdouble) (AGS_LEVEL_UTIL_TRUE_PEAK_TAPS / 2) + (gdouble) i / (gdouble) AGS_LEVEL_UTIL_OVERSAMPLING;
+
+      if(t == 0.0){
+	coefficient = 1.0;
+      }else{
+	coefficient = sin(M_PI * t) / (M_PI * t);
+      }
+
+      coefficient *= 0.5 * (1.0 + cos(M_PI * t / (gdouble) (AGS_LEVEL_UTIL_TRUE_PEAK_TAPS / 2 + 1)));
+
+      ptr->true_peak_coefficient[i * AGS_LEVEL_UTIL_TRUE_PEAK_TAPS + j] = coefficient;
+
+      sum += coefficient;
+    }
+
+    for(j = 0; j < AGS_LEVEL_UTIL_TRUE_PEAK_TAPS; j++){
+      ptr->true_peak_coefficient[i * AGS_LEVEL_UTIL_TRUE_PEAK_TAPS + j] /= sum;
+    }
+  }
+
+  ptr->true_peak_history = (gdouble *) g_malloc0(audio_channels * 2 * AGS_LEVEL_UTIL_TRUE_PEAK_TAPS * sizeof(gdouble));
+  ptr->true_peak_offset = 0;
+
+  ptr->filter_state = (gdouble *) g_malloc0(audio_channels * 4 * sizeof(gdouble));
+
+  ptr->histogram_count = (guint64 *) g_malloc0(AGS_LEVEL_UTIL_HISTOGRAM_SIZE * sizeof(guint64));
+  ptr->histogram_energy = (gdouble *) g_malloc0(AGS_LEVEL_UTIL_HISTOGRAM_SIZE * sizeof(gdouble));
+
+  /* block ring - one allocation for all channel values */
+  ptr->block_count = AGS_LEVEL_UTIL_DEFAULT_BLOCK_COUNT;
+  ptr->block = (AgsLevelUtilBlock *) g_malloc0(ptr->block_count * sizeof(AgsLevelUtilBlock));
+
+  data = (gdouble *) g_malloc0(ptr->block_count * 3 * audio_channels * sizeof(gdouble));
+
+  for(i = 0; i < ptr->block_count; i++){
+    ptr->block[i].peak = data + (3 * i) * audio_channels;
+    ptr->block[i].rms = data + (3 * i + 1) * audio_channels;
+    ptr->block[i].true_peak = data + (3 * i + 2) * audio_channels;
+  }
+
+  ptr->serial = 0;
+
+  ags_level_util_set_samplerate(ptr,
+				samplerate);
+
+  ags_level_util_reset(ptr);
+
+  return(ptr);
+}
+
+/**
+ * ags_level_util_free:
+ * @level_util: the #AgsLevelUtil-struct
+ *
+ * Free @level_util.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_level_util_free(AgsLevelUtil *level_util)
+{
+  if(level_util == NULL){
+    return;
+  }
+
+  g_free(level_util->scratch);
+
+  g_free(level_util->channel_weight);
+
+  g_free(level_util->true_peak_coefficient);
+  g_free(level_util->true_peak_history);
+
+  g_free(level_util->filter_state);
+
+  g_free(level_util->histogram_count);
+  g_free(level_util->histogram_energy);
+
+  g_free(level_util->block[0].peak);
+  g_free(level_util->block);
+
+  g_free(level_util);
+}
+
+void
+ags_level_util_compute_coefficient(AgsLevelUtil *level_util)
+{
+  gdouble f0, gain, q;
+  gdouble k, vh, vb, a0;
+
+  /* stage 1 - high shelf, BS.1770 pre-filter derived for any samplerate */
+  f0 = 1681.974450955533;
+  gain = 3.999843853973347;
+  q = 0.7071752369554196;
+
+  k = tan(M_PI * f0 / (gdouble) level_util->samplerate);
+  vh = pow(10.0, gain / 20.0);
+  vb = pow(vh, 0.4996667741545416);
+
+  a0 = 1.0 + k / q + k * k;
+
+  level_util->shelf_b[0] = (vh + vb * k / q + k * k) / a0;
+  level_util->shelf_b[1] = 2.0 * (k * k - vh) / a0;
+  level_util->shelf_b[2] = (vh - vb * k / q + k * k) / a0;
+
+  level_util->shelf_a[0] = 1.0;
+  level_util->shelf_a[1] = 2.0 * (k * k - 1.0) / a0;
+  level_util->shelf_a[2] = (1.0 - k / q + k * k) / a0;
+
+  /* stage 2 - RLB high pass */
+  f0 = 38.13547087602444;
+  q = 0.5003270373238773;
+
+  k = tan(M_PI * f0 / (gdouble) level_util->samplerate);
+
+  a0 = 1.0 + k / q + k * k;
+
+  level_util->highpass_b[0] = 1.0;
+  level_util->highpass_b[1] = -2.0;
+  level_util->highpass_b[2] = 1.0;
+
+  level_util->highpass_a[0] = 1.0;
+  level_util->highpass_a[1] = 2.0 * (k * k - 1.0) / a0;
+  level_util->highpass_a[2] = (1.0 - k / q + k * k) / a0;
+}
+
+/**
+ * ags_level_util_set_samplerate:
+ * @level_util: the #AgsLevelUtil-struct
+ * @samplerate: the samplerate
+ *
+ * Set the samplerate of @level_util. The K-weighting filters are only
+ * recomputed if @samplerate changed, which resets the loudness.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_level_util_set_samplerate(AgsLevelUtil *level_util,
+			      guint samplerate)
+{
+  if(level_util == NULL ||
+     samplerate == 0 ||
+     level_util->samplerate == samplerate){
+    return;
+  }
+
+  level_util->samplerate = samplerate;
+
+  level_util->sub_block_length = samplerate / 10;
+
+  ags_level_util_compute_coefficient(level_util);
+
+  ags_level_util_reset(level_util);
+}
+
+/**
+ * ags_level_util_reset:
+ * @level_util: the #AgsLevelUtil-struct
+ *
+ * Reset the filter state and the loudness history of @level_util. The block
+ * ring is kept, so readers continue to see the last published values.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_level_util_reset(AgsLevelUtil *level_util)
+{
+  guint i;
+
+  if(level_util == NULL){
+    return;
+  }
+
+  memset(level_util->true_peak_history, 0, level_util->audio_channels * 2 * AGS_LEVEL_UTIL_TRUE_PEAK_TAPS * sizeof(gdouble));
+  level_util->true_peak_offset = 0;
+
+  memset(level_util->filter_state, 0, level_util->audio_channels * 4 * sizeof(gdouble));
+
+  level_util->sub_block_frame = 0;
+  level_util->sub_block_energy = 0.0;
+
+  for(i = 0; i < AGS_LEVEL_UTIL_SUB_BLOCK_COUNT; i++){
+    level_util->sub_block[i] = 0.0;
+  }
+
+  level_util->sub_block_offset = 0;
+  level_util->sub_block_count = 0;
+
+  memset(level_util->histogram_count, 0, AGS_LEVEL_UTIL_HISTOGRAM_SIZE * sizeof(guint64));
+  memset(level_util->histogram_energy, 0, AGS_LEVEL_UTIL_HISTOGRAM_SIZE * sizeof(gdouble));
+
+  level_util->integrated = AGS_LEVEL_UTIL_SILENCE;
+
+  level_util->offset = 0;
+}
+
+gdouble
+ags_level_util_energy_to_loudness(gdouble energy)
+{
+  gdouble loudness;
+
+  if(energy <= 0.0){
+    return(AGS_LEVEL_UTIL_SILENCE);
+  }
+
+  loudness = -0.691 + 10.0 * log10(energy);
+
+  if(loudness < AGS_LEVEL_UTIL_SILENCE){
+    loudness = AGS_LEVEL_UTIL_SILENCE;
+  }
+
+  return(loudness);
+}
+
+void
+ags_level_util_sub_block_done(AgsLevelUtil *level_util)
+{
+  gdouble energy;
+  gdouble loudness;
+  guint i;
+
+  level_util->sub_block[level_util->sub_block_offset] = level_util->sub_block_energy / (gdouble) level_util->sub_block_length;
+
+  level_util->sub_block_offset = (level_util->sub_block_offset + 1) % AGS_LEVEL_UTIL_SUB_BLOCK_COUNT;
+
+  if(level_util->sub_block_count < AGS_LEVEL_UTIL_SUB_BLOCK_COUNT){
+    level_util->sub_block_count += 1;
+  }
+
+  level_util->sub_block_frame = 0;
+  level_util->sub_block_energy = 0.0;
+
+  if(level_util->sub_block_count < AGS_LEVEL_UTIL_MOMENTARY_SUB_BLOCK_COUNT){
+    return;
+  }
+
+  /* gating block of 400 ms overlapping by 75 % */
+  energy = 0.0;
+
+  for(i = 0; i < AGS_LEVEL_UTIL_MOMENTARY_SUB_BLOCK_COUNT; i++){
+    energy += level_util->sub_block[(level_util->sub_block_offset + AGS_LEVEL_UTIL_SUB_BLOCK_COUNT - 1 - i) % AGS_LEVEL_UTIL_SUB_BLOCK_COUNT];
+  }
+
+  energy /= (gdouble) AGS_LEVEL_UTIL_MOMENTARY_SUB_BLOCK_COUNT;
+
+  loudness = ags_level_util_energy_to_loudness(energy);
+
+  if(loudness >= AGS_LEVEL_UTIL_HISTOGRAM_MIN){
+    guint nth_bin;
+
+    nth_bin = (guint) ((loudness - AGS_LEVEL_UTIL_HISTOGRAM_MIN) / AGS_LEVEL_UTIL_HISTOGRAM_STEP);
+
+    if(nth_bin >= AGS_LEVEL_UTIL_HISTOGRAM_SIZE){
+      nth_bin = AGS_LEVEL_UTIL_HISTOGRAM_SIZE - 1;
+    }
+
+    level_util->histogram_count[nth_bin] += 1;
+    level_util->histogram_energy[nth_bin] += energy;
+
+    /* absolute gate at -70 LUFS, relative gate 10 LU below */
+    {
+      gdouble sum;
+      gdouble relative;
+      guint64 count;
+      gint start;
+
+      sum = 0.0;
+      count = 0;
+
+      for(i = 0; i < AGS_LEVEL_UTIL_HISTOGRAM_SIZE; i++){
+	sum += level_util->histogram_energy[i];
+	count += level_util->histogram_count[i];
+      }
+
+      relative = ags_level_util_energy_to_loudness(sum / (gdouble) count) - 10.0;
+
+      start = (gint) ceil((relative - AGS_LEVEL_UTIL_HISTOGRAM_MIN) / AGS_LEVEL_UTIL_HISTOGRAM_STEP);
+
+      if(start < 0){
+	start = 0;
+      }
+
+      sum = 0.0;
+      count = 0;
+
+      for(i = start; i < AGS_LEVEL_UTIL_HISTOGRAM_SIZE; i++){
+	sum += level_util->histogram_energy[i];
+	count += level_util->histogram_count[i];
+      }
+
+      if(count > 0){
+	level_util->integrated = ags_level_util_energy_to_loudness(sum / (gdouble) count);
+      }else{
+	level_util->integrated = AGS_LEVEL_UTIL_SILENCE;
+      }
+    }
+  }
+}
+
+void
+ags_level_util_run(AgsLevelUtil *level_util,
+		   AgsLevelUtilBlock *block,
+		   guint count,
+		   gboolean do_peak)
+{
+  gdouble *scratch;
+  gdouble *coefficient;
+
+  guint audio_channels;
+  guint i, j, k;
+
+  scratch = level_util->scratch;
+  coefficient = level_util->true_peak_coefficient;
+
+  audio_channels = level_util->audio_channels;
+
+  for(i = 0; i < count; i++){
+    guint offset;
+
+    offset = level_util->true_peak_offset;
+
+    for(j = 0; j < audio_channels; j++){
+      gdouble *history;
+      gdouble *state;
+
+      gdouble x, y;
+      gdouble square;
+
+      x = scratch[i * audio_channels + j];
+
+      /* sample peak and RMS */
+      square = x * x;
+
+      if(do_peak){
+	if(square > block->peak[j]){
+	  block->peak[j] = square;
+	}
+
+	block->rms[j] += square;
+      }
+
+      /* true-peak */
+      history = level_util->true_peak_history + j * 2 * AGS_LEVEL_UTIL_TRUE_PEAK_TAPS;
+
+      history[offset] = x;
+      history[offset + AGS_LEVEL_UTIL_TRUE_PEAK_TAPS] = x;
+
+      if(square > block->true_peak[j]){
+	block->true_peak[j] = square;
+      }
+
+      for(k = 1; k < AGS_LEVEL_UTIL_OVERSAMPLING; k++){
+	gdouble *current_coefficient;
+	gdouble *window;
+
+	gdouble interpolated;
+	guint l;
+
+	current_coefficient = coefficient + k * AGS_LEVEL_UTIL_TRUE_PEAK_TAPS;
+	window = history + offset + AGS_LEVEL_UTIL_TRUE_PEAK_TAPS;
+
+	interpolated = 0.0;
+
+	for(l = 0; l < AGS_LEVEL_UTIL_TRUE_PEAK_TAPS; l++){
+	  interpolated += current_coefficient[l] * window[-((gint) l)];
+	}
+
+	interpolated *= interpolated;
+
+	if(interpolated > block->true_peak[j]){
+	  block->true_peak[j] = interpolated;
+	}
+      }
+
+      /* K-weighting, transposed direct form II */
+      state = level_util->filter_state + j * 4;
+
+      y = level_util->shelf_b[0] * x + state[0];
+      state[0] = level_util->shelf_b[1] * x - level_util->shelf_a[1] * y + state[1];
+      state[1] = level_util->shelf_b[2] * x - level_util->shelf_a[2] * y;
+
+      x = y;
+
+      y = level_util->highpass_b[0] * x + state[2];
+      state[2] = level_util->highpass_b[1] * x - level_util->highpass_a[1] * y + state[3];
+      state[3] = level_util->highpass_b[2] * x - level_util->highpass_a[2] * y;
+
+      level_util->sub_block_energy += level_util->channel_weight[j] * y * y;
+    }
+
+    level_util->true_peak_offset = (offset + 1) % AGS_LEVEL_UTIL_TRUE_PEAK_TAPS;
+
+    level_util->sub_block_frame += 1;
+
+    if(level_util->sub_block_frame >= level_util->sub_block_length){
+      ags_level_util_sub_block_done(level_util);
+    }
+  }
+}
+
+/**
+ * ags_level_util_analyse:
+ * @level_util: the #AgsLevelUtil-struct
+ * @buffer: the interleaved audio buffer
+ * @buffer_length: the buffer length in frames
+ * @audio_buffer_util_format: the audio buffer util format
+ *
+ * Analyse @buffer and publish the results as the next #AgsLevelUtilBlock.
+ * The audio channels of @buffer are the audio channels of @level_util.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_level_util_analyse(AgsLevelUtil *level_util,
+		       void *buffer, guint buffer_length,
+		       guint audio_buffer_util_format)
+{
+  AgsLevelUtilBlock *block;
+
+  guint audio_channels;
+  guint serial;
+  guint copy_mode;
+  guint offset;
+  guint count;
+  guint i;
+  gboolean do_peak;
+
+  if(level_util == NULL ||
+     buffer == NULL){
+    return;
+  }
+
+  audio_channels = level_util->audio_channels;
+
+  serial = level_util->serial;
+
+  block = level_util->block + (serial % level_util->block_count);
+
+  for(i = 0; i < audio_channels; i++){
+    block->peak[i] = 0.0;
+    block->rms[i] = 0.0;
+    block->true_peak[i] = 0.0;
+  }
+
+  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_DOUBLE,
+						  audio_buffer_util_format);
+
+  for(offset = 0; offset < buffer_length; offset += count){
+    count = buffer_length - offset;
+
+    if(count > level_util->scratch_size){
+      count = level_util->scratch_size;
+    }
+
+    ags_audio_buffer_util_clear_double(level_util->scratch, 1,
+				       audio_channels * count);
+
+    ags_audio_buffer_util_copy_buffer_to_buffer(level_util->scratch, 1, 0,
+						buffer, 1, offset * audio_channels,
+						audio_channels * count, copy_mode);
+
+    do_peak = TRUE;
+
+#if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
+    /* vectorized function - lane i holds channel i % audio_channels */
+    if(8 % audio_channels == 0 &&
+       audio_channels * count >= 8){
+      ags_v8double v_peak;
+      ags_v8double v_sum;
+
+      gdouble *scratch;
+
+      guint limit;
+      guint j;
+
+      scratch = level_util->scratch;
+
+      v_peak = (ags_v8double) {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+      v_sum = (ags_v8double) {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+      limit = audio_channels * count - ((audio_channels * count) % 8);
+
+      for(j = 0; j < limit; j += 8){
+	ags_v8double v_buffer;
+
+	v_buffer = (ags_v8double) {scratch[j],
+				   scratch[j + 1],
+				   scratch[j + 2],
+				   scratch[j + 3],
+				   scratch[j + 4],
+				   scratch[j + 5],
+				   scratch[j + 6],
+				   scratch[j + 7]};
+
+	v_buffer = v_buffer * v_buffer;
+
+	v_sum += v_buffer;
+
+	if(v_buffer[0] > v_peak[0]){
+	  v_peak[0] = v_buffer[0];
+	}
+
+	if(v_buffer[1] > v_peak[1]){
+	  v_peak[1] = v_buffer[1];
+	}
+
+	if(v_buffer[2] > v_peak[2]){
+	  v_peak[2] = v_buffer[2];
+	}
+
+	if(v_buffer[3] > v_peak[3]){
+	  v_peak[3] = v_buffer[3];
+	}
+
+	if(v_buffer[4] > v_peak[4]){
+	  v_peak[4] = v_buffer[4];
+	}
+
+	if(v_buffer[5] > v_peak[5]){
+	  v_peak[5] = v_buffer[5];
+	}
+
+	if(v_buffer[6] > v_peak[6]){
+	  v_peak[6] = v_buffer[6];
+	}
+
+	if(v_buffer[7] > v_peak[7]){
+	  v_peak[7] = v_buffer[7];
+	}
+      }
+
+      for(; j < audio_channels * count; j++){
+	gdouble square;
+
+	square = scratch[j] * scratch[j];
+
+	if(square > block->peak[j % audio_channels]){
+	  block->peak[j % audio_channels] = square;
+	}
+
+	block->rms[j % audio_channels] += square;
+      }
+
+      for(j = 0; j < 8; j++){
+	if(v_peak[j] > block->peak[j % audio_channels]){
+	  block->peak[j % audio_channels] = v_peak[j];
+	}
+
+	block->rms[j % audio_channels] += v_sum[j];
+      }
+
+      do_peak = FALSE;
+    }
+#endif
+
+    ags_level_util_run(level_util,
+		       block,
+		       count,
+		       do_peak);
+  }
+
+  /* finalize block */
+  for(i = 0; i < audio_channels; i++){
+    block->peak[i] = sqrt(block->peak[i]);
+    block->true_peak[i] = sqrt(block->true_peak[i]);
+
+    if(buffer_length > 0){
+      block->rms[i] = sqrt(block->rms[i] / (gdouble) buffer_length);
+    }
+  }
+
+  block->offset = level_util->offset;
+  block->buffer_length = buffer_length;
+
+  block->momentary = ags_level_util_get_momentary(level_util);
+  block->short_term = ags_level_util_get_short_term(level_util);
+  block->integrated = level_util->integrated;
+
+  block->serial = serial;
+
+  level_util->offset += buffer_length;
+
+  /* publish */
+  g_atomic_int_set(&(level_util->serial),
+		   serial + 1);
+}
+
+/**
+ * ags_level_util_get_block:
+ * @level_util: the #AgsLevelUtil-struct
+ * @nth: the block to get, 0 is the most recent one
+ *
+ * Get the @nth most recent block. The block is owned by @level_util and
+ * overwritten after #AgsLevelUtil-struct.block_count further calls to
+ * ags_level_util_analyse(), compare #AgsLevelUtilBlock-struct.serial if you
+ * hold it longer.
+ *
+ * Returns: the #AgsLevelUtilBlock-struct or %NULL if not available
+ *
+ * Since: 3.5.0
+ */
+AgsLevelUtilBlock*
+ags_level_util_get_block(AgsLevelUtil *level_util,
+			 guint nth)
+{
+  guint serial;
+
+  if(level_util == NULL){
+    return(NULL);
+  }
+
+  serial = g_atomic_int_get(&(level_util->serial));
+
+  /* keep one block distance to the writer */
+  if(nth + 1 >= level_util->block_count ||
+     nth >= serial){
+    return(NULL);
+  }
+
+  return(level_util->block + ((serial - 1 - nth) % level_util->block_count));
+}
+
+/**
+ * ags_level_util_get_momentary:
+ * @level_util: the #AgsLevelUtil-struct
+ *
+ * Get the momentary loudness of the last 400 ms.
+ *
+ * Returns: the loudness in LUFS
+ *
+ * Since: 3.5.0
+ */
+gdouble
+ags_level_util_get_momentary(AgsLevelUtil *level_util)
+{
+  gdouble energy;
+  guint count;
+  guint i;
+
+  if(level_util == NULL ||
+     level_util->sub_block_count == 0){
+    return(AGS_LEVEL_UTIL_SILENCE);
+  }
+
+  count = level_util->sub_block_count;
+
+  if(count > AGS_LEVEL_UTIL_MOMENTARY_SUB_BLOCK_COUNT){
+    count = AGS_LEVEL_UTIL_MOMENTARY_SUB_BLOCK_COUNT;
+  }
+
+  energy = 0.0;
+
+  for(i = 0; i < count; i++){
+    energy += level_util->sub_block[(level_util->sub_block_offset + AGS_LEVEL_UTIL_SUB_BLOCK_COUNT - 1 - i) % AGS_LEVEL_UTIL_SUB_BLOCK_COUNT];
+  }
+
+  return(ags_level_util_energy_to_loudness(energy / (gdouble) count));
+}
+
+/**
+ * ags_level_util_get_short_term:
+ * @level_util: the #AgsLevelUtil-struct
+ *
+ * Get the short-term loudness of the last 3 s.
+ *
+ * Returns: the loudness in LUFS
+ *
+ * Since: 3.5.0
+ */
+gdouble
+ags_level_util_get_short_term(AgsLevelUtil *level_util)
+{
+  gdouble energy;
+  guint i;
+
+  if(level_util == NULL ||
+     level_util->sub_block_count == 0){
+    return(AGS_LEVEL_UTIL_SILENCE);
+  }
+
+  energy = 0.0;
+
+  for(i = 0; i < level_util->sub_block_count; i++){
+    energy += level_util->sub_block[(level_util->sub_block_offset + AGS_LEVEL_UTIL_SUB_BLOCK_COUNT - 1 - i) % AGS_LEVEL_UTIL_SUB_BLOCK_COUNT];
+  }
+
+  return(ags_level_util_energy_to_loudness(energy / (gdouble) level_util->sub_block_count));
+}
+
+/**
+ * ags_level_util_get_integrated:
+ * @level_util: the #AgsLevelUtil-struct
+ *
+ * Get the gated integrated loudness since last reset.
+ *
+ * Returns: the loudness in LUFS
+ *
+ * Since: 3.5.0
+ */
+gdouble
+ags_level_util_get_integrated(AgsLevelUtil *level_util)
+{
+  if(level_util == NULL){
+    return(AGS_LEVEL_UTIL_SILENCE);
+  }
+
+  return(level_util->integrated);
+}
+
+/**
+ * ags_level_util_to_db:
+ * @amplitude: the linear amplitude
+ *
+ * Convert @amplitude to dBFS.
+ *
+ * Returns: the level in dBFS
+ *
+ * Since: 3.5.0
+ */
+gdouble
+ags_level_util_to_db(gdouble amplitude)
+{
+  gdouble level;
+
+  if(amplitude <= 0.0){
+    return(AGS_LEVEL_UTIL_SILENCE);
+  }
+
+  level = 20.0 * log10(amplitude);
+
+  if(level < AGS_LEVEL_UTIL_SILENCE){
+    level = AGS_LEVEL_UTIL_SILENCE;
+  }
+
+  return(level);
+}
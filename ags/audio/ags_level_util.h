@@ -0,0 +1,179 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_LEVEL_UTIL_H__
+#define __AGS_LEVEL_UTIL_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+G_BEGIN_DECLS
+
+#define AGS_LEVEL_UTIL(ptr) ((AgsLevelUtil *)(ptr))
+#define AGS_LEVEL_UTIL_BLOCK(ptr) ((AgsLevelUtilBlock *)(ptr))
+
+#define AGS_LEVEL_UTIL_DEFAULT_BLOCK_COUNT (32)
+#define AGS_LEVEL_UTIL_DEFAULT_SCRATCH_SIZE (4096)
+
+#define AGS_LEVEL_UTIL_OVERSAMPLING (4)
+#define AGS_LEVEL_UTIL_TRUE_PEAK_TAPS (12)
+
+#define AGS_LEVEL_UTIL_SUB_BLOCK_COUNT (30)
+#define AGS_LEVEL_UTIL_MOMENTARY_SUB_BLOCK_COUNT (4)
+
+#define AGS_LEVEL_UTIL_HISTOGRAM_SIZE (1000)
+#define AGS_LEVEL_UTIL_HISTOGRAM_MIN (-70.0)
+#define AGS_LEVEL_UTIL_HISTOGRAM_STEP (0.1)
+
+#define AGS_LEVEL_UTIL_SILENCE (-144.0)
+
+typedef struct _AgsLevelUtil AgsLevelUtil;
+typedef struct _AgsLevelUtilBlock AgsLevelUtilBlock;
+
+/**
+ * AgsLevelUtilBlock:
+ * @serial: the serial number of the block
+ * @offset: the frame offset of the block since last reset
+ * @buffer_length: the number of frames analysed
+ * @peak: the sample peak of each channel as linear amplitude
+ * @rms: the RMS of each channel as linear amplitude
+ * @true_peak: the 4x oversampled true-peak of each channel as linear amplitude
+ * @momentary: the momentary loudness in LUFS
+ * @short_term: the short-term loudness in LUFS
+ * @integrated: the gated integrated loudness in LUFS
+ *
+ * #AgsLevelUtilBlock holds the analysis result of one call to ags_level_util_analyse().
+ */
+struct _AgsLevelUtilBlock
+{
+  guint serial;
+
+  guint64 offset;
+  guint buffer_length;
+
+  gdouble *peak;
+  gdouble *rms;
+  gdouble *true_peak;
+
+  gdouble momentary;
+  gdouble short_term;
+  gdouble integrated;
+};
+
+/**
+ * AgsLevelUtil:
+ * @audio_channels: the audio channels
+ * @samplerate: the samplerate
+ * @scratch_size: the scratch size in frames
+ * @scratch: the interleaved scratch buffer
+ * @channel_weight: the loudness weight of each channel
+ * @true_peak_coefficient: the polyphase interpolation coefficients
+ * @true_peak_history: the interpolation history of each channel
+ * @true_peak_offset: the interpolation history offset
+ * @shelf_b: the K-weighting high shelf numerator
+ * @shelf_a: the K-weighting high shelf denominator
+ * @highpass_b: the K-weighting high pass numerator
+ * @highpass_a: the K-weighting high pass denominator
+ * @filter_state: the K-weighting filter state of each channel
+ * @sub_block_length: the loudness sub block length in frames
+ * @sub_block_frame: the frames accumulated in the current sub block
+ * @sub_block_energy: the weighted energy of the current sub block
+ * @sub_block: the mean energy of the most recent sub blocks
+ * @sub_block_offset: the next sub block index
+ * @sub_block_count: the number of filled sub blocks
+ * @histogram_count: the gating block count of each histogram bin
+ * @histogram_energy: the gating block energy of each histogram bin
+ * @integrated: the cached integrated loudness
+ * @offset: the frame offset since last reset
+ * @block_count: the number of blocks in the ring
+ * @block: the block ring
+ * @serial: the serial number of the next block
+ *
+ * #AgsLevelUtil computes peak, RMS, true-peak and EBU R128 loudness of
+ * interleaved audio in one pass and publishes a ring of #AgsLevelUtilBlock.
+ */
+struct _AgsLevelUtil
+{
+  guint audio_channels;
+  guint samplerate;
+
+  guint scratch_size;
+  gdouble *scratch;
+
+  gdouble *channel_weight;
+
+  gdouble *true_peak_coefficient;
+  gdouble *true_peak_history;
+  guint true_peak_offset;
+
+  gdouble shelf_b[3];
+  gdouble shelf_a[3];
+  gdouble highpass_b[3];
+  gdouble highpass_a[3];
+
+  gdouble *filter_state;
+
+  guint sub_block_length;
+  guint sub_block_frame;
+  gdouble sub_block_energy;
+
+  gdouble sub_block[AGS_LEVEL_UTIL_SUB_BLOCK_COUNT];
+  guint sub_block_offset;
+  guint sub_block_count;
+
+  guint64 *histogram_count;
+  gdouble *histogram_energy;
+
+  gdouble integrated;
+
+  guint64 offset;
+
+  guint block_count;
+  AgsLevelUtilBlock *block;
+
+  volatile guint serial;
+};
+
+AgsLevelUtil* ags_level_util_alloc(guint audio_channels,
+				   guint samplerate);
+void ags_level_util_free(AgsLevelUtil *level_util);
+
+void ags_level_util_set_samplerate(AgsLevelUtil *level_util,
+				   guint samplerate);
+
+void ags_level_util_reset(AgsLevelUtil *level_util);
+
+void ags_level_util_analyse(AgsLevelUtil *level_util,
+			    void *buffer, guint buffer_length,
+			    guint audio_buffer_util_format);
+
+AgsLevelUtilBlock* ags_level_util_get_block(AgsLevelUtil *level_util,
+					    guint nth);
+
+gdouble ags_level_util_get_momentary(AgsLevelUtil *level_util);
+gdouble ags_level_util_get_short_term(AgsLevelUtil *level_util);
+gdouble ags_level_util_get_integrated(AgsLevelUtil *level_util);
+
+gdouble ags_level_util_to_db(gdouble amplitude);
+
+G_END_DECLS
+
+#endif /*__AGS_LEVEL_UTIL_H__*/
@@ -0,0 +1,726 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/ags_meter_snapshot.h>
+
+#include <ags/audio/ags_port.h>
+
+#include <string.h>
+
+void ags_meter_snapshot_class_init(AgsMeterSnapshotClass *meter_snapshot);
+void ags_meter_snapshot_init (AgsMeterSnapshot *meter_snapshot);
+void ags_meter_snapshot_finalize(GObject *gobject);
+
+guint ags_meter_snapshot_entry_hash(gconstpointer key);
+gboolean ags_meter_snapshot_entry_equal(gconstpointer a,
+					gconstpointer b);
+
+gboolean ags_meter_snapshot_read_port(AgsPort *port,
+				      gdouble *value);
+gboolean ags_meter_snapshot_read_value(AgsMeterSnapshotEntry *entry,
+				       gdouble *value);
+
+/**
+ * SECTION:ags_meter_snapshot
+ * @short_description: double-buffered meter snapshot
+ * @title: AgsMeterSnapshot
+ * @section_id:
+ * @include: ags/audio/ags_meter_snapshot.h
+ *
+ * #AgsMeterSnapshot is a singleton the engine publishes peaks, playback
+ * position and LED state to. It is published once per period by the audio
+ * loop into the back buffer and then flipped, so readers get a consistent
+ * front buffer without taking any lock the audio threads might hold.
+ */
+
+static gpointer ags_meter_snapshot_parent_class = NULL;
+
+AgsMeterSnapshot *ags_meter_snapshot = NULL;
+
+GType
+ags_meter_snapshot_get_type (void)
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_meter_snapshot = 0;
+
+    static const GTypeInfo ags_meter_snapshot_info = {
+      sizeof (AgsMeterSnapshotClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_meter_snapshot_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof (AgsMeterSnapshot),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_meter_snapshot_init,
+    };
+
+    ags_type_meter_snapshot = g_type_register_static(G_TYPE_OBJECT,
+						     "AgsMeterSnapshot",
+						     &ags_meter_snapshot_info,
+						     0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_meter_snapshot);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_meter_snapshot_class_init(AgsMeterSnapshotClass *meter_snapshot)
+{
+  GObjectClass *gobject;
+
+  ags_meter_snapshot_parent_class = g_type_class_peek_parent(meter_snapshot);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) meter_snapshot;
+
+  gobject->finalize = ags_meter_snapshot_finalize;
+}
+
+void
+ags_meter_snapshot_init(AgsMeterSnapshot *meter_snapshot)
+{
+  meter_snapshot->flags = 0;
+
+  /* meter snapshot mutex */
+  g_rec_mutex_init(&(meter_snapshot->obj_mutex));
+
+  /* entries - preallocated so the audio threads never see a reallocation */
+  meter_snapshot->slot_count = AGS_METER_SNAPSHOT_DEFAULT_SLOT_COUNT;
+  meter_snapshot->n_entries = 0;
+
+  meter_snapshot->entry = (AgsMeterSnapshotEntry *) g_malloc0(meter_snapshot->slot_count * sizeof(AgsMeterSnapshotEntry));
+
+  meter_snapshot->slot = g_hash_table_new(ags_meter_snapshot_entry_hash,
+					  ags_meter_snapshot_entry_equal);
+
+  /* double buffer */
+  meter_snapshot->buffer[0] = (gdouble *) g_malloc0(meter_snapshot->slot_count * sizeof(gdouble));
+  meter_snapshot->buffer[1] = (gdouble *) g_malloc0(meter_snapshot->slot_count * sizeof(gdouble));
+
+  meter_snapshot->front = 0;
+  meter_snapshot->generation = 0;
+
+  meter_snapshot->subscription_generation = 0;
+}
+
+void
+ags_meter_snapshot_finalize(GObject *gobject)
+{
+  AgsMeterSnapshot *meter_snapshot;
+
+  guint i;
+
+  meter_snapshot = AGS_METER_SNAPSHOT(gobject);
+
+  for(i = 0; i < meter_snapshot->n_entries; i++){
+    if(meter_snapshot->entry[i].source != NULL){
+      g_object_unref(meter_snapshot->entry[i].source);
+    }
+  }
+
+  g_free(meter_snapshot->entry);
+
+  g_hash_table_destroy(meter_snapshot->slot);
+
+  g_free(meter_snapshot->buffer[0]);
+  g_free(meter_snapshot->buffer[1]);
+
+  /* singleton */
+  if(meter_snapshot == ags_meter_snapshot){
+    ags_meter_snapshot = NULL;
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_meter_snapshot_parent_class)->finalize(gobject);
+}
+
+guint
+ags_meter_snapshot_entry_hash(gconstpointer key)
+{
+  const AgsMeterSnapshotEntry *entry;
+
+  entry = key;
+
+  return(g_direct_hash(entry->source) ^ entry->entry_type);
+}
+
+gboolean
+ags_meter_snapshot_entry_equal(gconstpointer a,
+			       gconstpointer b)
+{
+  const AgsMeterSnapshotEntry *a_entry, *b_entry;
+
+  a_entry = a;
+  b_entry = b;
+
+  return(a_entry->source == b_entry->source &&
+	 a_entry->entry_type == b_entry->entry_type);
+}
+
+/**
+ * ags_meter_snapshot_subscribe:
+ * @meter_snapshot: the #AgsMeterSnapshot
+ * @source: the source #GObject
+ * @entry_type: the #AgsMeterSnapshotEntryType-enum
+ *
+ * Subscribe @source to @meter_snapshot. Subscribing the same @source
+ * with the same @entry_type again returns the same slot and increments
+ * its subscriber count.
+ *
+ * Returns: the slot to pass to ags_meter_snapshot_read() or
+ * %AGS_METER_SNAPSHOT_INVALID_SLOT if no slot is available
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_meter_snapshot_subscribe(AgsMeterSnapshot *meter_snapshot,
+			     GObject *source,
+			     guint entry_type)
+{
+  AgsMeterSnapshotEntry *entry;
+  AgsMeterSnapshotEntry key;
+
+  gpointer ptr;
+
+  guint slot;
+  guint i;
+
+  GRecMutex *meter_snapshot_mutex;
+
+  if(!AGS_IS_METER_SNAPSHOT(meter_snapshot) ||
+     !G_IS_OBJECT(source)){
+    return(AGS_METER_SNAPSHOT_INVALID_SLOT);
+  }
+
+  meter_snapshot_mutex = AGS_METER_SNAPSHOT_GET_OBJ_MUTEX(meter_snapshot);
+
+  key.source = source;
+  key.entry_type = entry_type;
+
+  g_rec_mutex_lock(meter_snapshot_mutex);
+
+  /* already subscribed */
+  ptr = g_hash_table_lookup(meter_snapshot->slot,
+			    &key);
+
+  if(ptr != NULL){
+    slot = GPOINTER_TO_UINT(ptr) - 1;
+
+    meter_snapshot->entry[slot].ref_count += 1;
+
+    g_rec_mutex_unlock(meter_snapshot_mutex);
+
+    return(slot);
+  }
+
+  /* find free slot */
+  slot = AGS_METER_SNAPSHOT_INVALID_SLOT;
+
+  for(i = 0; i < meter_snapshot->n_entries; i++){
+    if(meter_snapshot->entry[i].source == NULL){
+      slot = i;
+
+      break;
+    }
+  }
+
+  if(slot == AGS_METER_SNAPSHOT_INVALID_SLOT){
+    if(meter_snapshot->n_entries >= meter_snapshot->slot_count){
+      g_rec_mutex_unlock(meter_snapshot_mutex);
+
+      g_warning("meter snapshot - no slot available");
+
+      return(AGS_METER_SNAPSHOT_INVALID_SLOT);
+    }
+
+    slot = meter_snapshot->n_entries;
+  }
+
+  entry = meter_snapshot->entry + slot;
+
+  entry->entry_type = entry_type;
+  entry->ref_count = 1;
+
+  g_atomic_int_set(&(entry->sequence),
+		   0);
+  entry->value = 0.0;
+
+  meter_snapshot->buffer[0][slot] = 0.0;
+  meter_snapshot->buffer[1][slot] = 0.0;
+
+  g_object_ref(source);
+  g_atomic_pointer_set(&(entry->source),
+		       source);
+
+  if(slot == meter_snapshot->n_entries){
+    g_atomic_int_inc(&(meter_snapshot->n_entries));
+  }
+
+  g_hash_table_insert(meter_snapshot->slot,
+		      entry,
+		      GUINT_TO_POINTER(slot + 1));
+
+  g_atomic_int_inc(&(meter_snapshot->subscription_generation));
+
+  g_rec_mutex_unlock(meter_snapshot_mutex);
+
+  return(slot);
+}
+
+/**
+ * ags_meter_snapshot_unsubscribe:
+ * @meter_snapshot: the #AgsMeterSnapshot
+ * @slot: the slot
+ *
+ * Unsubscribe @slot of @meter_snapshot. The slot is released as soon
+ * as its last subscriber is gone.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_meter_snapshot_unsubscribe(AgsMeterSnapshot *meter_snapshot,
+			       guint slot)
+{
+  AgsMeterSnapshotEntry *entry;
+
+  gpointer source;
+
+  GRecMutex *meter_snapshot_mutex;
+
+  if(!AGS_IS_METER_SNAPSHOT(meter_snapshot)){
+    return;
+  }
+
+  meter_snapshot_mutex = AGS_METER_SNAPSHOT_GET_OBJ_MUTEX(meter_snapshot);
+
+  g_rec_mutex_lock(meter_snapshot_mutex);
+
+  if(slot >= meter_snapshot->n_entries){
+    g_rec_mutex_unlock(meter_snapshot_mutex);
+
+    return;
+  }
+
+  entry = meter_snapshot->entry + slot;
+  source = entry->source;
+
+  if(source == NULL){
+    g_rec_mutex_unlock(meter_snapshot_mutex);
+
+    return;
+  }
+
+  entry->ref_count -= 1;
+
+  if(entry->ref_count == 0){
+    g_hash_table_remove(meter_snapshot->slot,
+			entry);
+
+    g_atomic_pointer_set(&(entry->source),
+			 NULL);
+
+    g_atomic_int_inc(&(meter_snapshot->subscription_generation));
+
+    g_object_unref(source);
+  }
+
+  g_rec_mutex_unlock(meter_snapshot_mutex);
+}
+
+/**
+ * ags_meter_snapshot_try_find_slot:
+ * @meter_snapshot: the #AgsMeterSnapshot
+ * @source: the source #GObject
+ * @entry_type: the #AgsMeterSnapshotEntryType-enum
+ * @slot: (out): return location of the slot
+ *
+ * Find the slot of @source subscribed as @entry_type. This function
+ * doesn't wait for the lock, if a subscription is just modified it
+ * returns %FALSE and the caller should retry the next period.
+ *
+ * Returns: %TRUE if the lookup completed, @slot is set to
+ * %AGS_METER_SNAPSHOT_INVALID_SLOT if not subscribed
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_meter_snapshot_try_find_slot(AgsMeterSnapshot *meter_snapshot,
+				 GObject *source,
+				 guint entry_type,
+				 guint *slot)
+{
+  AgsMeterSnapshotEntry key;
+
+  gpointer ptr;
+
+  GRecMutex *meter_snapshot_mutex;
+
+  if(slot != NULL){
+    slot[0] = AGS_METER_SNAPSHOT_INVALID_SLOT;
+  }
+  
+  if(meter_snapshot == NULL ||
+     source == NULL){
+    return(TRUE);
+  }
+
+  meter_snapshot_mutex = AGS_METER_SNAPSHOT_GET_OBJ_MUTEX(meter_snapshot);
+
+  if(!g_rec_mutex_trylock(meter_snapshot_mutex)){
+    return(FALSE);
+  }
+
+  key.source = source;
+  key.entry_type = entry_type;
+
+  ptr = g_hash_table_lookup(meter_snapshot->slot,
+			    &key);
+
+  if(ptr != NULL &&
+     slot != NULL){
+    slot[0] = GPOINTER_TO_UINT(ptr) - 1;
+  }
+
+  g_rec_mutex_unlock(meter_snapshot_mutex);
+
+  return(TRUE);
+}
+
+/**
+ * ags_meter_snapshot_put:
+ * @meter_snapshot: the #AgsMeterSnapshot
+ * @slot: the slot as returned by ags_meter_snapshot_try_find_slot()
+ * @source: the source #GObject
+ * @value: the value
+ *
+ * Push @value of @source to @slot of @meter_snapshot. It becomes visible
+ * to readers with the next ags_meter_snapshot_publish(). If @slot was
+ * released or reused by another source meanwhile, @value is dropped.
+ * This function doesn't take any lock, it is safe to call from the audio
+ * threads.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_meter_snapshot_put(AgsMeterSnapshot *meter_snapshot,
+		       guint slot,
+		       GObject *source,
+		       gdouble value)
+{
+  AgsMeterSnapshotEntry *entry;
+
+  guint sequence;
+
+  if(meter_snapshot == NULL ||
+     source == NULL ||
+     slot >= g_atomic_int_get(&(meter_snapshot->n_entries))){
+    return;
+  }
+
+  entry = meter_snapshot->entry + slot;
+
+  if(g_atomic_pointer_get(&(entry->source)) != source ||
+     (AGS_METER_SNAPSHOT_ENTRY_PUSHED & (entry->entry_type)) == 0){
+    return;
+  }
+
+  /* sequence lock - odd while writing */
+  sequence = g_atomic_int_get(&(entry->sequence));
+
+  g_atomic_int_set(&(entry->sequence),
+		   sequence + 1);
+
+  entry->value = value;
+
+  g_atomic_int_set(&(entry->sequence),
+		   sequence + 2);
+}
+
+gboolean
+ags_meter_snapshot_read_port(AgsPort *port,
+			     gdouble *value)
+{
+  GRecMutex *port_mutex;
+
+  port_mutex = AGS_PORT_GET_OBJ_MUTEX(port);
+
+  /* the port is just written - keep the recent value */
+  if(!g_rec_mutex_trylock(port_mutex)){
+    return(FALSE);
+  }
+
+  value[0] = 0.0;
+
+  if(!port->port_value_is_pointer){
+    if(port->port_value_type == G_TYPE_FLOAT){
+      value[0] = (gdouble) port->port_value.ags_port_float;
+    }else if(port->port_value_type == G_TYPE_DOUBLE){
+      value[0] = port->port_value.ags_port_double;
+    }else if(port->port_value_type == G_TYPE_BOOLEAN){
+      value[0] = (port->port_value.ags_port_boolean) ? 1.0: 0.0;
+    }else if(port->port_value_type == G_TYPE_INT64){
+      value[0] = (gdouble) port->port_value.ags_port_int;
+    }else if(port->port_value_type == G_TYPE_UINT64){
+      value[0] = (gdouble) port->port_value.ags_port_uint;
+    }
+  }
+
+  g_rec_mutex_unlock(port_mutex);
+
+  return(TRUE);
+}
+
+gboolean
+ags_meter_snapshot_read_value(AgsMeterSnapshotEntry *entry,
+			      gdouble *value)
+{
+  gdouble current_value;
+
+  guint first_sequence, second_sequence;
+  guint i;
+
+  for(i = 0; i < AGS_METER_SNAPSHOT_READ_RETRIES; i++){
+    first_sequence = g_atomic_int_get(&(entry->sequence));
+
+    if((1 & first_sequence) != 0){
+      continue;
+    }
+
+    current_value = entry->value;
+
+    second_sequence = g_atomic_int_get(&(entry->sequence));
+
+    if(first_sequence == second_sequence){
+      value[0] = current_value;
+
+      return(TRUE);
+    }
+  }
+
+  return(FALSE);
+}
+
+/**
+ * ags_meter_snapshot_publish:
+ * @meter_snapshot: the #AgsMeterSnapshot
+ *
+ * Fill the back buffer of @meter_snapshot and make it the front buffer.
+ * It is called once per period by #AgsAudioLoop. If a subscription is just
+ * modified the period is skipped rather than waiting for it, a port or
+ * pushed value just written keeps its recent value.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_meter_snapshot_publish(AgsMeterSnapshot *meter_snapshot)
+{
+  AgsMeterSnapshotEntry *entry;
+
+  GObject *source;
+
+  gdouble *front_buffer, *back_buffer;
+
+  gint front;
+  guint i;
+
+  GRecMutex *meter_snapshot_mutex;
+
+  if(!AGS_IS_METER_SNAPSHOT(meter_snapshot)){
+    return;
+  }
+
+  meter_snapshot_mutex = AGS_METER_SNAPSHOT_GET_OBJ_MUTEX(meter_snapshot);
+
+  if(!g_rec_mutex_trylock(meter_snapshot_mutex)){
+    return;
+  }
+
+  front = g_atomic_int_get(&(meter_snapshot->front));
+  front_buffer = meter_snapshot->buffer[front];
+  back_buffer = meter_snapshot->buffer[1 - front];
+
+  for(i = 0; i < meter_snapshot->n_entries; i++){
+    entry = meter_snapshot->entry + i;
+    source = entry->source;
+
+    if(source == NULL){
+      continue;
+    }
+
+    /* a contended value keeps its recent value */
+    back_buffer[i] = front_buffer[i];
+
+    switch(entry->entry_type){
+    case AGS_METER_SNAPSHOT_ENTRY_PORT:
+      {
+	ags_meter_snapshot_read_port((AgsPort *) source,
+				     back_buffer + i);
+      }
+      break;
+    case AGS_METER_SNAPSHOT_ENTRY_SOUNDCARD:
+      {
+	back_buffer[i] = (gdouble) ags_soundcard_get_note_offset(AGS_SOUNDCARD(source));
+      }
+      break;
+    case AGS_METER_SNAPSHOT_ENTRY_PUSHED:
+      {
+	ags_meter_snapshot_read_value(entry,
+				      back_buffer + i);
+      }
+      break;
+    }
+  }
+
+  /* flip */
+  g_atomic_int_set(&(meter_snapshot->front),
+		   1 - front);
+  g_atomic_int_inc(&(meter_snapshot->generation));
+
+  g_rec_mutex_unlock(meter_snapshot_mutex);
+}
+
+/**
+ * ags_meter_snapshot_read:
+ * @meter_snapshot: the #AgsMeterSnapshot
+ * @slot: the slot
+ *
+ * Read the published value of @slot. This function doesn't take any lock.
+ *
+ * Returns: the value of @slot of the front buffer
+ *
+ * Since: 3.5.0
+ */
+gdouble
+ags_meter_snapshot_read(AgsMeterSnapshot *meter_snapshot,
+			guint slot)
+{
+  gdouble *front_buffer;
+
+  gdouble value;
+
+  guint generation;
+  
+  if(meter_snapshot == NULL ||
+     slot >= meter_snapshot->slot_count){
+    return(0.0);
+  }
+
+  /* the read front buffer is written again two publishes later */
+  do{
+    generation = g_atomic_int_get(&(meter_snapshot->generation));
+    
+    front_buffer = meter_snapshot->buffer[g_atomic_int_get(&(meter_snapshot->front))];
+
+    value = front_buffer[slot];
+  }while(g_atomic_int_get(&(meter_snapshot->generation)) - generation > 1);
+
+  return(value);
+}
+
+/**
+ * ags_meter_snapshot_get_generation:
+ * @meter_snapshot: the #AgsMeterSnapshot
+ *
+ * Get generation of @meter_snapshot, it is incremented by every publish.
+ *
+ * Returns: the generation
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_meter_snapshot_get_generation(AgsMeterSnapshot *meter_snapshot)
+{
+  if(meter_snapshot == NULL){
+    return(0);
+  }
+
+  return(g_atomic_int_get(&(meter_snapshot->generation)));
+}
+
+/**
+ * ags_meter_snapshot_get_subscription_generation:
+ * @meter_snapshot: the #AgsMeterSnapshot
+ *
+ * Get subscription generation of @meter_snapshot, it is incremented by
+ * every slot taken or released. Slots looked up by
+ * ags_meter_snapshot_try_find_slot() are valid as long as it is unchanged.
+ *
+ * Returns: the subscription generation
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_meter_snapshot_get_subscription_generation(AgsMeterSnapshot *meter_snapshot)
+{
+  if(meter_snapshot == NULL){
+    return(0);
+  }
+
+  return(g_atomic_int_get(&(meter_snapshot->subscription_generation)));
+}
+
+/**
+ * ags_meter_snapshot_get_instance:
+ *
+ * Get instance.
+ *
+ * Returns: (transfer none): the #AgsMeterSnapshot
+ *
+ * Since: 3.5.0
+ */
+AgsMeterSnapshot*
+ags_meter_snapshot_get_instance()
+{
+  static GMutex mutex;
+
+  g_mutex_lock(&mutex);
+
+  if(ags_meter_snapshot == NULL){
+    ags_meter_snapshot = ags_meter_snapshot_new();
+  }
+
+  g_mutex_unlock(&mutex);
+
+  return(ags_meter_snapshot);
+}
+
+/**
+ * ags_meter_snapshot_new:
+ *
+ * Create a new instance of #AgsMeterSnapshot
+ *
+ * Returns: the new #AgsMeterSnapshot
+ *
+ * Since: 3.5.0
+ */
+AgsMeterSnapshot*
+ags_meter_snapshot_new()
+{
+  AgsMeterSnapshot *meter_snapshot;
+
+  meter_snapshot = (AgsMeterSnapshot *) g_object_new(AGS_TYPE_METER_SNAPSHOT,
+						     NULL);
+
+  return(meter_snapshot);
+}
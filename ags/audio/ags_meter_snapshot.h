@@ -0,0 +1,142 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_METER_SNAPSHOT_H__
+#define __AGS_METER_SNAPSHOT_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_METER_SNAPSHOT                (ags_meter_snapshot_get_type())
+#define AGS_METER_SNAPSHOT(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_METER_SNAPSHOT, AgsMeterSnapshot))
+#define AGS_METER_SNAPSHOT_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_METER_SNAPSHOT, AgsMeterSnapshotClass))
+#define AGS_IS_METER_SNAPSHOT(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_METER_SNAPSHOT))
+#define AGS_IS_METER_SNAPSHOT_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_METER_SNAPSHOT))
+#define AGS_METER_SNAPSHOT_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_METER_SNAPSHOT, AgsMeterSnapshotClass))
+
+#define AGS_METER_SNAPSHOT_GET_OBJ_MUTEX(obj) (&(((AgsMeterSnapshot *) obj)->obj_mutex))
+
+#define AGS_METER_SNAPSHOT_DEFAULT_SLOT_COUNT (4096)
+#define AGS_METER_SNAPSHOT_INVALID_SLOT (G_MAXUINT)
+#define AGS_METER_SNAPSHOT_READ_RETRIES (4)
+
+typedef struct _AgsMeterSnapshot AgsMeterSnapshot;
+typedef struct _AgsMeterSnapshotClass AgsMeterSnapshotClass;
+typedef struct _AgsMeterSnapshotEntry AgsMeterSnapshotEntry;
+
+/**
+ * AgsMeterSnapshotEntryType:
+ * @AGS_METER_SNAPSHOT_ENTRY_PORT: the source is an output #AgsPort, its value is read once per period
+ * @AGS_METER_SNAPSHOT_ENTRY_SOUNDCARD: the source is a #AgsSoundcard, its note offset is read once per period
+ * @AGS_METER_SNAPSHOT_ENTRY_PUSHED: the value is pushed by the engine using ags_meter_snapshot_put()
+ *
+ * Enum values to specify how the value of a #AgsMeterSnapshotEntry-struct is obtained.
+ */
+typedef enum{
+  AGS_METER_SNAPSHOT_ENTRY_PORT        = 1,
+  AGS_METER_SNAPSHOT_ENTRY_SOUNDCARD   = 1 <<  1,
+  AGS_METER_SNAPSHOT_ENTRY_PUSHED      = 1 <<  2,
+}AgsMeterSnapshotEntryType;
+
+/**
+ * AgsMeterSnapshotEntry:
+ * @entry_type: the #AgsMeterSnapshotEntryType-enum
+ * @source: the source #GObject
+ * @ref_count: the subscriber count
+ * @sequence: the sequence counter guarding @value, odd while written
+ * @value: the most recent pushed value
+ *
+ * #AgsMeterSnapshotEntry maps a source object and entry type to a slot of
+ * the snapshot.
+ */
+struct _AgsMeterSnapshotEntry
+{
+  guint entry_type;
+
+  volatile gpointer source;
+
+  guint ref_count;
+
+  volatile guint sequence;
+  gdouble value;
+};
+
+struct _AgsMeterSnapshot
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  guint slot_count;
+  volatile guint n_entries;
+
+  AgsMeterSnapshotEntry *entry;
+
+  GHashTable *slot;
+
+  gdouble *buffer[2];
+
+  volatile gint front;
+  volatile guint generation;
+
+  volatile guint subscription_generation;
+};
+
+struct _AgsMeterSnapshotClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_meter_snapshot_get_type(void);
+
+guint ags_meter_snapshot_subscribe(AgsMeterSnapshot *meter_snapshot,
+				   GObject *source,
+				   guint entry_type);
+void ags_meter_snapshot_unsubscribe(AgsMeterSnapshot *meter_snapshot,
+				    guint slot);
+
+gboolean ags_meter_snapshot_try_find_slot(AgsMeterSnapshot *meter_snapshot,
+					  GObject *source,
+					  guint entry_type,
+					  guint *slot);
+
+void ags_meter_snapshot_put(AgsMeterSnapshot *meter_snapshot,
+			    guint slot,
+			    GObject *source,
+			    gdouble value);
+
+void ags_meter_snapshot_publish(AgsMeterSnapshot *meter_snapshot);
+
+gdouble ags_meter_snapshot_read(AgsMeterSnapshot *meter_snapshot,
+				guint slot);
+guint ags_meter_snapshot_get_generation(AgsMeterSnapshot *meter_snapshot);
+guint ags_meter_snapshot_get_subscription_generation(AgsMeterSnapshot *meter_snapshot);
+
+AgsMeterSnapshot* ags_meter_snapshot_get_instance();
+AgsMeterSnapshot* ags_meter_snapshot_new();
+
+G_END_DECLS
+
+#endif /*__AGS_METER_SNAPSHOT_H__*/
@@ -116,6 +116,9 @@ void ags_midiin_alsa_record(AgsSequencer *sequencer,
 			    GError **error);
 void ags_midiin_alsa_free(AgsSequencer *sequencer);
 
+guint ags_midiin_message_length(guchar status);
+guint ags_midiin_get_nth_buffer(AgsMidiin *midiin);
+
 void ags_midiin_tic(AgsSequencer *sequencer);
 void ags_midiin_offset_changed(AgsSequencer *sequencer,
 			       guint note_offset);
@@ -453,14 +456,27 @@ ags_midiin_init(AgsMidiin *midiin)
     midiin->in.oss.device = AGS_MIDIIN_DEFAULT_OSS_DEVICE;
   }
 
-  /* ring buffer */
+  /* ring buffer - preallocated, the poll loop doesn't allocate */
   midiin->ring_buffer = (char **) malloc(2 * sizeof(char *));
 
-  midiin->ring_buffer[0] = NULL;
-  midiin->ring_buffer[1] = NULL;
+  midiin->ring_buffer[0] = (char *) malloc(AGS_MIDIIN_DEFAULT_BUFFER_SIZE * sizeof(char));
+  midiin->ring_buffer[1] = (char *) malloc(AGS_MIDIIN_DEFAULT_BUFFER_SIZE * sizeof(char));
   
   midiin->ring_buffer_size[0] = 0;
   midiin->ring_buffer_size[1] = 0;
+
+  midiin->ring_event = (AgsMidiinEvent **) malloc(2 * sizeof(AgsMidiinEvent *));
+
+  midiin->ring_event[0] = (AgsMidiinEvent *) malloc(AGS_MIDIIN_DEFAULT_EVENT_COUNT * sizeof(AgsMidiinEvent));
+  midiin->ring_event[1] = (AgsMidiinEvent *) malloc(AGS_MIDIIN_DEFAULT_EVENT_COUNT * sizeof(AgsMidiinEvent));
+
+  midiin->ring_event_count[0] = 0;
+  midiin->ring_event_count[1] = 0;
+
+  midiin->parser_status = 0;
+  midiin->parser_remaining = 0;
+
+  midiin->poll_time = 0;
   
   /* buffer */
   midiin->buffer_mutex = (GRecMutex **) malloc(4 * sizeof(GRecMutex *));
@@ -473,15 +489,16 @@ ags_midiin_init(AgsMidiin *midiin)
 
   midiin->buffer = (char **) malloc(4 * sizeof(char *));
 
-  midiin->buffer[0] = NULL;
-  midiin->buffer[1] = NULL;
-  midiin->buffer[2] = NULL;
-  midiin->buffer[3] = NULL;
+  midiin->event = (AgsMidiinEvent **) malloc(4 * sizeof(AgsMidiinEvent *));
 
-  midiin->buffer_size[0] = 0;
-  midiin->buffer_size[1] = 0;
-  midiin->buffer_size[2] = 0;
-  midiin->buffer_size[3] = 0;
+  for(i = 0; i < 4; i++){
+    midiin->buffer[i] = (char *) malloc(AGS_MIDIIN_DEFAULT_BUFFER_SIZE * sizeof(char));
+    midiin->buffer_size[i] = 0;
+
+    midiin->event[i] = (AgsMidiinEvent *) malloc(AGS_MIDIIN_DEFAULT_EVENT_COUNT * sizeof(AgsMidiinEvent));
+    midiin->event_count[i] = 0;
+    midiin->event_duration[i] = 0;
+  }
 
   /* bpm */
   midiin->bpm = AGS_SEQUENCER_DEFAULT_BPM;
@@ -677,6 +694,8 @@ ags_midiin_finalize(GObject *gobject)
 {
   AgsMidiin *midiin;
 
+  guint i;
+  
   midiin = AGS_MIDIIN(gobject);
 
   ags_uuid_free(midiin->uuid);
@@ -700,6 +719,22 @@ ags_midiin_finalize(GObject *gobject)
   
   /* free buffer array */
   free(midiin->buffer);
+
+  /* free event index */
+  for(i = 0; i < 4; i++){
+    free(midiin->event[i]);
+  }
+
+  free(midiin->event);
+
+  /* free ring buffer */
+  for(i = 0; i < 2; i++){
+    free(midiin->ring_buffer[i]);
+    free(midiin->ring_event[i]);
+  }
+
+  free(midiin->ring_buffer);
+  free(midiin->ring_event);
   
   /* call parent */
   G_OBJECT_CLASS(ags_midiin_parent_class)->finalize(gobject);
@@ -1330,7 +1365,7 @@ ags_midiin_oss_init(AgsSequencer *sequencer,
 #ifdef AGS_WITH_OSS
   /* open device fd */
   str = midiin->in.oss.device;
-  midiin->in.oss.device_fd = open(str, O_WRONLY, 0);
+  midiin->in.oss.device_fd = open(str, O_RDONLY | O_NONBLOCK, 0);
 
   if(midiin->in.oss.device_fd == -1){
     midiin->flags &= (~(AGS_MIDIIN_START_RECORD |
@@ -1357,6 +1392,11 @@ ags_midiin_oss_init(AgsSequencer *sequencer,
   midiin->delay_counter = 0.0;
   midiin->tic_counter = 0;
 
+  midiin->parser_status = 0;
+  midiin->parser_remaining = 0;
+
+  midiin->poll_time = g_get_monotonic_time() * 1000;
+
 #ifdef AGS_WITH_OSS
   midiin->flags |= AGS_MIDIIN_INITIALIZED;
 #endif
@@ -1384,13 +1424,10 @@ ags_midiin_oss_record(AgsSequencer *sequencer,
 
   GList *task;
 
-  char **ring_buffer;
-  char buf[128];
+  guchar buf[AGS_MIDIIN_DEFAULT_BUFFER_SIZE];
   
-  gboolean no_event;
   guint nth_buffer;
   guint nth_ring_buffer;
-  guint ring_buffer_size;
   int device_fd;
   int num_read;
   
@@ -1434,18 +1471,12 @@ ags_midiin_oss_record(AgsSequencer *sequencer,
     nth_ring_buffer = 1;
   }
 
-  if(midiin->ring_buffer[nth_ring_buffer] != NULL){
-    free(midiin->ring_buffer[nth_ring_buffer]);
-  }
-      
-  midiin->ring_buffer[nth_ring_buffer] = NULL;
   midiin->ring_buffer_size[nth_ring_buffer] = 0;
-      
-  ring_buffer = midiin->ring_buffer;
-  ring_buffer_size = midiin->ring_buffer_size[nth_ring_buffer];
+  midiin->ring_event_count[nth_ring_buffer] = 0;
   
   g_rec_mutex_unlock(midiin_mutex);
 
+  /* bulk read until drained - device is non-blocking */
   num_read = 1;
   
   while(num_read > 0){
@@ -1454,24 +1485,17 @@ ags_midiin_oss_record(AgsSequencer *sequencer,
 #ifdef AGS_WITH_OSS
     num_read = read(device_fd, buf, sizeof(buf));
     
-    if((num_read < 0)){
+    if(num_read < 0 &&
+       errno != EAGAIN &&
+       errno != EWOULDBLOCK){
       g_warning("Problem reading MIDI input");
     }
 
     if(num_read > 0){
-      if(ceil((ring_buffer_size + num_read) / AGS_MIDIIN_DEFAULT_BUFFER_SIZE) > ceil(ring_buffer_size / AGS_MIDIIN_DEFAULT_BUFFER_SIZE)){
-	if(ring_buffer[nth_ring_buffer] == NULL){
-	  ring_buffer[nth_ring_buffer] = (char *) malloc(AGS_MIDIIN_DEFAULT_BUFFER_SIZE * sizeof(char));
-	}else{
-	  ring_buffer[nth_ring_buffer] = (char *) realloc(ring_buffer[nth_ring_buffer],
-							  (AGS_MIDIIN_DEFAULT_BUFFER_SIZE * ceil(ring_buffer_size / AGS_MIDIIN_DEFAULT_BUFFER_SIZE) + AGS_MIDIIN_DEFAULT_BUFFER_SIZE) * sizeof(char));
-	}
-      }
-
-      memcpy(&(ring_buffer[nth_ring_buffer][ring_buffer_size]),
-	     buf,
-	     num_read);
-      ring_buffer_size += num_read;
+      ags_midiin_ring_append(midiin,
+			     nth_ring_buffer,
+			     buf, num_read,
+			     g_get_monotonic_time() * 1000);
     }
 #endif
   }
@@ -1479,23 +1503,9 @@ ags_midiin_oss_record(AgsSequencer *sequencer,
   /* switch buffer */
   g_rec_mutex_lock(midiin_mutex);
 
-  /* update byte array and buffer size */
-  if(midiin->buffer[nth_buffer] != NULL){
-    free(midiin->buffer[nth_buffer]);
-  }
-
-  midiin->buffer[nth_buffer] = NULL;
-      
-  midiin->ring_buffer_size[nth_ring_buffer] = ring_buffer_size;
-
-  midiin->buffer_size[nth_buffer] = ring_buffer_size;
-
-  /* fill buffer */
-  if(ring_buffer_size > 0){
-    midiin->buffer[nth_buffer] = (char *) malloc(ring_buffer_size * sizeof(char));
-	
-    memcpy(midiin->buffer[nth_buffer], ring_buffer[nth_ring_buffer], ring_buffer_size * sizeof(char));
-  }
+  ags_midiin_ring_commit(midiin,
+			 nth_ring_buffer, nth_buffer,
+			 g_get_monotonic_time() * 1000);
       
   g_rec_mutex_unlock(midiin_mutex);
 
@@ -1520,12 +1530,8 @@ ags_midiin_oss_record(AgsSequencer *sequencer,
     nth_ring_buffer = 1;
   }
 
-  if(midiin->ring_buffer[nth_ring_buffer] != NULL){
-    free(midiin->ring_buffer[nth_ring_buffer]);
-  }
-      
-  midiin->ring_buffer[nth_ring_buffer] = NULL;
   midiin->ring_buffer_size[nth_ring_buffer] = 0;
+  midiin->ring_event_count[nth_ring_buffer] = 0;
       
   g_rec_mutex_unlock(midiin_mutex);
 
@@ -1608,6 +1614,10 @@ ags_midiin_alsa_init(AgsSequencer *sequencer,
 #ifdef AGS_WITH_ALSA
   int mode = SND_RAWMIDI_NONBLOCK;
   snd_rawmidi_t* handle = NULL;
+
+#if SND_LIB_VERSION >= 0x010206
+  snd_rawmidi_params_t *params;
+#endif
 #endif
 
   int err;
@@ -1653,12 +1663,35 @@ ags_midiin_alsa_init(AgsSequencer *sequencer,
   
   /*  */
   midiin->in.alsa.handle = handle;
+
+#if SND_LIB_VERSION >= 0x010206
+  /* request timestamps of received bytes, if supported by the kernel */
+  midiin->flags &= (~AGS_MIDIIN_READ_TSTAMP);
+
+  params = NULL;
+  
+  if(snd_rawmidi_params_malloc(&params) == 0){
+    if(snd_rawmidi_params_current(handle, params) == 0 &&
+       snd_rawmidi_params_set_read_mode(handle, params, SND_RAWMIDI_READ_TSTAMP) == 0 &&
+       snd_rawmidi_params_set_clock_type(handle, params, SND_RAWMIDI_CLOCK_MONOTONIC) == 0 &&
+       snd_rawmidi_params(handle, params) == 0){
+      midiin->flags |= AGS_MIDIIN_READ_TSTAMP;
+    }
+
+    snd_rawmidi_params_free(params);
+  }
+#endif
 #endif
 
   midiin->tact_counter = 0.0;
   midiin->delay_counter = floor(midiin->delay);
   midiin->tic_counter = 0;
 
+  midiin->parser_status = 0;
+  midiin->parser_remaining = 0;
+
+  midiin->poll_time = g_get_monotonic_time() * 1000;
+
 #ifdef AGS_WITH_ALSA
   midiin->flags |= AGS_MIDIIN_INITIALIZED;
 #endif
@@ -1692,14 +1725,17 @@ ags_midiin_alsa_record(AgsSequencer *sequencer,
   gpointer device_handle;
 #endif
 
-  char **ring_buffer;
+#if defined(AGS_WITH_ALSA) && SND_LIB_VERSION >= 0x010206
+  struct timespec tstamp;
+#endif
+
+  guchar buf[AGS_MIDIIN_DEFAULT_BUFFER_SIZE];
   
-  gboolean no_event;
+  gint64 timestamp;
   guint nth_buffer;
   guint nth_ring_buffer;
-  guint ring_buffer_size;
+  gboolean read_tstamp;
   int status;
-  unsigned char c;
   
   GRecMutex *midiin_mutex;
   
@@ -1722,6 +1758,8 @@ ags_midiin_alsa_record(AgsSequencer *sequencer,
   }
 
   device_handle = midiin->in.alsa.handle;
+
+  read_tstamp = ((AGS_MIDIIN_READ_TSTAMP & (midiin->flags)) != 0) ? TRUE: FALSE;
       
   /* nth buffer */
   nth_buffer = 0;
@@ -1741,43 +1779,45 @@ ags_midiin_alsa_record(AgsSequencer *sequencer,
     nth_ring_buffer = 1;
   }
 
-  if(midiin->ring_buffer[nth_ring_buffer] != NULL){
-    free(midiin->ring_buffer[nth_ring_buffer]);
-  }
-      
-  midiin->ring_buffer[nth_ring_buffer] = NULL;
   midiin->ring_buffer_size[nth_ring_buffer] = 0;
-      
-  ring_buffer = midiin->ring_buffer;
-  ring_buffer_size = midiin->ring_buffer_size[nth_ring_buffer];
+  midiin->ring_event_count[nth_ring_buffer] = 0;
 
   g_rec_mutex_unlock(midiin_mutex);
 
-  /* poll MIDI device */
-  status = 0;
+  /* poll MIDI device - bulk read until drained */
+  status = 1;
   
-  while(status >= 0){
+  while(status > 0){
     status = -1;
     
 #ifdef AGS_WITH_ALSA
-    status = snd_rawmidi_read(device_handle, &c, 1);
+    timestamp = g_get_monotonic_time() * 1000;
+
+#if SND_LIB_VERSION >= 0x010206
+    if(read_tstamp){
+      /* all bytes returned share the timestamp of their arrival */
+      status = snd_rawmidi_tread(device_handle, &tstamp, buf, sizeof(buf));
 
+      if(status > 0 &&
+	 (tstamp.tv_sec != 0 || tstamp.tv_nsec != 0)){
+	timestamp = (gint64) tstamp.tv_sec * AGS_NSEC_PER_SEC + (gint64) tstamp.tv_nsec;
+      }
+    }else{
+      status = snd_rawmidi_read(device_handle, buf, sizeof(buf));
+    }
+#else
+    status = snd_rawmidi_read(device_handle, buf, sizeof(buf));
+#endif
+    
     if((status < 0) && (status != -EBUSY) && (status != -EAGAIN)){
       g_warning("Problem reading MIDI input: %s", snd_strerror(status));
     }
 
-    if(status >= 0){
-      if(ring_buffer_size % AGS_MIDIIN_DEFAULT_BUFFER_SIZE == 0){
-	if(ring_buffer[nth_ring_buffer] == NULL){
-	  ring_buffer[nth_ring_buffer] = (char *) malloc(AGS_MIDIIN_DEFAULT_BUFFER_SIZE * sizeof(char));
-	}else{
-	  ring_buffer[nth_ring_buffer] = (char *) realloc(ring_buffer[nth_ring_buffer],
-							  (ring_buffer_size + AGS_MIDIIN_DEFAULT_BUFFER_SIZE) * sizeof(char));
-	}
-      }
-
-      ring_buffer[nth_ring_buffer][ring_buffer_size] = (unsigned char) c;
-      ring_buffer_size += 1;
+    if(status > 0){
+      ags_midiin_ring_append(midiin,
+			     nth_ring_buffer,
+			     buf, status,
+			     timestamp);
     }
 #endif
   }
@@ -1785,23 +1825,9 @@ ags_midiin_alsa_record(AgsSequencer *sequencer,
   /* switch buffer */
   g_rec_mutex_lock(midiin_mutex);
 
-  /* update byte array and buffer size */
-  if(midiin->buffer[nth_buffer] != NULL){
-    free(midiin->buffer[nth_buffer]);
-  }
-      
-  midiin->buffer[nth_buffer] = NULL;
-
-  midiin->ring_buffer_size[nth_ring_buffer] = ring_buffer_size;
-      
-  midiin->buffer_size[nth_buffer] = ring_buffer_size;
-      
-  /* fill buffer */
-  if(ring_buffer_size > 0){
-    midiin->buffer[nth_buffer] = (char *) malloc(ring_buffer_size * sizeof(char));
-	
-    memcpy(midiin->buffer[nth_buffer], ring_buffer[nth_ring_buffer], ring_buffer_size * sizeof(char));
-  }
+  ags_midiin_ring_commit(midiin,
+			 nth_ring_buffer, nth_buffer,
+			 g_get_monotonic_time() * 1000);
       
   g_rec_mutex_unlock(midiin_mutex);
 
@@ -1827,12 +1853,8 @@ ags_midiin_alsa_record(AgsSequencer *sequencer,
     nth_ring_buffer = 1;
   }
 
-  if(midiin->ring_buffer[nth_ring_buffer] != NULL){
-    free(midiin->ring_buffer[nth_ring_buffer]);
-  }
-      
-  midiin->ring_buffer[nth_ring_buffer] = NULL;
   midiin->ring_buffer_size[nth_ring_buffer] = 0;
+  midiin->ring_event_count[nth_ring_buffer] = 0;
 
   g_rec_mutex_unlock(midiin_mutex);
   
@@ -1898,30 +1920,238 @@ ags_midiin_alsa_free(AgsSequencer *sequencer)
   g_atomic_int_or(&(midiin->sync_flags),
 		  AGS_MIDIIN_PASS_THROUGH);
 
-  if(midiin->buffer[1] != NULL){
-    free(midiin->buffer[1]);
-    midiin->buffer_size[1] = 0;
+  midiin->buffer_size[1] = 0;
+  midiin->event_count[1] = 0;
+
+  midiin->buffer_size[2] = 0;
+  midiin->event_count[2] = 0;
+
+  midiin->buffer_size[3] = 0;
+  midiin->event_count[3] = 0;
+
+  midiin->buffer_size[0] = 0;
+  midiin->event_count[0] = 0;
+
+  midiin->note_offset = midiin->start_note_offset;
+  midiin->note_offset_absolute = midiin->start_note_offset;
+  
+  g_rec_mutex_unlock(midiin_mutex);  
+}
+
+guint
+ags_midiin_message_length(guchar status)
+{
+  if(status < 0x80){
+    return(0);
+  }
+  
+  if(status < 0xc0 ||
+     (status >= 0xe0 && status < 0xf0) ||
+     status == 0xf2){
+    return(3);
   }
 
-  if(midiin->buffer[2] != NULL){
-    free(midiin->buffer[2]);
-    midiin->buffer_size[2] = 0;
+  if(status < 0xe0 ||
+     status == 0xf1 ||
+     status == 0xf3){
+    return(2);
   }
 
-  if(midiin->buffer[3] != NULL){
-    free(midiin->buffer[3]);
-    midiin->buffer_size[3] = 0;
+  return(1);
+}
+
+/**
+ * ags_midiin_ring_append:
+ * @midiin: the #AgsMidiin
+ * @nth_ring_buffer: the ring buffer to append to
+ * @data: the received bytes
+ * @length: the count of @data
+ * @timestamp: the time @data was received in nanoseconds
+ *
+ * Append @data to the ring buffer of @midiin and index the MIDI messages it
+ * contains. A real-time byte received within another message is moved in
+ * front of that message, so the message stays contiguous.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_midiin_ring_append(AgsMidiin *midiin,
+		       guint nth_ring_buffer,
+		       guchar *data, guint length,
+		       gint64 timestamp)
+{
+  AgsMidiinEvent *ring_event;
+
+  char *ring_buffer;
+
+  guint ring_buffer_size;
+  guint ring_event_count;
+  guint i;
+  gboolean new_event;
+
+  ring_buffer = midiin->ring_buffer[nth_ring_buffer];
+  ring_buffer_size = midiin->ring_buffer_size[nth_ring_buffer];
+
+  ring_event = midiin->ring_event[nth_ring_buffer];
+  ring_event_count = midiin->ring_event_count[nth_ring_buffer];
+
+  /* fixed capacity - drop what doesn't fit */
+  if(ring_buffer_size + length > AGS_MIDIIN_DEFAULT_BUFFER_SIZE){
+    g_warning("MIDI input overrun, dropped %d bytes", ring_buffer_size + length - AGS_MIDIIN_DEFAULT_BUFFER_SIZE);
+
+    length = AGS_MIDIIN_DEFAULT_BUFFER_SIZE - ring_buffer_size;
   }
+  
+  for(i = 0; i < length; i++){
+    guchar c;
 
-  if(midiin->buffer[0] != NULL){
-    free(midiin->buffer[0]);
-    midiin->buffer_size[0] = 0;
+    c = data[i];
+    
+    new_event = FALSE;
+
+    /* parse message boundaries */
+    if(c >= 0xf8){
+      /* real-time message, doesn't affect running status */
+      if(ring_event_count > 0 &&
+	 (midiin->parser_status == 0xf0 ||
+	  (midiin->parser_status >= 0x80 &&
+	   midiin->parser_remaining > 0))){
+	AgsMidiinEvent *partial_event;
+
+	/* interrupts a message - insert in front of it */
+	if(ring_event_count < AGS_MIDIIN_DEFAULT_EVENT_COUNT){
+	  partial_event = ring_event + (ring_event_count - 1);
+	  
+	  memmove(ring_buffer + partial_event->offset + 1,
+		  ring_buffer + partial_event->offset,
+		  partial_event->length * sizeof(char));
+	  ring_buffer[partial_event->offset] = c;
+
+	  ring_event[ring_event_count].offset = partial_event->offset + 1;
+	  ring_event[ring_event_count].length = partial_event->length;
+	  ring_event[ring_event_count].timestamp = partial_event->timestamp;
+
+	  partial_event->length = 1;
+	  partial_event->timestamp = timestamp;
+
+	  ring_event_count++;
+	  ring_buffer_size++;
+	}
+	
+	continue;
+      }
+      
+      new_event = TRUE;
+    }else if(c >= 0x80){
+      if(c == 0xf7 &&
+	 midiin->parser_status == 0xf0){
+	/* end of system exclusive */
+	midiin->parser_status = 0;
+      }else{
+	new_event = TRUE;
+
+	midiin->parser_status = c;
+	midiin->parser_remaining = ags_midiin_message_length(c) - 1;
+      }
+    }else if(midiin->parser_status == 0xf0){
+      /* system exclusive data */
+    }else if(midiin->parser_remaining > 0){
+      midiin->parser_remaining -= 1;
+    }else if(midiin->parser_status >= 0x80 &&
+	     midiin->parser_status < 0xf0){
+      /* running status */
+      new_event = TRUE;
+      
+      midiin->parser_remaining = ags_midiin_message_length(midiin->parser_status) - 2;
+    }
+
+    /* index - if full the last event grows */
+    if((new_event || ring_event_count == 0) &&
+       ring_event_count < AGS_MIDIIN_DEFAULT_EVENT_COUNT){
+      ring_event[ring_event_count].offset = ring_buffer_size;
+      ring_event[ring_event_count].length = 1;
+      ring_event[ring_event_count].timestamp = timestamp;
+
+      ring_event_count++;
+    }else{
+      ring_event[ring_event_count - 1].length += 1;
+    }
+    
+    ring_buffer[ring_buffer_size] = c;
+    ring_buffer_size++;
   }
 
-  midiin->note_offset = midiin->start_note_offset;
-  midiin->note_offset_absolute = midiin->start_note_offset;
+  midiin->ring_buffer_size[nth_ring_buffer] = ring_buffer_size;
+  midiin->ring_event_count[nth_ring_buffer] = ring_event_count;
+}
+
+/**
+ * ags_midiin_ring_commit:
+ * @midiin: the #AgsMidiin
+ * @nth_ring_buffer: the ring buffer to commit
+ * @nth_buffer: the buffer to fill
+ * @poll_time: the end of the poll period in nanoseconds
+ *
+ * Copy the ring buffer and its index to @nth_buffer of @midiin. The
+ * timestamps are made relative to the poll period.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_midiin_ring_commit(AgsMidiin *midiin,
+		       guint nth_ring_buffer, guint nth_buffer,
+		       gint64 poll_time)
+{
+  AgsMidiinEvent *event, *ring_event;
+
+  gint64 start_time;
+  gint64 duration;
+  guint ring_buffer_size;
+  guint ring_event_count;
+  guint i;
+
+  GRecMutex *buffer_mutex;
   
-  g_rec_mutex_unlock(midiin_mutex);  
+  start_time = midiin->poll_time;
+
+  if(start_time <= 0 ||
+     start_time > poll_time){
+    start_time = poll_time;
+  }
+  
+  duration = poll_time - start_time;
+
+  ring_buffer_size = midiin->ring_buffer_size[nth_ring_buffer];
+  ring_event_count = midiin->ring_event_count[nth_ring_buffer];
+
+  event = midiin->event[nth_buffer];
+  ring_event = midiin->ring_event[nth_ring_buffer];
+  
+  /* fill buffer */
+  buffer_mutex = midiin->buffer_mutex[nth_buffer];
+
+  g_rec_mutex_lock(buffer_mutex);
+  
+  if(ring_buffer_size > 0){
+    memcpy(midiin->buffer[nth_buffer], midiin->ring_buffer[nth_ring_buffer], ring_buffer_size * sizeof(char));
+  }
+
+  midiin->buffer_size[nth_buffer] = ring_buffer_size;
+
+  /* timestamps relative to the poll period */
+  for(i = 0; i < ring_event_count; i++){
+    event[i].offset = ring_event[i].offset;
+    event[i].length = ring_event[i].length;
+
+    event[i].timestamp = CLAMP(ring_event[i].timestamp - start_time, 0, duration);
+  }
+
+  midiin->event_count[nth_buffer] = ring_event_count;
+  midiin->event_duration[nth_buffer] = duration;
+
+  g_rec_mutex_unlock(buffer_mutex);
+
+  midiin->poll_time = poll_time;
 }
 
 void
@@ -2346,48 +2576,185 @@ ags_midiin_switch_buffer_flag(AgsMidiin *midiin)
     midiin->flags |= AGS_MIDIIN_BUFFER1;
 
     /* clear buffer */
-    if(midiin->buffer[3] != NULL){
-      free(midiin->buffer[3]);
-    }
-
-    midiin->buffer[3] = NULL;
     midiin->buffer_size[3] = 0;
+    midiin->event_count[3] = 0;
   }else if((AGS_MIDIIN_BUFFER1 & (midiin->flags)) != 0){
     midiin->flags &= (~AGS_MIDIIN_BUFFER1);
     midiin->flags |= AGS_MIDIIN_BUFFER2;
 
     /* clear buffer */
-    if(midiin->buffer[0] != NULL){
-      free(midiin->buffer[0]);
-    }
-
-    midiin->buffer[0] = NULL;
     midiin->buffer_size[0] = 0;
+    midiin->event_count[0] = 0;
   }else if((AGS_MIDIIN_BUFFER2 & (midiin->flags)) != 0){
     midiin->flags &= (~AGS_MIDIIN_BUFFER2);
     midiin->flags |= AGS_MIDIIN_BUFFER3;
 
     /* clear buffer */
-    if(midiin->buffer[1] != NULL){
-      free(midiin->buffer[1]);
-    }
-
-    midiin->buffer[1] = NULL;
     midiin->buffer_size[1] = 0;
+    midiin->event_count[1] = 0;
   }else if((AGS_MIDIIN_BUFFER3 & (midiin->flags)) != 0){
     midiin->flags &= (~AGS_MIDIIN_BUFFER3);
     midiin->flags |= AGS_MIDIIN_BUFFER0;
 
     /* clear buffer */
-    if(midiin->buffer[2] != NULL){
-      free(midiin->buffer[2]);
-    }
-
-    midiin->buffer[2] = NULL;
     midiin->buffer_size[2] = 0;
+    midiin->event_count[2] = 0;
+  }
+
+  g_rec_mutex_unlock(midiin_mutex);
+}
+
+guint
+ags_midiin_get_nth_buffer(AgsMidiin *midiin)
+{
+  guint nth_buffer;
+  
+  GRecMutex *midiin_mutex;
+
+  midiin_mutex = AGS_MIDIIN_GET_OBJ_MUTEX(midiin);
+
+  /* get nth buffer */
+  g_rec_mutex_lock(midiin_mutex);
+
+  if((AGS_MIDIIN_BUFFER0 & (midiin->flags)) != 0){
+    nth_buffer = 0;
+  }else if((AGS_MIDIIN_BUFFER1 & (midiin->flags)) != 0){
+    nth_buffer = 1;
+  }else if((AGS_MIDIIN_BUFFER2 & (midiin->flags)) != 0){
+    nth_buffer = 2;
+  }else if((AGS_MIDIIN_BUFFER3 & (midiin->flags)) != 0){
+    nth_buffer = 3;
+  }else{
+    nth_buffer = G_MAXUINT;
   }
 
   g_rec_mutex_unlock(midiin_mutex);
+
+  return(nth_buffer);
+}
+
+/**
+ * ags_midiin_get_event:
+ * @midiin: the #AgsMidiin
+ * @n_events: (out): return location of the event count
+ *
+ * Get the index of the MIDI messages within the current buffer as
+ * returned by ags_sequencer_get_buffer(). The memory is owned by
+ * @midiin, lock the buffer while accessing it.
+ *
+ * Returns: (transfer none): the #AgsMidiinEvent-struct array
+ *
+ * Since: 3.5.0
+ */
+AgsMidiinEvent*
+ags_midiin_get_event(AgsMidiin *midiin,
+		     guint *n_events)
+{
+  AgsMidiinEvent *event;
+
+  guint nth_buffer;
+  
+  if(n_events != NULL){
+    n_events[0] = 0;
+  }
+    
+  if(!AGS_IS_MIDIIN(midiin)){
+    return(NULL);
+  }
+
+  nth_buffer = ags_midiin_get_nth_buffer(midiin);
+
+  if(nth_buffer == G_MAXUINT){
+    return(NULL);
+  }
+
+  event = midiin->event[nth_buffer];
+
+  if(n_events != NULL){
+    n_events[0] = midiin->event_count[nth_buffer];
+  }
+
+  return(event);
+}
+
+/**
+ * ags_midiin_get_frame_offset:
+ * @midiin: the #AgsMidiin
+ * @byte_offset: the byte offset within the current buffer
+ * @buffer_size: the audio buffer size
+ *
+ * Get the sub-period position of the MIDI message at @byte_offset. The time
+ * it was received within the poll period is mapped onto @buffer_size frames.
+ *
+ * Returns: the frame offset within the audio buffer
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_midiin_get_frame_offset(AgsMidiin *midiin,
+			    guint byte_offset,
+			    guint buffer_size)
+{
+  AgsMidiinEvent *event;
+
+  gint64 duration;
+  guint n_events;
+  guint nth_buffer;
+  guint lower, upper, middle;
+  guint frame_offset;
+
+  GRecMutex *buffer_mutex;
+  
+  if(!AGS_IS_MIDIIN(midiin) ||
+     buffer_size == 0){
+    return(0);
+  }
+
+  nth_buffer = ags_midiin_get_nth_buffer(midiin);
+
+  if(nth_buffer == G_MAXUINT){
+    return(0);
+  }
+
+  buffer_mutex = midiin->buffer_mutex[nth_buffer];
+
+  g_rec_mutex_lock(buffer_mutex);
+  
+  event = midiin->event[nth_buffer];
+
+  n_events = midiin->event_count[nth_buffer];
+  duration = midiin->event_duration[nth_buffer];
+
+  if(n_events == 0 ||
+     duration <= 0){
+    g_rec_mutex_unlock(buffer_mutex);
+    
+    return(0);
+  }
+
+  /* binary search the last event starting at or before byte offset */
+  lower = 0;
+  upper = n_events - 1;
+
+  while(lower < upper){
+    middle = lower + (upper - lower + 1) / 2;
+
+    if(event[middle].offset <= byte_offset){
+      lower = middle;
+    }else{
+      upper = middle - 1;
+    }
+  }
+
+  frame_offset = (guint) floor((gdouble) event[lower].timestamp / (gdouble) duration * (gdouble) buffer_size);
+
+  g_rec_mutex_unlock(buffer_mutex);
+
+  if(frame_offset >= buffer_size){
+    frame_offset = buffer_size - 1;
+  }
+  
+  return(frame_offset);
 }
 
 /**
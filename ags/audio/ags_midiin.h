@@ -42,9 +42,11 @@ G_BEGIN_DECLS
 #define AGS_MIDIIN_DEFAULT_ALSA_DEVICE "hw:0,0"
 #define AGS_MIDIIN_DEFAULT_OSS_DEVICE "/dev/midi00"
 #define AGS_MIDIIN_DEFAULT_BUFFER_SIZE (4096)
+#define AGS_MIDIIN_DEFAULT_EVENT_COUNT (1024)
 
 typedef struct _AgsMidiin AgsMidiin;
 typedef struct _AgsMidiinClass AgsMidiinClass;
+typedef struct _AgsMidiinEvent AgsMidiinEvent;
 
 /**
  * AgsMidiinFlags:
@@ -62,6 +64,7 @@ typedef struct _AgsMidiinClass AgsMidiinClass;
  * @AGS_MIDIIN_START_RECORD: just started recording
  * @AGS_MIDIIN_NONBLOCKING: do non-blocking calls
  * @AGS_MIDIIN_INITIALIZED: recording is initialized
+ * @AGS_MIDIIN_READ_TSTAMP: the device provides timestamps of received bytes
  *
  * Enum values to control the behavior or indicate internal state of #AgsMidiin by
  * enable/disable as flags.
@@ -88,6 +91,8 @@ typedef enum
 
   AGS_MIDIIN_NONBLOCKING        = 1 << 12,
   AGS_MIDIIN_INITIALIZED        = 1 << 13,
+
+  AGS_MIDIIN_READ_TSTAMP        = 1 << 14,
 }AgsMidiinFlags;
 
 /**
@@ -118,6 +123,22 @@ typedef enum{
   AGS_MIDIIN_ERROR_LOCKED_SEQUENCER,
 }AgsMidiinError;
 
+/**
+ * AgsMidiinEvent:
+ * @offset: the byte offset within the buffer
+ * @length: the byte count
+ * @timestamp: the time in nanoseconds relative to the start of the buffer's poll period
+ *
+ * The index of a MIDI message within the buffer of #AgsMidiin.
+ */
+struct _AgsMidiinEvent
+{
+  guint offset;
+  guint length;
+
+  gint64 timestamp;
+};
+
 struct _AgsMidiin
 {
   GObject gobject;
@@ -131,11 +152,23 @@ struct _AgsMidiin
   
   char **ring_buffer;
   guint ring_buffer_size[2];
+
+  AgsMidiinEvent **ring_event;
+  guint ring_event_count[2];
+
+  guint parser_status;
+  guint parser_remaining;
+
+  gint64 poll_time;
   
   GRecMutex **buffer_mutex;
   char **buffer;
   guint buffer_size[4];
 
+  AgsMidiinEvent **event;
+  guint event_count[4];
+  gint64 event_duration[4];
+
   double bpm; // beats per minute
 
   gdouble delay;
@@ -182,6 +215,20 @@ void ags_midiin_unset_flags(AgsMidiin *midiin, guint flags);
 
 void ags_midiin_switch_buffer_flag(AgsMidiin *midiin);
 
+void ags_midiin_ring_append(AgsMidiin *midiin,
+			    guint nth_ring_buffer,
+			    guchar *data, guint length,
+			    gint64 timestamp);
+void ags_midiin_ring_commit(AgsMidiin *midiin,
+			    guint nth_ring_buffer, guint nth_buffer,
+			    gint64 poll_time);
+
+AgsMidiinEvent* ags_midiin_get_event(AgsMidiin *midiin,
+				     guint *n_events);
+guint ags_midiin_get_frame_offset(AgsMidiin *midiin,
+				  guint byte_offset,
+				  guint buffer_size);
+
 AgsMidiin* ags_midiin_new();
 
 G_END_DECLS
@@ -41,6 +41,10 @@ void ags_notation_get_property(GObject *gobject,
 void ags_notation_dispose(GObject *gobject);
 void ags_notation_finalize(GObject *gobject);
 
+gint ags_notation_snapshot_sort_func(gconstpointer a,
+				     gconstpointer b);
+void ags_notation_free_retired_snapshot(AgsNotation *notation);
+
 void ags_notation_insert_native_piano_from_clipboard_version_0_3_12(AgsNotation *notation,
 								    xmlNode *root_node, char *version,
 								    char *base_frequency,
@@ -219,6 +223,12 @@ ags_notation_init(AgsNotation *notation)
 
   notation->note = NULL;
   notation->selection = NULL;
+
+  notation->snapshot = NULL;
+  notation->retired_snapshot = NULL;
+
+  notation->snapshot_dirty = FALSE;
+  notation->snapshot_readers = 0;
 }
 
 void
@@ -459,6 +469,12 @@ ags_notation_finalize(GObject *gobject)
 
   g_list_free_full(notation->selection,
 		   g_object_unref);
+
+  /* snapshot */
+  ags_notation_snapshot_free(notation->snapshot);
+  
+  g_list_free_full(notation->retired_snapshot,
+		   (GDestroyNotify) ags_notation_snapshot_free);
   
   /* call parent */
   G_OBJECT_CLASS(ags_notation_parent_class)->finalize(gobject);
@@ -1153,6 +1169,9 @@ ags_notation_set_note(AgsNotation *notation, GList *note)
 
   start_note = notation->note;
   notation->note = note;
+
+  g_atomic_int_set(&(notation->snapshot_dirty),
+		   TRUE);
   
   g_rec_mutex_unlock(notation_mutex);
 
@@ -1274,6 +1293,9 @@ ags_notation_add_note(AgsNotation *notation,
     notation->note = g_list_insert_sorted(notation->note,
 					  note,
 					  (GCompareFunc) ags_note_sort_func);
+
+    g_atomic_int_set(&(notation->snapshot_dirty),
+		     TRUE);
   }
 
   g_rec_mutex_unlock(notation_mutex);
@@ -1313,6 +1335,9 @@ ags_notation_remove_note(AgsNotation *notation,
       notation->note = g_list_remove(notation->note,
 				     note);
       g_object_unref(note);
+
+      g_atomic_int_set(&(notation->snapshot_dirty),
+		       TRUE);
     }
   }else{
     if(g_list_find(notation->selection,
@@ -1402,6 +1427,9 @@ ags_notation_remove_note_at_position(AgsNotation *notation,
 				   note);
     g_object_unref(note);
 
+    g_atomic_int_set(&(notation->snapshot_dirty),
+		     TRUE);
+
     g_rec_mutex_unlock(notation_mutex);
   }
 
@@ -1866,6 +1894,318 @@ ags_notation_find_offset(AgsNotation *notation,
   return(retval);
 }
 
+/**
+ * ags_notation_snapshot_alloc:
+ * @n_notes: the count of notes
+ *
+ * Allocate #AgsNotationSnapshot with room for @n_notes.
+ *
+ * Returns: (type gpointer) (transfer full): the newly allocated #AgsNotationSnapshot
+ *
+ * Since: 3.5.0
+ */
+AgsNotationSnapshot*
+ags_notation_snapshot_alloc(guint n_notes)
+{
+  AgsNotationSnapshot *snapshot;
+
+  snapshot = (AgsNotationSnapshot *) g_malloc(sizeof(AgsNotationSnapshot));
+
+  snapshot->n_notes = n_notes;
+  snapshot->max_length = 0;
+
+  snapshot->x0 = NULL;
+  snapshot->x1 = NULL;
+  snapshot->y = NULL;
+  snapshot->flags = NULL;
+
+  snapshot->note = NULL;
+
+  if(n_notes > 0){
+    snapshot->x0 = (guint *) g_malloc(n_notes * sizeof(guint));
+    snapshot->x1 = (guint *) g_malloc(n_notes * sizeof(guint));
+    snapshot->y = (guint *) g_malloc(n_notes * sizeof(guint));
+    snapshot->flags = (guint *) g_malloc(n_notes * sizeof(guint));
+
+    snapshot->note = (AgsNote **) g_malloc0(n_notes * sizeof(AgsNote *));
+  }
+  
+  return(snapshot);
+}
+
+/**
+ * ags_notation_snapshot_free:
+ * @snapshot: (type gpointer) (transfer full): the #AgsNotationSnapshot
+ *
+ * Free @snapshot and unref its notes.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_notation_snapshot_free(AgsNotationSnapshot *snapshot)
+{
+  guint i;
+  
+  if(snapshot == NULL){
+    return;
+  }
+
+  for(i = 0; i < snapshot->n_notes; i++){
+    if(snapshot->note[i] != NULL){
+      g_object_unref(snapshot->note[i]);
+    }
+  }
+  
+  g_free(snapshot->x0);
+  g_free(snapshot->x1);
+  g_free(snapshot->y);
+  g_free(snapshot->flags);
+
+  g_free(snapshot->note);
+
+  g_free(snapshot);
+}
+
+/**
+ * ags_notation_snapshot_find_offset:
+ * @snapshot: (type gpointer): the #AgsNotationSnapshot
+ * @x: the offset
+ *
+ * Find the index of the first note with x0 not less than @x. The notes
+ * starting at @x are at this index and the following while x0 matches.
+ *
+ * Returns: the index, @snapshot's n_notes if no such note
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_notation_snapshot_find_offset(AgsNotationSnapshot *snapshot,
+				  guint x)
+{
+  guint lower, upper;
+  guint middle;
+
+  if(snapshot == NULL){
+    return(0);
+  }
+
+  /* lower bound */
+  lower = 0;
+  upper = snapshot->n_notes;
+
+  while(lower < upper){
+    middle = lower + (upper - lower) / 2;
+
+    if(snapshot->x0[middle] < x){
+      lower = middle + 1;
+    }else{
+      upper = middle;
+    }
+  }
+
+  return(lower);
+}
+
+gint
+ags_notation_snapshot_sort_func(gconstpointer a,
+				gconstpointer b)
+{
+  const guint *a_entry, *b_entry;
+
+  /* x0 then y */
+  a_entry = a;
+  b_entry = b;
+
+  if(a_entry[0] != b_entry[0]){
+    return((a_entry[0] < b_entry[0]) ? -1: 1);
+  }
+
+  if(a_entry[2] != b_entry[2]){
+    return((a_entry[2] < b_entry[2]) ? -1: 1);
+  }
+
+  /* keep list order */
+  if(a_entry[4] != b_entry[4]){
+    return((a_entry[4] < b_entry[4]) ? -1: 1);
+  }
+  
+  return(0);
+}
+
+void
+ags_notation_free_retired_snapshot(AgsNotation *notation)
+{
+  GList *start_retired_snapshot;
+
+  /* called with notation mutex held, no reader may see a retired snapshot */
+  if(g_atomic_int_get(&(notation->snapshot_readers)) != 0){
+    return;
+  }
+
+  start_retired_snapshot = notation->retired_snapshot;
+  notation->retired_snapshot = NULL;
+
+  g_list_free_full(start_retired_snapshot,
+		   (GDestroyNotify) ags_notation_snapshot_free);
+}
+
+/**
+ * ags_notation_update_snapshot:
+ * @notation: the #AgsNotation
+ *
+ * Rebuild the #AgsNotationSnapshot of @notation from its notes and publish
+ * it by swapping the snapshot pointer. The previous snapshot is retired and
+ * freed by this or a later update as soon as no reader holds it.
+ *
+ * Don't call from the audio thread, launch #AgsUpdateNotationSnapshot instead.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_notation_update_snapshot(AgsNotation *notation)
+{
+  AgsNotationSnapshot *snapshot, *old_snapshot;
+
+  AgsNote **list_note;
+  
+  GList *note;
+
+  guint *entry;
+  
+  guint n_notes;
+  guint i;
+  
+  GRecMutex *notation_mutex;
+  GRecMutex *note_mutex;
+
+  if(!AGS_IS_NOTATION(notation)){
+    return;
+  }
+
+  /* get notation mutex */
+  notation_mutex = AGS_NOTATION_GET_OBJ_MUTEX(notation);
+
+  g_rec_mutex_lock(notation_mutex);
+
+  g_atomic_int_set(&(notation->snapshot_dirty),
+		   FALSE);
+
+  n_notes = g_list_length(notation->note);
+
+  snapshot = ags_notation_snapshot_alloc(n_notes);
+
+  /* x0, x1, y, flags and list position of each note */
+  entry = (guint *) g_malloc(5 * n_notes * sizeof(guint));
+  list_note = (AgsNote **) g_malloc(n_notes * sizeof(AgsNote *));
+  
+  note = notation->note;
+
+  for(i = 0; i < n_notes; i++){
+    note_mutex = AGS_NOTE_GET_OBJ_MUTEX(note->data);
+
+    g_rec_mutex_lock(note_mutex);
+
+    entry[5 * i] = AGS_NOTE(note->data)->x[0];
+    entry[5 * i + 1] = AGS_NOTE(note->data)->x[1];
+    entry[5 * i + 2] = AGS_NOTE(note->data)->y;
+    entry[5 * i + 3] = AGS_NOTE(note->data)->flags;
+    entry[5 * i + 4] = i;
+
+    g_rec_mutex_unlock(note_mutex);
+
+    list_note[i] = note->data;
+    
+    note = note->next;
+  }
+
+  /* notes might have been moved in place */
+  qsort(entry,
+	n_notes, 5 * sizeof(guint),
+	ags_notation_snapshot_sort_func);
+
+  for(i = 0; i < n_notes; i++){
+    snapshot->x0[i] = entry[5 * i];
+    snapshot->x1[i] = entry[5 * i + 1];
+    snapshot->y[i] = entry[5 * i + 2];
+    snapshot->flags[i] = entry[5 * i + 3];
+
+    if(snapshot->x1[i] > snapshot->x0[i] &&
+       snapshot->x1[i] - snapshot->x0[i] > snapshot->max_length){
+      snapshot->max_length = snapshot->x1[i] - snapshot->x0[i];
+    }
+  }
+
+  /* the notes by list position */
+  for(i = 0; i < n_notes; i++){
+    snapshot->note[i] = g_object_ref(list_note[entry[5 * i + 4]]);
+  }
+  
+  g_free(entry);
+  g_free(list_note);
+
+  /* publish */
+  old_snapshot = g_atomic_pointer_get(&(notation->snapshot));
+  
+  g_atomic_pointer_set(&(notation->snapshot),
+		       snapshot);
+
+  if(old_snapshot != NULL){
+    notation->retired_snapshot = g_list_prepend(notation->retired_snapshot,
+						old_snapshot);
+  }
+
+  ags_notation_free_retired_snapshot(notation);
+  
+  g_rec_mutex_unlock(notation_mutex);
+}
+
+/**
+ * ags_notation_acquire_snapshot:
+ * @notation: the #AgsNotation
+ *
+ * Acquire the current #AgsNotationSnapshot of @notation. The snapshot stays
+ * valid until ags_notation_release_snapshot(), which must be called even
+ * if %NULL is returned.
+ *
+ * The audio thread only loads the snapshot pointer, the snapshot is rebuilt
+ * by ags_notation_update_snapshot() from the editor or a task.
+ *
+ * Returns: (type gpointer) (transfer none): the #AgsNotationSnapshot or %NULL
+ *
+ * Since: 3.5.0
+ */
+AgsNotationSnapshot*
+ags_notation_acquire_snapshot(AgsNotation *notation)
+{
+  if(!AGS_IS_NOTATION(notation)){
+    return(NULL);
+  }
+
+  g_atomic_int_inc(&(notation->snapshot_readers));
+
+  return(g_atomic_pointer_get(&(notation->snapshot)));
+}
+
+/**
+ * ags_notation_release_snapshot:
+ * @notation: the #AgsNotation
+ *
+ * Release the #AgsNotationSnapshot acquired by ags_notation_acquire_snapshot().
+ * Retired snapshots are freed by the next ags_notation_update_snapshot().
+ *
+ * Since: 3.5.0
+ */
+void
+ags_notation_release_snapshot(AgsNotation *notation)
+{
+  if(!AGS_IS_NOTATION(notation)){
+    return;
+  }
+
+  g_atomic_int_add(&(notation->snapshot_readers),
+		   -1);
+}
+
 /**
  * ags_notation_free_selection:
  * @notation: the #AgsNotation
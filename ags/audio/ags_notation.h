@@ -40,6 +40,8 @@ G_BEGIN_DECLS
 
 #define AGS_NOTATION_GET_OBJ_MUTEX(obj) (&(((AgsNotation *) obj)->obj_mutex))
 
+#define AGS_NOTATION_SNAPSHOT(ptr) ((AgsNotationSnapshot *)(ptr))
+
 #define AGS_NOTATION_DEFAULT_BPM (120.0)
 
 #define AGS_NOTATION_TICS_PER_BEAT (1.0)
@@ -59,6 +61,7 @@ G_BEGIN_DECLS
 
 typedef struct _AgsNotation AgsNotation;
 typedef struct _AgsNotationClass AgsNotationClass;
+typedef struct _AgsNotationSnapshot AgsNotationSnapshot;
 
 /**
  * AgsNotationFlags:
@@ -93,6 +96,12 @@ struct _AgsNotation
 
   GList *note;
   GList *selection;
+
+  AgsNotationSnapshot *snapshot;
+  GList *retired_snapshot;
+
+  gint snapshot_dirty;
+  gint snapshot_readers;
 };
 
 struct _AgsNotationClass
@@ -100,6 +109,32 @@ struct _AgsNotationClass
   GObjectClass gobject;
 };
 
+/**
+ * AgsNotationSnapshot:
+ * @n_notes: the count of notes
+ * @max_length: the maximum note length, x1 minus x0
+ * @x0: the note on offsets, sorted ascending
+ * @x1: the note off offsets
+ * @y: the keys
+ * @flags: the #AgsNoteFlags
+ * @note: the #AgsNote the values were taken from
+ *
+ * #AgsNotationSnapshot is an immutable structure of arrays copy of the
+ * notes of #AgsNotation, for lock-free scanning by the audio thread.
+ */
+struct _AgsNotationSnapshot
+{
+  guint n_notes;
+  guint max_length;
+
+  guint *x0;
+  guint *x1;
+  guint *y;
+  guint *flags;
+
+  AgsNote **note;
+};
+
 GType ags_notation_get_type();
 
 GRecMutex* ags_notation_get_obj_mutex(AgsNotation *notation);
@@ -165,6 +200,17 @@ GList* ags_notation_find_offset(AgsNotation *notation,
 				guint x,
 				gboolean use_selection_list);
 
+AgsNotationSnapshot* ags_notation_snapshot_alloc(guint n_notes);
+void ags_notation_snapshot_free(AgsNotationSnapshot *snapshot);
+
+guint ags_notation_snapshot_find_offset(AgsNotationSnapshot *snapshot,
+					guint x);
+
+void ags_notation_update_snapshot(AgsNotation *notation);
+
+AgsNotationSnapshot* ags_notation_acquire_snapshot(AgsNotation *notation);
+void ags_notation_release_snapshot(AgsNotation *notation);
+
 void ags_notation_free_selection(AgsNotation *notation);
 
 void ags_notation_add_point_to_selection(AgsNotation *notation,
@@ -0,0 +1,1368 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/ags_pitch_util.h>
+
+#include <ags/audio/ags_audio_buffer_util.h>
+#include <ags/audio/ags_fft_plan_cache.h>
+
+#include <ags/audio/file/ags_sound_resource.h>
+
+#include <math.h>
+#include <string.h>
+
+/**
+ * SECTION:ags_pitch_util
+ * @short_description: pitch util
+ * @title: AgsPitchUtil
+ * @section_id:
+ * @include: ags/audio/ags_pitch_util.h
+ *
+ * #AgsPitchUtil shifts the pitch of audio data. It keeps its scratch memory
+ * across calls, so transposing many notes or streaming period by period
+ * doesn't allocate.
+ *
+ * The resample mode interpolates the source with a cubic kernel and is
+ * meant for sampler transposition, the phase vocoder mode preserves the
+ * duration and processes in-place with a latency of frame size minus hop size.
+ *
+ * A sound resource can be resampled through a bounded source window. The
+ * window is kept as cursor, so rendering a voice period by period only reads
+ * the sample frames it advances over.
+ */
+
+void* ags_pitch_util_buffer_offset(void *buffer,
+				   guint offset,
+				   guint audio_buffer_util_format);
+
+void ags_pitch_util_interpolate(gdouble *destination,
+				gdouble *source, guint source_length,
+				gdouble position, gdouble ratio,
+				guint count);
+void ags_pitch_util_phase_vocoder_run(AgsPitchUtil *pitch_util,
+				      gdouble *buffer,
+				      guint count);
+
+static GPrivate ags_pitch_util_default_key = G_PRIVATE_INIT((GDestroyNotify) ags_pitch_util_free);
+static GPrivate ags_pitch_util_default_phase_vocoder_key = G_PRIVATE_INIT((GDestroyNotify) ags_pitch_util_free);
+
+/**
+ * ags_pitch_util_alloc:
+ * @mode: the #AgsPitchUtilMode-enum
+ * @samplerate: the samplerate
+ *
+ * Allocate #AgsPitchUtil-struct. The phase vocoder buffers are only created
+ * for %AGS_PITCH_UTIL_PHASE_VOCODER, its FFT plans are shared by the
+ * #AgsFFTPlanCache. The source is preallocated
+ * with %AGS_PITCH_UTIL_DEFAULT_WINDOW_SIZE frames.
+ *
+ * Returns: the newly allocated #AgsPitchUtil-struct
+ *
+ * Since: 3.5.0
+ */
+AgsPitchUtil*
+ags_pitch_util_alloc(guint mode,
+		     guint samplerate)
+{
+  AgsPitchUtil *ptr;
+
+  ptr = (AgsPitchUtil *) g_malloc(sizeof(AgsPitchUtil));
+
+  ptr->mode = mode;
+
+  ptr->source_samplerate = samplerate;
+  ptr->samplerate = samplerate;
+
+  ptr->base_key = 0.0;
+  ptr->tuning = 0.0;
+
+  ptr->shift = 1.0;
+  ptr->ratio = 1.0;
+
+  ptr->scratch_size = AGS_PITCH_UTIL_DEFAULT_SCRATCH_SIZE;
+  ptr->scratch = (gdouble *) g_malloc0(ptr->scratch_size * sizeof(gdouble));
+
+  ptr->source_length = 0;
+  ptr->source_allocated = AGS_PITCH_UTIL_DEFAULT_WINDOW_SIZE;
+  ptr->source = (gdouble *) g_malloc0(ptr->source_allocated * sizeof(gdouble));
+
+  ptr->source_id = NULL;
+  ptr->source_offset = 0;
+
+  ptr->position = 0.0;
+
+  ptr->frame_size = AGS_PITCH_UTIL_DEFAULT_FRAME_SIZE;
+  ptr->oversampling = AGS_PITCH_UTIL_DEFAULT_OVERSAMPLING;
+  ptr->fifo_offset = ptr->frame_size - (ptr->frame_size / ptr->oversampling);
+
+  ptr->window = NULL;
+
+  ptr->in_fifo = NULL;
+  ptr->out_fifo = NULL;
+  ptr->output_accum = NULL;
+
+  ptr->last_phase = NULL;
+  ptr->sum_phase = NULL;
+
+  ptr->analysis_magnitude = NULL;
+  ptr->analysis_phase = NULL;
+  ptr->analysis_frequency = NULL;
+  ptr->synthesis_magnitude = NULL;
+  ptr->synthesis_phase = NULL;
+
+  ptr->peak = NULL;
+
+  ptr->fft_in = NULL;
+  ptr->fft_out = NULL;
+
+  ptr->forward_plan = NULL;
+  ptr->backward_plan = NULL;
+
+  if((AGS_PITCH_UTIL_PHASE_VOCODER & mode) != 0){
+    guint half;
+    guint i;
+
+    half = ptr->frame_size / 2 + 1;
+
+    ptr->window = (gdouble *) g_malloc(ptr->frame_size * sizeof(gdouble));
+
+    for(i = 0; i < ptr->frame_size; i++){
+      ptr->window[i] = 0.5 - 0.5 * cos(2.0 * M_PI * (gdouble) i / (gdouble) ptr->frame_size);
+    }
+
+    ptr->in_fifo = (gdouble *) g_malloc0(ptr->frame_size * sizeof(gdouble));
+    ptr->out_fifo = (gdouble *) g_malloc0(ptr->frame_size * sizeof(gdouble));
+    ptr->output_accum = (gdouble *) g_malloc0(2 * ptr->frame_size * sizeof(gdouble));
+
+    ptr->last_phase = (gdouble *) g_malloc0(half * sizeof(gdouble));
+    ptr->sum_phase = (gdouble *) g_malloc0(half * sizeof(gdouble));
+
+    ptr->analysis_magnitude = (gdouble *) g_malloc0(half * sizeof(gdouble));
+    ptr->analysis_phase = (gdouble *) g_malloc0(half * sizeof(gdouble));
+    ptr->analysis_frequency = (gdouble *) g_malloc0(half * sizeof(gdouble));
+    ptr->synthesis_magnitude = (gdouble *) g_malloc0(half * sizeof(gdouble));
+    ptr->synthesis_phase = (gdouble *) g_malloc0(half * sizeof(gdouble));
+
+    ptr->peak = (guint *) g_malloc0(half * sizeof(guint));
+
+    ptr->fft_in = (double *) fftw_malloc(ptr->frame_size * sizeof(double));
+    ptr->fft_out = (fftw_complex *) fftw_malloc(half * sizeof(fftw_complex));
+
+    ptr->forward_plan = ags_fft_plan_cache_find_dft_r2c(ags_fft_plan_cache_get_instance(),
+							ptr->frame_size,
+							fftw_alignment_of(ptr->fft_in));
+    ptr->backward_plan = ags_fft_plan_cache_find_dft_c2r(ags_fft_plan_cache_get_instance(),
+							 ptr->frame_size,
+							 fftw_alignment_of(ptr->fft_in));
+  }
+
+  return(ptr);
+}
+
+/**
+ * ags_pitch_util_free:
+ * @pitch_util: the #AgsPitchUtil-struct
+ *
+ * Free @pitch_util.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_pitch_util_free(AgsPitchUtil *pitch_util)
+{
+  if(pitch_util == NULL){
+    return;
+  }
+
+  g_free(pitch_util->scratch);
+  g_free(pitch_util->source);
+
+  if(pitch_util->fft_in != NULL){
+    fftw_free(pitch_util->fft_in);
+  }
+
+  if(pitch_util->fft_out != NULL){
+    fftw_free(pitch_util->fft_out);
+  }
+
+  g_free(pitch_util->window);
+
+  g_free(pitch_util->in_fifo);
+  g_free(pitch_util->out_fifo);
+  g_free(pitch_util->output_accum);
+
+  g_free(pitch_util->last_phase);
+  g_free(pitch_util->sum_phase);
+
+  g_free(pitch_util->analysis_magnitude);
+  g_free(pitch_util->analysis_phase);
+  g_free(pitch_util->analysis_frequency);
+  g_free(pitch_util->synthesis_magnitude);
+  g_free(pitch_util->synthesis_phase);
+
+  g_free(pitch_util->peak);
+
+  g_free(pitch_util);
+}
+
+/**
+ * ags_pitch_util_get_default:
+ *
+ * Get the resampling #AgsPitchUtil-struct of the calling thread. It is
+ * created on first use and freed as the thread exits.
+ *
+ * Returns: (transfer none): the #AgsPitchUtil-struct
+ *
+ * Since: 3.5.0
+ */
+AgsPitchUtil*
+ags_pitch_util_get_default()
+{
+  AgsPitchUtil *pitch_util;
+
+  pitch_util = (AgsPitchUtil *) g_private_get(&ags_pitch_util_default_key);
+
+  if(pitch_util == NULL){
+    pitch_util = ags_pitch_util_alloc(AGS_PITCH_UTIL_RESAMPLE,
+				      AGS_SOUNDCARD_DEFAULT_SAMPLERATE);
+
+    g_private_set(&ags_pitch_util_default_key,
+		  pitch_util);
+  }
+
+  return(pitch_util);
+}
+
+/**
+ * ags_pitch_util_get_default_phase_vocoder:
+ *
+ * Get the phase vocoder #AgsPitchUtil-struct of the calling thread. It is
+ * created on first use and freed as the thread exits.
+ *
+ * Returns: (transfer none): the #AgsPitchUtil-struct
+ *
+ * Since: 3.5.0
+ */
+AgsPitchUtil*
+ags_pitch_util_get_default_phase_vocoder()
+{
+  AgsPitchUtil *pitch_util;
+
+  pitch_util = (AgsPitchUtil *) g_private_get(&ags_pitch_util_default_phase_vocoder_key);
+
+  if(pitch_util == NULL){
+    pitch_util = ags_pitch_util_alloc(AGS_PITCH_UTIL_PHASE_VOCODER,
+				      AGS_SOUNDCARD_DEFAULT_SAMPLERATE);
+
+    g_private_set(&ags_pitch_util_default_phase_vocoder_key,
+		  pitch_util);
+  }
+
+  return(pitch_util);
+}
+
+/**
+ * ags_pitch_util_set_samplerate:
+ * @pitch_util: the #AgsPitchUtil-struct
+ * @source_samplerate: the source samplerate
+ * @samplerate: the samplerate
+ *
+ * Set samplerates of @pitch_util. The resample mode converts from
+ * @source_samplerate to @samplerate in the same pass as transposing.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_pitch_util_set_samplerate(AgsPitchUtil *pitch_util,
+			      guint source_samplerate,
+			      guint samplerate)
+{
+  if(pitch_util == NULL ||
+     source_samplerate == 0 ||
+     samplerate == 0){
+    return;
+  }
+
+  pitch_util->source_samplerate = source_samplerate;
+  pitch_util->samplerate = samplerate;
+
+  pitch_util->ratio = pitch_util->shift * ((gdouble) source_samplerate / (gdouble) samplerate);
+}
+
+/**
+ * ags_pitch_util_set_pitch:
+ * @pitch_util: the #AgsPitchUtil-struct
+ * @base_key: the base key
+ * @tuning: the tuning in cents
+ *
+ * Set pitch of @pitch_util, @tuning is relative to @base_key.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_pitch_util_set_pitch(AgsPitchUtil *pitch_util,
+			 gdouble base_key,
+			 gdouble tuning)
+{
+  if(pitch_util == NULL){
+    return;
+  }
+
+  pitch_util->base_key = base_key;
+  pitch_util->tuning = tuning;
+
+  pitch_util->shift = exp2(tuning / 1200.0);
+  pitch_util->ratio = pitch_util->shift * ((gdouble) pitch_util->source_samplerate / (gdouble) pitch_util->samplerate);
+}
+
+/**
+ * ags_pitch_util_reset:
+ * @pitch_util: the #AgsPitchUtil-struct
+ *
+ * Reset streaming state of @pitch_util, the resample position is rewound
+ * and the phase vocoder fifos are cleared.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_pitch_util_reset(AgsPitchUtil *pitch_util)
+{
+  guint half;
+
+  if(pitch_util == NULL){
+    return;
+  }
+
+  pitch_util->position = 0.0;
+
+  pitch_util->fifo_offset = pitch_util->frame_size - (pitch_util->frame_size / pitch_util->oversampling);
+
+  if(pitch_util->fft_in == NULL){
+    return;
+  }
+
+  half = pitch_util->frame_size / 2 + 1;
+
+  memset(pitch_util->in_fifo, 0, pitch_util->frame_size * sizeof(gdouble));
+  memset(pitch_util->out_fifo, 0, pitch_util->frame_size * sizeof(gdouble));
+  memset(pitch_util->output_accum, 0, 2 * pitch_util->frame_size * sizeof(gdouble));
+
+  memset(pitch_util->last_phase, 0, half * sizeof(gdouble));
+  memset(pitch_util->sum_phase, 0, half * sizeof(gdouble));
+}
+
+/**
+ * ags_pitch_util_reserve_source:
+ * @pitch_util: the #AgsPitchUtil-struct
+ * @source_length: the source length
+ *
+ * Reserve @source_length frames of source and rewind the resample position.
+ * The memory is only reallocated if it grows.
+ *
+ * Returns: (transfer none): the cleared source buffer to fill
+ *
+ * Since: 3.5.0
+ */
+gdouble*
+ags_pitch_util_reserve_source(AgsPitchUtil *pitch_util,
+			      guint source_length)
+{
+  if(pitch_util == NULL){
+    return(NULL);
+  }
+
+  if(source_length > pitch_util->source_allocated){
+    g_free(pitch_util->source);
+
+    pitch_util->source = (gdouble *) g_malloc(source_length * sizeof(gdouble));
+    pitch_util->source_allocated = source_length;
+  }
+
+  if(source_length > 0){
+    ags_audio_buffer_util_clear_double(pitch_util->source, 1,
+				       source_length);
+  }
+
+  pitch_util->source_length = source_length;
+
+  pitch_util->source_id = NULL;
+  pitch_util->source_offset = 0;
+
+  pitch_util->position = 0.0;
+
+  return(pitch_util->source);
+}
+
+/**
+ * ags_pitch_util_append_source:
+ * @pitch_util: the #AgsPitchUtil-struct
+ * @buffer: the audio buffer
+ * @buffer_length: the buffer length
+ * @audio_buffer_util_format: the audio buffer util format of @buffer
+ *
+ * Append @buffer to the source of @pitch_util. Use it to feed a source that
+ * is split across several buffers, like the stream of #AgsAudioSignal.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_pitch_util_append_source(AgsPitchUtil *pitch_util,
+			     void *buffer, guint buffer_length,
+			     guint audio_buffer_util_format)
+{
+  guint source_length;
+  guint copy_mode;
+
+  if(pitch_util == NULL ||
+     buffer == NULL ||
+     buffer_length == 0){
+    return;
+  }
+
+  source_length = pitch_util->source_length + buffer_length;
+
+  if(source_length > pitch_util->source_allocated){
+    pitch_util->source_allocated = MAX(source_length, 2 * pitch_util->source_allocated);
+
+    pitch_util->source = (gdouble *) g_realloc(pitch_util->source,
+					       pitch_util->source_allocated * sizeof(gdouble));
+  }
+
+  ags_audio_buffer_util_clear_double(pitch_util->source + pitch_util->source_length, 1,
+				     buffer_length);
+
+  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_DOUBLE,
+						  audio_buffer_util_format);
+
+  ags_audio_buffer_util_copy_buffer_to_buffer(pitch_util->source, 1, pitch_util->source_length,
+					      buffer, 1, 0,
+					      buffer_length, copy_mode);
+
+  pitch_util->source_length = source_length;
+
+  pitch_util->source_id = NULL;
+  pitch_util->source_offset = 0;
+}
+
+/**
+ * ags_pitch_util_get_frame_count:
+ * @pitch_util: the #AgsPitchUtil-struct
+ *
+ * Get the count of frames the whole source of @pitch_util resamples to.
+ *
+ * Returns: the frame count
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_pitch_util_get_frame_count(AgsPitchUtil *pitch_util)
+{
+  if(pitch_util == NULL ||
+     pitch_util->ratio <= 0.0){
+    return(0);
+  }
+
+  return((guint) ceil((gdouble) pitch_util->source_length / pitch_util->ratio));
+}
+
+/**
+ * ags_pitch_util_reserve_window:
+ * @pitch_util: the #AgsPitchUtil-struct
+ * @source_id: the sound resource to read from
+ * @source_offset: the first frame of the sound resource
+ * @source_length: (inout): the requested frame count, returns the reserved frame count
+ *
+ * Reserve the source of @pitch_util as window of @source_id starting at
+ * @source_offset. The source is never reallocated, so @source_length is
+ * limited to the allocated source length.
+ *
+ * Returns: (transfer none): the cleared source buffer to fill
+ *
+ * Since: 3.5.0
+ */
+gdouble*
+ags_pitch_util_reserve_window(AgsPitchUtil *pitch_util,
+			      gpointer source_id,
+			      guint64 source_offset,
+			      guint *source_length)
+{
+  guint length;
+  
+  if(pitch_util == NULL ||
+     source_length == NULL){
+    return(NULL);
+  }
+
+  length = source_length[0];
+  
+  if(length > pitch_util->source_allocated){
+    length = pitch_util->source_allocated;
+  }
+
+  if(length > 0){
+    ags_audio_buffer_util_clear_double(pitch_util->source, 1,
+				       length);
+  }
+
+  pitch_util->source_length = length;
+
+  pitch_util->source_id = source_id;
+  pitch_util->source_offset = source_offset;
+
+  source_length[0] = length;
+  
+  return(pitch_util->source);
+}
+
+/**
+ * ags_pitch_util_has_window:
+ * @pitch_util: the #AgsPitchUtil-struct
+ * @source_id: the sound resource
+ * @source_offset: the first frame of the sound resource
+ * @source_length: the frame count
+ *
+ * Check if the source window of @pitch_util holds @source_length frames of
+ * @source_id starting at @source_offset.
+ *
+ * Returns: %TRUE if the frames are within the window, otherwise %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_pitch_util_has_window(AgsPitchUtil *pitch_util,
+			  gpointer source_id,
+			  guint64 source_offset,
+			  guint source_length)
+{
+  if(pitch_util == NULL ||
+     source_id == NULL ||
+     pitch_util->source_id != source_id){
+    return(FALSE);
+  }
+
+  if(source_offset < pitch_util->source_offset ||
+     source_offset + source_length > pitch_util->source_offset + pitch_util->source_length){
+    return(FALSE);
+  }
+
+  return(TRUE);
+}
+
+void*
+ags_pitch_util_buffer_offset(void *buffer,
+			     guint offset,
+			     guint audio_buffer_util_format)
+{
+  switch(audio_buffer_util_format){
+  case AGS_AUDIO_BUFFER_UTIL_S8:
+  {
+    return(((gint8 *) buffer) + offset);
+  }
+  case AGS_AUDIO_BUFFER_UTIL_S16:
+  {
+    return(((gint16 *) buffer) + offset);
+  }
+  case AGS_AUDIO_BUFFER_UTIL_S24:
+  case AGS_AUDIO_BUFFER_UTIL_S32:
+  {
+    return(((gint32 *) buffer) + offset);
+  }
+  case AGS_AUDIO_BUFFER_UTIL_S64:
+  {
+    return(((gint64 *) buffer) + offset);
+  }
+  case AGS_AUDIO_BUFFER_UTIL_FLOAT:
+  {
+    return(((gfloat *) buffer) + offset);
+  }
+  case AGS_AUDIO_BUFFER_UTIL_DOUBLE:
+  {
+    return(((gdouble *) buffer) + offset);
+  }
+  case AGS_AUDIO_BUFFER_UTIL_COMPLEX:
+  {
+    return(((AgsComplex *) buffer) + offset);
+  }
+  }
+
+  return(NULL);
+}
+
+void
+ags_pitch_util_interpolate(gdouble *destination,
+			   gdouble *source, guint source_length,
+			   gdouble position, gdouble ratio,
+			   guint count)
+{
+  gdouble x, t;
+  gdouble y0, y1, y2, y3;
+  gint64 n;
+  guint i;
+
+  i = 0;
+
+#if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
+  /* vectorized function */
+  if(count > 8){
+    guint limit;
+
+    limit = count - (count % 8);
+
+    for(; i < limit; i += 8){
+      ags_v8double v_y0, v_y1, v_y2, v_y3;
+      ags_v8double v_t;
+      ags_v8double v_y;
+
+      guint j;
+
+      /* the kernel reads n - 1 to n + 2 of the source, ratio is negative if reversed */
+      x = MIN(position + (gdouble) i * ratio, position + (gdouble) (i + 7) * ratio);
+      t = MAX(position + (gdouble) i * ratio, position + (gdouble) (i + 7) * ratio);
+
+      if(x < 1.0 ||
+	 (gint64) floor(t) + 2 >= (gint64) source_length){
+	break;
+      }
+
+      for(j = 0; j < 8; j++){
+	x = position + (gdouble) (i + j) * ratio;
+	n = (gint64) floor(x);
+
+	v_t[j] = x - (gdouble) n;
+
+	v_y0[j] = source[n - 1];
+	v_y1[j] = source[n];
+	v_y2[j] = source[n + 1];
+	v_y3[j] = source[n + 2];
+      }
+
+      v_y = v_y1 + 0.5 * v_t * (v_y2 - v_y0 + v_t * (2.0 * v_y0 - 5.0 * v_y1 + 4.0 * v_y2 - v_y3 + v_t * (3.0 * (v_y1 - v_y2) + v_y3 - v_y0)));
+
+      for(j = 0; j < 8; j++){
+	destination[i + j] = v_y[j];
+      }
+    }
+  }
+#endif
+
+  for(; i < count; i++){
+    x = position + (gdouble) i * ratio;
+    n = (gint64) floor(x);
+
+    t = x - (gdouble) n;
+
+    if(n >= 1 &&
+       n + 2 < (gint64) source_length){
+      y0 = source[n - 1];
+      y1 = source[n];
+      y2 = source[n + 1];
+      y3 = source[n + 2];
+    }else{
+      y0 = (n - 1 >= 0 && n - 1 < (gint64) source_length) ? source[n - 1]: 0.0;
+      y1 = (n >= 0 && n < (gint64) source_length) ? source[n]: 0.0;
+      y2 = (n + 1 >= 0 && n + 1 < (gint64) source_length) ? source[n + 1]: 0.0;
+      y3 = (n + 2 >= 0 && n + 2 < (gint64) source_length) ? source[n + 2]: 0.0;
+    }
+
+    destination[i] = y1 + 0.5 * t * (y2 - y0 + t * (2.0 * y0 - 5.0 * y1 + 4.0 * y2 - y3 + t * (3.0 * (y1 - y2) + y3 - y0)));
+  }
+}
+
+/**
+ * ags_pitch_util_resample:
+ * @pitch_util: the #AgsPitchUtil-struct
+ * @destination: the destination buffer
+ * @n_frames: the count of frames to write
+ * @audio_buffer_util_format: the audio buffer util format of @destination
+ *
+ * Resample the source of @pitch_util to @destination using additive strategy,
+ * starting at the current position. The position is advanced, so consecutive
+ * calls continue seamlessly across buffers.
+ *
+ * Returns: the count of frames written, less than @n_frames if the source is exhausted
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_pitch_util_resample(AgsPitchUtil *pitch_util,
+			void *destination,
+			guint n_frames,
+			guint audio_buffer_util_format)
+{
+  guint copy_mode;
+  guint available;
+  guint count;
+  guint i;
+
+  if(pitch_util == NULL ||
+     destination == NULL ||
+     pitch_util->source == NULL ||
+     pitch_util->ratio <= 0.0){
+    return(0);
+  }
+
+  available = 0;
+
+  if(pitch_util->position < (gdouble) pitch_util->source_length){
+    available = (guint) ceil(((gdouble) pitch_util->source_length - pitch_util->position) / pitch_util->ratio);
+  }
+
+  if(n_frames > available){
+    n_frames = available;
+  }
+
+  copy_mode = ags_audio_buffer_util_get_copy_mode(audio_buffer_util_format,
+						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+  for(i = 0; i < n_frames; i += count){
+    count = n_frames - i;
+
+    if(count > pitch_util->scratch_size){
+      count = pitch_util->scratch_size;
+    }
+
+    ags_pitch_util_interpolate(pitch_util->scratch,
+			       pitch_util->source, pitch_util->source_length,
+			       pitch_util->position, pitch_util->ratio,
+			       count);
+
+    ags_audio_buffer_util_copy_buffer_to_buffer(destination, 1, i,
+						pitch_util->scratch, 1, 0,
+						count, copy_mode);
+
+    pitch_util->position += (gdouble) count * pitch_util->ratio;
+  }
+
+  return(n_frames);
+}
+
+/**
+ * ags_pitch_util_resample_at:
+ * @pitch_util: the #AgsPitchUtil-struct
+ * @destination: the destination buffer
+ * @frame: the first frame of the resampled source
+ * @n_frames: the count of frames to write
+ * @reverse: if %TRUE read backwards from @frame
+ * @audio_buffer_util_format: the audio buffer util format of @destination
+ *
+ * Resample @n_frames of the source window of @pitch_util to @destination
+ * using additive strategy. @frame is within the resampled source, so it is
+ * independent of where the window starts. Frames outside the window are
+ * silent.
+ *
+ * Returns: the count of frames written
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_pitch_util_resample_at(AgsPitchUtil *pitch_util,
+			   void *destination,
+			   gint64 frame, guint n_frames,
+			   gboolean reverse,
+			   guint audio_buffer_util_format)
+{
+  gdouble position;
+  gdouble ratio;
+  guint copy_mode;
+  guint count;
+  guint i;
+
+  if(pitch_util == NULL ||
+     destination == NULL ||
+     pitch_util->ratio <= 0.0){
+    return(0);
+  }
+
+  position = (gdouble) frame * pitch_util->ratio - (gdouble) pitch_util->source_offset;
+
+  ratio = (reverse) ? -1.0 * pitch_util->ratio: pitch_util->ratio;
+
+  copy_mode = ags_audio_buffer_util_get_copy_mode(audio_buffer_util_format,
+						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+  for(i = 0; i < n_frames; i += count){
+    count = n_frames - i;
+
+    if(count > pitch_util->scratch_size){
+      count = pitch_util->scratch_size;
+    }
+
+    ags_pitch_util_interpolate(pitch_util->scratch,
+			       pitch_util->source, pitch_util->source_length,
+			       position, ratio,
+			       count);
+
+    ags_audio_buffer_util_copy_buffer_to_buffer(destination, 1, i,
+						pitch_util->scratch, 1, 0,
+						count, copy_mode);
+
+    position += (gdouble) count * ratio;
+  }
+
+  pitch_util->position = position;
+  
+  return(n_frames);
+}
+
+/**
+ * ags_pitch_util_resample_sound_resource:
+ * @pitch_util: the #AgsPitchUtil-struct
+ * @destination: the destination buffer
+ * @sound_resource: the #AgsSoundResource
+ * @source_frame_count: the frame count of @sound_resource
+ * @frame: the first frame of the resampled source
+ * @n_frames: the count of frames to write
+ * @reverse: if %TRUE read backwards from @frame
+ * @audio_buffer_util_format: the audio buffer util format of @destination
+ *
+ * Resample @n_frames of @sound_resource to @destination using additive
+ * strategy. Only the sample frames needed are read into the source window of
+ * @pitch_util. The window reads ahead and is reused by the next call, so a
+ * voice rendered period by period reads each frame about once.
+ *
+ * Returns: the count of frames written
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_pitch_util_resample_sound_resource(AgsPitchUtil *pitch_util,
+				       void *destination,
+				       GObject *sound_resource,
+				       guint source_frame_count,
+				       gint64 frame, guint n_frames,
+				       gboolean reverse,
+				       guint audio_buffer_util_format)
+{
+  gdouble *source;
+  
+  gdouble first_position, last_position;
+  gint64 lower, upper;
+  guint64 source_offset;
+  guint source_length;
+  guint max_count;
+  guint count;
+  guint i;
+
+  if(pitch_util == NULL ||
+     destination == NULL ||
+     !AGS_IS_SOUND_RESOURCE(sound_resource) ||
+     pitch_util->ratio <= 0.0){
+    return(0);
+  }
+
+  /* frames per window - the kernel needs 4 source frames around the span */
+  max_count = (guint) floor((gdouble) (pitch_util->source_allocated - 4) / pitch_util->ratio);
+
+  if(max_count == 0){
+    max_count = 1;
+  }
+
+  for(i = 0; i < n_frames; i += count){
+    count = n_frames - i;
+
+    if(count > max_count){
+      count = max_count;
+    }
+
+    /* source frames of the span */
+    if(!reverse){
+      first_position = (gdouble) (frame + i) * pitch_util->ratio;
+      last_position = (gdouble) (frame + i + count - 1) * pitch_util->ratio;
+    }else{
+      first_position = (gdouble) (frame - (gint64) (i + count - 1)) * pitch_util->ratio;
+      last_position = (gdouble) (frame - (gint64) i) * pitch_util->ratio;
+    }
+    
+    lower = (gint64) floor(first_position) - 1;
+    upper = (gint64) floor(last_position) + 2;
+
+    if(lower < 0){
+      lower = 0;
+    }
+
+    if(upper >= (gint64) source_frame_count){
+      upper = (gint64) source_frame_count - 1;
+    }
+
+    if(lower > upper){
+      /* beyond the sample - silent */
+      continue;
+    }
+
+    /* read ahead in play direction */
+    if(!ags_pitch_util_has_window(pitch_util,
+				  sound_resource,
+				  (guint64) lower, (guint) (upper - lower + 1))){
+      if(!reverse){
+	source_offset = (guint64) lower;
+      }else{
+	source_offset = (upper + 1 > (gint64) pitch_util->source_allocated) ? (guint64) (upper + 1 - pitch_util->source_allocated): 0;
+      }
+
+      source_length = source_frame_count - source_offset;
+
+      source = ags_pitch_util_reserve_window(pitch_util,
+					     sound_resource,
+					     source_offset,
+					     &source_length);
+      
+      ags_sound_resource_seek(AGS_SOUND_RESOURCE(sound_resource),
+			      (gint64) source_offset, G_SEEK_SET);
+      ags_sound_resource_read(AGS_SOUND_RESOURCE(sound_resource),
+			      source, 1,
+			      0,
+			      source_length, AGS_SOUNDCARD_DOUBLE);
+    }
+
+    ags_pitch_util_resample_at(pitch_util,
+			       ags_pitch_util_buffer_offset(destination, i, audio_buffer_util_format),
+			       (reverse) ? frame - (gint64) i: frame + (gint64) i, count,
+			       reverse,
+			       audio_buffer_util_format);
+  }
+
+  return(n_frames);
+}
+
+/**
+ * ags_pitch_util_resample_data:
+ * @pitch_util: the #AgsPitchUtil-struct
+ * @destination: the destination buffer
+ * @data: the interleaved sample data
+ * @data_audio_channels: the audio channels of @data
+ * @audio_channel: the audio channel of @data to resample
+ * @data_format: the #AgsSoundcardFormat of @data
+ * @source_frame_count: the frame count of @data
+ * @frame: the first frame of the resampled source
+ * @n_frames: the count of frames to write
+ * @reverse: if %TRUE read backwards from @frame
+ * @audio_buffer_util_format: the audio buffer util format of @destination
+ *
+ * Resample @n_frames of @audio_channel of @data to @destination using
+ * additive strategy. Like ags_pitch_util_resample_sound_resource() but the
+ * source window is converted straight from the sample data, as returned by
+ * ags_ipatch_sample_get_data() or ags_sfz_sample_get_data(), without going
+ * through the sound resource.
+ *
+ * Returns: the count of frames written
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_pitch_util_resample_data(AgsPitchUtil *pitch_util,
+			     void *destination,
+			     void *data, guint data_audio_channels,
+			     guint audio_channel, guint data_format,
+			     guint source_frame_count,
+			     gint64 frame, guint n_frames,
+			     gboolean reverse,
+			     guint audio_buffer_util_format)
+{
+  gdouble *source;
+
+  gpointer source_id;
+  
+  gdouble first_position, last_position;
+  gint64 lower, upper;
+  guint64 source_offset;
+  guint source_length;
+  guint data_audio_buffer_util_format;
+  guint copy_mode;
+  guint max_count;
+  guint count;
+  guint i;
+
+  if(pitch_util == NULL ||
+     destination == NULL ||
+     data == NULL ||
+     data_audio_channels == 0 ||
+     audio_channel >= data_audio_channels ||
+     pitch_util->ratio <= 0.0){
+    return(0);
+  }
+
+  data_audio_buffer_util_format = ags_audio_buffer_util_format_from_soundcard(data_format);
+
+  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_DOUBLE,
+						  data_audio_buffer_util_format);
+
+  /* the first sample of the channel identifies the window */
+  source_id = ags_pitch_util_buffer_offset(data, audio_channel, data_audio_buffer_util_format);
+
+  /* frames per window - the kernel needs 4 source frames around the span */
+  max_count = (guint) floor((gdouble) (pitch_util->source_allocated - 4) / pitch_util->ratio);
+
+  if(max_count == 0){
+    max_count = 1;
+  }
+
+  for(i = 0; i < n_frames; i += count){
+    count = n_frames - i;
+
+    if(count > max_count){
+      count = max_count;
+    }
+
+    /* source frames of the span */
+    if(!reverse){
+      first_position = (gdouble) (frame + i) * pitch_util->ratio;
+      last_position = (gdouble) (frame + i + count - 1) * pitch_util->ratio;
+    }else{
+      first_position = (gdouble) (frame - (gint64) (i + count - 1)) * pitch_util->ratio;
+      last_position = (gdouble) (frame - (gint64) i) * pitch_util->ratio;
+    }
+    
+    lower = (gint64) floor(first_position) - 1;
+    upper = (gint64) floor(last_position) + 2;
+
+    if(lower < 0){
+      lower = 0;
+    }
+
+    if(upper >= (gint64) source_frame_count){
+      upper = (gint64) source_frame_count - 1;
+    }
+
+    if(lower > upper){
+      /* beyond the sample - silent */
+      continue;
+    }
+
+    /* convert ahead in play direction */
+    if(!ags_pitch_util_has_window(pitch_util,
+				  source_id,
+				  (guint64) lower, (guint) (upper - lower + 1))){
+      if(!reverse){
+	source_offset = (guint64) lower;
+      }else{
+	source_offset = (upper + 1 > (gint64) pitch_util->source_allocated) ? (guint64) (upper + 1 - pitch_util->source_allocated): 0;
+      }
+
+      source_length = source_frame_count - source_offset;
+
+      source = ags_pitch_util_reserve_window(pitch_util,
+					     source_id,
+					     source_offset,
+					     &source_length);
+      
+      ags_audio_buffer_util_copy_buffer_to_buffer(source, 1, 0,
+						  data, data_audio_channels, (source_offset * data_audio_channels) + audio_channel,
+						  source_length, copy_mode);
+    }
+
+    ags_pitch_util_resample_at(pitch_util,
+			       ags_pitch_util_buffer_offset(destination, i, audio_buffer_util_format),
+			       (reverse) ? frame - (gint64) i: frame + (gint64) i, count,
+			       reverse,
+			       audio_buffer_util_format);
+  }
+
+  return(n_frames);
+}
+
+void
+ags_pitch_util_phase_vocoder_run(AgsPitchUtil *pitch_util,
+				 gdouble *buffer,
+				 guint count)
+{
+  double *fft_out;
+
+  gdouble expected;
+  gdouble normalize;
+  gdouble phase, delta;
+  gdouble peak_phase;
+  glong qpd;
+  guint frame_size, oversampling;
+  guint hop, latency;
+  guint half;
+  guint n_peaks;
+  guint lower, upper;
+  gint target, t;
+  guint i, j, k;
+
+  frame_size = pitch_util->frame_size;
+  oversampling = pitch_util->oversampling;
+
+  hop = frame_size / oversampling;
+  latency = frame_size - hop;
+
+  half = frame_size / 2;
+
+  expected = 2.0 * M_PI * (gdouble) hop / (gdouble) frame_size;
+
+  /* the squared hann window overlaps to 3/8 of the oversampling */
+  normalize = 1.0 / ((gdouble) frame_size * (gdouble) oversampling * 0.375);
+
+  fft_out = (double *) pitch_util->fft_out;
+
+  for(i = 0; i < count; i++){
+    pitch_util->in_fifo[pitch_util->fifo_offset] = buffer[i];
+    buffer[i] = pitch_util->out_fifo[pitch_util->fifo_offset - latency];
+
+    pitch_util->fifo_offset += 1;
+
+    if(pitch_util->fifo_offset < frame_size){
+      continue;
+    }
+
+    pitch_util->fifo_offset = latency;
+
+    /* analysis - frequencies are kept in bins */
+    for(k = 0; k < frame_size; k++){
+      pitch_util->fft_in[k] = pitch_util->in_fifo[k] * pitch_util->window[k];
+    }
+
+    ags_fft_plan_execute_dft_r2c(pitch_util->forward_plan,
+				 pitch_util->fft_in,
+				 pitch_util->fft_out);
+
+    for(k = 0; k <= half; k++){
+      phase = atan2(fft_out[2 * k + 1], fft_out[2 * k]);
+
+      delta = phase - pitch_util->last_phase[k];
+      pitch_util->last_phase[k] = phase;
+
+      delta -= (gdouble) k * expected;
+
+      qpd = (glong) (delta / M_PI);
+
+      if(qpd >= 0){
+	qpd += (qpd & 1);
+      }else{
+	qpd -= (qpd & 1);
+      }
+
+      delta -= M_PI * (gdouble) qpd;
+
+      pitch_util->analysis_magnitude[k] = sqrt(fft_out[2 * k] * fft_out[2 * k] + fft_out[2 * k + 1] * fft_out[2 * k + 1]);
+      pitch_util->analysis_phase[k] = phase;
+      pitch_util->analysis_frequency[k] = (gdouble) k + (gdouble) oversampling * delta / (2.0 * M_PI);
+    }
+
+    /* peaks */
+    n_peaks = 0;
+
+    for(k = 1; k < half; k++){
+      if(pitch_util->analysis_magnitude[k] > pitch_util->analysis_magnitude[k - 1] &&
+	 pitch_util->analysis_magnitude[k] >= pitch_util->analysis_magnitude[k + 1]){
+	pitch_util->peak[n_peaks] = k;
+	n_peaks++;
+      }
+    }
+
+    /* shift - each peak moves its region of influence, phases are locked to the peak */
+    memset(pitch_util->synthesis_magnitude, 0, (half + 1) * sizeof(gdouble));
+    memset(pitch_util->synthesis_phase, 0, (half + 1) * sizeof(gdouble));
+
+    for(j = 0; j < n_peaks; j++){
+      guint peak;
+
+      peak = pitch_util->peak[j];
+
+      target = (gint) floor((gdouble) peak * pitch_util->shift + 0.5);
+
+      if(target > (gint) half){
+	break;
+      }
+
+      lower = (j == 0) ? 0: ((pitch_util->peak[j - 1] + peak) / 2 + 1);
+      upper = (j + 1 == n_peaks) ? half: ((peak + pitch_util->peak[j + 1]) / 2);
+
+      peak_phase = pitch_util->sum_phase[target] + expected * pitch_util->analysis_frequency[peak] * pitch_util->shift;
+
+      for(k = lower; k <= upper; k++){
+	t = target + (gint) k - (gint) peak;
+
+	if(t < 0 ||
+	   t > (gint) half){
+	  continue;
+	}
+
+	pitch_util->synthesis_magnitude[t] += pitch_util->analysis_magnitude[k];
+	pitch_util->synthesis_phase[t] = peak_phase + pitch_util->analysis_phase[k] - pitch_util->analysis_phase[peak];
+      }
+    }
+
+    /* synthesis */
+    for(k = 0; k <= half; k++){
+      if(pitch_util->synthesis_magnitude[k] != 0.0){
+	pitch_util->sum_phase[k] = fmod(pitch_util->synthesis_phase[k], 2.0 * M_PI);
+      }else{
+	pitch_util->sum_phase[k] = fmod(pitch_util->sum_phase[k] + (gdouble) k * expected, 2.0 * M_PI);
+      }
+
+      fft_out[2 * k] = pitch_util->synthesis_magnitude[k] * cos(pitch_util->sum_phase[k]);
+      fft_out[2 * k + 1] = pitch_util->synthesis_magnitude[k] * sin(pitch_util->sum_phase[k]);
+    }
+
+    ags_fft_plan_execute_dft_c2r(pitch_util->backward_plan,
+				 pitch_util->fft_out,
+				 pitch_util->fft_in);
+
+    for(k = 0; k < frame_size; k++){
+      pitch_util->output_accum[k] += pitch_util->window[k] * pitch_util->fft_in[k] * normalize;
+    }
+
+    memcpy(pitch_util->out_fifo, pitch_util->output_accum, hop * sizeof(gdouble));
+
+    memmove(pitch_util->output_accum, pitch_util->output_accum + hop, frame_size * sizeof(gdouble));
+    memmove(pitch_util->in_fifo, pitch_util->in_fifo + hop, latency * sizeof(gdouble));
+  }
+}
+
+/**
+ * ags_pitch_util_phase_vocoder:
+ * @pitch_util: the #AgsPitchUtil-struct
+ * @buffer: the audio buffer
+ * @buffer_length: the buffer length
+ * @audio_buffer_util_format: the audio buffer util format of @buffer
+ *
+ * Shift pitch of @buffer in-place by phase vocoder. @pitch_util has to be
+ * allocated with %AGS_PITCH_UTIL_PHASE_VOCODER, it keeps the fifos between
+ * calls so consecutive buffers of a stream are processed seamlessly.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_pitch_util_phase_vocoder(AgsPitchUtil *pitch_util,
+			     void *buffer, guint buffer_length,
+			     guint audio_buffer_util_format)
+{
+  guint copy_in_mode, copy_out_mode;
+  guint count;
+  guint i;
+
+  if(pitch_util == NULL ||
+     buffer == NULL ||
+     pitch_util->fft_in == NULL){
+    return;
+  }
+
+  copy_in_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_DOUBLE,
+						     audio_buffer_util_format);
+  copy_out_mode = ags_audio_buffer_util_get_copy_mode(audio_buffer_util_format,
+						      AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+  for(i = 0; i < buffer_length; i += count){
+    count = buffer_length - i;
+
+    if(count > pitch_util->scratch_size){
+      count = pitch_util->scratch_size;
+    }
+
+    ags_audio_buffer_util_clear_double(pitch_util->scratch, 1,
+				       count);
+
+    ags_audio_buffer_util_copy_buffer_to_buffer(pitch_util->scratch, 1, 0,
+						buffer, 1, i,
+						count, copy_in_mode);
+
+    ags_pitch_util_phase_vocoder_run(pitch_util,
+				     pitch_util->scratch,
+				     count);
+
+    ags_audio_buffer_util_clear_buffer(ags_pitch_util_buffer_offset(buffer, i, audio_buffer_util_format), 1,
+				       count, audio_buffer_util_format);
+
+    ags_audio_buffer_util_copy_buffer_to_buffer(buffer, 1, i,
+						pitch_util->scratch, 1, 0,
+						count, copy_out_mode);
+  }
+}
+
+/**
+ * ags_pitch_util_pitch:
+ * @pitch_util: the #AgsPitchUtil-struct
+ * @buffer: the audio buffer
+ * @buffer_length: the buffer length
+ * @audio_buffer_util_format: the audio buffer util format of @buffer
+ *
+ * Shift pitch of @buffer in-place, the length and the duration are kept.
+ * @buffer is taken as a whole, so the phase vocoder of @pitch_util is reset
+ * and its latency is compensated. @pitch_util has to be allocated with
+ * %AGS_PITCH_UTIL_PHASE_VOCODER.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_pitch_util_pitch(AgsPitchUtil *pitch_util,
+		     void *buffer, guint buffer_length,
+		     guint audio_buffer_util_format)
+{
+  guint copy_in_mode, copy_out_mode;
+  guint latency;
+  guint n_frames;
+  guint output_offset;
+  guint count;
+  guint i;
+
+  if(pitch_util == NULL ||
+     buffer == NULL ||
+     buffer_length == 0 ||
+     pitch_util->fft_in == NULL){
+    return;
+  }
+
+  ags_pitch_util_reset(pitch_util);
+
+  latency = pitch_util->frame_size - (pitch_util->frame_size / pitch_util->oversampling);
+
+  copy_in_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_DOUBLE,
+						     audio_buffer_util_format);
+  copy_out_mode = ags_audio_buffer_util_get_copy_mode(audio_buffer_util_format,
+						      AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+  /* feed silence to flush the latency, output frame i + latency belongs to input frame i */
+  n_frames = buffer_length + latency;
+  
+  for(i = 0; i < n_frames; i += count){
+    count = n_frames - i;
+
+    if(count > pitch_util->scratch_size){
+      count = pitch_util->scratch_size;
+    }
+
+    ags_audio_buffer_util_clear_double(pitch_util->scratch, 1,
+				       count);
+
+    if(i < buffer_length){
+      ags_audio_buffer_util_copy_buffer_to_buffer(pitch_util->scratch, 1, 0,
+						  buffer, 1, i,
+						  MIN(count, buffer_length - i), copy_in_mode);
+    }
+
+    ags_pitch_util_phase_vocoder_run(pitch_util,
+				     pitch_util->scratch,
+				     count);
+
+    /* the input of this span was consumed, so writing behind it is safe */
+    if(i + count <= latency){
+      continue;
+    }
+
+    output_offset = (i < latency) ? latency - i: 0;
+    
+    ags_audio_buffer_util_clear_buffer(ags_pitch_util_buffer_offset(buffer, i + output_offset - latency, audio_buffer_util_format), 1,
+				       count - output_offset, audio_buffer_util_format);
+
+    ags_audio_buffer_util_copy_buffer_to_buffer(buffer, 1, i + output_offset - latency,
+						pitch_util->scratch, 1, output_offset,
+						count - output_offset, copy_out_mode);
+  }
+}
@@ -0,0 +1,217 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_PITCH_UTIL_H__
+#define __AGS_PITCH_UTIL_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <fftw3.h>
+
+#include <ags/libags.h>
+
+#include <ags/audio/ags_fft_plan_cache.h>
+
+G_BEGIN_DECLS
+
+#define AGS_PITCH_UTIL(ptr) ((AgsPitchUtil *)(ptr))
+
+#define AGS_PITCH_UTIL_DEFAULT_SCRATCH_SIZE (8192)
+#define AGS_PITCH_UTIL_DEFAULT_WINDOW_SIZE (16384)
+#define AGS_PITCH_UTIL_DEFAULT_FRAME_SIZE (2048)
+#define AGS_PITCH_UTIL_DEFAULT_OVERSAMPLING (4)
+
+typedef struct _AgsPitchUtil AgsPitchUtil;
+
+/**
+ * AgsPitchUtilMode:
+ * @AGS_PITCH_UTIL_RESAMPLE: transpose by resampling the source, the duration changes with pitch
+ * @AGS_PITCH_UTIL_PHASE_VOCODER: shift pitch by a phase vocoder, the duration is preserved
+ *
+ * Enum values to specify the algorithm used by #AgsPitchUtil.
+ */
+typedef enum{
+  AGS_PITCH_UTIL_RESAMPLE        = 1,
+  AGS_PITCH_UTIL_PHASE_VOCODER   = 1 <<  1,
+}AgsPitchUtilMode;
+
+/**
+ * AgsPitchUtil:
+ * @mode: the #AgsPitchUtilMode-enum
+ * @source_samplerate: the source samplerate
+ * @samplerate: the samplerate
+ * @base_key: the base key
+ * @tuning: the tuning in cents
+ * @shift: the pitch shift factor
+ * @ratio: the resample step, source frames per output frame
+ * @scratch_size: the scratch size
+ * @scratch: the scratch buffer
+ * @source_length: the source length
+ * @source_allocated: the allocated source length
+ * @source: the source buffer
+ * @source_id: the sound resource the source window was read from
+ * @source_offset: the frame of the sound resource at the start of @source
+ * @position: the current position within @source
+ * @frame_size: the phase vocoder frame size
+ * @oversampling: the phase vocoder oversampling
+ * @fifo_offset: the phase vocoder fifo offset
+ * @window: the analysis and synthesis window
+ * @in_fifo: the input fifo
+ * @out_fifo: the output fifo
+ * @output_accum: the overlap-add accumulator
+ * @last_phase: the last analysis phase
+ * @sum_phase: the last synthesis phase
+ * @analysis_magnitude: the analysis magnitude
+ * @analysis_phase: the analysis phase
+ * @analysis_frequency: the analysis frequency in bins
+ * @synthesis_magnitude: the synthesis magnitude
+ * @synthesis_phase: the synthesis phase
+ * @peak: the spectral peaks of the current frame
+ * @fft_in: the real FFT buffer
+ * @fft_out: the complex FFT buffer
+ * @forward_plan: the forward FFT plan, owned by #AgsFFTPlanCache
+ * @backward_plan: the backward FFT plan, owned by #AgsFFTPlanCache
+ *
+ * #AgsPitchUtil holds the state and scratch memory of a pitch shifter, so
+ * it can be reused across calls and stream across period boundaries
+ * without allocating.
+ */
+struct _AgsPitchUtil
+{
+  guint mode;
+
+  guint source_samplerate;
+  guint samplerate;
+
+  gdouble base_key;
+  gdouble tuning;
+
+  gdouble shift;
+  gdouble ratio;
+
+  guint scratch_size;
+  gdouble *scratch;
+
+  guint source_length;
+  guint source_allocated;
+  gdouble *source;
+
+  gpointer source_id;
+  guint64 source_offset;
+
+  gdouble position;
+
+  guint frame_size;
+  guint oversampling;
+  guint fifo_offset;
+
+  gdouble *window;
+
+  gdouble *in_fifo;
+  gdouble *out_fifo;
+  gdouble *output_accum;
+
+  gdouble *last_phase;
+  gdouble *sum_phase;
+
+  gdouble *analysis_magnitude;
+  gdouble *analysis_phase;
+  gdouble *analysis_frequency;
+  gdouble *synthesis_magnitude;
+  gdouble *synthesis_phase;
+
+  guint *peak;
+
+  double *fft_in;
+  fftw_complex *fft_out;
+
+  AgsFFTPlan *forward_plan;
+  AgsFFTPlan *backward_plan;
+};
+
+AgsPitchUtil* ags_pitch_util_alloc(guint mode,
+				   guint samplerate);
+void ags_pitch_util_free(AgsPitchUtil *pitch_util);
+
+AgsPitchUtil* ags_pitch_util_get_default();
+AgsPitchUtil* ags_pitch_util_get_default_phase_vocoder();
+
+void ags_pitch_util_set_samplerate(AgsPitchUtil *pitch_util,
+				   guint source_samplerate,
+				   guint samplerate);
+void ags_pitch_util_set_pitch(AgsPitchUtil *pitch_util,
+			      gdouble base_key,
+			      gdouble tuning);
+
+void ags_pitch_util_reset(AgsPitchUtil *pitch_util);
+
+gdouble* ags_pitch_util_reserve_source(AgsPitchUtil *pitch_util,
+				       guint source_length);
+void ags_pitch_util_append_source(AgsPitchUtil *pitch_util,
+				  void *buffer, guint buffer_length,
+				  guint audio_buffer_util_format);
+
+guint ags_pitch_util_get_frame_count(AgsPitchUtil *pitch_util);
+
+gdouble* ags_pitch_util_reserve_window(AgsPitchUtil *pitch_util,
+				       gpointer source_id,
+				       guint64 source_offset,
+				       guint *source_length);
+gboolean ags_pitch_util_has_window(AgsPitchUtil *pitch_util,
+				   gpointer source_id,
+				   guint64 source_offset,
+				   guint source_length);
+
+guint ags_pitch_util_resample(AgsPitchUtil *pitch_util,
+			      void *destination,
+			      guint n_frames,
+			      guint audio_buffer_util_format);
+guint ags_pitch_util_resample_at(AgsPitchUtil *pitch_util,
+				 void *destination,
+				 gint64 frame, guint n_frames,
+				 gboolean reverse,
+				 guint audio_buffer_util_format);
+guint ags_pitch_util_resample_sound_resource(AgsPitchUtil *pitch_util,
+					     void *destination,
+					     GObject *sound_resource,
+					     guint source_frame_count,
+					     gint64 frame, guint n_frames,
+					     gboolean reverse,
+					     guint audio_buffer_util_format);
+guint ags_pitch_util_resample_data(AgsPitchUtil *pitch_util,
+				   void *destination,
+				   void *data, guint data_audio_channels,
+				   guint audio_channel, guint data_format,
+				   guint source_frame_count,
+				   gint64 frame, guint n_frames,
+				   gboolean reverse,
+				   guint audio_buffer_util_format);
+
+void ags_pitch_util_phase_vocoder(AgsPitchUtil *pitch_util,
+				  void *buffer, guint buffer_length,
+				  guint audio_buffer_util_format);
+
+void ags_pitch_util_pitch(AgsPitchUtil *pitch_util,
+			  void *buffer, guint buffer_length,
+			  guint audio_buffer_util_format);
+
+G_END_DECLS
+
+#endif /*__AGS_PITCH_UTIL_H__*/
@@ -455,6 +455,9 @@ ags_port_init(AgsPort *port)
   port->automation = NULL;
 
   port->port_value.ags_port_double = 0.0;
+
+  port->port_value_frame = 0;
+  port->previous_port_value.ags_port_double = 0.0;
 }
 
 void
@@ -1325,6 +1328,9 @@ ags_port_real_safe_write(AgsPort *port, GValue *value)
 
   overall_size = port->port_value_length * port->port_value_size;
 
+  /* takes effect immediately */
+  port->port_value_frame = 0;
+
   if(!port->port_value_is_pointer){
     if(port->port_value_type == G_TYPE_BOOLEAN){
       port->port_value.ags_port_boolean = g_value_get_boolean(value);
@@ -106,6 +106,9 @@ struct _AgsPort
     gpointer ags_port_pointer;
     GObject *ags_port_object;
   }port_value;
+
+  guint64 port_value_frame;
+  union _AgsPortValue previous_port_value;
 };
 
 struct _AgsPortClass
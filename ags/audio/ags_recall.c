@@ -42,6 +42,9 @@
 #include <ags/audio/ags_recall_lv2.h>
 #include <ags/audio/ags_recall_recycling.h>
 #include <ags/audio/ags_recall_audio_signal.h>
+#include <ags/audio/ags_recall_pool.h>
+
+#include <ags/audio/osc/ags_osc_address_trie.h>
 
 #include <libxml/tree.h>
 
@@ -86,6 +89,8 @@ void ags_recall_real_run_init_post(AgsRecall *recall);
 void ags_recall_real_feed_input_queue(AgsRecall *recall);
 void ags_recall_real_automate(AgsRecall *recall);
 
+gboolean ags_recall_degraded_bypass(AgsRecall *recall);
+
 void ags_recall_real_run_pre(AgsRecall *recall);
 void ags_recall_real_run_inter(AgsRecall *recall);
 void ags_recall_real_run_post(AgsRecall *recall);
@@ -168,6 +173,7 @@ static gboolean ags_recall_global_children_lock_free = FALSE;
 static gboolean ags_recall_global_omit_event = TRUE;
 static gboolean ags_recall_global_performance_mode = FALSE;
 static gboolean ags_recall_global_rt_safe = FALSE;
+static volatile gint ags_recall_global_degraded = FALSE;
 
 GType
 ags_recall_get_type(void)
@@ -1626,6 +1632,10 @@ ags_recall_dispose(GObject *gobject)
   recall = AGS_RECALL(gobject);
 
   ags_connectable_disconnect(AGS_CONNECTABLE(recall));
+
+  /* timing histograms */
+  ags_timing_monitor_remove(ags_timing_monitor_get_instance(),
+			    recall);
   
   /* recall container */
   if(recall->recall_container != NULL){
@@ -2185,6 +2195,47 @@ ags_recall_global_get_rt_safe()
   return(rt_safe);
 }
 
+/**
+ * ags_recall_global_set_degraded:
+ * @degraded: %TRUE to bypass non-essential recalls
+ * 
+ * Set degraded. While degraded the run stages of recalls having
+ * %AGS_RECALL_NON_ESSENTIAL set are bypassed.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_recall_global_set_degraded(gboolean degraded)
+{
+  g_atomic_int_set(&ags_recall_global_degraded,
+		   degraded);
+}
+
+/**
+ * ags_recall_global_get_degraded:
+ * 
+ * Get degraded.
+ *
+ * Returns: if %TRUE non-essential recalls are bypassed, else not
+ * 
+ * Since: 3.5.0
+ */
+gboolean
+ags_recall_global_get_degraded()
+{
+  return(g_atomic_int_get(&ags_recall_global_degraded));
+}
+
+gboolean
+ags_recall_degraded_bypass(AgsRecall *recall)
+{
+  if(!g_atomic_int_get(&ags_recall_global_degraded)){
+    return(FALSE);
+  }
+
+  return(ags_recall_test_flags(recall, AGS_RECALL_NON_ESSENTIAL));
+}
+
 /**
  * ags_recall_get_obj_mutex:
  * @recall: the #AgsRecall
@@ -2978,6 +3029,7 @@ ags_recall_set_staging_flags(AgsRecall *recall, guint staging_flags)
   guint recall_state_flags;
   
   gboolean omit_event;
+  gboolean degraded_bypass;
 
   GRecMutex *recall_mutex;
 
@@ -2997,6 +3049,8 @@ ags_recall_set_staging_flags(AgsRecall *recall, guint staging_flags)
   recall_state_flags = recall->state_flags;
   
   g_rec_mutex_unlock(recall_mutex);
+
+  degraded_bypass = ags_recall_degraded_bypass(recall);
   
   /* invoke appropriate staging */
   if((AGS_SOUND_STAGING_FINI & (recall_staging_flags)) == 0 &&
@@ -3055,28 +3109,55 @@ ags_recall_set_staging_flags(AgsRecall *recall, guint staging_flags)
       }
     }
 
-    if((AGS_SOUND_STAGING_RUN_PRE & (staging_flags)) != 0 &&
+    if(!degraded_bypass &&
+       (AGS_SOUND_STAGING_RUN_PRE & (staging_flags)) != 0 &&
        (AGS_SOUND_STAGING_RUN_PRE & (recall_staging_flags)) == 0){
       if(omit_event){
+	gint64 start_time;
+
+	start_time = ags_timing_monitor_start();
+	
 	AGS_RECALL_GET_CLASS(recall)->run_pre(recall);
+
+	ags_timing_monitor_stop(recall,
+				AGS_TIMING_MONITOR_RECALL_RUN_PRE,
+				start_time);
       }else{
 	ags_recall_run_pre(recall);
       }
     }
 
-    if((AGS_SOUND_STAGING_RUN_INTER & (staging_flags)) != 0 &&
+    if(!degraded_bypass &&
+       (AGS_SOUND_STAGING_RUN_INTER & (staging_flags)) != 0 &&
        (AGS_SOUND_STAGING_RUN_INTER & (recall_staging_flags)) == 0){
       if(omit_event){
+	gint64 start_time;
+
+	start_time = ags_timing_monitor_start();
+	
 	AGS_RECALL_GET_CLASS(recall)->run_inter(recall);
+
+	ags_timing_monitor_stop(recall,
+				AGS_TIMING_MONITOR_RECALL_RUN_INTER,
+				start_time);
       }else{
 	ags_recall_run_inter(recall);
       }
     }
 
-    if((AGS_SOUND_STAGING_RUN_POST & (staging_flags)) != 0 &&
+    if(!degraded_bypass &&
+       (AGS_SOUND_STAGING_RUN_POST & (staging_flags)) != 0 &&
        (AGS_SOUND_STAGING_RUN_POST & (recall_staging_flags)) == 0){
       if(omit_event){
+	gint64 start_time;
+
+	start_time = ags_timing_monitor_start();
+	
 	AGS_RECALL_GET_CLASS(recall)->run_post(recall);
+
+	ags_timing_monitor_stop(recall,
+				AGS_TIMING_MONITOR_RECALL_RUN_POST,
+				start_time);
       }else{
 	ags_recall_run_post(recall);
       }
@@ -3904,6 +3985,9 @@ ags_recall_add_port(AgsRecall *recall,
   }
   
   g_rec_mutex_unlock(recall_mutex);
+
+  /* invalidate OSC addresses */
+  ags_osc_address_trie_invalidate();
 }
 
 /**
@@ -3939,6 +4023,9 @@ ags_recall_remove_port(AgsRecall *recall,
   }
   
   g_rec_mutex_unlock(recall_mutex);
+
+  /* invalidate OSC addresses */
+  ags_osc_address_trie_invalidate();
 }
 
 /**
@@ -5232,9 +5319,23 @@ ags_recall_real_run_pre(AgsRecall *recall)
 
   while(list != NULL){
     next = list->next;
+
+    if(ags_recall_degraded_bypass(AGS_RECALL(list->data))){
+      list = next;
+
+      continue;
+    }
     
     if(omit_event){
+      gint64 start_time;
+
+      start_time = ags_timing_monitor_start();
+      
       AGS_RECALL_GET_CLASS(AGS_RECALL(list->data))->run_pre(AGS_RECALL(list->data));
+
+      ags_timing_monitor_stop(list->data,
+			      AGS_TIMING_MONITOR_RECALL_RUN_PRE,
+			      start_time);
     }else{
       ags_recall_run_pre(AGS_RECALL(list->data));
     }    
@@ -5259,13 +5360,25 @@ ags_recall_real_run_pre(AgsRecall *recall)
 void
 ags_recall_run_pre(AgsRecall *recall)
 {
+  gint64 start_time;
+  
   g_return_if_fail(AGS_IS_RECALL(recall));
   g_return_if_fail(!ags_recall_test_state_flags(recall, AGS_SOUND_STATE_IS_TERMINATING));
 
+  if(ags_recall_degraded_bypass(recall)){
+    return;
+  }
+  
+  start_time = ags_timing_monitor_start();
+  
   g_object_ref(G_OBJECT(recall));
   g_signal_emit(G_OBJECT(recall),
 		recall_signals[PLAY_RUN_PRE], 0);
   g_object_unref(G_OBJECT(recall));
+
+  ags_timing_monitor_stop(recall,
+			  AGS_TIMING_MONITOR_RECALL_RUN_PRE,
+			  start_time);
 }
 
 void
@@ -5319,9 +5432,23 @@ ags_recall_real_run_inter(AgsRecall *recall)
 
   while(list != NULL){
     next = list->next;
+
+    if(ags_recall_degraded_bypass(AGS_RECALL(list->data))){
+      list = next;
+
+      continue;
+    }
     
     if(omit_event){
+      gint64 start_time;
+
+      start_time = ags_timing_monitor_start();
+      
       AGS_RECALL_GET_CLASS(AGS_RECALL(list->data))->run_inter(AGS_RECALL(list->data));
+
+      ags_timing_monitor_stop(list->data,
+			      AGS_TIMING_MONITOR_RECALL_RUN_INTER,
+			      start_time);
     }else{
       ags_recall_run_inter(AGS_RECALL(list->data));
     }    
@@ -5346,13 +5473,25 @@ ags_recall_real_run_inter(AgsRecall *recall)
 void
 ags_recall_run_inter(AgsRecall *recall)
 {
+  gint64 start_time;
+  
   g_return_if_fail(AGS_IS_RECALL(recall));
   g_return_if_fail(!ags_recall_test_state_flags(recall, AGS_SOUND_STATE_IS_TERMINATING));
 
+  if(ags_recall_degraded_bypass(recall)){
+    return;
+  }
+  
+  start_time = ags_timing_monitor_start();
+  
   g_object_ref(G_OBJECT(recall));
   g_signal_emit(G_OBJECT(recall),
 		recall_signals[PLAY_RUN_INTER], 0);
   g_object_unref(G_OBJECT(recall));
+
+  ags_timing_monitor_stop(recall,
+			  AGS_TIMING_MONITOR_RECALL_RUN_INTER,
+			  start_time);
 }
 
 void
@@ -5407,9 +5546,23 @@ ags_recall_real_run_post(AgsRecall *recall)
 
   while(list != NULL){
     next = list->next;
+
+    if(ags_recall_degraded_bypass(AGS_RECALL(list->data))){
+      list = next;
+
+      continue;
+    }
     
     if(omit_event){
+      gint64 start_time;
+
+      start_time = ags_timing_monitor_start();
+      
       AGS_RECALL_GET_CLASS(AGS_RECALL(list->data))->run_post(AGS_RECALL(list->data));
+
+      ags_timing_monitor_stop(list->data,
+			      AGS_TIMING_MONITOR_RECALL_RUN_POST,
+			      start_time);
     }else{
       ags_recall_run_post(AGS_RECALL(list->data));
     }    
@@ -5434,13 +5587,25 @@ ags_recall_real_run_post(AgsRecall *recall)
 void
 ags_recall_run_post(AgsRecall *recall)
 {
+  gint64 start_time;
+  
   g_return_if_fail(AGS_IS_RECALL(recall));
   g_return_if_fail(!ags_recall_test_state_flags(recall, AGS_SOUND_STATE_IS_TERMINATING));
 
+  if(ags_recall_degraded_bypass(recall)){
+    return;
+  }
+  
+  start_time = ags_timing_monitor_start();
+  
   g_object_ref(G_OBJECT(recall));
   g_signal_emit(G_OBJECT(recall),
 		recall_signals[PLAY_RUN_POST], 0);
   g_object_unref(G_OBJECT(recall));
+
+  ags_timing_monitor_stop(recall,
+			  AGS_TIMING_MONITOR_RECALL_RUN_POST,
+			  start_time);
 }
 
 void
@@ -5882,23 +6047,29 @@ ags_recall_real_duplicate(AgsRecall *recall,
   parameter_name[n_params[0] + 7] = NULL;
 
   n_params[0] += 7;
-  
+
+  /* take pre-instanced recall of pool */
+  copy_recall = (AgsRecall *) ags_recall_pool_take(ags_recall_pool_get_instance(),
+						   G_OBJECT_TYPE(recall));
+
+  if(copy_recall != NULL){
+    ags_recall_pool_apply_properties(ags_recall_pool_get_instance(),
+				     (GObject *) copy_recall,
+				     n_params[0], parameter_name, value);
+  }else{
 #if HAVE_GLIB_2_54    
-  copy_recall = g_object_new_with_properties(G_OBJECT_TYPE(recall),
-					     n_params[0], parameter_name, value);
+    copy_recall = g_object_new_with_properties(G_OBJECT_TYPE(recall),
+					       n_params[0], parameter_name, value);
 #else
-  copy_recall = g_object_new(G_OBJECT_TYPE(recall),
-			     NULL);
-
-  {
-    guint i;
+    copy_recall = g_object_new(G_OBJECT_TYPE(recall),
+			       NULL);
 
     for(i = 0; i < n_params[0]; i++){
       g_object_set_property((GObject *) copy_recall,
 			    parameter_name[i], &(value[i]));
     }
-  }
 #endif
+  }
   
   /* free parameter name and value */
   g_free(parameter_name);
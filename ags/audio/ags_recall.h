@@ -59,6 +59,7 @@ typedef struct _AgsRecallHandler AgsRecallHandler;
  * @AGS_RECALL_HAS_OUTPUT_PORT: has output port
  * @AGS_RECALL_BYPASS: don't apply effect processing
  * @AGS_RECALL_INITIAL_RUN: initial run, first attack to audio data
+ * @AGS_RECALL_NON_ESSENTIAL: analysis or metering, bypassed while degraded
  * 
  * Enum values to control the behavior or indicate internal state of #AgsRecall by
  * enable/disable as flags.
@@ -71,6 +72,7 @@ typedef enum{
   AGS_RECALL_HAS_OUTPUT_PORT       = 1 <<  4,
   AGS_RECALL_BYPASS                = 1 <<  5,
   AGS_RECALL_INITIAL_RUN           = 1 <<  6,
+  AGS_RECALL_NON_ESSENTIAL         = 1 <<  7,
 }AgsRecallFlags;
 
 /**
@@ -215,6 +217,9 @@ gboolean ags_recall_global_get_omit_event();
 gboolean ags_recall_global_get_performance_mode();
 gboolean ags_recall_global_get_rt_safe();
 
+void ags_recall_global_set_degraded(gboolean degraded);
+gboolean ags_recall_global_get_degraded();
+
 GRecMutex* ags_recall_get_obj_mutex(AgsRecall *recall);
 
 gboolean ags_recall_test_flags(AgsRecall *recall, guint flags);
@@ -25,6 +25,7 @@
 #include <ags/plugin/ags_lv2_manager.h>
 #include <ags/plugin/ags_lv2_plugin.h>
 #include <ags/plugin/ags_plugin_port.h>
+#include <ags/plugin/ags_lv2_worker_manager.h>
 #include <ags/plugin/ags_lv2_worker.h>
 
 #include <ags/audio/ags_input.h>
@@ -236,6 +237,7 @@ ags_recall_lv2_run_init(AgsRecallLv2Run *recall_lv2_run)
   recall_lv2_run->note = NULL;
 
   recall_lv2_run->worker_handle = NULL;
+  recall_lv2_run->lv2_worker = NULL;
 }
 
 void
@@ -508,6 +510,9 @@ ags_recall_lv2_run_run_init_pre(AgsRecall *recall)
 							  samplerate, buffer_size);
 
   recall_lv2_run->lv2_handle = lv2_handle;
+
+  recall_lv2_run->lv2_worker = (GObject *) ags_lv2_worker_manager_find_worker(ags_lv2_worker_manager_get_instance(),
+									      ((lv2_handle != NULL) ? lv2_handle[0]: NULL));
   
 #ifdef AGS_DEBUG
   g_message("instantiate LV2 handle");
@@ -736,6 +741,8 @@ ags_recall_lv2_run_run_pre(AgsRecall *recall)
   AgsCountBeatsAudioRun *count_beats_audio_run;
   AgsRouteLv2AudioRun *route_lv2_audio_run;
 
+  AgsLv2Worker *lv2_worker;
+
   GList *list_start, *list;
   GList *port;
   
@@ -901,6 +908,10 @@ ags_recall_lv2_run_run_pre(AgsRecall *recall)
 
 	/* cleanup */
 	if(cleanup != NULL){
+	  ags_lv2_worker_manager_remove_handle(ags_lv2_worker_manager_get_instance(),
+					       recall_lv2_run->lv2_handle[0]);
+	  recall_lv2_run->lv2_worker = NULL;
+
 	  cleanup(recall_lv2_run->lv2_handle[0]);
 	}
 
@@ -928,6 +939,10 @@ ags_recall_lv2_run_run_pre(AgsRecall *recall)
 
       /* cleanup */
       if(cleanup != NULL){
+	ags_lv2_worker_manager_remove_handle(ags_lv2_worker_manager_get_instance(),
+					     recall_lv2_run->lv2_handle[0]);
+	recall_lv2_run->lv2_worker = NULL;
+
 	cleanup(recall_lv2_run->lv2_handle[0]);
       }
 
@@ -1039,10 +1054,16 @@ ags_recall_lv2_run_run_pre(AgsRecall *recall)
   
   note = note_start;
 
+  lv2_worker = (AgsLv2Worker *) recall_lv2_run->lv2_worker;
+
   while(note != NULL){
+    ags_lv2_worker_deliver_response(lv2_worker);
+    
     run(recall_lv2_run->lv2_handle[0],
 	(uint32_t) buffer_size);
 
+    ags_lv2_worker_end_run(lv2_worker);
+    
     note = note->next;
   }
 
@@ -1101,6 +1122,7 @@ ags_recall_lv2_run_run_inter(AgsRecall *recall)
   AgsRecyclingContext *parent_recycling_context, *recycling_context;
 
   AgsLv2Plugin *lv2_plugin;
+  AgsLv2Worker *lv2_worker;
 
   GList *note_start, *note;
 
@@ -1229,6 +1251,10 @@ ags_recall_lv2_run_run_inter(AgsRecall *recall)
 
     /* cleanup */
     if(cleanup != NULL){
+      ags_lv2_worker_manager_remove_handle(ags_lv2_worker_manager_get_instance(),
+					   recall_lv2_run->lv2_handle[0]);
+      recall_lv2_run->lv2_worker = NULL;
+
       cleanup(recall_lv2_run->lv2_handle[0]);
     }
 
@@ -1261,8 +1287,14 @@ ags_recall_lv2_run_run_inter(AgsRecall *recall)
   }
   
   /* process data */
+  lv2_worker = (AgsLv2Worker *) recall_lv2_run->lv2_worker;
+
+  ags_lv2_worker_deliver_response(lv2_worker);
+
   run(recall_lv2_run->lv2_handle[0],
       (uint32_t) buffer_size);
+
+  ags_lv2_worker_end_run(lv2_worker);
   
   /* copy data */
   if(recall_lv2_run->output != NULL &&
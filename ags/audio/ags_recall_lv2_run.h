@@ -67,6 +67,7 @@ struct _AgsRecallLv2Run
   GList *note;
 
   GObject *worker_handle;
+  GObject *lv2_worker;
 };
 
 struct _AgsRecallLv2RunClass
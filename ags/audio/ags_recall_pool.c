@@ -0,0 +1,876 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/ags_recall_pool.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+void ags_recall_pool_class_init(AgsRecallPoolClass *recall_pool);
+void ags_recall_pool_init(AgsRecallPool *recall_pool);
+void ags_recall_pool_finalize(GObject *gobject);
+
+void ags_recall_pool_fresh_value_free(GValue *value);
+gboolean ags_recall_pool_fresh_value_equal(GParamSpec *param_spec,
+					   GValue *value, GValue *fresh_value);
+
+gpointer ags_recall_pool_refill_thread(gpointer data);
+
+/**
+ * SECTION:ags_recall_pool
+ * @short_description: pre-instanced recalls
+ * @title: AgsRecallPool
+ * @section_id:
+ * @include: ags/audio/ags_recall_pool.h
+ *
+ * #AgsRecallPool keeps freshly instantiated recalls of every #GType that
+ * was duplicated from a template. ags_recall_duplicate() takes the
+ * instance of the pool and only applies its properties, so starting
+ * playback doesn't pay the instance initialization of every recall.
+ *
+ * The pool learns the demand of each #GType during playback start and
+ * is refilled off the audio path by ags_recall_pool_refill_async(), which
+ * wakes a single long-lived worker. Targets shrink again as the demand
+ * drops and the total of ready instances is bounded.
+ */
+
+static gpointer ags_recall_pool_parent_class = NULL;
+
+AgsRecallPool *ags_recall_pool = NULL;
+
+GType
+ags_recall_pool_get_type (void)
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_recall_pool = 0;
+
+    static const GTypeInfo ags_recall_pool_info = {
+      sizeof (AgsRecallPoolClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_recall_pool_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof (AgsRecallPool),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_recall_pool_init,
+    };
+
+    ags_type_recall_pool = g_type_register_static(G_TYPE_OBJECT,
+						  "AgsRecallPool",
+						  &ags_recall_pool_info,
+						  0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_recall_pool);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_recall_pool_class_init(AgsRecallPoolClass *recall_pool)
+{
+  GObjectClass *gobject;
+
+  ags_recall_pool_parent_class = g_type_class_peek_parent(recall_pool);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) recall_pool;
+
+  gobject->finalize = ags_recall_pool_finalize;
+}
+
+void
+ags_recall_pool_init(AgsRecallPool *recall_pool)
+{
+  recall_pool->flags = 0;
+
+  /* recall pool mutex */
+  g_rec_mutex_init(&(recall_pool->obj_mutex));
+
+  recall_pool->generation = 0;
+
+  recall_pool->max_instances = AGS_RECALL_POOL_DEFAULT_MAX_INSTANCES;
+
+  recall_pool->max_total_instances = AGS_RECALL_POOL_DEFAULT_MAX_TOTAL_INSTANCES;
+  recall_pool->n_total_instances = 0;
+
+  recall_pool->recipe = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+					      NULL,
+					      (GDestroyNotify) ags_recall_pool_recipe_free);
+
+  /* refill worker */
+  recall_pool->refill_thread = NULL;
+
+  g_mutex_init(&(recall_pool->refill_mutex));
+  g_cond_init(&(recall_pool->refill_cond));
+}
+
+void
+ags_recall_pool_finalize(GObject *gobject)
+{
+  AgsRecallPool *recall_pool;
+
+  recall_pool = AGS_RECALL_POOL(gobject);
+
+  /* stop refill worker */
+  g_mutex_lock(&(recall_pool->refill_mutex));
+
+  recall_pool->flags |= AGS_RECALL_POOL_REFILL_TERMINATE;
+
+  g_cond_signal(&(recall_pool->refill_cond));
+
+  g_mutex_unlock(&(recall_pool->refill_mutex));
+
+  if(recall_pool->refill_thread != NULL){
+    g_thread_join(recall_pool->refill_thread);
+  }
+
+  g_mutex_clear(&(recall_pool->refill_mutex));
+  g_cond_clear(&(recall_pool->refill_cond));
+
+  g_hash_table_destroy(recall_pool->recipe);
+
+  if(recall_pool == ags_recall_pool){
+    ags_recall_pool = NULL;
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_recall_pool_parent_class)->finalize(gobject);
+}
+
+/**
+ * ags_recall_pool_recipe_alloc:
+ * @recall_type: the #GType
+ *
+ * Allocate #AgsRecallPoolRecipe-struct.
+ *
+ * Returns: the newly allocated #AgsRecallPoolRecipe-struct
+ *
+ * Since: 3.5.0
+ */
+AgsRecallPoolRecipe*
+ags_recall_pool_recipe_alloc(GType recall_type)
+{
+  AgsRecallPoolRecipe *recipe;
+
+  recipe = (AgsRecallPoolRecipe *) malloc(sizeof(AgsRecallPoolRecipe));
+
+  recipe->recall_type = recall_type;
+
+  recipe->target = 0;
+  recipe->demand = 0;
+  recipe->n_idle = 0;
+
+  recipe->n_instances = 0;
+  recipe->allocated_instances = 0;
+
+  recipe->instance = NULL;
+
+  recipe->hit = 0;
+  recipe->miss = 0;
+
+  recipe->fresh_value = g_hash_table_new_full(g_str_hash, g_str_equal,
+					      g_free,
+					      (GDestroyNotify) ags_recall_pool_fresh_value_free);
+
+  return(recipe);
+}
+
+/**
+ * ags_recall_pool_recipe_free:
+ * @recipe: the #AgsRecallPoolRecipe-struct
+ *
+ * Free @recipe and unref its ready instances.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_recall_pool_recipe_free(AgsRecallPoolRecipe *recipe)
+{
+  guint i;
+
+  if(recipe == NULL){
+    return;
+  }
+
+  for(i = 0; i < recipe->n_instances; i++){
+    g_object_unref(recipe->instance[i]);
+  }
+
+  free(recipe->instance);
+
+  g_hash_table_destroy(recipe->fresh_value);
+
+  free(recipe);
+}
+
+void
+ags_recall_pool_fresh_value_free(GValue *value)
+{
+  if(G_IS_VALUE(value)){
+    g_value_unset(value);
+  }
+
+  g_free(value);
+}
+
+gboolean
+ags_recall_pool_fresh_value_equal(GParamSpec *param_spec,
+				  GValue *value, GValue *fresh_value)
+{
+  if(!G_IS_VALUE(fresh_value) ||
+     G_VALUE_TYPE(value) != G_VALUE_TYPE(fresh_value)){
+    return(FALSE);
+  }
+
+  return(g_param_values_cmp(param_spec, value, fresh_value) == 0);
+}
+
+/**
+ * ags_recall_pool_find_recipe:
+ * @recall_pool: the #AgsRecallPool
+ * @recall_type: the #GType
+ *
+ * Find the recipe of @recall_type. The recipe is owned by @recall_pool,
+ * hold its mutex while reading it.
+ *
+ * Returns: (transfer none): the #AgsRecallPoolRecipe-struct or %NULL
+ *
+ * Since: 3.5.0
+ */
+AgsRecallPoolRecipe*
+ags_recall_pool_find_recipe(AgsRecallPool *recall_pool,
+			    GType recall_type)
+{
+  AgsRecallPoolRecipe *recipe;
+
+  GRecMutex *recall_pool_mutex;
+
+  if(!AGS_IS_RECALL_POOL(recall_pool)){
+    return(NULL);
+  }
+
+  recall_pool_mutex = AGS_RECALL_POOL_GET_OBJ_MUTEX(recall_pool);
+
+  g_rec_mutex_lock(recall_pool_mutex);
+
+  recipe = g_hash_table_lookup(recall_pool->recipe,
+			       GSIZE_TO_POINTER(recall_type));
+
+  g_rec_mutex_unlock(recall_pool_mutex);
+
+  return(recipe);
+}
+
+/**
+ * ags_recall_pool_prepare:
+ * @recall_pool: the #AgsRecallPool
+ * @recall_type: the #GType to pre-instance
+ * @n_instances: the number of instances to keep ready
+ *
+ * Keep at least @n_instances of @recall_type ready and instantiate the
+ * missing ones now, limited by the maximum instance count.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_recall_pool_prepare(AgsRecallPool *recall_pool,
+			GType recall_type,
+			guint n_instances)
+{
+  AgsRecallPoolRecipe *recipe;
+
+  GRecMutex *recall_pool_mutex;
+
+  if(!AGS_IS_RECALL_POOL(recall_pool) ||
+     !G_TYPE_IS_OBJECT(recall_type)){
+    return;
+  }
+
+  recall_pool_mutex = AGS_RECALL_POOL_GET_OBJ_MUTEX(recall_pool);
+
+  g_rec_mutex_lock(recall_pool_mutex);
+
+  recipe = g_hash_table_lookup(recall_pool->recipe,
+			       GSIZE_TO_POINTER(recall_type));
+
+  if(recipe == NULL){
+    recipe = ags_recall_pool_recipe_alloc(recall_type);
+
+    g_hash_table_insert(recall_pool->recipe,
+			GSIZE_TO_POINTER(recall_type),
+			recipe);
+  }
+
+  if(recipe->demand < n_instances){
+    recipe->demand = n_instances;
+  }
+
+  g_rec_mutex_unlock(recall_pool_mutex);
+
+  ags_recall_pool_refill(recall_pool);
+}
+
+/**
+ * ags_recall_pool_take:
+ * @recall_pool: the #AgsRecallPool
+ * @recall_type: the #GType to take
+ *
+ * Take a ready instance of @recall_type. The demand is recorded, so the
+ * next refill keeps enough instances for it.
+ *
+ * Returns: (transfer full): the #GObject or %NULL if none is ready
+ *
+ * Since: 3.5.0
+ */
+GObject*
+ags_recall_pool_take(AgsRecallPool *recall_pool,
+		     GType recall_type)
+{
+  AgsRecallPoolRecipe *recipe;
+
+  GObject *gobject;
+
+  GRecMutex *recall_pool_mutex;
+
+  if(!AGS_IS_RECALL_POOL(recall_pool)){
+    return(NULL);
+  }
+
+  recall_pool_mutex = AGS_RECALL_POOL_GET_OBJ_MUTEX(recall_pool);
+
+  gobject = NULL;
+
+  g_rec_mutex_lock(recall_pool_mutex);
+
+  recipe = g_hash_table_lookup(recall_pool->recipe,
+			       GSIZE_TO_POINTER(recall_type));
+
+  if(recipe == NULL){
+    recipe = ags_recall_pool_recipe_alloc(recall_type);
+
+    g_hash_table_insert(recall_pool->recipe,
+			GSIZE_TO_POINTER(recall_type),
+			recipe);
+  }
+
+  recipe->demand += 1;
+
+  if(recipe->n_instances > 0){
+    recipe->n_instances -= 1;
+
+    gobject = recipe->instance[recipe->n_instances];
+    recipe->instance[recipe->n_instances] = NULL;
+
+    recall_pool->n_total_instances -= 1;
+
+    recipe->hit += 1;
+  }else{
+    recipe->miss += 1;
+  }
+
+  g_rec_mutex_unlock(recall_pool_mutex);
+
+  return(gobject);
+}
+
+/**
+ * ags_recall_pool_apply_properties:
+ * @recall_pool: the #AgsRecallPool
+ * @gobject: the fresh #GObject taken of @recall_pool
+ * @n_params: the count of parameters
+ * @parameter_name: (array length=n_params): the parameter names
+ * @value: (array length=n_params): the values
+ *
+ * Apply the properties to an instance taken by ags_recall_pool_take().
+ * The values of a fresh instance are learned once per #GType, every
+ * property that wouldn't change isn't set.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_recall_pool_apply_properties(AgsRecallPool *recall_pool,
+				 GObject *gobject,
+				 guint n_params, gchar **parameter_name, GValue *value)
+{
+  AgsRecallPoolRecipe *recipe;
+
+  GObjectClass *gobject_class;
+
+  gboolean *skip;
+
+  guint generation;
+  guint i;
+
+  GRecMutex *recall_pool_mutex;
+
+  if(!AGS_IS_RECALL_POOL(recall_pool) ||
+     !G_IS_OBJECT(gobject) ||
+     n_params == 0){
+    return;
+  }
+
+  recall_pool_mutex = AGS_RECALL_POOL_GET_OBJ_MUTEX(recall_pool);
+
+  g_rec_mutex_lock(recall_pool_mutex);
+
+  recipe = g_hash_table_lookup(recall_pool->recipe,
+			       GSIZE_TO_POINTER(G_OBJECT_TYPE(gobject)));
+
+  generation = recall_pool->generation;
+  
+  g_rec_mutex_unlock(recall_pool_mutex);
+
+  gobject_class = G_OBJECT_GET_CLASS(gobject);
+
+  skip = (gboolean *) malloc(n_params * sizeof(gboolean));
+
+  /* compare to fresh values before anything is set */
+  for(i = 0; i < n_params; i++){
+    GParamSpec *param_spec;
+    GValue *fresh_value;
+
+    gboolean is_learned;
+    
+    skip[i] = FALSE;
+
+    param_spec = g_object_class_find_property(gobject_class,
+					      parameter_name[i]);
+
+    if(recipe == NULL ||
+       param_spec == NULL){
+      continue;
+    }
+
+    /* fresh values are freed by ags_recall_pool_clear(), so compare with the mutex held */
+    g_rec_mutex_lock(recall_pool_mutex);
+
+    fresh_value = g_hash_table_lookup(recipe->fresh_value,
+				      parameter_name[i]);
+
+    if(fresh_value != NULL){
+      skip[i] = ags_recall_pool_fresh_value_equal(param_spec,
+						  &(value[i]), fresh_value);
+    }
+    
+    g_rec_mutex_unlock(recall_pool_mutex);
+
+    if(fresh_value != NULL){
+      continue;
+    }
+    
+    /* learn */
+    fresh_value = g_new0(GValue,
+			 1);
+
+    /* pointer getters might return copies, so they are always set */
+    if((G_PARAM_READABLE & (param_spec->flags)) != 0 &&
+       !G_IS_PARAM_SPEC_POINTER(param_spec)){
+      g_value_init(fresh_value,
+		   param_spec->value_type);
+      g_object_get_property(gobject,
+			    parameter_name[i], fresh_value);
+    }
+
+    is_learned = FALSE;
+    
+    g_rec_mutex_lock(recall_pool_mutex);
+
+    /* if cleared meanwhile, the instance might be of the former presets */
+    if(generation == recall_pool->generation &&
+       !g_hash_table_contains(recipe->fresh_value,
+			      parameter_name[i])){
+      g_hash_table_insert(recipe->fresh_value,
+			  g_strdup(parameter_name[i]),
+			  fresh_value);
+
+      is_learned = TRUE;
+    }
+
+    skip[i] = ags_recall_pool_fresh_value_equal(param_spec,
+						&(value[i]), fresh_value);
+    
+    g_rec_mutex_unlock(recall_pool_mutex);
+
+    if(!is_learned){
+      ags_recall_pool_fresh_value_free(fresh_value);
+    }
+  }
+
+  /* set changed properties */
+  g_object_freeze_notify(gobject);
+
+  for(i = 0; i < n_params; i++){
+    if(!skip[i]){
+      g_object_set_property(gobject,
+			    parameter_name[i], &(value[i]));
+    }
+  }
+
+  g_object_thaw_notify(gobject);
+
+  free(skip);
+}
+
+/**
+ * ags_recall_pool_refill:
+ * @recall_pool: the #AgsRecallPool
+ *
+ * Instantiate the missing recalls of every recipe. The target of each
+ * recipe follows the demand since last refill, it grows at once and
+ * shrinks by half of the difference. A recipe without demand for
+ * %AGS_RECALL_POOL_DEFAULT_IDLE_REFILLS refills halves its target. The
+ * excess instances are released and the total of ready instances is
+ * limited by the maximum total instance count. The pool isn't locked
+ * during instantiation.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_recall_pool_refill(AgsRecallPool *recall_pool)
+{
+  AgsRecallPoolRecipe *recipe;
+
+  GHashTableIter iter;
+
+  GList *start_excess;
+
+  GType *recall_type;
+  guint *n_missing;
+
+  gpointer key, value;
+
+  guint generation;
+  guint n_recipes;
+  guint i, j;
+
+  GRecMutex *recall_pool_mutex;
+
+  if(!AGS_IS_RECALL_POOL(recall_pool)){
+    return;
+  }
+
+  recall_pool_mutex = AGS_RECALL_POOL_GET_OBJ_MUTEX(recall_pool);
+
+  start_excess = NULL;
+
+  /* update targets and collect missing instances */
+  g_rec_mutex_lock(recall_pool_mutex);
+
+  generation = recall_pool->generation;
+
+  n_recipes = g_hash_table_size(recall_pool->recipe);
+
+  recall_type = (GType *) malloc((n_recipes + 1) * sizeof(GType));
+  n_missing = (guint *) malloc((n_recipes + 1) * sizeof(guint));
+
+  i = 0;
+
+  g_hash_table_iter_init(&iter,
+			 recall_pool->recipe);
+
+  while(g_hash_table_iter_next(&iter, &key, &value)){
+    recipe = (AgsRecallPoolRecipe *) value;
+
+    if(recipe->demand >= recipe->target){
+      recipe->target = recipe->demand;
+
+      recipe->n_idle = 0;
+    }else if(recipe->demand > 0){
+      recipe->target = recipe->demand + ((recipe->target - recipe->demand) / 2);
+
+      recipe->n_idle = 0;
+    }else{
+      recipe->n_idle += 1;
+
+      if(recipe->n_idle >= AGS_RECALL_POOL_DEFAULT_IDLE_REFILLS){
+	recipe->target /= 2;
+
+	recipe->n_idle = 0;
+      }
+    }
+
+    if(recipe->target > recall_pool->max_instances){
+      recipe->target = recall_pool->max_instances;
+    }
+
+    recipe->demand = 0;
+
+    /* release excess */
+    while(recipe->n_instances > recipe->target){
+      recipe->n_instances -= 1;
+
+      start_excess = g_list_prepend(start_excess,
+				    recipe->instance[recipe->n_instances]);
+
+      recipe->instance[recipe->n_instances] = NULL;
+
+      recall_pool->n_total_instances -= 1;
+    }
+
+    if(recipe->n_instances < recipe->target){
+      recall_type[i] = recipe->recall_type;
+      n_missing[i] = recipe->target - recipe->n_instances;
+
+      i++;
+    }
+  }
+
+  n_recipes = i;
+
+  g_rec_mutex_unlock(recall_pool_mutex);
+
+  g_list_free_full(start_excess,
+		   g_object_unref);
+
+  /* instantiate */
+  for(i = 0; i < n_recipes; i++){
+    for(j = 0; j < n_missing[i]; j++){
+      GObject *gobject;
+
+      gboolean success;
+
+      gobject = g_object_new(recall_type[i],
+			     NULL);
+
+      success = FALSE;
+
+      g_rec_mutex_lock(recall_pool_mutex);
+
+      recipe = g_hash_table_lookup(recall_pool->recipe,
+				   GSIZE_TO_POINTER(recall_type[i]));
+
+      /* discard instances created before ags_recall_pool_clear() */
+      if(recipe != NULL &&
+	 generation == recall_pool->generation &&
+	 recipe->n_instances < recipe->target &&
+	 recall_pool->n_total_instances < recall_pool->max_total_instances){
+	if(recipe->n_instances == recipe->allocated_instances){
+	  recipe->allocated_instances = (recipe->allocated_instances == 0) ? 8: 2 * recipe->allocated_instances;
+
+	  if(recipe->allocated_instances > recall_pool->max_instances){
+	    recipe->allocated_instances = recall_pool->max_instances;
+	  }
+
+	  recipe->instance = (GObject **) realloc(recipe->instance,
+						  recipe->allocated_instances * sizeof(GObject *));
+	}
+
+	recipe->instance[recipe->n_instances] = gobject;
+	recipe->n_instances += 1;
+
+	recall_pool->n_total_instances += 1;
+
+	success = TRUE;
+      }
+
+      g_rec_mutex_unlock(recall_pool_mutex);
+
+      if(!success){
+	g_object_unref(gobject);
+
+	break;
+      }
+    }
+  }
+
+  free(recall_type);
+  free(n_missing);
+}
+
+gpointer
+ags_recall_pool_refill_thread(gpointer data)
+{
+  AgsRecallPool *recall_pool;
+
+  recall_pool = (AgsRecallPool *) data;
+
+  g_mutex_lock(&(recall_pool->refill_mutex));
+
+  while((AGS_RECALL_POOL_REFILL_TERMINATE & (recall_pool->flags)) == 0){
+    if((AGS_RECALL_POOL_REFILL_REQUESTED & (recall_pool->flags)) == 0){
+      g_cond_wait(&(recall_pool->refill_cond),
+		  &(recall_pool->refill_mutex));
+
+      continue;
+    }
+
+    recall_pool->flags &= (~AGS_RECALL_POOL_REFILL_REQUESTED);
+
+    g_mutex_unlock(&(recall_pool->refill_mutex));
+
+    ags_recall_pool_refill(recall_pool);
+
+    g_mutex_lock(&(recall_pool->refill_mutex));
+  }
+
+  recall_pool->flags &= (~AGS_RECALL_POOL_REFILL_RUNNING);
+
+  g_mutex_unlock(&(recall_pool->refill_mutex));
+
+  return(NULL);
+}
+
+/**
+ * ags_recall_pool_refill_async:
+ * @recall_pool: the #AgsRecallPool
+ *
+ * Request a refill of @recall_pool by its worker thread. The worker is
+ * started by the first request and lives as long as @recall_pool.
+ * Requests during a running refill are coalesced.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_recall_pool_refill_async(AgsRecallPool *recall_pool)
+{
+  if(!AGS_IS_RECALL_POOL(recall_pool)){
+    return;
+  }
+
+  g_mutex_lock(&(recall_pool->refill_mutex));
+
+  if((AGS_RECALL_POOL_REFILL_TERMINATE & (recall_pool->flags)) == 0){
+    recall_pool->flags |= AGS_RECALL_POOL_REFILL_REQUESTED;
+
+    if(recall_pool->refill_thread == NULL){
+      recall_pool->flags |= AGS_RECALL_POOL_REFILL_RUNNING;
+
+      recall_pool->refill_thread = g_thread_new("Advanced Gtk+ Sequencer - recall pool",
+						ags_recall_pool_refill_thread,
+						recall_pool);
+    }else{
+      g_cond_signal(&(recall_pool->refill_cond));
+    }
+  }
+
+  g_mutex_unlock(&(recall_pool->refill_mutex));
+}
+
+/**
+ * ags_recall_pool_clear:
+ * @recall_pool: the #AgsRecallPool
+ *
+ * Drop every ready instance of @recall_pool and forget the learned
+ * fresh values, for example after the presets changed. The learned
+ * targets are kept.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_recall_pool_clear(AgsRecallPool *recall_pool)
+{
+  AgsRecallPoolRecipe *recipe;
+
+  GHashTableIter iter;
+
+  GList *start_list;
+
+  gpointer key, value;
+
+  guint i;
+
+  GRecMutex *recall_pool_mutex;
+
+  if(!AGS_IS_RECALL_POOL(recall_pool)){
+    return;
+  }
+
+  recall_pool_mutex = AGS_RECALL_POOL_GET_OBJ_MUTEX(recall_pool);
+
+  start_list = NULL;
+
+  g_rec_mutex_lock(recall_pool_mutex);
+
+  recall_pool->generation += 1;
+
+  g_hash_table_iter_init(&iter,
+			 recall_pool->recipe);
+
+  while(g_hash_table_iter_next(&iter, &key, &value)){
+    recipe = (AgsRecallPoolRecipe *) value;
+
+    for(i = 0; i < recipe->n_instances; i++){
+      start_list = g_list_prepend(start_list,
+				  recipe->instance[i]);
+
+      recipe->instance[i] = NULL;
+    }
+
+    recipe->n_instances = 0;
+
+    /* fresh values depend on the former presets, learn them again */
+    g_hash_table_remove_all(recipe->fresh_value);
+  }
+
+  recall_pool->n_total_instances = 0;
+
+  g_rec_mutex_unlock(recall_pool_mutex);
+
+  g_list_free_full(start_list,
+		   g_object_unref);
+}
+
+/**
+ * ags_recall_pool_get_instance:
+ *
+ * Get instance.
+ *
+ * Returns: (transfer none): the #AgsRecallPool
+ *
+ * Since: 3.5.0
+ */
+AgsRecallPool*
+ags_recall_pool_get_instance()
+{
+  static GMutex mutex;
+
+  g_mutex_lock(&mutex);
+
+  if(ags_recall_pool == NULL){
+    ags_recall_pool = ags_recall_pool_new();
+  }
+
+  g_mutex_unlock(&mutex);
+
+  return(ags_recall_pool);
+}
+
+/**
+ * ags_recall_pool_new:
+ *
+ * Create a new instance of #AgsRecallPool
+ *
+ * Returns: the new #AgsRecallPool
+ *
+ * Since: 3.5.0
+ */
+AgsRecallPool*
+ags_recall_pool_new()
+{
+  AgsRecallPool *recall_pool;
+
+  recall_pool = (AgsRecallPool *) g_object_new(AGS_TYPE_RECALL_POOL,
+					       NULL);
+
+  return(recall_pool);
+}
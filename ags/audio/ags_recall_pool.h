@@ -0,0 +1,155 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_RECALL_POOL_H__
+#define __AGS_RECALL_POOL_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_RECALL_POOL                (ags_recall_pool_get_type())
+#define AGS_RECALL_POOL(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_RECALL_POOL, AgsRecallPool))
+#define AGS_RECALL_POOL_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_RECALL_POOL, AgsRecallPoolClass))
+#define AGS_IS_RECALL_POOL(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_RECALL_POOL))
+#define AGS_IS_RECALL_POOL_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_RECALL_POOL))
+#define AGS_RECALL_POOL_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_RECALL_POOL, AgsRecallPoolClass))
+
+#define AGS_RECALL_POOL_GET_OBJ_MUTEX(obj) (&(((AgsRecallPool *) obj)->obj_mutex))
+
+#define AGS_RECALL_POOL_RECIPE(ptr) ((AgsRecallPoolRecipe *)(ptr))
+
+#define AGS_RECALL_POOL_DEFAULT_MAX_INSTANCES (256)
+#define AGS_RECALL_POOL_DEFAULT_MAX_TOTAL_INSTANCES (4096)
+#define AGS_RECALL_POOL_DEFAULT_IDLE_REFILLS (4)
+
+typedef struct _AgsRecallPool AgsRecallPool;
+typedef struct _AgsRecallPoolClass AgsRecallPoolClass;
+typedef struct _AgsRecallPoolRecipe AgsRecallPoolRecipe;
+
+/**
+ * AgsRecallPoolFlags:
+ * @AGS_RECALL_POOL_REFILL_RUNNING: the refill worker is running
+ * @AGS_RECALL_POOL_REFILL_REQUESTED: the refill worker has to refill
+ * @AGS_RECALL_POOL_REFILL_TERMINATE: the refill worker has to exit
+ *
+ * Enum values to control the behavior or indicate internal state of #AgsRecallPool by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_RECALL_POOL_REFILL_RUNNING        = 1,
+  AGS_RECALL_POOL_REFILL_REQUESTED      = 1 <<  1,
+  AGS_RECALL_POOL_REFILL_TERMINATE      = 1 <<  2,
+}AgsRecallPoolFlags;
+
+/**
+ * AgsRecallPoolRecipe:
+ * @recall_type: the #GType to instantiate
+ * @target: the number of instances to keep ready
+ * @demand: the instances taken since last refill
+ * @n_idle: the refills without any demand
+ * @n_instances: the number of ready instances
+ * @allocated_instances: the allocated size of @instance
+ * @instance: the ready instances
+ * @hit: the count of takes served by the pool
+ * @miss: the count of takes the pool couldn't serve
+ * @fresh_value: the property values of a fresh instance by name
+ *
+ * #AgsRecallPoolRecipe holds the pre-instanced recalls of one #GType.
+ */
+struct _AgsRecallPoolRecipe
+{
+  GType recall_type;
+
+  guint target;
+  guint demand;
+  guint n_idle;
+
+  guint n_instances;
+  guint allocated_instances;
+
+  GObject **instance;
+
+  guint64 hit;
+  guint64 miss;
+
+  GHashTable *fresh_value;
+};
+
+struct _AgsRecallPool
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  guint generation;
+
+  guint max_instances;
+
+  guint max_total_instances;
+  guint n_total_instances;
+
+  GHashTable *recipe;
+
+  GThread *refill_thread;
+
+  GMutex refill_mutex;
+  GCond refill_cond;
+};
+
+struct _AgsRecallPoolClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_recall_pool_get_type(void);
+
+AgsRecallPoolRecipe* ags_recall_pool_recipe_alloc(GType recall_type);
+void ags_recall_pool_recipe_free(AgsRecallPoolRecipe *recipe);
+
+AgsRecallPoolRecipe* ags_recall_pool_find_recipe(AgsRecallPool *recall_pool,
+						 GType recall_type);
+
+void ags_recall_pool_prepare(AgsRecallPool *recall_pool,
+			     GType recall_type,
+			     guint n_instances);
+
+GObject* ags_recall_pool_take(AgsRecallPool *recall_pool,
+			      GType recall_type);
+
+void ags_recall_pool_apply_properties(AgsRecallPool *recall_pool,
+				      GObject *gobject,
+				      guint n_params, gchar **parameter_name, GValue *value);
+
+void ags_recall_pool_refill(AgsRecallPool *recall_pool);
+void ags_recall_pool_refill_async(AgsRecallPool *recall_pool);
+
+void ags_recall_pool_clear(AgsRecallPool *recall_pool);
+
+AgsRecallPool* ags_recall_pool_get_instance();
+AgsRecallPool* ags_recall_pool_new();
+
+G_END_DECLS
+
+#endif /*__AGS_RECALL_POOL_H__*/
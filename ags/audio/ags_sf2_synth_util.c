@@ -22,7 +22,7 @@
 #include <ags/audio/ags_synth_enums.h>
 #include <ags/audio/ags_audio_signal.h>
 #include <ags/audio/ags_audio_buffer_util.h>
-#include <ags/audio/ags_filter_util.h>
+#include <ags/audio/ags_pitch_util.h>
 
 #include <ags/audio/file/ags_sound_container.h>
 #include <ags/audio/file/ags_sound_resource.h>
@@ -246,19 +246,19 @@ ags_sf2_synth_util_copy_s8(gint8 *buffer,
 			   guint loop_mode,
 			   gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gint8 *im_buffer;
+  void *data;
 
   gint midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -266,15 +266,25 @@ ags_sf2_synth_util_copy_s8(gint8 *buffer,
   guint l;
   gboolean pong_copy;
 
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
   
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_ipatch_sample_get_data(ipatch_sample,
+				 0,
+				 &data,
+				 &source_frame_count,
+				 &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
 				 NULL,
@@ -282,58 +292,7 @@ ags_sf2_synth_util_copy_s8(gint8 *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_8_BIT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S8,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -355,12 +314,16 @@ ags_sf2_synth_util_copy_s8(gint8 *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_s8(im_buffer,
-			   frame_count,
-			   samplerate,
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
 			   base_key,
 			   tuning);
 
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
+
   pong_copy = FALSE;
   
   for(i = 0, j = 0, k = 0, l = 0; i < offset + n_frames;){
@@ -454,15 +417,14 @@ ags_sf2_synth_util_copy_s8(gint8 *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_s8_to_s8(buffer + l, 1,
-					    im_buffer + k, 1,
-					    copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_s8(buffer + l, 1,
-				      im_buffer + k, 1,
-				      copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_S8);
     }
 
     if(success){
@@ -506,9 +468,6 @@ ags_sf2_synth_util_copy_s8(gint8 *buffer,
       }
     }
   }
-  
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -540,19 +499,19 @@ ags_sf2_synth_util_copy_s16(gint16 *buffer,
 			    guint loop_mode,
 			    gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gint16 *im_buffer;
+  void *data;
 
   gint midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -560,15 +519,25 @@ ags_sf2_synth_util_copy_s16(gint16 *buffer,
   guint l;
   gboolean pong_copy;
 
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
   
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_ipatch_sample_get_data(ipatch_sample,
+				 0,
+				 &data,
+				 &source_frame_count,
+				 &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
 				 NULL,
@@ -576,58 +545,7 @@ ags_sf2_synth_util_copy_s16(gint16 *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
-  
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_16_BIT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S16,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -649,11 +567,15 @@ ags_sf2_synth_util_copy_s16(gint16 *buffer,
 
   tuning = 100.0 * (note - base_key);
 
-  ags_filter_util_pitch_s16(im_buffer,
-			    frame_count,
-			    samplerate,
-			    base_key,
-			    tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -748,15 +670,14 @@ ags_sf2_synth_util_copy_s16(gint16 *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_s16_to_s16(buffer + l, 1,
-					      im_buffer + k, 1,
-					      copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_s16(buffer + l, 1,
-				       im_buffer + k, 1,
-				       copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_S16);
     }
 
     if(success){
@@ -800,9 +721,6 @@ ags_sf2_synth_util_copy_s16(gint16 *buffer,
       }
     }
   }
-  
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -834,19 +752,19 @@ ags_sf2_synth_util_copy_s24(gint32 *buffer,
 			    guint loop_mode,
 			    gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gint32 *im_buffer;
+  void *data;
 
   gint midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -854,15 +772,25 @@ ags_sf2_synth_util_copy_s24(gint32 *buffer,
   guint l;
   gboolean pong_copy;
   
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
 
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_ipatch_sample_get_data(ipatch_sample,
+				 0,
+				 &data,
+				 &source_frame_count,
+				 &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
 				 NULL,
@@ -870,58 +798,7 @@ ags_sf2_synth_util_copy_s24(gint32 *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_24_BIT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S24,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -943,11 +820,15 @@ ags_sf2_synth_util_copy_s24(gint32 *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_s24(im_buffer,
-			    frame_count,
-			    samplerate,
-			    base_key,
-			    tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -1042,15 +923,14 @@ ags_sf2_synth_util_copy_s24(gint32 *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_s24_to_s24(buffer + l, 1,
-					      im_buffer + k, 1,
-					      copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_s24(buffer + l, 1,
-				       im_buffer + k, 1,
-				       copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_S24);
     }
 
     if(success){
@@ -1094,9 +974,6 @@ ags_sf2_synth_util_copy_s24(gint32 *buffer,
       }
     }
   }
-  
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -1128,19 +1005,19 @@ ags_sf2_synth_util_copy_s32(gint32 *buffer,
 			    guint loop_mode,
 			    gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gint32 *im_buffer;
+  void *data;
 
   gint midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -1148,15 +1025,25 @@ ags_sf2_synth_util_copy_s32(gint32 *buffer,
   guint l;
   gboolean pong_copy;
   
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
 
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_ipatch_sample_get_data(ipatch_sample,
+				 0,
+				 &data,
+				 &source_frame_count,
+				 &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
 				 NULL,
@@ -1164,58 +1051,7 @@ ags_sf2_synth_util_copy_s32(gint32 *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_32_BIT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S32,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -1237,11 +1073,15 @@ ags_sf2_synth_util_copy_s32(gint32 *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_s32(im_buffer,
-			    frame_count,
-			    samplerate,
-			    base_key,
-			    tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -1336,15 +1176,14 @@ ags_sf2_synth_util_copy_s32(gint32 *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_s32_to_s32(buffer + l, 1,
-					      im_buffer + k, 1,
-					      copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_s32(buffer + l, 1,
-				       im_buffer + k, 1,
-				       copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_S32);
     }
 
     if(success){
@@ -1388,9 +1227,6 @@ ags_sf2_synth_util_copy_s32(gint32 *buffer,
       }
     }
   }
-
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -1422,19 +1258,19 @@ ags_sf2_synth_util_copy_s64(gint64 *buffer,
 			    guint loop_mode,
 			    gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gint64 *im_buffer;
+  void *data;
 
   gint midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -1442,15 +1278,25 @@ ags_sf2_synth_util_copy_s64(gint64 *buffer,
   guint l;
   gboolean pong_copy;
   
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
 
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_ipatch_sample_get_data(ipatch_sample,
+				 0,
+				 &data,
+				 &source_frame_count,
+				 &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
 				 NULL,
@@ -1458,58 +1304,7 @@ ags_sf2_synth_util_copy_s64(gint64 *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_64_BIT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S64,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -1531,11 +1326,15 @@ ags_sf2_synth_util_copy_s64(gint64 *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_s64(im_buffer,
-			    frame_count,
-			    samplerate,
-			    base_key,
-			    tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -1630,15 +1429,14 @@ ags_sf2_synth_util_copy_s64(gint64 *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_s64_to_s64(buffer + l, 1,
-					      im_buffer + k, 1,
-					      copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_s64(buffer + l, 1,
-				       im_buffer + k, 1,
-				       copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_S64);
     }
 
     if(success){
@@ -1682,9 +1480,6 @@ ags_sf2_synth_util_copy_s64(gint64 *buffer,
       }
     }
   }
-
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -1716,19 +1511,19 @@ ags_sf2_synth_util_copy_float(gfloat *buffer,
 			      guint loop_mode,
 			      gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gfloat *im_buffer;
+  void *data;
 
   gint midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -1736,15 +1531,25 @@ ags_sf2_synth_util_copy_float(gfloat *buffer,
   guint l;
   gboolean pong_copy;
   
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
 
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_ipatch_sample_get_data(ipatch_sample,
+				 0,
+				 &data,
+				 &source_frame_count,
+				 &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
 				 NULL,
@@ -1752,58 +1557,7 @@ ags_sf2_synth_util_copy_float(gfloat *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_FLOAT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_FLOAT,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -1825,11 +1579,15 @@ ags_sf2_synth_util_copy_float(gfloat *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_float(im_buffer,
-			      frame_count,
-			      samplerate,
-			      base_key,
-			      tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -1924,15 +1682,14 @@ ags_sf2_synth_util_copy_float(gfloat *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_float_to_float(buffer + l, 1,
-						  im_buffer + k, 1,
-						  copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_float(buffer + l, 1,
-					 im_buffer + k, 1,
-					 copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_FLOAT);
     }
 
     if(success){
@@ -1976,9 +1733,6 @@ ags_sf2_synth_util_copy_float(gfloat *buffer,
       }
     }
   }
-  
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -2010,19 +1764,19 @@ ags_sf2_synth_util_copy_double(gdouble *buffer,
 			       guint loop_mode,
 			       gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gdouble *im_buffer;
+  void *data;
 
   gint midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -2030,15 +1784,25 @@ ags_sf2_synth_util_copy_double(gdouble *buffer,
   guint l;
   gboolean pong_copy;
   
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
 
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_ipatch_sample_get_data(ipatch_sample,
+				 0,
+				 &data,
+				 &source_frame_count,
+				 &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
 				 NULL,
@@ -2046,58 +1810,7 @@ ags_sf2_synth_util_copy_double(gdouble *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_DOUBLE);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_DOUBLE,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -2119,11 +1832,15 @@ ags_sf2_synth_util_copy_double(gdouble *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_double(im_buffer,
-			       frame_count,
-			       samplerate,
-			       base_key,
-			       tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -2218,15 +1935,14 @@ ags_sf2_synth_util_copy_double(gdouble *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_double_to_double(buffer + l, 1,
-						    im_buffer + k, 1,
-						    copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_double(buffer + l, 1,
-					  im_buffer + k, 1,
-					  copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_DOUBLE);
     }
 
     if(success){
@@ -2270,9 +1986,6 @@ ags_sf2_synth_util_copy_double(gdouble *buffer,
       }
     }
   }
-  
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -2304,19 +2017,19 @@ ags_sf2_synth_util_copy_complex(AgsComplex *buffer,
 				guint loop_mode,
 				gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  AgsComplex *im_buffer;
+  void *data;
 
   gint midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -2324,15 +2037,25 @@ ags_sf2_synth_util_copy_complex(AgsComplex *buffer,
   guint l;
   gboolean pong_copy;
   
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
 
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_ipatch_sample_get_data(ipatch_sample,
+				 0,
+				 &data,
+				 &source_frame_count,
+				 &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
 				 NULL,
@@ -2340,58 +2063,7 @@ ags_sf2_synth_util_copy_complex(AgsComplex *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_COMPLEX);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_COMPLEX,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -2413,11 +2085,15 @@ ags_sf2_synth_util_copy_complex(AgsComplex *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_complex(im_buffer,
-				frame_count,
-				samplerate,
-				base_key,
-				tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -2512,15 +2188,14 @@ ags_sf2_synth_util_copy_complex(AgsComplex *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_complex_to_complex(buffer + l, 1,
-						      im_buffer + k, 1,
-						      copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_complex(buffer + l, 1,
-					   im_buffer + k, 1,
-					   copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_COMPLEX);
     }
 
     if(success){
@@ -2564,9 +2239,6 @@ ags_sf2_synth_util_copy_complex(AgsComplex *buffer,
       }
     }
   }
-
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
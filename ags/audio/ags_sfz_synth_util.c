@@ -23,7 +23,7 @@
 #include <ags/audio/ags_audio_signal.h>
 #include <ags/audio/ags_audio_buffer_util.h>
 #include <ags/audio/ags_diatonic_scale.h>
-#include <ags/audio/ags_filter_util.h>
+#include <ags/audio/ags_pitch_util.h>
 
 #include <ags/audio/file/ags_sound_container.h>
 #include <ags/audio/file/ags_sound_resource.h>
@@ -81,19 +81,19 @@ ags_sfz_synth_util_copy_s8(gint8 *buffer,
   gchar *group_key;
   gchar *region_key;
 
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gint8 *im_buffer;
+  void *data;
 
   gint midi_key, current_midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -101,15 +101,25 @@ ags_sfz_synth_util_copy_s8(gint8 *buffer,
   guint l;
   gboolean pong_copy;
 
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
   
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_sfz_sample_get_data(sfz_sample,
+			      &data,
+			      &data_audio_channels,
+			      &source_frame_count,
+			      &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
 				 NULL,
@@ -117,59 +127,8 @@ ags_sfz_synth_util_copy_s8(gint8 *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					sfz_sample->format);
-  
-  sfz_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-  
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+  pitch_util = ags_pitch_util_get_default();
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_8_BIT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S8,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
-  
   /* pitch */
   midi_key = 60;
 
@@ -217,12 +176,16 @@ ags_sfz_synth_util_copy_s8(gint8 *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_s8(im_buffer,
-			   frame_count,
-			   samplerate,
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
 			   base_key,
 			   tuning);
 
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
+
   pong_copy = FALSE;
   
   for(i = 0, j = 0, k = 0, l = 0; i < offset + n_frames;){
@@ -316,15 +279,14 @@ ags_sfz_synth_util_copy_s8(gint8 *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_s8_to_s8(buffer + l, 1,
-					    im_buffer + k, 1,
-					    copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_s8(buffer + l, 1,
-				      im_buffer + k, 1,
-				      copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_S8);
     }
 
     if(success){
@@ -368,9 +330,6 @@ ags_sfz_synth_util_copy_s8(gint8 *buffer,
       }
     }
   }
-  
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -404,19 +363,19 @@ ags_sfz_synth_util_copy_s16(gint16 *buffer,
 {
   gchar *group_key, *region_key;
 
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gint16 *im_buffer;
+  void *data;
 
   gint midi_key, current_midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -424,15 +383,25 @@ ags_sfz_synth_util_copy_s16(gint16 *buffer,
   guint l;
   gboolean pong_copy;
 
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
   
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_sfz_sample_get_data(sfz_sample,
+			      &data,
+			      &data_audio_channels,
+			      &source_frame_count,
+			      &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
 				 NULL,
@@ -440,58 +409,7 @@ ags_sfz_synth_util_copy_s16(gint16 *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					   sfz_sample->format);
-  
-  sfz_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_16_BIT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S16,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -540,11 +458,15 @@ ags_sfz_synth_util_copy_s16(gint16 *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_s16(im_buffer,
-			    frame_count,
-			    samplerate,
-			    base_key,
-			    tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -639,15 +561,14 @@ ags_sfz_synth_util_copy_s16(gint16 *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_s16_to_s16(buffer + l, 1,
-					      im_buffer + k, 1,
-					      copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_s16(buffer + l, 1,
-				       im_buffer + k, 1,
-				       copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_S16);
     }
 
     if(success){
@@ -691,9 +612,6 @@ ags_sfz_synth_util_copy_s16(gint16 *buffer,
       }
     }
   }
-  
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -727,19 +645,19 @@ ags_sfz_synth_util_copy_s24(gint32 *buffer,
 {
   gchar *group_key, *region_key;
 
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gint32 *im_buffer;
+  void *data;
 
   gint midi_key, current_midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -747,15 +665,25 @@ ags_sfz_synth_util_copy_s24(gint32 *buffer,
   guint l;
   gboolean pong_copy;
 
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
   
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_sfz_sample_get_data(sfz_sample,
+			      &data,
+			      &data_audio_channels,
+			      &source_frame_count,
+			      &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
 				 NULL,
@@ -763,58 +691,7 @@ ags_sfz_synth_util_copy_s24(gint32 *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					   sfz_sample->format);
-  
-  sfz_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_24_BIT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S24,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -863,11 +740,15 @@ ags_sfz_synth_util_copy_s24(gint32 *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_s24(im_buffer,
-			    frame_count,
-			    samplerate,
-			    base_key,
-			    tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -962,15 +843,14 @@ ags_sfz_synth_util_copy_s24(gint32 *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_s24_to_s24(buffer + l, 1,
-					      im_buffer + k, 1,
-					      copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_s24(buffer + l, 1,
-				       im_buffer + k, 1,
-				       copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_S24);
     }
 
     if(success){
@@ -1014,9 +894,6 @@ ags_sfz_synth_util_copy_s24(gint32 *buffer,
       }
     }
   }
-  
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -1050,19 +927,19 @@ ags_sfz_synth_util_copy_s32(gint32 *buffer,
 {
   gchar *group_key, *region_key;
 
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gint32 *im_buffer;
+  void *data;
 
   gint midi_key, current_midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -1070,15 +947,25 @@ ags_sfz_synth_util_copy_s32(gint32 *buffer,
   guint l;
   gboolean pong_copy;
   
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
 
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_sfz_sample_get_data(sfz_sample,
+			      &data,
+			      &data_audio_channels,
+			      &source_frame_count,
+			      &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
 				 NULL,
@@ -1086,58 +973,7 @@ ags_sfz_synth_util_copy_s32(gint32 *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					   sfz_sample->format);
-  
-  sfz_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_32_BIT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S32,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -1186,11 +1022,15 @@ ags_sfz_synth_util_copy_s32(gint32 *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_s32(im_buffer,
-			    frame_count,
-			    samplerate,
-			    base_key,
-			    tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -1285,15 +1125,14 @@ ags_sfz_synth_util_copy_s32(gint32 *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_s32_to_s32(buffer + l, 1,
-					      im_buffer + k, 1,
-					      copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_s32(buffer + l, 1,
-				       im_buffer + k, 1,
-				       copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_S32);
     }
 
     if(success){
@@ -1337,9 +1176,6 @@ ags_sfz_synth_util_copy_s32(gint32 *buffer,
       }
     }
   }
-
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -1373,19 +1209,19 @@ ags_sfz_synth_util_copy_s64(gint64 *buffer,
 {
   gchar *group_key, *region_key;
 
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gint64 *im_buffer;
+  void *data;
 
   gint midi_key, current_midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -1393,15 +1229,25 @@ ags_sfz_synth_util_copy_s64(gint64 *buffer,
   guint l;
   gboolean pong_copy;
 
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
   
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_sfz_sample_get_data(sfz_sample,
+			      &data,
+			      &data_audio_channels,
+			      &source_frame_count,
+			      &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
 				 NULL,
@@ -1409,58 +1255,7 @@ ags_sfz_synth_util_copy_s64(gint64 *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					   sfz_sample->format);
-  
-  sfz_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_64_BIT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S64,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -1509,11 +1304,15 @@ ags_sfz_synth_util_copy_s64(gint64 *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_s64(im_buffer,
-			    frame_count,
-			    samplerate,
-			    base_key,
-			    tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -1608,15 +1407,14 @@ ags_sfz_synth_util_copy_s64(gint64 *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_s64_to_s64(buffer + l, 1,
-					      im_buffer + k, 1,
-					      copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_s64(buffer + l, 1,
-				       im_buffer + k, 1,
-				       copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_S64);
     }
 
     if(success){
@@ -1660,9 +1458,6 @@ ags_sfz_synth_util_copy_s64(gint64 *buffer,
       }
     }
   }
-
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -1696,19 +1491,19 @@ ags_sfz_synth_util_copy_float(gfloat *buffer,
 {
   gchar *group_key, *region_key;
 
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gfloat *im_buffer;
+  void *data;
 
   gint midi_key, current_midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -1716,15 +1511,25 @@ ags_sfz_synth_util_copy_float(gfloat *buffer,
   guint l;
   gboolean pong_copy;
 
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
   
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_sfz_sample_get_data(sfz_sample,
+			      &data,
+			      &data_audio_channels,
+			      &source_frame_count,
+			      &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
 				 NULL,
@@ -1732,58 +1537,7 @@ ags_sfz_synth_util_copy_float(gfloat *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					   sfz_sample->format);
-  
-  sfz_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_FLOAT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_FLOAT,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -1832,11 +1586,15 @@ ags_sfz_synth_util_copy_float(gfloat *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_float(im_buffer,
-			    frame_count,
-			    samplerate,
-			    base_key,
-			    tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -1931,15 +1689,14 @@ ags_sfz_synth_util_copy_float(gfloat *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_float_to_float(buffer + l, 1,
-						  im_buffer + k, 1,
-						  copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_float(buffer + l, 1,
-					 im_buffer + k, 1,
-					 copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_FLOAT);
     }
 
     if(success){
@@ -1983,9 +1740,6 @@ ags_sfz_synth_util_copy_float(gfloat *buffer,
       }
     }
   }
-  
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -2019,19 +1773,19 @@ ags_sfz_synth_util_copy_double(gdouble *buffer,
 {
   gchar *group_key, *region_key;
 
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  gdouble *im_buffer;
+  void *data;
 
   gint midi_key, current_midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -2039,15 +1793,25 @@ ags_sfz_synth_util_copy_double(gdouble *buffer,
   guint l;
   gboolean pong_copy;
   
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
 
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_sfz_sample_get_data(sfz_sample,
+			      &data,
+			      &data_audio_channels,
+			      &source_frame_count,
+			      &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
 				 NULL,
@@ -2055,58 +1819,7 @@ ags_sfz_synth_util_copy_double(gdouble *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					   sfz_sample->format);
-  
-  sfz_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_DOUBLE);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_DOUBLE,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -2155,11 +1868,15 @@ ags_sfz_synth_util_copy_double(gdouble *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_double(im_buffer,
-			    frame_count,
-			    samplerate,
-			    base_key,
-			    tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -2254,15 +1971,14 @@ ags_sfz_synth_util_copy_double(gdouble *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_double_to_double(buffer + l, 1,
-						    im_buffer + k, 1,
-						    copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_double(buffer + l, 1,
-					  im_buffer + k, 1,
-					  copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_DOUBLE);
     }
 
     if(success){
@@ -2306,9 +2022,6 @@ ags_sfz_synth_util_copy_double(gdouble *buffer,
       }
     }
   }
-  
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -2342,19 +2055,19 @@ ags_sfz_synth_util_copy_complex(AgsComplex *buffer,
 {
   gchar *group_key, *region_key;
 
-  void *sample_buffer;
+  AgsPitchUtil *pitch_util;
 
-  AgsComplex *im_buffer;
+  void *data;
 
   gint midi_key, current_midi_key;
-  guint frame_count;
   gdouble base_key;
   gdouble tuning;
   guint source_frame_count;
   guint source_samplerate;
   guint source_buffer_size;
   guint source_format;
-  guint copy_mode;
+  guint data_audio_channels;
+  guint data_format;
 
   guint i;
   guint j;
@@ -2362,15 +2075,25 @@ ags_sfz_synth_util_copy_complex(AgsComplex *buffer,
   guint l;
   gboolean pong_copy;
 
+  data = NULL;
+  
   source_frame_count = 0;
 
+  data_audio_channels = 1;
+  data_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
   source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
   
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* read the sample data directly, not through the sound resource */
+  if(!ags_sfz_sample_get_data(sfz_sample,
+			      &data,
+			      &data_audio_channels,
+			      &source_frame_count,
+			      &data_format)){
+    return;
+  }
 
   ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
 				 NULL,
@@ -2378,58 +2101,7 @@ ags_sfz_synth_util_copy_complex(AgsComplex *buffer,
 				 &source_buffer_size,
 				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					   sfz_sample->format);
-  
-  sfz_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_COMPLEX);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_COMPLEX,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+  pitch_util = ags_pitch_util_get_default();
 
   /* pitch */
   midi_key = 60;
@@ -2478,11 +2150,15 @@ ags_sfz_synth_util_copy_complex(AgsComplex *buffer,
 
   tuning = 100.0 * (note - base_key);
   
-  ags_filter_util_pitch_complex(im_buffer,
-				frame_count,
-				samplerate,
-				base_key,
-				tuning);
+  ags_pitch_util_set_samplerate(pitch_util,
+				source_samplerate, samplerate);
+  ags_pitch_util_set_pitch(pitch_util,
+			   base_key,
+			   tuning);
+
+  /* loop points within the pitched sample */
+  loop_start = (gint) floor((gdouble) loop_start / pitch_util->ratio);
+  loop_end = (gint) floor((gdouble) loop_end / pitch_util->ratio);
 
   pong_copy = FALSE;
   
@@ -2577,15 +2253,14 @@ ags_sfz_synth_util_copy_complex(AgsComplex *buffer,
 	start_frame = 0;
       }
       
-      if(!pong_copy){	
-	ags_audio_buffer_util_copy_complex_to_complex(buffer + l, 1,
-						      im_buffer + k, 1,
-						      copy_n_frames - start_frame);
-      }else{
-	ags_audio_buffer_util_pong_complex(buffer + l, 1,
-					   im_buffer + k, 1,
-					   copy_n_frames - start_frame);
-      }
+      ags_pitch_util_resample_data(pitch_util,
+				   buffer + l,
+				   data, data_audio_channels,
+				   0, data_format,
+				   source_frame_count,
+				   k, copy_n_frames - start_frame,
+				   pong_copy,
+				   AGS_AUDIO_BUFFER_UTIL_COMPLEX);
     }
 
     if(success){
@@ -2629,9 +2304,6 @@ ags_sfz_synth_util_copy_complex(AgsComplex *buffer,
       }
     }
   }
-
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
 }
 
 /**
@@ -19,6 +19,8 @@
 
 #include <ags/audio/ags_sound_provider.h>
 
+#include <ags/audio/osc/ags_osc_address_trie.h>
+
 void ags_sound_provider_class_init(AgsSoundProviderInterface *ginterface);
 
 /**
@@ -168,6 +170,9 @@ ags_sound_provider_set_soundcard(AgsSoundProvider *sound_provider,
 
   sound_provider_interface->set_soundcard(sound_provider,
 					  soundcard);
+
+  /* invalidate OSC addresses */
+  ags_osc_address_trie_invalidate();
 }
 
 /**
@@ -258,6 +263,9 @@ ags_sound_provider_set_audio(AgsSoundProvider *sound_provider,
 
   sound_provider_interface->set_audio(sound_provider,
 				      audio);
+
+  /* invalidate OSC addresses */
+  ags_osc_address_trie_invalidate();
 }
 
 /**
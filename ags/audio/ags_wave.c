@@ -25,6 +25,8 @@
 #include <ags/i18n.h>
 
 #include <errno.h>
+#include <math.h>
+#include <string.h>
 
 void ags_wave_class_init(AgsWaveClass *wave);
 void ags_wave_init(AgsWave *wave);
@@ -38,6 +40,25 @@ void ags_wave_get_property(GObject *gobject,
 			   GParamSpec *param_spec);
 void ags_wave_dispose(GObject *gobject);
 void ags_wave_finalize(GObject *gobject);
+
+guint ags_wave_index_lower_bound(AgsWave *wave,
+				 guint64 x);
+void ags_wave_index_insert(AgsWave *wave,
+			   AgsBuffer *buffer);
+void ags_wave_index_remove(AgsWave *wave,
+			   AgsBuffer *buffer);
+void ags_wave_index_rebuild(AgsWave *wave);
+guint ags_wave_index_first(AgsWave *wave,
+			   guint64 x);
+guint ags_wave_index_read(AgsWave *wave,
+			  guint position,
+			  guint64 x,
+			  gpointer destination, guint dchannels, guint doffset,
+			  guint frame_count, guint format);
+
+void ags_wave_free_peak(AgsWave *wave);
+void ags_wave_peak_of_buffer(AgsBuffer *buffer,
+			     AgsBufferPeak *peak);
   
 void ags_wave_insert_native_level_from_clipboard_version_1_4_0(AgsWave *wave,
 							       xmlNode *root_node, char *version,
@@ -67,6 +88,11 @@ void ags_wave_insert_native_level_from_clipboard(AgsWave *wave,
  * @include: ags/audio/ags_wave.h
  *
  * #AgsWave acts as a container of #AgsBuffer.
+ *
+ * For display the wave keeps a min/max/RMS peak pyramid across its
+ * buffers, level n summarizes 2 to the power of n buffers of the buffer
+ * index. A buffer tells about modified peaks by its peak serial, so only
+ * the outdated range of the pyramid is updated.
  */
 
 enum{
@@ -282,6 +308,20 @@ ags_wave_init(AgsWave *wave)
 
   wave->buffer = NULL;
   wave->selection = NULL;
+
+  /* buffer index */
+  wave->buffer_index = NULL;
+  wave->n_buffer_index = 0;
+  wave->allocated_buffer_index = 0;
+
+  wave->generation = 0;
+
+  /* peak */
+  wave->peak_levels = 0;
+  wave->peak = NULL;
+  wave->peak_serial = NULL;
+  wave->n_peak_buffers = 0;
+  wave->peak_generation = 0;
 }
 
 void
@@ -551,6 +591,9 @@ ags_wave_dispose(GObject *gobject)
 
   wave->buffer = NULL;
   wave->selection = NULL;
+
+  wave->n_buffer_index = 0;
+  wave->generation += 1;
     
   /* call parent */
   G_OBJECT_CLASS(ags_wave_parent_class)->dispose(gobject);
@@ -579,11 +622,131 @@ ags_wave_finalize(GObject *gobject)
 
   g_list_free_full(wave->selection,
 		   g_object_unref);
+
+  g_free(wave->buffer_index);
+
+  ags_wave_free_peak(wave);
   
   /* call parent */
   G_OBJECT_CLASS(ags_wave_parent_class)->finalize(gobject);
 }
 
+guint
+ags_wave_index_lower_bound(AgsWave *wave,
+			   guint64 x)
+{
+  guint low, high, middle;
+
+  low = 0;
+  high = wave->n_buffer_index;
+
+  while(low < high){
+    middle = low + (high - low) / 2;
+
+    if(wave->buffer_index[middle].x < x){
+      low = middle + 1;
+    }else{
+      high = middle;
+    }
+  }
+
+  return(low);
+}
+
+void
+ags_wave_index_insert(AgsWave *wave,
+		      AgsBuffer *buffer)
+{
+  guint64 x;
+  guint position;
+
+  x = ags_buffer_get_x(buffer);
+  
+  if(wave->n_buffer_index == wave->allocated_buffer_index){
+    if(wave->allocated_buffer_index == 0){
+      wave->allocated_buffer_index = 64;
+    }else{
+      wave->allocated_buffer_index *= 2;
+    }
+
+    wave->buffer_index = (AgsWaveIndexEntry *) g_realloc(wave->buffer_index,
+							 wave->allocated_buffer_index * sizeof(AgsWaveIndexEntry));
+  }
+
+  /* insert after equal offsets, as the sorted list does */
+  position = ags_wave_index_lower_bound(wave,
+					x + 1);
+
+  if(position < wave->n_buffer_index){
+    memmove(wave->buffer_index + position + 1,
+	    wave->buffer_index + position,
+	    (wave->n_buffer_index - position) * sizeof(AgsWaveIndexEntry));
+  }
+
+  wave->buffer_index[position].x = x;
+  wave->buffer_index[position].buffer = buffer;
+
+  wave->n_buffer_index += 1;
+  wave->generation += 1;
+}
+
+void
+ags_wave_index_remove(AgsWave *wave,
+		      AgsBuffer *buffer)
+{
+  guint i;
+
+  i = ags_wave_index_lower_bound(wave,
+				 ags_buffer_get_x(buffer));
+
+  for(; i < wave->n_buffer_index; i++){
+    if(wave->buffer_index[i].buffer == buffer){
+      break;
+    }
+  }
+
+  if(i == wave->n_buffer_index){
+    /* x was modified after adding, fall back to a linear search */
+    for(i = 0; i < wave->n_buffer_index; i++){
+      if(wave->buffer_index[i].buffer == buffer){
+	break;
+      }
+    }
+
+    if(i == wave->n_buffer_index){
+      return;
+    }
+  }
+
+  if(i + 1 < wave->n_buffer_index){
+    memmove(wave->buffer_index + i,
+	    wave->buffer_index + i + 1,
+	    (wave->n_buffer_index - i - 1) * sizeof(AgsWaveIndexEntry));
+  }
+
+  wave->n_buffer_index -= 1;
+  wave->generation += 1;
+}
+
+void
+ags_wave_index_rebuild(AgsWave *wave)
+{
+  GList *buffer;
+
+  wave->n_buffer_index = 0;
+  
+  buffer = wave->buffer;
+
+  while(buffer != NULL){
+    ags_wave_index_insert(wave,
+			  buffer->data);
+    
+    buffer = buffer->next;
+  }
+
+  wave->generation += 1;
+}
+
 /**
  * ags_wave_get_obj_mutex:
  * @wave: the #AgsWave
@@ -1357,6 +1520,9 @@ ags_wave_set_samplerate(AgsWave *wave,
     
     g_rec_mutex_unlock(buffer_mutex);
 
+    ags_buffer_invalidate_peak(list->data,
+			       0, buffer_size);
+
     /* iterate */
     list = list->next;
 
@@ -1624,6 +1790,9 @@ ags_wave_set_buffer_size(AgsWave *wave,
     
     g_rec_mutex_unlock(buffer_mutex);
 
+    ags_buffer_invalidate_peak(list->data,
+			       0, buffer_size);
+
     /* iterate */
     list = list->next;
 
@@ -1633,6 +1802,13 @@ ags_wave_set_buffer_size(AgsWave *wave,
   g_list_free_full(start_list,
 		   g_object_unref);
 
+  /* the buffers moved, the index is sorted by x */
+  g_rec_mutex_lock(wave_mutex);
+
+  ags_wave_index_rebuild(wave);
+  
+  g_rec_mutex_unlock(wave_mutex);
+
   if(data != NULL){
     free(data);
   }
@@ -1808,6 +1984,8 @@ ags_wave_set_buffer(AgsWave *wave, GList *buffer)
 
   start_buffer = wave->buffer;
   wave->buffer = buffer;
+
+  ags_wave_index_rebuild(wave);
   
   g_rec_mutex_unlock(wave_mutex);
 
@@ -1882,6 +2060,11 @@ ags_wave_add_buffer(AgsWave *wave,
     wave->buffer = g_list_insert_sorted(wave->buffer,
 					buffer,
 					(GCompareFunc) ags_buffer_sort_func);
+
+    ags_wave_index_insert(wave,
+			  buffer);
+
+    wave->flags |= AGS_WAVE_MODIFIED;
   }
 
   g_rec_mutex_unlock(wave_mutex);
@@ -1920,6 +2103,12 @@ ags_wave_remove_buffer(AgsWave *wave,
 		   buffer) != NULL){
       wave->buffer = g_list_remove(wave->buffer,
 				   buffer);
+
+      ags_wave_index_remove(wave,
+			    buffer);
+
+      wave->flags |= AGS_WAVE_MODIFIED;
+      
       g_object_unref(buffer);
     }
   }else{
@@ -2073,13 +2262,26 @@ ags_wave_find_point(AgsWave *wave,
   g_rec_mutex_lock(wave_mutex);
 
   buffer_size = wave->buffer_size;
-  
-  if(use_selection_list){
-    buffer = wave->selection;
-  }else{
-    buffer = wave->buffer;
+
+  /* binary search the buffer index */
+  if(!use_selection_list){
+    retval = NULL;
+    
+    position = ags_wave_index_lower_bound(wave,
+					  x + 1);
+
+    if(position > 0 &&
+       wave->buffer_index[position - 1].x + buffer_size > x){
+      retval = wave->buffer_index[position - 1].buffer;
+    }
+    
+    g_rec_mutex_unlock(wave_mutex);
+
+    return(retval);
   }
   
+  buffer = wave->selection;
+  
   current_start = buffer;
   current_end = g_list_last(buffer);
   
@@ -2202,17 +2404,31 @@ ags_wave_find_region(AgsWave *wave,
 
     tmp = x1;
     x1 = x0;
-    x0 = x1;
+    x0 = tmp;
   }
   
   /* find buffer */
   g_rec_mutex_lock(wave_mutex);
 
-  if(use_selection_list){
-    buffer = wave->selection;
-  }else{
-    buffer = wave->buffer;
+  if(!use_selection_list){
+    guint i;
+
+    /* the buffer index starts at the first buffer ending after x0 */
+    region = NULL;
+
+    for(i = ags_wave_index_first(wave, x0); i < wave->n_buffer_index && wave->buffer_index[i].x <= x1; i++){
+      region = g_list_prepend(region,
+			      wave->buffer_index[i].buffer);
+    }
+
+    g_rec_mutex_unlock(wave_mutex);
+
+    region = g_list_reverse(region);
+
+    return(region);
   }
+  
+  buffer = wave->selection;
 
   while(buffer != NULL){
     g_object_get(buffer->data,
@@ -2251,6 +2467,490 @@ ags_wave_find_region(AgsWave *wave,
   return(region);
 }
 
+guint
+ags_wave_index_first(AgsWave *wave,
+		     guint64 x)
+{
+  guint buffer_size;
+
+  buffer_size = wave->buffer_size;
+
+  /* the first buffer ending after x */
+  if(x < buffer_size){
+    return(0);
+  }
+  
+  return(ags_wave_index_lower_bound(wave,
+				    x - buffer_size + 1));
+}
+
+guint
+ags_wave_index_read(AgsWave *wave,
+		    guint position,
+		    guint64 x,
+		    gpointer destination, guint dchannels, guint doffset,
+		    guint frame_count, guint format)
+{
+  guint buffer_size;
+  guint n_read;
+  guint i;
+
+  buffer_size = wave->buffer_size;
+  
+  n_read = 0;
+  
+  for(i = position; i < wave->n_buffer_index && wave->buffer_index[i].x < x + frame_count; i++){
+    AgsBuffer *buffer;
+
+    guint64 x0, x1;
+    guint copy_mode;
+
+    GRecMutex *buffer_mutex;
+    
+    buffer = wave->buffer_index[i].buffer;
+
+    x0 = wave->buffer_index[i].x;
+    x1 = x0 + buffer_size;
+
+    if(x1 <= x){
+      continue;
+    }
+    
+    if(x0 < x){
+      x0 = x;
+    }
+
+    if(x1 > x + frame_count){
+      x1 = x + frame_count;
+    }
+
+    buffer_mutex = AGS_BUFFER_GET_OBJ_MUTEX(buffer);
+    
+    g_rec_mutex_lock(buffer_mutex);
+
+    copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(format),
+						    ags_audio_buffer_util_format_from_soundcard(buffer->format));
+
+    ags_audio_buffer_util_copy_buffer_to_buffer(destination, dchannels, (doffset + x0 - x) * dchannels,
+						buffer->data, 1, x0 - wave->buffer_index[i].x,
+						x1 - x0, copy_mode);
+    
+    g_rec_mutex_unlock(buffer_mutex);
+
+    n_read += (x1 - x0);
+  }
+
+  return(n_read);
+}
+
+/**
+ * ags_wave_read_range:
+ * @wave: the #AgsWave
+ * @x: offset
+ * @destination: the destination buffer
+ * @dchannels: the channel count of @destination
+ * @frame_count: the frame count to read
+ * @format: the format of @destination
+ *
+ * Mix the buffers of @wave from @x to @x plus @frame_count into the
+ * contiguous @destination, across buffer boundaries. The buffers are
+ * expected to match the samplerate of @destination.
+ *
+ * Returns: the count of frames covered by buffers
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_wave_read_range(AgsWave *wave,
+		    guint64 x,
+		    gpointer destination, guint dchannels,
+		    guint frame_count, guint format)
+{
+  guint n_read;
+  
+  GRecMutex *wave_mutex;
+
+  if(!AGS_IS_WAVE(wave) ||
+     destination == NULL){
+    return(0);
+  }
+
+  /* get wave mutex */
+  wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+
+  g_rec_mutex_lock(wave_mutex);
+
+  n_read = ags_wave_index_read(wave,
+			       ags_wave_index_first(wave,
+						    x),
+			       x,
+			       destination, dchannels, 0,
+			       frame_count, format);
+  
+  g_rec_mutex_unlock(wave_mutex);
+
+  return(n_read);
+}
+
+/**
+ * ags_wave_find_buffer_index:
+ * @wave: the #AgsWave
+ * @x: the offset
+ *
+ * Find the position of the first buffer ending after @x within the
+ * buffer index of @wave.
+ *
+ * Returns: the position, the count of buffers if none
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_wave_find_buffer_index(AgsWave *wave,
+			   guint64 x)
+{
+  guint position;
+  
+  GRecMutex *wave_mutex;
+
+  if(!AGS_IS_WAVE(wave)){
+    return(0);
+  }
+
+  /* get wave mutex */
+  wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+
+  g_rec_mutex_lock(wave_mutex);
+
+  position = ags_wave_index_first(wave,
+				  x);
+  
+  g_rec_mutex_unlock(wave_mutex);
+
+  return(position);
+}
+
+void
+ags_wave_free_peak(AgsWave *wave)
+{
+  guint i;
+  
+  if(wave->peak != NULL){
+    for(i = 0; i < wave->peak_levels; i++){
+      g_free(wave->peak[i]);
+    }
+
+    g_free(wave->peak);
+  }
+
+  g_free(wave->peak_serial);
+  
+  wave->peak_levels = 0;
+  wave->peak = NULL;
+  wave->peak_serial = NULL;
+  wave->n_peak_buffers = 0;
+}
+
+void
+ags_wave_peak_of_buffer(AgsBuffer *buffer,
+			AgsBufferPeak *peak)
+{
+  AgsBufferPeak *buffer_peak;
+
+  guint n_peaks;
+  guint i;
+  
+  GRecMutex *buffer_mutex;
+
+  buffer_mutex = AGS_BUFFER_GET_OBJ_MUTEX(buffer);
+
+  peak->min = 0.0;
+  peak->max = 0.0;
+  peak->rms = 0.0;
+  
+  /* the top level summarizes the whole buffer */
+  g_rec_mutex_lock(buffer_mutex);
+
+  buffer_peak = ags_buffer_get_peak(buffer,
+				    G_MAXUINT,
+				    &n_peaks,
+				    NULL);
+  
+  if(buffer_peak != NULL &&
+     n_peaks > 0){
+    peak[0] = buffer_peak[0];
+
+    for(i = 1; i < n_peaks; i++){
+      if(buffer_peak[i].min < peak->min){
+	peak->min = buffer_peak[i].min;
+      }
+
+      if(buffer_peak[i].max > peak->max){
+	peak->max = buffer_peak[i].max;
+      }
+
+      if(buffer_peak[i].rms > peak->rms){
+	peak->rms = buffer_peak[i].rms;
+      }
+    }
+  }
+  
+  g_rec_mutex_unlock(buffer_mutex);
+}
+
+/**
+ * ags_wave_update_peak:
+ * @wave: the #AgsWave
+ *
+ * Update the outdated peaks of @wave. The pyramid is rebuilt if buffers
+ * were added or removed, otherwise only the buffers with modified peaks
+ * and the levels above them are updated.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_wave_update_peak(AgsWave *wave)
+{
+  AgsBufferPeak *peak, *child_peak;
+
+  guint n_buffers;
+  guint n_peaks, n_child_peaks;
+  guint start, end;
+  guint level;
+  guint i;
+  gint serial;
+  
+  GRecMutex *wave_mutex;
+
+  if(!AGS_IS_WAVE(wave)){
+    return;
+  }
+
+  /* get wave mutex */
+  wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+
+  g_rec_mutex_lock(wave_mutex);
+
+  n_buffers = wave->n_buffer_index;
+
+  if(n_buffers == 0){
+    ags_wave_free_peak(wave);
+    
+    wave->peak_generation = wave->generation;
+    
+    g_rec_mutex_unlock(wave_mutex);
+
+    return;
+  }
+
+  start = n_buffers;
+  end = 0;
+  
+  if(wave->peak == NULL ||
+     wave->peak_generation != wave->generation){
+    /* allocate - the top level summarizes all buffers */
+    ags_wave_free_peak(wave);
+
+    wave->peak_levels = 1;
+
+    while((1 << (wave->peak_levels - 1)) < n_buffers){
+      wave->peak_levels += 1;
+    }
+
+    wave->peak = (AgsBufferPeak **) g_malloc(wave->peak_levels * sizeof(AgsBufferPeak *));
+
+    for(level = 0; level < wave->peak_levels; level++){
+      wave->peak[level] = (AgsBufferPeak *) g_malloc0((((n_buffers - 1) >> level) + 1) * sizeof(AgsBufferPeak));
+    }
+
+    wave->peak_serial = (gint *) g_malloc(n_buffers * sizeof(gint));
+    wave->n_peak_buffers = n_buffers;
+    
+    wave->peak_generation = wave->generation;
+    
+    start = 0;
+    end = n_buffers;
+  }
+
+  /* first level of buffers - the serial is taken before reading the peak */
+  peak = wave->peak[0];
+  
+  for(i = 0; i < n_buffers; i++){
+    serial = g_atomic_int_get(&(wave->buffer_index[i].buffer->peak_serial));
+
+    if(i >= start &&
+       i < end){
+      wave->peak_serial[i] = serial;
+    }else if(serial != wave->peak_serial[i]){
+      wave->peak_serial[i] = serial;
+
+      if(i < start){
+	start = i;
+      }
+
+      if(i + 1 > end){
+	end = i + 1;
+      }
+    }else{
+      continue;
+    }
+
+    ags_wave_peak_of_buffer(wave->buffer_index[i].buffer,
+			    &(peak[i]));
+  }
+
+  /* upper levels of the level below */
+  for(level = 1; level < wave->peak_levels && start < end; level++){
+    n_peaks = ((n_buffers - 1) >> level) + 1;
+    n_child_peaks = ((n_buffers - 1) >> (level - 1)) + 1;
+    
+    start = start / 2;
+    end = (end + 1) / 2;
+
+    if(end > n_peaks){
+      end = n_peaks;
+    }
+    
+    peak = wave->peak[level];
+    child_peak = wave->peak[level - 1];
+
+    for(i = start; i < end; i++){
+      peak[i] = child_peak[2 * i];
+
+      if(2 * i + 1 < n_child_peaks){
+	if(child_peak[2 * i + 1].min < peak[i].min){
+	  peak[i].min = child_peak[2 * i + 1].min;
+	}
+
+	if(child_peak[2 * i + 1].max > peak[i].max){
+	  peak[i].max = child_peak[2 * i + 1].max;
+	}
+
+	peak[i].rms = (gfloat) sqrt(0.5 * ((gdouble) child_peak[2 * i].rms * (gdouble) child_peak[2 * i].rms +
+					   (gdouble) child_peak[2 * i + 1].rms * (gdouble) child_peak[2 * i + 1].rms));
+      }
+    }
+  }
+  
+  g_rec_mutex_unlock(wave_mutex);
+}
+
+/**
+ * ags_wave_find_peak_level:
+ * @wave: the #AgsWave
+ * @frames_per_pixel: the frames a pixel of the display covers
+ *
+ * Find the coarsest peak level of @wave that still has a peak per
+ * pixel. Level 0 has a peak per buffer, so it is only of use if a
+ * buffer fits within a pixel, otherwise draw the peaks of the buffers,
+ * see ags_buffer_find_peak_level().
+ *
+ * Returns: the level to pass to ags_wave_get_peak()
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_wave_find_peak_level(AgsWave *wave,
+			 gdouble frames_per_pixel)
+{
+  guint buffer_size;
+  guint n_buffers;
+  guint level;
+  
+  GRecMutex *wave_mutex;
+
+  if(!AGS_IS_WAVE(wave)){
+    return(0);
+  }
+
+  /* get wave mutex */
+  wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+
+  g_rec_mutex_lock(wave_mutex);
+
+  buffer_size = wave->buffer_size;
+  n_buffers = wave->n_buffer_index;
+  
+  g_rec_mutex_unlock(wave_mutex);
+
+  level = 0;
+  
+  while(level < 31 &&
+	(gdouble) buffer_size * (gdouble) (1 << (level + 1)) <= frames_per_pixel &&
+	(1 << level) < n_buffers){
+    level++;
+  }
+  
+  return(level);
+}
+
+/**
+ * ags_wave_get_peak:
+ * @wave: the #AgsWave
+ * @level: the level, see ags_wave_find_peak_level()
+ * @n_peaks: (out): return location of the count of peaks
+ * @buffers_per_peak: (out): return location of the buffers per peak
+ *
+ * Get the peaks of @level, outdated peaks are updated first. Peak i
+ * starts at the buffer index entry i times @buffers_per_peak. The peaks
+ * and the buffer index are owned by @wave, keep it locked while reading
+ * them.
+ *
+ * Returns: (transfer none): the #AgsBufferPeak-struct array or %NULL
+ *
+ * Since: 3.5.0
+ */
+AgsBufferPeak*
+ags_wave_get_peak(AgsWave *wave,
+		  guint level,
+		  guint *n_peaks,
+		  guint *buffers_per_peak)
+{
+  AgsBufferPeak *peak;
+
+  GRecMutex *wave_mutex;
+
+  if(n_peaks != NULL){
+    n_peaks[0] = 0;
+  }
+
+  if(buffers_per_peak != NULL){
+    buffers_per_peak[0] = 0;
+  }
+  
+  if(!AGS_IS_WAVE(wave)){
+    return(NULL);
+  }
+
+  /* get wave mutex */
+  wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+
+  g_rec_mutex_lock(wave_mutex);
+
+  ags_wave_update_peak(wave);
+
+  peak = NULL;
+  
+  if(wave->peak != NULL){
+    if(level >= wave->peak_levels){
+      level = wave->peak_levels - 1;
+    }
+
+    peak = wave->peak[level];
+
+    if(n_peaks != NULL){
+      n_peaks[0] = ((wave->n_peak_buffers - 1) >> level) + 1;
+    }
+
+    if(buffers_per_peak != NULL){
+      buffers_per_peak[0] = 1 << level;
+    }
+  }
+  
+  g_rec_mutex_unlock(wave_mutex);
+
+  return(peak);
+}
+
 /**
  * ags_wave_free_selection:
  * @wave: the #AgsWave
@@ -2868,11 +3568,19 @@ ags_wave_cut_selection(AgsWave *wave)
   while(selection != NULL){
     wave->buffer = g_list_remove(wave->buffer,
 				 selection->data);
+
+    ags_wave_index_remove(wave,
+			  selection->data);
+    
     g_object_unref(selection->data);
 
     selection = selection->next;
   }
 
+  if(wave->selection != NULL){
+    wave->flags |= AGS_WAVE_MODIFIED;
+  }
+  
   g_rec_mutex_unlock(wave_mutex);
 
   /* free selection */
@@ -3367,6 +4075,9 @@ ags_wave_insert_native_level_from_clipboard_version_1_4_0(AgsWave *wave,
 							  wave_buffer_size - attack, copy_mode);
 	    }
 	  }
+
+	  ags_buffer_invalidate_peak(buffer,
+				     attack, wave_buffer_size - attack);
 	    
 	  /* find next */
 	  if(attack + frame_count > wave_buffer_size){
@@ -3432,6 +4143,9 @@ ags_wave_insert_native_level_from_clipboard_version_1_4_0(AgsWave *wave,
 							  clipboard_data, 1, wave_buffer_size - attack,
 							  attack, copy_mode);
 	    }
+
+	    ags_buffer_invalidate_peak(buffer,
+				       0, attack);
 	  }
 	}
       }
@@ -3599,6 +4313,9 @@ ags_wave_insert_from_clipboard_extended(AgsWave *wave,
 						    reset_x_offset, x_offset,
 						    delay, attack,
 						    match_line, do_replace);
+
+	ags_wave_set_flags(wave,
+			   AGS_WAVE_MODIFIED);
       }
     }
   }
@@ -3628,3 +4345,259 @@ ags_wave_new(GObject *audio,
   
   return(wave);
 }
+
+/**
+ * ags_wave_cursor_alloc:
+ * @audio: the #AgsAudio
+ * @line: the audio channel
+ *
+ * Allocate #AgsWaveCursor.
+ *
+ * Returns: (type gpointer) (transfer full): the newly allocated #AgsWaveCursor
+ *
+ * Since: 3.5.0
+ */
+AgsWaveCursor*
+ags_wave_cursor_alloc(GObject *audio,
+		      guint line)
+{
+  AgsWaveCursor *wave_cursor;
+
+  wave_cursor = (AgsWaveCursor *) g_malloc(sizeof(AgsWaveCursor));
+
+  wave_cursor->audio = audio;
+
+  if(audio != NULL){
+    g_object_ref(audio);
+  }
+  
+  wave_cursor->line = line;
+
+  wave_cursor->timestamp = ags_timestamp_new();
+
+  wave_cursor->timestamp->flags &= (~AGS_TIMESTAMP_UNIX);
+  wave_cursor->timestamp->flags |= AGS_TIMESTAMP_OFFSET;
+  
+  wave_cursor->wave = NULL;
+  wave_cursor->generation = 0;
+  wave_cursor->position = 0;
+
+  wave_cursor->wave_x0 = 0;
+  wave_cursor->wave_x1 = 0;
+
+  wave_cursor->x = 0;
+  
+  return(wave_cursor);
+}
+
+/**
+ * ags_wave_cursor_free:
+ * @wave_cursor: (type gpointer) (transfer full): the #AgsWaveCursor
+ *
+ * Free @wave_cursor.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_wave_cursor_free(AgsWaveCursor *wave_cursor)
+{
+  if(wave_cursor == NULL){
+    return;
+  }
+
+  if(wave_cursor->audio != NULL){
+    g_object_unref(wave_cursor->audio);
+  }
+
+  if(wave_cursor->timestamp != NULL){
+    g_object_unref(wave_cursor->timestamp);
+  }
+
+  if(wave_cursor->wave != NULL){
+    g_object_unref(wave_cursor->wave);
+  }
+  
+  g_free(wave_cursor);
+}
+
+/**
+ * ags_wave_cursor_seek:
+ * @wave_cursor: (type gpointer): the #AgsWaveCursor
+ * @x: offset
+ * @samplerate: the samplerate
+ *
+ * Seek @wave_cursor to @x, this looks up the #AgsWave containing @x.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_wave_cursor_seek(AgsWaveCursor *wave_cursor,
+		     guint64 x, guint samplerate)
+{
+  AgsWave *wave;
+  
+  GList *start_wave, *current_wave;
+
+  guint64 relative_offset;
+
+  GRecMutex *wave_mutex;
+
+  if(wave_cursor == NULL){
+    return;
+  }
+
+  relative_offset = AGS_WAVE_DEFAULT_BUFFER_LENGTH * samplerate;
+
+  if(relative_offset == 0){
+    relative_offset = AGS_WAVE_DEFAULT_OFFSET;
+  }
+  
+  wave_cursor->wave_x0 = relative_offset * (x / relative_offset);
+  wave_cursor->wave_x1 = wave_cursor->wave_x0 + relative_offset;
+
+  wave_cursor->x = x;
+
+  if(wave_cursor->wave != NULL){
+    g_object_unref(wave_cursor->wave);
+
+    wave_cursor->wave = NULL;
+  }
+
+  if(wave_cursor->audio == NULL){
+    return;
+  }
+  
+  /* find wave */
+  start_wave = NULL;
+  
+  g_object_get(wave_cursor->audio,
+	       "wave", &start_wave,
+	       NULL);
+  
+  ags_timestamp_set_ags_offset(wave_cursor->timestamp,
+			       wave_cursor->wave_x0);
+
+  current_wave = ags_wave_find_near_timestamp(start_wave, wave_cursor->line,
+					      wave_cursor->timestamp);
+
+  wave = NULL;
+  
+  if(current_wave != NULL){
+    wave = current_wave->data;
+    g_object_ref(wave);
+  }
+
+  g_list_free_full(start_wave,
+		   (GDestroyNotify) g_object_unref);
+
+  if(wave == NULL){
+    return;
+  }
+  
+  wave_cursor->wave = wave;
+
+  /* position */
+  wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+
+  g_rec_mutex_lock(wave_mutex);
+
+  wave_cursor->generation = wave->generation;
+  wave_cursor->position = ags_wave_index_first(wave,
+					       x);
+  
+  g_rec_mutex_unlock(wave_mutex);
+}
+
+/**
+ * ags_wave_cursor_read:
+ * @wave_cursor: (type gpointer): the #AgsWaveCursor
+ * @x: offset
+ * @samplerate: the samplerate
+ * @destination: the destination buffer
+ * @dchannels: the channel count of @destination
+ * @frame_count: the frame count to read
+ * @format: the format of @destination
+ *
+ * Mix the wave data at @x into @destination. A read continuing the previous
+ * one advances the cursor in constant time, any other @x seeks like
+ * locate or loop do.
+ *
+ * Returns: the count of frames covered by buffers
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_wave_cursor_read(AgsWaveCursor *wave_cursor,
+		     guint64 x, guint samplerate,
+		     gpointer destination, guint dchannels,
+		     guint frame_count, guint format)
+{
+  guint n_read;
+  guint offset;
+  
+  if(wave_cursor == NULL ||
+     destination == NULL){
+    return(0);
+  }
+
+  n_read = 0;
+  
+  for(offset = 0; offset < frame_count;){
+    AgsWave *wave;
+
+    guint64 current_x;
+    guint count;
+
+    GRecMutex *wave_mutex;
+    
+    current_x = x + offset;
+
+    if(wave_cursor->wave == NULL ||
+       wave_cursor->x != current_x ||
+       current_x < wave_cursor->wave_x0 ||
+       current_x >= wave_cursor->wave_x1){
+      ags_wave_cursor_seek(wave_cursor,
+			   current_x, samplerate);
+    }
+
+    count = frame_count - offset;
+
+    if(wave_cursor->wave_x1 - current_x < count){
+      count = wave_cursor->wave_x1 - current_x;
+    }
+
+    wave = wave_cursor->wave;
+    
+    if(wave != NULL){
+      wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+
+      g_rec_mutex_lock(wave_mutex);
+
+      if(wave_cursor->generation != wave->generation){
+	/* buffers were added or removed */
+	wave_cursor->generation = wave->generation;
+	wave_cursor->position = ags_wave_index_first(wave,
+						     current_x);
+      }else{
+	while(wave_cursor->position < wave->n_buffer_index &&
+	      wave->buffer_index[wave_cursor->position].x + wave->buffer_size <= current_x){
+	  wave_cursor->position += 1;
+	}
+      }
+
+      n_read += ags_wave_index_read(wave,
+				    wave_cursor->position,
+				    current_x,
+				    destination, dchannels, offset,
+				    count, format);
+      
+      g_rec_mutex_unlock(wave_mutex);
+    }
+    
+    offset += count;
+    
+    wave_cursor->x = current_x + count;
+  }
+
+  return(n_read);
+}
@@ -40,6 +40,8 @@ G_BEGIN_DECLS
 
 #define AGS_WAVE_GET_OBJ_MUTEX(obj) (&(((AgsWave *) obj)->obj_mutex))
 
+#define AGS_WAVE_CURSOR(ptr) ((AgsWaveCursor *)(ptr))
+
 #define AGS_WAVE_DEFAULT_BPM (120.0)
 
 #define AGS_WAVE_TICS_PER_BEAT (1.0)
@@ -58,18 +60,68 @@ G_BEGIN_DECLS
 
 typedef struct _AgsWave AgsWave;
 typedef struct _AgsWaveClass AgsWaveClass;
+typedef struct _AgsWaveIndexEntry AgsWaveIndexEntry;
+typedef struct _AgsWaveCursor AgsWaveCursor;
 
 /**
  * AgsWaveFlags:
  * @AGS_WAVE_BYPASS: ignore any wave data
+ * @AGS_WAVE_MODIFIED: the buffers were modified after decoding, a #AgsWaveStream of the line isn't played anymore
  * 
  * Enum values to control the behavior or indicate internal state of #AgsWave by
  * enable/disable as flags.
  */
 typedef enum{
   AGS_WAVE_BYPASS            = 1,
+  AGS_WAVE_MODIFIED          = 1 <<  1,
 }AgsWaveFlags;
 
+/**
+ * AgsWaveIndexEntry:
+ * @x: the offset of @buffer
+ * @buffer: the #AgsBuffer
+ *
+ * #AgsWaveIndexEntry is an entry of the buffer index of #AgsWave, sorted by @x.
+ */
+struct _AgsWaveIndexEntry
+{
+  guint64 x;
+  
+  AgsBuffer *buffer;
+};
+
+/**
+ * AgsWaveCursor:
+ * @audio: the #AgsAudio to play
+ * @line: the audio channel
+ * @timestamp: the #AgsTimestamp used to seek
+ * @wave: the current #AgsWave
+ * @generation: the buffer index generation of @wave
+ * @position: the buffer index position
+ * @wave_x0: the first offset of @wave
+ * @wave_x1: the offset after @wave
+ * @x: the expected offset of the next read
+ *
+ * #AgsWaveCursor keeps the read position of playback. Contiguous reads
+ * advance it, any other offset seeks.
+ */
+struct _AgsWaveCursor
+{
+  GObject *audio;
+  guint line;
+
+  AgsTimestamp *timestamp;
+  
+  AgsWave *wave;
+  guint generation;
+  guint position;
+
+  guint64 wave_x0;
+  guint64 wave_x1;
+  
+  guint64 x;
+};
+
 struct _AgsWave
 {
   GObject gobject;
@@ -91,6 +143,18 @@ struct _AgsWave
   
   GList *buffer;
   GList *selection;
+
+  AgsWaveIndexEntry *buffer_index;
+  guint n_buffer_index;
+  guint allocated_buffer_index;
+
+  guint generation;
+
+  guint peak_levels;
+  AgsBufferPeak **peak;
+  gint *peak_serial;
+  guint n_peak_buffers;
+  guint peak_generation;
 };
 
 struct _AgsWaveClass
@@ -162,6 +226,23 @@ GList* ags_wave_find_region(AgsWave *wave,
 			    guint64 x1,
 			    gboolean use_selection_list);
 
+guint ags_wave_read_range(AgsWave *wave,
+			  guint64 x,
+			  gpointer destination, guint dchannels,
+			  guint frame_count, guint format);
+
+guint ags_wave_find_buffer_index(AgsWave *wave,
+				 guint64 x);
+
+void ags_wave_update_peak(AgsWave *wave);
+
+guint ags_wave_find_peak_level(AgsWave *wave,
+			       gdouble frames_per_pixel);
+AgsBufferPeak* ags_wave_get_peak(AgsWave *wave,
+				 guint level,
+				 guint *n_peaks,
+				 guint *buffers_per_peak);
+
 void ags_wave_free_selection(AgsWave *wave);
 
 void ags_wave_add_region_to_selection(AgsWave *wave,
@@ -189,6 +270,17 @@ void ags_wave_insert_from_clipboard_extended(AgsWave *wave,
 AgsWave* ags_wave_new(GObject *audio,
 		      guint line);
 
+AgsWaveCursor* ags_wave_cursor_alloc(GObject *audio,
+				     guint line);
+void ags_wave_cursor_free(AgsWaveCursor *wave_cursor);
+
+void ags_wave_cursor_seek(AgsWaveCursor *wave_cursor,
+			  guint64 x, guint samplerate);
+guint ags_wave_cursor_read(AgsWaveCursor *wave_cursor,
+			   guint64 x, guint samplerate,
+			   gpointer destination, guint dchannels,
+			   guint frame_count, guint format);
+
 G_END_DECLS
 
 #endif /*__AGS_WAVE_H__*/
@@ -304,6 +304,14 @@ ags_ipatch_sample_init(AgsIpatchSample *ipatch_sample)
   ipatch_sample->length = 0;
 
   ipatch_sample->sample = NULL;
+
+  ipatch_sample->cache_sample = NULL;
+
+  ipatch_sample->cache_audio_channel = 0;
+  ipatch_sample->cache_frame_count = 0;
+  ipatch_sample->cache_format = 0;
+
+  ipatch_sample->cache_data = NULL;
 }
 
 void
@@ -383,6 +391,9 @@ ags_ipatch_sample_set_property(GObject *gobject,
 	return;
       }
 
+      /* the cached view belongs to the previous sample */
+      ags_ipatch_sample_release_data(ipatch_sample);
+      
       if(ipatch_sample->sample != NULL){
 	g_object_unref(ipatch_sample->sample);
       }
@@ -476,6 +487,8 @@ ags_ipatch_sample_finalize(GObject *gobject)
 
   ags_stream_free(ipatch_sample->buffer);
 
+  ags_ipatch_sample_release_data(ipatch_sample);
+
   if(ipatch_sample->sample != NULL){
     g_object_unref(ipatch_sample->sample);
   }
@@ -774,16 +787,18 @@ ags_ipatch_sample_read(AgsSoundResource *sound_resource,
 {
   AgsIpatchSample *ipatch_sample;
 
+  void *data;
+  
   guint total_frame_count;
+  guint data_format;
+  guint read_count;
   guint copy_mode;
+  guint i;
   
   GError *error;
   
   ipatch_sample = AGS_IPATCH_SAMPLE(sound_resource);
 
-  copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(format),
-						  ags_audio_buffer_util_format_from_soundcard(ipatch_sample->format));
-
 #ifdef AGS_WITH_LIBINSTPATCH
   ags_sound_resource_info(sound_resource,
 			  &total_frame_count,
@@ -797,92 +812,126 @@ ags_ipatch_sample_read(AgsSoundResource *sound_resource,
     frame_count = total_frame_count - ipatch_sample->offset;
   }
 
-  error = NULL;
+  /* convert directly from the cached sample data */
+  data = NULL;
 
-  switch(ipatch_sample->format){
-  case AGS_SOUNDCARD_SIGNED_8_BIT:
-    {
-      ipatch_sample_read_transform(IPATCH_SAMPLE(ipatch_sample->sample),
-				   ipatch_sample->offset,
-				   frame_count,
-				   ipatch_sample->buffer,
-				   IPATCH_SAMPLE_8BIT | IPATCH_SAMPLE_MONO,
-				   IPATCH_SAMPLE_MAP_CHANNEL(0, audio_channel),
-				   &error);
-    }
-    break;
-  case AGS_SOUNDCARD_SIGNED_16_BIT:
-    {
-      ipatch_sample_read_transform(IPATCH_SAMPLE(ipatch_sample->sample),
-				   ipatch_sample->offset,
-				   frame_count,
-				   ipatch_sample->buffer,
-				   IPATCH_SAMPLE_16BIT | IPATCH_SAMPLE_MONO,
-				   IPATCH_SAMPLE_MAP_CHANNEL(0, audio_channel),
-				   &error);
-    }
-    break;
-  case AGS_SOUNDCARD_SIGNED_24_BIT:
-    {
-      ipatch_sample_read_transform(IPATCH_SAMPLE(ipatch_sample->sample),
-				   ipatch_sample->offset,
-				   frame_count,
-				   ipatch_sample->buffer,
-				   IPATCH_SAMPLE_24BIT | IPATCH_SAMPLE_MONO,
-				   IPATCH_SAMPLE_MAP_CHANNEL(0, audio_channel),
-				   &error);
-    }
-    break;
-  case AGS_SOUNDCARD_SIGNED_32_BIT:
-    {
-      ipatch_sample_read_transform(IPATCH_SAMPLE(ipatch_sample->sample),
-				   ipatch_sample->offset,
-				   frame_count,
-				   ipatch_sample->buffer,
-				   IPATCH_SAMPLE_32BIT | IPATCH_SAMPLE_MONO,
-				   IPATCH_SAMPLE_MAP_CHANNEL(0, audio_channel),
-				   &error);
-    }
-    break;
-  case AGS_SOUNDCARD_FLOAT:
-    {
-      ipatch_sample_read_transform(IPATCH_SAMPLE(ipatch_sample->sample),
-				   ipatch_sample->offset,
-				   frame_count,
-				   ipatch_sample->buffer,
-				   IPATCH_SAMPLE_FLOAT | IPATCH_SAMPLE_MONO,
-				   IPATCH_SAMPLE_MAP_CHANNEL(0, audio_channel),
-				   &error);
-    }
-    break;
-  case AGS_SOUNDCARD_DOUBLE:
-    {
-      ipatch_sample_read_transform(IPATCH_SAMPLE(ipatch_sample->sample),
-				   ipatch_sample->offset,
-				   frame_count,
-				   ipatch_sample->buffer,
-				   IPATCH_SAMPLE_DOUBLE | IPATCH_SAMPLE_MONO,
-				   IPATCH_SAMPLE_MAP_CHANNEL(0, audio_channel),
-				   &error);
+  data_format = 0;
+  
+  if(ags_ipatch_sample_get_data(ipatch_sample,
+				audio_channel,
+				&data,
+				NULL,
+				&data_format)){
+    copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(format),
+						    ags_audio_buffer_util_format_from_soundcard(data_format));
+
+    ags_audio_buffer_util_copy_buffer_to_buffer(dbuffer, daudio_channels, 0,
+						data, 1, ipatch_sample->offset,
+						frame_count, copy_mode);
+
+    ipatch_sample->offset += frame_count;
+    
+    return(frame_count);
+  }
+  
+  copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(format),
+						  ags_audio_buffer_util_format_from_soundcard(ipatch_sample->format));
+
+  /* transform in chunks of buffer size */
+  for(i = 0; i < frame_count; i += read_count){
+    read_count = ipatch_sample->buffer_size;
+
+    if(i + read_count > frame_count){
+      read_count = frame_count - i;
     }
-    break;
-  default:
-    {
-      g_warning("unsupported format");
+    
+    error = NULL;
+    
+    switch(ipatch_sample->format){
+    case AGS_SOUNDCARD_SIGNED_8_BIT:
+      {
+	ipatch_sample_read_transform(IPATCH_SAMPLE(ipatch_sample->sample),
+				     ipatch_sample->offset,
+				     read_count,
+				     ipatch_sample->buffer,
+				     IPATCH_SAMPLE_8BIT | IPATCH_SAMPLE_MONO,
+				     IPATCH_SAMPLE_MAP_CHANNEL(0, audio_channel),
+				     &error);
+      }
+      break;
+    case AGS_SOUNDCARD_SIGNED_16_BIT:
+      {
+	ipatch_sample_read_transform(IPATCH_SAMPLE(ipatch_sample->sample),
+				     ipatch_sample->offset,
+				     read_count,
+				     ipatch_sample->buffer,
+				     IPATCH_SAMPLE_16BIT | IPATCH_SAMPLE_MONO,
+				     IPATCH_SAMPLE_MAP_CHANNEL(0, audio_channel),
+				     &error);
+      }
+      break;
+    case AGS_SOUNDCARD_SIGNED_24_BIT:
+      {
+	ipatch_sample_read_transform(IPATCH_SAMPLE(ipatch_sample->sample),
+				     ipatch_sample->offset,
+				     read_count,
+				     ipatch_sample->buffer,
+				     IPATCH_SAMPLE_24BIT | IPATCH_SAMPLE_MONO,
+				     IPATCH_SAMPLE_MAP_CHANNEL(0, audio_channel),
+				     &error);
+      }
+      break;
+    case AGS_SOUNDCARD_SIGNED_32_BIT:
+      {
+	ipatch_sample_read_transform(IPATCH_SAMPLE(ipatch_sample->sample),
+				     ipatch_sample->offset,
+				     read_count,
+				     ipatch_sample->buffer,
+				     IPATCH_SAMPLE_32BIT | IPATCH_SAMPLE_MONO,
+				     IPATCH_SAMPLE_MAP_CHANNEL(0, audio_channel),
+				     &error);
+      }
+      break;
+    case AGS_SOUNDCARD_FLOAT:
+      {
+	ipatch_sample_read_transform(IPATCH_SAMPLE(ipatch_sample->sample),
+				     ipatch_sample->offset,
+				     read_count,
+				     ipatch_sample->buffer,
+				     IPATCH_SAMPLE_FLOAT | IPATCH_SAMPLE_MONO,
+				     IPATCH_SAMPLE_MAP_CHANNEL(0, audio_channel),
+				     &error);
+      }
+      break;
+    case AGS_SOUNDCARD_DOUBLE:
+      {
+	ipatch_sample_read_transform(IPATCH_SAMPLE(ipatch_sample->sample),
+				     ipatch_sample->offset,
+				     read_count,
+				     ipatch_sample->buffer,
+				     IPATCH_SAMPLE_DOUBLE | IPATCH_SAMPLE_MONO,
+				     IPATCH_SAMPLE_MAP_CHANNEL(0, audio_channel),
+				     &error);
+      }
+      break;
+    default:
+      {
+	g_warning("unsupported format");
+      }
     }
-  }
 
-  if(error != NULL){
-    g_message("%s", error->message);
+    if(error != NULL){
+      g_message("%s", error->message);
 
-    g_error_free(error);
-  }
+      g_error_free(error);
+    }
   
-  ags_audio_buffer_util_copy_buffer_to_buffer(dbuffer, daudio_channels, 0,
-					      ipatch_sample->buffer, 1, 0,
-					      frame_count, copy_mode);
+    ags_audio_buffer_util_copy_buffer_to_buffer(dbuffer, daudio_channels, i * daudio_channels,
+						ipatch_sample->buffer, 1, 0,
+						read_count, copy_mode);
 
-  ipatch_sample->offset += frame_count;
+    ipatch_sample->offset += read_count;
+  }
 #else
   frame_count = 0;
 #endif
@@ -1145,6 +1194,214 @@ ags_ipatch_sample_unset_flags(AgsIpatchSample *ipatch_sample, guint flags)
   g_rec_mutex_unlock(ipatch_sample_mutex);
 }
 
+/**
+ * ags_ipatch_sample_get_data:
+ * @ipatch_sample: the #AgsIpatchSample
+ * @audio_channel: the audio channel
+ * @data: (out) (transfer none): return location of the sample data
+ * @frame_count: (out): return location of the frame count
+ * @format: (out): return location of the #AgsSoundcardFormat of @data
+ *
+ * Get a view of @audio_channel's sample data, kept in libinstpatch's sample
+ * cache with the native sample width. The sample data is converted once and
+ * shared by all #AgsIpatchSample of the same sample, so no copy is made
+ * per read. The view stays valid until ags_ipatch_sample_release_data() or
+ * @ipatch_sample is finalized.
+ *
+ * Returns: %TRUE on success, otherwise %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_ipatch_sample_get_data(AgsIpatchSample *ipatch_sample,
+			   guint audio_channel,
+			   void **data,
+			   guint *frame_count,
+			   guint *format)
+{
+#ifdef AGS_WITH_LIBINSTPATCH
+  IpatchSampleData *sample_data;
+  IpatchSampleStore *cache_sample;
+  
+  gint sample_format;
+  gint cache_sample_format;
+  guint sample_frame_count;
+  guint cache_format;
+
+  GError *error;
+#endif
+
+  GRecMutex *ipatch_sample_mutex;
+
+  if(!AGS_IS_IPATCH_SAMPLE(ipatch_sample)){
+    return(FALSE);
+  }
+
+  /* get ipatch sample mutex */
+  ipatch_sample_mutex = AGS_IPATCH_SAMPLE_GET_OBJ_MUTEX(ipatch_sample);
+
+#ifdef AGS_WITH_LIBINSTPATCH
+  g_rec_mutex_lock(ipatch_sample_mutex);
+
+  if(ipatch_sample->sample == NULL){
+    g_rec_mutex_unlock(ipatch_sample_mutex);
+
+    return(FALSE);
+  }
+  
+  if(ipatch_sample->cache_sample != NULL &&
+     ipatch_sample->cache_audio_channel != audio_channel){
+    ags_ipatch_sample_release_data(ipatch_sample);
+  }
+
+  if(ipatch_sample->cache_sample == NULL){
+    sample_data = NULL;
+
+    sample_format = 0;
+    sample_frame_count = 0;
+    
+    g_object_get(ipatch_sample->sample,
+		 "sample-data", &sample_data,
+		 "sample-format", &sample_format,
+		 "sample-size", &sample_frame_count,
+		 NULL);
+
+    if(sample_data == NULL){
+      g_rec_mutex_unlock(ipatch_sample_mutex);
+
+      return(FALSE);
+    }
+    
+    /* keep the native width, only the channel and byte order are mapped */
+    switch(IPATCH_SAMPLE_FORMAT_GET_WIDTH(sample_format)){
+    case IPATCH_SAMPLE_8BIT:
+      {
+	cache_sample_format = IPATCH_SAMPLE_8BIT;
+	cache_format = AGS_SOUNDCARD_SIGNED_8_BIT;
+      }
+      break;
+    case IPATCH_SAMPLE_24BIT:
+    case IPATCH_SAMPLE_REAL24BIT:
+      {
+	cache_sample_format = IPATCH_SAMPLE_24BIT;
+	cache_format = AGS_SOUNDCARD_SIGNED_24_BIT;
+      }
+      break;
+    case IPATCH_SAMPLE_32BIT:
+      {
+	cache_sample_format = IPATCH_SAMPLE_32BIT;
+	cache_format = AGS_SOUNDCARD_SIGNED_32_BIT;
+      }
+      break;
+    case IPATCH_SAMPLE_FLOAT:
+      {
+	cache_sample_format = IPATCH_SAMPLE_FLOAT;
+	cache_format = AGS_SOUNDCARD_FLOAT;
+      }
+      break;
+    case IPATCH_SAMPLE_DOUBLE:
+      {
+	cache_sample_format = IPATCH_SAMPLE_DOUBLE;
+	cache_format = AGS_SOUNDCARD_DOUBLE;
+      }
+      break;
+    default:
+      {
+	cache_sample_format = IPATCH_SAMPLE_16BIT;
+	cache_format = AGS_SOUNDCARD_SIGNED_16_BIT;
+      }
+    }
+
+    error = NULL;
+    cache_sample = ipatch_sample_data_get_cache_sample(sample_data,
+						       cache_sample_format | IPATCH_SAMPLE_MONO | IPATCH_SAMPLE_ENDIAN_HOST,
+						       IPATCH_SAMPLE_MAP_CHANNEL(0, audio_channel),
+						       &error);
+
+    g_object_unref(sample_data);
+
+    if(error != NULL){
+      g_message("%s", error->message);
+
+      g_error_free(error);
+    }
+
+    if(cache_sample == NULL){
+      g_rec_mutex_unlock(ipatch_sample_mutex);
+
+      return(FALSE);
+    }
+
+    /* keep the cache from being expired while in use */
+    ipatch_sample_store_cache_open((IpatchSampleStoreCache *) cache_sample);
+    
+    ipatch_sample->cache_sample = cache_sample;
+
+    ipatch_sample->cache_audio_channel = audio_channel;
+    ipatch_sample->cache_frame_count = sample_frame_count;
+    ipatch_sample->cache_format = cache_format;
+
+    ipatch_sample->cache_data = ipatch_sample_store_cache_get_location((IpatchSampleStoreCache *) cache_sample);
+  }
+  
+  if(data != NULL){
+    data[0] = ipatch_sample->cache_data;
+  }
+
+  if(frame_count != NULL){
+    frame_count[0] = ipatch_sample->cache_frame_count;
+  }
+
+  if(format != NULL){
+    format[0] = ipatch_sample->cache_format;
+  }
+
+  g_rec_mutex_unlock(ipatch_sample_mutex);
+
+  return(TRUE);
+#else
+  return(FALSE);
+#endif
+}
+
+/**
+ * ags_ipatch_sample_release_data:
+ * @ipatch_sample: the #AgsIpatchSample
+ *
+ * Release the sample data view obtained by ags_ipatch_sample_get_data().
+ *
+ * Since: 3.5.0
+ */
+void
+ags_ipatch_sample_release_data(AgsIpatchSample *ipatch_sample)
+{
+  GRecMutex *ipatch_sample_mutex;
+
+  if(!AGS_IS_IPATCH_SAMPLE(ipatch_sample)){
+    return;
+  }
+
+  /* get ipatch sample mutex */
+  ipatch_sample_mutex = AGS_IPATCH_SAMPLE_GET_OBJ_MUTEX(ipatch_sample);
+
+  g_rec_mutex_lock(ipatch_sample_mutex);
+
+#ifdef AGS_WITH_LIBINSTPATCH
+  if(ipatch_sample->cache_sample != NULL){
+    ipatch_sample_store_cache_close((IpatchSampleStoreCache *) ipatch_sample->cache_sample);
+
+    g_object_unref(ipatch_sample->cache_sample);
+  }
+#endif
+  
+  ipatch_sample->cache_sample = NULL;
+
+  ipatch_sample->cache_frame_count = 0;
+  ipatch_sample->cache_data = NULL;
+  
+  g_rec_mutex_unlock(ipatch_sample_mutex);
+}
+
 /**
  * ags_ipatch_sample_new:
  *
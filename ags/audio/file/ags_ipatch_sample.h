@@ -89,6 +89,18 @@ struct _AgsIpatchSample
 #else
   gpointer sample;
 #endif
+
+#ifdef AGS_WITH_LIBINSTPATCH
+  IpatchSampleStore *cache_sample;
+#else
+  gpointer cache_sample;
+#endif
+
+  guint cache_audio_channel;
+  guint cache_frame_count;
+  guint cache_format;
+  
+  void *cache_data;
 };
 
 struct _AgsIpatchSampleClass
@@ -102,6 +114,13 @@ gboolean ags_ipatch_sample_test_flags(AgsIpatchSample *ipatch_sample, guint flag
 void ags_ipatch_sample_set_flags(AgsIpatchSample *ipatch_sample, guint flags);
 void ags_ipatch_sample_unset_flags(AgsIpatchSample *ipatch_sample, guint flags);
 
+gboolean ags_ipatch_sample_get_data(AgsIpatchSample *ipatch_sample,
+				    guint audio_channel,
+				    void **data,
+				    guint *frame_count,
+				    guint *format);
+void ags_ipatch_sample_release_data(AgsIpatchSample *ipatch_sample);
+
 /* instantiate */
 AgsIpatchSample* ags_ipatch_sample_new();
 
@@ -90,6 +90,8 @@ void ags_sfz_sample_seek(AgsSoundResource *sound_resource,
 			 gint64 frame_count, gint whence);
 void ags_sfz_sample_close(AgsSoundResource *sound_resource);
 
+gboolean ags_sfz_sample_decode(AgsSFZSample *sfz_sample);
+
 /**
  * SECTION:ags_sfz_sample
  * @short_description: interfacing SFZ samples
@@ -401,6 +403,9 @@ ags_sfz_sample_init(AgsSFZSample *sfz_sample)
   sfz_sample->buffer_offset = 0;
 
   sfz_sample->full_buffer = NULL;
+  sfz_sample->full_buffer_frame_count = 0;
+  sfz_sample->full_buffer_format = 0;
+  
   sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * sfz_sample->buffer_size,
 					sfz_sample->format);
 
@@ -758,6 +763,10 @@ ags_sfz_sample_finalize(GObject *gobject)
   
   ags_stream_free(sfz_sample->buffer);
 
+  if(sfz_sample->full_buffer != NULL){
+    ags_stream_free(sfz_sample->full_buffer);
+  }
+
   if(sfz_sample->region != NULL){
     g_object_unref(sfz_sample->region);
   }
@@ -1025,6 +1034,8 @@ ags_sfz_sample_open(AgsSoundResource *sound_resource,
   g_message("ags_sfz_sample_open(): channels %d frames %d", sfz_sample->info->channels, sfz_sample->info->frames);
 #endif
 
+  /* decoded by the first ags_sfz_sample_get_data(), not at load */
+  
   return(TRUE);
 }
 
@@ -1354,8 +1365,12 @@ ags_sfz_sample_read(AgsSoundResource *sound_resource,
 {
   AgsSFZSample *sfz_sample;
 
+  void *data;
+  
   sf_count_t multi_frames;
   guint total_frame_count;
+  guint data_audio_channels;
+  guint data_format;
   guint read_count;
   guint copy_mode;
   gboolean use_cache;
@@ -1390,6 +1405,26 @@ ags_sfz_sample_read(AgsSoundResource *sound_resource,
     }
   }
 
+  /* convert directly from the decoded sample data */
+  if(ags_sfz_sample_get_data(sfz_sample,
+			     &data,
+			     &data_audio_channels,
+			     NULL,
+			     &data_format)){
+    copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(format),
+						    ags_audio_buffer_util_format_from_soundcard(data_format));
+
+    ags_audio_buffer_util_copy_buffer_to_buffer(dbuffer, daudio_channels, 0,
+						data, data_audio_channels, (sfz_sample->offset * data_audio_channels) + audio_channel,
+						frame_count, copy_mode);
+
+    sfz_sample->offset += frame_count;
+    
+    g_rec_mutex_unlock(sfz_sample_mutex);
+
+    return(frame_count);
+  }
+  
 #if 0
   use_cache = FALSE;
 
@@ -1785,6 +1820,245 @@ ags_sfz_sample_unset_flags(AgsSFZSample *sfz_sample, guint flags)
   g_rec_mutex_unlock(sfz_sample_mutex);
 }
 
+gboolean
+ags_sfz_sample_decode(AgsSFZSample *sfz_sample)
+{
+  void *full_buffer;
+  
+  sf_count_t retval;
+  guint channels;
+  guint frames;
+  guint full_buffer_format;
+  guint i;
+  
+  GRecMutex *sfz_sample_mutex;
+
+  /* get sfz sample mutex */
+  sfz_sample_mutex = AGS_SFZ_SAMPLE_GET_OBJ_MUTEX(sfz_sample);
+
+  g_rec_mutex_lock(sfz_sample_mutex);
+
+  if(sfz_sample->full_buffer != NULL){
+    g_rec_mutex_unlock(sfz_sample_mutex);
+
+    return(TRUE);
+  }
+  
+  if(sfz_sample->file == NULL ||
+     sfz_sample->info == NULL ||
+     sfz_sample->info->channels <= 0 ||
+     sfz_sample->info->frames <= 0 ||
+     sfz_sample->info->frames > G_MAXUINT32){
+    g_rec_mutex_unlock(sfz_sample_mutex);
+
+    return(FALSE);
+  }
+
+  channels = (guint) sfz_sample->info->channels;
+  frames = (guint) sfz_sample->info->frames;
+  
+  /* keep the native width, ags_pitch_util_resample_data() converts */
+  switch(sfz_sample->info->format & SF_FORMAT_SUBMASK){
+  case SF_FORMAT_PCM_S8:
+  case SF_FORMAT_PCM_U8:
+  {
+    full_buffer_format = AGS_SOUNDCARD_SIGNED_8_BIT;
+  }
+  break;
+  case SF_FORMAT_PCM_16:
+  {
+    full_buffer_format = AGS_SOUNDCARD_SIGNED_16_BIT;
+  }
+  break;
+  case SF_FORMAT_PCM_24:
+  {
+    full_buffer_format = AGS_SOUNDCARD_SIGNED_24_BIT;
+  }
+  break;
+  case SF_FORMAT_PCM_32:
+  {
+    full_buffer_format = AGS_SOUNDCARD_SIGNED_32_BIT;
+  }
+  break;
+  case SF_FORMAT_FLOAT:
+  {
+    full_buffer_format = AGS_SOUNDCARD_FLOAT;
+  }
+  break;
+  default:
+  {
+    full_buffer_format = AGS_SOUNDCARD_DOUBLE;
+  }
+  }
+
+  full_buffer = ags_stream_alloc(channels * frames,
+				 full_buffer_format);
+
+  sf_seek(sfz_sample->file, 0, SEEK_SET);
+
+  retval = -1;
+    
+  switch(full_buffer_format){
+  case AGS_SOUNDCARD_SIGNED_8_BIT:
+  case AGS_SOUNDCARD_SIGNED_24_BIT:
+  {
+    gint32 *chunk;
+
+    sf_count_t chunk_count;
+    guint offset;
+    guint shift;
+    
+    /* libsndfile reads no 8 or 24 bit, narrow chunks of left aligned 32 bit */
+    chunk = (gint32 *) g_malloc(channels * AGS_SFZ_SAMPLE_DECODE_CHUNK_SIZE * sizeof(gint32));
+
+    shift = (full_buffer_format == AGS_SOUNDCARD_SIGNED_8_BIT) ? 24: 8;
+    
+    retval = 0;
+    
+    for(offset = 0; offset < frames; offset += (guint) chunk_count){
+      chunk_count = frames - offset;
+
+      if(chunk_count > AGS_SFZ_SAMPLE_DECODE_CHUNK_SIZE){
+	chunk_count = AGS_SFZ_SAMPLE_DECODE_CHUNK_SIZE;
+      }
+
+      chunk_count = sf_readf_int(sfz_sample->file, chunk, chunk_count);
+
+      if(chunk_count <= 0){
+	break;
+      }
+
+      if(full_buffer_format == AGS_SOUNDCARD_SIGNED_8_BIT){
+	for(i = 0; i < channels * (guint) chunk_count; i++){
+	  ((gint8 *) full_buffer)[channels * offset + i] = (gint8) (chunk[i] >> shift);
+	}
+      }else{
+	for(i = 0; i < channels * (guint) chunk_count; i++){
+	  ((gint32 *) full_buffer)[channels * offset + i] = (chunk[i] >> shift);
+	}
+      }
+
+      retval += chunk_count;
+    }
+
+    g_free(chunk);
+  }
+  break;
+  case AGS_SOUNDCARD_SIGNED_16_BIT:
+  {
+    retval = sf_readf_short(sfz_sample->file, full_buffer, frames);
+  }
+  break;
+  case AGS_SOUNDCARD_SIGNED_32_BIT:
+  {
+    retval = sf_readf_int(sfz_sample->file, full_buffer, frames);
+  }
+  break;
+  case AGS_SOUNDCARD_FLOAT:
+  {
+    retval = sf_readf_float(sfz_sample->file, full_buffer, frames);
+  }
+  break;
+  case AGS_SOUNDCARD_DOUBLE:
+  {
+    retval = sf_readf_double(sfz_sample->file, full_buffer, frames);
+  }
+  break;
+  }
+    
+  /* restore streaming position */
+  sf_seek(sfz_sample->file, sfz_sample->offset, SEEK_SET);
+
+  if(retval != sfz_sample->info->frames){
+    g_warning("read failed");
+
+    ags_stream_free(full_buffer);
+      
+    g_rec_mutex_unlock(sfz_sample_mutex);
+
+    return(FALSE);
+  }
+
+  sfz_sample->full_buffer = full_buffer;
+  
+  sfz_sample->full_buffer_frame_count = frames;
+  sfz_sample->full_buffer_format = full_buffer_format;
+  
+  g_rec_mutex_unlock(sfz_sample_mutex);
+
+  return(TRUE);
+}
+
+/**
+ * ags_sfz_sample_get_data:
+ * @sfz_sample: the #AgsSFZSample
+ * @data: (out) (transfer none): return location of the interleaved sample data
+ * @audio_channels: (out): return location of the audio channels of @data
+ * @frame_count: (out): return location of the frame count
+ * @format: (out): return location of the #AgsSoundcardFormat of @data
+ *
+ * Get a view of the sample data. The file is decoded by the first call with
+ * the native sample width of the file and kept for the lifetime of
+ * @sfz_sample, so later reads don't touch the file. The view is only
+ * available as long as #AgsSFZSample:audio-channels matches the channels
+ * of the file.
+ *
+ * Returns: %TRUE on success, otherwise %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_sfz_sample_get_data(AgsSFZSample *sfz_sample,
+			void **data,
+			guint *audio_channels,
+			guint *frame_count,
+			guint *format)
+{
+  GRecMutex *sfz_sample_mutex;
+
+  if(!AGS_IS_SFZ_SAMPLE(sfz_sample)){
+    return(FALSE);
+  }
+
+  /* get sfz sample mutex */
+  sfz_sample_mutex = AGS_SFZ_SAMPLE_GET_OBJ_MUTEX(sfz_sample);
+
+  g_rec_mutex_lock(sfz_sample_mutex);
+
+  /* decode lazily */
+  if(sfz_sample->full_buffer == NULL){
+    ags_sfz_sample_decode(sfz_sample);
+  }
+  
+  if(sfz_sample->full_buffer == NULL ||
+     sfz_sample->info == NULL ||
+     sfz_sample->audio_channels != (guint) sfz_sample->info->channels){
+    g_rec_mutex_unlock(sfz_sample_mutex);
+
+    return(FALSE);
+  }
+  
+  if(data != NULL){
+    data[0] = sfz_sample->full_buffer;
+  }
+
+  if(audio_channels != NULL){
+    audio_channels[0] = (guint) sfz_sample->info->channels;
+  }
+
+  if(frame_count != NULL){
+    frame_count[0] = sfz_sample->full_buffer_frame_count;
+  }
+
+  if(format != NULL){
+    format[0] = sfz_sample->full_buffer_format;
+  }
+
+  g_rec_mutex_unlock(sfz_sample_mutex);
+
+  return(TRUE);
+}
+
 /**
  * ags_sfz_sample_new:
  *
@@ -38,6 +38,8 @@ G_BEGIN_DECLS
 
 #define AGS_SFZ_SAMPLE_GET_OBJ_MUTEX(obj) (&(((AgsSFZSample *) obj)->obj_mutex))
 
+#define AGS_SFZ_SAMPLE_DECODE_CHUNK_SIZE (4096)
+
 typedef struct _AgsSFZSample AgsSFZSample;
 typedef struct _AgsSFZSampleClass AgsSFZSampleClass;
 
@@ -79,6 +81,9 @@ struct _AgsSFZSample
   guint64 buffer_offset;
 
   void *full_buffer;
+  guint full_buffer_frame_count;
+  guint full_buffer_format;
+  
   void *buffer;
 
   guchar *pointer;
@@ -103,6 +108,12 @@ gboolean ags_sfz_sample_test_flags(AgsSFZSample *sfz_sample, guint flags);
 void ags_sfz_sample_set_flags(AgsSFZSample *sfz_sample, guint flags);
 void ags_sfz_sample_unset_flags(AgsSFZSample *sfz_sample, guint flags);
 
+gboolean ags_sfz_sample_get_data(AgsSFZSample *sfz_sample,
+				 void **data,
+				 guint *audio_channels,
+				 guint *frame_count,
+				 guint *format);
+
 /* instantiate */
 AgsSFZSample* ags_sfz_sample_new();
 
@@ -584,7 +584,7 @@ ags_sound_resource_read_wave(AgsSoundResource *sound_resource,
 			     guint64 x_offset,
 			     gdouble delay, guint attack)
 {
-  GList *start_list;
+  GList *start_list, *list;
 
   void *target_data, *data;
 
@@ -803,6 +803,16 @@ ags_sound_resource_read_wave(AgsSoundResource *sound_resource,
     free(target_data);
   }  
 
+  /* decoded waves are unmodified */
+  list = start_list;
+
+  while(list != NULL){
+    ags_wave_unset_flags(list->data,
+			 AGS_WAVE_MODIFIED);
+
+    list = list->next;
+  }
+  
   g_list_foreach(start_list,
 		 (GFunc) g_object_ref,
 		 NULL);
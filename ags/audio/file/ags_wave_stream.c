@@ -0,0 +1,1654 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <ags/audio/file/ags_wave_stream.h>
+
+#include <ags/audio/ags_audio_signal.h>
+#include <ags/audio/ags_audio_buffer_util.h>
+
+#include <ags/audio/file/ags_sound_resource.h>
+#include <ags/audio/file/ags_audio_file.h>
+
+#include <ags/i18n.h>
+
+void ags_wave_stream_class_init(AgsWaveStreamClass *wave_stream);
+void ags_wave_stream_init(AgsWaveStream *wave_stream);
+void ags_wave_stream_set_property(GObject *gobject,
+				  guint prop_id,
+				  const GValue *value,
+				  GParamSpec *param_spec);
+void ags_wave_stream_get_property(GObject *gobject,
+				  guint prop_id,
+				  GValue *value,
+				  GParamSpec *param_spec);
+void ags_wave_stream_dispose(GObject *gobject);
+void ags_wave_stream_finalize(GObject *gobject);
+
+guint ags_wave_stream_word_size(guint format);
+void ags_wave_stream_update_max_blocks(AgsWaveStream *wave_stream);
+void ags_wave_stream_alloc_ring(AgsWaveStream *wave_stream);
+void ags_wave_stream_drop_ring(AgsWaveStream *wave_stream);
+AgsWaveStreamBlock* ags_wave_stream_lookup_block(AgsWaveStream *wave_stream,
+						 guint64 index);
+AgsWaveStreamBlock* ags_wave_stream_claim_block(AgsWaveStream *wave_stream,
+						guint64 index,
+						guint64 *wanted, guint n_wanted);
+AgsWaveStreamBlock* ags_wave_stream_acquire_block(AgsWaveStreamBlock **ring, guint ring_size,
+						  guint64 index);
+
+void* ags_wave_stream_io_thread(void *ptr);
+
+/**
+ * SECTION:ags_wave_stream
+ * @short_description: stream wave from disk
+ * @title: AgsWaveStream
+ * @section_id:
+ * @include: ags/audio/file/ags_wave_stream.h
+ *
+ * The #AgsWaveStream plays a long audio file without decoding it into
+ * resident #AgsBuffer. It keeps a bounded cache of decoded blocks around
+ * the playhead, filled by its own I/O thread. The loop start is prefetched
+ * while looping, so wrapping around doesn't miss.
+ *
+ * The decoded blocks are kept in a ring of slots allocated when the I/O
+ * thread starts. The audio thread reads them without taking any lock, so
+ * the block size, format and memory budget can't be changed afterwards.
+ *
+ * The #AgsSoundResource is owned by the I/O thread, don't share it.
+ */
+
+enum{
+  PROP_0,
+  PROP_SOUND_RESOURCE,
+  PROP_AUDIO_CHANNEL,
+  PROP_SAMPLERATE,
+  PROP_FORMAT,
+  PROP_X_OFFSET,
+  PROP_BLOCK_SIZE,
+  PROP_MEMORY_BUDGET,
+};
+
+static gpointer ags_wave_stream_parent_class = NULL;
+
+GType
+ags_wave_stream_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_wave_stream = 0;
+
+    static const GTypeInfo ags_wave_stream_info = {
+      sizeof (AgsWaveStreamClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_wave_stream_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof (AgsWaveStream),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_wave_stream_init,
+    };
+
+    ags_type_wave_stream = g_type_register_static(G_TYPE_OBJECT,
+						  "AgsWaveStream",
+						  &ags_wave_stream_info,
+						  0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_wave_stream);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_wave_stream_class_init(AgsWaveStreamClass *wave_stream)
+{
+  GObjectClass *gobject;
+
+  GParamSpec *param_spec;
+
+  ags_wave_stream_parent_class = g_type_class_peek_parent(wave_stream);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) wave_stream;
+
+  gobject->set_property = ags_wave_stream_set_property;
+  gobject->get_property = ags_wave_stream_get_property;
+
+  gobject->dispose = ags_wave_stream_dispose;
+  gobject->finalize = ags_wave_stream_finalize;
+
+  /* properties */
+  /**
+   * AgsWaveStream:sound-resource:
+   *
+   * The assigned #AgsSoundResource to decode from.
+   * 
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_object("sound-resource",
+				   i18n_pspec("assigned sound resource"),
+				   i18n_pspec("The sound resource it is assigned with"),
+				   G_TYPE_OBJECT,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_SOUND_RESOURCE,
+				  param_spec);
+
+  /**
+   * AgsWaveStream:audio-channel:
+   *
+   * The audio channel of the sound resource to stream.
+   * 
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_uint("audio-channel",
+				 i18n_pspec("audio channel"),
+				 i18n_pspec("The audio channel to stream"),
+				 0,
+				 G_MAXUINT32,
+				 0,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_AUDIO_CHANNEL,
+				  param_spec);
+
+  /**
+   * AgsWaveStream:samplerate:
+   *
+   * The samplerate of the sound resource.
+   * 
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_uint("samplerate",
+				 i18n_pspec("samplerate"),
+				 i18n_pspec("The samplerate of the sound resource"),
+				 0,
+				 G_MAXUINT32,
+				 AGS_SOUNDCARD_DEFAULT_SAMPLERATE,
+				 G_PARAM_READABLE);
+  g_object_class_install_property(gobject,
+				  PROP_SAMPLERATE,
+				  param_spec);
+
+  /**
+   * AgsWaveStream:format:
+   *
+   * The format of the decoded blocks, fixed once the ring was allocated.
+   * 
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_uint("format",
+				 i18n_pspec("format"),
+				 i18n_pspec("The format of the decoded blocks"),
+				 0,
+				 G_MAXUINT32,
+				 AGS_SOUNDCARD_DEFAULT_FORMAT,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_FORMAT,
+				  param_spec);
+
+  /**
+   * AgsWaveStream:x-offset:
+   *
+   * The timeline offset of the first frame, counted at the samplerate
+   * of the sound resource.
+   * 
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_uint64("x-offset",
+				   i18n_pspec("x offset"),
+				   i18n_pspec("The timeline offset of the first frame"),
+				   0,
+				   G_MAXUINT64,
+				   0,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_X_OFFSET,
+				  param_spec);
+
+  /**
+   * AgsWaveStream:block-size:
+   *
+   * The frame count of a decoded block, fixed once the ring was allocated.
+   * 
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_uint("block-size",
+				 i18n_pspec("block size"),
+				 i18n_pspec("The frame count of a decoded block"),
+				 1,
+				 G_MAXUINT32,
+				 AGS_WAVE_STREAM_DEFAULT_BLOCK_SIZE,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_BLOCK_SIZE,
+				  param_spec);
+
+  /**
+   * AgsWaveStream:memory-budget:
+   *
+   * The maximum bytes of decoded blocks to keep, fixed once the ring was
+   * allocated.
+   * 
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_uint64("memory-budget",
+				   i18n_pspec("memory budget"),
+				   i18n_pspec("The maximum bytes of decoded blocks to keep"),
+				   0,
+				   G_MAXUINT64,
+				   AGS_WAVE_STREAM_DEFAULT_MEMORY_BUDGET,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_MEMORY_BUDGET,
+				  param_spec);
+}
+
+void
+ags_wave_stream_init(AgsWaveStream *wave_stream)
+{
+  wave_stream->flags = 0;
+
+  g_rec_mutex_init(&(wave_stream->obj_mutex));
+
+  wave_stream->sound_resource = NULL;
+  wave_stream->audio_channel = 0;
+
+  wave_stream->samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+  wave_stream->format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+
+  wave_stream->x_offset = 0;
+  wave_stream->frame_count = 0;
+
+  wave_stream->block_size = AGS_WAVE_STREAM_DEFAULT_BLOCK_SIZE;
+  wave_stream->read_ahead = AGS_WAVE_STREAM_DEFAULT_READ_AHEAD;
+  wave_stream->loop_ahead = AGS_WAVE_STREAM_DEFAULT_LOOP_AHEAD;
+
+  wave_stream->memory_budget = AGS_WAVE_STREAM_DEFAULT_MEMORY_BUDGET;
+  wave_stream->max_blocks = 0;
+
+  ags_wave_stream_update_max_blocks(wave_stream);
+  
+  wave_stream->ring = NULL;
+  wave_stream->ring_size = 0;
+  
+  g_atomic_int_set(&(wave_stream->tick),
+		   0);
+
+  g_atomic_int_set(&(wave_stream->playhead_block),
+		   0);
+
+  wave_stream->loop_start = 0;
+  wave_stream->loop_end = 0;
+
+  g_atomic_int_set(&(wave_stream->generation),
+		   0);
+
+  wave_stream->io_thread = NULL;
+
+  g_mutex_init(&(wave_stream->io_mutex));
+  g_cond_init(&(wave_stream->io_cond));
+
+  g_atomic_int_set(&(wave_stream->hit),
+		   0);
+  g_atomic_int_set(&(wave_stream->miss),
+		   0);
+}
+
+void
+ags_wave_stream_set_property(GObject *gobject,
+			     guint prop_id,
+			     const GValue *value,
+			     GParamSpec *param_spec)
+{
+  AgsWaveStream *wave_stream;
+
+  GRecMutex *wave_stream_mutex;
+
+  wave_stream = AGS_WAVE_STREAM(gobject);
+
+  /* get wave stream mutex */
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  switch(prop_id){
+  case PROP_SOUND_RESOURCE:
+  {
+    GObject *sound_resource;
+
+    guint frame_count;
+    guint samplerate;
+    guint format;
+    
+    sound_resource = g_value_get_object(value);
+
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    if(wave_stream->sound_resource == sound_resource){
+      g_rec_mutex_unlock(wave_stream_mutex);
+	
+      return;
+    }
+
+    if(wave_stream->sound_resource != NULL){
+      g_object_unref(wave_stream->sound_resource);
+    }
+
+    frame_count = 0;
+
+    samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+    format = wave_stream->format;
+    
+    if(sound_resource != NULL){
+      g_object_ref(sound_resource);
+
+      ags_sound_resource_info(AGS_SOUND_RESOURCE(sound_resource),
+			      &frame_count,
+			      NULL, NULL);
+
+      ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sound_resource),
+				     NULL,
+				     &samplerate,
+				     NULL,
+				     &format);
+    }
+
+    wave_stream->sound_resource = sound_resource;
+
+    wave_stream->frame_count = frame_count;
+
+    wave_stream->samplerate = samplerate;
+
+    /* the ring keeps its format */
+    if(wave_stream->ring == NULL){
+      wave_stream->format = format;
+    }
+
+    g_atomic_int_or(&(wave_stream->flags),
+		    AGS_WAVE_STREAM_RESET);
+    
+    ags_wave_stream_update_max_blocks(wave_stream);
+
+    g_rec_mutex_unlock(wave_stream_mutex);
+
+    ags_wave_stream_wakeup(wave_stream);
+  }
+  break;
+  case PROP_AUDIO_CHANNEL:
+  {
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    wave_stream->audio_channel = g_value_get_uint(value);
+
+    g_atomic_int_or(&(wave_stream->flags),
+		    AGS_WAVE_STREAM_RESET);
+
+    g_rec_mutex_unlock(wave_stream_mutex);
+
+    ags_wave_stream_wakeup(wave_stream);
+  }
+  break;
+  case PROP_FORMAT:
+  {
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    if(wave_stream->ring != NULL){
+      g_rec_mutex_unlock(wave_stream_mutex);
+	
+      return;
+    }
+    
+    wave_stream->format = g_value_get_uint(value);
+
+    ags_wave_stream_update_max_blocks(wave_stream);
+
+    g_rec_mutex_unlock(wave_stream_mutex);
+  }
+  break;
+  case PROP_X_OFFSET:
+  {
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    wave_stream->x_offset = g_value_get_uint64(value);
+
+    g_rec_mutex_unlock(wave_stream_mutex);
+
+    ags_wave_stream_wakeup(wave_stream);
+  }
+  break;
+  case PROP_BLOCK_SIZE:
+  {
+    guint block_size;
+
+    block_size = g_value_get_uint(value);
+    
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    if(block_size == 0 ||
+       wave_stream->block_size == block_size ||
+       wave_stream->ring != NULL){
+      g_rec_mutex_unlock(wave_stream_mutex);
+	
+      return;
+    }
+    
+    wave_stream->block_size = block_size;
+
+    ags_wave_stream_update_max_blocks(wave_stream);
+
+    g_rec_mutex_unlock(wave_stream_mutex);
+  }
+  break;
+  case PROP_MEMORY_BUDGET:
+  {
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    if(wave_stream->ring != NULL){
+      g_rec_mutex_unlock(wave_stream_mutex);
+	
+      return;
+    }
+
+    wave_stream->memory_budget = g_value_get_uint64(value);
+
+    ags_wave_stream_update_max_blocks(wave_stream);
+
+    g_rec_mutex_unlock(wave_stream_mutex);
+  }
+  break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_wave_stream_get_property(GObject *gobject,
+			     guint prop_id,
+			     GValue *value,
+			     GParamSpec *param_spec)
+{
+  AgsWaveStream *wave_stream;
+
+  GRecMutex *wave_stream_mutex;
+
+  wave_stream = AGS_WAVE_STREAM(gobject);
+
+  /* get wave stream mutex */
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  switch(prop_id){
+  case PROP_SOUND_RESOURCE:
+  {
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    g_value_set_object(value, wave_stream->sound_resource);
+
+    g_rec_mutex_unlock(wave_stream_mutex);
+  }
+  break;
+  case PROP_AUDIO_CHANNEL:
+  {
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    g_value_set_uint(value, wave_stream->audio_channel);
+
+    g_rec_mutex_unlock(wave_stream_mutex);
+  }
+  break;
+  case PROP_SAMPLERATE:
+  {
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    g_value_set_uint(value, wave_stream->samplerate);
+
+    g_rec_mutex_unlock(wave_stream_mutex);
+  }
+  break;
+  case PROP_FORMAT:
+  {
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    g_value_set_uint(value, wave_stream->format);
+
+    g_rec_mutex_unlock(wave_stream_mutex);
+  }
+  break;
+  case PROP_X_OFFSET:
+  {
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    g_value_set_uint64(value, wave_stream->x_offset);
+
+    g_rec_mutex_unlock(wave_stream_mutex);
+  }
+  break;
+  case PROP_BLOCK_SIZE:
+  {
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    g_value_set_uint(value, wave_stream->block_size);
+
+    g_rec_mutex_unlock(wave_stream_mutex);
+  }
+  break;
+  case PROP_MEMORY_BUDGET:
+  {
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    g_value_set_uint64(value, wave_stream->memory_budget);
+
+    g_rec_mutex_unlock(wave_stream_mutex);
+  }
+  break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_wave_stream_dispose(GObject *gobject)
+{
+  AgsWaveStream *wave_stream;
+
+  wave_stream = AGS_WAVE_STREAM(gobject);
+
+  ags_wave_stream_stop(wave_stream);
+
+  if(wave_stream->sound_resource != NULL){
+    g_object_unref(wave_stream->sound_resource);
+
+    wave_stream->sound_resource = NULL;
+  }
+  
+  /* call parent */
+  G_OBJECT_CLASS(ags_wave_stream_parent_class)->dispose(gobject);
+}
+
+void
+ags_wave_stream_finalize(GObject *gobject)
+{
+  AgsWaveStream *wave_stream;
+
+  wave_stream = AGS_WAVE_STREAM(gobject);
+
+  ags_wave_stream_stop(wave_stream);
+
+  if(wave_stream->sound_resource != NULL){
+    g_object_unref(wave_stream->sound_resource);
+  }
+
+  if(wave_stream->ring != NULL){
+    guint i;
+
+    for(i = 0; i < wave_stream->ring_size; i++){
+      ags_wave_stream_block_free(wave_stream->ring[i]);
+    }
+    
+    g_free(wave_stream->ring);
+  }
+
+  g_mutex_clear(&(wave_stream->io_mutex));
+  g_cond_clear(&(wave_stream->io_cond));
+  
+  /* call parent */
+  G_OBJECT_CLASS(ags_wave_stream_parent_class)->finalize(gobject);
+}
+
+guint
+ags_wave_stream_word_size(guint format)
+{
+  switch(format){
+  case AGS_SOUNDCARD_SIGNED_8_BIT:
+    return(sizeof(gint8));
+  case AGS_SOUNDCARD_SIGNED_16_BIT:
+    return(sizeof(gint16));
+  case AGS_SOUNDCARD_SIGNED_24_BIT:
+  case AGS_SOUNDCARD_SIGNED_32_BIT:
+    return(sizeof(gint32));
+  case AGS_SOUNDCARD_SIGNED_64_BIT:
+    return(sizeof(gint64));
+  case AGS_SOUNDCARD_FLOAT:
+    return(sizeof(gfloat));
+  case AGS_SOUNDCARD_DOUBLE:
+    return(sizeof(gdouble));
+  case AGS_SOUNDCARD_COMPLEX:
+    return(sizeof(AgsComplex));
+  }
+
+  return(sizeof(gint16));
+}
+
+void
+ags_wave_stream_update_max_blocks(AgsWaveStream *wave_stream)
+{
+  guint64 block_bytes;
+  guint64 max_blocks;
+  guint min_blocks;
+
+  /* the ring was allocated */
+  if(wave_stream->ring != NULL){
+    return;
+  }
+  
+  block_bytes = (guint64) wave_stream->block_size * ags_wave_stream_word_size(wave_stream->format);
+
+  max_blocks = 0;
+  
+  if(block_bytes > 0){
+    max_blocks = wave_stream->memory_budget / block_bytes;
+  }
+
+  /* the read ahead and loop start must fit, even with a tight budget */
+  min_blocks = wave_stream->read_ahead + wave_stream->loop_ahead;
+
+  if(max_blocks < min_blocks){
+    max_blocks = min_blocks;
+  }
+
+  if(max_blocks > G_MAXUINT32){
+    max_blocks = G_MAXUINT32;
+  }
+  
+  wave_stream->max_blocks = (guint) max_blocks;
+}
+
+/**
+ * ags_wave_stream_block_alloc:
+ * @index: the block index
+ * @block_size: the frame count of the block
+ * @format: the format
+ * 
+ * Allocate #AgsWaveStreamBlock.
+ * 
+ * Returns: (type gpointer) (transfer full): the newly allocated #AgsWaveStreamBlock
+ * 
+ * Since: 3.5.0
+ */
+AgsWaveStreamBlock*
+ags_wave_stream_block_alloc(guint64 index,
+			    guint block_size,
+			    guint format)
+{
+  AgsWaveStreamBlock *block;
+
+  block = (AgsWaveStreamBlock *) g_malloc(sizeof(AgsWaveStreamBlock));
+
+  g_atomic_int_set(&(block->state),
+		   AGS_WAVE_STREAM_BLOCK_EMPTY);
+  g_atomic_int_set(&(block->readers),
+		   0);
+  
+  block->index = index;
+
+  block->data = ags_stream_alloc(block_size,
+				 format);
+  block->frame_count = 0;
+
+  g_atomic_int_set(&(block->last_used),
+		   0);
+  
+  return(block);
+}
+
+/**
+ * ags_wave_stream_block_free:
+ * @block: (type gpointer) (transfer full): the #AgsWaveStreamBlock
+ * 
+ * Free @block.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_wave_stream_block_free(AgsWaveStreamBlock *block)
+{
+  if(block == NULL){
+    return;
+  }
+
+  ags_stream_free(block->data);
+  
+  g_free(block);
+}
+
+void
+ags_wave_stream_alloc_ring(AgsWaveStream *wave_stream)
+{
+  AgsWaveStreamBlock **ring;
+
+  guint i;
+  
+  GRecMutex *wave_stream_mutex;
+
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  g_rec_mutex_lock(wave_stream_mutex);
+
+  if(wave_stream->ring != NULL){
+    g_rec_mutex_unlock(wave_stream_mutex);
+
+    return;
+  }
+
+  ring = (AgsWaveStreamBlock **) g_malloc(wave_stream->max_blocks * sizeof(AgsWaveStreamBlock *));
+
+  for(i = 0; i < wave_stream->max_blocks; i++){
+    ring[i] = ags_wave_stream_block_alloc(0,
+					  wave_stream->block_size,
+					  wave_stream->format);
+  }
+
+  wave_stream->ring_size = wave_stream->max_blocks;
+
+  g_atomic_pointer_set(&(wave_stream->ring),
+		       ring);
+  
+  g_rec_mutex_unlock(wave_stream_mutex);
+}
+
+void
+ags_wave_stream_drop_ring(AgsWaveStream *wave_stream)
+{
+  AgsWaveStreamBlock *block;
+  
+  guint i;
+
+  for(i = 0; i < wave_stream->ring_size; i++){
+    block = wave_stream->ring[i];
+
+    if(g_atomic_int_compare_and_exchange(&(block->state),
+					 AGS_WAVE_STREAM_BLOCK_READY,
+					 AGS_WAVE_STREAM_BLOCK_LOADING)){
+      while(g_atomic_int_get(&(block->readers)) != 0){
+	g_thread_yield();
+      }
+      
+      g_atomic_int_set(&(block->state),
+		       AGS_WAVE_STREAM_BLOCK_EMPTY);
+    }
+  }
+}
+
+AgsWaveStreamBlock*
+ags_wave_stream_lookup_block(AgsWaveStream *wave_stream,
+			     guint64 index)
+{
+  AgsWaveStreamBlock *block;
+  
+  guint i;
+
+  /* only the I/O thread changes the slots, no need to acquire */
+  for(i = 0; i < wave_stream->ring_size; i++){
+    block = wave_stream->ring[i];
+
+    if(g_atomic_int_get(&(block->state)) == AGS_WAVE_STREAM_BLOCK_READY &&
+       block->index == index){
+      return(block);
+    }
+  }
+
+  return(NULL);
+}
+
+AgsWaveStreamBlock*
+ags_wave_stream_claim_block(AgsWaveStream *wave_stream,
+			    guint64 index,
+			    guint64 *wanted, guint n_wanted)
+{
+  AgsWaveStreamBlock *block, *victim;
+
+  guint tick;
+  guint i, j;
+
+  /* an empty slot, readers start looking at index modulo ring size */
+  for(i = 0; i < wave_stream->ring_size; i++){
+    block = wave_stream->ring[(index + i) % wave_stream->ring_size];
+
+    if(g_atomic_int_compare_and_exchange(&(block->state),
+					 AGS_WAVE_STREAM_BLOCK_EMPTY,
+					 AGS_WAVE_STREAM_BLOCK_LOADING)){
+      return(block);
+    }
+  }
+
+  /* the least recently used slot, that isn't wanted */
+  victim = NULL;
+
+  tick = g_atomic_int_get(&(wave_stream->tick));
+  
+  for(i = 0; i < wave_stream->ring_size; i++){
+    block = wave_stream->ring[i];
+
+    if(g_atomic_int_get(&(block->state)) != AGS_WAVE_STREAM_BLOCK_READY){
+      continue;
+    }
+    
+    for(j = 0; j < n_wanted; j++){
+      if(wanted[j] == block->index){
+	break;
+      }
+    }
+
+    if(j < n_wanted){
+      continue;
+    }
+
+    if(victim == NULL ||
+       tick - g_atomic_int_get(&(block->last_used)) > tick - g_atomic_int_get(&(victim->last_used))){
+      victim = block;
+    }
+  }
+
+  if(victim == NULL ||
+     !g_atomic_int_compare_and_exchange(&(victim->state),
+					AGS_WAVE_STREAM_BLOCK_READY,
+					AGS_WAVE_STREAM_BLOCK_LOADING)){
+    return(NULL);
+  }
+
+  /* readers see the slot loading and won't enter, wait for the present ones */
+  while(g_atomic_int_get(&(victim->readers)) != 0){
+    g_thread_yield();
+  }
+  
+  return(victim);
+}
+
+AgsWaveStreamBlock*
+ags_wave_stream_acquire_block(AgsWaveStreamBlock **ring, guint ring_size,
+			      guint64 index)
+{
+  AgsWaveStreamBlock *block;
+  
+  guint i;
+
+  for(i = 0; i < ring_size; i++){
+    block = ring[(index + i) % ring_size];
+
+    if(g_atomic_int_get(&(block->state)) != AGS_WAVE_STREAM_BLOCK_READY ||
+       block->index != index){
+      continue;
+    }
+
+    /* count as reader, then check the slot wasn't taken meanwhile */
+    g_atomic_int_inc(&(block->readers));
+
+    if(g_atomic_int_get(&(block->state)) == AGS_WAVE_STREAM_BLOCK_READY &&
+       block->index == index){
+      return(block);
+    }
+
+    g_atomic_int_add(&(block->readers),
+		     -1);
+  }
+
+  return(NULL);
+}
+
+/**
+ * ags_wave_stream_fill:
+ * @wave_stream: the #AgsWaveStream
+ * 
+ * Decode the missing blocks ahead of the playhead and, while looping, at
+ * the loop start. Least recently used slots of the ring are reused to stay
+ * within the memory budget. Returns early if the playhead was located
+ * meanwhile.
+ *
+ * This is called by the I/O thread and must not be called from the audio
+ * thread.
+ * 
+ * Returns: the count of decoded blocks
+ * 
+ * Since: 3.5.0
+ */
+guint
+ags_wave_stream_fill(AgsWaveStream *wave_stream)
+{
+  GObject *sound_resource;
+
+  guint64 *wanted;
+
+  guint64 x_offset;
+  guint64 frame_count;
+  guint64 loop_start, loop_end;
+  guint64 n_blocks, last_block, loop_block;
+  guint64 first;
+  guint audio_channel;
+  guint format;
+  guint block_size;
+  guint read_ahead, loop_ahead;
+  guint n_wanted;
+  guint generation;
+  guint n_loaded;
+  gboolean do_loop;
+  guint i, j;
+  
+  GRecMutex *wave_stream_mutex;
+
+  if(!AGS_IS_WAVE_STREAM(wave_stream)){
+    return(0);
+  }
+
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  ags_wave_stream_alloc_ring(wave_stream);
+
+  /* drop the blocks of a former sound resource or audio channel */
+  if((AGS_WAVE_STREAM_RESET & (g_atomic_int_and(&(wave_stream->flags), (~AGS_WAVE_STREAM_RESET)))) != 0){
+    ags_wave_stream_drop_ring(wave_stream);
+  }
+  
+  generation = g_atomic_int_get(&(wave_stream->generation));
+  
+  g_rec_mutex_lock(wave_stream_mutex);
+
+  sound_resource = wave_stream->sound_resource;
+
+  if(sound_resource != NULL){
+    g_object_ref(sound_resource);
+  }
+  
+  audio_channel = wave_stream->audio_channel;
+  format = wave_stream->format;
+
+  x_offset = wave_stream->x_offset;
+  frame_count = wave_stream->frame_count;
+
+  block_size = wave_stream->block_size;
+  read_ahead = wave_stream->read_ahead;
+  loop_ahead = wave_stream->loop_ahead;
+
+  first = g_atomic_int_get(&(wave_stream->playhead_block));
+
+  do_loop = ((AGS_WAVE_STREAM_LOOP & (g_atomic_int_get(&(wave_stream->flags)))) != 0) ? TRUE: FALSE;
+  
+  loop_start = wave_stream->loop_start;
+  loop_end = wave_stream->loop_end;
+  
+  g_rec_mutex_unlock(wave_stream_mutex);
+
+  if(sound_resource == NULL ||
+     frame_count == 0){
+    if(sound_resource != NULL){
+      g_object_unref(sound_resource);
+    }
+    
+    return(0);
+  }
+
+  n_blocks = (frame_count + block_size - 1) / block_size;
+
+  /* the wanted blocks, most urgent first */
+  wanted = (guint64 *) g_malloc((read_ahead + loop_ahead) * sizeof(guint64));
+
+  n_wanted = 0;
+
+  if(do_loop &&
+     loop_start >= loop_end){
+    do_loop = FALSE;
+  }
+  
+  last_block = n_blocks;
+  
+  if(do_loop){
+    loop_block = 0;
+    
+    if(loop_end > x_offset){
+      loop_block = (loop_end - x_offset + block_size - 1) / block_size;
+    }
+
+    if(first < loop_block &&
+       loop_block < n_blocks){
+      last_block = loop_block;
+    }
+  }
+  
+  for(i = 0; i < read_ahead && first + i < last_block; i++){
+    wanted[n_wanted] = first + i;
+    n_wanted++;
+  }
+
+  if(do_loop){
+    first = 0;
+    
+    if(loop_start > x_offset){
+      first = (loop_start - x_offset) / block_size;
+    }
+
+    for(i = 0; i < loop_ahead && first + i < n_blocks; i++){
+      for(j = 0; j < n_wanted; j++){
+	if(wanted[j] == first + i){
+	  break;
+	}
+      }
+
+      if(j == n_wanted){
+	wanted[n_wanted] = first + i;
+	n_wanted++;
+      }
+    }
+  }
+
+  /* decode */
+  n_loaded = 0;
+  
+  for(i = 0; i < n_wanted; i++){
+    AgsWaveStreamBlock *block;
+
+    gboolean success;
+    
+    if(g_atomic_int_get(&(wave_stream->generation)) != generation){
+      break;
+    }
+    
+    if(ags_wave_stream_lookup_block(wave_stream,
+				    wanted[i]) != NULL){
+      continue;
+    }
+
+    block = ags_wave_stream_claim_block(wave_stream,
+					wanted[i],
+					wanted, n_wanted);
+
+    if(block == NULL){
+      break;
+    }
+
+    ags_audio_buffer_util_clear_buffer(block->data, 1,
+				       block_size, ags_audio_buffer_util_format_from_soundcard(format));
+    
+    ags_sound_resource_seek(AGS_SOUND_RESOURCE(sound_resource),
+			    (gint64) (wanted[i] * block_size), G_SEEK_SET);
+    
+    block->frame_count = ags_sound_resource_read(AGS_SOUND_RESOURCE(sound_resource),
+						 block->data, 1,
+						 audio_channel,
+						 block_size, format);
+
+    if(block->frame_count == 0){
+      g_atomic_int_set(&(block->state),
+		       AGS_WAVE_STREAM_BLOCK_EMPTY);
+
+      continue;
+    }
+
+    g_rec_mutex_lock(wave_stream_mutex);
+
+    /* the properties changed while decoding */
+    success = (wave_stream->sound_resource == sound_resource &&
+	       wave_stream->audio_channel == audio_channel) ? TRUE: FALSE;
+    
+    g_rec_mutex_unlock(wave_stream_mutex);
+
+    if(!success){
+      g_atomic_int_set(&(block->state),
+		       AGS_WAVE_STREAM_BLOCK_EMPTY);
+
+      break;
+    }
+
+    /* publish */
+    block->index = wanted[i];
+    
+    g_atomic_int_set(&(block->last_used),
+		     g_atomic_int_add(&(wave_stream->tick), 1) + 1);
+    
+    g_atomic_int_set(&(block->state),
+		     AGS_WAVE_STREAM_BLOCK_READY);
+
+    n_loaded++;
+  }
+
+  g_free(wanted);
+  
+  g_object_unref(sound_resource);
+
+  return(n_loaded);
+}
+
+/**
+ * ags_wave_stream_locate:
+ * @wave_stream: the #AgsWaveStream
+ * @x_offset: the timeline offset
+ * 
+ * Move the playhead to @x_offset and let the I/O thread prefetch from
+ * there. A fill in progress is abandoned.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_wave_stream_locate(AgsWaveStream *wave_stream,
+		       guint64 x_offset)
+{
+  GRecMutex *wave_stream_mutex;
+
+  if(!AGS_IS_WAVE_STREAM(wave_stream)){
+    return;
+  }
+
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  g_rec_mutex_lock(wave_stream_mutex);
+
+  g_atomic_int_set(&(wave_stream->playhead_block),
+		   ((x_offset > wave_stream->x_offset) ? (x_offset - wave_stream->x_offset) / wave_stream->block_size: 0));
+  
+  g_rec_mutex_unlock(wave_stream_mutex);
+
+  g_atomic_int_inc(&(wave_stream->generation));
+  
+  ags_wave_stream_wakeup(wave_stream);
+}
+
+/**
+ * ags_wave_stream_set_loop:
+ * @wave_stream: the #AgsWaveStream
+ * @do_loop: if %TRUE prefetch the loop start
+ * @loop_start: the timeline offset of the loop start
+ * @loop_end: the timeline offset of the loop end
+ * 
+ * Set the loop of @wave_stream. While looping, no block after @loop_end
+ * is read ahead, but the blocks at @loop_start are kept.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_wave_stream_set_loop(AgsWaveStream *wave_stream,
+			 gboolean do_loop,
+			 guint64 loop_start, guint64 loop_end)
+{
+  gboolean was_loop;
+  gboolean changed;
+  
+  GRecMutex *wave_stream_mutex;
+
+  if(!AGS_IS_WAVE_STREAM(wave_stream)){
+    return;
+  }
+
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  g_rec_mutex_lock(wave_stream_mutex);
+
+  was_loop = ((AGS_WAVE_STREAM_LOOP & (g_atomic_int_get(&(wave_stream->flags)))) != 0) ? TRUE: FALSE;
+
+  changed = (was_loop != do_loop ||
+	     wave_stream->loop_start != loop_start ||
+	     wave_stream->loop_end != loop_end) ? TRUE: FALSE;
+  
+  if(do_loop){
+    g_atomic_int_or(&(wave_stream->flags),
+		    AGS_WAVE_STREAM_LOOP);
+  }else{
+    g_atomic_int_and(&(wave_stream->flags),
+		     (~AGS_WAVE_STREAM_LOOP));
+  }
+
+  wave_stream->loop_start = loop_start;
+  wave_stream->loop_end = loop_end;
+  
+  g_rec_mutex_unlock(wave_stream_mutex);
+
+  if(changed){
+    ags_wave_stream_wakeup(wave_stream);
+  }
+}
+
+/**
+ * ags_wave_stream_read:
+ * @wave_stream: the #AgsWaveStream
+ * @x_offset: the timeline offset
+ * @destination: the destination buffer
+ * @dchannels: the channel count of @destination
+ * @frame_count: the frame count to read
+ * @format: the format of @destination
+ * 
+ * Mix @frame_count frames at @x_offset into @destination from the decoded
+ * blocks. This neither takes a lock nor waits for I/O, missing blocks are
+ * left silent and requested from the I/O thread. The playhead moves to the
+ * end of the read.
+ * 
+ * Returns: the count of frames available
+ * 
+ * Since: 3.5.0
+ */
+guint
+ags_wave_stream_read(AgsWaveStream *wave_stream,
+		     guint64 x_offset,
+		     gpointer destination, guint dchannels,
+		     guint frame_count, guint format)
+{
+  AgsWaveStreamBlock **ring;
+
+  guint64 stream_x_offset;
+  guint64 stream_frame_count;
+  guint64 end;
+  guint ring_size;
+  guint block_size;
+  guint playhead_block;
+  guint copy_mode;
+  guint n_read;
+  guint i;
+  gboolean do_wakeup;
+  
+  if(!AGS_IS_WAVE_STREAM(wave_stream) ||
+     destination == NULL ||
+     frame_count == 0){
+    return(0);
+  }
+
+  ring = g_atomic_pointer_get(&(wave_stream->ring));
+
+  if(ring == NULL){
+    ags_wave_stream_wakeup(wave_stream);
+    
+    return(0);
+  }
+
+  /* fixed once the ring was allocated */
+  ring_size = wave_stream->ring_size;
+  block_size = wave_stream->block_size;
+  
+  stream_x_offset = wave_stream->x_offset;
+  stream_frame_count = wave_stream->frame_count;
+  
+  copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(format),
+						  ags_audio_buffer_util_format_from_soundcard(wave_stream->format));
+
+  n_read = 0;
+
+  do_wakeup = FALSE;
+
+  i = 0;
+  
+  if(x_offset < stream_x_offset){
+    if(stream_x_offset - x_offset < frame_count){
+      i = stream_x_offset - x_offset;
+    }else{
+      i = frame_count;
+    }
+  }
+  
+  while(i < frame_count){
+    AgsWaveStreamBlock *block;
+
+    guint64 frame;
+    guint64 index;
+    guint block_offset;
+    guint count;
+    
+    frame = x_offset + i - stream_x_offset;
+
+    if(frame >= stream_frame_count){
+      break;
+    }
+    
+    index = frame / block_size;
+    block_offset = frame % block_size;
+
+    count = block_size - block_offset;
+
+    if(count > frame_count - i){
+      count = frame_count - i;
+    }
+    
+    block = ags_wave_stream_acquire_block(ring, ring_size,
+					  index);
+
+    if(block == NULL){
+      g_atomic_int_inc(&(wave_stream->miss));
+
+      do_wakeup = TRUE;
+      
+      i += count;
+      
+      continue;
+    }
+
+    g_atomic_int_inc(&(wave_stream->hit));
+    
+    g_atomic_int_set(&(block->last_used),
+		     g_atomic_int_add(&(wave_stream->tick), 1) + 1);
+
+    if(block_offset < block->frame_count){
+      guint available;
+
+      available = count;
+      
+      if(available > block->frame_count - block_offset){
+	available = block->frame_count - block_offset;
+      }
+      
+      ags_audio_buffer_util_copy_buffer_to_buffer(destination, dchannels, i * dchannels,
+						  block->data, 1, block_offset,
+						  available, copy_mode);
+
+      n_read += available;
+    }
+
+    /* release */
+    g_atomic_int_add(&(block->readers),
+		     -1);
+    
+    i += count;
+  }
+
+  /* move playhead */
+  end = x_offset + frame_count;
+  
+  playhead_block = 0;
+
+  if(end > stream_x_offset){
+    playhead_block = (end - stream_x_offset) / block_size;
+  }
+
+  if(g_atomic_int_get(&(wave_stream->playhead_block)) != playhead_block){
+    g_atomic_int_set(&(wave_stream->playhead_block),
+		     playhead_block);
+    
+    do_wakeup = TRUE;
+  }
+  
+  if(do_wakeup){
+    ags_wave_stream_wakeup(wave_stream);
+  }
+  
+  return(n_read);
+}
+
+void*
+ags_wave_stream_io_thread(void *ptr)
+{
+  AgsWaveStream *wave_stream;
+
+  gint64 end_time;
+  
+  wave_stream = AGS_WAVE_STREAM(ptr);
+
+  while((AGS_WAVE_STREAM_RUNNING & (g_atomic_int_get(&(wave_stream->flags)))) != 0){
+    g_mutex_lock(&(wave_stream->io_mutex));
+
+    if((AGS_WAVE_STREAM_PENDING & (g_atomic_int_get(&(wave_stream->flags)))) == 0){
+      end_time = g_get_monotonic_time() + AGS_WAVE_STREAM_POLL_TIMEOUT;
+      
+      g_cond_wait_until(&(wave_stream->io_cond),
+			&(wave_stream->io_mutex),
+			end_time);
+    }
+    
+    g_mutex_unlock(&(wave_stream->io_mutex));
+
+    g_atomic_int_and(&(wave_stream->flags),
+		     (~AGS_WAVE_STREAM_PENDING));
+
+    if((AGS_WAVE_STREAM_RUNNING & (g_atomic_int_get(&(wave_stream->flags)))) == 0){
+      break;
+    }
+    
+    ags_wave_stream_fill(wave_stream);
+  }
+
+  g_thread_exit(NULL);
+
+  return(NULL);
+}
+
+/**
+ * ags_wave_stream_start:
+ * @wave_stream: the #AgsWaveStream
+ * 
+ * Start the I/O thread, if not running.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_wave_stream_start(AgsWaveStream *wave_stream)
+{
+  GRecMutex *wave_stream_mutex;
+
+  if(!AGS_IS_WAVE_STREAM(wave_stream)){
+    return;
+  }
+
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  g_rec_mutex_lock(wave_stream_mutex);
+
+  if((AGS_WAVE_STREAM_RUNNING & (g_atomic_int_get(&(wave_stream->flags)))) != 0){
+    g_rec_mutex_unlock(wave_stream_mutex);
+
+    return;
+  }
+
+  ags_wave_stream_alloc_ring(wave_stream);
+  
+  g_atomic_int_or(&(wave_stream->flags),
+		  (AGS_WAVE_STREAM_RUNNING | AGS_WAVE_STREAM_PENDING));
+  
+  wave_stream->io_thread = g_thread_new("Advanced Gtk+ Sequencer - wave stream",
+					ags_wave_stream_io_thread,
+					wave_stream);
+  
+  g_rec_mutex_unlock(wave_stream_mutex);
+}
+
+/**
+ * ags_wave_stream_stop:
+ * @wave_stream: the #AgsWaveStream
+ * 
+ * Stop the I/O thread and join it.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_wave_stream_stop(AgsWaveStream *wave_stream)
+{
+  GThread *io_thread;
+
+  GRecMutex *wave_stream_mutex;
+
+  if(!AGS_IS_WAVE_STREAM(wave_stream)){
+    return;
+  }
+
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  g_rec_mutex_lock(wave_stream_mutex);
+
+  if((AGS_WAVE_STREAM_RUNNING & (g_atomic_int_get(&(wave_stream->flags)))) == 0){
+    g_rec_mutex_unlock(wave_stream_mutex);
+
+    return;
+  }
+
+  g_atomic_int_and(&(wave_stream->flags),
+		   (~AGS_WAVE_STREAM_RUNNING));
+
+  io_thread = wave_stream->io_thread;
+
+  wave_stream->io_thread = NULL;
+  
+  g_rec_mutex_unlock(wave_stream_mutex);
+
+  /* join */
+  g_atomic_int_inc(&(wave_stream->generation));
+
+  g_mutex_lock(&(wave_stream->io_mutex));
+
+  g_cond_broadcast(&(wave_stream->io_cond));
+
+  g_mutex_unlock(&(wave_stream->io_mutex));
+
+  g_thread_join(io_thread);
+}
+
+/**
+ * ags_wave_stream_wakeup:
+ * @wave_stream: the #AgsWaveStream
+ * 
+ * Wake up the I/O thread. Doesn't take any lock, so it is safe to be called
+ * from the audio thread.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_wave_stream_wakeup(AgsWaveStream *wave_stream)
+{
+  if(wave_stream == NULL){
+    return;
+  }
+
+  g_atomic_int_or(&(wave_stream->flags),
+		  AGS_WAVE_STREAM_PENDING);
+  
+  g_cond_signal(&(wave_stream->io_cond));
+}
+
+/**
+ * ags_wave_stream_test_duration:
+ * @sound_resource: the #AgsSoundResource
+ * 
+ * Test if @sound_resource is long enough to be played from disk as long
+ * as its decoded #AgsWave isn't modified. This is the case if it lasts longer
+ * than %AGS_WAVE_STREAM_DEFAULT_MIN_DURATION seconds.
+ * 
+ * Returns: %TRUE if it should be streamed, otherwise %FALSE
+ * 
+ * Since: 3.5.0
+ */
+gboolean
+ags_wave_stream_test_duration(GObject *sound_resource)
+{
+  guint frame_count;
+  guint samplerate;
+
+  if(!AGS_IS_SOUND_RESOURCE(sound_resource)){
+    return(FALSE);
+  }
+
+  frame_count = 0;
+  
+  samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+  
+  ags_sound_resource_info(AGS_SOUND_RESOURCE(sound_resource),
+			  &frame_count,
+			  NULL, NULL);
+  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sound_resource),
+				 NULL,
+				 &samplerate,
+				 NULL,
+				 NULL);
+
+  if(samplerate == 0){
+    return(FALSE);
+  }
+  
+  return(frame_count / samplerate > AGS_WAVE_STREAM_DEFAULT_MIN_DURATION);
+}
+
+/**
+ * ags_wave_stream_open_filename:
+ * @filename: the filename
+ * @soundcard: the #AgsSoundcard
+ * 
+ * Open a #AgsWaveStream for every audio channel of @filename. Each stream
+ * gets its own #AgsSoundResource since it is owned by the I/O thread.
+ * 
+ * Returns: (element-type AgsAudio.WaveStream) (transfer full): the #GList-struct containing #AgsWaveStream
+ * 
+ * Since: 3.5.0
+ */
+GList*
+ags_wave_stream_open_filename(gchar *filename,
+			      GObject *soundcard)
+{
+  AgsAudioFile *audio_file;
+  AgsWaveStream *wave_stream;
+
+  GList *start_wave_stream;
+
+  guint audio_channels;
+  guint i;
+
+  if(filename == NULL){
+    return(NULL);
+  }
+
+  start_wave_stream = NULL;
+
+  audio_channels = 1;
+  
+  for(i = 0; i < audio_channels; i++){
+    audio_file = ags_audio_file_new(filename,
+				    soundcard,
+				    -1);
+
+    if(!ags_audio_file_open(audio_file)){
+      g_object_unref(audio_file);
+
+      break;
+    }
+
+    if(i == 0){
+      ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(audio_file->sound_resource),
+				     &audio_channels,
+				     NULL,
+				     NULL,
+				     NULL);
+    }
+    
+    wave_stream = ags_wave_stream_new(audio_file->sound_resource,
+				      i);
+    start_wave_stream = g_list_prepend(start_wave_stream,
+				       wave_stream);
+
+    g_object_unref(audio_file);
+  }
+
+  return(g_list_reverse(start_wave_stream));
+}
+
+/**
+ * ags_wave_stream_new:
+ * @sound_resource: the #AgsSoundResource to decode from
+ * @audio_channel: the audio channel to stream
+ * 
+ * Create a new instance of #AgsWaveStream.
+ * 
+ * Returns: the new #AgsWaveStream
+ * 
+ * Since: 3.5.0
+ */
+AgsWaveStream*
+ags_wave_stream_new(GObject *sound_resource,
+		    guint audio_channel)
+{
+  AgsWaveStream *wave_stream;
+
+  wave_stream = (AgsWaveStream *) g_object_new(AGS_TYPE_WAVE_STREAM,
+					       "audio-channel", audio_channel,
+					       "sound-resource", sound_resource,
+					       NULL);
+  
+  return(wave_stream);
+}
@@ -0,0 +1,193 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __AGS_WAVE_STREAM_H__
+#define __AGS_WAVE_STREAM_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_WAVE_STREAM                (ags_wave_stream_get_type())
+#define AGS_WAVE_STREAM(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_WAVE_STREAM, AgsWaveStream))
+#define AGS_WAVE_STREAM_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_WAVE_STREAM, AgsWaveStreamClass))
+#define AGS_IS_WAVE_STREAM(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_WAVE_STREAM))
+#define AGS_IS_WAVE_STREAM_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_WAVE_STREAM))
+#define AGS_WAVE_STREAM_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_WAVE_STREAM, AgsWaveStreamClass))
+
+#define AGS_WAVE_STREAM_GET_OBJ_MUTEX(obj) (&(((AgsWaveStream *) obj)->obj_mutex))
+
+#define AGS_WAVE_STREAM_BLOCK(ptr) ((AgsWaveStreamBlock *)(ptr))
+
+#define AGS_WAVE_STREAM_DEFAULT_BLOCK_SIZE (16384)
+#define AGS_WAVE_STREAM_DEFAULT_READ_AHEAD (8)
+#define AGS_WAVE_STREAM_DEFAULT_LOOP_AHEAD (2)
+#define AGS_WAVE_STREAM_DEFAULT_MEMORY_BUDGET (16 * 1024 * 1024)
+#define AGS_WAVE_STREAM_DEFAULT_MIN_DURATION (60)
+
+#define AGS_WAVE_STREAM_POLL_TIMEOUT (100000)
+
+typedef struct _AgsWaveStream AgsWaveStream;
+typedef struct _AgsWaveStreamClass AgsWaveStreamClass;
+typedef struct _AgsWaveStreamBlock AgsWaveStreamBlock;
+
+/**
+ * AgsWaveStreamFlags:
+ * @AGS_WAVE_STREAM_RUNNING: the I/O thread is running
+ * @AGS_WAVE_STREAM_LOOP: prefetch the loop start while playing towards the loop end
+ * @AGS_WAVE_STREAM_PENDING: the I/O thread was woken up and has to fill
+ * @AGS_WAVE_STREAM_RESET: the decoded blocks are stale and have to be dropped by the I/O thread
+ * 
+ * Enum values to control the behavior or indicate internal state of #AgsWaveStream by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_WAVE_STREAM_RUNNING      = 1,
+  AGS_WAVE_STREAM_LOOP         = 1 <<  1,
+  AGS_WAVE_STREAM_PENDING      = 1 <<  2,
+  AGS_WAVE_STREAM_RESET        = 1 <<  3,
+}AgsWaveStreamFlags;
+
+/**
+ * AgsWaveStreamBlockState:
+ * @AGS_WAVE_STREAM_BLOCK_EMPTY: the slot is unused
+ * @AGS_WAVE_STREAM_BLOCK_LOADING: the slot is owned by the I/O thread
+ * @AGS_WAVE_STREAM_BLOCK_READY: the slot contains decoded frames and may be read
+ * 
+ * Enum values to indicate the state of a #AgsWaveStreamBlock slot of the ring.
+ */
+typedef enum{
+  AGS_WAVE_STREAM_BLOCK_EMPTY,
+  AGS_WAVE_STREAM_BLOCK_LOADING,
+  AGS_WAVE_STREAM_BLOCK_READY,
+}AgsWaveStreamBlockState;
+
+/**
+ * AgsWaveStreamBlock:
+ * @state: the #AgsWaveStreamBlockState, accessed atomically
+ * @readers: the count of readers copying from @data, accessed atomically
+ * @index: the block index, the first frame is @index times block size
+ * @data: the decoded frames
+ * @frame_count: the count of valid frames in @data
+ * @last_used: the access tick of the last read
+ *
+ * #AgsWaveStreamBlock is a slot of the ring of #AgsWaveStream. The I/O thread
+ * takes a slot by setting @state to %AGS_WAVE_STREAM_BLOCK_LOADING and waits
+ * for @readers to drop to 0 before it reuses @data.
+ */
+struct _AgsWaveStreamBlock
+{
+  volatile gint state;
+  volatile gint readers;
+  
+  guint64 index;
+
+  gpointer data;
+  guint frame_count;
+
+  volatile guint last_used;
+};
+
+struct _AgsWaveStream
+{
+  GObject gobject;
+
+  volatile guint flags;
+
+  GRecMutex obj_mutex;
+
+  GObject *sound_resource;
+  guint audio_channel;
+
+  guint samplerate;
+  guint format;
+
+  guint64 x_offset;
+  guint64 frame_count;
+
+  guint block_size;
+  guint read_ahead;
+  guint loop_ahead;
+  
+  guint64 memory_budget;
+  guint max_blocks;
+
+  AgsWaveStreamBlock **ring;
+  guint ring_size;
+  
+  volatile guint tick;
+
+  volatile guint playhead_block;
+  guint64 loop_start;
+  guint64 loop_end;
+
+  volatile guint generation;
+
+  GThread *io_thread;
+
+  GMutex io_mutex;
+  GCond io_cond;
+
+  volatile guint hit;
+  volatile guint miss;
+};
+
+struct _AgsWaveStreamClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_wave_stream_get_type(void);
+
+AgsWaveStreamBlock* ags_wave_stream_block_alloc(guint64 index,
+						guint block_size,
+						guint format);
+void ags_wave_stream_block_free(AgsWaveStreamBlock *block);
+
+guint ags_wave_stream_fill(AgsWaveStream *wave_stream);
+
+void ags_wave_stream_locate(AgsWaveStream *wave_stream,
+			    guint64 x_offset);
+void ags_wave_stream_set_loop(AgsWaveStream *wave_stream,
+			      gboolean do_loop,
+			      guint64 loop_start, guint64 loop_end);
+
+guint ags_wave_stream_read(AgsWaveStream *wave_stream,
+			   guint64 x_offset,
+			   gpointer destination, guint dchannels,
+			   guint frame_count, guint format);
+
+void ags_wave_stream_start(AgsWaveStream *wave_stream);
+void ags_wave_stream_stop(AgsWaveStream *wave_stream);
+void ags_wave_stream_wakeup(AgsWaveStream *wave_stream);
+
+gboolean ags_wave_stream_test_duration(GObject *sound_resource);
+GList* ags_wave_stream_open_filename(gchar *filename,
+				     GObject *soundcard);
+
+AgsWaveStream* ags_wave_stream_new(GObject *sound_resource,
+				   guint audio_channel);
+
+G_END_DECLS
+
+#endif /*__AGS_WAVE_STREAM_H__*/
@@ -243,7 +243,10 @@ ags_fx_analyse_channel_init(AgsFxAnalyseChannel *fx_analyse_channel)
 
     fx_analyse_channel->input_data[i]->comout = (fftw_complex *) fftw_malloc(buffer_size * sizeof(fftw_complex));
 
-    fx_analyse_channel->input_data[i]->plan = fftw_plan_r2r_1d(buffer_size, fx_analyse_channel->input_data[i]->in, fx_analyse_channel->input_data[i]->out, FFTW_R2HC, FFTW_ESTIMATE);
+    fx_analyse_channel->input_data[i]->plan = ags_fft_plan_cache_find_r2r(ags_fft_plan_cache_get_instance(),
+									  buffer_size, 1,
+									  FFTW_R2HC,
+									  fftw_alignment_of(fx_analyse_channel->input_data[i]->in));
   }
 
   /* add to reset analyse task */
@@ -581,15 +584,16 @@ ags_fx_analyse_channel_notify_buffer_size_callback(GObject *gobject,
 
     fftw_free(input_data->comout);
 
-    fftw_destroy_plan(input_data->plan);
-    
     if(buffer_size > 0){
       input_data->in = (double *) fftw_malloc(buffer_size * sizeof(double));
       input_data->out = (double *) fftw_malloc(buffer_size * sizeof(double));
 
       input_data->comout = (fftw_complex *) fftw_malloc(buffer_size * sizeof(fftw_complex));
 
-      input_data->plan = fftw_plan_r2r_1d(buffer_size, input_data->in, input_data->out, FFTW_R2HC, FFTW_ESTIMATE);
+      input_data->plan = ags_fft_plan_cache_find_r2r(ags_fft_plan_cache_get_instance(),
+						     buffer_size, 1,
+						     FFTW_R2HC,
+						     fftw_alignment_of(input_data->in));
     }else{
       input_data->in = NULL;
       input_data->out = NULL;
@@ -660,8 +664,6 @@ ags_fx_analyse_channel_input_data_free(AgsFxAnalyseChannelInputData *input_data)
   fftw_free(input_data->out);
 
   fftw_free(input_data->comout);
-
-  fftw_destroy_plan(input_data->plan);    
   
   g_free(input_data);
 }
@@ -27,6 +27,8 @@
 
 #include <ags/libags.h>
 
+#include <ags/audio/ags_fft_plan_cache.h>
+
 #include <ags/audio/ags_sound_enums.h>
 #include <ags/audio/ags_channel.h>
 #include <ags/audio/ags_recall_channel.h>
@@ -70,7 +72,7 @@ struct _AgsFxAnalyseChannelInputData
   
   gpointer parent;
 
-  fftw_plan plan;
+  AgsFFTPlan *plan;
   fftw_complex *comout;
 
   double *in;
@@ -101,6 +101,8 @@ ags_fx_analyse_channel_processor_class_init(AgsFxAnalyseChannelProcessorClass *f
 void
 ags_fx_analyse_channel_processor_init(AgsFxAnalyseChannelProcessor *fx_analyse_channel_processor)
 {
+  ags_recall_set_flags((AgsRecall *) fx_analyse_channel_processor, AGS_RECALL_NON_ESSENTIAL);
+
   AGS_RECALL(fx_analyse_channel_processor)->name = "ags-fx-analyse";
   AGS_RECALL(fx_analyse_channel_processor)->version = AGS_RECALL_DEFAULT_VERSION;
   AGS_RECALL(fx_analyse_channel_processor)->build_id = AGS_RECALL_DEFAULT_BUILD_ID;
@@ -193,7 +195,9 @@ ags_fx_analyse_channel_processor_real_run_inter(AgsRecall *recall)
 
     memset((void *) fx_analyse_channel->input_data[sound_scope]->out, 0, buffer_size * sizeof(double));
     
-    fftw_execute(fx_analyse_channel->input_data[sound_scope]->plan);
+    ags_fft_plan_execute_r2r(fx_analyse_channel->input_data[sound_scope]->plan,
+			     fx_analyse_channel->input_data[sound_scope]->in,
+			     fx_analyse_channel->input_data[sound_scope]->out);
 
     memset((void *) fx_analyse_channel->input_data[sound_scope]->in, 0, buffer_size * sizeof(double));
 
@@ -21,15 +21,20 @@
 
 #include <ags/plugin/ags_lv2_manager.h>
 #include <ags/plugin/ags_lv2_plugin.h>
+#include <ags/plugin/ags_lv2_worker_manager.h>
+#include <ags/plugin/ags_lv2_worker.h>
 #include <ags/plugin/ags_base_plugin.h>
 #include <ags/plugin/ags_plugin_port.h>
 
 #include <ags/audio/ags_input.h>
 #include <ags/audio/ags_recall_container.h>
 #include <ags/audio/ags_port_util.h>
+#include <ags/audio/ags_audio_buffer_util.h>
 
 #include <ags/audio/fx/ags_fx_lv2_channel.h>
 
+#include <string.h>
+
 #include <ags/i18n.h>
 
 void ags_fx_lv2_audio_class_init(AgsFxLv2AudioClass *fx_lv2_audio);
@@ -37,6 +42,13 @@ void ags_fx_lv2_audio_init(AgsFxLv2Audio *fx_lv2_audio);
 void ags_fx_lv2_audio_dispose(GObject *gobject);
 void ags_fx_lv2_audio_finalize(GObject *gobject);
 
+void ags_fx_lv2_audio_run_discarded(AgsLv2Plugin *lv2_plugin,
+				    LV2_Handle *lv2_handle,
+				    AgsLv2Worker *lv2_worker,
+				    float *output, guint output_port_count,
+				    float *input, guint input_port_count,
+				    guint buffer_size);
+
 void ags_fx_lv2_audio_notify_audio_callback(GObject *gobject,
 					    GParamSpec *pspec,
 					    gpointer user_data);
@@ -518,6 +530,10 @@ ags_fx_lv2_audio_notify_samplerate_callback(GObject *gobject,
 	  
 	  guint nth;
 
+	  ags_fx_lv2_audio_flush_note_off(fx_lv2_audio,
+					  channel_data,
+					  NULL);
+	  
 	  if(deactivate != NULL &&
 	     channel_data->lv2_handle != NULL){
 	    deactivate(channel_data->lv2_handle[0]);
@@ -525,12 +541,19 @@ ags_fx_lv2_audio_notify_samplerate_callback(GObject *gobject,
 
 	  if(cleanup != NULL &&
 	     channel_data->lv2_handle != NULL){
+	    ags_lv2_worker_manager_remove_handle(ags_lv2_worker_manager_get_instance(),
+						 channel_data->lv2_handle[0]);
+	    channel_data->lv2_worker = NULL;
+
 	    cleanup(channel_data->lv2_handle[0]);
 	  }	  
 
 	  channel_data->lv2_handle = ags_base_plugin_instantiate((AgsBasePlugin *) lv2_plugin,
 								 samplerate, buffer_size);
 
+	  channel_data->lv2_worker = (GObject *) ags_lv2_worker_manager_find_worker(ags_lv2_worker_manager_get_instance(),
+										    ((channel_data->lv2_handle != NULL) ? channel_data->lv2_handle[0]: NULL));
+
 	  for(nth = 0; nth < output_port_count; nth++){
 	    ags_base_plugin_connect_port((AgsBasePlugin *) lv2_plugin,
 					 channel_data->lv2_handle[0],
@@ -581,6 +604,10 @@ ags_fx_lv2_audio_notify_samplerate_callback(GObject *gobject,
 
 	    input_data = channel_data->input_data[k];
 
+	    ags_fx_lv2_audio_flush_note_off(fx_lv2_audio,
+					    channel_data,
+					    input_data);
+	    
 	    if(deactivate != NULL &&
 	       input_data->lv2_handle != NULL){
 	      deactivate(input_data->lv2_handle[0]);
@@ -588,11 +615,18 @@ ags_fx_lv2_audio_notify_samplerate_callback(GObject *gobject,
 
 	    if(cleanup != NULL &&
 	       input_data->lv2_handle != NULL){
+	      ags_lv2_worker_manager_remove_handle(ags_lv2_worker_manager_get_instance(),
+						   input_data->lv2_handle[0]);
+	      input_data->lv2_worker = NULL;
+
 	      cleanup(input_data->lv2_handle[0]);
 	    }
 
 	    input_data->lv2_handle = ags_base_plugin_instantiate((AgsBasePlugin *) lv2_plugin,
 								 samplerate, buffer_size);
+
+	    input_data->lv2_worker = (GObject *) ags_lv2_worker_manager_find_worker(ags_lv2_worker_manager_get_instance(),
+										    ((input_data->lv2_handle != NULL) ? input_data->lv2_handle[0]: NULL));
 	  }
 	}
       }
@@ -743,6 +777,9 @@ ags_fx_lv2_audio_set_audio_channels_callback(AgsAudio *audio,
 
 	    channel_data->lv2_handle = ags_base_plugin_instantiate((AgsBasePlugin *) lv2_plugin,
 								   samplerate, buffer_size);
+
+	    channel_data->lv2_worker = (GObject *) ags_lv2_worker_manager_find_worker(ags_lv2_worker_manager_get_instance(),
+										      ((channel_data->lv2_handle != NULL) ? channel_data->lv2_handle[0]: NULL));
 	  
 	    if(output_port_count > 0 &&
 	       buffer_size > 0){
@@ -814,6 +851,9 @@ ags_fx_lv2_audio_set_audio_channels_callback(AgsAudio *audio,
 
 	      input_data->lv2_handle = ags_base_plugin_instantiate((AgsBasePlugin *) lv2_plugin,
 								   samplerate, buffer_size);
+
+	      input_data->lv2_worker = (GObject *) ags_lv2_worker_manager_find_worker(ags_lv2_worker_manager_get_instance(),
+										      ((input_data->lv2_handle != NULL) ? input_data->lv2_handle[0]: NULL));
 	    
 	      if(output_port_count > 0 &&
 		 buffer_size > 0){
@@ -1034,6 +1074,7 @@ ags_fx_lv2_audio_channel_data_alloc()
   channel_data->parent = NULL;
   
   channel_data->event_count = 0;
+  channel_data->note_off_pending = 0;
 
   channel_data->output = NULL;
   channel_data->input = NULL;
@@ -1042,6 +1083,7 @@ ags_fx_lv2_audio_channel_data_alloc()
   channel_data->atom_port = NULL;
 
   channel_data->lv2_handle = NULL;
+  channel_data->lv2_worker = NULL;
 
   for(i = 0; i < AGS_SEQUENCER_MAX_MIDI_KEYS; i++){
     channel_data->input_data[i] = ags_fx_lv2_audio_input_data_alloc();
@@ -1070,12 +1112,6 @@ ags_fx_lv2_audio_channel_data_free(AgsFxLv2AudioChannelData *channel_data)
   if(channel_data == NULL){
     return;
   }
-
-  g_free(channel_data->output);
-  g_free(channel_data->input);
-
-  ags_lv2_plugin_event_buffer_free(channel_data->event_port);
-  ags_lv2_plugin_atom_sequence_free(channel_data->atom_port);
   
   if(channel_data->lv2_handle != NULL){
     gpointer plugin_descriptor;
@@ -1108,6 +1144,11 @@ ags_fx_lv2_audio_channel_data_free(AgsFxLv2AudioChannelData *channel_data)
       cleanup = AGS_LV2_PLUGIN_DESCRIPTOR(plugin_descriptor)->cleanup;
       
       g_rec_mutex_unlock(base_plugin_mutex);
+
+      /* note off of queued and sounding keys */
+      ags_fx_lv2_audio_flush_note_off(AGS_FX_LV2_AUDIO_SCOPE_DATA(channel_data->parent)->parent,
+				      channel_data,
+				      NULL);
     }
 
     if(deactivate != NULL &&
@@ -1117,9 +1158,19 @@ ags_fx_lv2_audio_channel_data_free(AgsFxLv2AudioChannelData *channel_data)
 
     if(cleanup != NULL &&
        channel_data->lv2_handle != NULL){
+      ags_lv2_worker_manager_remove_handle(ags_lv2_worker_manager_get_instance(),
+					   channel_data->lv2_handle[0]);
+      channel_data->lv2_worker = NULL;
+
       cleanup(channel_data->lv2_handle[0]);
     }
   }
+
+  g_free(channel_data->output);
+  g_free(channel_data->input);
+
+  ags_lv2_plugin_event_buffer_free(channel_data->event_port);
+  ags_lv2_plugin_atom_sequence_free(channel_data->atom_port);
   
   for(i = 0; i < AGS_SEQUENCER_MAX_MIDI_KEYS; i++){
     ags_fx_lv2_audio_input_data_free(channel_data->input_data[i]);
@@ -1155,6 +1206,7 @@ ags_fx_lv2_audio_input_data_alloc()
   input_data->atom_port = NULL;
 
   input_data->lv2_handle = NULL;
+  input_data->lv2_worker = NULL;
 
   input_data->event_buffer = (snd_seq_event_t *) g_malloc(sizeof(snd_seq_event_t));
 
@@ -1165,6 +1217,7 @@ ags_fx_lv2_audio_input_data_alloc()
   input_data->event_buffer->data.note.velocity = 127;
 
   input_data->key_on = 0;
+  input_data->note_off_pending = 0;
   
   return(input_data);
 }
@@ -1186,12 +1239,6 @@ ags_fx_lv2_audio_input_data_free(AgsFxLv2AudioInputData *input_data)
     return;
   }
 
-  g_free(input_data->output);
-  g_free(input_data->input);
-
-  ags_lv2_plugin_event_buffer_free(input_data->event_port);
-  ags_lv2_plugin_atom_sequence_free(input_data->atom_port);
-
   if(input_data->lv2_handle != NULL){
     gpointer plugin_descriptor;
 
@@ -1224,6 +1271,11 @@ ags_fx_lv2_audio_input_data_free(AgsFxLv2AudioInputData *input_data)
       cleanup = AGS_LV2_PLUGIN_DESCRIPTOR(plugin_descriptor)->cleanup;
       
       g_rec_mutex_unlock(base_plugin_mutex);
+
+      /* note off of queued and sounding key */
+      ags_fx_lv2_audio_flush_note_off(AGS_FX_LV2_AUDIO_SCOPE_DATA(AGS_FX_LV2_AUDIO_CHANNEL_DATA(input_data->parent)->parent)->parent,
+				      input_data->parent,
+				      input_data);
     }
 
     if(deactivate != NULL){
@@ -1231,9 +1283,19 @@ ags_fx_lv2_audio_input_data_free(AgsFxLv2AudioInputData *input_data)
     }
 
     if(cleanup != NULL){
+      ags_lv2_worker_manager_remove_handle(ags_lv2_worker_manager_get_instance(),
+					   input_data->lv2_handle[0]);
+      input_data->lv2_worker = NULL;
+
       cleanup(input_data->lv2_handle[0]);
     }
   }
+
+  g_free(input_data->output);
+  g_free(input_data->input);
+
+  ags_lv2_plugin_event_buffer_free(input_data->event_port);
+  ags_lv2_plugin_atom_sequence_free(input_data->atom_port);
   
   g_free(input_data->event_buffer);
 
@@ -1425,6 +1487,9 @@ ags_fx_lv2_audio_load_plugin(AgsFxLv2Audio *fx_lv2_audio)
 	    if(channel_data->lv2_handle == NULL){
 	      channel_data->lv2_handle = ags_base_plugin_instantiate((AgsBasePlugin *) lv2_plugin,
 								     samplerate, buffer_size);
+
+	      channel_data->lv2_worker = (GObject *) ags_lv2_worker_manager_find_worker(ags_lv2_worker_manager_get_instance(),
+											((channel_data->lv2_handle != NULL) ? channel_data->lv2_handle[0]: NULL));
 	    }
 	  }
 	
@@ -1437,6 +1502,9 @@ ags_fx_lv2_audio_load_plugin(AgsFxLv2Audio *fx_lv2_audio)
 	      if(input_data->lv2_handle == NULL){
 		input_data->lv2_handle = ags_base_plugin_instantiate((AgsBasePlugin *) lv2_plugin,
 								     samplerate, buffer_size);
+
+		input_data->lv2_worker = (GObject *) ags_lv2_worker_manager_find_worker(ags_lv2_worker_manager_get_instance(),
+											((input_data->lv2_handle != NULL) ? input_data->lv2_handle[0]: NULL));
 	      }
 	    }
 	  }
@@ -1833,6 +1901,7 @@ ags_fx_lv2_audio_load_port(AgsFxLv2Audio *fx_lv2_audio)
 
 	  if(has_atom_port){
 	    channel_data->atom_port = ags_lv2_plugin_alloc_atom_sequence(AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT);
+	    ags_lv2_plugin_atom_sequence_reset(channel_data->atom_port);
 	    
 	    ags_base_plugin_connect_port((AgsBasePlugin *) lv2_plugin,
 					 channel_data->lv2_handle[0],
@@ -1959,6 +2028,308 @@ ags_fx_lv2_audio_change_program(AgsFxLv2Audio *fx_lv2_audio,
   }
 }
 
+/**
+ * ags_fx_lv2_audio_flush_note_off:
+ * @fx_lv2_audio: the #AgsFxLv2Audio
+ * @channel_data: the #AgsFxLv2AudioChannelData-struct
+ * @input_data: (nullable): the #AgsFxLv2AudioInputData-struct or %NULL
+ * 
+ * Append a note off for every key still sounding and deliver the pending
+ * MIDI events with one last silent run, whose output is discarded. Then
+ * reset the key state. Call it before the instance is deactivated. The live instrument instance of
+ * @channel_data is flushed, if @input_data is %NULL.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_fx_lv2_audio_flush_note_off(AgsFxLv2Audio *fx_lv2_audio,
+				AgsFxLv2AudioChannelData *channel_data,
+				AgsFxLv2AudioInputData *input_data)
+{
+  AgsLv2Plugin *lv2_plugin;
+  AgsLv2Worker *lv2_worker;
+
+  LV2_Handle *lv2_handle;
+
+  snd_seq_event_t note_off;
+
+  gpointer event_port, atom_port;
+  float *output, *input;
+
+  guint output_port_count, input_port_count;
+  guint buffer_size;
+  guint i;
+  gboolean has_pending;
+
+  GRecMutex *recall_mutex;
+  
+  if(!AGS_IS_FX_LV2_AUDIO(fx_lv2_audio) ||
+     channel_data == NULL){
+    return;
+  }
+
+  /* get recall mutex */
+  recall_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_lv2_audio);
+
+  g_rec_mutex_lock(recall_mutex);
+
+  lv2_plugin = fx_lv2_audio->lv2_plugin;
+
+  output_port_count = fx_lv2_audio->output_port_count;
+  input_port_count = fx_lv2_audio->input_port_count;
+  
+  buffer_size = AGS_RECALL(fx_lv2_audio)->buffer_size;
+  
+  if(input_data == NULL){
+    lv2_handle = channel_data->lv2_handle;
+    lv2_worker = (AgsLv2Worker *) channel_data->lv2_worker;
+
+    output = channel_data->output;
+    input = channel_data->input;
+    
+    event_port = channel_data->event_port;
+    atom_port = channel_data->atom_port;
+  }else{
+    lv2_handle = input_data->lv2_handle;
+    lv2_worker = (AgsLv2Worker *) input_data->lv2_worker;
+
+    output = input_data->output;
+    input = input_data->input;
+    
+    event_port = input_data->event_port;
+    atom_port = input_data->atom_port;
+  }
+
+  if(lv2_plugin == NULL ||
+     lv2_handle == NULL){
+    g_rec_mutex_unlock(recall_mutex);
+    
+    return;
+  }
+  
+  /* note off of sounding keys */
+  has_pending = FALSE;
+  
+  if(event_port != NULL &&
+     AGS_LV2_EVENT_BUFFER(event_port)->event_count > 0){
+    has_pending = TRUE;
+  }
+
+  if(atom_port != NULL &&
+     ((LV2_Atom_Sequence *) atom_port)->atom.size > sizeof(LV2_Atom_Sequence_Body)){
+    has_pending = TRUE;
+  }
+  
+  for(i = 0; i < AGS_SEQUENCER_MAX_MIDI_KEYS; i++){
+    AgsFxLv2AudioInputData *current_input_data;
+
+    current_input_data = (input_data != NULL) ? input_data: channel_data->input_data[i];
+
+    if(current_input_data->key_on > 0){
+      memcpy(&note_off, current_input_data->event_buffer, sizeof(snd_seq_event_t));
+      
+      note_off.type = SND_SEQ_EVENT_NOTEOFF;
+      note_off.data.note.note = (input_data != NULL) ? current_input_data->event_buffer->data.note.note: i;
+      note_off.data.note.velocity = 0;
+
+      ags_lv2_plugin_event_buffer_append_midi_at(event_port,
+						 AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
+						 0,
+						 &note_off,
+						 1);
+      ags_lv2_plugin_atom_sequence_append_midi_at(atom_port,
+						  AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
+						  0,
+						  &note_off,
+						  1);
+      
+      current_input_data->key_on = 0;
+
+      has_pending = TRUE;
+    }
+
+    if(input_data != NULL){
+      break;
+    }
+  }
+
+  /* deliver with a silent run, the output is discarded */
+  if(has_pending){
+    ags_fx_lv2_audio_run_discarded(lv2_plugin,
+				   lv2_handle,
+				   lv2_worker,
+				   output, output_port_count,
+				   input, input_port_count,
+				   buffer_size);
+  }
+
+  ags_lv2_plugin_event_buffer_reset(event_port);
+  ags_lv2_plugin_atom_sequence_reset(atom_port);
+
+  if(input_data == NULL){
+    channel_data->note_off_pending = 0;
+  }else{
+    input_data->note_off_pending = 0;
+  }
+  
+  g_rec_mutex_unlock(recall_mutex);
+}
+
+/**
+ * ags_fx_lv2_audio_deliver_note_off:
+ * @fx_lv2_audio: the #AgsFxLv2Audio
+ * @channel_data: the #AgsFxLv2AudioChannelData-struct
+ * @input_data: (nullable): the #AgsFxLv2AudioInputData-struct or %NULL
+ * 
+ * Deliver the note offs queued by #AgsFxLv2AudioSignal, that no stream
+ * feed consumed during the following period. Call it once per period,
+ * after the audio signals did run. The queued events are delivered with
+ * the next period's run and the output is discarded. The live instrument
+ * instance of @channel_data is used, if @input_data is %NULL.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_fx_lv2_audio_deliver_note_off(AgsFxLv2Audio *fx_lv2_audio,
+				  AgsFxLv2AudioChannelData *channel_data,
+				  AgsFxLv2AudioInputData *input_data)
+{
+  AgsLv2Plugin *lv2_plugin;
+  AgsLv2Worker *lv2_worker;
+
+  LV2_Handle *lv2_handle;
+
+  gpointer event_port, atom_port;
+  float *output, *input;
+
+  guint *note_off_pending;
+  guint output_port_count, input_port_count;
+  guint buffer_size;
+
+  GRecMutex *recall_mutex;
+  
+  if(!AGS_IS_FX_LV2_AUDIO(fx_lv2_audio) ||
+     channel_data == NULL){
+    return;
+  }
+
+  /* get recall mutex */
+  recall_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_lv2_audio);
+
+  g_rec_mutex_lock(recall_mutex);
+
+  if(input_data == NULL){
+    note_off_pending = &(channel_data->note_off_pending);
+  }else{
+    note_off_pending = &(input_data->note_off_pending);
+  }
+
+  /* queued during this period, wait for the next one */
+  if(note_off_pending[0] < 2){
+    if(note_off_pending[0] == 1){
+      note_off_pending[0] = 2;
+    }
+    
+    g_rec_mutex_unlock(recall_mutex);
+    
+    return;
+  }
+
+  lv2_plugin = fx_lv2_audio->lv2_plugin;
+
+  output_port_count = fx_lv2_audio->output_port_count;
+  input_port_count = fx_lv2_audio->input_port_count;
+  
+  buffer_size = AGS_RECALL(fx_lv2_audio)->buffer_size;
+  
+  if(input_data == NULL){
+    lv2_handle = channel_data->lv2_handle;
+    lv2_worker = (AgsLv2Worker *) channel_data->lv2_worker;
+
+    output = channel_data->output;
+    input = channel_data->input;
+    
+    event_port = channel_data->event_port;
+    atom_port = channel_data->atom_port;
+  }else{
+    lv2_handle = input_data->lv2_handle;
+    lv2_worker = (AgsLv2Worker *) input_data->lv2_worker;
+
+    output = input_data->output;
+    input = input_data->input;
+    
+    event_port = input_data->event_port;
+    atom_port = input_data->atom_port;
+  }
+
+  if(lv2_plugin != NULL &&
+     lv2_handle != NULL){
+    ags_fx_lv2_audio_run_discarded(lv2_plugin,
+				   lv2_handle,
+				   lv2_worker,
+				   output, output_port_count,
+				   input, input_port_count,
+				   buffer_size);
+  }
+
+  ags_lv2_plugin_event_buffer_reset(event_port);
+  ags_lv2_plugin_atom_sequence_reset(atom_port);
+
+  note_off_pending[0] = 0;
+  
+  g_rec_mutex_unlock(recall_mutex);
+}
+
+void
+ags_fx_lv2_audio_run_discarded(AgsLv2Plugin *lv2_plugin,
+			       LV2_Handle *lv2_handle,
+			       AgsLv2Worker *lv2_worker,
+			       float *output, guint output_port_count,
+			       float *input, guint input_port_count,
+			       guint buffer_size)
+{
+  void (*run)(LV2_Handle instance,
+	      uint32_t sample_count);
+
+  GRecMutex *base_plugin_mutex;
+
+  if(output == NULL){
+    return;
+  }
+  
+  base_plugin_mutex = AGS_BASE_PLUGIN_GET_OBJ_MUTEX(lv2_plugin);
+
+  g_rec_mutex_lock(base_plugin_mutex);
+
+  run = AGS_LV2_PLUGIN_DESCRIPTOR(AGS_BASE_PLUGIN(lv2_plugin)->plugin_descriptor)->run;
+  
+  g_rec_mutex_unlock(base_plugin_mutex);
+
+  if(run == NULL){
+    return;
+  }
+  
+  /* silent input */
+  if(input != NULL){
+    ags_audio_buffer_util_clear_float(input, input_port_count,
+				      buffer_size);
+  }
+  
+  ags_audio_buffer_util_clear_float(output, output_port_count,
+				    buffer_size);
+      
+  ags_lv2_worker_deliver_response(lv2_worker);
+
+  run(lv2_handle[0],
+      (uint32_t) (output_port_count * buffer_size));
+
+  ags_lv2_worker_end_run(lv2_worker);
+
+  /* discard output */
+  ags_audio_buffer_util_clear_float(output, output_port_count,
+				    buffer_size);
+}
+
 /**
  * ags_fx_lv2_audio_new:
  * @audio: the #AgsAudio
@@ -116,6 +116,7 @@ struct _AgsFxLv2AudioChannelData
   gpointer parent;
 
   guint event_count;
+  guint note_off_pending;
   
   float *output;
   float *input;
@@ -124,6 +125,7 @@ struct _AgsFxLv2AudioChannelData
   gpointer atom_port;
   
   LV2_Handle *lv2_handle;
+  GObject *lv2_worker;
 
   AgsFxLv2AudioInputData* input_data[AGS_SEQUENCER_MAX_MIDI_KEYS];
 };
@@ -141,9 +143,11 @@ struct _AgsFxLv2AudioInputData
   gpointer atom_port;
 
   LV2_Handle *lv2_handle;
+  GObject *lv2_worker;
   
   snd_seq_event_t *event_buffer;
   guint key_on;
+  guint note_off_pending;
 };
 
 GType ags_fx_lv2_audio_get_type();
@@ -172,6 +176,13 @@ void ags_fx_lv2_audio_change_program(AgsFxLv2Audio *fx_lv2_audio,
 				     guint bank_index,
 				     guint program_index);
 
+void ags_fx_lv2_audio_flush_note_off(AgsFxLv2Audio *fx_lv2_audio,
+				     AgsFxLv2AudioChannelData *channel_data,
+				     AgsFxLv2AudioInputData *input_data);
+void ags_fx_lv2_audio_deliver_note_off(AgsFxLv2Audio *fx_lv2_audio,
+				       AgsFxLv2AudioChannelData *channel_data,
+				       AgsFxLv2AudioInputData *input_data);
+
 /* instantiate */
 AgsFxLv2Audio* ags_fx_lv2_audio_new(AgsAudio *audio);
 
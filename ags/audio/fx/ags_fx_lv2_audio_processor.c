@@ -32,6 +32,8 @@ void ags_fx_lv2_audio_processor_init(AgsFxLv2AudioProcessor *fx_lv2_audio_proces
 void ags_fx_lv2_audio_processor_dispose(GObject *gobject);
 void ags_fx_lv2_audio_processor_finalize(GObject *gobject);
 
+void ags_fx_lv2_audio_processor_run_post(AgsRecall *recall);
+
 void ags_fx_lv2_audio_processor_key_on(AgsFxNotationAudioProcessor *fx_notation_audio_processor,
 				       AgsNote *note,
 				       guint velocity,
@@ -84,6 +86,7 @@ void
 ags_fx_lv2_audio_processor_class_init(AgsFxLv2AudioProcessorClass *fx_lv2_audio_processor)
 {
   AgsFxNotationAudioProcessorClass *fx_notation_audio_processor;
+  AgsRecallClass *recall;
   GObjectClass *gobject;
   
   ags_fx_lv2_audio_processor_parent_class = g_type_class_peek_parent(fx_lv2_audio_processor);
@@ -94,6 +97,11 @@ ags_fx_lv2_audio_processor_class_init(AgsFxLv2AudioProcessorClass *fx_lv2_audio_
   gobject->dispose = ags_fx_lv2_audio_processor_dispose;
   gobject->finalize = ags_fx_lv2_audio_processor_finalize;
 
+  /* AgsRecallClass */
+  recall = (AgsRecallClass *) fx_lv2_audio_processor;
+  
+  recall->run_post = ags_fx_lv2_audio_processor_run_post;
+
   /* AgsFxNotationAudioProcessorClass */
   fx_notation_audio_processor = (AgsFxNotationAudioProcessorClass *) fx_lv2_audio_processor;
   
@@ -132,107 +140,86 @@ ags_fx_lv2_audio_processor_finalize(GObject *gobject)
 }
 
 void
-ags_fx_lv2_audio_processor_key_on(AgsFxNotationAudioProcessor *fx_notation_audio_processor,
-				  AgsNote *note,
-				  guint velocity,
-				  guint key_mode)
+ags_fx_lv2_audio_processor_run_post(AgsRecall *recall)
 {
-  AgsAudio *audio;
   AgsFxLv2Audio *fx_lv2_audio;
-
-  guint sound_scope;
-  guint audio_channel;
-  guint audio_start_mapping;
-  guint midi_start_mapping;
-  gint midi_note;
-  guint y;
   
-  GRecMutex *fx_lv2_audio_mutex;
+  gboolean is_live_instrument;
+  gint sound_scope;
+  guint audio_channel;
+  guint i;
 
-  audio = NULL;
-  
-  audio_start_mapping = 0;
-  midi_start_mapping = 0;
+  GRecMutex *fx_lv2_audio_mutex;
 
-  y = 0;
+  fx_lv2_audio = NULL;
 
-  sound_scope = ags_recall_get_sound_scope(fx_notation_audio_processor);
+  sound_scope = ags_recall_get_sound_scope(recall);
 
   audio_channel = 0;
   
-  g_object_get(fx_notation_audio_processor,
-	       "audio", &audio,
+  g_object_get(recall,
 	       "recall-audio", &fx_lv2_audio,
 	       "audio-channel", &audio_channel,
 	       NULL);
 
-  fx_lv2_audio_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_lv2_audio);
+  /* deliver the note offs no stream feed did consume */
+  if(fx_lv2_audio != NULL &&
+     (sound_scope == AGS_SOUND_SCOPE_PLAYBACK ||
+      sound_scope == AGS_SOUND_SCOPE_NOTATION ||
+      sound_scope == AGS_SOUND_SCOPE_MIDI)){
+    AgsFxLv2AudioScopeData *scope_data;
+    AgsFxLv2AudioChannelData *channel_data;
 
-  g_object_get(audio,
-	       "audio-start-mapping", &audio_start_mapping,
-	       "midi-start-mapping", &midi_start_mapping,
-	       NULL);
+    fx_lv2_audio_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_lv2_audio);
 
-  g_object_get(note,
-	       "y", &y,
-	       NULL);
-  
-  midi_note = (y - audio_start_mapping + midi_start_mapping);
+    is_live_instrument = ags_fx_lv2_audio_test_flags(fx_lv2_audio, AGS_FX_LV2_AUDIO_LIVE_INSTRUMENT);
 
-  if(midi_note >= 0 &&
-     midi_note < 128){
-    if(ags_fx_lv2_audio_test_flags(fx_lv2_audio, AGS_FX_LV2_AUDIO_LIVE_INSTRUMENT)){
-      AgsFxLv2AudioScopeData *scope_data;
-      AgsFxLv2AudioChannelData *channel_data;
+    g_rec_mutex_lock(fx_lv2_audio_mutex);
 
-      g_rec_mutex_lock(fx_lv2_audio_mutex);
-
-      scope_data = fx_lv2_audio->scope_data[sound_scope];
+    scope_data = fx_lv2_audio->scope_data[sound_scope];
 
+    channel_data = NULL;
+    
+    if(scope_data != NULL &&
+       audio_channel < scope_data->audio_channels){
       channel_data = scope_data->channel_data[audio_channel];
-
-      if(channel_data->event_port != NULL){
-	ags_lv2_plugin_event_buffer_append_midi(channel_data->event_port,
-						AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
-						channel_data->input_data[midi_note]->event_buffer,
-						1);
-      }else if(channel_data->atom_port != NULL){
-	ags_lv2_plugin_atom_sequence_append_midi(channel_data->atom_port,
-						 AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
-						 channel_data->input_data[midi_note]->event_buffer,
-						 1);
+    }
+    
+    if(channel_data != NULL){
+      if(is_live_instrument){
+	ags_fx_lv2_audio_deliver_note_off(fx_lv2_audio,
+					  channel_data,
+					  NULL);
+      }else{
+	for(i = 0; i < AGS_SEQUENCER_MAX_MIDI_KEYS; i++){
+	  if(channel_data->input_data[i]->note_off_pending != 0){
+	    ags_fx_lv2_audio_deliver_note_off(fx_lv2_audio,
+					      channel_data,
+					      channel_data->input_data[i]);
+	  }
+	}
       }
-      
-      g_rec_mutex_unlock(fx_lv2_audio_mutex);
-    }else{
-      AgsFxLv2AudioScopeData *scope_data;
-      AgsFxLv2AudioChannelData *channel_data;
-      AgsFxLv2AudioInputData *input_data;
-
-      g_rec_mutex_lock(fx_lv2_audio_mutex);
-
-      scope_data = fx_lv2_audio->scope_data[sound_scope];
+    }
 
-      channel_data = scope_data->channel_data[audio_channel];
+    g_rec_mutex_unlock(fx_lv2_audio_mutex);
+  }
 
-      input_data = channel_data->input_data[midi_note];
-
-      if(input_data->event_port != NULL){
-	ags_lv2_plugin_event_buffer_append_midi(input_data->event_port,
-						AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
-						input_data->event_buffer,
-						1);
-      }else if(input_data->atom_port != NULL){
-	ags_lv2_plugin_atom_sequence_append_midi(input_data->atom_port,
-						 AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
-						 input_data->event_buffer,
-						 1);
-      }
-      
-      g_rec_mutex_unlock(fx_lv2_audio_mutex);
-    }
+  if(fx_lv2_audio != NULL){
+    g_object_unref(fx_lv2_audio);
   }
   
+  /* call parent */
+  AGS_RECALL_CLASS(ags_fx_lv2_audio_processor_parent_class)->run_post(recall);
+}
+
+void
+ags_fx_lv2_audio_processor_key_on(AgsFxNotationAudioProcessor *fx_notation_audio_processor,
+				  AgsNote *note,
+				  guint velocity,
+				  guint key_mode)
+{
+  /* the MIDI note on is appended time stamped by ags_fx_lv2_audio_signal_stream_feed() */
+  
   /* call parent */
   AGS_FX_NOTATION_AUDIO_PROCESSOR_CLASS(ags_fx_lv2_audio_processor_parent_class)->key_on(fx_notation_audio_processor,
 											 note,
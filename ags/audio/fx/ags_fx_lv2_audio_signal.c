@@ -21,6 +21,8 @@
 
 #include <ags/plugin/ags_base_plugin.h>
 #include <ags/plugin/ags_lv2_plugin.h>
+#include <ags/plugin/ags_lv2_worker_manager.h>
+#include <ags/plugin/ags_lv2_worker.h>
 
 #include <ags/audio/ags_audio_buffer_util.h>
 
@@ -30,6 +32,8 @@
 #include <ags/audio/fx/ags_fx_lv2_channel_processor.h>
 #include <ags/audio/fx/ags_fx_lv2_recycling.h>
 
+#include <string.h>
+
 #include <ags/i18n.h>
 
 void ags_fx_lv2_audio_signal_class_init(AgsFxLv2AudioSignalClass *fx_lv2_audio_signal);
@@ -38,6 +42,7 @@ void ags_fx_lv2_audio_signal_dispose(GObject *gobject);
 void ags_fx_lv2_audio_signal_finalize(GObject *gobject);
 
 void ags_fx_lv2_audio_signal_real_run_inter(AgsRecall *recall);
+void ags_fx_lv2_audio_signal_done(AgsRecall *recall);
 
 void ags_fx_lv2_audio_signal_stream_feed(AgsFxNotationAudioSignal *fx_notation_audio_signal,
 					 AgsAudioSignal *source,
@@ -48,6 +53,17 @@ void ags_fx_lv2_audio_signal_stream_feed(AgsFxNotationAudioSignal *fx_notation_a
 					 gdouble delay_counter, guint64 offset_counter,
 					 guint frame_count,
 					 gdouble delay, guint buffer_size);
+void ags_fx_lv2_audio_signal_run_instance(AgsFxLv2Audio *fx_lv2_audio,
+					  LV2_Handle *lv2_handle,
+					  AgsLv2Worker *lv2_worker,
+					  float *output,
+					  gpointer event_port,
+					  gpointer atom_port,
+					  guint *note_off_pending,
+					  AgsAudioSignal *source,
+					  guint buffer_size,
+					  guint copy_mode_out);
+
 void ags_fx_lv2_audio_signal_notify_remove(AgsFxNotationAudioSignal *fx_notation_audio_signal,
 					   AgsAudioSignal *source,
 					   AgsNote *note,
@@ -120,6 +136,7 @@ ags_fx_lv2_audio_signal_class_init(AgsFxLv2AudioSignalClass *fx_lv2_audio_signal
   recall = (AgsRecallClass *) fx_lv2_audio_signal;
   
   recall->run_inter = ags_fx_lv2_audio_signal_real_run_inter;
+  recall->done = ags_fx_lv2_audio_signal_done;
   
   /* AgsFxNotationAudioSignalClass */
   fx_notation_audio_signal = (AgsFxNotationAudioSignalClass *) fx_lv2_audio_signal;
@@ -174,6 +191,8 @@ ags_fx_lv2_audio_signal_real_run_inter(AgsRecall *recall)
   guint format;
   guint copy_mode_out, copy_mode_in;
   
+  AgsLv2Worker *lv2_worker;
+
   void (*run)(LV2_Handle instance,
 	      uint32_t sample_count);
 
@@ -300,9 +319,15 @@ ags_fx_lv2_audio_signal_real_run_inter(AgsRecall *recall)
 						  buffer_size, copy_mode_in);
     }
 
+    lv2_worker = (AgsLv2Worker *) input_data->lv2_worker;
+
+    ags_lv2_worker_deliver_response(lv2_worker);
+
     run(input_data->lv2_handle[0],
 	(uint32_t) (fx_lv2_channel->output_port_count * buffer_size));
 
+    ags_lv2_worker_end_run(lv2_worker);
+
     if(input_data->output != NULL &&
        fx_lv2_channel->output_port_count >= 1 &&
        source->stream_current != NULL){
@@ -365,8 +390,6 @@ ags_fx_lv2_audio_signal_stream_feed(AgsFxNotationAudioSignal *fx_notation_audio_
   AgsFxLv2Recycling *fx_lv2_recycling;
   AgsFxLv2AudioSignal *fx_lv2_audio_signal;
   
-  AgsLv2Plugin *lv2_plugin;
-
   gboolean is_live_instrument;
   guint sound_scope;
   guint audio_channel;
@@ -376,12 +399,7 @@ ags_fx_lv2_audio_signal_stream_feed(AgsFxNotationAudioSignal *fx_notation_audio_
   guint format;
   guint copy_mode_out;
 
-  void (*run)(LV2_Handle instance,
-	      uint32_t sample_count);
-  
-  GRecMutex *source_stream_mutex;
   GRecMutex *fx_lv2_audio_mutex;
-  GRecMutex *base_plugin_mutex;
 
   audio = NULL;
   
@@ -424,27 +442,10 @@ ags_fx_lv2_audio_signal_stream_feed(AgsFxNotationAudioSignal *fx_notation_audio_
 	       "format", &format,
 	       NULL);
 
-  /* get LV2 plugin */
   fx_lv2_audio_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_lv2_audio);
 
   is_live_instrument = ags_fx_lv2_audio_test_flags(fx_lv2_audio, AGS_FX_LV2_AUDIO_LIVE_INSTRUMENT);
 
-  g_rec_mutex_lock(fx_lv2_audio_mutex);
-
-  lv2_plugin = fx_lv2_audio->lv2_plugin;
-  
-  g_rec_mutex_unlock(fx_lv2_audio_mutex);
-
-  /* process data */
-  source_stream_mutex = AGS_AUDIO_SIGNAL_GET_STREAM_MUTEX(source);
-  base_plugin_mutex = AGS_BASE_PLUGIN_GET_OBJ_MUTEX(lv2_plugin);
-
-  g_rec_mutex_lock(base_plugin_mutex);
-
-  run = AGS_LV2_PLUGIN_DESCRIPTOR(AGS_BASE_PLUGIN(lv2_plugin)->plugin_descriptor)->run;
-  
-  g_rec_mutex_unlock(base_plugin_mutex);
-
   g_object_get(audio,
 	       "audio-start-mapping", &audio_start_mapping,
 	       "midi-start-mapping", &midi_start_mapping,
@@ -486,95 +487,79 @@ ags_fx_lv2_audio_signal_stream_feed(AgsFxNotationAudioSignal *fx_notation_audio_
       g_rec_mutex_unlock(fx_lv2_audio_mutex);
     }    
 
-    g_rec_mutex_lock(fx_lv2_audio_mutex);
-    
-    if(is_live_instrument){
-      if(fx_lv2_audio->has_event_port){
-	ags_lv2_plugin_event_buffer_append_midi(channel_data->event_port,
-						AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
-						input_data->event_buffer,
-						1);
-      }
+    /* note on at its sub-period position, once */
+    if(frame_count == 0){
+      snd_seq_event_t note_on;
 
-      if(fx_lv2_audio->has_atom_port){
-	ags_lv2_plugin_atom_sequence_append_midi(channel_data->atom_port,
-						 AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
-						 input_data->event_buffer,
-						 1);
-      }
-    }else{
-      if(fx_lv2_audio->has_event_port){
-	ags_lv2_plugin_event_buffer_append_midi(input_data->event_port,
-						AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
-						input_data->event_buffer,
-						1);
-      }
+      guint attack;
 
-      if(fx_lv2_audio->has_atom_port){
-	ags_lv2_plugin_atom_sequence_append_midi(input_data->atom_port,
-						 AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
-						 input_data->event_buffer,
-						 1);
-      }
-    }      
-
-    g_rec_mutex_unlock(fx_lv2_audio_mutex);
-    
-    if(is_live_instrument){
-      g_rec_mutex_lock(fx_lv2_audio_mutex);
+      attack = 0;
       
-      if(channel_data->output != NULL){
-	ags_audio_buffer_util_clear_float(channel_data->output, fx_lv2_audio->output_port_count,
-					  buffer_size);
-      }
-
-      if(run != NULL){
-	run(channel_data->lv2_handle[0],
-	    (uint32_t) (fx_lv2_audio->output_port_count * buffer_size));
-      }
-
-      g_rec_mutex_lock(source_stream_mutex);
+      g_object_get(source,
+		   "attack", &attack,
+		   NULL);
 
-      if(channel_data->output != NULL &&
-	 fx_lv2_audio->output_port_count >= 1 &&
-	 source->stream_current != NULL){
-	//NOTE:JK: only mono input, additional channels discarded
-	ags_audio_buffer_util_copy_buffer_to_buffer(source->stream_current->data, 1, 0,
-						    channel_data->output, fx_lv2_audio->output_port_count, 0,
-						    buffer_size, copy_mode_out);
+      if(attack >= buffer_size){
+	attack = buffer_size - 1;
       }
-	  
-      g_rec_mutex_unlock(source_stream_mutex);
-
-      g_rec_mutex_unlock(fx_lv2_audio_mutex);
-    }else{
-      g_rec_mutex_lock(fx_lv2_audio_mutex);
       
-      if(input_data->output != NULL){
-	ags_audio_buffer_util_clear_float(input_data->output, fx_lv2_audio->output_port_count,
-					  buffer_size);
-      }
+      g_rec_mutex_lock(fx_lv2_audio_mutex);
 
-      if(run != NULL){
-	run(input_data->lv2_handle[0],
-	    (uint32_t) (fx_lv2_audio->output_port_count * buffer_size));
-      }
+      memcpy(&note_on, input_data->event_buffer, sizeof(snd_seq_event_t));
+      
+      note_on.type = SND_SEQ_EVENT_NOTEON;
+      note_on.data.note.note = midi_note;
       
-      g_rec_mutex_lock(source_stream_mutex);
-
-      if(input_data->output != NULL &&
-	 fx_lv2_audio->output_port_count >= 1 &&
-	 source->stream_current != NULL){
-	//NOTE:JK: only mono input, additional channels discarded
-	ags_audio_buffer_util_copy_buffer_to_buffer(source->stream_current->data, 1, 0,
-						    input_data->output, fx_lv2_audio->output_port_count, 0,
-						    buffer_size, copy_mode_out);
+      if(is_live_instrument){
+	ags_lv2_plugin_event_buffer_append_midi_at(channel_data->event_port,
+						   AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
+						   attack,
+						   &note_on,
+						   1);
+	ags_lv2_plugin_atom_sequence_append_midi_at(channel_data->atom_port,
+						    AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
+						    attack,
+						    &note_on,
+						    1);
+      }else{
+	ags_lv2_plugin_event_buffer_append_midi_at(input_data->event_port,
+						   AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
+						   attack,
+						   &note_on,
+						   1);
+	ags_lv2_plugin_atom_sequence_append_midi_at(input_data->atom_port,
+						    AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
+						    attack,
+						    &note_on,
+						    1);
       }
-	  
-      g_rec_mutex_unlock(source_stream_mutex);
 
       g_rec_mutex_unlock(fx_lv2_audio_mutex);
     }
+    
+    if(is_live_instrument){
+      ags_fx_lv2_audio_signal_run_instance(fx_lv2_audio,
+					   channel_data->lv2_handle,
+					   (AgsLv2Worker *) channel_data->lv2_worker,
+					   channel_data->output,
+					   channel_data->event_port,
+					   channel_data->atom_port,
+					   &(channel_data->note_off_pending),
+					   source,
+					   buffer_size,
+					   copy_mode_out);
+    }else{
+      ags_fx_lv2_audio_signal_run_instance(fx_lv2_audio,
+					   input_data->lv2_handle,
+					   (AgsLv2Worker *) input_data->lv2_worker,
+					   input_data->output,
+					   input_data->event_port,
+					   input_data->atom_port,
+					   &(input_data->note_off_pending),
+					   source,
+					   buffer_size,
+					   copy_mode_out);
+    }
   }
   
   /* unref */
@@ -599,6 +584,145 @@ ags_fx_lv2_audio_signal_stream_feed(AgsFxNotationAudioSignal *fx_notation_audio_
   }
 }
 
+void
+ags_fx_lv2_audio_signal_done(AgsRecall *recall)
+{
+  AgsAudioSignal *source;
+
+  GList *start_note, *note;
+
+  source = NULL;
+
+  start_note = NULL;
+  
+  g_object_get(recall,
+	       "source", &source,
+	       NULL);
+
+  if(source != NULL){
+    g_object_get(source,
+		 "note", &start_note,
+		 NULL);
+  }
+
+  /* queue the note off of the notes still sounding, delivered by the next period's run or flushed before deactivate */
+  note = start_note;
+
+  while(note != NULL){
+    guint x0, x1;
+    guint y;
+
+    g_object_get(note->data,
+		 "x0", &x0,
+		 "x1", &x1,
+		 "y", &y,
+		 NULL);
+    
+    ags_audio_signal_remove_note(source,
+				 note->data);
+    
+    ags_fx_notation_audio_signal_notify_remove((AgsFxNotationAudioSignal *) recall,
+					       source,
+					       note->data,
+					       x0, x1,
+					       y);
+
+    note = note->next;
+  }
+
+  g_list_free_full(start_note,
+		   (GDestroyNotify) g_object_unref);
+
+  if(source != NULL){
+    g_object_unref(source);
+  }
+  
+  /* call parent */
+  AGS_RECALL_CLASS(ags_fx_lv2_audio_signal_parent_class)->done(recall);
+}
+
+void
+ags_fx_lv2_audio_signal_run_instance(AgsFxLv2Audio *fx_lv2_audio,
+				     LV2_Handle *lv2_handle,
+				     AgsLv2Worker *lv2_worker,
+				     float *output,
+				     gpointer event_port,
+				     gpointer atom_port,
+				     guint *note_off_pending,
+				     AgsAudioSignal *source,
+				     guint buffer_size,
+				     guint copy_mode_out)
+{
+  AgsLv2Plugin *lv2_plugin;
+
+  void (*run)(LV2_Handle instance,
+	      uint32_t sample_count);
+  
+  GRecMutex *source_stream_mutex;
+  GRecMutex *fx_lv2_audio_mutex;
+  GRecMutex *base_plugin_mutex;
+
+  fx_lv2_audio_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_lv2_audio);
+
+  g_rec_mutex_lock(fx_lv2_audio_mutex);
+
+  lv2_plugin = fx_lv2_audio->lv2_plugin;
+  
+  g_rec_mutex_unlock(fx_lv2_audio_mutex);
+
+  if(lv2_plugin == NULL ||
+     lv2_handle == NULL){
+    return;
+  }
+  
+  source_stream_mutex = AGS_AUDIO_SIGNAL_GET_STREAM_MUTEX(source);
+  base_plugin_mutex = AGS_BASE_PLUGIN_GET_OBJ_MUTEX(lv2_plugin);
+
+  g_rec_mutex_lock(base_plugin_mutex);
+
+  run = AGS_LV2_PLUGIN_DESCRIPTOR(AGS_BASE_PLUGIN(lv2_plugin)->plugin_descriptor)->run;
+  
+  g_rec_mutex_unlock(base_plugin_mutex);
+
+  /* process data */
+  g_rec_mutex_lock(fx_lv2_audio_mutex);
+      
+  if(output != NULL){
+    ags_audio_buffer_util_clear_float(output, fx_lv2_audio->output_port_count,
+				      buffer_size);
+  }
+
+  if(run != NULL){
+    ags_lv2_worker_deliver_response(lv2_worker);
+
+    run(lv2_handle[0],
+	(uint32_t) (fx_lv2_audio->output_port_count * buffer_size));
+
+    ags_lv2_worker_end_run(lv2_worker);
+
+    /* events consumed, including queued note offs */
+    ags_lv2_plugin_event_buffer_reset(event_port);
+    ags_lv2_plugin_atom_sequence_reset(atom_port);
+
+    note_off_pending[0] = 0;
+  }
+
+  g_rec_mutex_lock(source_stream_mutex);
+
+  if(output != NULL &&
+     fx_lv2_audio->output_port_count >= 1 &&
+     source->stream_current != NULL){
+    //NOTE:JK: only mono input, additional channels discarded
+    ags_audio_buffer_util_copy_buffer_to_buffer(source->stream_current->data, 1, 0,
+						output, fx_lv2_audio->output_port_count, 0,
+						buffer_size, copy_mode_out);
+  }
+	  
+  g_rec_mutex_unlock(source_stream_mutex);
+
+  g_rec_mutex_unlock(fx_lv2_audio_mutex);
+}
+
 void
 ags_fx_lv2_audio_signal_notify_remove(AgsFxNotationAudioSignal *fx_notation_audio_signal,
 				      AgsAudioSignal *source,
@@ -612,11 +736,16 @@ ags_fx_lv2_audio_signal_notify_remove(AgsFxNotationAudioSignal *fx_notation_audi
   AgsFxLv2ChannelProcessor *fx_lv2_channel_processor;
   AgsFxLv2Recycling *fx_lv2_recycling;
 
+  GObject *output_soundcard;
+  
+  gboolean is_live_instrument;
   guint sound_scope;
   guint audio_channel;
   guint audio_start_mapping;
   guint midi_start_mapping;
   gint midi_note;
+  guint buffer_size;
+  guint attack;
 
   GRecMutex *fx_lv2_audio_mutex;
 
@@ -629,6 +758,8 @@ ags_fx_lv2_audio_signal_notify_remove(AgsFxNotationAudioSignal *fx_notation_audi
 
   fx_lv2_recycling = NULL;
 
+  output_soundcard = NULL;
+  
   sound_scope = ags_recall_get_sound_scope(fx_notation_audio_signal);
 
   audio_channel = 0;
@@ -636,6 +767,8 @@ ags_fx_lv2_audio_signal_notify_remove(AgsFxNotationAudioSignal *fx_notation_audi
   audio_start_mapping = 0;
   midi_start_mapping = 0;
 
+  buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
+  
   g_object_get(fx_notation_audio_signal,
 	       "parent", &fx_lv2_recycling,
 	       NULL);
@@ -662,9 +795,31 @@ ags_fx_lv2_audio_signal_notify_remove(AgsFxNotationAudioSignal *fx_notation_audi
 	       "midi-start-mapping", &midi_start_mapping,
 	       NULL);
 
+  g_object_get(source,
+	       "output-soundcard", &output_soundcard,
+	       "buffer-size", &buffer_size,
+	       NULL);
+
   fx_lv2_audio_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_lv2_audio);
 
-  midi_note = (y - audio_start_mapping + midi_start_mapping);
+  is_live_instrument = ags_fx_lv2_audio_test_flags(fx_lv2_audio, AGS_FX_LV2_AUDIO_LIVE_INSTRUMENT);
+
+  if(ags_audio_test_behaviour_flags(audio, AGS_SOUND_BEHAVIOUR_REVERSE_MAPPING)){
+    midi_note = (128 - y - 1 - audio_start_mapping + midi_start_mapping);
+  }else{
+    midi_note = (y - audio_start_mapping + midi_start_mapping);
+  }
+
+  /* the note ends at the current tic, keep its sub-period position */
+  attack = 0;
+
+  if(output_soundcard != NULL){
+    attack = ags_soundcard_get_attack(AGS_SOUNDCARD(output_soundcard));
+  }
+
+  if(attack >= buffer_size){
+    attack = buffer_size - 1;
+  }
 
   if(midi_note >= 0 &&
      midi_note < 128){
@@ -672,6 +827,8 @@ ags_fx_lv2_audio_signal_notify_remove(AgsFxNotationAudioSignal *fx_notation_audi
     AgsFxLv2AudioChannelData *channel_data;
     AgsFxLv2AudioInputData *input_data;
 
+    snd_seq_event_t note_off;
+    
     g_rec_mutex_lock(fx_lv2_audio_mutex);
       
     scope_data = fx_lv2_audio->scope_data[sound_scope];
@@ -680,30 +837,47 @@ ags_fx_lv2_audio_signal_notify_remove(AgsFxNotationAudioSignal *fx_notation_audi
 
     input_data = channel_data->input_data[midi_note];
 
-    input_data->key_on -= 1;
+    if(input_data->key_on > 0){
+      input_data->key_on -= 1;
+    }
+    
+    memcpy(&note_off, input_data->event_buffer, sizeof(snd_seq_event_t));
+      
+    note_off.type = SND_SEQ_EVENT_NOTEOFF;
+    note_off.data.note.note = midi_note;
+    note_off.data.note.velocity = 0;
     
-    if(ags_fx_lv2_audio_test_flags(fx_lv2_audio, AGS_FX_LV2_AUDIO_LIVE_INSTRUMENT)){
-      if(channel_data->event_port != NULL){
-	ags_lv2_plugin_event_buffer_remove_midi(channel_data->event_port,
-						AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
-						midi_note);
-      }else if(channel_data->atom_port != NULL){
-	ags_lv2_plugin_atom_sequence_remove_midi(channel_data->atom_port,
+    if(is_live_instrument){
+      ags_lv2_plugin_event_buffer_append_midi_at(channel_data->event_port,
 						 AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
-						 midi_note);
-      }
+						 attack,
+						 &note_off,
+						 1);
+      ags_lv2_plugin_atom_sequence_append_midi_at(channel_data->atom_port,
+						  AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
+						  attack,
+						  &note_off,
+						  1);
     }else{
-      if(input_data->event_port != NULL){
-	ags_lv2_plugin_event_buffer_remove_midi(input_data->event_port,
-						AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
-						midi_note);
-      }else if(input_data->atom_port != NULL){
-	ags_lv2_plugin_atom_sequence_remove_midi(input_data->atom_port,
+      ags_lv2_plugin_event_buffer_append_midi_at(input_data->event_port,
 						 AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
-						 midi_note);
-      }
+						 attack,
+						 &note_off,
+						 1);
+      ags_lv2_plugin_atom_sequence_append_midi_at(input_data->atom_port,
+						  AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT,
+						  attack,
+						  &note_off,
+						  1);
     }
 
+    /* queued for the next period's run, ags_fx_lv2_audio_deliver_note_off() runs it if no stream feed does */
+    if(is_live_instrument){
+      channel_data->note_off_pending = 1;
+    }else{
+      input_data->note_off_pending = 1;
+    }
+    
     g_rec_mutex_unlock(fx_lv2_audio_mutex);
   }
   
@@ -711,6 +885,10 @@ ags_fx_lv2_audio_signal_notify_remove(AgsFxNotationAudioSignal *fx_notation_audi
     g_object_unref(audio);
   }
   
+  if(output_soundcard != NULL){
+    g_object_unref(output_soundcard);
+  }
+
   if(fx_lv2_audio != NULL){
     g_object_unref(fx_lv2_audio);
   }
@@ -21,6 +21,7 @@
 
 #include <ags/plugin/ags_lv2_manager.h>
 #include <ags/plugin/ags_lv2_plugin.h>
+#include <ags/plugin/ags_lv2_worker_manager.h>
 #include <ags/plugin/ags_base_plugin.h>
 #include <ags/plugin/ags_plugin_port.h>
 
@@ -317,11 +318,18 @@ ags_fx_lv2_channel_notify_samplerate_callback(GObject *gobject,
 
     if(cleanup != NULL &&
        input_data->lv2_handle != NULL){
+      ags_lv2_worker_manager_remove_handle(ags_lv2_worker_manager_get_instance(),
+					   input_data->lv2_handle[0]);
+      input_data->lv2_worker = NULL;
+
       cleanup(input_data->lv2_handle[0]);
     }
 
     input_data->lv2_handle = ags_base_plugin_instantiate((AgsBasePlugin *) lv2_plugin,
 							 samplerate, buffer_size);
+
+    input_data->lv2_worker = (GObject *) ags_lv2_worker_manager_find_worker(ags_lv2_worker_manager_get_instance(),
+									    ((input_data->lv2_handle != NULL) ? input_data->lv2_handle[0]: NULL));
   }
   
   g_rec_mutex_unlock(recall_mutex);
@@ -351,6 +359,7 @@ ags_fx_lv2_channel_input_data_alloc()
   input_data->input = NULL;
 
   input_data->lv2_handle = NULL;
+  input_data->lv2_worker = NULL;
 
   return(input_data);
 }
@@ -414,6 +423,10 @@ ags_fx_lv2_channel_input_data_free(AgsFxLv2ChannelInputData *input_data)
 
     if(cleanup != NULL &&
        input_data->lv2_handle != NULL){
+      ags_lv2_worker_manager_remove_handle(ags_lv2_worker_manager_get_instance(),
+					   input_data->lv2_handle[0]);
+      input_data->lv2_worker = NULL;
+
       cleanup(input_data->lv2_handle[0]);
     }
   }
@@ -493,6 +506,9 @@ ags_fx_lv2_channel_load_plugin(AgsFxLv2Channel *fx_lv2_channel)
       if(input_data->lv2_handle == NULL){
 	input_data->lv2_handle = ags_base_plugin_instantiate((AgsBasePlugin *) lv2_plugin,
 							     samplerate, buffer_size);
+
+	input_data->lv2_worker = (GObject *) ags_lv2_worker_manager_find_worker(ags_lv2_worker_manager_get_instance(),
+										((input_data->lv2_handle != NULL) ? input_data->lv2_handle[0]: NULL));
       }
     }
     
@@ -760,6 +776,9 @@ ags_fx_lv2_channel_load_port(AgsFxLv2Channel *fx_lv2_channel)
 		  if(input_data->lv2_handle == NULL){
 		    input_data->lv2_handle = ags_base_plugin_instantiate((AgsBasePlugin *) lv2_plugin,
 									 samplerate, buffer_size);
+
+		    input_data->lv2_worker = (GObject *) ags_lv2_worker_manager_find_worker(ags_lv2_worker_manager_get_instance(),
+											    ((input_data->lv2_handle != NULL) ? input_data->lv2_handle[0]: NULL));
 		  }
 
 		  ags_base_plugin_connect_port((AgsBasePlugin *) lv2_plugin,
@@ -845,6 +864,7 @@ ags_fx_lv2_channel_load_port(AgsFxLv2Channel *fx_lv2_channel)
 
 	  if(has_atom_port){
 	    input_data->atom_port = ags_lv2_plugin_alloc_atom_sequence(AGS_FX_LV2_AUDIO_DEFAULT_MIDI_LENGHT);
+	    ags_lv2_plugin_atom_sequence_reset(input_data->atom_port);
 	    
 	    ags_base_plugin_connect_port((AgsBasePlugin *) lv2_plugin,
 					 input_data->lv2_handle[0],
@@ -1011,6 +1031,9 @@ ags_fx_lv2_channel_load_port(AgsFxLv2Channel *fx_lv2_channel)
 	    if(input_data->lv2_handle == NULL){
 	      input_data->lv2_handle = ags_base_plugin_instantiate((AgsBasePlugin *) lv2_plugin,
 								   samplerate, buffer_size);
+
+	      input_data->lv2_worker = (GObject *) ags_lv2_worker_manager_find_worker(ags_lv2_worker_manager_get_instance(),
+										      ((input_data->lv2_handle != NULL) ? input_data->lv2_handle[0]: NULL));
 	    }
 
 	    ags_base_plugin_connect_port((AgsBasePlugin *) lv2_plugin,
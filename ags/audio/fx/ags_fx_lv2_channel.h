@@ -86,6 +86,7 @@ struct _AgsFxLv2ChannelInputData
   float *input;
 
   LV2_Handle *lv2_handle;
+  GObject *lv2_worker;
 };
 
 GType ags_fx_lv2_channel_get_type();
@@ -26,6 +26,7 @@
 #include <ags/audio/ags_port.h>
 #include <ags/audio/ags_notation.h>
 #include <ags/audio/ags_note.h>
+#include <ags/audio/ags_midiin.h>
 #include <ags/audio/ags_recall_id.h>
 #include <ags/audio/ags_recycling_context.h>
 
@@ -33,6 +34,8 @@
 
 #include <ags/audio/fx/ags_fx_notation_audio.h>
 
+#include <ags/audio/task/ags_update_notation_snapshot.h>
+
 #include <ags/i18n.h>
 
 void ags_fx_notation_audio_processor_class_init(AgsFxNotationAudioProcessorClass *fx_notation_audio_processor);
@@ -1242,26 +1245,30 @@ ags_fx_notation_audio_processor_real_play(AgsFxNotationAudioProcessor *fx_notati
 					      timestamp);
 
   if(notation != NULL){
-    GList *start_note, *note;
-    
-    start_note = ags_notation_find_offset(notation->data,
-					  offset_counter,
-					  FALSE);
+    AgsNotationSnapshot *snapshot;
 
-    note = start_note;
-
-    while(note != NULL){
-      ags_fx_notation_audio_processor_key_on(fx_notation_audio_processor,
-					     note->data,
-					     AGS_FX_NOTATION_AUDIO_PROCESSOR_DEFAULT_KEY_ON_VELOCITY,
-					     AGS_FX_NOTATION_AUDIO_PROCESSOR_KEY_MODE_PLAY);
-
-      /* iterate */
-      note = note->next;
+    guint i;
+    
+    /* scan the published snapshot without locking the notes */
+    snapshot = ags_notation_acquire_snapshot(notation->data);
+
+    if(snapshot != NULL){
+      i = ags_notation_snapshot_find_offset(snapshot,
+					    (guint) offset_counter);
+
+      while(i < snapshot->n_notes &&
+	    snapshot->x0[i] == offset_counter){
+	ags_fx_notation_audio_processor_key_on(fx_notation_audio_processor,
+					       snapshot->note[i],
+					       AGS_FX_NOTATION_AUDIO_PROCESSOR_DEFAULT_KEY_ON_VELOCITY,
+					       AGS_FX_NOTATION_AUDIO_PROCESSOR_KEY_MODE_PLAY);
+
+	/* iterate */
+	i++;
+      }
     }
-
-    g_list_free_full(start_note,
-		     (GDestroyNotify) g_object_unref);
+    
+    ags_notation_release_snapshot(notation->data);
   }
 
   g_object_unref(audio);
@@ -1310,8 +1317,10 @@ ags_fx_notation_audio_processor_real_record(AgsFxNotationAudioProcessor *fx_nota
   guint64 offset_counter;
   guint audio_channel;
   guint buffer_length;
+  guint audio_buffer_size;
   gboolean reverse_mapping;
   gboolean pattern_mode;
+  gboolean notation_edited;
 
   GValue value = {0,};
   
@@ -1349,6 +1358,8 @@ ags_fx_notation_audio_processor_real_record(AgsFxNotationAudioProcessor *fx_nota
   midi_end_mapping = 0;
 
   midi_channel = 0;
+
+  audio_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   
   g_object_get(audio,
 	       "input-sequencer", &input_sequencer,
@@ -1357,6 +1368,7 @@ ags_fx_notation_audio_processor_real_record(AgsFxNotationAudioProcessor *fx_nota
 	       "midi-start-mapping", &midi_start_mapping,
 	       "midi-end-mapping", &midi_end_mapping,
 	       "midi-channel", &midi_channel,
+	       "buffer-size", &audio_buffer_size,
 	       NULL);
 
   if(input_sequencer == NULL){
@@ -1376,6 +1388,8 @@ ags_fx_notation_audio_processor_real_record(AgsFxNotationAudioProcessor *fx_nota
   start_notation = NULL;
   start_note = NULL;
 
+  notation_edited = FALSE;
+
   g_object_get(audio,
 	       "notation", &start_notation,
 	       NULL);
@@ -1500,6 +1514,13 @@ ags_fx_notation_audio_processor_real_record(AgsFxNotationAudioProcessor *fx_nota
 	    
 	      current_note->x[0] = offset_counter;
 	      current_note->x[1] = offset_counter + 1;
+
+	      /* sub-period attack */
+	      if(AGS_IS_MIDIIN(input_sequencer)){
+		current_note->rt_attack = ags_midiin_get_frame_offset((AgsMidiin *) input_sequencer,
+								      midi_iter - midi_buffer,
+								      audio_buffer_size);
+	      }
 	      
 	      current_note->y = y;
 		
@@ -1532,6 +1553,8 @@ ags_fx_notation_audio_processor_real_record(AgsFxNotationAudioProcessor *fx_nota
 	      ags_notation_add_note(current_notation,
 				    current_note,
 				    FALSE);
+
+	      notation_edited = TRUE;
 	    }else{
 	      if((0x7f & (midi_iter[2])) == 0){
 		/* note-off */
@@ -1683,6 +1706,26 @@ ags_fx_notation_audio_processor_real_record(AgsFxNotationAudioProcessor *fx_nota
   ags_sequencer_unlock_buffer(AGS_SEQUENCER(input_sequencer),
 			      midi_buffer);
 
+  /* rebuild snapshot off the audio thread */
+  if(notation_edited){
+    AgsUpdateNotationSnapshot *update_notation_snapshot;
+
+    AgsTaskLauncher *task_launcher;
+
+    AgsApplicationContext *application_context;
+
+    application_context = ags_application_context_get_instance();
+
+    task_launcher = ags_concurrency_provider_get_task_launcher(AGS_CONCURRENCY_PROVIDER(application_context));
+
+    update_notation_snapshot = ags_update_notation_snapshot_new(current_notation);
+    
+    ags_task_launcher_add_task(task_launcher,
+			       (AgsTask *) update_notation_snapshot);
+
+    g_object_unref(task_launcher);
+  }
+
   /* key on */
   note = start_note;
 
@@ -27,6 +27,7 @@
 #include <ags/audio/ags_note.h>
 #include <ags/audio/ags_recall_id.h>
 #include <ags/audio/ags_recycling_context.h>
+#include <ags/audio/ags_meter_snapshot.h>
 
 #include <ags/audio/midi/ags_midi_util.h>
 
@@ -218,6 +219,10 @@ ags_fx_pattern_audio_processor_init(AgsFxPatternAudioProcessor *fx_pattern_audio
 
   fx_pattern_audio_processor->current_delay_counter = 0.0;
   fx_pattern_audio_processor->current_offset_counter = 0;
+
+  /* meter snapshot */
+  fx_pattern_audio_processor->meter_slot = AGS_METER_SNAPSHOT_INVALID_SLOT;
+  fx_pattern_audio_processor->meter_subscription_generation = 0;
 }
 
 void
@@ -713,6 +718,7 @@ ags_fx_pattern_audio_processor_run_inter(AgsRecall *recall)
   
   gint sound_scope;
   gdouble delay_counter;
+  guint64 offset_counter;
   
   GRecMutex *fx_pattern_audio_processor_mutex;
 
@@ -756,14 +762,51 @@ ags_fx_pattern_audio_processor_run_inter(AgsRecall *recall)
   fx_pattern_audio_processor->offset_counter = fx_pattern_audio_processor->current_offset_counter;
 
   delay_counter = fx_pattern_audio_processor->delay_counter;
+  offset_counter = fx_pattern_audio_processor->offset_counter;
 
   g_rec_mutex_unlock(fx_pattern_audio_processor_mutex);
 
   /* run */
   if(ags_recall_id_check_sound_scope(recall_id, AGS_SOUND_SCOPE_SEQUENCER)){
-    if(parent_recycling_context == NULL &&
-       delay_counter == 0.0){
-      ags_fx_pattern_audio_processor_play(fx_pattern_audio_processor);
+    if(parent_recycling_context == NULL){
+      AgsAudio *audio;
+      AgsMeterSnapshot *meter_snapshot;
+
+      guint meter_slot;
+      guint subscription_generation;
+      
+      audio = NULL;
+      
+      g_object_get(recall,
+		   "audio", &audio,
+		   NULL);
+
+      /* publish active led - slot looked up again only if subscriptions changed */
+      meter_snapshot = ags_meter_snapshot_get_instance();
+
+      subscription_generation = ags_meter_snapshot_get_subscription_generation(meter_snapshot);
+
+      if(fx_pattern_audio_processor->meter_subscription_generation != subscription_generation &&
+	 ags_meter_snapshot_try_find_slot(meter_snapshot,
+					  (GObject *) audio,
+					  AGS_METER_SNAPSHOT_ENTRY_PUSHED,
+					  &meter_slot)){
+	fx_pattern_audio_processor->meter_slot = meter_slot;
+	fx_pattern_audio_processor->meter_subscription_generation = subscription_generation;
+      }
+      
+      ags_meter_snapshot_put(meter_snapshot,
+			     fx_pattern_audio_processor->meter_slot,
+			     (GObject *) audio,
+			     (gdouble) offset_counter);
+
+      if(audio != NULL){
+	g_object_unref(audio);
+      }
+      
+      if(delay_counter == 0.0){
+	ags_fx_pattern_audio_processor_play(fx_pattern_audio_processor);
+      }
     }
   }
   
@@ -54,6 +54,9 @@ struct _AgsFxPatternAudioProcessor
 
   gdouble current_delay_counter;  
   guint64 current_offset_counter;
+
+  guint meter_slot;
+  guint meter_subscription_generation;
 };
 
 struct _AgsFxPatternAudioProcessorClass
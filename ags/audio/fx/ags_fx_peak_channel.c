@@ -21,6 +21,8 @@
 
 #include <ags/plugin/ags_plugin_port.h>
 
+#include <ags/audio/ags_audio_buffer_util.h>
+
 #include <ags/audio/task/ags_reset_fx_peak.h>
 
 #include <ags/i18n.h>
@@ -43,6 +45,8 @@ void ags_fx_peak_channel_notify_buffer_size_callback(GObject *gobject,
 						     gpointer user_data);
 
 static AgsPluginPort* ags_fx_peak_channel_get_peak_plugin_port();
+static AgsPluginPort* ags_fx_peak_channel_get_loudness_plugin_port();
+static AgsPluginPort* ags_fx_peak_channel_get_true_peak_plugin_port();
 
 /**
  * SECTION:ags_fx_peak_channel
@@ -52,6 +56,10 @@ static AgsPluginPort* ags_fx_peak_channel_get_peak_plugin_port();
  * @include: ags/audio/fx/ags_fx_peak_channel.h
  *
  * The #AgsFxPeakChannel class provides ports to the effect processor.
+ *
+ * It measures the sample peak, the momentary loudness and the
+ * true-peak of the channel. All sound scopes are mixed into one stream, so
+ * the K-weighting filter of the channel sees a single signal.
  */
 
 static gpointer ags_fx_peak_channel_parent_class = NULL;
@@ -60,17 +68,24 @@ const gchar *ags_fx_peak_channel_plugin_name = "ags-fx-peak";
 
 const gchar *ags_fx_peak_channel_specifier[] = {
   "./peak[0]",
+  "./loudness[0]",
+  "./true-peak[0]",
   NULL,
 };
 
 const gchar *ags_fx_peak_channel_control_port[] = {
-  "1/1",
+  "1/3",
+  "2/3",
+  "3/3",
   NULL,
 };
 
 enum{
   PROP_0,
   PROP_PEAK,
+  PROP_LOUDNESS,
+  PROP_TRUE_PEAK,
+  PROP_LEVEL_UTIL,
 };
 
 GType
@@ -138,6 +153,54 @@ ags_fx_peak_channel_class_init(AgsFxPeakChannelClass *fx_peak_channel)
   g_object_class_install_property(gobject,
 				  PROP_PEAK,
 				  param_spec);
+
+  /**
+   * AgsFxPeakChannel:loudness:
+   *
+   * The momentary loudness in LUFS.
+   * 
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_object("loudness",
+				   i18n_pspec("loudness of recall"),
+				   i18n_pspec("The recall's momentary loudness"),
+				   AGS_TYPE_PORT,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_LOUDNESS,
+				  param_spec);
+
+  /**
+   * AgsFxPeakChannel:true-peak:
+   *
+   * The true-peak in dBTP.
+   * 
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_object("true-peak",
+				   i18n_pspec("true-peak of recall"),
+				   i18n_pspec("The recall's true-peak"),
+				   AGS_TYPE_PORT,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_TRUE_PEAK,
+				  param_spec);
+
+  /**
+   * AgsFxPeakChannel:level-util:
+   *
+   * The #AgsLevelUtil-struct analysing the channel, read its block ring for
+   * peak, RMS, true-peak and loudness.
+   * 
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_pointer("level-util",
+				    i18n_pspec("level util"),
+				    i18n_pspec("The level util"),
+				    G_PARAM_READABLE);
+  g_object_class_install_property(gobject,
+				  PROP_LEVEL_UTIL,
+				  param_spec);
 }
 
 void
@@ -145,6 +208,7 @@ ags_fx_peak_channel_init(AgsFxPeakChannel *fx_peak_channel)
 {
   AgsResetFxPeak *reset_fx_peak;
 
+  guint samplerate;
   guint buffer_size;
   guint i;
   
@@ -156,11 +220,13 @@ ags_fx_peak_channel_init(AgsFxPeakChannel *fx_peak_channel)
   AGS_RECALL(fx_peak_channel)->build_id = AGS_RECALL_DEFAULT_BUILD_ID;
   AGS_RECALL(fx_peak_channel)->xml_type = "ags-fx-peak-channel";
 
+  samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
 
   fx_peak_channel->peak_reseted = TRUE;
 
   g_object_get(fx_peak_channel,
+	       "samplerate", &samplerate,
 	       "buffer-size", &buffer_size,
 	       NULL);
   
@@ -185,6 +251,48 @@ ags_fx_peak_channel_init(AgsFxPeakChannel *fx_peak_channel)
   ags_recall_add_port((AgsRecall *) fx_peak_channel,
 		      fx_peak_channel->peak);
 
+  /* loudness */
+  fx_peak_channel->loudness = g_object_new(AGS_TYPE_PORT,
+					   "plugin-name", ags_fx_peak_channel_plugin_name,
+					   "specifier", ags_fx_peak_channel_specifier[1],
+					   "control-port", ags_fx_peak_channel_control_port[1],
+					   "port-value-is-pointer", FALSE,
+					   "port-value-type", G_TYPE_FLOAT,
+					   "port-value-size", sizeof(gfloat),
+					   "port-value-length", 1,
+					   NULL);
+  ags_port_set_flags(fx_peak_channel->loudness, AGS_PORT_IS_OUTPUT);
+  
+  fx_peak_channel->loudness->port_value.ags_port_float = (gfloat) AGS_LEVEL_UTIL_SILENCE;
+
+  g_object_set(fx_peak_channel->loudness,
+	       "plugin-port", ags_fx_peak_channel_get_loudness_plugin_port(),
+	       NULL);
+
+  ags_recall_add_port((AgsRecall *) fx_peak_channel,
+		      fx_peak_channel->loudness);
+
+  /* true-peak */
+  fx_peak_channel->true_peak = g_object_new(AGS_TYPE_PORT,
+					    "plugin-name", ags_fx_peak_channel_plugin_name,
+					    "specifier", ags_fx_peak_channel_specifier[2],
+					    "control-port", ags_fx_peak_channel_control_port[2],
+					    "port-value-is-pointer", FALSE,
+					    "port-value-type", G_TYPE_FLOAT,
+					    "port-value-size", sizeof(gfloat),
+					    "port-value-length", 1,
+					    NULL);
+  ags_port_set_flags(fx_peak_channel->true_peak, AGS_PORT_IS_OUTPUT);
+  
+  fx_peak_channel->true_peak->port_value.ags_port_float = (gfloat) AGS_LEVEL_UTIL_SILENCE;
+
+  g_object_set(fx_peak_channel->true_peak,
+	       "plugin-port", ags_fx_peak_channel_get_true_peak_plugin_port(),
+	       NULL);
+
+  ags_recall_add_port((AgsRecall *) fx_peak_channel,
+		      fx_peak_channel->true_peak);
+
   /* input data */
   for(i = 0; i < AGS_SOUND_SCOPE_LAST; i++){
     fx_peak_channel->input_data[i] = ags_fx_peak_channel_input_data_alloc();
@@ -194,6 +302,12 @@ ags_fx_peak_channel_init(AgsFxPeakChannel *fx_peak_channel)
     fx_peak_channel->input_data[i]->buffer = (gdouble *) g_malloc(buffer_size * sizeof(gdouble));
   }
 
+  /* level - all sound scopes mixed */
+  fx_peak_channel->level_buffer = (gdouble *) g_malloc0(buffer_size * sizeof(gdouble));
+
+  fx_peak_channel->level_util = ags_level_util_alloc(1,
+						     samplerate);
+
   /* add to reset peak task */
   reset_fx_peak = ags_reset_fx_peak_get_instance();
 
@@ -244,6 +358,60 @@ ags_fx_peak_channel_set_property(GObject *gobject,
     g_rec_mutex_unlock(recall_mutex);	
   }
   break;
+  case PROP_LOUDNESS:
+  {
+    AgsPort *port;
+
+    port = (AgsPort *) g_value_get_object(value);
+
+    g_rec_mutex_lock(recall_mutex);
+
+    if(port == fx_peak_channel->loudness){
+      g_rec_mutex_unlock(recall_mutex);	
+
+      return;
+    }
+
+    if(fx_peak_channel->loudness != NULL){
+      g_object_unref(G_OBJECT(fx_peak_channel->loudness));
+    }
+      
+    if(port != NULL){
+      g_object_ref(G_OBJECT(port));
+    }
+
+    fx_peak_channel->loudness = port;
+      
+    g_rec_mutex_unlock(recall_mutex);	
+  }
+  break;
+  case PROP_TRUE_PEAK:
+  {
+    AgsPort *port;
+
+    port = (AgsPort *) g_value_get_object(value);
+
+    g_rec_mutex_lock(recall_mutex);
+
+    if(port == fx_peak_channel->true_peak){
+      g_rec_mutex_unlock(recall_mutex);	
+
+      return;
+    }
+
+    if(fx_peak_channel->true_peak != NULL){
+      g_object_unref(G_OBJECT(fx_peak_channel->true_peak));
+    }
+      
+    if(port != NULL){
+      g_object_ref(G_OBJECT(port));
+    }
+
+    fx_peak_channel->true_peak = port;
+      
+    g_rec_mutex_unlock(recall_mutex);	
+  }
+  break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
     break;
@@ -275,6 +443,33 @@ ags_fx_peak_channel_get_property(GObject *gobject,
     g_rec_mutex_unlock(recall_mutex);	
   }
   break;
+  case PROP_LOUDNESS:
+  {
+    g_rec_mutex_lock(recall_mutex);
+
+    g_value_set_object(value, fx_peak_channel->loudness);
+      
+    g_rec_mutex_unlock(recall_mutex);	
+  }
+  break;
+  case PROP_TRUE_PEAK:
+  {
+    g_rec_mutex_lock(recall_mutex);
+
+    g_value_set_object(value, fx_peak_channel->true_peak);
+      
+    g_rec_mutex_unlock(recall_mutex);	
+  }
+  break;
+  case PROP_LEVEL_UTIL:
+  {
+    g_rec_mutex_lock(recall_mutex);
+
+    g_value_set_pointer(value, fx_peak_channel->level_util);
+      
+    g_rec_mutex_unlock(recall_mutex);	
+  }
+  break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
     break;
@@ -294,6 +489,20 @@ ags_fx_peak_channel_dispose(GObject *gobject)
 
     fx_peak_channel->peak = NULL;
   }  
+
+  /* loudness */
+  if(fx_peak_channel->loudness != NULL){
+    g_object_unref(G_OBJECT(fx_peak_channel->loudness));
+
+    fx_peak_channel->loudness = NULL;
+  }  
+
+  /* true-peak */
+  if(fx_peak_channel->true_peak != NULL){
+    g_object_unref(G_OBJECT(fx_peak_channel->true_peak));
+
+    fx_peak_channel->true_peak = NULL;
+  }  
   
   /* call parent */
   G_OBJECT_CLASS(ags_fx_peak_channel_parent_class)->dispose(gobject);
@@ -315,11 +524,26 @@ ags_fx_peak_channel_finalize(GObject *gobject)
     g_object_unref(G_OBJECT(fx_peak_channel->peak));
   }
 
+  /* loudness */
+  if(fx_peak_channel->loudness != NULL){
+    g_object_unref(G_OBJECT(fx_peak_channel->loudness));
+  }
+
+  /* true-peak */
+  if(fx_peak_channel->true_peak != NULL){
+    g_object_unref(G_OBJECT(fx_peak_channel->true_peak));
+  }
+
   /* input data */
   for(i = 0; i < AGS_SOUND_SCOPE_LAST; i++){
     ags_fx_peak_channel_input_data_free(fx_peak_channel->input_data[i]);
   }
 
+  /* level */
+  g_free(fx_peak_channel->level_buffer);
+  
+  ags_level_util_free(fx_peak_channel->level_util);
+
   /* reset ags-fx-peak task */
   reset_fx_peak = ags_reset_fx_peak_get_instance();
   
@@ -369,6 +593,14 @@ ags_fx_peak_channel_notify_buffer_size_callback(GObject *gobject,
       }
     }
   }
+
+  if(buffer_size > 0){
+    fx_peak_channel->level_buffer = (gdouble *) g_realloc(fx_peak_channel->level_buffer,
+							  buffer_size * sizeof(gdouble));
+
+    ags_audio_buffer_util_clear_double(fx_peak_channel->level_buffer, 1,
+				       buffer_size);
+  }
   
   g_rec_mutex_unlock(recall_mutex);
 }
@@ -457,6 +689,84 @@ ags_fx_peak_channel_get_peak_plugin_port()
   return(plugin_port);
 }
 
+static AgsPluginPort*
+ags_fx_peak_channel_get_loudness_plugin_port()
+{
+  static AgsPluginPort *plugin_port = NULL;
+
+  static GMutex mutex;
+
+  g_mutex_lock(&mutex);
+  
+  if(plugin_port == NULL){
+    plugin_port = ags_plugin_port_new();
+    g_object_ref(plugin_port);
+    
+    plugin_port->flags |= (AGS_PLUGIN_PORT_OUTPUT |
+			   AGS_PLUGIN_PORT_CONTROL);
+
+    plugin_port->port_index = 1;
+
+    /* range */
+    g_value_init(plugin_port->default_value,
+		 G_TYPE_FLOAT);
+    g_value_init(plugin_port->lower_value,
+		 G_TYPE_FLOAT);
+    g_value_init(plugin_port->upper_value,
+		 G_TYPE_FLOAT);
+
+    g_value_set_float(plugin_port->default_value,
+		      (gfloat) AGS_LEVEL_UTIL_SILENCE);
+    g_value_set_float(plugin_port->lower_value,
+		      (gfloat) AGS_LEVEL_UTIL_SILENCE);
+    g_value_set_float(plugin_port->upper_value,
+		      0.0);
+  }
+
+  g_mutex_unlock(&mutex);
+    
+  return(plugin_port);
+}
+
+static AgsPluginPort*
+ags_fx_peak_channel_get_true_peak_plugin_port()
+{
+  static AgsPluginPort *plugin_port = NULL;
+
+  static GMutex mutex;
+
+  g_mutex_lock(&mutex);
+  
+  if(plugin_port == NULL){
+    plugin_port = ags_plugin_port_new();
+    g_object_ref(plugin_port);
+    
+    plugin_port->flags |= (AGS_PLUGIN_PORT_OUTPUT |
+			   AGS_PLUGIN_PORT_CONTROL);
+
+    plugin_port->port_index = 2;
+
+    /* range */
+    g_value_init(plugin_port->default_value,
+		 G_TYPE_FLOAT);
+    g_value_init(plugin_port->lower_value,
+		 G_TYPE_FLOAT);
+    g_value_init(plugin_port->upper_value,
+		 G_TYPE_FLOAT);
+
+    g_value_set_float(plugin_port->default_value,
+		      (gfloat) AGS_LEVEL_UTIL_SILENCE);
+    g_value_set_float(plugin_port->lower_value,
+		      (gfloat) AGS_LEVEL_UTIL_SILENCE);
+    g_value_set_float(plugin_port->upper_value,
+		      6.0);
+  }
+
+  g_mutex_unlock(&mutex);
+    
+  return(plugin_port);
+}
+
 /**
  * ags_fx_peak_channel_new:
  * @channel: the #AgsChannel
@@ -26,6 +26,7 @@
 #include <ags/libags.h>
 
 #include <ags/audio/ags_channel.h>
+#include <ags/audio/ags_level_util.h>
 #include <ags/audio/ags_recall_channel.h>
 
 G_BEGIN_DECLS
@@ -52,7 +53,12 @@ struct _AgsFxPeakChannel
 
   AgsFxPeakChannelInputData* input_data[AGS_SOUND_SCOPE_LAST];
 
+  gdouble *level_buffer;
+  AgsLevelUtil *level_util;
+
   AgsPort *peak;
+  AgsPort *loudness;
+  AgsPort *true_peak;
 };
 
 struct _AgsFxPeakChannelClass
@@ -101,6 +101,8 @@ ags_fx_peak_channel_processor_class_init(AgsFxPeakChannelProcessorClass *fx_peak
 void
 ags_fx_peak_channel_processor_init(AgsFxPeakChannelProcessor *fx_peak_channel_processor)
 {
+  ags_recall_set_flags((AgsRecall *) fx_peak_channel_processor, AGS_RECALL_NON_ESSENTIAL);
+
   AGS_RECALL(fx_peak_channel_processor)->name = "ags-fx-peak";
   AGS_RECALL(fx_peak_channel_processor)->version = AGS_RECALL_DEFAULT_VERSION;
   AGS_RECALL(fx_peak_channel_processor)->build_id = AGS_RECALL_DEFAULT_BUILD_ID;
@@ -137,6 +139,7 @@ ags_fx_peak_channel_processor_real_run_inter(AgsRecall *recall)
   AgsFxPeakChannel *fx_peak_channel;
   
   gdouble peak;
+  guint samplerate;
   guint buffer_size;
   gint sound_scope;
 
@@ -150,69 +153,121 @@ ags_fx_peak_channel_processor_real_run_inter(AgsRecall *recall)
 
   peak = 0.0;
 
+  samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   
   g_object_get(recall,
 	       "recall-channel", &fx_peak_channel,
+	       "samplerate", &samplerate,
 	       "buffer-size", &buffer_size,
 	       NULL);
     
   if(fx_peak_channel != NULL){
     AgsPort *port;
+    AgsPort *loudness, *true_peak;
 
+    AgsLevelUtilBlock *block;
+    
+    gdouble momentary, true_peak_db;
     gboolean peak_reseted;
     
     GValue value = {0,};
 
     port = NULL;
 
+    loudness = NULL;
+    true_peak = NULL;
+
     g_object_get(fx_peak_channel,
 		 "peak", &port,
+		 "loudness", &loudness,
+		 "true-peak", &true_peak,
 		 NULL);
     
     fx_peak_channel_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_peak_channel);
-  
+
+    momentary = AGS_LEVEL_UTIL_SILENCE;
+    true_peak_db = AGS_LEVEL_UTIL_SILENCE;
+    
     g_rec_mutex_lock(fx_peak_channel_mutex);
 
     peak_reseted = fx_peak_channel->peak_reseted;
 
     fx_peak_channel->peak_reseted = TRUE;
     
-    if(!peak_reseted &&
-       port != NULL){
-      g_value_init(&value, G_TYPE_FLOAT);
+    if(!peak_reseted){
+      /* analyse the previous cycle, all sound scopes mixed */
+      ags_level_util_set_samplerate(fx_peak_channel->level_util,
+				    samplerate);
 
-      g_value_set_float(&value, 0.0);
-      
-      ags_port_safe_write(port, &value);
+      ags_level_util_analyse(fx_peak_channel->level_util,
+			     fx_peak_channel->level_buffer, buffer_size,
+			     AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+      ags_audio_buffer_util_clear_double(fx_peak_channel->level_buffer, 1,
+					 buffer_size);
+
+      momentary = ags_level_util_get_momentary(fx_peak_channel->level_util);
 
-      g_value_unset(&value);
+      block = ags_level_util_get_block(fx_peak_channel->level_util,
+				       0);
+
+      if(block != NULL){
+	peak = block->peak[0];
+	true_peak_db = ags_level_util_to_db(block->true_peak[0]);
+      }
     }
-  
-    peak = ags_audio_buffer_util_peak(fx_peak_channel->input_data[sound_scope]->buffer, 1,
-				      AGS_AUDIO_BUFFER_UTIL_DOUBLE,
-				      buffer_size,
-				      440.0,
-				      22000.0,
-				      1.0);
+
+    /* one K-weighting filter state per channel - mix the sound scope in */
+    ags_audio_buffer_util_copy_double_to_double(fx_peak_channel->level_buffer, 1,
+						fx_peak_channel->input_data[sound_scope]->buffer, 1,
+						buffer_size);
 
     ags_audio_buffer_util_clear_buffer(fx_peak_channel->input_data[sound_scope]->buffer, 1,
 				       buffer_size, AGS_AUDIO_BUFFER_UTIL_DOUBLE);
     
     g_rec_mutex_unlock(fx_peak_channel_mutex);
 
-    if(port != NULL){
-      g_value_init(&value, G_TYPE_FLOAT);
+    if(!peak_reseted){
+      if(port != NULL){
+	g_value_init(&value, G_TYPE_FLOAT);
 
-      ags_port_safe_read(port, &value);
+	g_value_set_float(&value, (gfloat) peak);
+	ags_port_safe_write(port, &value);
+      
+	g_value_unset(&value);
+      }
       
-      g_value_set_float(&value, g_value_get_float(&value) + (gfloat) peak);
-      ags_port_safe_write(port, &value);
+      if(loudness != NULL){
+	g_value_init(&value, G_TYPE_FLOAT);
+
+	g_value_set_float(&value, (gfloat) momentary);
+	ags_port_safe_write(loudness, &value);
       
-      g_value_unset(&value);
+	g_value_unset(&value);
+      }
+
+      if(true_peak != NULL){
+	g_value_init(&value, G_TYPE_FLOAT);
+
+	g_value_set_float(&value, (gfloat) true_peak_db);
+	ags_port_safe_write(true_peak, &value);
       
+	g_value_unset(&value);
+      }
+    }
+    
+    if(port != NULL){
       g_object_unref(port);
     }
+
+    if(loudness != NULL){
+      g_object_unref(loudness);
+    }
+
+    if(true_peak != NULL){
+      g_object_unref(true_peak);
+    }
   }
 
   /* unref */
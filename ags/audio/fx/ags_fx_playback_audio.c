@@ -393,6 +393,8 @@ ags_fx_playback_audio_init(AgsFxPlaybackAudio *fx_playback_audio)
   fx_playback_audio->feed_audio_signal = NULL;
   fx_playback_audio->master_audio_signal = NULL;
 
+  fx_playback_audio->wave_stream = NULL;
+
   fx_playback_audio->audio_file = NULL;
   
   bpm = AGS_SOUNDCARD_DEFAULT_BPM;
@@ -1190,6 +1192,13 @@ ags_fx_playback_audio_dispose(GObject *gobject)
     fx_playback_audio->master_audio_signal = NULL;
   }
 
+  if(fx_playback_audio->wave_stream != NULL){
+    g_list_free_full(fx_playback_audio->wave_stream,
+		     (GDestroyNotify) g_object_unref);
+
+    fx_playback_audio->wave_stream = NULL;
+  }
+
   if(fx_playback_audio->bpm != NULL){
     g_object_unref(fx_playback_audio->bpm);
 
@@ -1295,6 +1304,11 @@ ags_fx_playback_audio_finalize(GObject *gobject)
 		     (GDestroyNotify) g_object_unref);
   }
 
+  if(fx_playback_audio->wave_stream != NULL){
+    g_list_free_full(fx_playback_audio->wave_stream,
+		     (GDestroyNotify) g_object_unref);
+  }
+
   if(fx_playback_audio->audio_file != NULL){
     g_object_unref(fx_playback_audio->audio_file);
   }
@@ -1662,6 +1676,233 @@ ags_fx_playback_audio_remove_master_audio_signal(AgsFxPlaybackAudio *fx_playback
   g_rec_mutex_unlock(recall_mutex);
 }
 
+/**
+ * ags_fx_playback_audio_get_wave_stream:
+ * @fx_playback_audio: the #AgsFxPlaybackAudio
+ * 
+ * Get wave stream of @fx_playback_audio.
+ * 
+ * Returns: (element-type AgsAudio.WaveStream) (transfer full): the #GList-struct containing wave stream
+ * 
+ * Since: 3.5.0
+ */
+GList*
+ags_fx_playback_audio_get_wave_stream(AgsFxPlaybackAudio *fx_playback_audio)
+{
+  GList *wave_stream;
+  
+  GRecMutex *recall_mutex;
+
+  if(!AGS_IS_FX_PLAYBACK_AUDIO(fx_playback_audio)){
+    return(NULL);
+  }
+
+  /* get recall mutex */
+  recall_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_playback_audio);
+
+  /* get */
+  g_rec_mutex_lock(recall_mutex);
+
+  wave_stream = g_list_copy_deep(fx_playback_audio->wave_stream,
+				 (GCopyFunc) g_object_ref,
+				 NULL);
+
+  g_rec_mutex_unlock(recall_mutex);
+
+  return(wave_stream);
+}
+
+/**
+ * ags_fx_playback_audio_add_wave_stream:
+ * @fx_playback_audio: the #AgsFxPlaybackAudio
+ * @wave_stream: the #AgsWaveStream
+ * 
+ * Add @wave_stream to @fx_playback_audio. The audio channel of
+ * @wave_stream is played from disk instead of the resident #AgsBuffer,
+ * until an #AgsWave of the audio channel has %AGS_WAVE_MODIFIED set.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_fx_playback_audio_add_wave_stream(AgsFxPlaybackAudio *fx_playback_audio,
+				      AgsWaveStream *wave_stream)
+{
+  GRecMutex *recall_mutex;
+
+  if(!AGS_IS_FX_PLAYBACK_AUDIO(fx_playback_audio) ||
+     !AGS_IS_WAVE_STREAM(wave_stream)){
+    return;
+  }
+
+  /* get recall mutex */
+  recall_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_playback_audio);
+
+  /* add */
+  g_rec_mutex_lock(recall_mutex);
+
+  if(g_list_find(fx_playback_audio->wave_stream, wave_stream) == NULL){
+    g_object_ref(wave_stream);
+
+    fx_playback_audio->wave_stream = g_list_prepend(fx_playback_audio->wave_stream,
+						    wave_stream);
+  }
+  
+  g_rec_mutex_unlock(recall_mutex);
+}
+
+/**
+ * ags_fx_playback_audio_remove_wave_stream:
+ * @fx_playback_audio: the #AgsFxPlaybackAudio
+ * @wave_stream: the #AgsWaveStream
+ * 
+ * Remove @wave_stream from @fx_playback_audio.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_fx_playback_audio_remove_wave_stream(AgsFxPlaybackAudio *fx_playback_audio,
+					 AgsWaveStream *wave_stream)
+{
+  GRecMutex *recall_mutex;
+
+  if(!AGS_IS_FX_PLAYBACK_AUDIO(fx_playback_audio)){
+    return;
+  }
+
+  /* get recall mutex */
+  recall_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_playback_audio);
+
+  /* remove */
+  g_rec_mutex_lock(recall_mutex);
+
+  if(g_list_find(fx_playback_audio->wave_stream, wave_stream) != NULL){
+    fx_playback_audio->wave_stream = g_list_remove(fx_playback_audio->wave_stream,
+						   wave_stream);
+    g_object_unref(wave_stream);
+  }
+  
+  g_rec_mutex_unlock(recall_mutex);
+}
+
+/**
+ * ags_fx_playback_audio_find_wave_stream:
+ * @fx_playback_audio: the #AgsFxPlaybackAudio
+ * @audio_channel: the audio channel
+ * 
+ * Find the wave stream of @audio_channel.
+ * 
+ * Returns: (transfer full): the matching #AgsWaveStream or %NULL
+ * 
+ * Since: 3.5.0
+ */
+AgsWaveStream*
+ags_fx_playback_audio_find_wave_stream(AgsFxPlaybackAudio *fx_playback_audio,
+				       guint audio_channel)
+{
+  AgsWaveStream *wave_stream;
+
+  GList *list;
+  
+  GRecMutex *recall_mutex;
+
+  if(!AGS_IS_FX_PLAYBACK_AUDIO(fx_playback_audio)){
+    return(NULL);
+  }
+
+  /* get recall mutex */
+  recall_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_playback_audio);
+
+  /* find */
+  wave_stream = NULL;
+  
+  g_rec_mutex_lock(recall_mutex);
+
+  list = fx_playback_audio->wave_stream;
+
+  while(list != NULL){
+    if(AGS_WAVE_STREAM(list->data)->audio_channel == audio_channel){
+      wave_stream = AGS_WAVE_STREAM(list->data);
+      g_object_ref(wave_stream);
+      
+      break;
+    }
+    
+    list = list->next;
+  }
+  
+  g_rec_mutex_unlock(recall_mutex);
+
+  return(wave_stream);
+}
+
+/**
+ * ags_fx_playback_audio_attach_wave_stream:
+ * @audio: the #AgsAudio
+ * @wave_stream: (element-type AgsAudio.WaveStream) (transfer none): the #GList-struct containing #AgsWaveStream
+ * @do_replace: if %TRUE the present wave streams are removed
+ * 
+ * Add @wave_stream to every #AgsFxPlaybackAudio of @audio, both the play and
+ * the recall context share the same streams.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_fx_playback_audio_attach_wave_stream(AgsAudio *audio,
+					 GList *wave_stream,
+					 gboolean do_replace)
+{
+  GList *start_play, *start_recall;
+  GList *start_recall_audio, *recall_audio;
+  GList *start_present, *present;
+  GList *list;
+  
+  if(!AGS_IS_AUDIO(audio)){
+    return;
+  }
+
+  g_object_get(audio,
+	       "play", &start_play,
+	       "recall", &start_recall,
+	       NULL);
+
+  start_recall_audio = g_list_concat(start_play,
+				     start_recall);
+
+  recall_audio = start_recall_audio;
+  
+  while((recall_audio = ags_recall_find_type(recall_audio,
+					     AGS_TYPE_FX_PLAYBACK_AUDIO)) != NULL){
+    if(do_replace){
+      present =
+	start_present = ags_fx_playback_audio_get_wave_stream(recall_audio->data);
+
+      while(present != NULL){
+	ags_fx_playback_audio_remove_wave_stream(recall_audio->data,
+						 present->data);
+
+	present = present->next;
+      }
+
+      g_list_free_full(start_present,
+		       g_object_unref);
+    }
+
+    list = wave_stream;
+
+    while(list != NULL){
+      ags_fx_playback_audio_add_wave_stream(recall_audio->data,
+					    list->data);
+
+      list = list->next;
+    }
+    
+    recall_audio = recall_audio->next;
+  }
+
+  g_list_free_full(start_recall_audio,
+		   g_object_unref);
+}
+
 /**
  * ags_fx_playback_audio_open_audio_file:
  * @fx_playback_audio: the #AgsFxPlaybackAudio
@@ -29,6 +29,7 @@
 #include <ags/audio/ags_recall_audio.h>
 
 #include <ags/audio/file/ags_audio_file.h>
+#include <ags/audio/file/ags_wave_stream.h>
 
 G_BEGIN_DECLS
 
@@ -86,6 +87,8 @@ struct _AgsFxPlaybackAudio
   GList *feed_audio_signal;  
 
   GList *master_audio_signal;  
+
+  GList *wave_stream;
   
   AgsAudioFile *audio_file;
   
@@ -137,6 +140,21 @@ void ags_fx_playback_audio_add_master_audio_signal(AgsFxPlaybackAudio *fx_playba
 void ags_fx_playback_audio_remove_master_audio_signal(AgsFxPlaybackAudio *fx_playback_audio,
 						      AgsAudioSignal *audio_signal);
 
+/* wave stream */
+GList* ags_fx_playback_audio_get_wave_stream(AgsFxPlaybackAudio *fx_playback_audio);
+
+void ags_fx_playback_audio_add_wave_stream(AgsFxPlaybackAudio *fx_playback_audio,
+					   AgsWaveStream *wave_stream);
+void ags_fx_playback_audio_remove_wave_stream(AgsFxPlaybackAudio *fx_playback_audio,
+					      AgsWaveStream *wave_stream);
+
+AgsWaveStream* ags_fx_playback_audio_find_wave_stream(AgsFxPlaybackAudio *fx_playback_audio,
+						      guint audio_channel);
+
+void ags_fx_playback_audio_attach_wave_stream(AgsAudio *audio,
+					      GList *wave_stream,
+					      gboolean do_replace);
+
 /* open audio file */
 void ags_fx_playback_audio_open_audio_file(AgsFxPlaybackAudio *fx_playback_audio);
 
@@ -48,6 +48,9 @@ void ags_fx_playback_audio_processor_change_tact(AgsTactable *tactable, gdouble
 void ags_fx_playback_audio_processor_run_init_pre(AgsRecall *recall);
 void ags_fx_playback_audio_processor_run_inter(AgsRecall *recall);
 
+AgsAudioSignal* ags_fx_playback_audio_processor_get_audio_signal(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
+								 guint data_mode);
+
 void ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
 						   AgsBuffer *buffer,
 						   guint data_mode);
@@ -62,6 +65,16 @@ void ags_fx_playback_audio_processor_real_master(AgsFxPlaybackAudioProcessor *fx
 
 void ags_fx_playback_audio_processor_real_counter_change(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor);
 
+AgsWaveStream* ags_fx_playback_audio_processor_find_wave_stream(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor);
+guint64 ags_fx_playback_audio_processor_wave_stream_offset(AgsWaveStream *wave_stream,
+							   guint64 x_offset,
+							   guint samplerate);
+void ags_fx_playback_audio_processor_play_wave_stream(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
+						      AgsWaveStream *wave_stream);
+gboolean ags_fx_playback_audio_processor_play_wave_cursor(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
+						      AgsAudio *audio,
+						      guint audio_channel);
+
 /**
  * SECTION:ags_fx_playback_audio_processor
  * @short_description: fx playback audio processor
@@ -247,6 +260,23 @@ ags_fx_playback_audio_processor_init(AgsFxPlaybackAudioProcessor *fx_playback_au
 
   /* capture */
   fx_playback_audio_processor->capture_audio_signal = NULL;
+
+  /* wave cursor */
+  fx_playback_audio_processor->wave_cursor = NULL;
+
+  fx_playback_audio_processor->wave_cursor_buffer = NULL;
+  fx_playback_audio_processor->wave_cursor_buffer_size = 0;
+  fx_playback_audio_processor->wave_cursor_format = 0;
+
+  /* wave stream */
+  fx_playback_audio_processor->wave_stream_data = NULL;
+  fx_playback_audio_processor->wave_stream_data_size = 0;
+
+  fx_playback_audio_processor->wave_stream_buffer = NULL;
+  fx_playback_audio_processor->wave_stream_buffer_size = 0;
+
+  fx_playback_audio_processor->wave_stream_position = 0.0;
+  fx_playback_audio_processor->wave_stream_x_offset = G_MAXUINT64;
 }
 
 void
@@ -311,6 +341,22 @@ ags_fx_playback_audio_processor_finalize(GObject *gobject)
     g_list_free_full(fx_playback_audio_processor->capture_audio_signal,
 		     (GDestroyNotify) g_object_unref);
   }
+
+  /* wave cursor */
+  ags_wave_cursor_free(fx_playback_audio_processor->wave_cursor);
+
+  if(fx_playback_audio_processor->wave_cursor_buffer != NULL){
+    ags_stream_free(fx_playback_audio_processor->wave_cursor_buffer);
+  }
+
+  /* wave stream */
+  if(fx_playback_audio_processor->wave_stream_data != NULL){
+    ags_stream_free(fx_playback_audio_processor->wave_stream_data);
+  }
+
+  if(fx_playback_audio_processor->wave_stream_buffer != NULL){
+    ags_stream_free(fx_playback_audio_processor->wave_stream_buffer);
+  }
   
   /* call parent */
   G_OBJECT_CLASS(ags_fx_playback_audio_processor_parent_class)->finalize(gobject);
@@ -327,10 +373,14 @@ ags_fx_playback_audio_processor_seek(AgsSeekable *seekable,
 
   gdouble playback_duration;
   
+  AgsWaveStream *wave_stream;
+
   GRecMutex *recall_mutex;
 
   gdouble delay;
   guint64 playback_counter;
+  guint64 x_offset;
+  guint samplerate;
   guint buffer_size;
 
   GValue value = {0,};
@@ -342,10 +392,12 @@ ags_fx_playback_audio_processor_seek(AgsSeekable *seekable,
   /* get recall mutex */
   recall_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_playback_audio_processor);
 
+  samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
 
   g_object_get(fx_playback_audio_processor,
 	       "recall-audio", &fx_playback_audio,
+	       "samplerate", &samplerate,
 	       "buffer-size", &buffer_size,
 	       NULL);
 
@@ -459,6 +511,24 @@ ags_fx_playback_audio_processor_seek(AgsSeekable *seekable,
   break;
   }
 
+  /* disk streaming - prefetch at the new position */
+  wave_stream = ags_fx_playback_audio_processor_find_wave_stream(fx_playback_audio_processor);
+  
+  g_rec_mutex_lock(recall_mutex);
+
+  x_offset = fx_playback_audio_processor->x_offset;
+  
+  g_rec_mutex_unlock(recall_mutex);
+
+  if(wave_stream != NULL){
+    ags_wave_stream_locate(wave_stream,
+			   ags_fx_playback_audio_processor_wave_stream_offset(wave_stream,
+									      x_offset,
+									      samplerate));
+
+    g_object_unref(wave_stream);
+  }
+  
   if(fx_playback_audio != NULL){
     g_object_unref(fx_playback_audio);
   }
@@ -943,10 +1013,9 @@ ags_fx_playback_audio_processor_run_inter(AgsRecall *recall)
   AGS_RECALL_CLASS(ags_fx_playback_audio_processor_parent_class)->run_inter(recall);
 }
 
-void
-ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
-					      AgsBuffer *buffer,
-					      guint data_mode)
+AgsAudioSignal*
+ags_fx_playback_audio_processor_get_audio_signal(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
+						 guint data_mode)
 {
   AgsAudioSignal *current_audio_signal;
   AgsRecallID *recall_id;
@@ -954,22 +1023,16 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
   
   GList *start_audio_signal, *audio_signal;
 
-  gpointer buffer_data;
-
-  guint buffer_x_offset, x_offset;
-  guint buffer_samplerate, samplerate;
-  guint buffer_buffer_size, buffer_size;
-  guint buffer_format, format;
-  guint copy_mode;
-  guint attack;
-  gboolean do_resample;
+  guint samplerate;
+  guint buffer_size;
+  guint format;
   
   GRecMutex *fx_playback_audio_processor_mutex;
-  GRecMutex *buffer_mutex;
-  GRecMutex *stream_mutex;
 
   fx_playback_audio_processor_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_playback_audio_processor);
 
+  recall_id = NULL;
+  
   samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   format = AGS_SOUNDCARD_DEFAULT_FORMAT;
@@ -981,17 +1044,6 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
 	       "format", &format,
 	       NULL);
 
-  buffer_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  buffer_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  buffer_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
-
-  g_object_get(buffer,
-	       "x", &buffer_x_offset,
-	       "samplerate", &buffer_samplerate,
-	       "buffer-size", &buffer_buffer_size,
-	       "format", &buffer_format,
-	       NULL);
-
   /* get audio signal */
   current_audio_signal = NULL;
   
@@ -999,8 +1051,6 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
   
   g_rec_mutex_lock(fx_playback_audio_processor_mutex);
 
-  x_offset = fx_playback_audio_processor->x_offset;
-  
   if(data_mode == AGS_FX_PLAYBACK_AUDIO_PROCESSOR_DATA_MODE_PLAY){
     start_audio_signal = fx_playback_audio_processor->playing_audio_signal;
   }else if(data_mode == AGS_FX_PLAYBACK_AUDIO_PROCESSOR_DATA_MODE_RECORD){
@@ -1033,8 +1083,6 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
     output_soundcard = NULL;
 
     audio = NULL;
-  
-    recall_id = NULL;
 
     fx_playback_audio = NULL;
 
@@ -1043,7 +1091,6 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
     g_object_get(fx_playback_audio_processor,
 		 "output-soundcard", &output_soundcard,
 		 "audio", &audio,
-		 "recall-id", &recall_id,
 		 "recall-audio", &fx_playback_audio,
 		 "audio-channel", &audio_channel,
 		 NULL);
@@ -1123,6 +1170,10 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
       g_object_unref(output_soundcard);
     }
 
+    if(audio != NULL){
+      g_object_unref(audio);
+    }
+
     if(start_input != NULL){
       g_object_unref(start_input);
     }
@@ -1139,6 +1190,67 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
       g_object_unref(fx_playback_audio);
     }
   }
+  
+  if(recall_id != NULL){
+    g_object_unref(recall_id);
+  }
+
+  return(current_audio_signal);
+}
+
+void
+ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
+					      AgsBuffer *buffer,
+					      guint data_mode)
+{
+  AgsAudioSignal *current_audio_signal;
+
+  gpointer buffer_data;
+
+  guint buffer_x_offset, x_offset;
+  guint buffer_samplerate, samplerate;
+  guint buffer_buffer_size, buffer_size;
+  guint buffer_format, format;
+  guint copy_mode;
+  guint attack;
+  gboolean do_resample;
+  
+  GRecMutex *fx_playback_audio_processor_mutex;
+  GRecMutex *buffer_mutex;
+  GRecMutex *stream_mutex;
+
+  fx_playback_audio_processor_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_playback_audio_processor);
+
+  samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+  buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
+  format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
+  g_object_get(fx_playback_audio_processor,
+	       "samplerate", &samplerate,
+	       "buffer-size", &buffer_size,
+	       "format", &format,
+	       NULL);
+
+  buffer_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+  buffer_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
+  buffer_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+
+  g_object_get(buffer,
+	       "x", &buffer_x_offset,
+	       "samplerate", &buffer_samplerate,
+	       "buffer-size", &buffer_buffer_size,
+	       "format", &buffer_format,
+	       NULL);
+
+  g_rec_mutex_lock(fx_playback_audio_processor_mutex);
+
+  x_offset = fx_playback_audio_processor->x_offset;
+
+  g_rec_mutex_unlock(fx_playback_audio_processor_mutex);
+
+  /* get audio signal */
+  current_audio_signal = ags_fx_playback_audio_processor_get_audio_signal(fx_playback_audio_processor,
+									  data_mode);
 
   buffer_mutex = AGS_BUFFER_GET_OBJ_MUTEX(buffer);
   stream_mutex = AGS_AUDIO_SIGNAL_GET_STREAM_MUTEX(current_audio_signal);
@@ -1210,10 +1322,6 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
   if(current_audio_signal != NULL){
     g_object_unref(current_audio_signal);
   }
-  
-  if(recall_id != NULL){
-    g_object_unref(recall_id);
-  }  
 }
 
 void
@@ -1260,10 +1368,363 @@ ags_fx_playback_audio_processor_data_get(AgsFxPlaybackAudioProcessor *fx_playbac
   g_object_unref(fx_playback_audio_processor);
 }
 
+AgsWaveStream*
+ags_fx_playback_audio_processor_find_wave_stream(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor)
+{
+  AgsFxPlaybackAudio *fx_playback_audio;
+  AgsWaveStream *wave_stream;
+
+  guint audio_channel;
+
+  fx_playback_audio = NULL;
+
+  audio_channel = 0;
+  
+  g_object_get(fx_playback_audio_processor,
+	       "recall-audio", &fx_playback_audio,
+	       "audio-channel", &audio_channel,
+	       NULL);
+
+  wave_stream = ags_fx_playback_audio_find_wave_stream(fx_playback_audio,
+						       audio_channel);
+
+  /* edited lines play the resident buffers */
+  if(wave_stream != NULL){
+    AgsAudio *audio;
+    
+    GList *start_wave, *wave;
+
+    audio = NULL;
+    
+    start_wave = NULL;
+    
+    g_object_get(fx_playback_audio,
+		 "audio", &audio,
+		 NULL);
+
+    if(audio != NULL){
+      g_object_get(audio,
+		   "wave", &start_wave,
+		   NULL);
+    }
+    
+    wave = start_wave;
+
+    while(wave != NULL){
+      if(ags_wave_get_line(wave->data) == audio_channel &&
+	 ags_wave_test_flags(wave->data, AGS_WAVE_MODIFIED)){
+	g_object_unref(wave_stream);
+
+	wave_stream = NULL;
+	
+	break;
+      }
+
+      wave = wave->next;
+    }
+
+    g_list_free_full(start_wave,
+		     g_object_unref);
+
+    if(audio != NULL){
+      g_object_unref(audio);
+    }
+  }
+  
+  if(fx_playback_audio != NULL){
+    g_object_unref(fx_playback_audio);
+  }
+
+  return(wave_stream);
+}
+
+guint64
+ags_fx_playback_audio_processor_wave_stream_offset(AgsWaveStream *wave_stream,
+						   guint64 x_offset,
+						   guint samplerate)
+{
+  guint stream_samplerate;
+
+  stream_samplerate = samplerate;
+  
+  g_object_get(wave_stream,
+	       "samplerate", &stream_samplerate,
+	       NULL);
+
+  if(stream_samplerate == samplerate ||
+     samplerate == 0){
+    return(x_offset);
+  }
+
+  return((guint64) ((gdouble) x_offset * ((gdouble) stream_samplerate / (gdouble) samplerate)));
+}
+
+void
+ags_fx_playback_audio_processor_play_wave_stream(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
+						 AgsWaveStream *wave_stream)
+{
+  AgsAudioSignal *current_audio_signal;
+
+  guint64 x_offset;
+  guint samplerate, stream_samplerate;
+  guint buffer_size;
+  guint format;
+  
+  GRecMutex *fx_playback_audio_processor_mutex;
+  GRecMutex *stream_mutex;
+
+  fx_playback_audio_processor_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_playback_audio_processor);
+
+  samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+  buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
+  format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
+  g_object_get(fx_playback_audio_processor,
+	       "samplerate", &samplerate,
+	       "buffer-size", &buffer_size,
+	       "format", &format,
+	       NULL);
+
+  stream_samplerate = samplerate;
+  
+  g_object_get(wave_stream,
+	       "samplerate", &stream_samplerate,
+	       NULL);
+  
+  g_rec_mutex_lock(fx_playback_audio_processor_mutex);
+
+  x_offset = fx_playback_audio_processor->x_offset;
+  
+  g_rec_mutex_unlock(fx_playback_audio_processor_mutex);
+
+  current_audio_signal = ags_fx_playback_audio_processor_get_audio_signal(fx_playback_audio_processor,
+									  AGS_FX_PLAYBACK_AUDIO_PROCESSOR_DATA_MODE_PLAY);
+
+  if(current_audio_signal == NULL){
+    return;
+  }
+  
+  stream_mutex = AGS_AUDIO_SIGNAL_GET_STREAM_MUTEX(current_audio_signal);
+
+  if(stream_samplerate == samplerate){
+    /* read the decoded blocks, never waits for disk */
+    g_rec_mutex_lock(stream_mutex);
+
+    ags_wave_stream_read(wave_stream,
+			 x_offset,
+			 current_audio_signal->stream_current->data, 1,
+			 buffer_size, format);
+    
+    g_rec_mutex_unlock(stream_mutex);
+  }else{
+    gdouble *stream_data, *buffer_data;
+
+    gdouble ratio;
+    gdouble position, phase;
+    guint64 stream_offset;
+    guint stream_buffer_size;
+    guint copy_mode;
+    guint i;
+
+    ratio = (gdouble) stream_samplerate / (gdouble) samplerate;
+    
+    /* two more frames to interpolate across the end of the period */
+    stream_buffer_size = (guint) ceil((gdouble) buffer_size * ratio) + 2;
+
+    if(fx_playback_audio_processor->wave_stream_data == NULL ||
+       fx_playback_audio_processor->wave_stream_data_size < stream_buffer_size){
+      if(fx_playback_audio_processor->wave_stream_data != NULL){
+	ags_stream_free(fx_playback_audio_processor->wave_stream_data);
+      }
+
+      fx_playback_audio_processor->wave_stream_data = ags_stream_alloc(stream_buffer_size,
+								       AGS_SOUNDCARD_DOUBLE);
+      fx_playback_audio_processor->wave_stream_data_size = stream_buffer_size;
+    }
+
+    if(fx_playback_audio_processor->wave_stream_buffer == NULL ||
+       fx_playback_audio_processor->wave_stream_buffer_size != buffer_size){
+      if(fx_playback_audio_processor->wave_stream_buffer != NULL){
+	ags_stream_free(fx_playback_audio_processor->wave_stream_buffer);
+      }
+
+      fx_playback_audio_processor->wave_stream_buffer = ags_stream_alloc(buffer_size,
+									 AGS_SOUNDCARD_DOUBLE);
+      fx_playback_audio_processor->wave_stream_buffer_size = buffer_size;
+    }
+
+    stream_data = fx_playback_audio_processor->wave_stream_data;
+    buffer_data = fx_playback_audio_processor->wave_stream_buffer;
+
+    /* the fractional read position is kept between periods, unless located */
+    if(fx_playback_audio_processor->wave_stream_x_offset != x_offset){
+      fx_playback_audio_processor->wave_stream_position = (gdouble) ags_fx_playback_audio_processor_wave_stream_offset(wave_stream,
+														       x_offset,
+														       samplerate);
+    }
+
+    position = fx_playback_audio_processor->wave_stream_position;
+
+    stream_offset = (guint64) floor(position);
+    phase = position - (gdouble) stream_offset;
+
+    ags_audio_buffer_util_clear_double(stream_data, 1,
+				       stream_buffer_size);
+    
+    ags_wave_stream_read(wave_stream,
+			 stream_offset,
+			 stream_data, 1,
+			 stream_buffer_size, AGS_SOUNDCARD_DOUBLE);
+
+    /* linear interpolation */
+    for(i = 0; i < buffer_size; i++){
+      gdouble t;
+      guint j;
+
+      t = phase + ((gdouble) i * ratio);
+      j = (guint) t;
+      
+      buffer_data[i] = stream_data[j] + ((t - (gdouble) j) * (stream_data[j + 1] - stream_data[j]));
+    }
+
+    fx_playback_audio_processor->wave_stream_position = position + ((gdouble) buffer_size * ratio);
+    fx_playback_audio_processor->wave_stream_x_offset = x_offset + buffer_size;
+    
+    copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(format),
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+    g_rec_mutex_lock(stream_mutex);
+
+    ags_audio_buffer_util_copy_buffer_to_buffer(current_audio_signal->stream_current->data, 1, 0,
+						buffer_data, 1, 0,
+						buffer_size, copy_mode);
+    
+    g_rec_mutex_unlock(stream_mutex);
+  }
+  
+  g_object_unref(current_audio_signal);
+}
+
+gboolean
+ags_fx_playback_audio_processor_play_wave_cursor(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
+						 AgsAudio *audio,
+						 guint audio_channel)
+{
+  AgsAudioSignal *current_audio_signal;
+  AgsWaveCursor *wave_cursor;
+
+  gpointer wave_cursor_buffer;
+  
+  guint64 x_offset;
+  guint samplerate;
+  guint buffer_size;
+  guint format;
+  guint copy_mode;
+  guint n_read;
+  
+  GRecMutex *fx_playback_audio_processor_mutex;
+  GRecMutex *stream_mutex;
+
+  fx_playback_audio_processor_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_playback_audio_processor);
+
+  samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+  buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
+  format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
+  g_object_get(fx_playback_audio_processor,
+	       "samplerate", &samplerate,
+	       "buffer-size", &buffer_size,
+	       "format", &format,
+	       NULL);
+
+  /* cursor and scratch buffer are used by the audio thread only */
+  g_rec_mutex_lock(fx_playback_audio_processor_mutex);
+
+  x_offset = fx_playback_audio_processor->x_offset;
+
+  if(fx_playback_audio_processor->wave_cursor == NULL){
+    fx_playback_audio_processor->wave_cursor = ags_wave_cursor_alloc((GObject *) audio,
+								     audio_channel);
+  }
+
+  wave_cursor = fx_playback_audio_processor->wave_cursor;
+
+  /* the cursor copies the frames as they are, the wave has to match the samplerate */
+  if(wave_cursor->wave == NULL ||
+     wave_cursor->x != x_offset ||
+     x_offset < wave_cursor->wave_x0 ||
+     x_offset >= wave_cursor->wave_x1){
+    ags_wave_cursor_seek(wave_cursor,
+			 x_offset, samplerate);
+  }
+
+  if(wave_cursor->wave != NULL &&
+     ags_wave_get_samplerate(wave_cursor->wave) != samplerate){
+    g_rec_mutex_unlock(fx_playback_audio_processor_mutex);
+
+    return(FALSE);
+  }
+  
+  if(fx_playback_audio_processor->wave_cursor_buffer == NULL ||
+     fx_playback_audio_processor->wave_cursor_buffer_size != buffer_size ||
+     fx_playback_audio_processor->wave_cursor_format != format){
+    if(fx_playback_audio_processor->wave_cursor_buffer != NULL){
+      ags_stream_free(fx_playback_audio_processor->wave_cursor_buffer);
+    }
+
+    fx_playback_audio_processor->wave_cursor_buffer = ags_stream_alloc(buffer_size,
+								       format);
+    fx_playback_audio_processor->wave_cursor_buffer_size = buffer_size;
+    fx_playback_audio_processor->wave_cursor_format = format;
+  }else{
+    ags_audio_buffer_util_clear_buffer(fx_playback_audio_processor->wave_cursor_buffer, 1,
+				       buffer_size, ags_audio_buffer_util_format_from_soundcard(format));
+  }
+
+  wave_cursor_buffer = fx_playback_audio_processor->wave_cursor_buffer;
+  
+  g_rec_mutex_unlock(fx_playback_audio_processor_mutex);
+
+  /* advances in constant time, seeks on locate and loop */
+  n_read = ags_wave_cursor_read(wave_cursor,
+				x_offset, samplerate,
+				wave_cursor_buffer, 1,
+				buffer_size, format);
+
+  if(n_read == 0){
+    return(TRUE);
+  }
+  
+  current_audio_signal = ags_fx_playback_audio_processor_get_audio_signal(fx_playback_audio_processor,
+									  AGS_FX_PLAYBACK_AUDIO_PROCESSOR_DATA_MODE_PLAY);
+
+  if(current_audio_signal == NULL){
+    return(TRUE);
+  }
+
+  stream_mutex = AGS_AUDIO_SIGNAL_GET_STREAM_MUTEX(current_audio_signal);
+
+  copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(format),
+						  ags_audio_buffer_util_format_from_soundcard(format));
+  
+  g_rec_mutex_lock(stream_mutex);
+
+  ags_audio_buffer_util_copy_buffer_to_buffer(current_audio_signal->stream_current->data, 1, 0,
+					      wave_cursor_buffer, 1, 0,
+					      buffer_size, copy_mode);
+  
+  g_rec_mutex_unlock(stream_mutex);
+
+  g_object_unref(current_audio_signal);
+
+  return(TRUE);
+}
+
 void
 ags_fx_playback_audio_processor_real_play(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor)
 {
   AgsAudio *audio;
+  AgsWaveStream *wave_stream;
 
   AgsTimestamp *timestamp;
   
@@ -1295,9 +1756,36 @@ ags_fx_playback_audio_processor_real_play(AgsFxPlaybackAudioProcessor *fx_playba
   timestamp = fx_playback_audio_processor->timestamp;
   
   x_offset = fx_playback_audio_processor->x_offset;
-  
+
   g_rec_mutex_unlock(fx_playback_audio_processor_mutex);
 
+  /* disk streaming replaces the resident buffers of unedited lines */
+  wave_stream = ags_fx_playback_audio_processor_find_wave_stream(fx_playback_audio_processor);
+
+  if(wave_stream != NULL){
+    ags_fx_playback_audio_processor_play_wave_stream(fx_playback_audio_processor,
+						     wave_stream);
+
+    g_object_unref(wave_stream);
+    
+    if(audio != NULL){
+      g_object_unref(audio);
+    }
+
+    return;
+  }
+
+  /* wave cursor - the wave matches the samplerate and needs no resampling */
+  if(ags_fx_playback_audio_processor_play_wave_cursor(fx_playback_audio_processor,
+						      audio,
+						      audio_channel)){
+    if(audio != NULL){
+      g_object_unref(audio);
+    }
+    
+    return;
+  }
+
   /* time stamp offset */
   relative_offset = AGS_WAVE_DEFAULT_BUFFER_LENGTH * samplerate;
 
@@ -1776,6 +2264,12 @@ ags_fx_playback_audio_processor_real_record(AgsFxPlaybackAudioProcessor *fx_play
 
       ags_soundcard_unlock_buffer(AGS_SOUNDCARD(input_soundcard), data);
       g_rec_mutex_unlock(buffer_mutex);
+
+      ags_buffer_invalidate_peak(buffer,
+				 attack, frame_count);
+
+      ags_wave_set_flags(current_wave,
+			 AGS_WAVE_MODIFIED);
   
       /* data put */
       ags_fx_playback_audio_processor_data_put(fx_playback_audio_processor,
@@ -1854,6 +2348,12 @@ ags_fx_playback_audio_processor_real_record(AgsFxPlaybackAudioProcessor *fx_play
 
 	ags_soundcard_unlock_buffer(AGS_SOUNDCARD(input_soundcard), data);
 	g_rec_mutex_unlock(buffer_mutex);
+
+	ags_buffer_invalidate_peak(buffer,
+				   0, attack);
+
+	ags_wave_set_flags(current_wave,
+			   AGS_WAVE_MODIFIED);
   
 	/* data put */
 	ags_fx_playback_audio_processor_data_put(fx_playback_audio_processor,
@@ -2134,6 +2634,7 @@ void
 ags_fx_playback_audio_processor_real_counter_change(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor)
 {
   AgsFxPlaybackAudio *fx_playback_audio;
+  AgsWaveStream *wave_stream;
 
   GObject *output_soundcard;
 
@@ -2142,7 +2643,10 @@ ags_fx_playback_audio_processor_real_counter_change(AgsFxPlaybackAudioProcessor
   guint offset_counter;
   gboolean loop;
   guint64 loop_start, loop_end;
+  guint64 x_offset;
+  guint samplerate;
   guint buffer_size;
+  gboolean do_locate;
   
   GValue value = {0,};
 
@@ -2154,14 +2658,18 @@ ags_fx_playback_audio_processor_real_counter_change(AgsFxPlaybackAudioProcessor
 
   fx_playback_audio = NULL;
 
+  samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   
   g_object_get(fx_playback_audio_processor,
 	       "output-soundcard", &output_soundcard,
 	       "recall-audio", &fx_playback_audio,
+	       "samplerate", &samplerate,
 	       "buffer-size", &buffer_size,
 	       NULL);
 
+  do_locate = FALSE;
+
   delay = AGS_SOUNDCARD_DEFAULT_DELAY;
 
   loop = FALSE;
@@ -2269,6 +2777,8 @@ ags_fx_playback_audio_processor_real_counter_change(AgsFxPlaybackAudioProcessor
       fx_playback_audio_processor->current_offset_counter = loop_start;
 
       fx_playback_audio_processor->current_x_offset = (guint64) floor(loop_start * delay) * buffer_size;
+
+      do_locate = TRUE;
     }else{
       fx_playback_audio_processor->current_offset_counter += 1;
 
@@ -2285,6 +2795,35 @@ ags_fx_playback_audio_processor_real_counter_change(AgsFxPlaybackAudioProcessor
 
     g_rec_mutex_unlock(fx_playback_audio_processor_mutex);
   }
+
+  /* disk streaming - keep the loop start prefetched */
+  wave_stream = ags_fx_playback_audio_processor_find_wave_stream(fx_playback_audio_processor);
+
+  g_rec_mutex_lock(fx_playback_audio_processor_mutex);
+
+  x_offset = fx_playback_audio_processor->current_x_offset;
+  
+  g_rec_mutex_unlock(fx_playback_audio_processor_mutex);
+
+  if(wave_stream != NULL){
+    ags_wave_stream_set_loop(wave_stream,
+			     loop,
+			     ags_fx_playback_audio_processor_wave_stream_offset(wave_stream,
+										(guint64) floor(loop_start * delay) * buffer_size,
+										samplerate),
+			     ags_fx_playback_audio_processor_wave_stream_offset(wave_stream,
+										(guint64) floor(loop_end * delay) * buffer_size,
+										samplerate));
+
+    if(do_locate){
+      ags_wave_stream_locate(wave_stream,
+			     ags_fx_playback_audio_processor_wave_stream_offset(wave_stream,
+										x_offset,
+										samplerate));
+    }
+    
+    g_object_unref(wave_stream);
+  }
   
   if(output_soundcard != NULL){
     g_object_unref(output_soundcard);
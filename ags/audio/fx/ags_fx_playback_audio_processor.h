@@ -27,8 +27,11 @@
 
 #include <ags/audio/ags_audio.h>
 #include <ags/audio/ags_buffer.h>
+#include <ags/audio/ags_wave.h>
 #include <ags/audio/ags_recall_audio_run.h>
 
+#include <ags/audio/file/ags_wave_stream.h>
+
 G_BEGIN_DECLS
 
 #define AGS_TYPE_FX_PLAYBACK_AUDIO_PROCESSOR                (ags_fx_playback_audio_processor_get_type())
@@ -85,6 +88,21 @@ struct _AgsFxPlaybackAudioProcessor
   GList *mastering_audio_signal;
 
   GList *capture_audio_signal;
+
+  AgsWaveCursor *wave_cursor;
+  
+  gpointer wave_cursor_buffer;
+  guint wave_cursor_buffer_size;
+  guint wave_cursor_format;
+
+  gpointer wave_stream_data;
+  guint wave_stream_data_size;
+
+  gpointer wave_stream_buffer;
+  guint wave_stream_buffer_size;
+
+  gdouble wave_stream_position;
+  guint64 wave_stream_x_offset;
 };
 
 struct _AgsFxPlaybackAudioProcessorClass
@@ -22,6 +22,8 @@
 #include <ags/audio/ags_port.h>
 #include <ags/audio/ags_audio_buffer_util.h>
 
+#include <ags/audio/osc/ags_osc_scheduler.h>
+
 #include <ags/audio/fx/ags_fx_volume_audio.h>
 #include <ags/audio/fx/ags_fx_volume_channel.h>
 #include <ags/audio/fx/ags_fx_volume_channel_processor.h>
@@ -143,7 +145,9 @@ ags_fx_volume_audio_signal_real_run_inter(AgsRecall *recall)
   
   guint buffer_size;
   guint format;
-  gdouble volume;
+  guint word_size;
+  guint offset;
+  gdouble volume, previous_volume;
   gboolean muted;
 
   GRecMutex *stream_mutex;
@@ -158,7 +162,12 @@ ags_fx_volume_audio_signal_real_run_inter(AgsRecall *recall)
   buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   format = AGS_SOUNDCARD_DEFAULT_FORMAT;
   
+  word_size = 0;
+
+  offset = 0;
+  
   volume = 1.0;
+  previous_volume = 1.0;
   
   muted = FALSE;
 
@@ -179,6 +188,7 @@ ags_fx_volume_audio_signal_real_run_inter(AgsRecall *recall)
   g_object_get(source,
 	       "buffer-size", &buffer_size,
 	       "format", &format,
+	       "word-size", &word_size,
 	       NULL);
   
   if(fx_volume_audio != NULL){
@@ -246,7 +256,14 @@ ags_fx_volume_audio_signal_real_run_inter(AgsRecall *recall)
 			   &value);
 
 	volume = g_value_get_float(&value);
-      
+
+	/* scheduled OSC write within this period */
+	offset = ags_osc_scheduler_get_offset(ags_osc_scheduler_get_instance(),
+					      port,
+					      &value);
+
+	previous_volume = g_value_get_float(&value);
+	
 	g_object_unref(port);
       }
 
@@ -261,10 +278,22 @@ ags_fx_volume_audio_signal_real_run_inter(AgsRecall *recall)
     g_rec_mutex_lock(stream_mutex);
 
     if(!muted){
-      ags_audio_buffer_util_volume(source->stream_current->data, 1,
-				   ags_audio_buffer_util_format_from_soundcard(format),
-				   buffer_size,
-				   volume);
+      if(offset > 0 &&
+	 offset < buffer_size){
+	ags_audio_buffer_util_volume(source->stream_current->data, 1,
+				     ags_audio_buffer_util_format_from_soundcard(format),
+				     offset,
+				     previous_volume);
+	ags_audio_buffer_util_volume(((guchar *) source->stream_current->data) + offset * word_size, 1,
+				     ags_audio_buffer_util_format_from_soundcard(format),
+				     buffer_size - offset,
+				     volume);
+      }else{
+	ags_audio_buffer_util_volume(source->stream_current->data, 1,
+				     ags_audio_buffer_util_format_from_soundcard(format),
+				     buffer_size,
+				     volume);
+      }
     }else{
       ags_audio_buffer_util_clear_buffer(source->stream_current->data, 1,
 					 buffer_size, ags_audio_buffer_util_format_from_soundcard(format));
@@ -0,0 +1,728 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/osc/ags_osc_address_trie.h>
+
+#include <string.h>
+
+void ags_osc_address_trie_class_init(AgsOscAddressTrieClass *osc_address_trie);
+void ags_osc_address_trie_init(AgsOscAddressTrie *osc_address_trie);
+void ags_osc_address_trie_finalize(GObject *gobject);
+
+guint ags_osc_address_trie_next_segment(gchar *path, guint path_length,
+					guint offset);
+void ags_osc_address_trie_check_generation(AgsOscAddressTrie *osc_address_trie);
+
+/**
+ * SECTION:ags_osc_address_trie
+ * @short_description: OSC address space trie
+ * @title: AgsOscAddressTrie
+ * @section_id:
+ * @include: ags/audio/osc/ags_osc_address_trie.h
+ *
+ * #AgsOscAddressTrie caches OSC addresses the controllers resolved to an
+ * #AgsPort or a soundcard. The trie is keyed by path segment, so a repeated
+ * message costs a lookup per segment instead of the regex matching and list
+ * walks of the controllers.
+ *
+ * Only concrete addresses are cached, meaning every index is a number or a
+ * quoted name. Any change to the session topology, like adding or removing
+ * audio, channels, recalls or ports, calls ags_osc_address_trie_invalidate()
+ * and the trie is cleared before its next use.
+ *
+ * The cached objects are held by weak references, so the trie never keeps
+ * a removed recall or port alive. A controller resolves an address between
+ * ags_osc_address_trie_begin_resolve() and ags_osc_address_trie_end_resolve(),
+ * an insert is dropped if the topology changed in the meantime.
+ */
+
+static gpointer ags_osc_address_trie_parent_class = NULL;
+
+AgsOscAddressTrie *ags_osc_address_trie = NULL;
+
+static volatile guint ags_osc_address_trie_generation = 1;
+
+static GPrivate ags_osc_address_trie_resolve_key = G_PRIVATE_INIT((GDestroyNotify) g_free);
+
+GType
+ags_osc_address_trie_get_type (void)
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_osc_address_trie = 0;
+
+    static const GTypeInfo ags_osc_address_trie_info = {
+      sizeof (AgsOscAddressTrieClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_osc_address_trie_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof (AgsOscAddressTrie),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_osc_address_trie_init,
+    };
+
+    ags_type_osc_address_trie = g_type_register_static(G_TYPE_OBJECT,
+						       "AgsOscAddressTrie",
+						       &ags_osc_address_trie_info,
+						       0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_osc_address_trie);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_osc_address_trie_class_init(AgsOscAddressTrieClass *osc_address_trie)
+{
+  GObjectClass *gobject;
+
+  ags_osc_address_trie_parent_class = g_type_class_peek_parent(osc_address_trie);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) osc_address_trie;
+
+  gobject->finalize = ags_osc_address_trie_finalize;
+}
+
+void
+ags_osc_address_trie_init(AgsOscAddressTrie *osc_address_trie)
+{
+  osc_address_trie->flags = 0;
+
+  /* osc address trie mutex */
+  g_rec_mutex_init(&(osc_address_trie->obj_mutex));
+
+  osc_address_trie->generation = g_atomic_int_get(&ags_osc_address_trie_generation);
+
+  osc_address_trie->n_entries = 0;
+  osc_address_trie->max_entries = AGS_OSC_ADDRESS_TRIE_DEFAULT_MAX_ENTRIES;
+
+  osc_address_trie->root = ags_osc_address_trie_node_alloc(NULL);
+}
+
+void
+ags_osc_address_trie_finalize(GObject *gobject)
+{
+  AgsOscAddressTrie *osc_address_trie;
+
+  osc_address_trie = AGS_OSC_ADDRESS_TRIE(gobject);
+
+  ags_osc_address_trie_node_free(osc_address_trie->root);
+
+  if(osc_address_trie == ags_osc_address_trie){
+    ags_osc_address_trie = NULL;
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_osc_address_trie_parent_class)->finalize(gobject);
+}
+
+/**
+ * ags_osc_address_trie_node_alloc:
+ * @segment: the path segment
+ *
+ * Allocate #AgsOscAddressTrieNode-struct.
+ *
+ * Returns: the newly allocated #AgsOscAddressTrieNode-struct
+ *
+ * Since: 3.5.0
+ */
+AgsOscAddressTrieNode*
+ags_osc_address_trie_node_alloc(gchar *segment)
+{
+  AgsOscAddressTrieNode *ptr;
+
+  ptr = (AgsOscAddressTrieNode *) g_malloc(sizeof(AgsOscAddressTrieNode));
+
+  ptr->segment = g_strdup(segment);
+
+  ptr->child = NULL;
+
+  ptr->has_target = FALSE;
+  ptr->has_parent = FALSE;
+  
+  g_weak_ref_init(&(ptr->parent),
+		  NULL);
+  g_weak_ref_init(&(ptr->target),
+		  NULL);
+
+  return(ptr);
+}
+
+/**
+ * ags_osc_address_trie_node_free:
+ * @node: the #AgsOscAddressTrieNode-struct
+ *
+ * Free @node and all its children.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_osc_address_trie_node_free(AgsOscAddressTrieNode *node)
+{
+  if(node == NULL){
+    return;
+  }
+
+  if(node->child != NULL){
+    g_hash_table_destroy(node->child);
+  }
+
+  g_weak_ref_clear(&(node->parent));
+  g_weak_ref_clear(&(node->target));
+
+  g_free(node->segment);
+
+  g_free(node);
+}
+
+guint
+ags_osc_address_trie_next_segment(gchar *path, guint path_length,
+				  guint offset)
+{
+  gboolean is_quoted;
+
+  is_quoted = FALSE;
+
+  /* skip leading slash */
+  if(offset < path_length &&
+     path[offset] == '/'){
+    offset++;
+  }
+
+  for(; offset < path_length && path[offset] != '\0'; offset++){
+    if(path[offset] == '"'){
+      is_quoted = !is_quoted;
+    }else if(!is_quoted &&
+	     path[offset] == '/'){
+      break;
+    }
+  }
+
+  return(offset);
+}
+
+/**
+ * ags_osc_address_trie_find_port_end:
+ * @path: the OSC address
+ *
+ * Find the end of the object part of @path, that is the offset of the
+ * last colon not within quotes or brackets.
+ *
+ * Returns: the offset of the colon, or 0 if there is none
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_osc_address_trie_find_port_end(gchar *path)
+{
+  guint port_end;
+  guint depth;
+  guint i;
+  gboolean is_quoted;
+
+  if(path == NULL){
+    return(0);
+  }
+
+  port_end = 0;
+  depth = 0;
+
+  is_quoted = FALSE;
+
+  for(i = 0; path[i] != '\0'; i++){
+    if(path[i] == '"'){
+      is_quoted = !is_quoted;
+    }else if(!is_quoted){
+      if(path[i] == '['){
+	depth++;
+      }else if(path[i] == ']'){
+	if(depth > 0){
+	  depth--;
+	}
+      }else if(path[i] == ':' &&
+	       depth == 0){
+	port_end = i;
+      }
+    }
+  }
+
+  return(port_end);
+}
+
+/**
+ * ags_osc_address_trie_is_concrete:
+ * @path: the OSC address
+ * @path_length: the length of @path to check
+ *
+ * Check if @path addresses exactly one object. That is every bracket
+ * contains a number or a quoted name, but no range or wildcard.
+ *
+ * Returns: %TRUE if concrete, otherwise %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_osc_address_trie_is_concrete(gchar *path, guint path_length)
+{
+  guint i;
+  gboolean is_quoted;
+  gboolean is_bracket;
+
+  if(path == NULL ||
+     path_length == 0){
+    return(FALSE);
+  }
+
+  is_quoted = FALSE;
+  is_bracket = FALSE;
+
+  for(i = 0; i < path_length && path[i] != '\0'; i++){
+    if(path[i] == '"'){
+      if(!is_bracket){
+	return(FALSE);
+      }
+
+      is_quoted = !is_quoted;
+
+      continue;
+    }
+
+    if(is_quoted){
+      continue;
+    }
+
+    if(path[i] == '['){
+      if(is_bracket){
+	return(FALSE);
+      }
+
+      is_bracket = TRUE;
+
+      /* empty bracket */
+      if(i + 1 >= path_length ||
+	 path[i + 1] == ']'){
+	return(FALSE);
+      }
+    }else if(path[i] == ']'){
+      is_bracket = FALSE;
+    }else if(is_bracket){
+      if(!g_ascii_isdigit(path[i])){
+	return(FALSE);
+      }
+    }else if(path[i] == '*' ||
+	     path[i] == '?' ||
+	     path[i] == '{' ||
+	     path[i] == '}'){
+      return(FALSE);
+    }
+  }
+
+  return((!is_quoted && !is_bracket) ? TRUE: FALSE);
+}
+
+/**
+ * ags_osc_address_trie_invalidate:
+ *
+ * Invalidate all #AgsOscAddressTrie. Call it whenever the session topology
+ * changes, it is cheap and doesn't take any lock.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_osc_address_trie_invalidate()
+{
+  g_atomic_int_inc(&ags_osc_address_trie_generation);
+}
+
+/**
+ * ags_osc_address_trie_begin_resolve:
+ * @osc_address_trie: the #AgsOscAddressTrie
+ *
+ * Begin resolving an address by the calling thread. The current generation
+ * is remembered, ags_osc_address_trie_insert() drops the entry if
+ * ags_osc_address_trie_invalidate() was called until then.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_osc_address_trie_begin_resolve(AgsOscAddressTrie *osc_address_trie)
+{
+  guint *resolve_generation;
+
+  resolve_generation = (guint *) g_private_get(&ags_osc_address_trie_resolve_key);
+
+  if(resolve_generation == NULL){
+    resolve_generation = (guint *) g_malloc(sizeof(guint));
+
+    g_private_set(&ags_osc_address_trie_resolve_key,
+		  resolve_generation);
+  }
+
+  resolve_generation[0] = g_atomic_int_get(&ags_osc_address_trie_generation);
+}
+
+/**
+ * ags_osc_address_trie_end_resolve:
+ * @osc_address_trie: the #AgsOscAddressTrie
+ *
+ * End resolving the address of ags_osc_address_trie_begin_resolve().
+ *
+ * Since: 3.5.0
+ */
+void
+ags_osc_address_trie_end_resolve(AgsOscAddressTrie *osc_address_trie)
+{
+  guint *resolve_generation;
+
+  resolve_generation = (guint *) g_private_get(&ags_osc_address_trie_resolve_key);
+
+  if(resolve_generation != NULL){
+    resolve_generation[0] = 0;
+  }
+}
+
+void
+ags_osc_address_trie_check_generation(AgsOscAddressTrie *osc_address_trie)
+{
+  guint generation;
+
+  generation = g_atomic_int_get(&ags_osc_address_trie_generation);
+
+  if(osc_address_trie->generation != generation){
+    ags_osc_address_trie_clear(osc_address_trie);
+
+    osc_address_trie->generation = generation;
+  }
+}
+
+/**
+ * ags_osc_address_trie_clear:
+ * @osc_address_trie: the #AgsOscAddressTrie
+ *
+ * Remove all cached addresses of @osc_address_trie.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_osc_address_trie_clear(AgsOscAddressTrie *osc_address_trie)
+{
+  GRecMutex *osc_address_trie_mutex;
+
+  if(!AGS_IS_OSC_ADDRESS_TRIE(osc_address_trie)){
+    return;
+  }
+
+  osc_address_trie_mutex = AGS_OSC_ADDRESS_TRIE_GET_OBJ_MUTEX(osc_address_trie);
+
+  g_rec_mutex_lock(osc_address_trie_mutex);
+
+  ags_osc_address_trie_node_free(osc_address_trie->root);
+
+  osc_address_trie->root = ags_osc_address_trie_node_alloc(NULL);
+
+  osc_address_trie->n_entries = 0;
+
+  g_rec_mutex_unlock(osc_address_trie_mutex);
+}
+
+/**
+ * ags_osc_address_trie_insert:
+ * @osc_address_trie: the #AgsOscAddressTrie
+ * @path: the OSC address
+ * @path_length: the length of @path up to and including the target segment
+ * @parent: (nullable): the parent of @target, like the #AgsRecall owning an #AgsPort
+ * @target: the resolved #GObject
+ *
+ * Cache @target as target of @path. Addresses that aren't concrete are
+ * ignored, as well as inserts outside of ags_osc_address_trie_begin_resolve()
+ * or after the topology changed since then.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_osc_address_trie_insert(AgsOscAddressTrie *osc_address_trie,
+			    gchar *path, guint path_length,
+			    GObject *parent,
+			    GObject *target)
+{
+  AgsOscAddressTrieNode *node;
+
+  gchar segment[AGS_OSC_ADDRESS_TRIE_MAX_SEGMENT_LENGTH];
+
+  guint *resolve_generation;
+  
+  guint offset, next;
+
+  GRecMutex *osc_address_trie_mutex;
+
+  if(!AGS_IS_OSC_ADDRESS_TRIE(osc_address_trie) ||
+     (parent != NULL && !G_IS_OBJECT(parent)) ||
+     !G_IS_OBJECT(target) ||
+     !ags_osc_address_trie_is_concrete(path, path_length)){
+    return;
+  }
+
+  resolve_generation = (guint *) g_private_get(&ags_osc_address_trie_resolve_key);
+
+  if(resolve_generation == NULL ||
+     resolve_generation[0] == 0){
+    return;
+  }
+  
+  osc_address_trie_mutex = AGS_OSC_ADDRESS_TRIE_GET_OBJ_MUTEX(osc_address_trie);
+
+  g_rec_mutex_lock(osc_address_trie_mutex);
+
+  ags_osc_address_trie_check_generation(osc_address_trie);
+
+  /* stale - invalidated while resolving */
+  if(osc_address_trie->generation != resolve_generation[0]){
+    g_rec_mutex_unlock(osc_address_trie_mutex);
+
+    return;
+  }
+
+  if(osc_address_trie->n_entries >= osc_address_trie->max_entries){
+    ags_osc_address_trie_clear(osc_address_trie);
+  }
+
+  node = osc_address_trie->root;
+
+  for(offset = 0; offset < path_length; offset = next){
+    AgsOscAddressTrieNode *child;
+
+    guint length;
+
+    next = ags_osc_address_trie_next_segment(path, path_length,
+					     offset);
+
+    if(path[offset] == '/'){
+      offset++;
+    }
+
+    length = next - offset;
+
+    if(length == 0 ||
+       length >= AGS_OSC_ADDRESS_TRIE_MAX_SEGMENT_LENGTH){
+      g_rec_mutex_unlock(osc_address_trie_mutex);
+
+      return;
+    }
+
+    memcpy(segment, path + offset, length * sizeof(gchar));
+    segment[length] = '\0';
+
+    if(node->child == NULL){
+      node->child = g_hash_table_new_full(g_str_hash, g_str_equal,
+					  NULL,
+					  (GDestroyNotify) ags_osc_address_trie_node_free);
+    }
+
+    child = g_hash_table_lookup(node->child,
+				segment);
+
+    if(child == NULL){
+      child = ags_osc_address_trie_node_alloc(segment);
+
+      g_hash_table_insert(node->child,
+			  child->segment,
+			  child);
+    }
+
+    node = child;
+  }
+
+  if(!node->has_target){
+    osc_address_trie->n_entries += 1;
+  }
+
+  node->has_target = TRUE;
+  node->has_parent = (parent != NULL) ? TRUE: FALSE;
+  
+  g_weak_ref_set(&(node->parent),
+		 parent);
+  g_weak_ref_set(&(node->target),
+		 target);
+
+  g_rec_mutex_unlock(osc_address_trie_mutex);
+}
+
+/**
+ * ags_osc_address_trie_lookup:
+ * @osc_address_trie: the #AgsOscAddressTrie
+ * @path: the OSC address
+ * @path_length: the length of @path up to and including the target segment
+ * @parent: (out) (transfer full): return location of the parent of the target
+ *
+ * Lookup the cached target of @path. If the target or its parent were
+ * finalized meanwhile, the entry is removed and %NULL returned.
+ *
+ * Returns: (transfer full): the target or %NULL if not cached
+ *
+ * Since: 3.5.0
+ */
+GObject*
+ags_osc_address_trie_lookup(AgsOscAddressTrie *osc_address_trie,
+			    gchar *path, guint path_length,
+			    GObject **parent)
+{
+  AgsOscAddressTrieNode *node;
+  GObject *current_parent;
+  GObject *target;
+
+  gchar segment[AGS_OSC_ADDRESS_TRIE_MAX_SEGMENT_LENGTH];
+
+  guint offset, next;
+
+  GRecMutex *osc_address_trie_mutex;
+
+  if(parent != NULL){
+    parent[0] = NULL;
+  }
+
+  if(!AGS_IS_OSC_ADDRESS_TRIE(osc_address_trie) ||
+     path == NULL ||
+     path_length == 0){
+    return(NULL);
+  }
+
+  osc_address_trie_mutex = AGS_OSC_ADDRESS_TRIE_GET_OBJ_MUTEX(osc_address_trie);
+
+  g_rec_mutex_lock(osc_address_trie_mutex);
+
+  ags_osc_address_trie_check_generation(osc_address_trie);
+
+  node = osc_address_trie->root;
+
+  for(offset = 0; node != NULL && offset < path_length; offset = next){
+    guint length;
+
+    next = ags_osc_address_trie_next_segment(path, path_length,
+					     offset);
+
+    if(path[offset] == '/'){
+      offset++;
+    }
+
+    length = next - offset;
+
+    if(node->child == NULL ||
+       length == 0 ||
+       length >= AGS_OSC_ADDRESS_TRIE_MAX_SEGMENT_LENGTH){
+      node = NULL;
+
+      break;
+    }
+
+    memcpy(segment, path + offset, length * sizeof(gchar));
+    segment[length] = '\0';
+
+    node = g_hash_table_lookup(node->child,
+			       segment);
+  }
+
+  target = NULL;
+
+  if(node != NULL &&
+     node->has_target){
+    target = g_weak_ref_get(&(node->target));
+    current_parent = g_weak_ref_get(&(node->parent));
+
+    if(target == NULL ||
+       (node->has_parent && current_parent == NULL)){
+      /* finalized - drop entry */
+      if(target != NULL){
+	g_object_unref(target);
+
+	target = NULL;
+      }
+      
+      node->has_target = FALSE;
+      node->has_parent = FALSE;
+
+      g_weak_ref_set(&(node->parent),
+		     NULL);
+      g_weak_ref_set(&(node->target),
+		     NULL);
+
+      osc_address_trie->n_entries -= 1;
+    }
+
+    if(parent != NULL &&
+       target != NULL){
+      parent[0] = current_parent;
+    }else if(current_parent != NULL){
+      g_object_unref(current_parent);
+    }
+  }
+
+  g_rec_mutex_unlock(osc_address_trie_mutex);
+
+  return(target);
+}
+
+/**
+ * ags_osc_address_trie_get_instance:
+ *
+ * Get instance.
+ *
+ * Returns: (transfer none): the #AgsOscAddressTrie
+ *
+ * Since: 3.5.0
+ */
+AgsOscAddressTrie*
+ags_osc_address_trie_get_instance()
+{
+  static GMutex mutex;
+
+  g_mutex_lock(&mutex);
+
+  if(ags_osc_address_trie == NULL){
+    ags_osc_address_trie = ags_osc_address_trie_new();
+  }
+
+  g_mutex_unlock(&mutex);
+
+  return(ags_osc_address_trie);
+}
+
+/**
+ * ags_osc_address_trie_new:
+ *
+ * Create a new instance of #AgsOscAddressTrie
+ *
+ * Returns: the new #AgsOscAddressTrie
+ *
+ * Since: 3.5.0
+ */
+AgsOscAddressTrie*
+ags_osc_address_trie_new()
+{
+  AgsOscAddressTrie *osc_address_trie;
+
+  osc_address_trie = (AgsOscAddressTrie *) g_object_new(AGS_TYPE_OSC_ADDRESS_TRIE,
+							NULL);
+
+  return(osc_address_trie);
+}
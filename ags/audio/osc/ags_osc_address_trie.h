@@ -0,0 +1,124 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_OSC_ADDRESS_TRIE_H__
+#define __AGS_OSC_ADDRESS_TRIE_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+#include <ags/audio/ags_recall.h>
+#include <ags/audio/ags_port.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_OSC_ADDRESS_TRIE                (ags_osc_address_trie_get_type())
+#define AGS_OSC_ADDRESS_TRIE(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_OSC_ADDRESS_TRIE, AgsOscAddressTrie))
+#define AGS_OSC_ADDRESS_TRIE_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_OSC_ADDRESS_TRIE, AgsOscAddressTrieClass))
+#define AGS_IS_OSC_ADDRESS_TRIE(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_OSC_ADDRESS_TRIE))
+#define AGS_IS_OSC_ADDRESS_TRIE_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_OSC_ADDRESS_TRIE))
+#define AGS_OSC_ADDRESS_TRIE_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_OSC_ADDRESS_TRIE, AgsOscAddressTrieClass))
+
+#define AGS_OSC_ADDRESS_TRIE_GET_OBJ_MUTEX(obj) (&(((AgsOscAddressTrie *) obj)->obj_mutex))
+
+#define AGS_OSC_ADDRESS_TRIE_NODE(ptr) ((AgsOscAddressTrieNode *)(ptr))
+
+#define AGS_OSC_ADDRESS_TRIE_MAX_SEGMENT_LENGTH (256)
+#define AGS_OSC_ADDRESS_TRIE_DEFAULT_MAX_ENTRIES (65536)
+
+typedef struct _AgsOscAddressTrie AgsOscAddressTrie;
+typedef struct _AgsOscAddressTrieClass AgsOscAddressTrieClass;
+typedef struct _AgsOscAddressTrieNode AgsOscAddressTrieNode;
+
+/**
+ * AgsOscAddressTrieNode:
+ * @segment: the path segment
+ * @child: the child nodes by segment
+ * @has_target: if %TRUE the node caches an address
+ * @has_parent: if %TRUE the cached target has got a parent
+ * @parent: weak reference to the parent of the target, like the #AgsRecall owning an #AgsPort
+ * @target: weak reference to the resolved object, like #AgsPort or soundcard
+ *
+ * #AgsOscAddressTrieNode is a path segment of the OSC address space.
+ */
+struct _AgsOscAddressTrieNode
+{
+  gchar *segment;
+
+  GHashTable *child;
+
+  gboolean has_target;
+  gboolean has_parent;
+  
+  GWeakRef parent;
+  GWeakRef target;
+};
+
+struct _AgsOscAddressTrie
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  guint generation;
+
+  guint n_entries;
+  guint max_entries;
+
+  AgsOscAddressTrieNode *root;
+};
+
+struct _AgsOscAddressTrieClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_osc_address_trie_get_type(void);
+
+AgsOscAddressTrieNode* ags_osc_address_trie_node_alloc(gchar *segment);
+void ags_osc_address_trie_node_free(AgsOscAddressTrieNode *node);
+
+guint ags_osc_address_trie_find_port_end(gchar *path);
+gboolean ags_osc_address_trie_is_concrete(gchar *path, guint path_length);
+
+void ags_osc_address_trie_invalidate();
+
+void ags_osc_address_trie_begin_resolve(AgsOscAddressTrie *osc_address_trie);
+void ags_osc_address_trie_end_resolve(AgsOscAddressTrie *osc_address_trie);
+
+void ags_osc_address_trie_clear(AgsOscAddressTrie *osc_address_trie);
+
+void ags_osc_address_trie_insert(AgsOscAddressTrie *osc_address_trie,
+				 gchar *path, guint path_length,
+				 GObject *parent,
+				 GObject *target);
+GObject* ags_osc_address_trie_lookup(AgsOscAddressTrie *osc_address_trie,
+				     gchar *path, guint path_length,
+				     GObject **parent);
+
+AgsOscAddressTrie* ags_osc_address_trie_get_instance();
+AgsOscAddressTrie* ags_osc_address_trie_new();
+
+G_END_DECLS
+
+#endif /*__AGS_OSC_ADDRESS_TRIE_H__*/
@@ -0,0 +1,856 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/osc/ags_osc_scheduler.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+void ags_osc_scheduler_class_init(AgsOscSchedulerClass *osc_scheduler);
+void ags_osc_scheduler_init(AgsOscScheduler *osc_scheduler);
+void ags_osc_scheduler_finalize(GObject *gobject);
+
+gboolean ags_osc_scheduler_event_less(AgsOscSchedulerEvent *a,
+				      AgsOscSchedulerEvent *b);
+void ags_osc_scheduler_pop(AgsOscScheduler *osc_scheduler,
+			   AgsOscSchedulerEvent *event);
+
+/**
+ * SECTION:ags_osc_scheduler
+ * @short_description: timetag scheduled OSC port writes
+ * @title: AgsOscScheduler
+ * @section_id:
+ * @include: ags/audio/osc/ags_osc_scheduler.h
+ *
+ * #AgsOscScheduler keeps port writes of timetagged OSC bundles in a heap
+ * ordered by engine frame. The audio loop drains it at the start of every
+ * period, so the writes follow the audio clock rather than the wakeup of
+ * the OSC delegate thread.
+ *
+ * The NTP timetag is mapped to a frame by a clock that is updated by
+ * every call to ags_osc_scheduler_drain(). It relates the wall clock to
+ * the frames processed so far and filters the wakeup jitter of the
+ * audio loop.
+ *
+ * The heap is allocated once with a fixed capacity, a push to a full heap
+ * fails and the caller writes immediately. The drain doesn't release the
+ * ports it applied, they are retired and unreferenced by the next push or
+ * ags_osc_scheduler_release_retired() on the OSC thread.
+ */
+
+static gpointer ags_osc_scheduler_parent_class = NULL;
+
+AgsOscScheduler *ags_osc_scheduler = NULL;
+
+static GPrivate ags_osc_scheduler_dispatch_key = G_PRIVATE_INIT((GDestroyNotify) g_free);
+
+GType
+ags_osc_scheduler_get_type (void)
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_osc_scheduler = 0;
+
+    static const GTypeInfo ags_osc_scheduler_info = {
+      sizeof (AgsOscSchedulerClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_osc_scheduler_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof (AgsOscScheduler),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_osc_scheduler_init,
+    };
+
+    ags_type_osc_scheduler = g_type_register_static(G_TYPE_OBJECT,
+						    "AgsOscScheduler",
+						    &ags_osc_scheduler_info,
+						    0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_osc_scheduler);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_osc_scheduler_class_init(AgsOscSchedulerClass *osc_scheduler)
+{
+  GObjectClass *gobject;
+
+  ags_osc_scheduler_parent_class = g_type_class_peek_parent(osc_scheduler);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) osc_scheduler;
+
+  gobject->finalize = ags_osc_scheduler_finalize;
+}
+
+void
+ags_osc_scheduler_init(AgsOscScheduler *osc_scheduler)
+{
+  osc_scheduler->flags = 0;
+
+  /* osc scheduler mutex */
+  g_rec_mutex_init(&(osc_scheduler->obj_mutex));
+
+  osc_scheduler->samplerate = 0;
+  osc_scheduler->buffer_size = 0;
+
+  osc_scheduler->frame = 0;
+
+  osc_scheduler->reference_frame = 0;
+  osc_scheduler->reference_time = 0;
+
+  osc_scheduler->serial = 0;
+
+  osc_scheduler->event = (AgsOscSchedulerEvent *) g_malloc(AGS_OSC_SCHEDULER_DEFAULT_ALLOCATED_EVENTS * sizeof(AgsOscSchedulerEvent));
+  osc_scheduler->n_events = 0;
+  osc_scheduler->allocated_events = AGS_OSC_SCHEDULER_DEFAULT_ALLOCATED_EVENTS;
+
+  osc_scheduler->retired_port = (AgsPort **) g_malloc(AGS_OSC_SCHEDULER_DEFAULT_ALLOCATED_EVENTS * sizeof(AgsPort *));
+  osc_scheduler->n_retired_ports = 0;
+}
+
+void
+ags_osc_scheduler_finalize(GObject *gobject)
+{
+  AgsOscScheduler *osc_scheduler;
+
+  osc_scheduler = AGS_OSC_SCHEDULER(gobject);
+
+  ags_osc_scheduler_clear(osc_scheduler);
+  ags_osc_scheduler_release_retired(osc_scheduler);
+
+  g_free(osc_scheduler->event);
+  g_free(osc_scheduler->retired_port);
+
+  if(osc_scheduler == ags_osc_scheduler){
+    ags_osc_scheduler = NULL;
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_osc_scheduler_parent_class)->finalize(gobject);
+}
+
+gboolean
+ags_osc_scheduler_event_less(AgsOscSchedulerEvent *a,
+			     AgsOscSchedulerEvent *b)
+{
+  if(a->frame < b->frame ||
+     (a->frame == b->frame &&
+      a->serial < b->serial)){
+    return(TRUE);
+  }
+
+  return(FALSE);
+}
+
+void
+ags_osc_scheduler_pop(AgsOscScheduler *osc_scheduler,
+		      AgsOscSchedulerEvent *event)
+{
+  AgsOscSchedulerEvent *heap;
+
+  guint n_events;
+  guint i;
+
+  heap = osc_scheduler->event;
+
+  event[0] = heap[0];
+
+  n_events = osc_scheduler->n_events - 1;
+  osc_scheduler->n_events = n_events;
+
+  if(n_events == 0){
+    return;
+  }
+
+  /* sift down */
+  heap[0] = heap[n_events];
+
+  for(i = 0;;){
+    AgsOscSchedulerEvent tmp;
+
+    guint smallest;
+    guint left, right;
+
+    smallest = i;
+
+    left = 2 * i + 1;
+    right = 2 * i + 2;
+
+    if(left < n_events &&
+       ags_osc_scheduler_event_less(heap + left, heap + smallest)){
+      smallest = left;
+    }
+
+    if(right < n_events &&
+       ags_osc_scheduler_event_less(heap + right, heap + smallest)){
+      smallest = right;
+    }
+
+    if(smallest == i){
+      break;
+    }
+
+    tmp = heap[i];
+    heap[i] = heap[smallest];
+    heap[smallest] = tmp;
+
+    i = smallest;
+  }
+}
+
+/**
+ * ags_osc_scheduler_timetag_to_time:
+ * @tv_sec: the NTP seconds
+ * @tv_fraction: the NTP fraction
+ *
+ * Convert OSC timetag to wall clock time as returned by g_get_real_time().
+ *
+ * Returns: the time in microseconds since January 1, 1970 UTC
+ *
+ * Since: 3.5.0
+ */
+gint64
+ags_osc_scheduler_timetag_to_time(gint32 tv_sec, gint32 tv_fraction)
+{
+  gint64 time;
+
+  time = ((gint64) ((guint32) tv_sec) - AGS_OSC_SCHEDULER_NTP_UNIX_OFFSET) * G_USEC_PER_SEC;
+  time += (gint64) ((((guint64) ((guint32) tv_fraction)) * G_USEC_PER_SEC) >> 32);
+
+  return(time);
+}
+
+/**
+ * ags_osc_scheduler_time_to_frame:
+ * @osc_scheduler: the #AgsOscScheduler
+ * @time: the wall clock time in microseconds
+ * @frame: (out): return location of the frame
+ *
+ * Map @time to an engine frame. Times in the past map to the current
+ * period.
+ *
+ * Returns: %TRUE if the clock runs, otherwise %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_osc_scheduler_time_to_frame(AgsOscScheduler *osc_scheduler,
+				gint64 time,
+				guint64 *frame)
+{
+  gint64 delta;
+  gboolean success;
+
+  GRecMutex *osc_scheduler_mutex;
+
+  if(!AGS_IS_OSC_SCHEDULER(osc_scheduler)){
+    return(FALSE);
+  }
+
+  osc_scheduler_mutex = AGS_OSC_SCHEDULER_GET_OBJ_MUTEX(osc_scheduler);
+
+  g_rec_mutex_lock(osc_scheduler_mutex);
+
+  success = (osc_scheduler->samplerate != 0) ? TRUE: FALSE;
+
+  if(success &&
+     frame != NULL){
+    delta = (time - osc_scheduler->reference_time) * (gint64) osc_scheduler->samplerate / G_USEC_PER_SEC;
+
+    if(delta < 0 &&
+       (guint64) -delta > osc_scheduler->reference_frame){
+      frame[0] = osc_scheduler->frame;
+    }else{
+      frame[0] = osc_scheduler->reference_frame + delta;
+
+      if(frame[0] < osc_scheduler->frame){
+	frame[0] = osc_scheduler->frame;
+      }
+    }
+  }
+
+  g_rec_mutex_unlock(osc_scheduler_mutex);
+
+  return(success);
+}
+
+/**
+ * ags_osc_scheduler_begin_dispatch:
+ * @osc_scheduler: the #AgsOscScheduler
+ * @tv_sec: the NTP seconds
+ * @tv_fraction: the NTP fraction
+ *
+ * Begin dispatching a timetagged message on the calling thread. Until
+ * ags_osc_scheduler_end_dispatch() is called, ags_osc_scheduler_push_dispatched()
+ * schedules at the frame of the timetag.
+ *
+ * Returns: %TRUE if the message is scheduled, otherwise %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_osc_scheduler_begin_dispatch(AgsOscScheduler *osc_scheduler,
+				 gint32 tv_sec, gint32 tv_fraction)
+{
+  guint64 *dispatch_frame;
+
+  guint64 frame;
+
+  if(!ags_osc_scheduler_time_to_frame(osc_scheduler,
+				      ags_osc_scheduler_timetag_to_time(tv_sec, tv_fraction),
+				      &frame)){
+    return(FALSE);
+  }
+
+  dispatch_frame = (guint64 *) g_private_get(&ags_osc_scheduler_dispatch_key);
+
+  if(dispatch_frame == NULL){
+    dispatch_frame = (guint64 *) g_malloc(sizeof(guint64));
+
+    g_private_set(&ags_osc_scheduler_dispatch_key,
+		  dispatch_frame);
+  }
+
+  dispatch_frame[0] = frame;
+
+  return(TRUE);
+}
+
+/**
+ * ags_osc_scheduler_end_dispatch:
+ * @osc_scheduler: the #AgsOscScheduler
+ *
+ * End dispatching the message of ags_osc_scheduler_begin_dispatch().
+ *
+ * Since: 3.5.0
+ */
+void
+ags_osc_scheduler_end_dispatch(AgsOscScheduler *osc_scheduler)
+{
+  guint64 *dispatch_frame;
+
+  dispatch_frame = (guint64 *) g_private_get(&ags_osc_scheduler_dispatch_key);
+
+  if(dispatch_frame != NULL){
+    dispatch_frame[0] = G_MAXUINT64;
+  }
+}
+
+/**
+ * ags_osc_scheduler_push:
+ * @osc_scheduler: the #AgsOscScheduler
+ * @frame: the engine frame
+ * @port: the #AgsPort
+ * @value: the #GValue containing a boolean, int64, uint64, float or double
+ *
+ * Schedule writing @value to @port at @frame. Ports retired by
+ * ags_osc_scheduler_drain() are released first.
+ *
+ * Returns: %TRUE if scheduled, %FALSE if invalid or the heap is full
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_osc_scheduler_push(AgsOscScheduler *osc_scheduler,
+		       guint64 frame,
+		       AgsPort *port,
+		       GValue *value)
+{
+  AgsOscSchedulerEvent *heap;
+  AgsOscSchedulerEvent event;
+
+  guint i;
+
+  GRecMutex *osc_scheduler_mutex;
+
+  if(!AGS_IS_OSC_SCHEDULER(osc_scheduler) ||
+     !AGS_IS_PORT(port) ||
+     value == NULL){
+    return(FALSE);
+  }
+
+  event.frame = frame;
+
+  event.port = port;
+
+  event.port_value_type = G_VALUE_TYPE(value);
+
+  switch(event.port_value_type){
+  case G_TYPE_BOOLEAN:
+  {
+    event.port_value.ags_port_boolean = g_value_get_boolean(value);
+  }
+  break;
+  case G_TYPE_INT64:
+  {
+    event.port_value.ags_port_int = g_value_get_int64(value);
+  }
+  break;
+  case G_TYPE_UINT64:
+  {
+    event.port_value.ags_port_uint = g_value_get_uint64(value);
+  }
+  break;
+  case G_TYPE_FLOAT:
+  {
+    event.port_value.ags_port_float = g_value_get_float(value);
+  }
+  break;
+  case G_TYPE_DOUBLE:
+  {
+    event.port_value.ags_port_double = g_value_get_double(value);
+  }
+  break;
+  default:
+    return(FALSE);
+  }
+
+  ags_osc_scheduler_release_retired(osc_scheduler);
+  
+  osc_scheduler_mutex = AGS_OSC_SCHEDULER_GET_OBJ_MUTEX(osc_scheduler);
+
+  g_rec_mutex_lock(osc_scheduler_mutex);
+
+  /* bounded - every event takes a retire slot after drain */
+  if(osc_scheduler->n_events + osc_scheduler->n_retired_ports >= osc_scheduler->allocated_events){
+    g_rec_mutex_unlock(osc_scheduler_mutex);
+
+    return(FALSE);
+  }
+
+  event.serial = osc_scheduler->serial;
+  osc_scheduler->serial += 1;
+
+  g_object_ref(port);
+
+  /* sift up */
+  heap = osc_scheduler->event;
+
+  i = osc_scheduler->n_events;
+  osc_scheduler->n_events += 1;
+
+  while(i > 0 &&
+	ags_osc_scheduler_event_less(&event, heap + ((i - 1) / 2))){
+    heap[i] = heap[(i - 1) / 2];
+
+    i = (i - 1) / 2;
+  }
+
+  heap[i] = event;
+
+  g_rec_mutex_unlock(osc_scheduler_mutex);
+
+  return(TRUE);
+}
+
+/**
+ * ags_osc_scheduler_push_dispatched:
+ * @osc_scheduler: the #AgsOscScheduler
+ * @port: the #AgsPort
+ * @value: the #GValue
+ *
+ * Schedule writing @value to @port at the frame of the message dispatched
+ * by the calling thread, see ags_osc_scheduler_begin_dispatch().
+ *
+ * Returns: %TRUE if scheduled, %FALSE if there is no timetagged message
+ * dispatched and the caller should write immediately
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_osc_scheduler_push_dispatched(AgsOscScheduler *osc_scheduler,
+				  AgsPort *port,
+				  GValue *value)
+{
+  guint64 *dispatch_frame;
+
+  dispatch_frame = (guint64 *) g_private_get(&ags_osc_scheduler_dispatch_key);
+
+  if(dispatch_frame == NULL ||
+     dispatch_frame[0] == G_MAXUINT64){
+    return(FALSE);
+  }
+
+  return(ags_osc_scheduler_push(osc_scheduler,
+				dispatch_frame[0],
+				port,
+				value));
+}
+
+/**
+ * ags_osc_scheduler_clear:
+ * @osc_scheduler: the #AgsOscScheduler
+ *
+ * Drop all pending events.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_osc_scheduler_clear(AgsOscScheduler *osc_scheduler)
+{
+  guint i;
+
+  GRecMutex *osc_scheduler_mutex;
+
+  if(!AGS_IS_OSC_SCHEDULER(osc_scheduler)){
+    return;
+  }
+
+  osc_scheduler_mutex = AGS_OSC_SCHEDULER_GET_OBJ_MUTEX(osc_scheduler);
+
+  g_rec_mutex_lock(osc_scheduler_mutex);
+
+  for(i = 0; i < osc_scheduler->n_events; i++){
+    g_object_unref(osc_scheduler->event[i].port);
+  }
+
+  osc_scheduler->n_events = 0;
+
+  g_rec_mutex_unlock(osc_scheduler_mutex);
+}
+
+/**
+ * ags_osc_scheduler_release_retired:
+ * @osc_scheduler: the #AgsOscScheduler
+ *
+ * Unreference the ports applied by ags_osc_scheduler_drain(). Call it from
+ * a non-realtime thread, the drain itself never drops a reference.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_osc_scheduler_release_retired(AgsOscScheduler *osc_scheduler)
+{
+  AgsPort **retired_port;
+
+  guint n_retired_ports;
+  guint i;
+
+  GRecMutex *osc_scheduler_mutex;
+
+  if(!AGS_IS_OSC_SCHEDULER(osc_scheduler)){
+    return;
+  }
+
+  osc_scheduler_mutex = AGS_OSC_SCHEDULER_GET_OBJ_MUTEX(osc_scheduler);
+
+  g_rec_mutex_lock(osc_scheduler_mutex);
+
+  n_retired_ports = osc_scheduler->n_retired_ports;
+
+  retired_port = NULL;
+  
+  if(n_retired_ports > 0){
+    retired_port = (AgsPort **) g_memdup(osc_scheduler->retired_port,
+					 n_retired_ports * sizeof(AgsPort *));
+  }
+  
+  osc_scheduler->n_retired_ports = 0;
+
+  g_rec_mutex_unlock(osc_scheduler_mutex);
+
+  /* unref outside of the lock the drain takes */
+  for(i = 0; i < n_retired_ports; i++){
+    g_object_unref(retired_port[i]);
+  }
+
+  g_free(retired_port);
+}
+
+/**
+ * ags_osc_scheduler_drain:
+ * @osc_scheduler: the #AgsOscScheduler
+ * @samplerate: the samplerate of the engine
+ * @buffer_size: the buffer size of the engine
+ *
+ * Advance the clock by one period and apply the events due within it. The
+ * frame of an event inside the period is handed to the port, see
+ * ags_osc_scheduler_get_offset(). The drain neither allocates nor releases
+ * references, see ags_osc_scheduler_release_retired().
+ *
+ * Returns: the count of events applied
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_osc_scheduler_drain(AgsOscScheduler *osc_scheduler,
+			guint samplerate, guint buffer_size)
+{
+  gint64 time_now;
+  gint64 predicted_time;
+  gint64 error;
+  guint64 end_frame;
+  guint count;
+
+  GRecMutex *osc_scheduler_mutex;
+
+  if(!AGS_IS_OSC_SCHEDULER(osc_scheduler) ||
+     samplerate == 0){
+    return(0);
+  }
+
+  osc_scheduler_mutex = AGS_OSC_SCHEDULER_GET_OBJ_MUTEX(osc_scheduler);
+
+  time_now = g_get_real_time();
+
+  g_rec_mutex_lock(osc_scheduler_mutex);
+
+  /* clock */
+  if(osc_scheduler->samplerate != samplerate ||
+     osc_scheduler->buffer_size != buffer_size ||
+     osc_scheduler->reference_time == 0){
+    osc_scheduler->samplerate = samplerate;
+    osc_scheduler->buffer_size = buffer_size;
+
+    osc_scheduler->reference_frame = osc_scheduler->frame;
+    osc_scheduler->reference_time = time_now;
+  }else{
+    predicted_time = osc_scheduler->reference_time + (gint64) ((osc_scheduler->frame - osc_scheduler->reference_frame) * G_USEC_PER_SEC / samplerate);
+
+    error = time_now - predicted_time;
+
+    if(error > AGS_OSC_SCHEDULER_MAX_CLOCK_ERROR ||
+       error < -AGS_OSC_SCHEDULER_MAX_CLOCK_ERROR){
+      osc_scheduler->reference_frame = osc_scheduler->frame;
+      osc_scheduler->reference_time = time_now;
+    }else{
+      osc_scheduler->reference_time += error / AGS_OSC_SCHEDULER_CLOCK_FILTER;
+    }
+  }
+
+  /* apply */
+  end_frame = osc_scheduler->frame + buffer_size;
+
+  count = 0;
+
+  while(osc_scheduler->n_events > 0 &&
+	osc_scheduler->event[0].frame < end_frame){
+    AgsOscSchedulerEvent event;
+
+    GRecMutex *port_mutex;
+
+    ags_osc_scheduler_pop(osc_scheduler,
+			  &event);
+
+    port_mutex = AGS_PORT_GET_OBJ_MUTEX(event.port);
+
+    g_rec_mutex_lock(port_mutex);
+
+    /* keep the value of the period start, a later write in the same period supersedes */
+    if(event.frame < osc_scheduler->frame){
+      event.frame = osc_scheduler->frame;
+    }
+
+    if(event.port->port_value_frame <= osc_scheduler->frame){
+      event.port->previous_port_value = event.port->port_value;
+    }
+
+    event.port->port_value_frame = event.frame;
+    
+    switch(event.port_value_type){
+    case G_TYPE_BOOLEAN:
+    {
+      event.port->port_value.ags_port_boolean = event.port_value.ags_port_boolean;
+    }
+    break;
+    case G_TYPE_INT64:
+    {
+      event.port->port_value.ags_port_int = event.port_value.ags_port_int;
+    }
+    break;
+    case G_TYPE_UINT64:
+    {
+      event.port->port_value.ags_port_uint = event.port_value.ags_port_uint;
+    }
+    break;
+    case G_TYPE_FLOAT:
+    {
+      event.port->port_value.ags_port_float = event.port_value.ags_port_float;
+    }
+    break;
+    case G_TYPE_DOUBLE:
+    {
+      event.port->port_value.ags_port_double = event.port_value.ags_port_double;
+    }
+    break;
+    }
+
+    g_rec_mutex_unlock(port_mutex);
+
+    /* retire - released by the OSC thread */
+    osc_scheduler->retired_port[osc_scheduler->n_retired_ports] = event.port;
+    osc_scheduler->n_retired_ports += 1;
+
+    count++;
+  }
+
+  osc_scheduler->frame += buffer_size;
+
+  g_rec_mutex_unlock(osc_scheduler_mutex);
+
+  return(count);
+}
+
+/**
+ * ags_osc_scheduler_get_offset:
+ * @osc_scheduler: the #AgsOscScheduler
+ * @port: the #AgsPort
+ * @previous_value: (out) (nullable): the #GValue to return the value before the offset
+ *
+ * Get the frame offset within the last drained period the value of @port
+ * takes effect at. Before the offset @port keeps @previous_value, it is
+ * set only if the offset is not 0 and has to be initialized with the
+ * #GType of @port.
+ *
+ * Returns: the offset, 0 if the value of @port applies to the whole period
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_osc_scheduler_get_offset(AgsOscScheduler *osc_scheduler,
+			     AgsPort *port,
+			     GValue *previous_value)
+{
+  guint64 start_frame, end_frame;
+  guint offset;
+
+  GRecMutex *osc_scheduler_mutex;
+  GRecMutex *port_mutex;
+
+  if(!AGS_IS_OSC_SCHEDULER(osc_scheduler) ||
+     !AGS_IS_PORT(port)){
+    return(0);
+  }
+
+  osc_scheduler_mutex = AGS_OSC_SCHEDULER_GET_OBJ_MUTEX(osc_scheduler);
+
+  g_rec_mutex_lock(osc_scheduler_mutex);
+
+  end_frame = osc_scheduler->frame;
+
+  start_frame = 0;
+
+  if(end_frame >= osc_scheduler->buffer_size){
+    start_frame = end_frame - osc_scheduler->buffer_size;
+  }
+  
+  g_rec_mutex_unlock(osc_scheduler_mutex);
+
+  /* offset */
+  offset = 0;
+  
+  port_mutex = AGS_PORT_GET_OBJ_MUTEX(port);
+
+  g_rec_mutex_lock(port_mutex);
+
+  if(port->port_value_frame > start_frame &&
+     port->port_value_frame < end_frame){
+    offset = (guint) (port->port_value_frame - start_frame);
+
+    if(previous_value != NULL){
+      switch(port->port_value_type){
+      case G_TYPE_BOOLEAN:
+      {
+	g_value_set_boolean(previous_value,
+			    port->previous_port_value.ags_port_boolean);
+      }
+      break;
+      case G_TYPE_INT64:
+      {
+	g_value_set_int64(previous_value,
+			  port->previous_port_value.ags_port_int);
+      }
+      break;
+      case G_TYPE_UINT64:
+      {
+	g_value_set_uint64(previous_value,
+			   port->previous_port_value.ags_port_uint);
+      }
+      break;
+      case G_TYPE_FLOAT:
+      {
+	g_value_set_float(previous_value,
+			  port->previous_port_value.ags_port_float);
+      }
+      break;
+      case G_TYPE_DOUBLE:
+      {
+	g_value_set_double(previous_value,
+			   port->previous_port_value.ags_port_double);
+      }
+      break;
+      }
+    }
+  }
+
+  g_rec_mutex_unlock(port_mutex);
+
+  return(offset);
+}
+
+/**
+ * ags_osc_scheduler_get_instance:
+ *
+ * Get instance.
+ *
+ * Returns: (transfer none): the #AgsOscScheduler
+ *
+ * Since: 3.5.0
+ */
+AgsOscScheduler*
+ags_osc_scheduler_get_instance()
+{
+  static GMutex mutex;
+
+  g_mutex_lock(&mutex);
+
+  if(ags_osc_scheduler == NULL){
+    ags_osc_scheduler = ags_osc_scheduler_new();
+  }
+
+  g_mutex_unlock(&mutex);
+
+  return(ags_osc_scheduler);
+}
+
+/**
+ * ags_osc_scheduler_new:
+ *
+ * Create a new instance of #AgsOscScheduler
+ *
+ * Returns: the new #AgsOscScheduler
+ *
+ * Since: 3.5.0
+ */
+AgsOscScheduler*
+ags_osc_scheduler_new()
+{
+  AgsOscScheduler *osc_scheduler;
+
+  osc_scheduler = (AgsOscScheduler *) g_object_new(AGS_TYPE_OSC_SCHEDULER,
+						   NULL);
+
+  return(osc_scheduler);
+}
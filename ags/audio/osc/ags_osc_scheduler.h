@@ -0,0 +1,142 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_OSC_SCHEDULER_H__
+#define __AGS_OSC_SCHEDULER_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+#include <ags/audio/ags_port.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_OSC_SCHEDULER                (ags_osc_scheduler_get_type())
+#define AGS_OSC_SCHEDULER(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_OSC_SCHEDULER, AgsOscScheduler))
+#define AGS_OSC_SCHEDULER_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_OSC_SCHEDULER, AgsOscSchedulerClass))
+#define AGS_IS_OSC_SCHEDULER(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_OSC_SCHEDULER))
+#define AGS_IS_OSC_SCHEDULER_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_OSC_SCHEDULER))
+#define AGS_OSC_SCHEDULER_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_OSC_SCHEDULER, AgsOscSchedulerClass))
+
+#define AGS_OSC_SCHEDULER_GET_OBJ_MUTEX(obj) (&(((AgsOscScheduler *) obj)->obj_mutex))
+
+#define AGS_OSC_SCHEDULER_EVENT(ptr) ((AgsOscSchedulerEvent *)(ptr))
+
+#define AGS_OSC_SCHEDULER_DEFAULT_ALLOCATED_EVENTS (4096)
+
+#define AGS_OSC_SCHEDULER_NTP_UNIX_OFFSET (2208988800)
+
+#define AGS_OSC_SCHEDULER_MAX_CLOCK_ERROR (100000)
+#define AGS_OSC_SCHEDULER_CLOCK_FILTER (64)
+
+typedef struct _AgsOscScheduler AgsOscScheduler;
+typedef struct _AgsOscSchedulerClass AgsOscSchedulerClass;
+typedef struct _AgsOscSchedulerEvent AgsOscSchedulerEvent;
+
+/**
+ * AgsOscSchedulerEvent:
+ * @frame: the engine frame to apply the event at
+ * @serial: the serial number, keeps arrival order of equal frames
+ * @port: the #AgsPort to write
+ * @port_value_type: the #GType of @port_value
+ * @port_value: the value to write
+ *
+ * #AgsOscSchedulerEvent is a pending port write of #AgsOscScheduler.
+ */
+struct _AgsOscSchedulerEvent
+{
+  guint64 frame;
+  guint64 serial;
+
+  AgsPort *port;
+
+  GType port_value_type;
+  union _AgsPortValue port_value;
+};
+
+struct _AgsOscScheduler
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  guint samplerate;
+  guint buffer_size;
+
+  guint64 frame;
+
+  guint64 reference_frame;
+  gint64 reference_time;
+
+  guint64 serial;
+
+  AgsOscSchedulerEvent *event;
+  guint n_events;
+  guint allocated_events;
+
+  AgsPort **retired_port;
+  guint n_retired_ports;
+};
+
+struct _AgsOscSchedulerClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_osc_scheduler_get_type(void);
+
+gint64 ags_osc_scheduler_timetag_to_time(gint32 tv_sec, gint32 tv_fraction);
+
+gboolean ags_osc_scheduler_time_to_frame(AgsOscScheduler *osc_scheduler,
+					 gint64 time,
+					 guint64 *frame);
+
+gboolean ags_osc_scheduler_begin_dispatch(AgsOscScheduler *osc_scheduler,
+					  gint32 tv_sec, gint32 tv_fraction);
+void ags_osc_scheduler_end_dispatch(AgsOscScheduler *osc_scheduler);
+
+gboolean ags_osc_scheduler_push(AgsOscScheduler *osc_scheduler,
+				guint64 frame,
+				AgsPort *port,
+				GValue *value);
+gboolean ags_osc_scheduler_push_dispatched(AgsOscScheduler *osc_scheduler,
+					   AgsPort *port,
+					   GValue *value);
+
+void ags_osc_scheduler_clear(AgsOscScheduler *osc_scheduler);
+
+void ags_osc_scheduler_release_retired(AgsOscScheduler *osc_scheduler);
+
+guint ags_osc_scheduler_drain(AgsOscScheduler *osc_scheduler,
+			      guint samplerate, guint buffer_size);
+
+guint ags_osc_scheduler_get_offset(AgsOscScheduler *osc_scheduler,
+				   AgsPort *port,
+				   GValue *previous_value);
+
+AgsOscScheduler* ags_osc_scheduler_get_instance();
+AgsOscScheduler* ags_osc_scheduler_new();
+
+G_END_DECLS
+
+#endif /*__AGS_OSC_SCHEDULER_H__*/
@@ -23,6 +23,7 @@
 
 #include <ags/audio/osc/ags_osc_response.h>
 #include <ags/audio/osc/ags_osc_buffer_util.h>
+#include <ags/audio/osc/ags_osc_address_trie.h>
 
 #include <ags/i18n.h>
 
@@ -300,6 +301,9 @@ ags_osc_config_controller_real_apply_config(AgsOscConfigController *osc_config_c
   ags_task_launcher_add_task(task_launcher,
 			     (AgsTask *) apply_sound_config);
 
+  /* cached addresses refer to the soundcards being replaced */
+  ags_osc_address_trie_invalidate();
+
   /* create response */
   osc_response = ags_osc_response_new();  
   start_response = g_list_prepend(start_response,
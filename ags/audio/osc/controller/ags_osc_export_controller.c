@@ -26,6 +26,7 @@
 
 #include <ags/audio/osc/ags_osc_response.h>
 #include <ags/audio/osc/ags_osc_buffer_util.h>
+#include <ags/audio/osc/ags_osc_address_trie.h>
 
 #include <ags/i18n.h>
 
@@ -342,6 +343,8 @@ ags_osc_export_controller_real_do_export(AgsOscExportController *osc_export_cont
 
       AgsThread *main_loop;
       
+      GObject *cached_soundcard;
+      
       GList *start_soundcard, *soundcard;
 
       regmatch_t match_arr[2];
@@ -388,7 +391,13 @@ ags_osc_export_controller_real_do_export(AgsOscExportController *osc_export_cont
       soundcard = 
 	start_soundcard = ags_sound_provider_get_soundcard(AGS_SOUND_PROVIDER(application_context));
 
-      if(ags_regexec(&single_access_regex, path + path_offset, index_max_matches, match_arr, 0) == 0){
+      /* cached address */
+      cached_soundcard = ags_osc_address_trie_lookup(ags_osc_address_trie_get_instance(),
+						     path, strlen(path),
+						     NULL);
+      
+      if(cached_soundcard != NULL ||
+	 ags_regexec(&single_access_regex, path + path_offset, index_max_matches, match_arr, 0) == 0){
 	AgsExportOutput *export_output;
       
 	AgsExportThread *current_export_thread;
@@ -399,16 +408,25 @@ ags_osc_export_controller_real_do_export(AgsOscExportController *osc_export_cont
       
 	guint i_stop;
 
-	endptr = NULL;
-	i_stop = g_ascii_strtoull(path + path_offset + 1,
-				  &endptr,
-				  10);
+	if(cached_soundcard != NULL){
+	  current = cached_soundcard;
+	}else{
+	  endptr = NULL;
+	  i_stop = g_ascii_strtoull(path + path_offset + 1,
+				    &endptr,
+				    10);
       
-	current = g_list_nth_data(start_soundcard,
-				  i_stop);
+	  current = g_list_nth_data(start_soundcard,
+				    i_stop);
 
-	path_offset += ((endptr + 1) - (path + path_offset));
+	  path_offset += ((endptr + 1) - (path + path_offset));
 
+	  ags_osc_address_trie_insert(ags_osc_address_trie_get_instance(),
+				      path, path_offset,
+				      NULL,
+				      current);
+	}
+	
 	current_export_thread = ags_export_thread_find_soundcard(export_thread,
 								 current);
 
@@ -421,6 +439,10 @@ ags_osc_export_controller_real_do_export(AgsOscExportController *osc_export_cont
 	ags_task_launcher_add_task(task_launcher,
 				   (AgsTask *) export_output);
 
+	if(cached_soundcard != NULL){
+	  g_object_unref(cached_soundcard);
+	}
+	
 	/* create response */
 	osc_response = ags_osc_response_new();  
 	start_response = g_list_prepend(start_response,
@@ -662,6 +684,8 @@ ags_osc_export_controller_do_export(AgsOscExportController *osc_export_controlle
   
   g_return_val_if_fail(AGS_IS_OSC_EXPORT_CONTROLLER(osc_export_controller), NULL);
   
+  ags_osc_address_trie_begin_resolve(ags_osc_address_trie_get_instance());
+  
   g_object_ref((GObject *) osc_export_controller);
   g_signal_emit(G_OBJECT(osc_export_controller),
 		osc_export_controller_signals[DO_EXPORT], 0,
@@ -670,6 +694,8 @@ ags_osc_export_controller_do_export(AgsOscExportController *osc_export_controlle
 		&osc_response);
   g_object_unref((GObject *) osc_export_controller);
 
+  ags_osc_address_trie_end_resolve(ags_osc_address_trie_get_instance());
+
   return(osc_response);
 }
 
@@ -24,6 +24,7 @@
 #include <ags/audio/osc/ags_osc_response.h>
 #include <ags/audio/osc/ags_osc_util.h>
 #include <ags/audio/osc/ags_osc_buffer_util.h>
+#include <ags/audio/osc/ags_osc_scheduler.h>
 
 #include <ags/audio/osc/controller/ags_osc_action_controller.h>
 #include <ags/audio/osc/controller/ags_osc_config_controller.h>
@@ -325,15 +326,20 @@ ags_osc_front_controller_delegate_thread(void *ptr)
   AgsOscServer *osc_server;
   AgsOscFrontController *osc_front_controller;
 
+  AgsOscScheduler *osc_scheduler;
+
   GList *start_controller, *controller;
   
   gint64 time_now, time_next;
+  gint64 time_real;
   gint64 current_time;
   
   GRecMutex *osc_controller_mutex;
 
   osc_front_controller = AGS_OSC_FRONT_CONTROLLER(ptr);
 
+  osc_scheduler = ags_osc_scheduler_get_instance();
+
   g_object_get(osc_front_controller,
 	       "osc-server", &osc_server,
 	       NULL);
@@ -383,6 +389,8 @@ ags_osc_front_controller_delegate_thread(void *ptr)
     list =
       start_list = g_list_copy(osc_front_controller->message);
 
+    time_real = g_get_real_time();
+
     while(list != NULL){
       if(AGS_OSC_MESSAGE(list->data)->immediately){
 	start_message = g_list_prepend(start_message,
@@ -391,16 +399,16 @@ ags_osc_front_controller_delegate_thread(void *ptr)
 	ags_osc_front_controller_remove_message(osc_front_controller,
 						list->data);
       }else{
-	current_time = AGS_OSC_MESSAGE(list->data)->tv_sec + AGS_OSC_MESSAGE(list->data)->tv_fraction / 4.294967296 * 1000.0;
-      
-	if(current_time < time_now){
+	current_time = ags_osc_scheduler_timetag_to_time(AGS_OSC_MESSAGE(list->data)->tv_sec, AGS_OSC_MESSAGE(list->data)->tv_fraction);
+
+	/* port writes are scheduled by the audio clock, so delegate them ahead of time */
+	if(current_time < time_real ||
+	   !g_strcmp0((gchar *) AGS_OSC_MESSAGE(list->data)->message, "/renew")){
 	  start_message = g_list_prepend(start_message,
 					 list->data);
 	  
 	  ags_osc_front_controller_remove_message(osc_front_controller,
 						  list->data);
-	}else{
-	  break;
 	}
       }
 
@@ -468,9 +476,22 @@ ags_osc_front_controller_delegate_thread(void *ptr)
 								  current->osc_connection,
 								  current->message, current->message_size);
 	  }else if(AGS_IS_OSC_RENEW_CONTROLLER(controller->data)){
+	    gboolean is_scheduled;
+
+	    is_scheduled = FALSE;
+
+	    if(!current->immediately){
+	      is_scheduled = ags_osc_scheduler_begin_dispatch(osc_scheduler,
+							      current->tv_sec, current->tv_fraction);
+	    }
+
 	    start_osc_response = ags_osc_renew_controller_set_data(controller->data,
 								   current->osc_connection,
 								   current->message, current->message_size);
+
+	    if(is_scheduled){
+	      ags_osc_scheduler_end_dispatch(osc_scheduler);
+	    }
 	  }else if(AGS_IS_OSC_STATUS_CONTROLLER(controller->data)){
 	    start_osc_response = ags_osc_status_controller_get_status(controller->data,
 								      current->osc_connection,
@@ -507,15 +528,22 @@ ags_osc_front_controller_delegate_thread(void *ptr)
     g_list_free_full(start_message,
 		     (GDestroyNotify) g_object_unref);
 
+    /* ports applied by the audio loop */
+    ags_osc_scheduler_release_retired(osc_scheduler);
+    
     /* next */
     g_mutex_lock(&(osc_front_controller->delegate_mutex));
 
     if(osc_front_controller->message != NULL){
       time_now = g_get_monotonic_time();
 
-      time_next = AGS_OSC_MESSAGE(osc_front_controller->message)->tv_sec + AGS_OSC_MESSAGE(osc_front_controller->message)->tv_fraction / 4.294967296 * 1000.0;
+      if(AGS_OSC_MESSAGE(osc_front_controller->message)->immediately){
+	time_next = time_now + 1;
+      }else{
+	time_next = time_now + (ags_osc_scheduler_timetag_to_time(AGS_OSC_MESSAGE(osc_front_controller->message)->tv_sec, AGS_OSC_MESSAGE(osc_front_controller->message)->tv_fraction) - g_get_real_time());
+      }
 
-      if(time_next == -1){
+      if(time_next <= time_now){
 	time_next = time_now + 1;
       }else if(time_next > time_now + G_TIME_SPAN_SECOND / 30){
 	time_next = time_now + G_TIME_SPAN_SECOND / 30;
@@ -31,6 +31,8 @@
 
 #include <ags/audio/osc/ags_osc_response.h>
 #include <ags/audio/osc/ags_osc_buffer_util.h>
+#include <ags/audio/osc/ags_osc_scheduler.h>
+#include <ags/audio/osc/ags_osc_address_trie.h>
 
 #include <ags/i18n.h>
 
@@ -57,6 +59,9 @@ void ags_osc_meter_controller_dispose(GObject *gobject);
 void ags_osc_meter_controller_finalize(GObject *gobject);
 
 gboolean ags_osc_meter_controller_monitor_timeout(AgsOscMeterController *osc_meter_controller);
+void ags_osc_meter_controller_write_bundle(AgsOscMeterController *osc_meter_controller,
+					   AgsOscConnection *osc_connection,
+					   GList *start_monitor);
 
 void ags_osc_meter_controller_real_start_monitor(AgsOscMeterController *osc_meter_controller);
 void ags_osc_meter_controller_real_stop_monitor(AgsOscMeterController *osc_meter_controller);
@@ -274,6 +279,9 @@ ags_osc_meter_controller_init(AgsOscMeterController *osc_meter_controller)
 
   osc_meter_controller->flags = 0;
 
+  osc_meter_controller->monitor_id = 0;
+  osc_meter_controller->monitor_threshold = AGS_OSC_METER_CONTROLLER_DEFAULT_MONITOR_THRESHOLD;
+
   /* monitor structs */
   osc_meter_controller->monitor = NULL;
 }
@@ -380,8 +388,39 @@ ags_osc_meter_controller_monitor_timeout(AgsOscMeterController *osc_meter_contro
     
   g_rec_mutex_unlock(osc_controller_mutex);
 
-  /*  */
-  monitor = start_monitor;
+  /* one bundle per connection */
+  if(ags_osc_meter_controller_test_flags(osc_meter_controller, AGS_OSC_METER_CONTROLLER_MONITOR_BUNDLE)){
+    GList *start_osc_connection, *osc_connection;
+
+    start_osc_connection = NULL;
+
+    monitor = start_monitor;
+
+    while(monitor != NULL){
+      if(g_list_find(start_osc_connection, AGS_OSC_METER_CONTROLLER_MONITOR(monitor->data)->osc_connection) == NULL){
+	start_osc_connection = g_list_prepend(start_osc_connection,
+					      AGS_OSC_METER_CONTROLLER_MONITOR(monitor->data)->osc_connection);
+      }
+
+      monitor = monitor->next;
+    }
+
+    osc_connection = start_osc_connection;
+
+    while(osc_connection != NULL){
+      ags_osc_meter_controller_write_bundle(osc_meter_controller,
+					    osc_connection->data,
+					    start_monitor);
+
+      osc_connection = osc_connection->next;
+    }
+
+    g_list_free(start_osc_connection);
+
+    monitor = NULL;
+  }else{
+    monitor = start_monitor;
+  }
 
   while(monitor != NULL){
     AgsPort *port;
@@ -642,6 +681,204 @@ ags_osc_meter_controller_monitor_timeout(AgsOscMeterController *osc_meter_contro
   return(G_SOURCE_CONTINUE);
 }
 
+void
+ags_osc_meter_controller_write_bundle(AgsOscMeterController *osc_meter_controller,
+				      AgsOscConnection *osc_connection,
+				      GList *start_monitor)
+{
+  AgsOscResponse *osc_response;
+  
+  GList *monitor;
+  GList *start_changed, *changed;
+  
+  guchar *packet;
+  guchar *data;
+  
+  gint64 time_now;
+  gdouble threshold;
+  guint packet_size;
+  guint data_size;
+  guint changed_count;
+  guint offset;
+  guint i;
+
+  GRecMutex *osc_controller_mutex;
+
+  /* get OSC meter controller mutex */
+  osc_controller_mutex = AGS_OSC_CONTROLLER_GET_OBJ_MUTEX(osc_meter_controller);
+
+  g_rec_mutex_lock(osc_controller_mutex);
+
+  threshold = osc_meter_controller->monitor_threshold;
+  
+  g_rec_mutex_unlock(osc_controller_mutex);
+
+  /* collect changed values and measure */
+  start_changed = NULL;
+
+  packet_size = 4 + 16;
+  data_size = 4;
+
+  changed_count = 0;
+  
+  monitor = start_monitor;
+
+  while(monitor != NULL){
+    AgsOscMeterControllerMonitor *current;
+    
+    current = AGS_OSC_METER_CONTROLLER_MONITOR(monitor->data);
+
+    if(current->osc_connection == osc_connection){
+      if(!current->is_announced){
+	/* announce path with ",si" */
+	packet_size += 4 + 8 + 4 + (4 * (guint) ceil((double) (strlen(current->path) + 1) / 4.0)) + 4;
+      }
+      
+      if(ags_osc_meter_controller_monitor_read_value(current,
+						     threshold)){
+	start_changed = g_list_prepend(start_changed,
+				       current);
+	
+	data_size += 8 + (current->value_length * 4);
+
+	changed_count++;
+      }
+    }
+    
+    monitor = monitor->next;
+  }
+
+  if(changed_count == 0 &&
+     packet_size == 4 + 16){
+    return;
+  }
+
+  if(changed_count > 0){
+    /* values with ",b" */
+    packet_size += 4 + 8 + 4 + 4 + data_size;
+  }
+  
+  /* bundle */
+  osc_response = ags_osc_response_new();
+      
+  packet = (guchar *) malloc(packet_size * sizeof(guchar));
+  memset(packet, 0, packet_size * sizeof(guchar));
+      
+  g_object_set(osc_response,
+	       "packet", packet,
+	       "packet-size", packet_size,
+	       NULL);
+
+  time_now = g_get_real_time();
+
+  ags_osc_buffer_util_put_bundle(packet + 4,
+				 (gint32) ((time_now / G_USEC_PER_SEC) + AGS_OSC_SCHEDULER_NTP_UNIX_OFFSET), (gint32) (((time_now % G_USEC_PER_SEC) << 32) / G_USEC_PER_SEC), FALSE);
+
+  offset = 4 + 16;
+
+  /* announce */
+  monitor = start_monitor;
+
+  while(monitor != NULL){
+    AgsOscMeterControllerMonitor *current;
+
+    guint length;
+    
+    current = AGS_OSC_METER_CONTROLLER_MONITOR(monitor->data);
+
+    if(current->osc_connection == osc_connection &&
+       !current->is_announced){
+      length = 4 * (guint) ceil((double) (strlen(current->path) + 1) / 4.0);
+
+      ags_osc_buffer_util_put_int32(packet + offset,
+				    8 + 4 + length + 4);
+      offset += 4;
+      
+      ags_osc_buffer_util_put_string(packet + offset,
+				     "/meter", -1);
+      offset += 8;
+
+      ags_osc_buffer_util_put_string(packet + offset,
+				     ",si", -1);
+      offset += 4;
+      
+      ags_osc_buffer_util_put_string(packet + offset,
+				     current->path, -1);
+      offset += length;
+
+      ags_osc_buffer_util_put_int32(packet + offset,
+				    current->monitor_id);
+      offset += 4;
+      
+      current->is_announced = TRUE;
+    }
+
+    monitor = monitor->next;
+  }
+
+  /* changed values as blob */
+  if(changed_count > 0){
+    ags_osc_buffer_util_put_int32(packet + offset,
+				  8 + 4 + 4 + data_size);
+    offset += 4;
+      
+    ags_osc_buffer_util_put_string(packet + offset,
+				   "/meter", -1);
+    offset += 8;
+
+    ags_osc_buffer_util_put_string(packet + offset,
+				   ",b", -1);
+    offset += 4;
+
+    ags_osc_buffer_util_put_int32(packet + offset,
+				  data_size);
+    offset += 4;
+
+    data = packet + offset;
+    
+    ags_osc_buffer_util_put_int32(data,
+				  changed_count);
+    data += 4;
+    
+    changed = 
+      start_changed = g_list_reverse(start_changed);
+
+    while(changed != NULL){
+      AgsOscMeterControllerMonitor *current;
+      
+      current = AGS_OSC_METER_CONTROLLER_MONITOR(changed->data);
+      
+      ags_osc_buffer_util_put_int32(data,
+				    current->monitor_id);
+      ags_osc_buffer_util_put_int32(data + 4,
+				    current->value_length);
+      data += 8;
+
+      for(i = 0; i < current->value_length; i++){
+	ags_osc_buffer_util_put_float(data,
+				      (gfloat) current->value[i]);
+	data += 4;
+      }
+      
+      changed = changed->next;
+    }
+
+    offset += data_size;
+  }
+
+  /* packet size */
+  ags_osc_buffer_util_put_int32(packet,
+				packet_size);
+
+  /* write response */
+  ags_osc_connection_write_response(osc_connection,
+				    (GObject *) osc_response);
+  g_object_run_dispose(osc_response);
+  g_object_unref(osc_response);
+
+  g_list_free(start_changed);
+}
+
 /**
  * ags_osc_meter_controller_test_flags:
  * @osc_meter_controller: the #AgsOscMeterController
@@ -758,6 +995,12 @@ ags_osc_meter_controller_monitor_alloc()
   monitor->path =  NULL;
   monitor->port = NULL;
 
+  monitor->monitor_id = 0;
+  monitor->is_announced = FALSE;
+
+  monitor->value_length = 0;
+  monitor->value = NULL;
+
   return(monitor);
 }
 
@@ -785,6 +1028,10 @@ ags_osc_meter_controller_monitor_free(AgsOscMeterControllerMonitor *monitor)
   if(monitor->port != NULL){
     g_object_unref(monitor->port);
   }
+
+  if(monitor->value != NULL){
+    free(monitor->value);
+  }
   
   free(monitor);
 }
@@ -919,6 +1166,9 @@ ags_osc_meter_controller_add_monitor(AgsOscMeterController *osc_meter_controller
 
   if(g_list_find(osc_meter_controller->monitor, monitor) == NULL){
     ags_osc_meter_controller_monitor_ref(monitor);
+
+    monitor->monitor_id = osc_meter_controller->monitor_id;
+    osc_meter_controller->monitor_id += 1;
     
     osc_meter_controller->monitor = g_list_prepend(osc_meter_controller->monitor, monitor);
   }
@@ -960,6 +1210,104 @@ ags_osc_meter_controller_remove_monitor(AgsOscMeterController *osc_meter_control
   g_rec_mutex_unlock(osc_controller_mutex);
 }
 
+/**
+ * ags_osc_meter_controller_monitor_read_value:
+ * @monitor: (type gpointer) (transfer none): the #AgsOscMeterControllerMonitor-struct
+ * @threshold: the threshold
+ * 
+ * Read the port value of @monitor. The value is only stored if it differs
+ * from the last stored value by more than @threshold.
+ * 
+ * Returns: %TRUE if the value changed, otherwise %FALSE
+ * 
+ * Since: 3.5.0
+ */
+gboolean
+ags_osc_meter_controller_monitor_read_value(AgsOscMeterControllerMonitor *monitor,
+					    gdouble threshold)
+{
+  AgsPort *port;
+
+  gdouble *value;
+  
+  guint value_length;
+  guint i;
+  gboolean is_changed;
+  
+  GRecMutex *port_mutex;
+
+  if(monitor == NULL ||
+     !AGS_IS_PORT(monitor->port)){
+    return(FALSE);
+  }
+
+  port = monitor->port;
+  
+  /* get port mutex */
+  port_mutex = AGS_PORT_GET_OBJ_MUTEX(port);
+
+  g_rec_mutex_lock(port_mutex);
+
+  if(port->port_value_is_pointer){
+    value_length = port->port_value_length;
+  }else{
+    value_length = 1;
+  }
+
+  if(!((port->port_value_type == G_TYPE_FLOAT && !port->port_value_is_pointer) ||
+       port->port_value_type == G_TYPE_DOUBLE)){
+    g_rec_mutex_unlock(port_mutex);
+
+    return(FALSE);
+  }
+  
+  is_changed = FALSE;
+  
+  if(monitor->value_length != value_length){
+    monitor->value = (gdouble *) realloc(monitor->value,
+					 value_length * sizeof(gdouble));
+    monitor->value_length = value_length;
+
+    is_changed = TRUE;
+  }
+
+  value = monitor->value;
+  
+  /* compare */
+  for(i = 0; !is_changed && i < value_length; i++){
+    gdouble current;
+
+    if(port->port_value_is_pointer){
+      current = port->port_value.ags_port_double_ptr[i];
+    }else if(port->port_value_type == G_TYPE_FLOAT){
+      current = port->port_value.ags_port_float;
+    }else{
+      current = port->port_value.ags_port_double;
+    }
+    
+    if(fabs(current - value[i]) > threshold){
+      is_changed = TRUE;
+    }
+  }
+
+  /* store */
+  if(is_changed){
+    for(i = 0; i < value_length; i++){
+      if(port->port_value_is_pointer){
+	value[i] = port->port_value.ags_port_double_ptr[i];
+      }else if(port->port_value_type == G_TYPE_FLOAT){
+	value[i] = port->port_value.ags_port_float;
+      }else{
+	value[i] = port->port_value.ags_port_double;
+      }
+    }
+  }
+  
+  g_rec_mutex_unlock(port_mutex);
+
+  return(is_changed);
+}
+
 /**
  * ags_osc_meter_controller_monitor_contains_monitor:
  * @osc_meter_controller: the #AgsOscMeterController
@@ -1063,6 +1411,51 @@ ags_osc_meter_controller_real_start_monitor(AgsOscMeterController *osc_meter_con
     free(str);
   }
 
+  /* monitor mode */
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_OSC_SERVER,
+			     "monitor-mode");
+
+  if(str == NULL){
+    str = ags_config_get_value(config,
+			       AGS_CONFIG_OSC_SERVER_0,
+			       "monitor-mode");
+  }
+
+  if(str != NULL){
+    if(!g_ascii_strncasecmp(str,
+			    "bundle",
+			    7)){
+      ags_osc_meter_controller_set_flags(osc_meter_controller, AGS_OSC_METER_CONTROLLER_MONITOR_BUNDLE);
+    }else{
+      ags_osc_meter_controller_unset_flags(osc_meter_controller, AGS_OSC_METER_CONTROLLER_MONITOR_BUNDLE);
+    }
+    
+    free(str);
+  }
+
+  /* monitor threshold */
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_OSC_SERVER,
+			     "monitor-threshold");
+
+  if(str == NULL){
+    str = ags_config_get_value(config,
+			       AGS_CONFIG_OSC_SERVER_0,
+			       "monitor-threshold");
+  }
+
+  if(str != NULL){
+    g_rec_mutex_lock(osc_controller_mutex);
+
+    osc_meter_controller->monitor_threshold = g_ascii_strtod(str,
+							     NULL);
+
+    g_rec_mutex_unlock(osc_controller_mutex);
+    
+    free(str);
+  }
+
   /* create monitor timeout */
   ags_osc_meter_controller_set_flags(osc_meter_controller, AGS_OSC_METER_CONTROLLER_MONITOR_RUNNING);
 
@@ -2542,6 +2935,11 @@ ags_osc_meter_controller_monitor_meter_recall(AgsOscMeterController *osc_meter_c
 
       path_offset += ((endptr + 1) - (path + path_offset));
 
+      ags_osc_address_trie_insert(ags_osc_address_trie_get_instance(),
+				  path, path_offset,
+				  (GObject *) recall,
+				  (GObject *) current);
+
       start_response = ags_osc_meter_controller_monitor_meter_port(osc_meter_controller,
 								   osc_connection,
 								   recall,
@@ -2745,6 +3143,11 @@ ags_osc_meter_controller_monitor_meter_recall(AgsOscMeterController *osc_meter_c
       }	
 
       path_offset += (length + 4);
+      ags_osc_address_trie_insert(ags_osc_address_trie_get_instance(),
+				  path, path_offset,
+				  (GObject *) recall,
+				  (GObject *) current);
+
       start_response  = ags_osc_meter_controller_monitor_meter_port(osc_meter_controller,
 								    osc_connection,
 								    recall,
@@ -3091,6 +3494,7 @@ ags_osc_meter_controller_monitor_meter_enable(AgsOscMeterController *osc_meter_c
   GList *start_audio, *audio;
   
   guint path_offset;
+  guint port_end;
 
   regmatch_t match_arr[2];
 
@@ -3150,6 +3554,47 @@ ags_osc_meter_controller_monitor_meter_enable(AgsOscMeterController *osc_meter_c
   }
   
   path_offset += 9;
+
+  /* cached address */
+  port_end = ags_osc_address_trie_find_port_end(path);
+
+  if(port_end > 0){
+    AgsRecall *recall;
+    AgsPort *port;
+
+    port = (AgsPort *) ags_osc_address_trie_lookup(ags_osc_address_trie_get_instance(),
+						   path, port_end,
+						   (GObject **) &recall);
+
+    if(port != NULL &&
+       !AGS_IS_PORT(port)){
+      g_object_unref(port);
+
+      if(recall != NULL){
+	g_object_unref(recall);
+      }
+      
+      port = NULL;
+    }
+    
+    if(port != NULL){
+      start_response = ags_osc_meter_controller_monitor_meter_port(osc_meter_controller,
+								   osc_connection,
+								   recall,
+								   port,
+								   message, message_size,
+								   type_tag,
+								   path, port_end);
+
+      if(recall != NULL){
+	g_object_unref(recall);
+      }
+      
+      g_object_unref(port);
+
+      return(start_response);
+    }
+  }
       
   /* compile regex */
   g_mutex_lock(&regex_mutex);
@@ -5020,6 +5465,8 @@ ags_osc_meter_controller_monitor_meter(AgsOscMeterController *osc_meter_controll
   
   g_return_val_if_fail(AGS_IS_OSC_METER_CONTROLLER(osc_meter_controller), NULL);
   
+  ags_osc_address_trie_begin_resolve(ags_osc_address_trie_get_instance());
+  
   g_object_ref((GObject *) osc_meter_controller);
   g_signal_emit(G_OBJECT(osc_meter_controller),
 		osc_meter_controller_signals[MONITOR_METER], 0,
@@ -5028,6 +5475,8 @@ ags_osc_meter_controller_monitor_meter(AgsOscMeterController *osc_meter_controll
 		&osc_response);
   g_object_unref((GObject *) osc_meter_controller);
 
+  ags_osc_address_trie_end_resolve(ags_osc_address_trie_get_instance());
+
   return(osc_response);
 }
 
@@ -41,6 +41,7 @@ G_BEGIN_DECLS
 #define AGS_OSC_METER_CONTROLLER_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS(obj, AGS_TYPE_OSC_METER_CONTROLLER, AgsOscMeterControllerClass))
 
 #define AGS_OSC_METER_CONTROLLER_DEFAULT_MONITOR_TIMEOUT (1.0 / 30.0)
+#define AGS_OSC_METER_CONTROLLER_DEFAULT_MONITOR_THRESHOLD (0.0001)
   
 #define AGS_OSC_METER_CONTROLLER_MONITOR(ptr) ((AgsOscMeterControllerMonitor *)(ptr))
 
@@ -52,6 +53,7 @@ typedef enum{
   AGS_OSC_METER_CONTROLLER_MONITOR_STARTED        = 1,
   AGS_OSC_METER_CONTROLLER_MONITOR_RUNNING        = 1 <<  1,
   AGS_OSC_METER_CONTROLLER_MONITOR_TERMINATING    = 1 <<  2,
+  AGS_OSC_METER_CONTROLLER_MONITOR_BUNDLE         = 1 <<  3,
 }AgsOscMeterControllerFlags;
 
 struct _AgsOscMeterController
@@ -59,6 +61,9 @@ struct _AgsOscMeterController
   AgsOscController osc_controller;
 
   guint flags;
+
+  guint monitor_id;
+  gdouble monitor_threshold;
   
   GList *monitor;
 };
@@ -83,6 +88,12 @@ struct _AgsOscMeterControllerMonitor
 
   gchar *path;
   AgsPort *port;
+
+  guint monitor_id;
+  gboolean is_announced;
+
+  guint value_length;
+  gdouble *value;
 };
 
 GType ags_osc_meter_controller_get_type();
@@ -107,6 +118,9 @@ void ags_osc_meter_controller_add_monitor(AgsOscMeterController *osc_meter_contr
 void ags_osc_meter_controller_remove_monitor(AgsOscMeterController *osc_meter_controller,
 					     AgsOscMeterControllerMonitor *monitor);
 
+gboolean ags_osc_meter_controller_monitor_read_value(AgsOscMeterControllerMonitor *monitor,
+						     gdouble threshold);
+
 gboolean ags_osc_meter_controller_contains_monitor(AgsOscMeterController *osc_meter_controller,
 						   AgsOscConnection *osc_connection,
 						   AgsPort *port);
@@ -31,6 +31,7 @@
 
 #include <ags/audio/osc/ags_osc_response.h>
 #include <ags/audio/osc/ags_osc_buffer_util.h>
+#include <ags/audio/osc/ags_osc_address_trie.h>
 
 #include <ags/i18n.h>
 
@@ -2843,6 +2844,11 @@ ags_osc_node_controller_get_data_recall(AgsOscNodeController *osc_node_controlle
 
       path_offset += ((endptr + 1) - (path + path_offset));
 
+      ags_osc_address_trie_insert(ags_osc_address_trie_get_instance(),
+				  path, path_offset,
+				  (GObject *) recall,
+				  (GObject *) current);
+
       start_response = ags_osc_node_controller_get_data_port(osc_node_controller,
 							     osc_connection,
 							     recall,
@@ -3037,6 +3043,11 @@ ags_osc_node_controller_get_data_recall(AgsOscNodeController *osc_node_controlle
       }	
 
       path_offset += (length + 4);
+      ags_osc_address_trie_insert(ags_osc_address_trie_get_instance(),
+				  path, path_offset,
+				  (GObject *) recall,
+				  (GObject *) current);
+
       start_response  = ags_osc_node_controller_get_data_port(osc_node_controller,
 							      osc_connection,
 							      recall,
@@ -3760,6 +3771,7 @@ ags_osc_node_controller_real_get_data(AgsOscNodeController *osc_node_controller,
   gchar *path;
   
   guint path_offset;
+  guint port_end;
   gboolean success;
 
   start_response = NULL;
@@ -3811,6 +3823,50 @@ ags_osc_node_controller_real_get_data(AgsOscNodeController *osc_node_controller,
     return(start_response);
   }
   
+  /* cached address */
+  port_end = ags_osc_address_trie_find_port_end(path);
+
+  if(port_end > 0){
+    AgsRecall *recall;
+    AgsPort *port;
+
+    port = (AgsPort *) ags_osc_address_trie_lookup(ags_osc_address_trie_get_instance(),
+						   path, port_end,
+						   (GObject **) &recall);
+
+    if(port != NULL &&
+       !AGS_IS_PORT(port)){
+      g_object_unref(port);
+
+      if(recall != NULL){
+	g_object_unref(recall);
+      }
+      
+      port = NULL;
+    }
+    
+    if(port != NULL){
+      start_response = ags_osc_node_controller_get_data_port(osc_node_controller,
+							     osc_connection,
+							     recall,
+							     port,
+							     message, message_size,
+							     type_tag,
+							     path, port_end);
+
+      if(recall != NULL){
+	g_object_unref(recall);
+      }
+      
+      g_object_unref(port);
+
+      free(type_tag);
+      free(path);
+
+      return(start_response);
+    }
+  }
+
   /* create packet */
   application_context = ags_application_context_get_instance();
 
@@ -4636,6 +4692,8 @@ ags_osc_node_controller_get_data(AgsOscNodeController *osc_node_controller,
   
   g_return_val_if_fail(AGS_IS_OSC_NODE_CONTROLLER(osc_node_controller), NULL);
   
+  ags_osc_address_trie_begin_resolve(ags_osc_address_trie_get_instance());
+  
   g_object_ref((GObject *) osc_node_controller);
   g_signal_emit(G_OBJECT(osc_node_controller),
 		osc_node_controller_signals[GET_DATA], 0,
@@ -4644,6 +4702,8 @@ ags_osc_node_controller_get_data(AgsOscNodeController *osc_node_controller,
 		&osc_response);
   g_object_unref((GObject *) osc_node_controller);
 
+  ags_osc_address_trie_end_resolve(ags_osc_address_trie_get_instance());
+
   return(osc_response);
 }
 
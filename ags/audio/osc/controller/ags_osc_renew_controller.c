@@ -36,6 +36,8 @@
 
 #include <ags/audio/osc/ags_osc_response.h>
 #include <ags/audio/osc/ags_osc_buffer_util.h>
+#include <ags/audio/osc/ags_osc_address_trie.h>
+#include <ags/audio/osc/ags_osc_scheduler.h>
 
 #include <ags/i18n.h>
 
@@ -439,8 +441,9 @@ ags_osc_renew_controller_set_data_soundcard(AgsOscRenewController *osc_renew_con
 
       set_samplerate = ags_set_samplerate_new(soundcard,
 					      samplerate);
-      ags_task_launcher_add_task(task_launcher,
-				  (AgsTask *) set_samplerate);
+      ags_task_launcher_add_task_coalesced(task_launcher,
+					   (AgsTask *) set_samplerate,
+					   soundcard);
     }else if(!strncmp(path + path_offset,
 		      "buffer-size",
 		      12)){
@@ -471,8 +474,9 @@ ags_osc_renew_controller_set_data_soundcard(AgsOscRenewController *osc_renew_con
 
       set_buffer_size = ags_set_buffer_size_new(soundcard,
 						buffer_size);
-      ags_task_launcher_add_task(task_launcher,
-				  (AgsTask *) set_buffer_size);
+      ags_task_launcher_add_task_coalesced(task_launcher,
+					   (AgsTask *) set_buffer_size,
+					   soundcard);
     }else if(!strncmp(path + path_offset,
 		      "format",
 		      7)){
@@ -503,8 +507,9 @@ ags_osc_renew_controller_set_data_soundcard(AgsOscRenewController *osc_renew_con
 
       set_format = ags_set_format_new(soundcard,
 				      format);
-      ags_task_launcher_add_task(task_launcher,
-				  (AgsTask *) set_format);
+      ags_task_launcher_add_task_coalesced(task_launcher,
+					   (AgsTask *) set_format,
+					   soundcard);
     }else{
       ags_osc_response_set_flags(osc_response,
 				 AGS_OSC_RESPONSE_ERROR);
@@ -884,8 +889,9 @@ ags_osc_renew_controller_set_data_audio(AgsOscRenewController *osc_renew_control
 
       set_samplerate = ags_set_samplerate_new((GObject *) audio,
 					      samplerate);
-      ags_task_launcher_add_task(task_launcher,
-				  (AgsTask *) set_samplerate);
+      ags_task_launcher_add_task_coalesced(task_launcher,
+					   (AgsTask *) set_samplerate,
+					   audio);
     }else if(!strncmp(path + path_offset,
 		      "buffer-size",
 		      12)){
@@ -916,8 +922,9 @@ ags_osc_renew_controller_set_data_audio(AgsOscRenewController *osc_renew_control
 
       set_buffer_size = ags_set_buffer_size_new((GObject *) audio,
 						buffer_size);
-      ags_task_launcher_add_task(task_launcher,
-				  (AgsTask *) set_buffer_size);
+      ags_task_launcher_add_task_coalesced(task_launcher,
+					   (AgsTask *) set_buffer_size,
+					   audio);
     }else if(!strncmp(path + path_offset,
 		      "format",
 		      7)){
@@ -948,8 +955,9 @@ ags_osc_renew_controller_set_data_audio(AgsOscRenewController *osc_renew_control
 
       set_format = ags_set_format_new((GObject *) audio,
 				      format);
-      ags_task_launcher_add_task(task_launcher,
-				  (AgsTask *) set_format);
+      ags_task_launcher_add_task_coalesced(task_launcher,
+					   (AgsTask *) set_format,
+					   audio);
     }else{
       ags_osc_response_set_flags(osc_response,
 				 AGS_OSC_RESPONSE_ERROR);
@@ -1843,8 +1851,9 @@ ags_osc_renew_controller_set_data_channel(AgsOscRenewController *osc_renew_contr
 
       set_samplerate = ags_set_samplerate_new((GObject *) channel,
 					      samplerate);
-      ags_task_launcher_add_task(task_launcher,
-				  (AgsTask *) set_samplerate);
+      ags_task_launcher_add_task_coalesced(task_launcher,
+					   (AgsTask *) set_samplerate,
+					   channel);
     }else if(!strncmp(path + path_offset,
 		      "buffer-size",
 		      12)){
@@ -1875,8 +1884,9 @@ ags_osc_renew_controller_set_data_channel(AgsOscRenewController *osc_renew_contr
 
       set_buffer_size = ags_set_buffer_size_new((GObject *) channel,
 						buffer_size);
-      ags_task_launcher_add_task(task_launcher,
-				  (AgsTask *) set_buffer_size);
+      ags_task_launcher_add_task_coalesced(task_launcher,
+					   (AgsTask *) set_buffer_size,
+					   channel);
     }else if(!strncmp(path + path_offset,
 		      "format",
 		      7)){
@@ -1907,8 +1917,9 @@ ags_osc_renew_controller_set_data_channel(AgsOscRenewController *osc_renew_contr
 
       set_format = ags_set_format_new((GObject *) channel,
 				      format);
-      ags_task_launcher_add_task(task_launcher,
-				  (AgsTask *) set_format);
+      ags_task_launcher_add_task_coalesced(task_launcher,
+					   (AgsTask *) set_format,
+					   channel);
     }else{
       ags_osc_response_set_flags(osc_response,
 				 AGS_OSC_RESPONSE_ERROR);
@@ -2538,6 +2549,11 @@ ags_osc_renew_controller_set_data_recall(AgsOscRenewController *osc_renew_contro
 
       path_offset += ((endptr + 1) - (path + path_offset));
 
+      ags_osc_address_trie_insert(ags_osc_address_trie_get_instance(),
+				  path, path_offset,
+				  (GObject *) recall,
+				  (GObject *) current);
+
       start_response = ags_osc_renew_controller_set_data_port(osc_renew_controller,
 							      osc_connection,
 							      recall,
@@ -2730,6 +2746,11 @@ ags_osc_renew_controller_set_data_recall(AgsOscRenewController *osc_renew_contro
       }	
 
       path_offset += (length + 4);
+      ags_osc_address_trie_insert(ags_osc_address_trie_get_instance(),
+				  path, path_offset,
+				  (GObject *) recall,
+				  (GObject *) current);
+
       start_response  = ags_osc_renew_controller_set_data_port(osc_renew_controller,
 							       osc_connection,
 							       recall,
@@ -2800,6 +2821,8 @@ ags_osc_renew_controller_set_data_port(AgsOscRenewController *osc_renew_controll
   
   GList *start_response;
 
+  GValue scheduled_value = G_VALUE_INIT;
+
   unsigned char *packet;
 
   guint path_length;
@@ -3139,11 +3162,22 @@ ags_osc_renew_controller_set_data_port(AgsOscRenewController *osc_renew_controll
 					    &value);
 
 	      /* set value */
-	      g_rec_mutex_lock(port_mutex);
+	      g_value_init(&scheduled_value,
+			   G_TYPE_INT64);
+	      g_value_set_int64(&scheduled_value,
+			     value);
 
-	      port->port_value.ags_port_int = value;
+	      if(!ags_osc_scheduler_push_dispatched(ags_osc_scheduler_get_instance(),
+						    port,
+						    &scheduled_value)){
+		g_rec_mutex_lock(port_mutex);
 
-	      g_rec_mutex_unlock(port_mutex);
+		port->port_value.ags_port_int = value;
+
+		g_rec_mutex_unlock(port_mutex);
+	      }
+
+	      g_value_unset(&scheduled_value);
 	    }else{
 	      success = FALSE;
 	    }
@@ -3178,11 +3212,22 @@ ags_osc_renew_controller_set_data_port(AgsOscRenewController *osc_renew_controll
 					    &value);
 
 	      /* set value */
-	      g_rec_mutex_lock(port_mutex);
+	      g_value_init(&scheduled_value,
+			   G_TYPE_UINT64);
+	      g_value_set_uint64(&scheduled_value,
+			     value);
+
+	      if(!ags_osc_scheduler_push_dispatched(ags_osc_scheduler_get_instance(),
+						    port,
+						    &scheduled_value)){
+		g_rec_mutex_lock(port_mutex);
 
-	      port->port_value.ags_port_uint = value;
+		port->port_value.ags_port_uint = value;
 
-	      g_rec_mutex_unlock(port_mutex);
+		g_rec_mutex_unlock(port_mutex);
+	      }
+
+	      g_value_unset(&scheduled_value);
 	    }else{
 	      success = FALSE;
 	    }
@@ -3217,11 +3262,22 @@ ags_osc_renew_controller_set_data_port(AgsOscRenewController *osc_renew_controll
 					    &value);
 
 	      /* set value */
-	      g_rec_mutex_lock(port_mutex);
+	      g_value_init(&scheduled_value,
+			   G_TYPE_FLOAT);
+	      g_value_set_float(&scheduled_value,
+			     value);
+
+	      if(!ags_osc_scheduler_push_dispatched(ags_osc_scheduler_get_instance(),
+						    port,
+						    &scheduled_value)){
+		g_rec_mutex_lock(port_mutex);
+
+		port->port_value.ags_port_float = value;
 
-	      port->port_value.ags_port_float = value;
+		g_rec_mutex_unlock(port_mutex);
+	      }
 
-	      g_rec_mutex_unlock(port_mutex);
+	      g_value_unset(&scheduled_value);
 	    }else{
 	      success = FALSE;
 	    }
@@ -3256,11 +3312,22 @@ ags_osc_renew_controller_set_data_port(AgsOscRenewController *osc_renew_controll
 					     &value);
 
 	      /* set value */
-	      g_rec_mutex_lock(port_mutex);
+	      g_value_init(&scheduled_value,
+			   G_TYPE_DOUBLE);
+	      g_value_set_double(&scheduled_value,
+			     value);
 
-	      port->port_value.ags_port_double = value;
+	      if(!ags_osc_scheduler_push_dispatched(ags_osc_scheduler_get_instance(),
+						    port,
+						    &scheduled_value)){
+		g_rec_mutex_lock(port_mutex);
 
-	      g_rec_mutex_unlock(port_mutex);
+		port->port_value.ags_port_double = value;
+
+		g_rec_mutex_unlock(port_mutex);
+	      }
+
+	      g_value_unset(&scheduled_value);
 	    }else{
 	      success = FALSE;
 	    }
@@ -3306,6 +3373,7 @@ ags_osc_renew_controller_real_set_data(AgsOscRenewController *osc_renew_controll
   gchar *path;
   
   guint path_offset;
+  guint port_end;
   gboolean success;
 
   start_response = NULL;
@@ -3357,6 +3425,50 @@ ags_osc_renew_controller_real_set_data(AgsOscRenewController *osc_renew_controll
     return(start_response);
   }
 
+  /* cached address */
+  port_end = ags_osc_address_trie_find_port_end(path);
+
+  if(port_end > 0){
+    AgsRecall *recall;
+    AgsPort *port;
+
+    port = (AgsPort *) ags_osc_address_trie_lookup(ags_osc_address_trie_get_instance(),
+						   path, port_end,
+						   (GObject **) &recall);
+
+    if(port != NULL &&
+       !AGS_IS_PORT(port)){
+      g_object_unref(port);
+
+      if(recall != NULL){
+	g_object_unref(recall);
+      }
+      
+      port = NULL;
+    }
+    
+    if(port != NULL){
+      start_response = ags_osc_renew_controller_set_data_port(osc_renew_controller,
+							      osc_connection,
+							      recall,
+							      port,
+							      message, message_size,
+							      type_tag,
+							      path, port_end);
+
+      if(recall != NULL){
+	g_object_unref(recall);
+      }
+      
+      g_object_unref(port);
+
+      free(type_tag);
+      free(path);
+
+      return(start_response);
+    }
+  }
+
   /* create packet */
   application_context = ags_application_context_get_instance();
 
@@ -4179,6 +4291,8 @@ ags_osc_renew_controller_set_data(AgsOscRenewController *osc_renew_controller,
   
   g_return_val_if_fail(AGS_IS_OSC_RENEW_CONTROLLER(osc_renew_controller), NULL);
   
+  ags_osc_address_trie_begin_resolve(ags_osc_address_trie_get_instance());
+  
   g_object_ref((GObject *) osc_renew_controller);
   g_signal_emit(G_OBJECT(osc_renew_controller),
 		osc_renew_controller_signals[SET_DATA], 0,
@@ -4187,6 +4301,8 @@ ags_osc_renew_controller_set_data(AgsOscRenewController *osc_renew_controller,
 		&osc_response);
   g_object_unref((GObject *) osc_renew_controller);
 
+  ags_osc_address_trie_end_resolve(ags_osc_address_trie_get_instance());
+
   return(osc_response);
 }
 
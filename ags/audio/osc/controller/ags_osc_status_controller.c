@@ -23,6 +23,10 @@
 #include <ags/audio/osc/ags_osc_server.h>
 #include <ags/audio/osc/ags_osc_buffer_util.h>
 
+#include <ags/audio/thread/ags_audio_loop.h>
+
+#include <ags/thread/ags_timing_monitor.h>
+
 #include <ags/i18n.h>
 
 #include <stdlib.h>
@@ -53,6 +57,12 @@ gpointer ags_osc_status_controller_real_get_status(AgsOscStatusController *statu
  * @include: ags/audio/osc/controller/ags_osc_status_controller.h
  *
  * The #AgsOscStatusController implements the OSC status controller.
+ *
+ * Without argument the server status is replied. The string argument "timing"
+ * replies the #AgsTimingMonitor summary one line per argument, "timing-enable",
+ * "timing-disable" and "timing-reset" control the recording. The argument
+ * "deadline" replies the tic, late tic and xrun counts, if degraded and the
+ * last and minimum slack of #AgsAudioLoop, "deadline-reset" resets them.
  */
 
 enum{
@@ -231,13 +241,17 @@ ags_osc_status_controller_real_get_status(AgsOscStatusController *osc_status_con
   
   GList *start_response;
 
+  gchar **timing_summary;
   gchar *type_tag;
+  gchar *argument;
   gchar *status;
   guchar *packet;
   
   guint real_packet_size;
   guint packet_size;
   guint length;
+  guint n_lines;
+  guint i;
   gboolean success;
 
   start_response = NULL;
@@ -250,9 +264,27 @@ ags_osc_status_controller_real_get_status(AgsOscStatusController *osc_status_con
   ags_osc_buffer_util_get_string(message + 8,
 				 &type_tag, NULL);
 
+  argument = NULL;
+  
   success = (type_tag != NULL &&
-	     !strncmp(type_tag, ",", 2)) ? TRUE: FALSE;
-
+	     (!strncmp(type_tag, ",", 2) ||
+	      !strncmp(type_tag, ",s", 3))) ? TRUE: FALSE;
+
+  if(success &&
+     !strncmp(type_tag, ",s", 3)){
+    /* read argument */
+    ags_osc_buffer_util_get_string(message + 12,
+				   &argument, NULL);
+
+    success = (argument != NULL &&
+	       (!g_strcmp0(argument, "timing") ||
+		!g_strcmp0(argument, "timing-enable") ||
+		!g_strcmp0(argument, "timing-disable") ||
+		!g_strcmp0(argument, "timing-reset") ||
+		!g_strcmp0(argument, "deadline") ||
+		!g_strcmp0(argument, "deadline-reset"))) ? TRUE: FALSE;
+  }
+  
   if(!success){
     ags_osc_response_set_flags(osc_response,
 			       AGS_OSC_RESPONSE_ERROR);
@@ -264,6 +296,10 @@ ags_osc_status_controller_real_get_status(AgsOscStatusController *osc_status_con
     if(type_tag != NULL){
       free(type_tag);
     }
+
+    if(argument != NULL){
+      free(argument);
+    }
     
     return(start_response);
   }
@@ -293,34 +329,168 @@ ags_osc_status_controller_real_get_status(AgsOscStatusController *osc_status_con
       
   packet_size += 8;
 
-  ags_osc_buffer_util_put_string(packet + packet_size,
-				 ",s", -1);
+  if(argument != NULL &&
+     !g_strcmp0(argument, "timing")){
+    /* timing summary - as many lines as fit into the chunk */
+    timing_summary = ags_timing_monitor_get_summary(ags_timing_monitor_get_instance());
+
+    length = 0;
+    
+    for(n_lines = 0; timing_summary != NULL && timing_summary[n_lines] != NULL; n_lines++){
+      guint line_size;
+
+      line_size = (4 * (guint) ceil((double) (strlen(timing_summary[n_lines]) + 1) / 4.0));
+      
+      if(packet_size + (4 * (guint) ceil((double) (n_lines + 3) / 4.0)) + length + line_size > real_packet_size){
+	break;
+      }
+
+      length += line_size;
+    }
+
+    for(i = 0; i < n_lines; i++){
+      packet[packet_size + i + 1] = 's';
+    }
+    
+    packet[packet_size] = ',';
+
+    packet_size += (4 * (guint) ceil((double) (n_lines + 2) / 4.0));
+
+    for(i = 0; i < n_lines; i++){
+      length = strlen(timing_summary[i]);
+      
+      ags_osc_buffer_util_put_string(packet + packet_size,
+				     timing_summary[i], -1);
+
+      packet_size += (4 * (guint) ceil((double) (length + 1) / 4.0));
+    }
+
+    g_strfreev(timing_summary);
+  }else if(argument != NULL &&
+	   !g_strcmp0(argument, "deadline")){
+    AgsApplicationContext *application_context;
+    AgsThread *main_loop;
+
+    gint64 slack, min_slack;
+    guint tic_count, late_tic_count, xrun_count;
+    gboolean is_degraded;
+
+    application_context = ags_application_context_get_instance();
+
+    main_loop = ags_concurrency_provider_get_main_loop(AGS_CONCURRENCY_PROVIDER(application_context));
+
+    tic_count = 0;
+    late_tic_count = 0;
+    xrun_count = 0;
+
+    slack = 0;
+    min_slack = 0;
+
+    is_degraded = FALSE;
+    
+    if(AGS_IS_AUDIO_LOOP(main_loop)){
+      ags_audio_loop_get_deadline((AgsAudioLoop *) main_loop,
+				  &tic_count,
+				  &late_tic_count,
+				  &xrun_count,
+				  &slack,
+				  &min_slack);
+
+      is_degraded = ags_audio_loop_test_flags((AgsAudioLoop *) main_loop, AGS_AUDIO_LOOP_DEGRADED);
+    }
+
+    if(main_loop != NULL){
+      g_object_unref(main_loop);
+    }
+    
+    /* tics, late tics, xruns, degraded, slack and minimum slack in nanoseconds */
+    ags_osc_buffer_util_put_string(packet + packet_size,
+				   ",iiiihh", -1);
   
-  /* status argument */
-  packet_size += 4;
-
-  if(ags_osc_server_test_flags(osc_server, AGS_OSC_SERVER_RUNNING)){
-    status = "server up and running";
-  }else if(ags_osc_server_test_flags(osc_server, AGS_OSC_SERVER_STARTED)){
-    status = "server started";
-  }else if(ags_osc_server_test_flags(osc_server, AGS_OSC_SERVER_TERMINATING)){
-    status = "server terminating";
+    packet_size += 8;
+
+    ags_osc_buffer_util_put_int32(packet + packet_size,
+				  tic_count);
+    packet_size += 4;
+
+    ags_osc_buffer_util_put_int32(packet + packet_size,
+				  late_tic_count);
+    packet_size += 4;
+
+    ags_osc_buffer_util_put_int32(packet + packet_size,
+				  xrun_count);
+    packet_size += 4;
+
+    ags_osc_buffer_util_put_int32(packet + packet_size,
+				  is_degraded);
+    packet_size += 4;
+
+    ags_osc_buffer_util_put_int64(packet + packet_size,
+				  slack);
+    packet_size += 8;
+
+    ags_osc_buffer_util_put_int64(packet + packet_size,
+				  min_slack);
+    packet_size += 8;
   }else{
-    status = "server stopped";
-  }
+    if(argument != NULL){
+      if(!g_strcmp0(argument, "deadline-reset")){
+	AgsApplicationContext *application_context;
+	AgsThread *main_loop;
+
+	application_context = ags_application_context_get_instance();
+
+	main_loop = ags_concurrency_provider_get_main_loop(AGS_CONCURRENCY_PROVIDER(application_context));
+
+	if(AGS_IS_AUDIO_LOOP(main_loop)){
+	  ags_audio_loop_reset_deadline((AgsAudioLoop *) main_loop);
+	}
+
+	if(main_loop != NULL){
+	  g_object_unref(main_loop);
+	}
+      }else if(!g_strcmp0(argument, "timing-enable")){
+	ags_timing_monitor_set_enabled(TRUE);
+      }else if(!g_strcmp0(argument, "timing-disable")){
+	ags_timing_monitor_set_enabled(FALSE);
+      }else if(!g_strcmp0(argument, "timing-reset")){
+	ags_timing_monitor_reset(ags_timing_monitor_get_instance());
+      }
+    }
+    
+    ags_osc_buffer_util_put_string(packet + packet_size,
+				   ",s", -1);
+  
+    /* status argument */
+    packet_size += 4;
+
+    if(ags_osc_server_test_flags(osc_server, AGS_OSC_SERVER_RUNNING)){
+      status = "server up and running";
+    }else if(ags_osc_server_test_flags(osc_server, AGS_OSC_SERVER_STARTED)){
+      status = "server started";
+    }else if(ags_osc_server_test_flags(osc_server, AGS_OSC_SERVER_TERMINATING)){
+      status = "server terminating";
+    }else{
+      status = "server stopped";
+    }
   
-  length = strlen(status);
+    length = strlen(status);
       
-  ags_osc_buffer_util_put_string(packet + packet_size,
-				 status, -1);
-
-  packet_size += (4 * (guint) ceil((double) (length + 1) / 4.0));
+    ags_osc_buffer_util_put_string(packet + packet_size,
+				   status, -1);
 
+    packet_size += (4 * (guint) ceil((double) (length + 1) / 4.0));
+  }
+  
   /* packet size */
   ags_osc_buffer_util_put_int32(packet,
 				packet_size);
   
   free(type_tag);
+
+  if(argument != NULL){
+    free(argument);
+  }
   
   return(start_response);
 }
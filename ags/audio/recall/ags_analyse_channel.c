@@ -305,7 +305,10 @@ ags_analyse_channel_init(AgsAnalyseChannel *analyse_channel)
 
   analyse_channel->comout = (fftw_complex *) fftw_malloc(analyse_channel->cache_buffer_size * sizeof(fftw_complex));
 
-  analyse_channel->plan = fftw_plan_r2r_1d(analyse_channel->cache_buffer_size, analyse_channel->in, analyse_channel->out, FFTW_R2HC, FFTW_ESTIMATE);
+  analyse_channel->plan = ags_fft_plan_cache_find_r2r(ags_fft_plan_cache_get_instance(),
+						      analyse_channel->cache_buffer_size, 1,
+						      FFTW_R2HC,
+						      fftw_alignment_of(analyse_channel->in));
 
   /* pre buffer */
   analyse_channel->frequency_pre_buffer = (double *) malloc(ceil(analyse_channel->cache_buffer_size / 2.0) * sizeof(double));
@@ -700,7 +703,6 @@ ags_analyse_channel_finalize(GObject *gobject)
   analyse_channel = AGS_ANALYSE_CHANNEL(gobject);
 
   /* buffer field */
-  fftw_destroy_plan(analyse_channel->plan);
   fftw_free(analyse_channel->in);
   fftw_free(analyse_channel->out);
   
@@ -841,7 +843,9 @@ ags_analyse_channel_retrieve_frequency_and_magnitude(AgsAnalyseChannel *analyse_
   /* execute plan */
   memset((void *) out, 0, cache_buffer_size * sizeof(double));
 
-  fftw_execute(analyse_channel->plan);
+  ags_fft_plan_execute_r2r(analyse_channel->plan,
+			   analyse_channel->in,
+			   out);
   
   /* retrieve frequency and magnitude */
   correction = (double) cache_samplerate / (double) cache_buffer_size;
@@ -28,6 +28,8 @@
 
 #include <ags/libags.h>
 
+#include <ags/audio/ags_fft_plan_cache.h>
+
 #include <ags/audio/ags_channel.h>
 #include <ags/audio/ags_recall_channel.h>
 #include <ags/audio/ags_port.h>
@@ -56,7 +58,7 @@ struct _AgsAnalyseChannel
   guint cache_buffer_size;
   guint cache_format;
 
-  fftw_plan plan;
+  AgsFFTPlan *plan;
   fftw_complex *comout;
 
   double *in;
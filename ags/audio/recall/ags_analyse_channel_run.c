@@ -104,6 +104,8 @@ ags_analyse_channel_run_init(AgsAnalyseChannelRun *analyse_channel_run)
 								   AGS_SOUND_ABILITY_WAVE |
 								   AGS_SOUND_ABILITY_MIDI));
   
+  ags_recall_set_flags((AgsRecall *) analyse_channel_run, AGS_RECALL_NON_ESSENTIAL);
+
   AGS_RECALL(analyse_channel_run)->name = "ags-analyse";
   AGS_RECALL(analyse_channel_run)->version = AGS_RECALL_DEFAULT_VERSION;
   AGS_RECALL(analyse_channel_run)->build_id = AGS_RECALL_DEFAULT_BUILD_ID;
@@ -667,6 +667,9 @@ ags_capture_wave_channel_run_run_pre(AgsRecall *recall)
 
     ags_soundcard_unlock_buffer(AGS_SOUNDCARD(input_soundcard), data);
     g_rec_mutex_unlock(buffer_mutex);
+
+    ags_buffer_invalidate_peak(buffer,
+			       attack, target_buffer_size - attack);
     
     g_list_free(list_start);
     
@@ -751,6 +754,9 @@ ags_capture_wave_channel_run_run_pre(AgsRecall *recall)
 
       ags_soundcard_unlock_buffer(AGS_SOUNDCARD(input_soundcard), data);
       g_rec_mutex_unlock(buffer_mutex);
+
+      ags_buffer_invalidate_peak(buffer,
+				 0, target_buffer_size);
     }
 
     if(resample_target){
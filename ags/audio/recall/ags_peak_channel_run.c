@@ -100,6 +100,8 @@ ags_peak_channel_run_init(AgsPeakChannelRun *peak_channel_run)
 								AGS_SOUND_ABILITY_WAVE |
 								AGS_SOUND_ABILITY_MIDI));
 
+  ags_recall_set_flags((AgsRecall *) peak_channel_run, AGS_RECALL_NON_ESSENTIAL);
+
   AGS_RECALL(peak_channel_run)->name = "ags-peak";
   AGS_RECALL(peak_channel_run)->version = AGS_RECALL_DEFAULT_VERSION;
   AGS_RECALL(peak_channel_run)->build_id = AGS_RECALL_DEFAULT_BUILD_ID;
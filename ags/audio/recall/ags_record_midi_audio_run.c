@@ -23,6 +23,7 @@
 #include <ags/audio/ags_recall_container.h>
 #include <ags/audio/ags_notation.h>
 #include <ags/audio/ags_note.h>
+#include <ags/audio/ags_midiin.h>
 
 #include <ags/audio/recall/ags_record_midi_audio.h>
 
@@ -32,6 +33,8 @@
 #include <ags/audio/midi/ags_midi_util.h>
 #include <ags/audio/midi/ags_midi_file.h>
 
+#include <ags/audio/task/ags_update_notation_snapshot.h>
+
 #include <ags/i18n.h>
 
 void ags_record_midi_audio_run_class_init(AgsRecordMidiAudioRunClass *record_midi_audio_run);
@@ -695,12 +698,14 @@ ags_record_midi_audio_run_run_pre(AgsRecall *recall)
   gboolean reverse_mapping;
   gboolean pattern_mode;
   gboolean playback, record;
+  gboolean notation_edited;
   guint midi_channel;
   guint audio_start_mapping;
   guint midi_start_mapping, midi_end_mapping;
   guint input_pads;
   guint audio_channel;
   guint buffer_length;
+  guint audio_buffer_size;
   guint i;
   
   GValue value = {0,};
@@ -751,12 +756,15 @@ ags_record_midi_audio_run_run_pre(AgsRecall *recall)
   reverse_mapping = ags_audio_test_behaviour_flags(audio,
 						   AGS_SOUND_BEHAVIOUR_REVERSE_MAPPING);
 
+  audio_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
+  
   g_object_get(audio,
 	       "input-pads", &input_pads,
 	       "audio-start-mapping", &audio_start_mapping,
 	       "midi-start-mapping", &midi_start_mapping,
 	       "midi-end-mapping", &midi_end_mapping,
 	       "midi-channel", &midi_channel,
+	       "buffer-size", &audio_buffer_size,
 	       "notation", &start_list,
 	       NULL);
 
@@ -775,6 +783,8 @@ ags_record_midi_audio_run_run_pre(AgsRecall *recall)
   list = ags_notation_find_near_timestamp(start_list, audio_channel,
 					  timestamp);
 
+  notation_edited = FALSE;
+
   if(list != NULL){
     notation = list->data;
   }
@@ -914,6 +924,13 @@ ags_record_midi_audio_run_run_pre(AgsRecall *recall)
 	    
 		  current_note->x[0] = notation_counter;
 		  current_note->x[1] = notation_counter + 1;
+
+		  /* sub-period attack */
+		  if(AGS_IS_MIDIIN(input_sequencer)){
+		    current_note->rt_attack = ags_midiin_get_frame_offset((AgsMidiin *) input_sequencer,
+									  midi_iter - midi_buffer,
+									  audio_buffer_size);
+		  }
 	      
 		  if(reverse_mapping){
 		    current_note->y = input_pads - ((0x7f & midi_iter[1]) - midi_start_mapping) - 1;
@@ -954,6 +971,8 @@ ags_record_midi_audio_run_run_pre(AgsRecall *recall)
 		  ags_notation_add_note(notation,
 					current_note,
 					FALSE);
+
+		  notation_edited = TRUE;
 		}
 	      }else{
 		if((0x7f & (midi_iter[2])) == 0){
@@ -1189,6 +1208,26 @@ ags_record_midi_audio_run_run_pre(AgsRecall *recall)
 
   ags_sequencer_unlock_buffer(AGS_SEQUENCER(input_sequencer),
 			      midi_buffer);
+
+  /* rebuild snapshot off the audio thread */
+  if(notation_edited){
+    AgsUpdateNotationSnapshot *update_notation_snapshot;
+
+    AgsTaskLauncher *task_launcher;
+
+    AgsApplicationContext *application_context;
+
+    application_context = ags_application_context_get_instance();
+
+    task_launcher = ags_concurrency_provider_get_task_launcher(AGS_CONCURRENCY_PROVIDER(application_context));
+
+    update_notation_snapshot = ags_update_notation_snapshot_new(notation);
+    
+    ags_task_launcher_add_task(task_launcher,
+			       (AgsTask *) update_notation_snapshot);
+
+    g_object_unref(task_launcher);
+  }
   
   /* call parent */
   parent_class_run_pre(recall);
@@ -407,6 +407,10 @@ ags_add_note_launch(AgsTask *task)
 			note,
 			add_note->use_selection_list);
 
+  if(!add_note->use_selection_list){
+    ags_notation_update_snapshot(notation);
+  }
+
   g_object_unref(timestamp);
 }
 
@@ -30,6 +30,7 @@
 #include <ags/audio/ags_synth_generator.h>
 #include <ags/audio/ags_audio_buffer_util.h>
 #include <ags/audio/ags_synth_util.h>
+#include <ags/audio/ags_recall_pool.h>
 
 #include <ags/audio/thread/ags_audio_loop.h>
 #include <ags/audio/thread/ags_soundcard_thread.h>
@@ -381,6 +382,9 @@ ags_apply_presets_launch(AgsTask *task)
   apply_presets = AGS_APPLY_PRESETS(task);
   
   if(AGS_IS_SOUNDCARD(apply_presets->scope)){
+    /* pre-instanced recalls were initialized with former presets */
+    ags_recall_pool_clear(ags_recall_pool_get_instance());
+
     ags_apply_presets_soundcard(apply_presets,
 				apply_presets->scope);
   }else if(AGS_IS_AUDIO(apply_presets->scope)){
@@ -29,6 +29,7 @@
 #include <ags/audio/ags_channel.h>
 #include <ags/audio/ags_playback_domain.h>
 #include <ags/audio/ags_playback.h>
+#include <ags/audio/ags_recall_pool.h>
 
 #include <ags/audio/file/ags_audio_file_link.h>
 #include <ags/audio/file/ags_audio_container.h>
@@ -66,6 +67,8 @@
 #include <ags/audio/core-audio/ags_core_audio_devin.h>
 #include <ags/audio/core-audio/ags_core_audio_midiin.h>
 
+#include <ags/audio/osc/ags_osc_address_trie.h>
+
 #include <math.h>
 
 #include <ags/i18n.h>
@@ -301,6 +304,7 @@ ags_apply_sound_config_launch(AgsTask *task)
 
   GObject *soundcard;
   GObject *sequencer;
+  GObject *default_soundcard;
 
   GList *start_sound_server, *sound_server;
   GList *start_orig_soundcard, *orig_soundcard;
@@ -345,6 +349,9 @@ ags_apply_sound_config_launch(AgsTask *task)
 			      apply_sound_config->config_data, -1);
   }
 
+  /* pre-instanced recalls were initialized with the former sound config */
+  ags_recall_pool_clear(ags_recall_pool_get_instance());
+
   jack_server = NULL;
   pulse_server = NULL;
   core_audio_server = NULL;
@@ -1309,6 +1316,20 @@ ags_apply_sound_config_launch(AgsTask *task)
   g_list_free_full(start_orig_sequencer,
 		   g_object_unref);
 
+  /* invalidate OSC addresses */
+  ags_osc_address_trie_invalidate();
+
+  /* audio loop clock */
+  default_soundcard = ags_sound_provider_get_default_soundcard(AGS_SOUND_PROVIDER(application_context));
+
+  g_object_set(audio_loop,
+	       "default-soundcard", default_soundcard,
+	       NULL);
+
+  if(default_soundcard != NULL){
+    g_object_unref(default_soundcard);
+  }
+  
   g_object_unref(audio_loop);
 }
 
@@ -622,6 +622,13 @@ ags_move_note_launch(AgsTask *task)
     selection = selection->next;
   }
 
+  /* publish to the audio thread */
+  ags_notation_update_snapshot(notation);
+
+  if(current_notation != notation){
+    ags_notation_update_snapshot(current_notation);
+  }
+  
   g_object_unref(audio);
 }
 
@@ -22,6 +22,8 @@
 #include <ags/audio/ags_audio.h>
 #include <ags/audio/ags_channel.h>
 #include <ags/audio/ags_input.h>
+#include <ags/audio/ags_audio_buffer_util.h>
+#include <ags/audio/ags_pitch_util.h>
 
 #include <ags/audio/file/ags_audio_file_link.h>
 #include <ags/audio/file/ags_sound_container.h>
@@ -375,8 +377,10 @@ ags_open_sfz_file_launch(AgsTask *task)
   AgsSFZGroup *group;
   AgsSFZRegion *region;      
   AgsOpenSFZFile *open_sfz_file;
+  AgsPitchUtil *pitch_util;
   
   GObject *output_soundcard;
+  GObject *pitch_source;
 
   GList *start_audio_signal, *audio_signal;
   GList *start_list, *list;
@@ -466,6 +470,12 @@ ags_open_sfz_file_launch(AgsTask *task)
 
   audio_signal = 
     start_audio_signal = NULL;
+
+  /* the pitch scratch is shared by all keys */
+  pitch_util = ags_pitch_util_alloc(AGS_PITCH_UTIL_RESAMPLE,
+				    AGS_SOUNDCARD_DEFAULT_SAMPLERATE);
+
+  pitch_source = NULL;
     
   j_stop = n_audio_channels;
   
@@ -808,6 +818,7 @@ ags_open_sfz_file_launch(AgsTask *task)
       guint samplerate;
       guint buffer_size;
       guint format;
+      guint audio_buffer_util_format;
       guint loop_start, loop_end;
       glong pitch_keycenter, current_pitch_keycenter;
       guint x_offset;
@@ -921,88 +932,48 @@ ags_open_sfz_file_launch(AgsTask *task)
 					audio_signal->data);
       
       /* pitch */
+      audio_buffer_util_format = ags_audio_buffer_util_format_from_soundcard(format);
+
+      if(pitch_source != audio_signal->data){
+	ags_pitch_util_reserve_source(pitch_util,
+				      0);
+
+	stream = AGS_AUDIO_SIGNAL(audio_signal->data)->stream;
+
+	while(stream != NULL){
+	  ags_pitch_util_append_source(pitch_util,
+				       stream->data, buffer_size,
+				       audio_buffer_util_format);
+	  
+	  stream = stream->next;
+	}
+
+	pitch_source = audio_signal->data;
+      }
+      
+      key -= lokey;
+
+      ags_pitch_util_set_samplerate(pitch_util,
+				    samplerate, samplerate);
+      ags_pitch_util_set_pitch(pitch_util,
+			       pitch_keycenter - 48.0,
+			       ((gdouble) key - (gdouble) pitch_keycenter) * 100.0);
+
+      ags_pitch_util_reset(pitch_util);
+
       stream =
 	start_stream = current_audio_signal->stream;
 
       x_offset = 0;
 
-      key -= lokey;
-
       while(stream != NULL){
-	switch(format){
-	case AGS_SOUNDCARD_SIGNED_8_BIT:
-	{
-	  ags_filter_util_pitch_s8((gint8 *) stream->data,
-				   buffer_size,
-				   samplerate,
-				   pitch_keycenter - 48.0,
-				   ((gdouble) key - (gdouble) pitch_keycenter) * 100.0);
-	}
-	break;
-	case AGS_SOUNDCARD_SIGNED_16_BIT:
-	{
-	  ags_filter_util_pitch_s16((gint16 *) stream->data,
-				    buffer_size,
-				    samplerate,
-				    pitch_keycenter - 48.0,
-				    ((gdouble) key - (gdouble) pitch_keycenter) * 100.0);
-	}
-	break;
-	case AGS_SOUNDCARD_SIGNED_24_BIT:
-	{
-	  ags_filter_util_pitch_s24((gint32 *) stream->data,
-				    buffer_size,
-				    samplerate,
-				    pitch_keycenter - 48.0,
-				    ((gdouble) key - (gdouble) pitch_keycenter) * 100.0);
-	}
-	break;
-	case AGS_SOUNDCARD_SIGNED_32_BIT:
-	{
-	  ags_filter_util_pitch_s32((gint32 *) stream->data,
-				    buffer_size,
-				    samplerate,
-				    pitch_keycenter - 48.0,
-				    ((gdouble) key - (gdouble) pitch_keycenter) * 100.0);
-	}
-	break;
-	case AGS_SOUNDCARD_SIGNED_64_BIT:
-	{
-	  ags_filter_util_pitch_s64((gint64 *) stream->data,
-				    buffer_size,
-				    samplerate,
-				    pitch_keycenter - 48.0,
-				    ((gdouble) key - (gdouble) pitch_keycenter) * 100.0);
-	}
-	break;
-	case AGS_SOUNDCARD_FLOAT:
-	{
-	  ags_filter_util_pitch_float((gfloat *) stream->data,
-				      buffer_size,
-				      samplerate,
-				      pitch_keycenter - 48.0,
-				      ((gdouble) key - (gdouble) pitch_keycenter) * 100.0);
-	}
-	break;
-	case AGS_SOUNDCARD_DOUBLE:
-	{
-	  ags_filter_util_pitch_double((gdouble *) stream->data,
-				       buffer_size,
-				       samplerate,
-				       pitch_keycenter - 48.0,
-				       ((gdouble) key - (gdouble) pitch_keycenter) * 100.0);
-	}
-	break;
-	case AGS_SOUNDCARD_COMPLEX:
-	{
-	  ags_filter_util_pitch_complex((AgsComplex *) stream->data,
-					buffer_size,
-					samplerate,
-					pitch_keycenter - 48.0,
-					((gdouble) key - (gdouble) pitch_keycenter) * 100.0);
-	}
-	break;
-	}	  
+	ags_audio_buffer_util_clear_buffer(stream->data, 1,
+					   buffer_size, audio_buffer_util_format);
+
+	ags_pitch_util_resample(pitch_util,
+				stream->data,
+				buffer_size,
+				audio_buffer_util_format);
 
 	/* iterate */
 	x_offset += buffer_size;
@@ -1029,6 +1000,8 @@ ags_open_sfz_file_launch(AgsTask *task)
       audio_signal = 
 	start_audio_signal = NULL;
 
+      pitch_source = NULL;
+
       i++;
       j = 0;
 
@@ -1042,6 +1015,8 @@ ags_open_sfz_file_launch(AgsTask *task)
     input = next_input;
   }
   
+  ags_pitch_util_free(pitch_util);
+  
   g_object_unref(output_soundcard);
 
   g_list_free_full(start_list,
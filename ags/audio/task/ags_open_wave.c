@@ -26,6 +26,9 @@
 #include <ags/audio/ags_buffer.h>
 
 #include <ags/audio/file/ags_sound_resource.h>
+#include <ags/audio/file/ags_wave_stream.h>
+
+#include <ags/audio/fx/ags_fx_playback_audio.h>
 
 #include <ags/config.h>
 
@@ -423,7 +426,7 @@ ags_open_wave_launch(AgsTask *task)
 			 AGS_TYPE_INPUT,
 			 open_wave->start_pad + 1, 0);
     }
-          
+
     wave =
       start_wave = ags_sound_resource_read_wave(AGS_SOUND_RESOURCE(audio_file->sound_resource),
 						output_soundcard,
@@ -449,6 +452,29 @@ ags_open_wave_launch(AgsTask *task)
     }
 
     g_list_free(start_wave);
+
+    /* long files are played from disk until edited, the streams map to the audio channels of the first pad */
+    if(open_wave->start_pad == 0 &&
+       ags_wave_stream_test_duration(audio_file->sound_resource)){
+      GList *start_wave_stream, *wave_stream;
+
+      wave_stream =
+	start_wave_stream = ags_wave_stream_open_filename(audio_file->filename,
+							  output_soundcard);
+
+      ags_fx_playback_audio_attach_wave_stream(audio,
+					       start_wave_stream,
+					       TRUE);
+      
+      while(wave_stream != NULL){
+	ags_wave_stream_start(wave_stream->data);
+
+	wave_stream = wave_stream->next;
+      }
+
+      g_list_free_full(start_wave_stream,
+		       g_object_unref);
+    }
   }
 }
 
@@ -403,6 +403,10 @@ ags_remove_note_launch(AgsTask *task)
   ags_notation_remove_note(notation,
 			   note,
 			   remove_note->use_selection_list);
+
+  if(!remove_note->use_selection_list){
+    ags_notation_update_snapshot(notation);
+  }
   
   g_object_unref(timestamp);
 }
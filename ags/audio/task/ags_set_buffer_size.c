@@ -24,6 +24,7 @@
 #include <ags/audio/ags_channel.h>
 #include <ags/audio/ags_recycling.h>
 #include <ags/audio/ags_audio_signal.h>
+#include <ags/audio/ags_recall_pool.h>
 
 #include <ags/i18n.h>
 
@@ -277,6 +278,9 @@ ags_set_buffer_size_launch(AgsTask *task)
   scope = set_buffer_size->scope;
 
   if(AGS_IS_SOUNDCARD(scope)){
+    /* pre-instanced recalls were initialized with former presets */
+    ags_recall_pool_clear(ags_recall_pool_get_instance());
+
     ags_set_buffer_size_soundcard(set_buffer_size, scope);
   }else if(AGS_IS_AUDIO(scope)){
     ags_set_buffer_size_audio(set_buffer_size, AGS_AUDIO(scope));
@@ -23,6 +23,7 @@
 #include <ags/audio/ags_channel.h>
 #include <ags/audio/ags_recycling.h>
 #include <ags/audio/ags_audio_signal.h>
+#include <ags/audio/ags_recall_pool.h>
 
 #include <ags/i18n.h>
 
@@ -276,6 +277,9 @@ ags_set_format_launch(AgsTask *task)
   scope = set_format->scope;
 
   if(AGS_IS_SOUNDCARD(scope)){
+    /* pre-instanced recalls were initialized with former presets */
+    ags_recall_pool_clear(ags_recall_pool_get_instance());
+
     ags_set_format_soundcard(set_format, scope);
   }else if(AGS_IS_AUDIO(scope)){
     ags_set_format_audio(set_format, AGS_AUDIO(scope));
@@ -24,6 +24,7 @@
 #include <ags/audio/ags_channel.h>
 #include <ags/audio/ags_recycling.h>
 #include <ags/audio/ags_audio_signal.h>
+#include <ags/audio/ags_recall_pool.h>
 
 #include <ags/i18n.h>
 
@@ -277,6 +278,9 @@ ags_set_samplerate_launch(AgsTask *task)
   scope = set_samplerate->scope;
 
   if(AGS_IS_SOUNDCARD(scope)){
+    /* pre-instanced recalls were initialized with former presets */
+    ags_recall_pool_clear(ags_recall_pool_get_instance());
+
     ags_set_samplerate_soundcard(set_samplerate, scope);
   }else if(AGS_IS_AUDIO(scope)){
     ags_set_samplerate_audio(set_samplerate, AGS_AUDIO(scope));
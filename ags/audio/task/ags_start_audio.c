@@ -22,6 +22,7 @@
 #include <ags/libags.h>
 
 #include <ags/audio/ags_audio.h>
+#include <ags/audio/ags_recall_pool.h>
 
 #include <ags/i18n.h>
 
@@ -282,6 +283,9 @@ ags_start_audio_launch(AgsTask *task)
   recall_id = ags_audio_start(audio,
 			      sound_scope);
 
+  /* refill recall pool for next start */
+  ags_recall_pool_refill_async(ags_recall_pool_get_instance());
+
   g_object_unref(audio);
   
   g_list_free_full(recall_id,
@@ -19,6 +19,8 @@
 
 #include <ags/audio/task/ags_start_sequencer.h>
 
+#include <ags/audio/ags_recall_pool.h>
+
 #include <ags/audio/thread/ags_audio_loop.h>
 #include <ags/audio/thread/ags_sequencer_thread.h>
 
@@ -212,6 +214,9 @@ ags_start_sequencer_launch(AgsTask *task)
     sequencer_thread = g_atomic_pointer_get(&(sequencer_thread->next));
   }
 
+  /* refill recall pool for next start */
+  ags_recall_pool_refill_async(ags_recall_pool_get_instance());
+
   /* unref */
   g_object_unref(audio_loop);
 }
@@ -0,0 +1,263 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/task/ags_update_notation_snapshot.h>
+
+#include <ags/i18n.h>
+
+void ags_update_notation_snapshot_class_init(AgsUpdateNotationSnapshotClass *update_notation_snapshot);
+void ags_update_notation_snapshot_init(AgsUpdateNotationSnapshot *update_notation_snapshot);
+void ags_update_notation_snapshot_set_property(GObject *gobject,
+					       guint prop_id,
+					       const GValue *value,
+					       GParamSpec *param_spec);
+void ags_update_notation_snapshot_get_property(GObject *gobject,
+					       guint prop_id,
+					       GValue *value,
+					       GParamSpec *param_spec);
+void ags_update_notation_snapshot_dispose(GObject *gobject);
+void ags_update_notation_snapshot_finalize(GObject *gobject);
+
+void ags_update_notation_snapshot_launch(AgsTask *task);
+
+/**
+ * SECTION:ags_update_notation_snapshot
+ * @short_description: update notation snapshot object
+ * @title: AgsUpdateNotationSnapshot
+ * @section_id:
+ * @include: ags/audio/task/ags_update_notation_snapshot.h
+ *
+ * The #AgsUpdateNotationSnapshot task rebuilds the #AgsNotationSnapshot of
+ * #AgsNotation edited by the audio thread.
+ */
+
+static gpointer ags_update_notation_snapshot_parent_class = NULL;
+
+enum{
+  PROP_0,
+  PROP_NOTATION,
+};
+
+GType
+ags_update_notation_snapshot_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_update_notation_snapshot = 0;
+
+    static const GTypeInfo ags_update_notation_snapshot_info = {
+      sizeof(AgsUpdateNotationSnapshotClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_update_notation_snapshot_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof(AgsUpdateNotationSnapshot),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_update_notation_snapshot_init,
+    };
+
+    ags_type_update_notation_snapshot = g_type_register_static(AGS_TYPE_TASK,
+							       "AgsUpdateNotationSnapshot",
+							       &ags_update_notation_snapshot_info,
+							       0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_update_notation_snapshot);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_update_notation_snapshot_class_init(AgsUpdateNotationSnapshotClass *update_notation_snapshot)
+{
+  GObjectClass *gobject;
+  AgsTaskClass *task;
+
+  GParamSpec *param_spec;
+
+  ags_update_notation_snapshot_parent_class = g_type_class_peek_parent(update_notation_snapshot);
+
+  /* gobject */
+  gobject = (GObjectClass *) update_notation_snapshot;
+
+  gobject->set_property = ags_update_notation_snapshot_set_property;
+  gobject->get_property = ags_update_notation_snapshot_get_property;
+
+  gobject->dispose = ags_update_notation_snapshot_dispose;
+  gobject->finalize = ags_update_notation_snapshot_finalize;
+
+  /* properties */
+  /**
+   * AgsUpdateNotationSnapshot:notation:
+   *
+   * The assigned #AgsNotation
+   * 
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_object("notation",
+				   i18n_pspec("notation of update notation snapshot"),
+				   i18n_pspec("The notation of update notation snapshot task"),
+				   AGS_TYPE_NOTATION,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_NOTATION,
+				  param_spec);
+
+  /* task */
+  task = (AgsTaskClass *) update_notation_snapshot;
+
+  task->launch = ags_update_notation_snapshot_launch;
+}
+
+void
+ags_update_notation_snapshot_init(AgsUpdateNotationSnapshot *update_notation_snapshot)
+{
+  update_notation_snapshot->notation = NULL;
+}
+
+void
+ags_update_notation_snapshot_set_property(GObject *gobject,
+					  guint prop_id,
+					  const GValue *value,
+					  GParamSpec *param_spec)
+{
+  AgsUpdateNotationSnapshot *update_notation_snapshot;
+
+  update_notation_snapshot = AGS_UPDATE_NOTATION_SNAPSHOT(gobject);
+
+  switch(prop_id){
+  case PROP_NOTATION:
+    {
+      AgsNotation *notation;
+
+      notation = (AgsNotation *) g_value_get_object(value);
+
+      if(update_notation_snapshot->notation == notation){
+	return;
+      }
+
+      if(update_notation_snapshot->notation != NULL){
+	g_object_unref(update_notation_snapshot->notation);
+      }
+
+      if(notation != NULL){
+	g_object_ref(notation);
+      }
+
+      update_notation_snapshot->notation = notation;
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_update_notation_snapshot_get_property(GObject *gobject,
+					  guint prop_id,
+					  GValue *value,
+					  GParamSpec *param_spec)
+{
+  AgsUpdateNotationSnapshot *update_notation_snapshot;
+
+  update_notation_snapshot = AGS_UPDATE_NOTATION_SNAPSHOT(gobject);
+
+  switch(prop_id){
+  case PROP_NOTATION:
+    {
+      g_value_set_object(value, update_notation_snapshot->notation);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_update_notation_snapshot_dispose(GObject *gobject)
+{
+  AgsUpdateNotationSnapshot *update_notation_snapshot;
+
+  update_notation_snapshot = AGS_UPDATE_NOTATION_SNAPSHOT(gobject);
+
+  if(update_notation_snapshot->notation != NULL){
+    g_object_unref(update_notation_snapshot->notation);
+
+    update_notation_snapshot->notation = NULL;
+  }
+  
+  /* call parent */
+  G_OBJECT_CLASS(ags_update_notation_snapshot_parent_class)->dispose(gobject);
+}
+
+void
+ags_update_notation_snapshot_finalize(GObject *gobject)
+{
+  AgsUpdateNotationSnapshot *update_notation_snapshot;
+
+  update_notation_snapshot = AGS_UPDATE_NOTATION_SNAPSHOT(gobject);
+
+  if(update_notation_snapshot->notation != NULL){
+    g_object_unref(update_notation_snapshot->notation);
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_update_notation_snapshot_parent_class)->finalize(gobject);
+}
+
+void
+ags_update_notation_snapshot_launch(AgsTask *task)
+{
+  AgsNotation *notation;
+  
+  AgsUpdateNotationSnapshot *update_notation_snapshot;
+
+  update_notation_snapshot = AGS_UPDATE_NOTATION_SNAPSHOT(task);
+
+  notation = update_notation_snapshot->notation;
+
+  /* update snapshot */
+  ags_notation_update_snapshot(notation);
+}
+
+/**
+ * ags_update_notation_snapshot_new:
+ * @notation: the #AgsNotation
+ *
+ * Create a new instance of #AgsUpdateNotationSnapshot.
+ *
+ * Returns: the new #AgsUpdateNotationSnapshot.
+ *
+ * Since: 3.5.0
+ */
+AgsUpdateNotationSnapshot*
+ags_update_notation_snapshot_new(AgsNotation *notation)
+{
+  AgsUpdateNotationSnapshot *update_notation_snapshot;
+
+  update_notation_snapshot = (AgsUpdateNotationSnapshot *) g_object_new(AGS_TYPE_UPDATE_NOTATION_SNAPSHOT,
+									"notation", notation,
+									NULL);
+
+  return(update_notation_snapshot);
+}
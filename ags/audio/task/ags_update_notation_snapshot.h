@@ -0,0 +1,60 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2019 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_UPDATE_NOTATION_SNAPSHOT_H__
+#define __AGS_UPDATE_NOTATION_SNAPSHOT_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+#include <ags/audio/ags_notation.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_UPDATE_NOTATION_SNAPSHOT                (ags_update_notation_snapshot_get_type())
+#define AGS_UPDATE_NOTATION_SNAPSHOT(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_UPDATE_NOTATION_SNAPSHOT, AgsUpdateNotationSnapshot))
+#define AGS_UPDATE_NOTATION_SNAPSHOT_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_UPDATE_NOTATION_SNAPSHOT, AgsUpdateNotationSnapshotClass))
+#define AGS_IS_UPDATE_NOTATION_SNAPSHOT(obj)             (G_TYPE_CHECK_INSTANCE_TYPE((obj), AGS_TYPE_UPDATE_NOTATION_SNAPSHOT))
+#define AGS_IS_UPDATE_NOTATION_SNAPSHOT_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE((class), AGS_TYPE_UPDATE_NOTATION_SNAPSHOT))
+#define AGS_UPDATE_NOTATION_SNAPSHOT_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS((obj), AGS_TYPE_UPDATE_NOTATION_SNAPSHOT, AgsUpdateNotationSnapshotClass))
+
+typedef struct _AgsUpdateNotationSnapshot AgsUpdateNotationSnapshot;
+typedef struct _AgsUpdateNotationSnapshotClass AgsUpdateNotationSnapshotClass;
+
+struct _AgsUpdateNotationSnapshot
+{
+  AgsTask task;
+
+  AgsNotation *notation;
+};
+
+struct _AgsUpdateNotationSnapshotClass
+{
+  AgsTaskClass task;
+};
+
+GType ags_update_notation_snapshot_get_type();
+
+AgsUpdateNotationSnapshot* ags_update_notation_snapshot_new(AgsNotation *notation);
+
+G_END_DECLS
+
+#endif /*__AGS_UPDATE_NOTATION_SNAPSHOT_H__*/
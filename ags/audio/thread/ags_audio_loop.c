@@ -23,6 +23,11 @@
 #include <ags/audio/ags_playback.h>
 #include <ags/audio/ags_audio.h>
 #include <ags/audio/ags_channel.h>
+#include <ags/audio/ags_meter_snapshot.h>
+#include <ags/audio/ags_sound_provider.h>
+#include <ags/audio/ags_recall.h>
+
+#include <ags/audio/osc/ags_osc_scheduler.h>
 
 #include <ags/audio/thread/ags_soundcard_thread.h>
 #include <ags/audio/thread/ags_sequencer_thread.h>
@@ -87,6 +92,7 @@ enum{
   PROP_0,
   PROP_PLAY_CHANNEL,
   PROP_PLAY_AUDIO,
+  PROP_DEFAULT_SOUNDCARD,
 };
 
 static gpointer ags_audio_loop_parent_class = NULL;
@@ -192,6 +198,23 @@ ags_audio_loop_class_init(AgsAudioLoopClass *audio_loop)
 				  PROP_PLAY_AUDIO,
 				  param_spec);
 
+  /**
+   * AgsAudioLoop:default-soundcard:
+   *
+   * The default soundcard clocking the loop, fetched from the sound provider
+   * on first run and kept until replaced.
+   * 
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_object("default-soundcard",
+				   i18n_pspec("default soundcard"),
+				   i18n_pspec("The default soundcard"),
+				   G_TYPE_OBJECT,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_DEFAULT_SOUNDCARD,
+				  param_spec);
+
   /* AgsThread */
   thread = (AgsThreadClass *) audio_loop;
   
@@ -232,6 +255,8 @@ ags_audio_loop_init(AgsAudioLoop *audio_loop)
 
   AgsConfig *config;
 
+  gchar *str;
+  
   gdouble frequency;
   guint samplerate;
   guint buffer_size;
@@ -271,6 +296,8 @@ ags_audio_loop_init(AgsAudioLoop *audio_loop)
 
   audio_loop->sync_thread = NULL;
 
+  audio_loop->default_soundcard = NULL;
+  
   /* staging program */
   audio_loop->do_fx_staging = FALSE;
 
@@ -283,6 +310,49 @@ ags_audio_loop_init(AgsAudioLoop *audio_loop)
   audio_loop->staging_program[2] = (AGS_SOUND_STAGING_RUN_POST);
 
   audio_loop->staging_program_count = 3;
+
+  /* deadline */
+  audio_loop->period_time = 0;
+  audio_loop->period_end = 0;
+
+  audio_loop->slack = 0;
+  audio_loop->min_slack = G_MAXINT64;
+
+  audio_loop->tic_count = 0;
+  audio_loop->late_tic_count = 0;
+
+  audio_loop->negative_slack_tics = 0;
+  audio_loop->positive_slack_tics = 0;
+
+  audio_loop->degrade_tics = AGS_AUDIO_LOOP_DEFAULT_DEGRADE_TICS;
+  audio_loop->recover_tics = AGS_AUDIO_LOOP_DEFAULT_RECOVER_TICS;
+
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_THREAD,
+			     "degrade-non-essential");
+
+  if(str != NULL &&
+     !g_ascii_strncasecmp(str,
+			  "true",
+			  5)){
+    audio_loop->flags |= AGS_AUDIO_LOOP_DEGRADE;
+  }
+
+  g_free(str);
+
+  /* synchronize the tree by tic barrier */
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_THREAD,
+			     "tic-barrier");
+
+  if(str != NULL &&
+     !g_ascii_strncasecmp(str,
+			  "true",
+			  5)){
+    ags_thread_set_flags(thread, AGS_THREAD_TIC_BARRIER);
+  }
+
+  g_free(str);
 }
 
 void
@@ -339,6 +409,33 @@ ags_audio_loop_set_property(GObject *gobject,
       g_rec_mutex_unlock(thread_mutex);
     }
     break;
+  case PROP_DEFAULT_SOUNDCARD:
+    {
+      GObject *default_soundcard;
+
+      default_soundcard = (GObject *) g_value_get_object(value);
+
+      g_rec_mutex_lock(thread_mutex);
+
+      if(audio_loop->default_soundcard == default_soundcard){
+	g_rec_mutex_unlock(thread_mutex);
+
+	return;
+      }
+
+      if(audio_loop->default_soundcard != NULL){
+	g_object_unref(audio_loop->default_soundcard);
+      }
+
+      if(default_soundcard != NULL){
+	g_object_ref(default_soundcard);
+      }
+
+      audio_loop->default_soundcard = default_soundcard;
+
+      g_rec_mutex_unlock(thread_mutex);
+    }
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
     break;
@@ -383,6 +480,15 @@ ags_audio_loop_get_property(GObject *gobject,
       g_rec_mutex_unlock(thread_mutex);
     }
     break;
+  case PROP_DEFAULT_SOUNDCARD:
+    {
+      g_rec_mutex_lock(thread_mutex);
+
+      g_value_set_object(value, audio_loop->default_soundcard);
+
+      g_rec_mutex_unlock(thread_mutex);
+    }
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
     break;
@@ -410,6 +516,13 @@ ags_audio_loop_dispose(GObject *gobject)
     
     audio_loop->play_audio = NULL;
   }
+
+  /* default soundcard */
+  if(audio_loop->default_soundcard != NULL){
+    g_object_unref(audio_loop->default_soundcard);
+
+    audio_loop->default_soundcard = NULL;
+  }
   
   /* call parent */
   G_OBJECT_CLASS(ags_audio_loop_parent_class)->dispose(gobject);
@@ -429,6 +542,10 @@ ags_audio_loop_finalize(GObject *gobject)
   g_list_free_full(audio_loop->play_audio,
 		   g_object_unref);
 
+  if(audio_loop->default_soundcard != NULL){
+    g_object_unref(audio_loop->default_soundcard);
+  }
+
   /* call parent */
   G_OBJECT_CLASS(ags_audio_loop_parent_class)->finalize(gobject);
 }
@@ -658,9 +775,16 @@ ags_audio_loop_run(AgsThread *thread)
 {
   AgsAudioLoop *audio_loop;
 
+  AgsApplicationContext *application_context;
+
+  GObject *default_soundcard;
+
   GList *start_queue;
   
+  gint64 start_time;
   guint play_audio_ref, play_channel_ref;
+  guint samplerate, buffer_size;
+  gboolean has_deadline;
   
   GRecMutex *thread_mutex;
 
@@ -668,6 +792,8 @@ ags_audio_loop_run(AgsThread *thread)
   
   audio_loop = AGS_AUDIO_LOOP(thread);
 
+  start_time = ags_timing_monitor_get_time();
+
   thread_mutex = AGS_THREAD_GET_OBJ_MUTEX(thread);
   
   /* real-time setup */
@@ -716,8 +842,50 @@ ags_audio_loop_run(AgsThread *thread)
 
   play_audio_ref = audio_loop->play_audio_ref;
   play_channel_ref = audio_loop->play_channel_ref;
+
+  default_soundcard = audio_loop->default_soundcard;
+
+  if(default_soundcard != NULL){
+    g_object_ref(default_soundcard);
+  }
   
   g_rec_mutex_unlock(thread_mutex);
+
+  /* cache default soundcard - replaced by AgsApplySoundConfig */
+  if(default_soundcard == NULL){
+    application_context = ags_application_context_get_instance();
+  
+    default_soundcard = ags_sound_provider_get_default_soundcard(AGS_SOUND_PROVIDER(application_context));
+
+    if(default_soundcard != NULL){
+      g_object_set(audio_loop,
+		   "default-soundcard", default_soundcard,
+		   NULL);
+    }
+  }
+  
+  /* apply scheduled OSC port writes */
+  has_deadline = FALSE;
+  
+  if(default_soundcard != NULL){
+    ags_soundcard_get_presets(AGS_SOUNDCARD(default_soundcard),
+			      NULL,
+			      &samplerate,
+			      &buffer_size,
+			      NULL);
+
+    /* deadline of this period */
+    ags_audio_loop_begin_period(audio_loop,
+				start_time,
+				samplerate, buffer_size);
+
+    has_deadline = TRUE;
+    
+    ags_osc_scheduler_drain(ags_osc_scheduler_get_instance(),
+			    samplerate, buffer_size);
+
+    g_object_unref(default_soundcard);
+  }
   
   /* play channel */
   if(ags_audio_loop_test_flags(audio_loop, AGS_AUDIO_LOOP_PLAY_CHANNEL)){
@@ -739,6 +907,15 @@ ags_audio_loop_run(AgsThread *thread)
     }
   }
 
+  /* publish meter snapshot */
+  ags_meter_snapshot_publish(ags_meter_snapshot_get_instance());
+
+  /* measure slack */
+  if(has_deadline){
+    ags_audio_loop_end_period(audio_loop,
+			      ags_timing_monitor_get_time());
+  }
+
   /* decide if we stop */
   if(play_channel_ref == 0 &&
      play_audio_ref == 0){
@@ -1757,6 +1934,267 @@ ags_audio_loop_set_staging_program(AgsAudioLoop *audio_loop,
   g_rec_mutex_unlock(thread_mutex);
 }
 
+/**
+ * ags_audio_loop_begin_period:
+ * @audio_loop: the #AgsAudioLoop
+ * @start_time: the monotonic time in nanoseconds the tic started
+ * @samplerate: the samplerate of the default soundcard
+ * @buffer_size: the buffer size of the default soundcard
+ *
+ * Begin a period and advance the expected period end by the period length of
+ * the device. The period end is resynced to @start_time if the loop fell more
+ * than one period behind or ran more than two periods ahead.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_audio_loop_begin_period(AgsAudioLoop *audio_loop,
+			    gint64 start_time,
+			    guint samplerate, guint buffer_size)
+{
+  gint64 period_time;
+  
+  GRecMutex *audio_loop_mutex;
+
+  if(!AGS_IS_AUDIO_LOOP(audio_loop) ||
+     samplerate == 0){
+    return;
+  }
+
+  period_time = ((gint64) buffer_size * AGS_TIMING_MONITOR_NSEC_PER_SEC) / (gint64) samplerate;
+  
+  /* get audio loop mutex */
+  audio_loop_mutex = AGS_THREAD_GET_OBJ_MUTEX(audio_loop);
+
+  /* advance period end */
+  g_rec_mutex_lock(audio_loop_mutex);
+
+  if(audio_loop->period_end == 0 ||
+     audio_loop->period_time != period_time ||
+     start_time > audio_loop->period_end + period_time ||
+     start_time + (2 * period_time) < audio_loop->period_end){
+    audio_loop->period_end = start_time + period_time;
+  }else{
+    audio_loop->period_end += period_time;
+  }
+
+  audio_loop->period_time = period_time;
+  
+  g_rec_mutex_unlock(audio_loop_mutex);
+}
+
+/**
+ * ags_audio_loop_end_period:
+ * @audio_loop: the #AgsAudioLoop
+ * @end_time: the monotonic time in nanoseconds the tic's work was done
+ *
+ * End the period and account the slack to the expected period end. If
+ * %AGS_AUDIO_LOOP_DEGRADE is set, non-essential recalls are bypassed after
+ * the slack stayed negative for the degrade tics, and enabled again after
+ * half a period of headroom was kept for the recover tics.
+ *
+ * Returns: the slack in nanoseconds, negative if the tic was late
+ *
+ * Since: 3.5.0
+ */
+gint64
+ags_audio_loop_end_period(AgsAudioLoop *audio_loop,
+			  gint64 end_time)
+{
+  gint64 slack;
+  gboolean do_degrade, is_degraded;
+  
+  GRecMutex *audio_loop_mutex;
+
+  if(!AGS_IS_AUDIO_LOOP(audio_loop)){
+    return(0);
+  }
+  
+  /* get audio loop mutex */
+  audio_loop_mutex = AGS_THREAD_GET_OBJ_MUTEX(audio_loop);
+
+  /* account slack */
+  g_rec_mutex_lock(audio_loop_mutex);
+
+  if(audio_loop->period_end == 0){
+    g_rec_mutex_unlock(audio_loop_mutex);
+
+    return(0);
+  }
+  
+  slack = audio_loop->period_end - end_time;
+
+  audio_loop->slack = slack;
+
+  if(slack < audio_loop->min_slack){
+    audio_loop->min_slack = slack;
+  }
+  
+  audio_loop->tic_count += 1;
+
+  if(slack < 0){
+    audio_loop->late_tic_count += 1;
+
+    audio_loop->negative_slack_tics += 1;
+    audio_loop->positive_slack_tics = 0;
+  }else if(slack > audio_loop->period_time / 2){
+    audio_loop->negative_slack_tics = 0;
+    audio_loop->positive_slack_tics += 1;
+  }else{
+    audio_loop->negative_slack_tics = 0;
+    audio_loop->positive_slack_tics = 0;
+  }
+
+  /* degrade policy */
+  do_degrade = ((AGS_AUDIO_LOOP_DEGRADE & (audio_loop->flags)) != 0) ? TRUE: FALSE;
+  is_degraded = ((AGS_AUDIO_LOOP_DEGRADED & (audio_loop->flags)) != 0) ? TRUE: FALSE;
+
+  if(do_degrade &&
+     !is_degraded &&
+     audio_loop->negative_slack_tics >= audio_loop->degrade_tics){
+    audio_loop->flags |= AGS_AUDIO_LOOP_DEGRADED;
+
+    ags_recall_global_set_degraded(TRUE);
+  }else if(is_degraded &&
+	   (!do_degrade ||
+	    audio_loop->positive_slack_tics >= audio_loop->recover_tics)){
+    audio_loop->flags &= (~AGS_AUDIO_LOOP_DEGRADED);
+
+    ags_recall_global_set_degraded(FALSE);
+  }
+  
+  g_rec_mutex_unlock(audio_loop_mutex);
+
+  return(slack);
+}
+
+/**
+ * ags_audio_loop_get_deadline:
+ * @audio_loop: the #AgsAudioLoop
+ * @tic_count: (out) (optional): return location of the count of measured tics
+ * @late_tic_count: (out) (optional): return location of the count of late tics
+ * @xrun_count: (out) (optional): return location of the xrun count of all soundcard threads
+ * @slack: (out) (optional): return location of the slack of the last tic in nanoseconds
+ * @min_slack: (out) (optional): return location of the minimum slack in nanoseconds
+ *
+ * Get the deadline accounting of @audio_loop.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_audio_loop_get_deadline(AgsAudioLoop *audio_loop,
+			    guint *tic_count,
+			    guint *late_tic_count,
+			    guint *xrun_count,
+			    gint64 *slack,
+			    gint64 *min_slack)
+{
+  AgsThread *soundcard_thread, *next_soundcard_thread;
+  
+  GRecMutex *audio_loop_mutex;
+
+  if(!AGS_IS_AUDIO_LOOP(audio_loop)){
+    return;
+  }
+  
+  /* get audio loop mutex */
+  audio_loop_mutex = AGS_THREAD_GET_OBJ_MUTEX(audio_loop);
+
+  /* get deadline */
+  g_rec_mutex_lock(audio_loop_mutex);
+
+  if(tic_count != NULL){
+    tic_count[0] = audio_loop->tic_count;
+  }
+
+  if(late_tic_count != NULL){
+    late_tic_count[0] = audio_loop->late_tic_count;
+  }
+
+  if(slack != NULL){
+    slack[0] = audio_loop->slack;
+  }
+
+  if(min_slack != NULL){
+    min_slack[0] = (audio_loop->tic_count != 0) ? audio_loop->min_slack: 0;
+  }
+  
+  g_rec_mutex_unlock(audio_loop_mutex);
+
+  /* xrun count */
+  if(xrun_count != NULL){
+    xrun_count[0] = 0;
+    
+    soundcard_thread = ags_thread_find_type((AgsThread *) audio_loop,
+					    AGS_TYPE_SOUNDCARD_THREAD);
+
+    while(soundcard_thread != NULL){
+      if(AGS_IS_SOUNDCARD_THREAD(soundcard_thread)){
+	xrun_count[0] += ags_soundcard_thread_get_xrun_count((AgsSoundcardThread *) soundcard_thread);
+      }
+
+      /* iterate */
+      next_soundcard_thread = ags_thread_next(soundcard_thread);
+
+      g_object_unref(soundcard_thread);
+
+      soundcard_thread = next_soundcard_thread;
+    }
+  }
+}
+
+/**
+ * ags_audio_loop_reset_deadline:
+ * @audio_loop: the #AgsAudioLoop
+ *
+ * Reset the deadline accounting of @audio_loop and the xrun count of
+ * all soundcard threads.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_audio_loop_reset_deadline(AgsAudioLoop *audio_loop)
+{
+  AgsThread *soundcard_thread, *next_soundcard_thread;
+  
+  GRecMutex *audio_loop_mutex;
+
+  if(!AGS_IS_AUDIO_LOOP(audio_loop)){
+    return;
+  }
+  
+  /* get audio loop mutex */
+  audio_loop_mutex = AGS_THREAD_GET_OBJ_MUTEX(audio_loop);
+
+  /* reset deadline */
+  g_rec_mutex_lock(audio_loop_mutex);
+
+  audio_loop->slack = 0;
+  audio_loop->min_slack = G_MAXINT64;
+
+  audio_loop->tic_count = 0;
+  audio_loop->late_tic_count = 0;
+  
+  g_rec_mutex_unlock(audio_loop_mutex);
+
+  /* reset xrun count */
+  soundcard_thread = ags_thread_find_type((AgsThread *) audio_loop,
+					  AGS_TYPE_SOUNDCARD_THREAD);
+
+  while(soundcard_thread != NULL){
+    if(AGS_IS_SOUNDCARD_THREAD(soundcard_thread)){
+      ags_soundcard_thread_reset_xrun_count((AgsSoundcardThread *) soundcard_thread);
+    }
+
+    /* iterate */
+    next_soundcard_thread = ags_thread_next(soundcard_thread);
+
+    g_object_unref(soundcard_thread);
+
+    soundcard_thread = next_soundcard_thread;
+  }
+}
+
 /**
  * ags_audio_loop_new:
  *
@@ -40,6 +40,9 @@ G_BEGIN_DECLS
 
 #define AGS_AUDIO_LOOP_DEFAULT_JIFFIE (ceil(AGS_SOUNDCARD_DEFAULT_SAMPLERATE / AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE) + AGS_SOUNDCARD_DEFAULT_OVERCLOCK)
 
+#define AGS_AUDIO_LOOP_DEFAULT_DEGRADE_TICS (4)
+#define AGS_AUDIO_LOOP_DEFAULT_RECOVER_TICS (256)
+
 typedef struct _AgsAudioLoop AgsAudioLoop;
 typedef struct _AgsAudioLoopClass AgsAudioLoopClass;
 
@@ -51,6 +54,8 @@ typedef struct _AgsAudioLoopClass AgsAudioLoopClass;
  * @AGS_AUDIO_LOOP_PLAY_AUDIO: play audio
  * @AGS_AUDIO_LOOP_PLAYING_AUDIO: playing audio
  * @AGS_AUDIO_LOOP_PLAY_AUDIO_TERMINATING: play audio terminating
+ * @AGS_AUDIO_LOOP_DEGRADE: bypass non-essential recalls while the slack stays negative
+ * @AGS_AUDIO_LOOP_DEGRADED: non-essential recalls are currently bypassed
  * 
  * Enum values to control the behavior or indicate internal state of #AgsAudioLoop by
  * enable/disable as flags.
@@ -62,6 +67,8 @@ typedef enum{
   AGS_AUDIO_LOOP_PLAY_AUDIO                     = 1 << 3,
   AGS_AUDIO_LOOP_PLAYING_AUDIO                  = 1 << 4,
   AGS_AUDIO_LOOP_PLAY_AUDIO_TERMINATING         = 1 << 5,
+  AGS_AUDIO_LOOP_DEGRADE                        = 1 << 6,
+  AGS_AUDIO_LOOP_DEGRADED                       = 1 << 7,
 }AgsAudioLoopFlags;
 
 struct _AgsAudioLoop
@@ -85,10 +92,27 @@ struct _AgsAudioLoop
 
   GList *sync_thread;
 
+  GObject *default_soundcard;
+
   gboolean do_fx_staging;
   
   guint *staging_program;
   guint staging_program_count;
+
+  gint64 period_time;
+  gint64 period_end;
+
+  gint64 slack;
+  gint64 min_slack;
+
+  guint tic_count;
+  guint late_tic_count;
+
+  guint negative_slack_tics;
+  guint positive_slack_tics;
+
+  guint degrade_tics;
+  guint recover_tics;
 };
 
 struct _AgsAudioLoopClass
@@ -120,6 +144,21 @@ void ags_audio_loop_set_staging_program(AgsAudioLoop *audio_loop,
 					guint *staging_program,
 					guint staging_program_count);
 
+/* deadline */
+void ags_audio_loop_begin_period(AgsAudioLoop *audio_loop,
+				 gint64 start_time,
+				 guint samplerate, guint buffer_size);
+gint64 ags_audio_loop_end_period(AgsAudioLoop *audio_loop,
+				 gint64 end_time);
+
+void ags_audio_loop_get_deadline(AgsAudioLoop *audio_loop,
+				 guint *tic_count,
+				 guint *late_tic_count,
+				 guint *xrun_count,
+				 gint64 *slack,
+				 gint64 *min_slack);
+void ags_audio_loop_reset_deadline(AgsAudioLoop *audio_loop);
+
 /* instantiate */
 AgsAudioLoop* ags_audio_loop_new();
 
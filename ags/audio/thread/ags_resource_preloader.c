@@ -0,0 +1,1216 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/thread/ags_resource_preloader.h>
+
+#include <ags/audio/file/ags_audio_container.h>
+#include <ags/audio/file/ags_audio_container_manager.h>
+#include <ags/audio/file/ags_audio_file.h>
+#include <ags/audio/file/ags_audio_file_manager.h>
+
+#include <glib/gstdio.h>
+
+#if defined(AGS_W32API)
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include <ags/i18n.h>
+
+void ags_resource_preloader_class_init(AgsResourcePreloaderClass *resource_preloader);
+void ags_resource_preloader_init(AgsResourcePreloader *resource_preloader);
+void ags_resource_preloader_set_property(GObject *gobject,
+					 guint prop_id,
+					 const GValue *value,
+					 GParamSpec *param_spec);
+void ags_resource_preloader_get_property(GObject *gobject,
+					 guint prop_id,
+					 GValue *value,
+					 GParamSpec *param_spec);
+void ags_resource_preloader_dispose(GObject *gobject);
+void ags_resource_preloader_finalize(GObject *gobject);
+
+gint ags_resource_preloader_job_sort_func(gconstpointer a,
+					  gconstpointer b);
+AgsResourcePreloaderJob* ags_resource_preloader_next_job(AgsResourcePreloader *resource_preloader);
+
+void ags_resource_preloader_load_audio_container(AgsResourcePreloader *resource_preloader,
+						 AgsResourcePreloaderJob *job);
+void ags_resource_preloader_load_audio_file(AgsResourcePreloader *resource_preloader,
+					    AgsResourcePreloaderJob *job);
+void ags_resource_preloader_load_plugin(AgsResourcePreloader *resource_preloader,
+					AgsResourcePreloaderJob *job);
+
+void* ags_resource_preloader_worker_thread(void *ptr);
+
+/**
+ * SECTION:ags_resource_preloader
+ * @short_description: load project resources in parallel
+ * @title: AgsResourcePreloader
+ * @section_id:
+ * @include: ags/audio/thread/ags_resource_preloader.h
+ *
+ * The #AgsResourcePreloader loads the audio containers, audio files and
+ * plugin shared objects referenced by a project on a bounded set of worker
+ * threads. Jobs are taken largest file first, with at most
+ * #AgsResourcePreloader:max-device-jobs jobs reading the same device at a
+ * time.
+ *
+ * Audio containers are added to #AgsAudioContainerManager, audio files to
+ * #AgsAudioFileManager, so the regular loaders find them ready. A loader
+ * started while the preloader runs calls ags_resource_preloader_wait_audio_container()
+ * to take over the pending audio container instead of opening it again.
+ */
+
+enum{
+  PROP_0,
+  PROP_OUTPUT_SOUNDCARD,
+  PROP_MAX_THREADS,
+  PROP_MAX_DEVICE_JOBS,
+};
+
+static gpointer ags_resource_preloader_parent_class = NULL;
+
+static GList *ags_resource_preloader_running = NULL;
+static GMutex ags_resource_preloader_running_mutex;
+
+GType
+ags_resource_preloader_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_resource_preloader = 0;
+
+    static const GTypeInfo ags_resource_preloader_info = {
+      sizeof(AgsResourcePreloaderClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_resource_preloader_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof(AgsResourcePreloader),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_resource_preloader_init,
+    };
+
+    ags_type_resource_preloader = g_type_register_static(G_TYPE_OBJECT,
+							 "AgsResourcePreloader",
+							 &ags_resource_preloader_info,
+							 0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_resource_preloader);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_resource_preloader_class_init(AgsResourcePreloaderClass *resource_preloader)
+{
+  GObjectClass *gobject;
+
+  GParamSpec *param_spec;
+
+  ags_resource_preloader_parent_class = g_type_class_peek_parent(resource_preloader);
+
+  /* GObject */
+  gobject = (GObjectClass *) resource_preloader;
+
+  gobject->set_property = ags_resource_preloader_set_property;
+  gobject->get_property = ags_resource_preloader_get_property;
+
+  gobject->dispose = ags_resource_preloader_dispose;
+  gobject->finalize = ags_resource_preloader_finalize;
+
+  /* properties */
+  /**
+   * AgsResourcePreloader:output-soundcard:
+   *
+   * The output soundcard the audio signals are read for.
+   *
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_object("output-soundcard",
+				   i18n_pspec("output soundcard"),
+				   i18n_pspec("The output soundcard"),
+				   G_TYPE_OBJECT,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_OUTPUT_SOUNDCARD,
+				  param_spec);
+
+  /**
+   * AgsResourcePreloader:max-threads:
+   *
+   * The maximum count of worker threads.
+   *
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_uint("max-threads",
+				 i18n_pspec("max threads"),
+				 i18n_pspec("The maximum count of worker threads"),
+				 1,
+				 G_MAXUINT32,
+				 AGS_RESOURCE_PRELOADER_DEFAULT_MAX_THREADS,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_MAX_THREADS,
+				  param_spec);
+
+  /**
+   * AgsResourcePreloader:max-device-jobs:
+   *
+   * The maximum count of jobs reading the same device concurrently.
+   *
+   * Since: 3.5.0
+   */
+  param_spec = g_param_spec_uint("max-device-jobs",
+				 i18n_pspec("max device jobs"),
+				 i18n_pspec("The maximum count of jobs per device"),
+				 1,
+				 G_MAXUINT32,
+				 AGS_RESOURCE_PRELOADER_DEFAULT_MAX_DEVICE_JOBS,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_MAX_DEVICE_JOBS,
+				  param_spec);
+}
+
+void
+ags_resource_preloader_init(AgsResourcePreloader *resource_preloader)
+{
+  resource_preloader->flags = 0;
+
+  g_rec_mutex_init(&(resource_preloader->obj_mutex));
+
+  resource_preloader->output_soundcard = NULL;
+
+  resource_preloader->max_threads = AGS_RESOURCE_PRELOADER_DEFAULT_MAX_THREADS;
+  resource_preloader->max_device_jobs = AGS_RESOURCE_PRELOADER_DEFAULT_MAX_DEVICE_JOBS;
+
+  resource_preloader->job = NULL;
+  resource_preloader->job_filename = g_hash_table_new_full(g_str_hash,
+							   g_str_equal,
+							   g_free,
+							   NULL);
+
+  resource_preloader->n_pending = 0;
+
+  resource_preloader->n_threads = 0;
+  resource_preloader->worker_thread = NULL;
+
+  g_mutex_init(&(resource_preloader->worker_mutex));
+  g_cond_init(&(resource_preloader->worker_cond));
+}
+
+void
+ags_resource_preloader_set_property(GObject *gobject,
+				    guint prop_id,
+				    const GValue *value,
+				    GParamSpec *param_spec)
+{
+  AgsResourcePreloader *resource_preloader;
+
+  GRecMutex *resource_preloader_mutex;
+
+  resource_preloader = AGS_RESOURCE_PRELOADER(gobject);
+
+  /* get resource preloader mutex */
+  resource_preloader_mutex = AGS_RESOURCE_PRELOADER_GET_OBJ_MUTEX(resource_preloader);
+
+  switch(prop_id){
+  case PROP_OUTPUT_SOUNDCARD:
+    {
+      GObject *output_soundcard;
+
+      output_soundcard = (GObject *) g_value_get_object(value);
+
+      g_rec_mutex_lock(resource_preloader_mutex);
+
+      if(resource_preloader->output_soundcard == output_soundcard){
+	g_rec_mutex_unlock(resource_preloader_mutex);
+
+	return;
+      }
+
+      if(resource_preloader->output_soundcard != NULL){
+	g_object_unref(resource_preloader->output_soundcard);
+      }
+
+      if(output_soundcard != NULL){
+	g_object_ref(output_soundcard);
+      }
+
+      resource_preloader->output_soundcard = output_soundcard;
+
+      g_rec_mutex_unlock(resource_preloader_mutex);
+    }
+    break;
+  case PROP_MAX_THREADS:
+    {
+      g_rec_mutex_lock(resource_preloader_mutex);
+
+      resource_preloader->max_threads = g_value_get_uint(value);
+
+      g_rec_mutex_unlock(resource_preloader_mutex);
+    }
+    break;
+  case PROP_MAX_DEVICE_JOBS:
+    {
+      g_rec_mutex_lock(resource_preloader_mutex);
+
+      resource_preloader->max_device_jobs = g_value_get_uint(value);
+
+      g_rec_mutex_unlock(resource_preloader_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_resource_preloader_get_property(GObject *gobject,
+				    guint prop_id,
+				    GValue *value,
+				    GParamSpec *param_spec)
+{
+  AgsResourcePreloader *resource_preloader;
+
+  GRecMutex *resource_preloader_mutex;
+
+  resource_preloader = AGS_RESOURCE_PRELOADER(gobject);
+
+  /* get resource preloader mutex */
+  resource_preloader_mutex = AGS_RESOURCE_PRELOADER_GET_OBJ_MUTEX(resource_preloader);
+
+  switch(prop_id){
+  case PROP_OUTPUT_SOUNDCARD:
+    {
+      g_rec_mutex_lock(resource_preloader_mutex);
+
+      g_value_set_object(value, resource_preloader->output_soundcard);
+
+      g_rec_mutex_unlock(resource_preloader_mutex);
+    }
+    break;
+  case PROP_MAX_THREADS:
+    {
+      g_rec_mutex_lock(resource_preloader_mutex);
+
+      g_value_set_uint(value, resource_preloader->max_threads);
+
+      g_rec_mutex_unlock(resource_preloader_mutex);
+    }
+    break;
+  case PROP_MAX_DEVICE_JOBS:
+    {
+      g_rec_mutex_lock(resource_preloader_mutex);
+
+      g_value_set_uint(value, resource_preloader->max_device_jobs);
+
+      g_rec_mutex_unlock(resource_preloader_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_resource_preloader_dispose(GObject *gobject)
+{
+  AgsResourcePreloader *resource_preloader;
+
+  resource_preloader = AGS_RESOURCE_PRELOADER(gobject);
+
+  ags_resource_preloader_join(resource_preloader);
+
+  if(resource_preloader->output_soundcard != NULL){
+    g_object_unref(resource_preloader->output_soundcard);
+
+    resource_preloader->output_soundcard = NULL;
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_resource_preloader_parent_class)->dispose(gobject);
+}
+
+void
+ags_resource_preloader_finalize(GObject *gobject)
+{
+  AgsResourcePreloader *resource_preloader;
+
+  resource_preloader = AGS_RESOURCE_PRELOADER(gobject);
+
+  ags_resource_preloader_release(resource_preloader);
+
+  g_hash_table_destroy(resource_preloader->job_filename);
+
+  g_mutex_clear(&(resource_preloader->worker_mutex));
+  g_cond_clear(&(resource_preloader->worker_cond));
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_resource_preloader_parent_class)->finalize(gobject);
+}
+
+/**
+ * ags_resource_preloader_job_alloc:
+ * @resource: the #AgsResourcePreloaderResource
+ * @filename: the filename
+ *
+ * Allocate #AgsResourcePreloaderJob.
+ *
+ * Returns: (type gpointer) (transfer full): the newly allocated #AgsResourcePreloaderJob
+ *
+ * Since: 3.5.0
+ */
+AgsResourcePreloaderJob*
+ags_resource_preloader_job_alloc(guint resource,
+				 gchar *filename)
+{
+  AgsResourcePreloaderJob *job;
+
+  job = (AgsResourcePreloaderJob *) g_malloc(sizeof(AgsResourcePreloaderJob));
+
+  job->resource = resource;
+
+  job->filename = g_strdup(filename);
+
+  job->device = 0;
+  job->size = 0;
+
+  job->running = FALSE;
+  job->completed = FALSE;
+
+  job->gobject = NULL;
+  job->plugin_so = NULL;
+
+  job->audio_signal = NULL;
+
+  return(job);
+}
+
+/**
+ * ags_resource_preloader_job_free:
+ * @job: (type gpointer) (transfer full): the #AgsResourcePreloaderJob
+ *
+ * Free @job, the audio signals not taken are unreferenced.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_resource_preloader_job_free(AgsResourcePreloaderJob *job)
+{
+  GList *list;
+
+  if(job == NULL){
+    return;
+  }
+
+  list = job->audio_signal;
+
+  while(list != NULL){
+    if(list->data != NULL){
+      g_object_unref(list->data);
+    }
+
+    list = list->next;
+  }
+
+  g_list_free(job->audio_signal);
+
+  if(job->gobject != NULL){
+    g_object_unref(job->gobject);
+  }
+
+  /* the plugin keeps its own reference, if instantiated */
+  if(job->plugin_so != NULL){
+#if defined(AGS_W32API)
+    FreeLibrary(job->plugin_so);
+#else
+    dlclose(job->plugin_so);
+#endif
+  }
+
+  g_free(job->filename);
+
+  g_free(job);
+}
+
+/**
+ * ags_resource_preloader_test_flags:
+ * @resource_preloader: the #AgsResourcePreloader
+ * @flags: the flags
+ *
+ * Test @flags to be set on @resource_preloader.
+ *
+ * Returns: %TRUE if flags are set, else %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_resource_preloader_test_flags(AgsResourcePreloader *resource_preloader, guint flags)
+{
+  if(!AGS_IS_RESOURCE_PRELOADER(resource_preloader)){
+    return(FALSE);
+  }
+
+  return(((flags & (g_atomic_int_get(&(resource_preloader->flags)))) != 0) ? TRUE: FALSE);
+}
+
+/**
+ * ags_resource_preloader_set_flags:
+ * @resource_preloader: the #AgsResourcePreloader
+ * @flags: the flags
+ *
+ * Set flags.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_resource_preloader_set_flags(AgsResourcePreloader *resource_preloader, guint flags)
+{
+  if(!AGS_IS_RESOURCE_PRELOADER(resource_preloader)){
+    return;
+  }
+
+  g_atomic_int_or(&(resource_preloader->flags),
+		  flags);
+}
+
+/**
+ * ags_resource_preloader_unset_flags:
+ * @resource_preloader: the #AgsResourcePreloader
+ * @flags: the flags
+ *
+ * Unset flags.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_resource_preloader_unset_flags(AgsResourcePreloader *resource_preloader, guint flags)
+{
+  if(!AGS_IS_RESOURCE_PRELOADER(resource_preloader)){
+    return;
+  }
+
+  g_atomic_int_and(&(resource_preloader->flags),
+		   (~flags));
+}
+
+gint
+ags_resource_preloader_job_sort_func(gconstpointer a,
+				     gconstpointer b)
+{
+  /* largest first */
+  if(AGS_RESOURCE_PRELOADER_JOB(a)->size > AGS_RESOURCE_PRELOADER_JOB(b)->size){
+    return(-1);
+  }else if(AGS_RESOURCE_PRELOADER_JOB(a)->size < AGS_RESOURCE_PRELOADER_JOB(b)->size){
+    return(1);
+  }
+
+  return(0);
+}
+
+/**
+ * ags_resource_preloader_add:
+ * @resource_preloader: the #AgsResourcePreloader
+ * @resource: the #AgsResourcePreloaderResource
+ * @filename: the filename
+ *
+ * Add a job loading @filename as @resource, unless already added. Jobs
+ * can only be added before ags_resource_preloader_start().
+ *
+ * Returns: %TRUE if a job was added, else %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_resource_preloader_add(AgsResourcePreloader *resource_preloader,
+			   guint resource,
+			   gchar *filename)
+{
+  AgsResourcePreloaderJob *job;
+
+  GStatBuf stat_buf;
+
+  gchar *key;
+
+  GRecMutex *resource_preloader_mutex;
+
+  if(!AGS_IS_RESOURCE_PRELOADER(resource_preloader) ||
+     filename == NULL){
+    return(FALSE);
+  }
+
+  if(g_stat(filename, &stat_buf) != 0){
+    return(FALSE);
+  }
+
+  /* get resource preloader mutex */
+  resource_preloader_mutex = AGS_RESOURCE_PRELOADER_GET_OBJ_MUTEX(resource_preloader);
+
+  key = g_strdup_printf("%u %s", resource, filename);
+
+  g_rec_mutex_lock(resource_preloader_mutex);
+
+  if(ags_resource_preloader_test_flags(resource_preloader, AGS_RESOURCE_PRELOADER_RUNNING) ||
+     g_hash_table_contains(resource_preloader->job_filename,
+			   key)){
+    g_rec_mutex_unlock(resource_preloader_mutex);
+
+    g_free(key);
+
+    return(FALSE);
+  }
+
+  job = ags_resource_preloader_job_alloc(resource,
+					 filename);
+
+  job->device = (guint64) stat_buf.st_dev;
+  job->size = (guint64) stat_buf.st_size;
+
+  resource_preloader->job = g_list_insert_sorted(resource_preloader->job,
+						 job,
+						 ags_resource_preloader_job_sort_func);
+
+  g_hash_table_insert(resource_preloader->job_filename,
+		      key,
+		      job);
+
+  g_rec_mutex_unlock(resource_preloader_mutex);
+
+  return(TRUE);
+}
+
+AgsResourcePreloaderJob*
+ags_resource_preloader_next_job(AgsResourcePreloader *resource_preloader)
+{
+  GList *list, *running;
+
+  guint n_device_jobs;
+
+  /* called with worker mutex held */
+  list = resource_preloader->job;
+
+  while(list != NULL){
+    AgsResourcePreloaderJob *job;
+
+    job = list->data;
+
+    if(!job->running &&
+       !job->completed){
+      /* I/O aware - bound the readers of one device */
+      n_device_jobs = 0;
+
+      running = resource_preloader->job;
+
+      while(running != NULL){
+	if(AGS_RESOURCE_PRELOADER_JOB(running->data)->running &&
+	   AGS_RESOURCE_PRELOADER_JOB(running->data)->device == job->device){
+	  n_device_jobs++;
+	}
+
+	running = running->next;
+      }
+
+      if(n_device_jobs < resource_preloader->max_device_jobs){
+	return(job);
+      }
+    }
+
+    list = list->next;
+  }
+
+  return(NULL);
+}
+
+void
+ags_resource_preloader_load_audio_container(AgsResourcePreloader *resource_preloader,
+					    AgsResourcePreloaderJob *job)
+{
+  AgsAudioContainerManager *audio_container_manager;
+  AgsAudioContainer *audio_container, *current;
+
+  GRecMutex *audio_container_manager_mutex;
+
+  audio_container_manager = ags_audio_container_manager_get_instance();
+
+  /* get audio container manager mutex */
+  audio_container_manager_mutex = AGS_AUDIO_CONTAINER_MANAGER_GET_OBJ_MUTEX(audio_container_manager);
+
+  g_rec_mutex_lock(audio_container_manager_mutex);
+
+  current = (AgsAudioContainer *) ags_audio_container_manager_find_audio_container(audio_container_manager,
+										   job->filename);
+
+  g_rec_mutex_unlock(audio_container_manager_mutex);
+
+  if(current != NULL){
+    job->gobject = g_object_ref(current);
+
+    return;
+  }
+
+  /* open without holding the manager */
+  audio_container = ags_audio_container_new(job->filename,
+					    NULL,
+					    NULL,
+					    NULL,
+					    resource_preloader->output_soundcard,
+					    -1);
+  ags_audio_container_open(audio_container);
+
+  g_rec_mutex_lock(audio_container_manager_mutex);
+
+  current = (AgsAudioContainer *) ags_audio_container_manager_find_audio_container(audio_container_manager,
+										   job->filename);
+
+  if(current == NULL){
+    ags_audio_container_manager_add_audio_container(audio_container_manager,
+						    (GObject *) audio_container);
+
+    current = audio_container;
+  }
+
+  job->gobject = g_object_ref(current);
+
+  g_rec_mutex_unlock(audio_container_manager_mutex);
+
+  if(current != audio_container){
+    g_object_run_dispose((GObject *) audio_container);
+    g_object_unref(audio_container);
+  }
+}
+
+void
+ags_resource_preloader_load_audio_file(AgsResourcePreloader *resource_preloader,
+				       AgsResourcePreloaderJob *job)
+{
+  AgsAudioFileManager *audio_file_manager;
+  AgsAudioFile *audio_file;
+
+  GList *start_audio_signal;
+
+  audio_file_manager = ags_audio_file_manager_get_instance();
+
+  /* all channels */
+  audio_file = ags_audio_file_new(job->filename,
+				  resource_preloader->output_soundcard,
+				  -1);
+
+  if(!ags_audio_file_open(audio_file)){
+    g_object_unref(audio_file);
+
+    return;
+  }
+
+  ags_audio_file_read_audio_signal(audio_file);
+
+  start_audio_signal = NULL;
+
+  g_object_get(audio_file,
+	       "audio-signal", &start_audio_signal,
+	       NULL);
+
+  job->audio_signal = start_audio_signal;
+  job->gobject = (GObject *) audio_file;
+
+  ags_audio_file_manager_add_audio_file(audio_file_manager,
+					(GObject *) audio_file);
+}
+
+void
+ags_resource_preloader_load_plugin(AgsResourcePreloader *resource_preloader,
+				   AgsResourcePreloaderJob *job)
+{
+  /* maps and relocates the shared object, instantiating it later reuses the mapping */
+#if defined(AGS_W32API)
+  job->plugin_so = LoadLibrary(job->filename);
+#else
+  job->plugin_so = dlopen(job->filename,
+			  RTLD_NOW);
+
+  if(job->plugin_so == NULL){
+    dlerror();
+  }
+#endif
+}
+
+void*
+ags_resource_preloader_worker_thread(void *ptr)
+{
+  AgsResourcePreloader *resource_preloader;
+
+  resource_preloader = AGS_RESOURCE_PRELOADER(ptr);
+
+  g_mutex_lock(&(resource_preloader->worker_mutex));
+
+  while(resource_preloader->n_pending > 0){
+    AgsResourcePreloaderJob *job;
+
+    job = ags_resource_preloader_next_job(resource_preloader);
+
+    if(job == NULL){
+      /* the remaining jobs wait for a device */
+      g_cond_wait(&(resource_preloader->worker_cond),
+		  &(resource_preloader->worker_mutex));
+
+      continue;
+    }
+
+    job->running = TRUE;
+
+    g_mutex_unlock(&(resource_preloader->worker_mutex));
+
+    switch(job->resource){
+    case AGS_RESOURCE_PRELOADER_AUDIO_CONTAINER:
+      {
+	ags_resource_preloader_load_audio_container(resource_preloader,
+						    job);
+      }
+      break;
+    case AGS_RESOURCE_PRELOADER_AUDIO_FILE:
+      {
+	ags_resource_preloader_load_audio_file(resource_preloader,
+					       job);
+      }
+      break;
+    case AGS_RESOURCE_PRELOADER_PLUGIN:
+      {
+	ags_resource_preloader_load_plugin(resource_preloader,
+					   job);
+      }
+      break;
+    }
+
+    g_mutex_lock(&(resource_preloader->worker_mutex));
+
+    job->running = FALSE;
+    job->completed = TRUE;
+
+    resource_preloader->n_pending -= 1;
+
+    g_cond_broadcast(&(resource_preloader->worker_cond));
+  }
+
+  g_mutex_unlock(&(resource_preloader->worker_mutex));
+
+  g_thread_exit(NULL);
+
+  return(NULL);
+}
+
+/**
+ * ags_resource_preloader_start:
+ * @resource_preloader: the #AgsResourcePreloader
+ *
+ * Start loading the added jobs on up to #AgsResourcePreloader:max-threads
+ * worker threads, bounded by the processor count.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_resource_preloader_start(AgsResourcePreloader *resource_preloader)
+{
+  guint n_jobs;
+  guint i;
+
+  GRecMutex *resource_preloader_mutex;
+
+  if(!AGS_IS_RESOURCE_PRELOADER(resource_preloader)){
+    return;
+  }
+
+  /* get resource preloader mutex */
+  resource_preloader_mutex = AGS_RESOURCE_PRELOADER_GET_OBJ_MUTEX(resource_preloader);
+
+  g_rec_mutex_lock(resource_preloader_mutex);
+
+  if(ags_resource_preloader_test_flags(resource_preloader, AGS_RESOURCE_PRELOADER_RUNNING)){
+    g_rec_mutex_unlock(resource_preloader_mutex);
+
+    return;
+  }
+
+  n_jobs = g_list_length(resource_preloader->job);
+
+  if(n_jobs == 0){
+    ags_resource_preloader_set_flags(resource_preloader, AGS_RESOURCE_PRELOADER_HAS_COMPLETED);
+
+    g_rec_mutex_unlock(resource_preloader_mutex);
+
+    return;
+  }
+
+  resource_preloader->n_pending = n_jobs;
+
+  resource_preloader->n_threads = g_get_num_processors();
+
+  if(resource_preloader->n_threads > resource_preloader->max_threads){
+    resource_preloader->n_threads = resource_preloader->max_threads;
+  }
+
+  if(resource_preloader->n_threads > n_jobs){
+    resource_preloader->n_threads = n_jobs;
+  }
+
+  ags_resource_preloader_set_flags(resource_preloader, AGS_RESOURCE_PRELOADER_RUNNING);
+
+  resource_preloader->worker_thread = (GThread **) g_malloc(resource_preloader->n_threads * sizeof(GThread *));
+
+  for(i = 0; i < resource_preloader->n_threads; i++){
+    resource_preloader->worker_thread[i] = g_thread_new("Advanced Gtk+ Sequencer - resource preloader",
+							ags_resource_preloader_worker_thread,
+							resource_preloader);
+  }
+
+  g_rec_mutex_unlock(resource_preloader_mutex);
+
+  /* pending jobs are visible to the loaders until joined */
+  g_mutex_lock(&ags_resource_preloader_running_mutex);
+
+  ags_resource_preloader_running = g_list_prepend(ags_resource_preloader_running,
+						  g_object_ref(resource_preloader));
+
+  g_mutex_unlock(&ags_resource_preloader_running_mutex);
+}
+
+/**
+ * ags_resource_preloader_join:
+ * @resource_preloader: the #AgsResourcePreloader
+ *
+ * Wait until all jobs of @resource_preloader have completed.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_resource_preloader_join(AgsResourcePreloader *resource_preloader)
+{
+  GThread **worker_thread;
+
+  GList *running;
+
+  guint n_threads;
+  guint i;
+
+  GRecMutex *resource_preloader_mutex;
+
+  if(!AGS_IS_RESOURCE_PRELOADER(resource_preloader)){
+    return;
+  }
+
+  /* get resource preloader mutex */
+  resource_preloader_mutex = AGS_RESOURCE_PRELOADER_GET_OBJ_MUTEX(resource_preloader);
+
+  g_rec_mutex_lock(resource_preloader_mutex);
+
+  worker_thread = resource_preloader->worker_thread;
+  n_threads = resource_preloader->n_threads;
+
+  resource_preloader->worker_thread = NULL;
+  resource_preloader->n_threads = 0;
+
+  g_rec_mutex_unlock(resource_preloader_mutex);
+
+  for(i = 0; i < n_threads; i++){
+    g_thread_join(worker_thread[i]);
+  }
+
+  g_free(worker_thread);
+
+  if(ags_resource_preloader_test_flags(resource_preloader, AGS_RESOURCE_PRELOADER_RUNNING)){
+    ags_resource_preloader_unset_flags(resource_preloader, AGS_RESOURCE_PRELOADER_RUNNING);
+    ags_resource_preloader_set_flags(resource_preloader, AGS_RESOURCE_PRELOADER_HAS_COMPLETED);
+  }
+
+  /* the loaders find the completed jobs in the managers */
+  g_mutex_lock(&ags_resource_preloader_running_mutex);
+
+  running = g_list_find(ags_resource_preloader_running,
+			resource_preloader);
+
+  if(running != NULL){
+    ags_resource_preloader_running = g_list_delete_link(ags_resource_preloader_running,
+							running);
+  }
+
+  g_mutex_unlock(&ags_resource_preloader_running_mutex);
+
+  if(running != NULL){
+    g_object_unref(resource_preloader);
+  }
+}
+
+/**
+ * ags_resource_preloader_take_audio_signal:
+ * @resource_preloader: the #AgsResourcePreloader
+ * @output_soundcard: the output soundcard
+ * @filename: the filename
+ * @audio_channel: the audio channel of @filename
+ *
+ * Take the preloaded audio signal of @filename's @audio_channel. Every
+ * audio signal is handed out once and only if read for @output_soundcard.
+ *
+ * Returns: (transfer full): the #AgsAudioSignal or %NULL if not available
+ *
+ * Since: 3.5.0
+ */
+AgsAudioSignal*
+ags_resource_preloader_take_audio_signal(AgsResourcePreloader *resource_preloader,
+					 GObject *output_soundcard,
+					 gchar *filename,
+					 guint audio_channel)
+{
+  AgsResourcePreloaderJob *job;
+  AgsAudioSignal *audio_signal;
+
+  GList *list;
+
+  gchar *key;
+
+  GRecMutex *resource_preloader_mutex;
+
+  if(!AGS_IS_RESOURCE_PRELOADER(resource_preloader) ||
+     filename == NULL){
+    return(NULL);
+  }
+
+  /* get resource preloader mutex */
+  resource_preloader_mutex = AGS_RESOURCE_PRELOADER_GET_OBJ_MUTEX(resource_preloader);
+
+  key = g_strdup_printf("%u %s", AGS_RESOURCE_PRELOADER_AUDIO_FILE, filename);
+
+  audio_signal = NULL;
+
+  g_rec_mutex_lock(resource_preloader_mutex);
+
+  job = g_hash_table_lookup(resource_preloader->job_filename,
+			    key);
+
+  if(job != NULL &&
+     resource_preloader->output_soundcard == output_soundcard){
+    g_mutex_lock(&(resource_preloader->worker_mutex));
+
+    if(job->completed){
+      list = g_list_nth(job->audio_signal,
+			audio_channel);
+
+      if(list != NULL){
+	audio_signal = list->data;
+
+	list->data = NULL;
+      }
+    }
+
+    g_mutex_unlock(&(resource_preloader->worker_mutex));
+  }
+
+  g_rec_mutex_unlock(resource_preloader_mutex);
+
+  g_free(key);
+
+  return(audio_signal);
+}
+
+/**
+ * ags_resource_preloader_wait_audio_container:
+ * @filename: the filename
+ *
+ * Wait for the audio container job of @filename of any running
+ * #AgsResourcePreloader and take over its result. Returns immediately if no
+ * running preloader has a job for @filename.
+ *
+ * Returns: (transfer full): the #AgsAudioContainer or %NULL if not preloaded
+ *
+ * Since: 3.5.0
+ */
+GObject*
+ags_resource_preloader_wait_audio_container(gchar *filename)
+{
+  AgsResourcePreloader *resource_preloader;
+  AgsResourcePreloaderJob *job;
+
+  GObject *gobject;
+
+  GList *list;
+
+  gchar *key;
+
+  GRecMutex *resource_preloader_mutex;
+
+  if(filename == NULL){
+    return(NULL);
+  }
+
+  key = g_strdup_printf("%u %s", AGS_RESOURCE_PRELOADER_AUDIO_CONTAINER, filename);
+
+  resource_preloader = NULL;
+
+  /* find running preloader with matching job */
+  g_mutex_lock(&ags_resource_preloader_running_mutex);
+
+  list = ags_resource_preloader_running;
+
+  while(list != NULL){
+    resource_preloader_mutex = AGS_RESOURCE_PRELOADER_GET_OBJ_MUTEX(list->data);
+
+    g_rec_mutex_lock(resource_preloader_mutex);
+
+    job = g_hash_table_lookup(AGS_RESOURCE_PRELOADER(list->data)->job_filename,
+			      key);
+
+    g_rec_mutex_unlock(resource_preloader_mutex);
+
+    if(job != NULL){
+      resource_preloader = g_object_ref(list->data);
+
+      break;
+    }
+
+    list = list->next;
+  }
+
+  g_mutex_unlock(&ags_resource_preloader_running_mutex);
+
+  if(resource_preloader == NULL){
+    g_free(key);
+
+    return(NULL);
+  }
+
+  /* get resource preloader mutex */
+  resource_preloader_mutex = AGS_RESOURCE_PRELOADER_GET_OBJ_MUTEX(resource_preloader);
+
+  gobject = NULL;
+
+  /* holding the mutex keeps ags_resource_preloader_release() from freeing the job */
+  g_rec_mutex_lock(resource_preloader_mutex);
+
+  job = g_hash_table_lookup(resource_preloader->job_filename,
+			    key);
+
+  if(job != NULL){
+    g_mutex_lock(&(resource_preloader->worker_mutex));
+
+    while(!job->completed){
+      g_cond_wait(&(resource_preloader->worker_cond),
+		  &(resource_preloader->worker_mutex));
+    }
+
+    if(job->gobject != NULL){
+      gobject = g_object_ref(job->gobject);
+    }
+
+    g_mutex_unlock(&(resource_preloader->worker_mutex));
+  }
+
+  g_rec_mutex_unlock(resource_preloader_mutex);
+
+  g_object_unref(resource_preloader);
+
+  g_free(key);
+
+  return(gobject);
+}
+
+/**
+ * ags_resource_preloader_release:
+ * @resource_preloader: the #AgsResourcePreloader
+ *
+ * Release the jobs of @resource_preloader. Preloaded audio files are removed
+ * from #AgsAudioFileManager, the audio containers stay managed.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_resource_preloader_release(AgsResourcePreloader *resource_preloader)
+{
+  AgsAudioFileManager *audio_file_manager;
+
+  GList *start_list, *list;
+
+  GRecMutex *resource_preloader_mutex;
+
+  if(!AGS_IS_RESOURCE_PRELOADER(resource_preloader)){
+    return;
+  }
+
+  ags_resource_preloader_join(resource_preloader);
+
+  /* get resource preloader mutex */
+  resource_preloader_mutex = AGS_RESOURCE_PRELOADER_GET_OBJ_MUTEX(resource_preloader);
+
+  audio_file_manager = ags_audio_file_manager_get_instance();
+
+  g_rec_mutex_lock(resource_preloader_mutex);
+
+  list =
+    start_list = resource_preloader->job;
+
+  resource_preloader->job = NULL;
+
+  g_hash_table_remove_all(resource_preloader->job_filename);
+
+  g_rec_mutex_unlock(resource_preloader_mutex);
+
+  while(list != NULL){
+    AgsResourcePreloaderJob *job;
+
+    job = list->data;
+
+    if(job->resource == AGS_RESOURCE_PRELOADER_AUDIO_FILE &&
+       job->gobject != NULL){
+      ags_audio_file_manager_remove_audio_file(audio_file_manager,
+					       job->gobject);
+    }
+
+    list = list->next;
+  }
+
+  g_list_free_full(start_list,
+		   (GDestroyNotify) ags_resource_preloader_job_free);
+}
+
+/**
+ * ags_resource_preloader_new:
+ * @output_soundcard: the output soundcard
+ *
+ * Create a new instance of #AgsResourcePreloader.
+ *
+ * Returns: the new #AgsResourcePreloader
+ *
+ * Since: 3.5.0
+ */
+AgsResourcePreloader*
+ags_resource_preloader_new(GObject *output_soundcard)
+{
+  AgsResourcePreloader *resource_preloader;
+
+  resource_preloader = (AgsResourcePreloader *) g_object_new(AGS_TYPE_RESOURCE_PRELOADER,
+							     "output-soundcard", output_soundcard,
+							     NULL);
+
+  return(resource_preloader);
+}
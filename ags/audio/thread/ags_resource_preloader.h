@@ -0,0 +1,169 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_RESOURCE_PRELOADER_H__
+#define __AGS_RESOURCE_PRELOADER_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+#include <ags/audio/ags_audio_signal.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_RESOURCE_PRELOADER                (ags_resource_preloader_get_type())
+#define AGS_RESOURCE_PRELOADER(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_RESOURCE_PRELOADER, AgsResourcePreloader))
+#define AGS_RESOURCE_PRELOADER_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_RESOURCE_PRELOADER, AgsResourcePreloaderClass))
+#define AGS_IS_RESOURCE_PRELOADER(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_RESOURCE_PRELOADER))
+#define AGS_IS_RESOURCE_PRELOADER_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_RESOURCE_PRELOADER))
+#define AGS_RESOURCE_PRELOADER_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_RESOURCE_PRELOADER, AgsResourcePreloaderClass))
+
+#define AGS_RESOURCE_PRELOADER_GET_OBJ_MUTEX(obj) (&(((AgsResourcePreloader *) obj)->obj_mutex))
+
+#define AGS_RESOURCE_PRELOADER_JOB(ptr) ((AgsResourcePreloaderJob *)(ptr))
+
+#define AGS_RESOURCE_PRELOADER_DEFAULT_MAX_THREADS (8)
+#define AGS_RESOURCE_PRELOADER_DEFAULT_MAX_DEVICE_JOBS (2)
+
+typedef struct _AgsResourcePreloader AgsResourcePreloader;
+typedef struct _AgsResourcePreloaderClass AgsResourcePreloaderClass;
+typedef struct _AgsResourcePreloaderJob AgsResourcePreloaderJob;
+
+/**
+ * AgsResourcePreloaderFlags:
+ * @AGS_RESOURCE_PRELOADER_RUNNING: the worker threads are running
+ * @AGS_RESOURCE_PRELOADER_HAS_COMPLETED: all jobs have completed
+ *
+ * Enum values to control the behavior or indicate internal state of #AgsResourcePreloader by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_RESOURCE_PRELOADER_RUNNING          = 1,
+  AGS_RESOURCE_PRELOADER_HAS_COMPLETED    = 1 <<  1,
+}AgsResourcePreloaderFlags;
+
+/**
+ * AgsResourcePreloaderResource:
+ * @AGS_RESOURCE_PRELOADER_AUDIO_CONTAINER: Soundfont2, SFZ or other container opened by #AgsAudioContainer
+ * @AGS_RESOURCE_PRELOADER_AUDIO_FILE: audio file decoded by #AgsAudioFile
+ * @AGS_RESOURCE_PRELOADER_PLUGIN: plugin shared object
+ *
+ * Enum values to specify the resource of #AgsResourcePreloaderJob.
+ */
+typedef enum{
+  AGS_RESOURCE_PRELOADER_AUDIO_CONTAINER,
+  AGS_RESOURCE_PRELOADER_AUDIO_FILE,
+  AGS_RESOURCE_PRELOADER_PLUGIN,
+}AgsResourcePreloaderResource;
+
+/**
+ * AgsResourcePreloaderJob:
+ * @resource: the #AgsResourcePreloaderResource
+ * @filename: the filename
+ * @device: the device @filename resides on
+ * @size: the size of @filename
+ * @running: %TRUE while a worker loads the resource
+ * @completed: %TRUE if the job has completed
+ * @gobject: the loaded #AgsAudioContainer or #AgsAudioFile
+ * @plugin_so: the loaded plugin shared object
+ * @audio_signal: the audio signals of #AgsAudioFile not yet taken
+ *
+ * #AgsResourcePreloaderJob is a resource to be loaded by #AgsResourcePreloader.
+ */
+struct _AgsResourcePreloaderJob
+{
+  guint resource;
+
+  gchar *filename;
+
+  guint64 device;
+  guint64 size;
+
+  gboolean running;
+  gboolean completed;
+
+  GObject *gobject;
+  gpointer plugin_so;
+
+  GList *audio_signal;
+};
+
+struct _AgsResourcePreloader
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  GObject *output_soundcard;
+
+  guint max_threads;
+  guint max_device_jobs;
+
+  GList *job;
+  GHashTable *job_filename;
+
+  guint n_pending;
+
+  guint n_threads;
+  GThread **worker_thread;
+
+  GMutex worker_mutex;
+  GCond worker_cond;
+};
+
+struct _AgsResourcePreloaderClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_resource_preloader_get_type(void);
+
+AgsResourcePreloaderJob* ags_resource_preloader_job_alloc(guint resource,
+							  gchar *filename);
+void ags_resource_preloader_job_free(AgsResourcePreloaderJob *job);
+
+gboolean ags_resource_preloader_test_flags(AgsResourcePreloader *resource_preloader, guint flags);
+void ags_resource_preloader_set_flags(AgsResourcePreloader *resource_preloader, guint flags);
+void ags_resource_preloader_unset_flags(AgsResourcePreloader *resource_preloader, guint flags);
+
+gboolean ags_resource_preloader_add(AgsResourcePreloader *resource_preloader,
+				    guint resource,
+				    gchar *filename);
+
+void ags_resource_preloader_start(AgsResourcePreloader *resource_preloader);
+void ags_resource_preloader_join(AgsResourcePreloader *resource_preloader);
+
+AgsAudioSignal* ags_resource_preloader_take_audio_signal(AgsResourcePreloader *resource_preloader,
+							 GObject *output_soundcard,
+							 gchar *filename,
+							 guint audio_channel);
+
+GObject* ags_resource_preloader_wait_audio_container(gchar *filename);
+
+void ags_resource_preloader_release(AgsResourcePreloader *resource_preloader);
+
+AgsResourcePreloader* ags_resource_preloader_new(GObject *output_soundcard);
+
+G_END_DECLS
+
+#endif /*__AGS_RESOURCE_PRELOADER_H__*/
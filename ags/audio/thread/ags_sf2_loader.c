@@ -26,6 +26,8 @@
 #include <ags/audio/file/ags_sound_container.h>
 #include <ags/audio/file/ags_ipatch.h>
 
+#include <ags/audio/thread/ags_resource_preloader.h>
+
 #include <ags/audio/task/ags_apply_sf2_synth.h>
 
 #include <ags/i18n.h>
@@ -596,10 +598,15 @@ ags_sf2_loader_run(void *ptr)
   /* get audio container manager mutex */
   audio_container_manager_mutex = AGS_AUDIO_CONTAINER_MANAGER_GET_OBJ_MUTEX(audio_container_manager);
   
+  /* take over the container of a running preloader rather than opening it twice */
+  sf2_loader->audio_container = (AgsAudioContainer *) ags_resource_preloader_wait_audio_container(sf2_loader->filename);
+  
   g_rec_mutex_lock(audio_container_manager_mutex);
 
-  sf2_loader->audio_container = ags_audio_container_manager_find_audio_container(audio_container_manager,
-										 sf2_loader->filename);
+  if(sf2_loader->audio_container == NULL){
+    sf2_loader->audio_container = ags_audio_container_manager_find_audio_container(audio_container_manager,
+										   sf2_loader->filename);
+  }
   
   if(sf2_loader->audio_container == NULL){
     sf2_loader->audio_container = ags_audio_container_new(sf2_loader->filename,
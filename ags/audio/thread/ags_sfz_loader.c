@@ -24,6 +24,8 @@
 #include <ags/audio/file/ags_sound_container.h>
 #include <ags/audio/file/ags_sfz_file.h>
 
+#include <ags/audio/thread/ags_resource_preloader.h>
+
 #include <ags/audio/task/ags_apply_sfz_synth.h>
 
 #include <ags/i18n.h>
@@ -492,10 +494,15 @@ ags_sfz_loader_run(void *ptr)
   /* get audio container manager mutex */
   audio_container_manager_mutex = AGS_AUDIO_CONTAINER_MANAGER_GET_OBJ_MUTEX(audio_container_manager);
   
+  /* take over the container of a running preloader rather than opening it twice */
+  sfz_loader->audio_container = (AgsAudioContainer *) ags_resource_preloader_wait_audio_container(sfz_loader->filename);
+  
   g_rec_mutex_lock(audio_container_manager_mutex);
 
-  sfz_loader->audio_container = ags_audio_container_manager_find_audio_container(audio_container_manager,
-										 sfz_loader->filename);
+  if(sfz_loader->audio_container == NULL){
+    sfz_loader->audio_container = ags_audio_container_manager_find_audio_container(audio_container_manager,
+										   sfz_loader->filename);
+  }
   
   if(sfz_loader->audio_container == NULL){
     sfz_loader->audio_container = ags_audio_container_new(sfz_loader->filename,
@@ -225,6 +225,11 @@ ags_soundcard_thread_init(AgsSoundcardThread *soundcard_thread)
 
   soundcard_thread->soundcard = NULL;
   soundcard_thread->error = NULL;
+
+  /* xrun */
+  soundcard_thread->last_play_time = 0;
+  g_atomic_int_set(&(soundcard_thread->xrun_count),
+		   0);
 }
 
 void
@@ -469,6 +474,8 @@ ags_soundcard_thread_run(AgsThread *thread)
     is_playing = ags_soundcard_is_playing(AGS_SOUNDCARD(soundcard));
   
     if(is_playing){
+      guint samplerate, buffer_size;
+      
       error = NULL;
       ags_soundcard_play(AGS_SOUNDCARD(soundcard),
 			 &error);
@@ -480,7 +487,22 @@ ags_soundcard_thread_run(AgsThread *thread)
 		  error->message);
 
 	g_error_free(error);
+
+	g_atomic_int_inc(&(soundcard_thread->xrun_count));
       }
+
+      /* xrun accounting */
+      ags_soundcard_get_presets(AGS_SOUNDCARD(soundcard),
+				NULL,
+				&samplerate,
+				&buffer_size,
+				NULL);
+      
+      ags_soundcard_thread_account_play(soundcard_thread,
+					ags_timing_monitor_get_time(),
+					samplerate, buffer_size);
+    }else{
+      soundcard_thread->last_play_time = 0;
     }
   }
 
@@ -630,6 +652,89 @@ ags_soundcard_thread_find_soundcard(AgsSoundcardThread *soundcard_thread,
   return(NULL);
 }
 
+/**
+ * ags_soundcard_thread_account_play:
+ * @soundcard_thread: the #AgsSoundcardThread
+ * @play_time: the monotonic time in nanoseconds the period was played
+ * @samplerate: the samplerate
+ * @buffer_size: the buffer size
+ * 
+ * Account a played period. If more than %AGS_SOUNDCARD_THREAD_XRUN_PERIODS
+ * periods passed since the previous one, the device ran out of data and an
+ * xrun is counted.
+ * 
+ * Returns: %TRUE if an xrun was counted, otherwise %FALSE
+ * 
+ * Since: 3.5.0
+ */
+gboolean
+ags_soundcard_thread_account_play(AgsSoundcardThread *soundcard_thread,
+				  gint64 play_time,
+				  guint samplerate, guint buffer_size)
+{
+  gint64 period_time;
+  gboolean is_xrun;
+  
+  if(!AGS_IS_SOUNDCARD_THREAD(soundcard_thread) ||
+     samplerate == 0){
+    return(FALSE);
+  }
+
+  period_time = ((gint64) buffer_size * AGS_TIMING_MONITOR_NSEC_PER_SEC) / (gint64) samplerate;
+
+  is_xrun = FALSE;
+  
+  if(soundcard_thread->last_play_time != 0 &&
+     play_time - soundcard_thread->last_play_time > AGS_SOUNDCARD_THREAD_XRUN_PERIODS * period_time){
+    g_atomic_int_inc(&(soundcard_thread->xrun_count));
+
+    is_xrun = TRUE;
+  }
+
+  soundcard_thread->last_play_time = play_time;
+
+  return(is_xrun);
+}
+
+/**
+ * ags_soundcard_thread_get_xrun_count:
+ * @soundcard_thread: the #AgsSoundcardThread
+ * 
+ * Get the count of xruns since start or last reset.
+ * 
+ * Returns: the xrun count
+ * 
+ * Since: 3.5.0
+ */
+guint
+ags_soundcard_thread_get_xrun_count(AgsSoundcardThread *soundcard_thread)
+{
+  if(!AGS_IS_SOUNDCARD_THREAD(soundcard_thread)){
+    return(0);
+  }
+
+  return(g_atomic_int_get(&(soundcard_thread->xrun_count)));
+}
+
+/**
+ * ags_soundcard_thread_reset_xrun_count:
+ * @soundcard_thread: the #AgsSoundcardThread
+ * 
+ * Reset the xrun count.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_soundcard_thread_reset_xrun_count(AgsSoundcardThread *soundcard_thread)
+{
+  if(!AGS_IS_SOUNDCARD_THREAD(soundcard_thread)){
+    return;
+  }
+
+  g_atomic_int_set(&(soundcard_thread->xrun_count),
+		   0);
+}
+
 /**
  * ags_soundcard_thread_new:
  * @soundcard: the #AgsSoundcard
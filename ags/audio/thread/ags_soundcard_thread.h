@@ -36,6 +36,8 @@ G_BEGIN_DECLS
 
 #define AGS_SOUNDCARD_THREAD_DEFAULT_JIFFIE (ceil(AGS_SOUNDCARD_DEFAULT_SAMPLERATE / AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE) + AGS_SOUNDCARD_DEFAULT_OVERCLOCK)
 
+#define AGS_SOUNDCARD_THREAD_XRUN_PERIODS (2)
+
 typedef struct _AgsSoundcardThread AgsSoundcardThread;
 typedef struct _AgsSoundcardThreadClass AgsSoundcardThreadClass;
 
@@ -49,6 +51,9 @@ struct _AgsSoundcardThread
 
   GObject *soundcard;
   GError *error;
+
+  gint64 last_play_time;
+  volatile guint xrun_count;
 };
 
 struct _AgsSoundcardThreadClass
@@ -61,6 +66,13 @@ GType ags_soundcard_thread_get_type();
 AgsSoundcardThread* ags_soundcard_thread_find_soundcard(AgsSoundcardThread *soundcard_thread,
 							GObject *soundcard);
 
+gboolean ags_soundcard_thread_account_play(AgsSoundcardThread *soundcard_thread,
+					   gint64 play_time,
+					   guint samplerate, guint buffer_size);
+
+guint ags_soundcard_thread_get_xrun_count(AgsSoundcardThread *soundcard_thread);
+void ags_soundcard_thread_reset_xrun_count(AgsSoundcardThread *soundcard_thread);
+
 AgsSoundcardThread* ags_soundcard_thread_new(GObject *soundcard,
 					     guint soundcard_capability);
 
@@ -23,6 +23,9 @@
 #include <ags/audio/ags_wave.h>
 
 #include <ags/audio/file/ags_sound_resource.h>
+#include <ags/audio/file/ags_wave_stream.h>
+
+#include <ags/audio/fx/ags_fx_playback_audio.h>
 
 #include <ags/i18n.h>
 
@@ -539,7 +542,7 @@ ags_wave_loader_run(void *ptr)
 			 AGS_TYPE_INPUT,
 			 1, 0);
     }
-    
+
     wave =
       start_wave = ags_sound_resource_read_wave(AGS_SOUND_RESOURCE(wave_loader->audio_file->sound_resource),
 						output_soundcard,
@@ -566,6 +569,28 @@ ags_wave_loader_run(void *ptr)
       
 	wave = wave->next;
       }
+
+      /* long files are played from disk until edited */
+      if(ags_wave_stream_test_duration(wave_loader->audio_file->sound_resource)){
+	GList *start_wave_stream, *wave_stream;
+
+	wave_stream =
+	  start_wave_stream = ags_wave_stream_open_filename(wave_loader->filename,
+							    output_soundcard);
+
+	ags_fx_playback_audio_attach_wave_stream(wave_loader->audio,
+						 start_wave_stream,
+						 TRUE);
+      
+	while(wave_stream != NULL){
+	  ags_wave_stream_start(wave_stream->data);
+
+	  wave_stream = wave_stream->next;
+	}
+
+	g_list_free_full(start_wave_stream,
+			 g_object_unref);
+      }
     }
     
     g_list_free(start_wave);
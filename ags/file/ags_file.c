@@ -35,11 +35,14 @@
 #include <libxml/parser.h>
 #include <libxml/xlink.h>
 #include <libxml/xpath.h>
+#include <libxml/xpathInternals.h>
 #include <libxml/valid.h>
 #include <libxml/xmlIO.h>
 #include <libxml/xmlmemory.h>
 #include <libxml/xmlsave.h>
 
+#include <string.h>
+
 #include <ags/i18n.h>
 
 void ags_file_class_init(AgsFileClass *file);
@@ -54,6 +57,11 @@ void ags_file_get_property(GObject *gobject,
 			   GParamSpec *param_spec);
 void ags_file_finalize(GObject *gobject);
 
+gboolean ags_file_xpath_id_predicate(gchar *xpath,
+				     gchar **name, gchar **id);
+xmlXPathObject* ags_file_eval_xpath(AgsFile *file,
+				    gchar *xpath);
+
 void ags_file_real_open(AgsFile *file,
 			GError **error);
 void ags_file_real_open_from_data(AgsFile *file,
@@ -435,6 +443,22 @@ ags_file_init(AgsFile *file)
   file->doc = NULL;
 
   file->id_refs = NULL;
+
+  file->id_ref_node = g_hash_table_new(g_direct_hash,
+				       g_direct_equal);
+  file->id_ref_reference = g_hash_table_new(g_direct_hash,
+					    g_direct_equal);
+  file->id_ref_id = g_hash_table_new_full(g_str_hash,
+					  g_str_equal,
+					  g_free,
+					  (GDestroyNotify) g_list_free);
+
+  file->xpath_context = NULL;
+  file->xpath_expression = g_hash_table_new_full(g_str_hash,
+						 g_str_equal,
+						 g_free,
+						 (GDestroyNotify) xmlXPathFreeCompExpr);
+
   file->lookup = NULL;
   file->launch = NULL;
 
@@ -628,6 +652,16 @@ ags_file_finalize(GObject *gobject)
     return;
   }
 
+  if(file->xpath_context != NULL){
+    xmlXPathFreeContext(file->xpath_context);
+  }
+
+  g_hash_table_destroy(file->xpath_expression);
+
+  g_hash_table_destroy(file->id_ref_node);
+  g_hash_table_destroy(file->id_ref_reference);
+  g_hash_table_destroy(file->id_ref_id);
+  
   xmlFreeDoc(file->doc);
   //  xmlCleanupParser();
   //  xmlMemoryDump();
@@ -671,6 +705,10 @@ ags_file_str2md5(gchar *content, guint content_length)
 void
 ags_file_add_id_ref(AgsFile *file, GObject *id_ref)
 {
+  xmlNode *node;
+
+  gpointer ref;
+  
   GRecMutex *file_mutex;
 
   if(!AGS_IS_FILE(file) ||
@@ -681,14 +719,57 @@ ags_file_add_id_ref(AgsFile *file, GObject *id_ref)
   /* get file mutex */
   file_mutex = AGS_FILE_GET_OBJ_MUTEX(file);
 
+  node = NULL;
+  ref = NULL;
+  
+  g_object_get(id_ref,
+	       "node", &node,
+	       "reference", &ref,
+	       NULL);
+
   /* add */
   g_rec_mutex_lock(file_mutex);
   
-  if(g_list_find(file->id_refs,
-		 id_ref) == NULL){
+  if(g_hash_table_lookup(file->id_ref_node,
+			 node) != id_ref){
     g_object_ref(id_ref);
     file->id_refs = g_list_prepend(file->id_refs,
 				   id_ref);
+
+    /* index - the most recent id ref wins */
+    g_hash_table_insert(file->id_ref_node,
+			node,
+			id_ref);
+    g_hash_table_insert(file->id_ref_reference,
+			ref,
+			id_ref);
+
+    if(node != NULL){
+      xmlChar *id;
+
+      id = xmlGetProp(node,
+		      "id");
+
+      if(id != NULL){
+	GList *start_node;
+
+	start_node = g_hash_table_lookup(file->id_ref_id,
+					 id);
+
+	if(start_node == NULL){
+	  g_hash_table_insert(file->id_ref_id,
+			      g_strdup(id),
+			      g_list_prepend(NULL,
+					     node));
+	}else if(g_list_find(start_node, node) == NULL){
+	  /* appending keeps the head stored in the table */
+	  g_list_append(start_node,
+			node);
+	}
+	
+	xmlFree(id);
+      }
+    }
   }
 
   g_rec_mutex_unlock(file_mutex);
@@ -710,10 +791,6 @@ ags_file_find_id_ref_by_node(AgsFile *file, xmlNode *node)
 {
   AgsFileIdRef *file_id_ref;
 
-  xmlNode *current_node;
-  
-  GList *start_list, *list;
-
   GRecMutex *file_mutex;
 
   if(!AGS_IS_FILE(file) ||
@@ -725,36 +802,139 @@ ags_file_find_id_ref_by_node(AgsFile *file, xmlNode *node)
   file_mutex = AGS_FILE_GET_OBJ_MUTEX(file);
 
   /* find */
-  file_id_ref = NULL;
-  
   g_rec_mutex_lock(file_mutex);
 
-  list =
-    start_list = g_list_copy_deep(file->id_refs,
-				  (GCopyFunc) g_object_ref,
-				  NULL);
+  file_id_ref = g_hash_table_lookup(file->id_ref_node,
+				    node);
 
+  if(file_id_ref != NULL){
+    g_object_ref(file_id_ref);
+  }
+  
   g_rec_mutex_unlock(file_mutex);
 
-  while(list != NULL){
-    g_object_get(list->data,
-		 "node", &current_node,
-		 NULL);
+  return((GObject *) file_id_ref);
+}
+
+gboolean
+ags_file_xpath_id_predicate(gchar *xpath,
+			    gchar **name, gchar **id)
+{
+  gchar *predicate;
+  gchar *id_start, *id_end;
 
-    if(current_node == node){
-      file_id_ref = AGS_FILE_ID_REF(list->data);
-      g_object_ref(file_id_ref);
+  /* an element name or wildcard step with an id predicate */
+  if(!g_str_has_prefix(xpath, "//")){
+    return(FALSE);
+  }
 
-      break;
+  predicate = strstr(xpath, "[@id='");
+
+  if(predicate == NULL ||
+     predicate == xpath + 2 ||
+     strpbrk(xpath + 2, "/[@") != predicate){
+    return(FALSE);
+  }
+
+  id_start = predicate + 6;
+  id_end = strchr(id_start, '\'');
+
+  if(id_end == NULL ||
+     strcmp(id_end, "']") != 0){
+    return(FALSE);
+  }
+
+  name[0] = g_strndup(xpath + 2,
+		      predicate - xpath - 2);
+  id[0] = g_strndup(id_start,
+		    id_end - id_start);
+  
+  return(TRUE);
+}
+
+xmlXPathObject*
+ags_file_eval_xpath(AgsFile *file,
+		    gchar *xpath)
+{
+  xmlXPathCompExpr *xpath_expression;
+  xmlXPathObject *xpath_object;
+
+  gchar *name, *id;
+  gchar *pattern;
+  
+  GRecMutex *file_mutex;
+
+  /* get file mutex */
+  file_mutex = AGS_FILE_GET_OBJ_MUTEX(file);
+
+  /* id predicates share one compiled pattern per element name */
+  name = NULL;
+  id = NULL;
+  
+  if(ags_file_xpath_id_predicate(xpath,
+				 &name, &id)){
+    pattern = g_strdup_printf("//%s[@id=$id]", name);
+  }else{
+    pattern = g_strdup(xpath);
+  }
+  
+  g_rec_mutex_lock(file_mutex);
+
+  /* the context is bound to the document */
+  if(file->xpath_context == NULL ||
+     file->xpath_context->doc != file->doc){
+    if(file->xpath_context != NULL){
+      xmlXPathFreeContext(file->xpath_context);
     }
+    
+    file->xpath_context = xmlXPathNewContext(file->doc);
+  }
 
-    list = list->next;
+  xpath_object = NULL;
+  
+  if(file->xpath_context == NULL){
+    g_rec_mutex_unlock(file_mutex);
+
+    g_warning("Error: unable to create new XPath context");
+
+    g_free(name);
+    g_free(id);
+    g_free(pattern);
+    
+    return(NULL);
   }
 
-  g_list_free_full(start_list,
-		   (GDestroyNotify) g_object_unref);
+  xpath_expression = g_hash_table_lookup(file->xpath_expression,
+					 pattern);
 
-  return((GObject *) file_id_ref);
+  if(xpath_expression == NULL){
+    xpath_expression = xmlXPathCompile(pattern);
+
+    if(xpath_expression != NULL){
+      g_hash_table_insert(file->xpath_expression,
+			  g_strdup(pattern),
+			  xpath_expression);
+    }
+  }
+
+  if(xpath_expression != NULL){
+    if(id != NULL){
+      xmlXPathRegisterVariable(file->xpath_context,
+			       "id",
+			       xmlXPathNewString(id));
+    }
+    
+    xpath_object = xmlXPathCompiledEval(xpath_expression,
+					file->xpath_context);
+  }
+  
+  g_rec_mutex_unlock(file_mutex);
+
+  g_free(name);
+  g_free(id);
+  g_free(pattern);
+  
+  return(xpath_object);
 }
 
 /**
@@ -762,7 +942,8 @@ ags_file_find_id_ref_by_node(AgsFile *file, xmlNode *node)
  * @file: the #AgsFile
  * @xpath: a XPath expression
  *
- * Lookup a reference by @xpath.
+ * Lookup a reference by @xpath. Expressions of the form //name[@id='id'] are
+ * resolved by the id index, others are evaluated with a compiled expression.
  * 
  * Returns: (transfer full): the matching #GObject
  *
@@ -771,14 +952,18 @@ ags_file_find_id_ref_by_node(AgsFile *file, xmlNode *node)
 GObject*
 ags_file_find_id_ref_by_xpath(AgsFile *file, gchar *xpath)
 {
-  AgsFileIdRef *file_id_ref;
-
-  xmlXPathContext *xpath_context; 
   xmlXPathObject *xpath_object;
   xmlNode **node;
+  xmlNode *id_node;
 
+  GObject *gobject;
+  
+  gchar *name, *id;
+  
   guint i;
 
+  GRecMutex *file_mutex;
+
   if(!AGS_IS_FILE(file) || xpath == NULL || !g_str_has_prefix(xpath, "xpath=")){
     g_message("invalid xpath: %s", xpath);
 
@@ -787,34 +972,75 @@ ags_file_find_id_ref_by_xpath(AgsFile *file, gchar *xpath)
 
   xpath = &(xpath[6]);
 
-  /* Create xpath evaluation context */
-  xpath_context = xmlXPathNewContext(file->doc);
+  /* get file mutex */
+  file_mutex = AGS_FILE_GET_OBJ_MUTEX(file);
 
-  if(xpath_context == NULL) {
-    g_warning("Error: unable to create new XPath context");
+  /* id index */
+  id_node = NULL;
 
-    return(NULL);
+  name = NULL;
+  id = NULL;
+  
+  if(ags_file_xpath_id_predicate(xpath,
+				 &name, &id)){
+    GList *list;
+
+    g_rec_mutex_lock(file_mutex);
+    
+    list = g_hash_table_lookup(file->id_ref_id,
+			       id);
+
+    while(list != NULL){
+      if(!g_strcmp0(name, "*") ||
+	 !xmlStrcmp(((xmlNode *) list->data)->name, name)){
+	id_node = list->data;
+
+	break;
+      }
+      
+      list = list->next;
+    }
+    
+    g_rec_mutex_unlock(file_mutex);
+
+    g_free(name);
+    g_free(id);
   }
 
+  if(id_node != NULL){
+    return(ags_file_find_id_ref_by_node(file,
+					id_node));
+  }
+  
   /* Evaluate xpath expression */
-  xpath_object = xmlXPathEval(xpath, xpath_context);
+  xpath_object = ags_file_eval_xpath(file,
+				     xpath);
 
   if(xpath_object == NULL) {
     g_warning("Error: unable to evaluate xpath expression \"%s\"", xpath);
-    xmlXPathFreeContext(xpath_context); 
 
     return(NULL);
   }
 
-  node = xpath_object->nodesetval->nodeTab;
+  gobject = NULL;
+  
+  if(xpath_object->nodesetval != NULL){
+    node = xpath_object->nodesetval->nodeTab;
+
+    for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
+      if(node[i]->type == XML_ELEMENT_NODE){
+	gobject = ags_file_find_id_ref_by_node(file,
+					       node[i]);
 
-  for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
-    if(node[i]->type == XML_ELEMENT_NODE){
-      return(ags_file_find_id_ref_by_node(file,
-					  node[i]));
+	xmlXPathFreeObject(xpath_object);
+      
+	return(gobject);
+      }
     }
   }
-
+  
+  xmlXPathFreeObject(xpath_object);
+  
   g_message("no xpath match: %s", xpath);
   
   return(NULL);
@@ -835,10 +1061,6 @@ GObject*
 ags_file_find_id_ref_by_reference(AgsFile *file, gpointer ref)
 {
   AgsFileIdRef *file_id_ref;
-
-  GList *start_list, *list;
-
-  gpointer current_ref;
   
   GRecMutex *file_mutex;
 
@@ -850,34 +1072,16 @@ ags_file_find_id_ref_by_reference(AgsFile *file, gpointer ref)
   file_mutex = AGS_FILE_GET_OBJ_MUTEX(file);
 
   /* find */
-  file_id_ref = NULL;
-  
   g_rec_mutex_lock(file_mutex);
 
-  list =
-    start_list = g_list_copy_deep(file->id_refs,
-				  (GCopyFunc) g_object_ref,
-				  NULL);
-
-  g_rec_mutex_unlock(file_mutex);
-
-  while(list != NULL){
-    g_object_get(list->data,
-		 "reference", &current_ref,
-		 NULL);
-
-    if(current_ref == ref){
-      file_id_ref = AGS_FILE_ID_REF(list->data);
-      g_object_ref(file_id_ref);
-      
-      break;
-    }
+  file_id_ref = g_hash_table_lookup(file->id_ref_reference,
+				    ref);
 
-    list = list->next;
+  if(file_id_ref != NULL){
+    g_object_ref(file_id_ref);
   }
-
-  g_list_free_full(start_list,
-		   (GDestroyNotify) g_object_unref);
+  
+  g_rec_mutex_unlock(file_mutex);
 
   return((GObject *) file_id_ref);
 }
@@ -1212,6 +1416,12 @@ ags_file_close(AgsFile *file)
   }
 
   /* free the document */
+  if(file->xpath_context != NULL){
+    xmlXPathFreeContext(file->xpath_context);
+
+    file->xpath_context = NULL;
+  }
+  
   xmlFreeDoc(file->doc);
   
   /*
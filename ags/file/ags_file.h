@@ -24,6 +24,7 @@
 #include <glib-object.h>
 
 #include <libxml/tree.h>
+#include <libxml/xpath.h>
 
 G_BEGIN_DECLS
 
@@ -102,6 +103,14 @@ struct _AgsFile
   xmlNode *root_node;
 
   GList *id_refs;
+
+  GHashTable *id_ref_node;
+  GHashTable *id_ref_reference;
+  GHashTable *id_ref_id;
+
+  xmlXPathContext *xpath_context;
+  GHashTable *xpath_expression;
+
   GList *lookup;
   GList *launch;
 
@@ -149,6 +149,66 @@ ags_uuid_compare(AgsUUID *a,
   return(retval);
 }
 
+/**
+ * ags_uuid_hash:
+ * @ptr: the #AgsUUID
+ * 
+ * Hash @ptr, suitable as #GHashFunc of #GHashTable.
+ *
+ * Returns: the hash value
+ * 
+ * Since: 3.5.0
+ */
+guint
+ags_uuid_hash(gconstpointer ptr)
+{
+  const AgsUUID *uuid;
+
+  guint hash;
+  guint i;
+
+  uuid = (const AgsUUID *) ptr;
+
+  /* FNV-1a */
+  hash = 2166136261U;
+  
+  for(i = 0; i < AGS_UUID_DEFAULT_LENGTH; i++){
+    hash ^= uuid->data[i];
+    hash *= 16777619U;
+  }
+
+  return(hash);
+}
+
+/**
+ * ags_uuid_equal:
+ * @a: an #AgsUUID
+ * @b: another #AgsUUID
+ * 
+ * Check @a and @b for equality, suitable as #GEqualFunc of #GHashTable.
+ *
+ * Returns: %TRUE if equal, otherwise %FALSE
+ * 
+ * Since: 3.5.0
+ */
+gboolean
+ags_uuid_equal(gconstpointer a,
+	       gconstpointer b)
+{
+  if(a == b){
+    return(TRUE);
+  }
+
+  if(a == NULL ||
+     b == NULL){
+    return(FALSE);
+  }
+  
+  return(!memcmp(((const AgsUUID *) a)->data,
+		 ((const AgsUUID *) b)->data,
+		 AGS_UUID_DEFAULT_LENGTH));
+}
+
 /**
  * ags_uuid_to_string:
  * @ptr: the #AgsUUID
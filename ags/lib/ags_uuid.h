@@ -49,6 +49,10 @@ void ags_uuid_generate(AgsUUID *ptr);
 gint ags_uuid_compare(AgsUUID *a,
 		      AgsUUID *b);
 
+guint ags_uuid_hash(gconstpointer ptr);
+gboolean ags_uuid_equal(gconstpointer a,
+			gconstpointer b);
+
 gchar* ags_uuid_to_string(AgsUUID *ptr);
 AgsUUID* ags_uuid_from_string(gchar *str);
 
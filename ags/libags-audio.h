@@ -63,13 +63,16 @@
 #include <ags/audio/ags_frequency_map_manager.h>
 #include <ags/audio/ags_frequency_map.h>
 #include <ags/audio/ags_input.h>
+#include <ags/audio/ags_level_util.h>
 #include <ags/audio/ags_lfo_synth_util.h>
+#include <ags/audio/ags_meter_snapshot.h>
 #include <ags/audio/ags_midi.h>
 #include <ags/audio/ags_midiin.h>
 #include <ags/audio/ags_notation.h>
 #include <ags/audio/ags_note.h>
 #include <ags/audio/ags_output.h>
 #include <ags/audio/ags_pattern.h>
+#include <ags/audio/ags_pitch_util.h>
 #include <ags/audio/ags_playback.h>
 #include <ags/audio/ags_playback_domain.h>
 #include <ags/audio/ags_port.h>
@@ -92,6 +95,8 @@
 #include <ags/audio/ags_recall_ladspa_run.h>
 #include <ags/audio/ags_recall_lv2.h>
 #include <ags/audio/ags_recall_lv2_run.h>
+#include <ags/audio/ags_recall_pool.h>
+#include <ags/audio/ags_fft_plan_cache.h>
 #include <ags/audio/ags_generic_recall_recycling.h>
 #include <ags/audio/ags_recall_recycling.h>
 #include <ags/audio/ags_recycling_context.h>
@@ -119,6 +124,7 @@
 #include <ags/audio/thread/ags_sf2_loader.h>
 #include <ags/audio/thread/ags_sfz_loader.h>
 #include <ags/audio/thread/ags_wave_loader.h>
+#include <ags/audio/thread/ags_resource_preloader.h>
 
 /* audio file */
 #include <ags/audio/file/ags_audio_container.h>
@@ -138,6 +144,7 @@
 #include <ags/audio/file/ags_sndfile.h>
 #include <ags/audio/file/ags_sound_container.h>
 #include <ags/audio/file/ags_sound_resource.h>
+#include <ags/audio/file/ags_wave_stream.h>
 
 /* audio midi */
 #include <ags/audio/midi/ags_midi_buffer_util.h>
@@ -147,12 +154,14 @@
 #include <ags/audio/midi/ags_midi_util.h>
 
 /* audio osc */
+#include <ags/audio/osc/ags_osc_address_trie.h>
 #include <ags/audio/osc/ags_osc_buffer_util.h>
 #include <ags/audio/osc/ags_osc_builder.h>
 #include <ags/audio/osc/ags_osc_client.h>
 #include <ags/audio/osc/ags_osc_connection.h>
 #include <ags/audio/osc/ags_osc_parser.h>
 #include <ags/audio/osc/ags_osc_response.h>
+#include <ags/audio/osc/ags_osc_scheduler.h>
 #include <ags/audio/osc/ags_osc_server.h>
 #include <ags/audio/osc/ags_osc_util.h>
 #include <ags/audio/osc/ags_osc_websocket_connection.h>
@@ -417,6 +426,7 @@
 #include <ags/audio/task/ags_switch_buffer_flag.h>
 #include <ags/audio/task/ags_tic_device.h>
 #include <ags/audio/task/ags_toggle_pattern_bit.h>
+#include <ags/audio/task/ags_update_notation_snapshot.h>
 
 /* audio recall task */
 #include <ags/audio/task/ags_apply_bpm.h>
@@ -84,6 +84,8 @@
 #include <ags/thread/ags_thread_application_context.h>
 #include <ags/thread/ags_thread_pool.h>
 #include <ags/thread/ags_thread.h>
+#include <ags/thread/ags_tic_barrier.h>
+#include <ags/thread/ags_timing_monitor.h>
 #include <ags/thread/ags_timestamp.h>
 #include <ags/thread/ags_worker_thread.h>
 
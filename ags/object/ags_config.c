@@ -400,6 +400,7 @@ ags_config_real_load_defaults(AgsConfig *config)
   ags_config_set_value(config, AGS_CONFIG_THREAD, "lock-global", "ags-thread");
   ags_config_set_value(config, AGS_CONFIG_THREAD, "lock-parent", "ags-recycling-thread");
   ags_config_set_value(config, AGS_CONFIG_THREAD, "max-precision", "250");
+  ags_config_set_value(config, AGS_CONFIG_THREAD, "tic-barrier", "false");
 
 #if defined(AGS_WITH_WASAPI)
   ags_config_set_value(config, AGS_CONFIG_SOUNDCARD_0, "backend", "wasapi");
@@ -863,7 +863,7 @@ ags_lv2_plugin_instantiate(AgsBasePlugin *base_plugin,
   LV2_Options_Interface *options_interface;
   LV2_Options_Option *options;
   
-  LV2_Feature **feature;
+  LV2_Feature **feature, **instance_feature;
 
   gchar *filename;
   char *path;  
@@ -999,20 +999,7 @@ ags_lv2_plugin_instantiate(AgsBasePlugin *base_plugin,
 
     nth++;
   
-    /* worker feature */
-    if(ags_lv2_plugin_test_flags(lv2_plugin, AGS_LV2_PLUGIN_NEEDS_WORKER)){
-      worker_handle = ags_lv2_worker_manager_pull_worker(ags_lv2_worker_manager_get_instance());
-  
-      worker_schedule = (LV2_Worker_Schedule *) malloc(sizeof(LV2_Worker_Schedule));
-      worker_schedule->handle = worker_handle;
-      worker_schedule->schedule_work = ags_lv2_worker_schedule_work;
-  
-      feature[nth] = (LV2_Feature *) malloc(sizeof(LV2_Feature));
-      feature[nth]->URI = LV2_WORKER__schedule;
-      feature[nth]->data = worker_schedule;
-
-      nth++;
-    }
+    /* worker feature is per instance, see below */
   
     /* log feature */
 #if 0
@@ -1227,14 +1214,52 @@ ags_lv2_plugin_instantiate(AgsBasePlugin *base_plugin,
 					   options);
   }
 
+  /* worker feature - every instance gets its own worker and schedule feature */
+  instance_feature = feature;
+  
+  if(ags_lv2_plugin_test_flags(lv2_plugin, AGS_LV2_PLUGIN_NEEDS_WORKER)){
+    worker_handle = ags_lv2_worker_manager_pull_worker(ags_lv2_worker_manager_get_instance());
+  
+    worker_schedule = (LV2_Worker_Schedule *) malloc(sizeof(LV2_Worker_Schedule));
+    worker_schedule->handle = worker_handle;
+    worker_schedule->schedule_work = ags_lv2_worker_schedule_work;
+
+    for(total_feature = 0; feature[total_feature] != NULL; total_feature++);
+    
+    instance_feature = (LV2_Feature **) malloc((total_feature + 2) * sizeof(LV2_Feature *));
+
+    instance_feature[0] = (LV2_Feature *) malloc(sizeof(LV2_Feature));
+    instance_feature[0]->URI = LV2_WORKER__schedule;
+    instance_feature[0]->data = worker_schedule;
+
+    for(i = 0; i < total_feature; i++){
+      instance_feature[i + 1] = feature[i];
+    }
+
+    instance_feature[total_feature + 1] = NULL;
+
+    /* freed with the worker */
+    AGS_LV2_WORKER(worker_handle)->worker_schedule = worker_schedule;
+    AGS_LV2_WORKER(worker_handle)->feature = instance_feature;
+  }
+  
   if(instantiate != NULL){
     lv2_handle[0] = instantiate(plugin_descriptor,
 				rate,
 				path,
-				feature);
+				instance_feature);
   }
   
   /*  */  
+  if(worker_handle != NULL &&
+     lv2_handle[0] == NULL){
+    /* no instance to release the worker with */
+    ags_lv2_worker_manager_remove_worker(ags_lv2_worker_manager_get_instance(),
+					 worker_handle);
+
+    worker_handle = NULL;
+  }
+  
   if(worker_handle != NULL){
     if(plugin_descriptor->extension_data != NULL){
       AGS_LV2_WORKER(worker_handle)->worker_interface = plugin_descriptor->extension_data("http://lv2plug.in/ns/ext/worker#interface");
@@ -1243,6 +1268,10 @@ ags_lv2_plugin_instantiate(AgsBasePlugin *base_plugin,
     g_object_set(worker_handle,
 		 "handle", lv2_handle[0],
 		 NULL);
+
+    ags_lv2_worker_manager_insert_handle(ags_lv2_worker_manager_get_instance(),
+					 lv2_handle[0],
+					 worker_handle);
   }
 
   g_free(path);
@@ -1783,6 +1812,115 @@ ags_lv2_plugin_clear_event_buffer(gpointer event_buffer,
   memset(offset, 0, padded_buffer_size);
 }
 
+/**
+ * ags_lv2_plugin_event_buffer_reset:
+ * @event_buffer: the event buffer
+ *
+ * Reset @event_buffer to contain no events. Doesn't touch the data, so it
+ * can be called once per cycle after run().
+ *
+ * Since: 3.5.0
+ */
+void
+ags_lv2_plugin_event_buffer_reset(gpointer event_buffer)
+{
+  if(event_buffer == NULL){
+    return;
+  }
+
+  AGS_LV2_EVENT_BUFFER(event_buffer)->event_count = 0;
+  AGS_LV2_EVENT_BUFFER(event_buffer)->size = 0;
+}
+
+/**
+ * ags_lv2_plugin_event_buffer_append_midi_at:
+ * @event_buffer: the event buffer
+ * @buffer_size: the event buffer size
+ * @frame: the frame offset within the period
+ * @events: (type gpointer) (transfer none): the events to write
+ * @event_count: the number of events to write
+ *
+ * Append MIDI channel messages to event buffer time stamped with @frame. The
+ * tail is given by the buffer's size, so appending in time order is O(1). An
+ * earlier @frame is inserted before the later events.
+ *
+ * Returns: %TRUE on success otherwise %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_lv2_plugin_event_buffer_append_midi_at(gpointer event_buffer,
+					   guint buffer_size,
+					   guint frame,
+					   snd_seq_event_t *events,
+					   guint event_count)
+{
+  guint8 *data;
+  LV2_Event *event;
+  
+  unsigned char midi_buffer[8];
+
+  uint16_t midi_type;
+  guint position;
+  guint count;
+  guint i;
+
+  if(event_buffer == NULL ||
+     events == NULL){
+    return(FALSE);
+  }
+
+  data = AGS_LV2_EVENT_BUFFER(event_buffer)->data;
+
+  midi_type = ags_lv2_uri_map_manager_uri_to_id(NULL,
+						LV2_EVENT_URI,
+						LV2_MIDI__MidiEvent);
+
+  for(i = 0; i < event_count; i++){
+    /* decode midi sequencer event - channel messages only */
+    count = ags_midi_buffer_util_decode(midi_buffer,
+					&(events[i]));
+
+    if(count == 0 ||
+       count > 4){
+      return(FALSE);
+    }
+    
+    if(AGS_LV2_EVENT_BUFFER(event_buffer)->size + AGS_LV2_PLUGIN_EVENT_MIDI_STRIDE > buffer_size){
+      return(FALSE);
+    }
+
+    /* keep time order, all events have the same stride */
+    position = AGS_LV2_EVENT_BUFFER(event_buffer)->size;
+
+    while(position >= AGS_LV2_PLUGIN_EVENT_MIDI_STRIDE &&
+	  AGS_LV2_EVENT(data + position - AGS_LV2_PLUGIN_EVENT_MIDI_STRIDE)->frames > frame){
+      position -= AGS_LV2_PLUGIN_EVENT_MIDI_STRIDE;
+    }
+
+    if(position < AGS_LV2_EVENT_BUFFER(event_buffer)->size){
+      memmove(data + position + AGS_LV2_PLUGIN_EVENT_MIDI_STRIDE,
+	      data + position,
+	      AGS_LV2_EVENT_BUFFER(event_buffer)->size - position);
+    }
+
+    event = AGS_LV2_EVENT(data + position);
+    
+    event->frames = frame;
+    event->subframes = 0;
+    event->type = midi_type;
+    event->size = count;
+
+    memset(data + position + sizeof(LV2_Event), 0, AGS_LV2_PLUGIN_EVENT_MIDI_STRIDE - sizeof(LV2_Event));
+    memcpy(data + position + sizeof(LV2_Event), midi_buffer, count * sizeof(unsigned char));
+
+    AGS_LV2_EVENT_BUFFER(event_buffer)->size += AGS_LV2_PLUGIN_EVENT_MIDI_STRIDE;
+    AGS_LV2_EVENT_BUFFER(event_buffer)->event_count += 1;
+  }
+
+  return(TRUE);
+}
+
 /**
  * ags_lv2_plugin_alloc_atom_sequence:
  * @sequence_size: the requested size
@@ -2017,6 +2155,128 @@ ags_lv2_plugin_clear_atom_sequence(gpointer atom_sequence,
   memset(atom_sequence, 0, sequence_size);
 }
 
+/**
+ * ags_lv2_plugin_atom_sequence_reset:
+ * @atom_sequence: the atom sequence
+ *
+ * Reset @atom_sequence to an empty sequence time stamped in frames. Doesn't
+ * reallocate, so it can be called once per cycle after run().
+ *
+ * Since: 3.5.0
+ */
+void
+ags_lv2_plugin_atom_sequence_reset(gpointer atom_sequence)
+{
+  LV2_Atom_Sequence *aseq;
+
+  if(atom_sequence == NULL){
+    return;
+  }
+
+  aseq = (LV2_Atom_Sequence *) atom_sequence;
+
+  aseq->atom.size = sizeof(LV2_Atom_Sequence_Body);
+  aseq->atom.type = ags_lv2_urid_manager_map(NULL,
+					     LV2_ATOM__Sequence);
+
+  aseq->body.unit = 0;
+  aseq->body.pad = 0;
+}
+
+/**
+ * ags_lv2_plugin_atom_sequence_append_midi_at:
+ * @atom_sequence: the atom sequence
+ * @sequence_size: the atom sequence size
+ * @frame: the frame offset within the period
+ * @events: (type gpointer) (transfer none): the events to write
+ * @event_count: the number of events to write
+ *
+ * Append MIDI data to atom sequence time stamped with @frame. The tail is
+ * given by the sequence's atom size, so appending in time order is O(1). An
+ * earlier @frame is inserted before the later events.
+ *
+ * Returns: %TRUE on success otherwise %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_lv2_plugin_atom_sequence_append_midi_at(gpointer atom_sequence,
+					    guint sequence_size,
+					    guint frame,
+					    snd_seq_event_t *events,
+					    guint event_count)
+{
+  LV2_Atom_Sequence *aseq;
+  LV2_Atom_Event *aev;
+
+  guint8 *contents;
+  
+  unsigned char midi_buffer[8];
+
+  LV2_URID midi_type;
+  guint used;
+  guint position;
+  guint count;
+  guint i;
+
+  if(atom_sequence == NULL ||
+     events == NULL){
+    return(FALSE);
+  }
+
+  aseq = (LV2_Atom_Sequence *) atom_sequence;
+
+  contents = (guint8 *) LV2_ATOM_CONTENTS(LV2_Atom_Sequence, aseq);
+
+  midi_type = ags_lv2_urid_manager_map(NULL,
+				       LV2_MIDI__MidiEvent);
+
+  for(i = 0; i < event_count; i++){
+    /* decode midi sequencer event */
+    count = ags_midi_buffer_util_decode(midi_buffer,
+					&(events[i]));
+
+    if(count == 0 ||
+       count > 8){
+      return(FALSE);
+    }
+
+    used = aseq->atom.size - sizeof(LV2_Atom_Sequence_Body);
+    
+    if(used + AGS_LV2_PLUGIN_ATOM_MIDI_STRIDE > sequence_size){
+      return(FALSE);
+    }
+
+    /* keep time order, all events have the same stride */
+    position = used;
+
+    while(position >= AGS_LV2_PLUGIN_ATOM_MIDI_STRIDE &&
+	  ((LV2_Atom_Event *) (contents + position - AGS_LV2_PLUGIN_ATOM_MIDI_STRIDE))->time.frames > frame){
+      position -= AGS_LV2_PLUGIN_ATOM_MIDI_STRIDE;
+    }
+
+    if(position < used){
+      memmove(contents + position + AGS_LV2_PLUGIN_ATOM_MIDI_STRIDE,
+	      contents + position,
+	      used - position);
+    }
+
+    aev = (LV2_Atom_Event *) (contents + position);
+
+    aev->time.frames = frame;
+
+    aev->body.size = count;
+    aev->body.type = midi_type;
+
+    memset(LV2_ATOM_BODY(&(aev->body)), 0, AGS_LV2_PLUGIN_ATOM_MIDI_STRIDE - sizeof(LV2_Atom_Event));
+    memcpy(LV2_ATOM_BODY(&(aev->body)), midi_buffer, count * sizeof(unsigned char));
+
+    aseq->atom.size += AGS_LV2_PLUGIN_ATOM_MIDI_STRIDE;
+  }
+
+  return(TRUE);
+}
+
 /**
  * ags_lv2_plugin_find_uri:
  * @lv2_plugin: (element-type AgsAudio.Lv2Plugin) (transfer none): a #GList-struct containig #AgsLv2Plugin
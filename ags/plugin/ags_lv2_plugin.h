@@ -58,6 +58,9 @@ G_BEGIN_DECLS
   
 #define AGS_LV2_EVENT_BUFFER(ptr) ((LV2_Event_Buffer *)(ptr))
 #define AGS_LV2_EVENT(ptr) ((LV2_Event *)(ptr))
+
+#define AGS_LV2_PLUGIN_EVENT_MIDI_STRIDE (sizeof(LV2_Event) + 4)
+#define AGS_LV2_PLUGIN_ATOM_MIDI_STRIDE (sizeof(LV2_Atom_Event) + 8)
 #define AGS_LV2_EVENT_DATA(ptr) ((void *)(ptr + sizeof(LV2_Event)))
 
 #define AGS_LV2_ATOM_SEQUENCE(ptr) ((LV2_Atom_Sequence *)(ptr))
@@ -138,6 +141,13 @@ gboolean ags_lv2_plugin_event_buffer_remove_midi(gpointer event_buffer,
 void ags_lv2_plugin_clear_event_buffer(gpointer event_buffer,
 				       guint buffer_size);
 
+void ags_lv2_plugin_event_buffer_reset(gpointer event_buffer);
+gboolean ags_lv2_plugin_event_buffer_append_midi_at(gpointer event_buffer,
+						    guint buffer_size,
+						    guint frame,
+						    snd_seq_event_t *events,
+						    guint event_count);
+
 gpointer ags_lv2_plugin_alloc_atom_sequence(guint sequence_size);
 void ags_lv2_plugin_atom_sequence_free(gpointer atom_sequence);
 
@@ -151,6 +161,13 @@ gboolean ags_lv2_plugin_atom_sequence_remove_midi(gpointer atom_sequence,
 void ags_lv2_plugin_clear_atom_sequence(gpointer atom_sequence,
 					guint sequence_size);
 
+void ags_lv2_plugin_atom_sequence_reset(gpointer atom_sequence);
+gboolean ags_lv2_plugin_atom_sequence_append_midi_at(gpointer atom_sequence,
+						     guint sequence_size,
+						     guint frame,
+						     snd_seq_event_t *events,
+						     guint event_count);
+
 GList* ags_lv2_plugin_find_uri(GList *lv2_plugin,
 			       gchar *uri);
 GList* ags_lv2_plugin_find_pname(GList *lv2_plugin,
@@ -18,6 +18,10 @@
  */
 
 #include <ags/plugin/ags_lv2_worker.h>
+#include <ags/plugin/ags_lv2_worker_manager.h>
+
+#include <stdlib.h>
+#include <string.h>
 
 #include <ags/i18n.h>
 
@@ -35,6 +39,19 @@ void ags_lv2_worker_get_property(GObject *gobject,
 void ags_lv2_worker_dispose(GObject *gobject);
 void ags_lv2_worker_finalize(GObject *gobject);
 
+void ags_lv2_worker_ring_copy_in(guint8 *ring, guint ring_size,
+				 guint position,
+				 const void *data, guint data_size);
+void ags_lv2_worker_ring_copy_out(guint8 *ring, guint ring_size,
+				  guint position,
+				  void *data, guint data_size);
+gboolean ags_lv2_worker_ring_write(guint8 *ring, guint ring_size,
+				   volatile guint *read_index, volatile guint *write_index,
+				   uint32_t data_size, const void *data);
+gboolean ags_lv2_worker_ring_read(guint8 *ring, guint ring_size,
+				  volatile guint *read_index, volatile guint *write_index,
+				  uint32_t *data_size, void *data);
+
 /**
  * SECTION:ags_lv2_worker
  * @short_description: LV2 worker thread
@@ -43,6 +60,14 @@ void ags_lv2_worker_finalize(GObject *gobject);
  * @include: ags/plugin/ags_lv2_worker.h
  *
  * The #AgsLv2Worker acts as task queue thread.
+ *
+ * Work requests and responses are copied into per instance single producer,
+ * single consumer byte rings of bounded size. Requests are processed by the
+ * shared pool of #AgsLv2WorkerManager and responses are delivered on the
+ * audio thread by ags_lv2_worker_deliver_response() before run() is called.
+ *
+ * Every plugin instance has its own #AgsLv2Worker, which owns the instance's
+ * LV2_Worker_Schedule feature and is released with the instance.
  */
 
 enum{
@@ -221,6 +246,41 @@ ags_lv2_worker_init(AgsLv2Worker *lv2_worker)
   lv2_worker->response_data = NULL;
   
   lv2_worker->worker_thread = NULL;
+
+  /* ring */
+  lv2_worker->worker_manager = NULL;
+  
+  g_atomic_int_set(&(lv2_worker->busy),
+		   FALSE);
+
+  g_mutex_init(&(lv2_worker->busy_mutex));
+  g_cond_init(&(lv2_worker->busy_cond));
+
+  lv2_worker->ring_size = AGS_LV2_WORKER_DEFAULT_RING_SIZE;
+
+  lv2_worker->request_ring = (guint8 *) g_malloc(lv2_worker->ring_size * sizeof(guint8));
+
+  g_atomic_int_set(&(lv2_worker->request_read),
+		   0);
+  g_atomic_int_set(&(lv2_worker->request_write),
+		   0);
+
+  lv2_worker->response_ring = (guint8 *) g_malloc(lv2_worker->ring_size * sizeof(guint8));
+
+  g_atomic_int_set(&(lv2_worker->response_read),
+		   0);
+  g_atomic_int_set(&(lv2_worker->response_write),
+		   0);
+
+  lv2_worker->request_buffer = (guint8 *) g_malloc(lv2_worker->ring_size * sizeof(guint8));
+  lv2_worker->response_buffer = (guint8 *) g_malloc(lv2_worker->ring_size * sizeof(guint8));
+
+  g_atomic_int_set(&(lv2_worker->dropped),
+		   0);
+
+  /* instance features */
+  lv2_worker->worker_schedule = NULL;
+  lv2_worker->feature = NULL;
 }
 
 void
@@ -421,6 +481,24 @@ ags_lv2_worker_finalize(GObject *gobject)
     g_object_unref(lv2_worker->worker_thread);
   }
 
+  /* ring */
+  g_free(lv2_worker->request_ring);
+  g_free(lv2_worker->response_ring);
+
+  g_free(lv2_worker->request_buffer);
+  g_free(lv2_worker->response_buffer);
+
+  g_mutex_clear(&(lv2_worker->busy_mutex));
+  g_cond_clear(&(lv2_worker->busy_cond));
+
+  /* instance features - only the schedule feature is owned, the others are shared by the plugin */
+  if(lv2_worker->feature != NULL){
+    free(lv2_worker->feature[0]);
+    free(lv2_worker->feature);
+  }
+
+  free(lv2_worker->worker_schedule);
+
   /* call parent */
   G_OBJECT_CLASS(ags_lv2_worker_parent_class)->finalize(gobject);
 }
@@ -518,6 +596,126 @@ ags_lv2_worker_unset_flags(AgsLv2Worker *lv2_worker, guint flags)
   g_rec_mutex_unlock(lv2_worker_mutex);
 }
 
+void
+ags_lv2_worker_ring_copy_in(guint8 *ring, guint ring_size,
+			    guint position,
+			    const void *data, guint data_size)
+{
+  guint offset;
+  guint first;
+
+  if(data_size == 0){
+    return;
+  }
+  
+  offset = position & (ring_size - 1);
+  first = ring_size - offset;
+
+  if(first > data_size){
+    first = data_size;
+  }
+  
+  memcpy(ring + offset, data, first);
+
+  if(first < data_size){
+    memcpy(ring, ((guint8 *) data) + first, data_size - first);
+  }
+}
+
+void
+ags_lv2_worker_ring_copy_out(guint8 *ring, guint ring_size,
+			     guint position,
+			     void *data, guint data_size)
+{
+  guint offset;
+  guint first;
+
+  if(data_size == 0){
+    return;
+  }
+
+  offset = position & (ring_size - 1);
+  first = ring_size - offset;
+
+  if(first > data_size){
+    first = data_size;
+  }
+  
+  memcpy(data, ring + offset, first);
+
+  if(first < data_size){
+    memcpy(((guint8 *) data) + first, ring, data_size - first);
+  }
+}
+
+gboolean
+ags_lv2_worker_ring_write(guint8 *ring, guint ring_size,
+			  volatile guint *read_index, volatile guint *write_index,
+			  uint32_t data_size, const void *data)
+{
+  guint read_position, write_position;
+  guint total;
+
+  total = sizeof(uint32_t) + data_size;
+
+  if(data_size >= ring_size ||
+     total > ring_size){
+    return(FALSE);
+  }
+  
+  read_position = g_atomic_int_get(read_index);
+  write_position = g_atomic_int_get(write_index);
+
+  /* bounded - never overwrite pending entries */
+  if(total > ring_size - (write_position - read_position)){
+    return(FALSE);
+  }
+
+  ags_lv2_worker_ring_copy_in(ring, ring_size,
+			      write_position,
+			      &data_size, sizeof(uint32_t));
+  ags_lv2_worker_ring_copy_in(ring, ring_size,
+			      write_position + sizeof(uint32_t),
+			      data, data_size);
+
+  /* publish */
+  g_atomic_int_set(write_index,
+		   write_position + total);
+  
+  return(TRUE);
+}
+
+gboolean
+ags_lv2_worker_ring_read(guint8 *ring, guint ring_size,
+			 volatile guint *read_index, volatile guint *write_index,
+			 uint32_t *data_size, void *data)
+{
+  guint read_position, write_position;
+  uint32_t size;
+
+  read_position = g_atomic_int_get(read_index);
+  write_position = g_atomic_int_get(write_index);
+
+  if(write_position - read_position < sizeof(uint32_t)){
+    return(FALSE);
+  }
+
+  ags_lv2_worker_ring_copy_out(ring, ring_size,
+			       read_position,
+			       &size, sizeof(uint32_t));
+  ags_lv2_worker_ring_copy_out(ring, ring_size,
+			       read_position + sizeof(uint32_t),
+			       data, size);
+
+  /* release */
+  g_atomic_int_set(read_index,
+		   read_position + sizeof(uint32_t) + size);
+
+  data_size[0] = size;
+  
+  return(TRUE);
+}
+
 /**
  * ags_lv2_worker_alloc_response_data:
  * 
@@ -560,7 +758,8 @@ ags_lv2_worker_free_response_data(AgsLv2WorkerResponseData *response_data)
  * @data_size: the data size
  * @data: the data
  *
- * Respond lv2 worker @handle.
+ * Respond lv2 worker @handle. The @data is copied into the response ring
+ * and delivered by ags_lv2_worker_deliver_response().
  * 
  * Returns: LV2_Worker_Status
  * 
@@ -572,27 +771,21 @@ ags_lv2_worker_respond(LV2_Worker_Respond_Handle handle,
 		       const void* data)
 {
   AgsLv2Worker *lv2_worker;
-  AgsLv2WorkerResponseData *response_data;
-
-  GRecMutex *lv2_worker_mutex;
 
-  lv2_worker = AGS_LV2_WORKER(handle);
+  if(!AGS_IS_LV2_WORKER(handle)){
+    return(LV2_WORKER_ERR_UNKNOWN);
+  }
   
-  /* get lv2 worker mutex */
-  lv2_worker_mutex = AGS_LV2_WORKER_GET_OBJ_MUTEX(lv2_worker);
-
-  /* allocate response data */
-  response_data = ags_lv2_worker_alloc_response_data();
-
-  response_data->data_size = data_size;
-  response_data->data = data;
-
-  g_rec_mutex_lock(lv2_worker_mutex);
-
-  lv2_worker->response_data = g_list_prepend(lv2_worker->response_data,
-					     response_data);
+  lv2_worker = AGS_LV2_WORKER(handle);
 
-  g_rec_mutex_unlock(lv2_worker_mutex);
+  /* copy response data */
+  if(!ags_lv2_worker_ring_write(lv2_worker->response_ring, lv2_worker->ring_size,
+				&(lv2_worker->response_read), &(lv2_worker->response_write),
+				data_size, data)){
+    g_atomic_int_inc(&(lv2_worker->dropped));
+    
+    return(LV2_WORKER_ERR_NO_SPACE);
+  }
   
   return(LV2_WORKER_SUCCESS);
 }
@@ -615,63 +808,80 @@ ags_lv2_worker_schedule_work(LV2_Worker_Schedule_Handle handle,
 			     const void* data)
 {
   AgsLv2Worker *lv2_worker;
+  AgsLv2WorkerManager *worker_manager;
 
-  GRecMutex *lv2_worker_mutex;
-
-  lv2_worker = AGS_LV2_WORKER(handle);
+  if(!AGS_IS_LV2_WORKER(handle)){
+    return(LV2_WORKER_ERR_UNKNOWN);
+  }
   
-  /* get lv2 worker mutex */
-  lv2_worker_mutex = AGS_LV2_WORKER_GET_OBJ_MUTEX(lv2_worker);
-
-  /* apply work data and size */
-  g_rec_mutex_lock(lv2_worker_mutex);
-
-  lv2_worker->work_size = (guint) data_size;
-  lv2_worker->work_data = data;
+  lv2_worker = AGS_LV2_WORKER(handle);
 
-  g_rec_mutex_unlock(lv2_worker_mutex);
+  worker_manager = (AgsLv2WorkerManager *) lv2_worker->worker_manager;
 
-  /* set flags */
-  ags_lv2_worker_set_flags(lv2_worker, AGS_LV2_WORKER_RUN);
+  /* counted before written, so the pool never consumes an uncounted request */
+  if(worker_manager != NULL){
+    g_atomic_int_inc(&(worker_manager->n_pending));
+  }
+  
+  /* copy work data - called from run() */
+  if(!ags_lv2_worker_ring_write(lv2_worker->request_ring, lv2_worker->ring_size,
+				&(lv2_worker->request_read), &(lv2_worker->request_write),
+				data_size, data)){
+    g_atomic_int_inc(&(lv2_worker->dropped));
+
+    if(worker_manager != NULL){
+      g_atomic_int_add(&(worker_manager->n_pending),
+		       -1);
+    }
+    
+    return(LV2_WORKER_ERR_NO_SPACE);
+  }
 
+  /* wake up shared pool */
+  ags_lv2_worker_manager_wakeup(worker_manager);
+  
   return(LV2_WORKER_SUCCESS);
 }
 
 /**
- * ags_lv2_worker_do_poll:
- * @worker_thread: the #AgsWorkerThread
- * @data: the data
+ * ags_lv2_worker_process:
+ * @lv2_worker: the #AgsLv2Worker
  * 
- * Safe run callback.
+ * Process all pending work requests of @lv2_worker by calling the plugin's
+ * work() function. Never called concurrently for the same @lv2_worker, if
+ * an other thread is processing the requests it returns immediately.
  * 
- * Since: 3.0.0
+ * Returns: the count of processed requests
+ * 
+ * Since: 3.5.0
  */
-void
-ags_lv2_worker_do_poll(AgsWorkerThread *worker_thread, gpointer data)
+guint
+ags_lv2_worker_process(AgsLv2Worker *lv2_worker)
 {
-  AgsLv2Worker *lv2_worker;
-
-  LV2_Handle handle;
+  AgsLv2WorkerManager *worker_manager;
   
-  GList *response_data_start, *response_data;
-
-  guint work_size;
-  gpointer work_data;
+  LV2_Handle handle;
 
+  uint32_t data_size;
+  guint count;
+  
   LV2_Worker_Status (*work)(LV2_Handle instance,
 			    LV2_Worker_Respond_Function respond,
 			    LV2_Worker_Respond_Handle handle,
 			    uint32_t data_size,
 			    const void* data);
-  LV2_Worker_Status (*work_response)(LV2_Handle instance,
-				     uint32_t size,
-				     const void* body);
-  LV2_Worker_Status (*end_run)(LV2_Handle instance);
   
   GRecMutex *lv2_worker_mutex;
 
-  lv2_worker = data;
+  if(!AGS_IS_LV2_WORKER(lv2_worker)){
+    return(0);
+  }
 
+  /* single consumer */
+  if(!g_atomic_int_compare_and_exchange(&(lv2_worker->busy), FALSE, TRUE)){
+    return(0);
+  }
+  
   /* get lv2 worker mutex */
   lv2_worker_mutex = AGS_LV2_WORKER_GET_OBJ_MUTEX(lv2_worker);
 
@@ -679,72 +889,175 @@ ags_lv2_worker_do_poll(AgsWorkerThread *worker_thread, gpointer data)
   g_rec_mutex_lock(lv2_worker_mutex);
 
   handle = lv2_worker->handle;
-  
-  work_size = lv2_worker->work_size;
-  work_data = lv2_worker->work_data;
 
-  if(lv2_worker->worker_interface == NULL){
-    g_rec_mutex_unlock(lv2_worker_mutex);
-    
-    return;    
+  work = NULL;
+  
+  if(lv2_worker->worker_interface != NULL){
+    work = lv2_worker->worker_interface->work;
   }
   
-  work = lv2_worker->worker_interface->work;
-  work_response = lv2_worker->worker_interface->work_response;
-  end_run = lv2_worker->worker_interface->end_run;
+  worker_manager = (AgsLv2WorkerManager *) lv2_worker->worker_manager;
+  
+  lv2_worker->flags |= (AGS_LV2_WORKER_RUN | AGS_LV2_WORKER_BUSY);
   
   g_rec_mutex_unlock(lv2_worker_mutex);
 
-  /* work */
-  if(ags_lv2_worker_test_flags(lv2_worker, AGS_LV2_WORKER_RUN)){
-    work(handle,
-	 ags_lv2_worker_respond,
-	 lv2_worker,
-	 (uint32_t) (work_size),
-	 work_data);
+  /* work - requests of a vanished instance are discarded */
+  count = 0;
+  
+  while(ags_lv2_worker_ring_read(lv2_worker->request_ring, lv2_worker->ring_size,
+				 &(lv2_worker->request_read), &(lv2_worker->request_write),
+				 &data_size, lv2_worker->request_buffer)){
+    if(handle != NULL &&
+       work != NULL){
+      work(handle,
+	   ags_lv2_worker_respond,
+	   lv2_worker,
+	   data_size,
+	   lv2_worker->request_buffer);
+    }
     
-    g_rec_mutex_lock(lv2_worker_mutex);
+    count++;
+  }
 
-    lv2_worker->work_size = 0;
-    lv2_worker->work_data = NULL;
+  if(worker_manager != NULL &&
+     count > 0){
+    g_atomic_int_add(&(worker_manager->n_pending),
+		     -1 * (gint) count);
+  }
+  
+  /* reset and wake up ags_lv2_worker_wait_idle() */
+  ags_lv2_worker_unset_flags(lv2_worker, (AGS_LV2_WORKER_RUN | AGS_LV2_WORKER_BUSY));
 
-    g_rec_mutex_unlock(lv2_worker_mutex);
-    
-    /* response data */
-    g_rec_mutex_lock(lv2_worker_mutex);
+  g_mutex_lock(&(lv2_worker->busy_mutex));
+  
+  g_atomic_int_set(&(lv2_worker->busy),
+		   FALSE);
 
-    response_data =
-      response_data_start = g_list_copy(lv2_worker->response_data);
+  g_cond_broadcast(&(lv2_worker->busy_cond));
 
-    g_rec_mutex_lock(lv2_worker_mutex);
+  g_mutex_unlock(&(lv2_worker->busy_mutex));
   
-    while(response_data != NULL){
-      work_response(handle,
-		    AGS_LV2_WORKER_RESPONSE_DATA(response_data->data)->data_size,
-		    AGS_LV2_WORKER_RESPONSE_DATA(response_data->data)->data);
-      
-      response_data = response_data->next;
+  return(count);
+}
+
+/**
+ * ags_lv2_worker_wait_idle:
+ * @lv2_worker: the #AgsLv2Worker
+ * 
+ * Wait until no thread is processing the requests of @lv2_worker.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_lv2_worker_wait_idle(AgsLv2Worker *lv2_worker)
+{
+  if(!AGS_IS_LV2_WORKER(lv2_worker)){
+    return;
+  }
+
+  g_mutex_lock(&(lv2_worker->busy_mutex));
+  
+  while(g_atomic_int_get(&(lv2_worker->busy))){
+    g_cond_wait(&(lv2_worker->busy_cond),
+		&(lv2_worker->busy_mutex));
+  }
+
+  g_mutex_unlock(&(lv2_worker->busy_mutex));
+}
+
+/**
+ * ags_lv2_worker_deliver_response:
+ * @lv2_worker: the #AgsLv2Worker
+ * 
+ * Deliver all pending responses of @lv2_worker by calling the plugin's
+ * work_response() function. Call it on the audio thread before run().
+ * 
+ * Returns: the count of delivered responses
+ * 
+ * Since: 3.5.0
+ */
+guint
+ags_lv2_worker_deliver_response(AgsLv2Worker *lv2_worker)
+{
+  LV2_Handle handle;
+  LV2_Worker_Interface *worker_interface;
+
+  uint32_t data_size;
+  guint count;
+  
+  if(lv2_worker == NULL){
+    return(0);
+  }
+
+  /* handle and interface are set once by instantiate */
+  handle = g_atomic_pointer_get(&(lv2_worker->handle));
+  worker_interface = g_atomic_pointer_get(&(lv2_worker->worker_interface));
+
+  count = 0;
+  
+  while(ags_lv2_worker_ring_read(lv2_worker->response_ring, lv2_worker->ring_size,
+				 &(lv2_worker->response_read), &(lv2_worker->response_write),
+				 &data_size, lv2_worker->response_buffer)){
+    if(handle != NULL &&
+       worker_interface != NULL &&
+       worker_interface->work_response != NULL){
+      worker_interface->work_response(handle,
+				      data_size,
+				      lv2_worker->response_buffer);
     }
 
-    /* free response data */
-    g_rec_mutex_lock(lv2_worker_mutex);
-    
-    g_list_free_full(response_data_start,
-		     (GDestroyNotify) ags_lv2_worker_free_response_data);
-    
-    g_list_free(lv2_worker->response_data);
-    lv2_worker->response_data = NULL;
-    
-    g_rec_mutex_unlock(lv2_worker_mutex);
+    count++;
+  }
+
+  return(count);
+}
 
-    /* end run */
-    end_run(handle);
+/**
+ * ags_lv2_worker_end_run:
+ * @lv2_worker: the #AgsLv2Worker
+ * 
+ * Call the plugin's end_run() function, if provided. Call it on the audio
+ * thread after run().
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_lv2_worker_end_run(AgsLv2Worker *lv2_worker)
+{
+  LV2_Handle handle;
+  LV2_Worker_Interface *worker_interface;
+
+  if(lv2_worker == NULL){
+    return;
+  }
+
+  handle = g_atomic_pointer_get(&(lv2_worker->handle));
+  worker_interface = g_atomic_pointer_get(&(lv2_worker->worker_interface));
 
-    /* reset */
-    ags_lv2_worker_unset_flags(lv2_worker, AGS_LV2_WORKER_RUN);
+  if(handle != NULL &&
+     worker_interface != NULL &&
+     worker_interface->end_run != NULL){
+    worker_interface->end_run(handle);
   }
 }
 
+/**
+ * ags_lv2_worker_do_poll:
+ * @worker_thread: the #AgsWorkerThread
+ * @data: the data
+ * 
+ * Safe run callback, processes pending requests. The responses are
+ * delivered by ags_lv2_worker_deliver_response().
+ * 
+ * Since: 3.0.0
+ */
+void
+ags_lv2_worker_do_poll(AgsWorkerThread *worker_thread, gpointer data)
+{
+  ags_lv2_worker_process((AgsLv2Worker *) data);
+}
+
 /**
  * ags_lv2_worker_new:
  *
@@ -41,6 +41,8 @@ G_BEGIN_DECLS
 
 #define AGS_LV2_WORKER_RESPONSE_DATA(ptr) ((AgsLv2WorkerResponseData *)(ptr))
 
+#define AGS_LV2_WORKER_DEFAULT_RING_SIZE (65536)
+
 typedef struct _AgsLv2Worker AgsLv2Worker;
 typedef struct _AgsLv2WorkerClass AgsLv2WorkerClass;
 typedef struct _AgsLv2WorkerResponseData AgsLv2WorkerResponseData;
@@ -48,12 +50,14 @@ typedef struct _AgsLv2WorkerResponseData AgsLv2WorkerResponseData;
 /**
  * AgsLv2WorkerFlags:
  * @AGS_LV2_WORKER_RUN: the worker is running
+ * @AGS_LV2_WORKER_BUSY: a pool thread is processing requests
  * 
  * Enum values to control the behavior or indicate internal state of #AgsLv2Worker by
  * enable/disable as flags.
  */
 typedef enum{
   AGS_LV2_WORKER_RUN    = 1,
+  AGS_LV2_WORKER_BUSY   = 1 <<  1,
 }AgsLv2WorkerFlags;
 
 struct _AgsLv2Worker
@@ -67,12 +71,37 @@ struct _AgsLv2Worker
   LV2_Handle handle;
   LV2_Worker_Interface *worker_interface;
 
+  LV2_Worker_Schedule *worker_schedule;
+  LV2_Feature **feature;
+
   guint work_size;
   void *work_data;
   
   GList *response_data;
   
   AgsThread *worker_thread;
+
+  GObject *worker_manager;
+  
+  volatile gint busy;
+
+  GMutex busy_mutex;
+  GCond busy_cond;
+  
+  guint ring_size;
+  
+  guint8 *request_ring;
+  volatile guint request_read;
+  volatile guint request_write;
+
+  guint8 *response_ring;
+  volatile guint response_read;
+  volatile guint response_write;
+
+  guint8 *request_buffer;
+  guint8 *response_buffer;
+
+  volatile guint dropped;
 };
 
 struct _AgsLv2WorkerClass
@@ -103,6 +132,12 @@ LV2_Worker_Status ags_lv2_worker_schedule_work(LV2_Worker_Schedule_Handle handle
 					       uint32_t data_size,
 					       const void* data);
 
+guint ags_lv2_worker_process(AgsLv2Worker *lv2_worker);
+void ags_lv2_worker_wait_idle(AgsLv2Worker *lv2_worker);
+
+guint ags_lv2_worker_deliver_response(AgsLv2Worker *lv2_worker);
+void ags_lv2_worker_end_run(AgsLv2Worker *lv2_worker);
+
 void ags_lv2_worker_do_poll(AgsWorkerThread *worker_thread, gpointer data);
 
 AgsLv2Worker* ags_lv2_worker_new();
@@ -26,6 +26,11 @@ void ags_lv2_worker_manager_class_init(AgsLv2WorkerManagerClass *lv2_worker_mana
 void ags_lv2_worker_manager_init(AgsLv2WorkerManager *lv2_worker_manager);
 void ags_lv2_worker_manager_finalize(GObject *gobject);
 
+void ags_lv2_worker_manager_pool_post(AgsLv2WorkerManager *worker_manager);
+void ags_lv2_worker_manager_pool_wait(AgsLv2WorkerManager *worker_manager);
+
+void* ags_lv2_worker_manager_pool_thread(void *ptr);
+
 /**
  * SECTION:ags_lv2_worker_manager
  * @short_description: manage workers
@@ -33,7 +38,12 @@ void ags_lv2_worker_manager_finalize(GObject *gobject);
  * @section_id:
  * @include: ags/plugin/ags_lv2_worker_manager.h
  *
- * The #AgsLv2WorkerManager tracks your workers.
+ * The #AgsLv2WorkerManager tracks your workers. It runs a shared pool of
+ * threads processing the work requests of all #AgsLv2Worker instances, so
+ * there is no thread per plugin instance.
+ *
+ * Requests are counted and posted to a semaphore, so the audio thread hands
+ * off work without taking a lock.
  */
 
 static gpointer ags_lv2_worker_manager_parent_class = NULL;
@@ -88,12 +98,36 @@ ags_lv2_worker_manager_class_init(AgsLv2WorkerManagerClass *lv2_worker_manager)
 void
 ags_lv2_worker_manager_init(AgsLv2WorkerManager *worker_manager)
 {
+  worker_manager->flags = 0;
+
+  g_rec_mutex_init(&(worker_manager->obj_mutex));
+  
   worker_manager->thread_pool = NULL;
 
   g_atomic_pointer_set(&(worker_manager->worker),
 		       NULL);
-  
-  /* empty */
+
+  worker_manager->handle_worker = g_hash_table_new(g_direct_hash,
+						   g_direct_equal);
+
+  /* shared pool */
+  worker_manager->n_threads = 0;
+  worker_manager->pool_thread = NULL;
+
+#if defined(__APPLE__)
+  worker_manager->pool_semaphore = dispatch_semaphore_create(0);
+#elif defined(AGS_W32API)
+  worker_manager->pool_semaphore = CreateSemaphore(NULL,
+						   0, G_MAXINT32,
+						   NULL);
+#else
+  sem_init(&(worker_manager->pool_semaphore),
+	   0,
+	   0);
+#endif
+
+  g_atomic_int_set(&(worker_manager->n_pending),
+		   0);
 }
 
 void
@@ -103,8 +137,20 @@ ags_lv2_worker_manager_finalize(GObject *gobject)
 
   lv2_worker_manager = AGS_LV2_WORKER_MANAGER(gobject);
 
+  ags_lv2_worker_manager_stop_pool(lv2_worker_manager);
+
+  g_hash_table_destroy(lv2_worker_manager->handle_worker);
+
   g_list_free_full(g_atomic_pointer_get(&(lv2_worker_manager->worker)),
 		   g_object_unref);
+
+#if defined(__APPLE__)
+  dispatch_release(lv2_worker_manager->pool_semaphore);
+#elif defined(AGS_W32API)
+  CloseHandle(lv2_worker_manager->pool_semaphore);
+#else
+  sem_destroy(&(lv2_worker_manager->pool_semaphore));
+#endif
   
   if(lv2_worker_manager == ags_lv2_worker_manager){
     ags_lv2_worker_manager = NULL;
@@ -118,9 +164,9 @@ ags_lv2_worker_manager_finalize(GObject *gobject)
  * ags_lv2_worker_manager_pull_worker:
  * @worker_manager: the #AgsLv2WorkerManager
  * 
- * Pull worker.
+ * Pull worker, processed by the shared worker pool.
  * 
- * Returns: (transfer full): the #AgsWorkerThread
+ * Returns: (transfer full): the #AgsLv2Worker
  * 
  * Since: 3.0.0
  */
@@ -128,26 +174,415 @@ GObject*
 ags_lv2_worker_manager_pull_worker(AgsLv2WorkerManager *worker_manager)
 {
   AgsLv2Worker *lv2_worker;
-  AgsThread *thread;
+
+  GRecMutex *worker_manager_mutex;
 
   if(!AGS_IS_LV2_WORKER_MANAGER(worker_manager)){
     return(NULL);
   }
-  
-  thread = ags_worker_thread_new();
+
+  worker_manager_mutex = AGS_LV2_WORKER_MANAGER_GET_OBJ_MUTEX(worker_manager);
   
   lv2_worker = g_object_new(AGS_TYPE_LV2_WORKER,
-			    "worker-thread", thread,
 			    NULL);
 
-  g_signal_connect(thread, "do-poll",
-		   G_CALLBACK(ags_lv2_worker_do_poll), lv2_worker);
+  lv2_worker->worker_manager = (GObject *) worker_manager;
+
+  /* processed by shared pool */
+  g_rec_mutex_lock(worker_manager_mutex);
+
+  g_atomic_pointer_set(&(worker_manager->worker),
+		       g_list_prepend(g_atomic_pointer_get(&(worker_manager->worker)),
+				      lv2_worker));
+  g_object_ref(lv2_worker);
+  
+  g_rec_mutex_unlock(worker_manager_mutex);
+
+  ags_lv2_worker_manager_start_pool(worker_manager);
+  
+  return((GObject *) lv2_worker);
+}
+
+/**
+ * ags_lv2_worker_manager_insert_handle:
+ * @worker_manager: the #AgsLv2WorkerManager
+ * @handle: the plugin instance handle
+ * @lv2_worker: the #AgsLv2Worker
+ * 
+ * Map plugin instance @handle to @lv2_worker.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_lv2_worker_manager_insert_handle(AgsLv2WorkerManager *worker_manager,
+				     gpointer handle,
+				     GObject *lv2_worker)
+{
+  GRecMutex *worker_manager_mutex;
+
+  if(!AGS_IS_LV2_WORKER_MANAGER(worker_manager) ||
+     handle == NULL ||
+     !AGS_IS_LV2_WORKER(lv2_worker)){
+    return;
+  }
+
+  worker_manager_mutex = AGS_LV2_WORKER_MANAGER_GET_OBJ_MUTEX(worker_manager);
+
+  g_rec_mutex_lock(worker_manager_mutex);
 
-  ags_thread_start(thread);
+  g_hash_table_insert(worker_manager->handle_worker,
+		      handle,
+		      lv2_worker);
   
+  g_rec_mutex_unlock(worker_manager_mutex);
+}
+
+/**
+ * ags_lv2_worker_manager_remove_handle:
+ * @worker_manager: the #AgsLv2WorkerManager
+ * @handle: the plugin instance handle
+ * 
+ * Remove the #AgsLv2Worker of plugin instance @handle. Waits for the
+ * shared pool to leave the plugin's work() function, so call it before
+ * cleanup().
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_lv2_worker_manager_remove_handle(AgsLv2WorkerManager *worker_manager,
+				     gpointer handle)
+{
+  AgsLv2Worker *lv2_worker;
+
+  GRecMutex *worker_manager_mutex;
+
+  if(!AGS_IS_LV2_WORKER_MANAGER(worker_manager) ||
+     handle == NULL){
+    return;
+  }
+
+  worker_manager_mutex = AGS_LV2_WORKER_MANAGER_GET_OBJ_MUTEX(worker_manager);
+
+  g_rec_mutex_lock(worker_manager_mutex);
+
+  lv2_worker = g_hash_table_lookup(worker_manager->handle_worker,
+				   handle);
+
+  if(lv2_worker == NULL){
+    g_rec_mutex_unlock(worker_manager_mutex);
+
+    return;
+  }
+  
+  g_hash_table_remove(worker_manager->handle_worker,
+		      handle);
+  
+  g_rec_mutex_unlock(worker_manager_mutex);
+
+  ags_lv2_worker_manager_remove_worker(worker_manager,
+				       (GObject *) lv2_worker);
+}
+
+/**
+ * ags_lv2_worker_manager_remove_worker:
+ * @worker_manager: the #AgsLv2WorkerManager
+ * @lv2_worker: the #AgsLv2Worker
+ * 
+ * Remove @lv2_worker pulled by ags_lv2_worker_manager_pull_worker() from the
+ * shared pool and release it, together with the instance features it owns.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_lv2_worker_manager_remove_worker(AgsLv2WorkerManager *worker_manager,
+				     GObject *lv2_worker)
+{
+  GList *start_worker;
+  
+  GRecMutex *worker_manager_mutex;
+  GRecMutex *lv2_worker_mutex;
+
+  if(!AGS_IS_LV2_WORKER_MANAGER(worker_manager) ||
+     !AGS_IS_LV2_WORKER(lv2_worker)){
+    return;
+  }
+
+  worker_manager_mutex = AGS_LV2_WORKER_MANAGER_GET_OBJ_MUTEX(worker_manager);
+
+  g_rec_mutex_lock(worker_manager_mutex);
+
+  start_worker = g_atomic_pointer_get(&(worker_manager->worker));
+
+  if(g_list_find(start_worker, lv2_worker) == NULL){
+    g_rec_mutex_unlock(worker_manager_mutex);
+
+    return;
+  }
+  
+  g_atomic_pointer_set(&(worker_manager->worker),
+		       g_list_remove(start_worker,
+				     lv2_worker));
+  
+  g_rec_mutex_unlock(worker_manager_mutex);
+
+  /* detach instance */
+  lv2_worker_mutex = AGS_LV2_WORKER_GET_OBJ_MUTEX(lv2_worker);
+
+  g_rec_mutex_lock(lv2_worker_mutex);
+
+  g_atomic_pointer_set(&(AGS_LV2_WORKER(lv2_worker)->handle),
+		       NULL);
+  
+  g_rec_mutex_unlock(lv2_worker_mutex);
+
+  ags_lv2_worker_wait_idle((AgsLv2Worker *) lv2_worker);
+
+  /* discard pending requests */
+  ags_lv2_worker_process((AgsLv2Worker *) lv2_worker);
+
+  /* the pool's and the instance's reference */
+  g_object_unref(lv2_worker);
+  g_object_unref(lv2_worker);
+}
+
+/**
+ * ags_lv2_worker_manager_find_worker:
+ * @worker_manager: the #AgsLv2WorkerManager
+ * @handle: the plugin instance handle
+ * 
+ * Find the #AgsLv2Worker of plugin instance @handle.
+ * 
+ * Returns: (transfer none): the #AgsLv2Worker or %NULL
+ * 
+ * Since: 3.5.0
+ */
+GObject*
+ags_lv2_worker_manager_find_worker(AgsLv2WorkerManager *worker_manager,
+				   gpointer handle)
+{
+  GObject *lv2_worker;
+
+  GRecMutex *worker_manager_mutex;
+
+  if(!AGS_IS_LV2_WORKER_MANAGER(worker_manager) ||
+     handle == NULL){
+    return(NULL);
+  }
+
+  worker_manager_mutex = AGS_LV2_WORKER_MANAGER_GET_OBJ_MUTEX(worker_manager);
+
+  g_rec_mutex_lock(worker_manager_mutex);
+
+  lv2_worker = g_hash_table_lookup(worker_manager->handle_worker,
+				   handle);
+  
+  g_rec_mutex_unlock(worker_manager_mutex);
+
   return(lv2_worker);
 }
 
+void
+ags_lv2_worker_manager_pool_post(AgsLv2WorkerManager *worker_manager)
+{
+#if defined(__APPLE__)
+  dispatch_semaphore_signal(worker_manager->pool_semaphore);
+#elif defined(AGS_W32API)
+  ReleaseSemaphore(worker_manager->pool_semaphore,
+		   1,
+		   NULL);
+#else
+  sem_post(&(worker_manager->pool_semaphore));
+#endif
+}
+
+void
+ags_lv2_worker_manager_pool_wait(AgsLv2WorkerManager *worker_manager)
+{
+#if defined(__APPLE__)
+  dispatch_semaphore_wait(worker_manager->pool_semaphore,
+			  DISPATCH_TIME_FOREVER);
+#elif defined(AGS_W32API)
+  WaitForSingleObject(worker_manager->pool_semaphore,
+		      INFINITE);
+#else
+  while(sem_wait(&(worker_manager->pool_semaphore)) != 0);
+#endif
+}
+
+void*
+ags_lv2_worker_manager_pool_thread(void *ptr)
+{
+  AgsLv2WorkerManager *worker_manager;
+
+  GList *start_worker, *worker;
+
+  GRecMutex *worker_manager_mutex;
+
+  worker_manager = AGS_LV2_WORKER_MANAGER(ptr);
+
+  worker_manager_mutex = AGS_LV2_WORKER_MANAGER_GET_OBJ_MUTEX(worker_manager);
+  
+  while(TRUE){
+    /* wait for requests - every request is posted after it was written, so no wakeup is missed */
+    ags_lv2_worker_manager_pool_wait(worker_manager);
+
+    if((AGS_LV2_WORKER_MANAGER_POOL_RUNNING & (g_atomic_int_get(&(worker_manager->flags)))) == 0){
+      break;
+    }
+
+    /* processed along with an earlier request */
+    if(g_atomic_int_get(&(worker_manager->n_pending)) <= 0){
+      continue;
+    }
+
+    /* process */
+    g_rec_mutex_lock(worker_manager_mutex);
+
+    worker =
+      start_worker = g_list_copy_deep(g_atomic_pointer_get(&(worker_manager->worker)),
+				      (GCopyFunc) g_object_ref,
+				      NULL);
+    
+    g_rec_mutex_unlock(worker_manager_mutex);
+
+    while(worker != NULL){
+      ags_lv2_worker_process(worker->data);
+      
+      worker = worker->next;
+    }
+
+    g_list_free_full(start_worker,
+		     (GDestroyNotify) g_object_unref);
+  }
+
+  g_thread_exit(NULL);
+
+  return(NULL);
+}
+
+/**
+ * ags_lv2_worker_manager_start_pool:
+ * @worker_manager: the #AgsLv2WorkerManager
+ * 
+ * Start the shared worker pool, if not running.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_lv2_worker_manager_start_pool(AgsLv2WorkerManager *worker_manager)
+{
+  guint i;
+  
+  GRecMutex *worker_manager_mutex;
+
+  if(!AGS_IS_LV2_WORKER_MANAGER(worker_manager)){
+    return;
+  }
+
+  worker_manager_mutex = AGS_LV2_WORKER_MANAGER_GET_OBJ_MUTEX(worker_manager);
+
+  g_rec_mutex_lock(worker_manager_mutex);
+
+  if((AGS_LV2_WORKER_MANAGER_POOL_RUNNING & (g_atomic_int_get(&(worker_manager->flags)))) != 0){
+    g_rec_mutex_unlock(worker_manager_mutex);
+
+    return;
+  }
+
+  worker_manager->n_threads = g_get_num_processors();
+
+  if(worker_manager->n_threads > AGS_LV2_WORKER_MANAGER_DEFAULT_MAX_THREADS){
+    worker_manager->n_threads = AGS_LV2_WORKER_MANAGER_DEFAULT_MAX_THREADS;
+  }
+
+  g_atomic_int_or(&(worker_manager->flags),
+		  AGS_LV2_WORKER_MANAGER_POOL_RUNNING);
+  
+  worker_manager->pool_thread = (GThread **) g_malloc(worker_manager->n_threads * sizeof(GThread *));
+  
+  for(i = 0; i < worker_manager->n_threads; i++){
+    worker_manager->pool_thread[i] = g_thread_new("Advanced Gtk+ Sequencer - lv2 worker",
+						  ags_lv2_worker_manager_pool_thread,
+						  worker_manager);
+  }
+  
+  g_rec_mutex_unlock(worker_manager_mutex);
+}
+
+/**
+ * ags_lv2_worker_manager_stop_pool:
+ * @worker_manager: the #AgsLv2WorkerManager
+ * 
+ * Stop the shared worker pool and join its threads.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_lv2_worker_manager_stop_pool(AgsLv2WorkerManager *worker_manager)
+{
+  GThread **pool_thread;
+
+  guint n_threads;
+  guint i;
+  
+  GRecMutex *worker_manager_mutex;
+
+  if(!AGS_IS_LV2_WORKER_MANAGER(worker_manager)){
+    return;
+  }
+
+  worker_manager_mutex = AGS_LV2_WORKER_MANAGER_GET_OBJ_MUTEX(worker_manager);
+
+  g_rec_mutex_lock(worker_manager_mutex);
+
+  if((AGS_LV2_WORKER_MANAGER_POOL_RUNNING & (g_atomic_int_get(&(worker_manager->flags)))) == 0){
+    g_rec_mutex_unlock(worker_manager_mutex);
+
+    return;
+  }
+
+  g_atomic_int_and(&(worker_manager->flags),
+		   (~AGS_LV2_WORKER_MANAGER_POOL_RUNNING));
+
+  pool_thread = worker_manager->pool_thread;
+  n_threads = worker_manager->n_threads;
+
+  worker_manager->pool_thread = NULL;
+  worker_manager->n_threads = 0;
+  
+  g_rec_mutex_unlock(worker_manager_mutex);
+
+  /* join */
+  for(i = 0; i < n_threads; i++){
+    ags_lv2_worker_manager_pool_post(worker_manager);
+  }
+
+  for(i = 0; i < n_threads; i++){
+    g_thread_join(pool_thread[i]);
+  }
+
+  g_free(pool_thread);
+}
+
+/**
+ * ags_lv2_worker_manager_wakeup:
+ * @worker_manager: the #AgsLv2WorkerManager
+ * 
+ * Wake up the shared worker pool. Posts the pool semaphore without taking
+ * a lock, so it is safe to be called from the audio thread.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_lv2_worker_manager_wakeup(AgsLv2WorkerManager *worker_manager)
+{
+  if(worker_manager == NULL){
+    return;
+  }
+
+  ags_lv2_worker_manager_pool_post(worker_manager);
+}
+
 /**
  * ags_lv2_worker_manager_get_instance:
  * 
@@ -28,6 +28,14 @@
 #include <lv2.h>
 #include <lv2/lv2plug.in/ns/ext/worker/worker.h>
 
+#if defined(__APPLE__)
+#include <dispatch/dispatch.h>
+#elif defined(AGS_W32API)
+#include <windows.h>
+#else
+#include <semaphore.h>
+#endif
+
 G_BEGIN_DECLS
 
 #define AGS_TYPE_LV2_WORKER_MANAGER                (ags_lv2_worker_manager_get_type())
@@ -39,18 +47,48 @@ G_BEGIN_DECLS
 
 #define AGS_LV2_WORKER_MANAGER_GET_OBJ_MUTEX(obj) (&(((AgsLv2WorkerManager *) obj)->obj_mutex))
 
+#define AGS_LV2_WORKER_MANAGER_DEFAULT_MAX_THREADS (4)
+
 typedef struct _AgsLv2WorkerManager AgsLv2WorkerManager;
 typedef struct _AgsLv2WorkerManagerClass AgsLv2WorkerManagerClass;
 
+/**
+ * AgsLv2WorkerManagerFlags:
+ * @AGS_LV2_WORKER_MANAGER_POOL_RUNNING: the shared worker pool is running
+ * 
+ * Enum values to control the behavior or indicate internal state of #AgsLv2WorkerManager by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_LV2_WORKER_MANAGER_POOL_RUNNING    = 1,
+}AgsLv2WorkerManagerFlags;
+
 struct _AgsLv2WorkerManager
 {
   GObject gobject;
 
+  guint flags;
+  
   GRecMutex obj_mutex;
 
   AgsThreadPool *thread_pool;
   
   volatile GList *worker;
+
+  GHashTable *handle_worker;
+  
+  guint n_threads;
+  GThread **pool_thread;
+
+#if defined(__APPLE__)
+  dispatch_semaphore_t pool_semaphore;
+#elif defined(AGS_W32API)
+  HANDLE pool_semaphore;
+#else
+  sem_t pool_semaphore;
+#endif
+
+  volatile gint n_pending;
 };
 
 struct _AgsLv2WorkerManagerClass
@@ -62,6 +100,21 @@ GType ags_lv2_worker_manager_get_type(void);
 
 GObject* ags_lv2_worker_manager_pull_worker(AgsLv2WorkerManager *worker_manager);
 
+void ags_lv2_worker_manager_insert_handle(AgsLv2WorkerManager *worker_manager,
+					  gpointer handle,
+					  GObject *lv2_worker);
+void ags_lv2_worker_manager_remove_handle(AgsLv2WorkerManager *worker_manager,
+					  gpointer handle);
+void ags_lv2_worker_manager_remove_worker(AgsLv2WorkerManager *worker_manager,
+					  GObject *lv2_worker);
+GObject* ags_lv2_worker_manager_find_worker(AgsLv2WorkerManager *worker_manager,
+					    gpointer handle);
+
+void ags_lv2_worker_manager_start_pool(AgsLv2WorkerManager *worker_manager);
+void ags_lv2_worker_manager_stop_pool(AgsLv2WorkerManager *worker_manager);
+
+void ags_lv2_worker_manager_wakeup(AgsLv2WorkerManager *worker_manager);
+
 AgsLv2WorkerManager* ags_lv2_worker_manager_get_instance();
 AgsLv2WorkerManager* ags_lv2_worker_manager_new();
 
@@ -159,8 +159,12 @@ ags_registry_init(AgsRegistry *registry)
   g_rec_mutex_init(&(registry->obj_mutex));
   
   registry->counter = 0;
+
+  g_rw_lock_init(&(registry->entry_lock));
   
   registry->entry = NULL;
+  registry->entry_table = g_hash_table_new(ags_uuid_hash,
+					   ags_uuid_equal);
 }
 
 void
@@ -264,10 +268,16 @@ ags_registry_dispose(GObject *gobject)
     registry->server = NULL;
   }
 
+  g_rw_lock_writer_lock(&(registry->entry_lock));
+
+  g_hash_table_remove_all(registry->entry_table);
+  
   g_list_free_full(registry->entry,
 		   (GDestroyNotify) ags_registry_entry_free);
 
   registry->entry = NULL;
+
+  g_rw_lock_writer_unlock(&(registry->entry_lock));
   
   /* call parent */
   G_OBJECT_CLASS(ags_registry_parent_class)->dispose(gobject);
@@ -284,9 +294,13 @@ ags_registry_finalize(GObject *gobject)
     g_object_unref(registry->server);
   }
 
+  g_hash_table_destroy(registry->entry_table);
+  
   g_list_free_full(registry->entry,
 		   (GDestroyNotify) ags_registry_entry_free);
 
+  g_rw_lock_clear(&(registry->entry_lock));
+
   /* call parent */
   G_OBJECT_CLASS(ags_registry_parent_class)->finalize(gobject);
 }
@@ -355,21 +369,60 @@ void
 ags_registry_add_entry(AgsRegistry *registry,
 		       AgsRegistryEntry *registry_entry)
 {
-  GRecMutex *registry_mutex;
-
   if(!AGS_IS_REGISTRY(registry) ||
      registry_entry == NULL){
     return;
   }
   
-  registry_mutex = AGS_REGISTRY_GET_OBJ_MUTEX(registry);
-  
-  g_rec_mutex_lock(registry_mutex);
+  g_rw_lock_writer_lock(&(registry->entry_lock));
 
   registry->entry = g_list_prepend(registry->entry,
 				   registry_entry);
 
-  g_rec_mutex_unlock(registry_mutex);
+  /* index by id - entries without id are kept unindexed */
+  if(registry_entry->id != NULL){
+    g_hash_table_insert(registry->entry_table,
+			registry_entry->id,
+			registry_entry);
+  }
+  
+  g_rw_lock_writer_unlock(&(registry->entry_lock));
+}
+
+/**
+ * ags_registry_remove_entry:
+ * @registry: the #AgsRegistry
+ * @registry_entry: the #AgsRegistryEntry-struct to remove
+ * 
+ * Remove @registry_entry from @registry. The entry isn't freed.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_registry_remove_entry(AgsRegistry *registry,
+			  AgsRegistryEntry *registry_entry)
+{
+  if(!AGS_IS_REGISTRY(registry) ||
+     registry_entry == NULL){
+    return;
+  }
+  
+  g_rw_lock_writer_lock(&(registry->entry_lock));
+
+  if(g_list_find(registry->entry,
+		 registry_entry) != NULL){
+    registry->entry = g_list_remove(registry->entry,
+				    registry_entry);
+
+    if(registry_entry->id != NULL &&
+       g_hash_table_lookup(registry->entry_table,
+			   registry_entry->id) == registry_entry){
+      g_hash_table_remove(registry->entry_table,
+			  registry_entry->id);
+    }
+  }
+  
+  g_rw_lock_writer_unlock(&(registry->entry_lock));
 }
 
 /**
@@ -385,37 +438,21 @@ AgsRegistryEntry*
 ags_registry_find_entry(AgsRegistry *registry,
 			AgsUUID *id)
 {
-  GList *current;
   AgsRegistryEntry *entry;
 
-  GRecMutex *registry_mutex;
-
-  if(!AGS_IS_REGISTRY(registry)){
+  if(!AGS_IS_REGISTRY(registry) ||
+     id == NULL){
     return(NULL);
   }
   
-  registry_mutex = AGS_REGISTRY_GET_OBJ_MUTEX(registry);
+  g_rw_lock_reader_lock(&(registry->entry_lock));
 
-  g_rec_mutex_lock(registry_mutex);
+  entry = (AgsRegistryEntry *) g_hash_table_lookup(registry->entry_table,
+						   id);
 
-  current = registry->entry;
-  
-  while(current != NULL){
-    entry = (AgsRegistryEntry *) current->data;
-
-    if(!ags_uuid_compare(entry->id,
-			 id)){
-      g_rec_mutex_unlock(registry_mutex);
-      
-      return(entry);
-    }
-
-    current = current->next;
-  }
-
-  g_rec_mutex_unlock(registry_mutex);
+  g_rw_lock_reader_unlock(&(registry->entry_lock));
 
-  return(NULL);
+  return(entry);
 }
 
 #ifdef AGS_WITH_XMLRPC_C
@@ -435,19 +472,15 @@ ags_registry_entry_bulk(xmlrpc_env *env,
   xmlrpc_value *bulk;
   xmlrpc_value *item;
 
-  GRecMutex *registry_mutex;
-
   server = ags_server_lookup(server_info);
 
   application_context = ags_application_context_get_instance();
 
   registry = ags_service_provider_get_registry(AGS_SERVICE_PROVIDER(application_context));
 
-  registry_mutex = AGS_REGISTRY_GET_OBJ_MUTEX(registry);
-
   bulk = xmlrpc_array_new(env);
 
-  g_rec_mutex_lock(registry_mutex);
+  g_rw_lock_reader_lock(&(registry->entry_lock));
 
   current = registry->entry;
 
@@ -460,7 +493,7 @@ ags_registry_entry_bulk(xmlrpc_env *env,
     current = current->next;
   }
 
-  g_rec_mutex_unlock(registry_mutex);
+  g_rw_lock_reader_unlock(&(registry->entry_lock));
 
   return(bulk);
 }
@@ -65,7 +65,10 @@ struct _AgsRegistry
 
   guint counter;
 
+  GRWLock entry_lock;
+  
   GList *entry;
+  GHashTable *entry_table;
 };
 
 struct _AgsRegistryClass
@@ -93,6 +96,8 @@ void ags_registry_entry_free(AgsRegistryEntry *registry_entry);
 
 void ags_registry_add_entry(AgsRegistry *registry,
 			    AgsRegistryEntry *registry_entry);
+void ags_registry_remove_entry(AgsRegistry *registry,
+			       AgsRegistryEntry *registry_entry);
 
 AgsRegistryEntry* ags_registry_find_entry(AgsRegistry *registry,
 					  AgsUUID *id);
@@ -165,6 +165,16 @@ ags_xml_authentication_init(AgsXmlAuthentication *xml_authentication)
 
   xml_authentication->doc = NULL;
   xml_authentication->root_node = NULL;
+
+  /* index */
+  g_rw_lock_init(&(xml_authentication->index_lock));
+  
+  xml_authentication->user_uuid_index = g_hash_table_new_full(g_str_hash, g_str_equal,
+							      g_free,
+							      NULL);
+  xml_authentication->security_token_index = g_hash_table_new_full(g_str_hash, g_str_equal,
+								   g_free,
+								   NULL);
 }
 
 void
@@ -182,6 +192,11 @@ ags_xml_authentication_finalize(GObject *gobject)
     xmlFreeDoc(xml_authentication->doc);
   }
 
+  g_hash_table_destroy(xml_authentication->user_uuid_index);
+  g_hash_table_destroy(xml_authentication->security_token_index);
+
+  g_rw_lock_clear(&(xml_authentication->index_lock));
+
   /* call parent */
   G_OBJECT_CLASS(ags_xml_authentication_parent_class)->finalize(gobject);
 }
@@ -223,9 +238,6 @@ ags_xml_authentication_login(AgsAuthentication *authentication,
   AgsXmlPasswordStore *xml_password_store;
   AgsSecurityContext *security_context;
   
-  xmlXPathContext *xpath_context; 
-  xmlXPathObject *xpath_object;
-  xmlNode **node;
   xmlNode *auth_node;
   xmlNode *user_node;
   xmlNode *child;
@@ -234,9 +246,7 @@ ags_xml_authentication_login(AgsAuthentication *authentication,
   
   gchar *current_user_uuid;
   gchar *current_security_token;
-  gchar *xpath;
 
-  guint i;
   gboolean success;
 
   GRecMutex *xml_authentication_mutex;
@@ -291,33 +301,8 @@ ags_xml_authentication_login(AgsAuthentication *authentication,
   if(xml_password_store != NULL){
     xml_password_store_mutex = AGS_XML_PASSWORD_STORE_GET_OBJ_MUTEX(xml_password_store);
       
-    xpath = g_strdup_printf("/ags-server-password-store/ags-srv-user-list/ags-srv-user/ags-srv-user-login[text() = '%s']",
-			    login);
-
-    g_rec_mutex_lock(xml_password_store_mutex);
-      
-    xpath_context = xmlXPathNewContext(xml_password_store->doc);
-    xpath_object = xmlXPathEval(xpath,
-				xpath_context);
-
-    if(xpath_object->nodesetval != NULL){
-      node = xpath_object->nodesetval->nodeTab;
-
-      for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
-	if(node[i]->type == XML_ELEMENT_NODE){
-	  user_node = node[i]->parent;
-
-	  break;
-	}
-      }
-    }
-
-    g_rec_mutex_unlock(xml_password_store_mutex);
-
-    xmlXPathFreeObject(xpath_object);
-    xmlXPathFreeContext(xpath_context);
-
-    g_free(xpath);
+    user_node = ags_xml_password_store_find_login(xml_password_store,
+						  login);
   }
     
   g_list_free_full(start_password_store,
@@ -365,33 +350,8 @@ ags_xml_authentication_login(AgsAuthentication *authentication,
     
     xml_authentication_mutex = AGS_XML_AUTHENTICATION_GET_OBJ_MUTEX(xml_authentication);
 
-    xpath = g_strdup_printf("/ags-server-authentication/ags-srv-auth-list/ags-srv-auth/ags-srv-user-uuid[text() = '%s']",
-			    current_user_uuid);
-    
-    g_rec_mutex_lock(xml_authentication_mutex);
-    
-    xpath_context = xmlXPathNewContext(xml_authentication->doc);
-    xpath_object = xmlXPathEval(xpath,
-				xpath_context);
-
-    if(xpath_object->nodesetval != NULL){
-      node = xpath_object->nodesetval->nodeTab;
-
-      for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
-	if(node[i]->type == XML_ELEMENT_NODE){
-	  auth_node = node[i]->parent;
-
-	  break;
-	}
-      }
-    }
-
-    g_rec_mutex_unlock(xml_authentication_mutex);
-
-    xmlXPathFreeObject(xpath_object);
-    xmlXPathFreeContext(xpath_context);
-
-    g_free(xpath);
+    auth_node = ags_xml_authentication_find_user_uuid(xml_authentication,
+						      current_user_uuid);
 
     /* login info */
     if(auth_node != NULL){
@@ -522,6 +482,15 @@ ags_xml_authentication_login(AgsAuthentication *authentication,
 
 	xmlNodeSetContent(session_node,
 			  current_security_token);
+
+	/* index session */
+	g_rw_lock_writer_lock(&(xml_authentication->index_lock));
+
+	g_hash_table_insert(xml_authentication->security_token_index,
+			    g_strdup(current_security_token),
+			    session_node);
+	
+	g_rw_lock_writer_unlock(&(xml_authentication->index_lock));
       }
 
       /* session */
@@ -631,20 +600,14 @@ ags_xml_authentication_logout(AgsAuthentication *authentication,
   AgsPasswordStoreManager *password_store_manager;
   AgsXmlAuthentication *xml_authentication;
 
-  xmlXPathContext *xpath_context; 
-  xmlXPathObject *xpath_object;
-  xmlNode **node;
   xmlNode *auth_node;
-  xmlNode *child;
 
   AgsLoginInfo *login_info;
 
   GList *start_password_store, *password_store;
 
   gchar *current_user_uuid;
-  gchar *xpath;
 
-  guint i;
   gboolean is_session_active;
   
   GRecMutex *authentication_manager_mutex;
@@ -697,102 +660,47 @@ ags_xml_authentication_logout(AgsAuthentication *authentication,
     return(FALSE);
   }
   
-  /* session */
+  /* session - look up and unlink under the mutex, so no concurrent logout or reindex frees the nodes */
   auth_node = NULL;
     
-  xml_authentication_mutex = AGS_XML_AUTHENTICATION_GET_OBJ_MUTEX(xml_authentication);
-    
-  xpath = g_strdup_printf("/ags-server-authentication/ags-srv-auth-list/ags-srv-auth/ags-srv-user-uuid[text() = '%s']",
-			  current_user_uuid);
-    
   g_rec_mutex_lock(xml_authentication_mutex);
-    
-  xpath_context = xmlXPathNewContext(xml_authentication->doc);
-  xpath_object = xmlXPathEval(xpath,
-			      xpath_context);
-
-  if(xpath_object->nodesetval != NULL){
-    node = xpath_object->nodesetval->nodeTab;
-
-    for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
-      if(node[i]->type == XML_ELEMENT_NODE){
-	auth_node = node[i]->parent;
 
-	break;
-      }
-    }
-  }
-
-  g_rec_mutex_unlock(xml_authentication_mutex);
-
-  xmlXPathFreeObject(xpath_object);
-  xmlXPathFreeContext(xpath_context);
-
-  g_free(xpath);
+  auth_node = ags_xml_authentication_find_user_uuid(xml_authentication,
+						    current_user_uuid);
 
   if(auth_node != NULL){
     xmlNode *session_list_node;
     xmlNode *session_node;
 
-    session_list_node = NULL;
-    session_node = NULL;
-      
-    g_rec_mutex_lock(xml_authentication_mutex);
-
-    /* find session list */
-    child = auth_node->children;
+    /* find session - must belong to auth node */
+    session_node = ags_xml_authentication_find_security_token(xml_authentication,
+							      security_token);
 
-    while(child != NULL){
-      if(child->type == XML_ELEMENT_NODE){
-	if(!g_ascii_strncasecmp(child->name,
-				"ags-srv-auth-session-list",
-				26)){
-	  session_list_node = child;
+    if(session_node != NULL){
+      session_list_node = session_node->parent;
 
-	  break;
-	}
+      if(session_list_node == NULL ||
+	 session_list_node->parent != auth_node){
+	session_node = NULL;
       }
-	
-      child = child->next;
     }
 
-    /* find session */
-    if(session_list_node != NULL){	
-      child = session_list_node->children;
-
-      while(child != NULL){
-	if(child->type == XML_ELEMENT_NODE){
-	  if(!g_ascii_strncasecmp(child->name,
-				  "ags-srv-auth-session",
-				  21)){
-	    xmlChar *current_security_token;
-
-	    current_security_token = xmlNodeGetContent(child);
-
-	    if(!g_strcmp0(security_token,
-			  current_security_token)){
-	      session_node = child;
-	    }
-
-	    xmlFree(current_security_token);
+    if(session_node != NULL){
+      g_rw_lock_writer_lock(&(xml_authentication->index_lock));
 
-	    if(session_node != NULL){		
-	      break;
-	    }
-	  }
-	}
-	
-	child = child->next;
-      }
-    }
+      g_hash_table_remove(xml_authentication->security_token_index,
+			  security_token);
+      
+      g_rw_lock_writer_unlock(&(xml_authentication->index_lock));
 
-    if(session_node != NULL){
       xmlUnlinkNode(session_node);
       xmlFreeNode(session_node);
     }
+  }
       
-    g_rec_mutex_unlock(xml_authentication_mutex);
+  g_rec_mutex_unlock(xml_authentication_mutex);
 
+  if(auth_node != NULL){
     /* login info - decrement active session count */
     g_rec_mutex_lock(authentication_manager_mutex);
 	
@@ -900,17 +808,14 @@ ags_xml_authentication_is_session_active(AgsAuthentication *authentication,
   AgsXmlAuthentication *xml_authentication;
   AgsAuthenticationManager *authentication_manager;
 
-  xmlXPathContext *xpath_context; 
-  xmlXPathObject *xpath_object;
-  xmlNode **node;
   xmlNode *auth_node;
-  xmlNode *child;
+  xmlNode *session_list_node;
+  xmlNode *session_node;
 
   GList *start_password_store, *password_store;
 
-  gchar *xpath;
+  gchar *str;
   
-  guint i;
   gboolean success;
   
   GRecMutex *authentication_manager_mutex;
@@ -938,147 +843,89 @@ ags_xml_authentication_is_session_active(AgsAuthentication *authentication,
   authentication_manager_mutex = AGS_AUTHENTICATION_MANAGER_GET_OBJ_MUTEX(authentication_manager);
     
   auth_node = NULL;
-  
-  xpath = g_strdup_printf("/ags-server-authentication/ags-srv-auth-list/ags-srv-auth/ags-srv-user-uuid[text() = '%s']",
-			  user_uuid);
-    
-  g_rec_mutex_lock(xml_authentication_mutex);
-    
-  xpath_context = xmlXPathNewContext(xml_authentication->doc);
-  xpath_object = xmlXPathEval(xpath,
-			      xpath_context);
-
-  if(xpath_object->nodesetval != NULL){
-    node = xpath_object->nodesetval->nodeTab;
-
-    for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
-      if(node[i]->type == XML_ELEMENT_NODE){
-	auth_node = node[i]->parent;
 
-	break;
-      }
-    }
-  }
-
-  g_rec_mutex_unlock(xml_authentication_mutex);
-
-  xmlXPathFreeObject(xpath_object);
-  xmlXPathFreeContext(xpath_context);
+  session_node = NULL;
 
-  g_free(xpath);
+  str = NULL;
+  
+  /* find session - must belong to auth node, look up under the mutex */
+  g_rec_mutex_lock(xml_authentication_mutex);
+  
+  auth_node = ags_xml_authentication_find_user_uuid(xml_authentication,
+						    user_uuid);
 
   if(auth_node != NULL){
-    xmlNode *session_list_node;
-    xmlNode *session_node;
+    session_node = ags_xml_authentication_find_security_token(xml_authentication,
+							      security_token);
 
-    session_list_node = NULL;
-    session_node = NULL;
-      
-    g_rec_mutex_lock(xml_authentication_mutex);
-
-    /* find session list */
-    child = auth_node->children;
-
-    while(child != NULL){
-      if(child->type == XML_ELEMENT_NODE){
-	if(!g_ascii_strncasecmp(child->name,
-				"ags-srv-auth-session-list",
-				26)){
-	  session_list_node = child;
-
-	  break;
-	}
-      }
-	
-      child = child->next;
-    }
-
-    /* find session */
-    if(session_list_node != NULL){	
-      child = session_list_node->children;
-
-      while(child != NULL){
-	if(child->type == XML_ELEMENT_NODE){
-	  if(!g_ascii_strncasecmp(child->name,
-				  "ags-srv-auth-session",
-				  21)){
-	    xmlChar *current_security_token;
-
-	    current_security_token = xmlNodeGetContent(child);
-
-	    if(!g_strcmp0(security_token,
-			  current_security_token)){
-	      session_node = child;
-	    }
-
-	    xmlFree(current_security_token);
+    if(session_node != NULL){
+      session_list_node = session_node->parent;
 
-	    if(session_node != NULL){		
-	      break;
-	    }
-	  }
-	}
-	
-	child = child->next;
+      if(session_list_node == NULL ||
+	 session_list_node->parent != auth_node){
+	session_node = NULL;
       }
     }
 
     if(session_node != NULL){
-      GDateTime *date_time, *last_active;
-
-      gchar *str;
-
-      gint64 session_timeout;
-      
-      date_time = g_date_time_new_now_utc();
-
       str = xmlGetProp(session_node,
 		       "last-active");
-      
+    }
+  }
+    
+  g_rec_mutex_unlock(xml_authentication_mutex);
+
+  /* session_node is only tested against NULL here, it is not dereferenced outside the lock */
+  if(session_node != NULL){
+    GDateTime *date_time, *last_active;
+
+    gint64 session_timeout;
+    
+    date_time = g_date_time_new_now_utc();
+    
 #if HAVE_GLIB_2_56
-      last_active = g_date_time_new_from_iso8601(str,
-						 NULL);
+    last_active = g_date_time_new_from_iso8601(str,
+					       NULL);
 #else
-      {
-	gint year;
-	gint month;
-	gint day;
-	gint hour;
-	gint minute;
-	gint second;
-
-	year = -1;
-	month = -1;
-	day = -1;
-	hour = -1;
-	minute = -1;
-	second = -1;
-
-	if(str != NULL){
-	  sscanf(str, "%4d-%2d-%2dT%2d:%2d:%2d", &year, &month, &day, &hour, &minute, &second);
-	}
-	
-	last_active = g_date_time_new(g_time_zone_new_utc(),
-				      year,
-				      month,
-				      day,
-				      hour,
-				      minute,
-				      second);
+    {
+      gint year;
+      gint month;
+      gint day;
+      gint hour;
+      gint minute;
+      gint second;
+
+      year = -1;
+      month = -1;
+      day = -1;
+      hour = -1;
+      minute = -1;
+      second = -1;
+
+      if(str != NULL){
+	sscanf(str, "%4d-%2d-%2dT%2d:%2d:%2d", &year, &month, &day, &hour, &minute, &second);
       }
-#endif
-      
-      xmlFree(str);
-
-      session_timeout = ags_authentication_manager_get_session_timeout(authentication_manager);
       
-      if(g_date_time_to_unix(last_active) + session_timeout > g_date_time_to_unix(date_time)){
-	success = TRUE;
-      }
+      last_active = g_date_time_new(g_time_zone_new_utc(),
+				    year,
+				    month,
+				    day,
+				    hour,
+				    minute,
+				    second);
+    }
+#endif
+    
+    xmlFree(str);
 
-      g_date_time_unref(date_time);
-      g_date_time_unref(last_active);
+    session_timeout = ags_authentication_manager_get_session_timeout(authentication_manager);
+    
+    if(g_date_time_to_unix(last_active) + session_timeout > g_date_time_to_unix(date_time)){
+      success = TRUE;
     }
+
+    g_date_time_unref(date_time);
+    g_date_time_unref(last_active);
   }
 
   return(success);
@@ -1127,6 +974,118 @@ ags_xml_authentication_open_filename(AgsXmlAuthentication *xml_authentication,
   }
 
   g_rec_mutex_unlock(xml_authentication_mutex);
+
+  ags_xml_authentication_reindex(xml_authentication);
+}
+
+/**
+ * ags_xml_authentication_reindex:
+ * @xml_authentication: the #AgsXmlAuthentication
+ * 
+ * Rebuild the user UUID and security token index of @xml_authentication
+ * from its XML document. Call it after modifying the document directly.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_xml_authentication_reindex(AgsXmlAuthentication *xml_authentication)
+{
+  xmlNode *list_node;
+  xmlNode *auth_node;
+  xmlNode *child;
+  xmlNode *session_node;
+
+  GRecMutex *xml_authentication_mutex;
+
+  if(!AGS_IS_XML_AUTHENTICATION(xml_authentication)){
+    return;
+  }
+
+  xml_authentication_mutex = AGS_XML_AUTHENTICATION_GET_OBJ_MUTEX(xml_authentication);
+
+  g_rec_mutex_lock(xml_authentication_mutex);
+
+  g_rw_lock_writer_lock(&(xml_authentication->index_lock));
+
+  g_hash_table_remove_all(xml_authentication->user_uuid_index);
+  g_hash_table_remove_all(xml_authentication->security_token_index);
+
+  list_node = NULL;
+
+  if(xml_authentication->root_node != NULL){
+    list_node = xml_authentication->root_node->children;
+  }
+  
+  while(list_node != NULL){
+    if(list_node->type == XML_ELEMENT_NODE &&
+       !g_ascii_strncasecmp(list_node->name,
+			    "ags-srv-auth-list",
+			    18)){
+      auth_node = list_node->children;
+
+      while(auth_node != NULL){
+	if(auth_node->type == XML_ELEMENT_NODE &&
+	   !g_ascii_strncasecmp(auth_node->name,
+				"ags-srv-auth",
+				13)){
+	  child = auth_node->children;
+
+	  while(child != NULL){
+	    if(child->type == XML_ELEMENT_NODE){
+	      xmlChar *str;
+	      
+	      if(!g_ascii_strncasecmp(child->name,
+				      "ags-srv-user-uuid",
+				      18)){
+		str = xmlNodeGetContent(child);
+
+		if(str != NULL){
+		  g_hash_table_insert(xml_authentication->user_uuid_index,
+				      g_strdup(str),
+				      auth_node);
+
+		  xmlFree(str);
+		}
+	      }else if(!g_ascii_strncasecmp(child->name,
+					    "ags-srv-auth-session-list",
+					    26)){
+		session_node = child->children;
+
+		while(session_node != NULL){
+		  if(session_node->type == XML_ELEMENT_NODE &&
+		     !g_ascii_strncasecmp(session_node->name,
+					  "ags-srv-auth-session",
+					  21)){
+		    str = xmlNodeGetContent(session_node);
+
+		    if(str != NULL){
+		      g_hash_table_insert(xml_authentication->security_token_index,
+					  g_strdup(str),
+					  session_node);
+
+		      xmlFree(str);
+		    }
+		  }
+		  
+		  session_node = session_node->next;
+		}
+	      }
+	    }
+
+	    child = child->next;
+	  }
+	}
+
+	auth_node = auth_node->next;
+      }
+    }
+
+    list_node = list_node->next;
+  }
+  
+  g_rw_lock_writer_unlock(&(xml_authentication->index_lock));
+
+  g_rec_mutex_unlock(xml_authentication_mutex);
 }
 
 /**
@@ -1144,73 +1103,53 @@ xmlNode*
 ags_xml_authentication_find_user_uuid(AgsXmlAuthentication *xml_authentication,
 				      gchar *user_uuid)
 {
-  xmlXPathContext *xpath_context; 
-  xmlXPathObject *xpath_object;
-  xmlNode **node;
   xmlNode *auth_node;
   
-  gchar *xpath;
-
-  guint i;
-
-  GRecMutex *xml_authentication_mutex;
-  
   if(!AGS_IS_XML_AUTHENTICATION(xml_authentication) ||
      user_uuid == NULL){
     return(NULL);
   }    
 
-  xml_authentication_mutex = AGS_XML_AUTHENTICATION_GET_OBJ_MUTEX(xml_authentication);
-
-  /* retrieve auth node */
-  xpath = g_strdup_printf("(/ags-server-authentication/ags-srv-auth-list/ags-srv-auth)/ags-srv-user-uuid[content()='%s']",
-			  user_uuid);
+  g_rw_lock_reader_lock(&(xml_authentication->index_lock));
 
-  g_rec_mutex_lock(xml_authentication_mutex);
-
-  /* Create xpath evaluation context */
-  xpath_context = xmlXPathNewContext(xml_authentication->doc);
-
-  if(xpath_context == NULL){
-    g_rec_mutex_unlock(xml_authentication_mutex);
+  auth_node = g_hash_table_lookup(xml_authentication->user_uuid_index,
+				  user_uuid);
+  
+  g_rw_lock_reader_unlock(&(xml_authentication->index_lock));
 
-    g_warning("Error: unable to create new XPath context");
+  return(auth_node);
+}
 
+/**
+ * ags_xml_authentication_find_security_token:
+ * @xml_authentication: the #AgsXmlAuthentication
+ * @security_token: the security token
+ * 
+ * Find ags-srv-auth-session xmlNode containing @security_token.
+ * 
+ * Returns: (transfer none): the matching xmlNode or %NULL
+ * 
+ * Since: 3.5.0
+ */
+xmlNode*
+ags_xml_authentication_find_security_token(AgsXmlAuthentication *xml_authentication,
+					   gchar *security_token)
+{
+  xmlNode *session_node;
+  
+  if(!AGS_IS_XML_AUTHENTICATION(xml_authentication) ||
+     security_token == NULL){
     return(NULL);
-  }
-
-  /* Evaluate xpath expression */
-  xpath_object = xmlXPathEval(xpath,
-			      xpath_context);
-
-  if(xpath_object == NULL){
-    g_rec_mutex_unlock(xml_authentication_mutex);
-
-    g_warning("Error: unable to evaluate xpath expression");
+  }    
 
-    xmlXPathFreeContext(xpath_context); 
+  g_rw_lock_reader_lock(&(xml_authentication->index_lock));
 
-    return(NULL);
-  }
-
-  /* find node */
-  node = xpath_object->nodesetval->nodeTab;
-  auth_node = NULL;
+  session_node = g_hash_table_lookup(xml_authentication->security_token_index,
+				     security_token);
   
-  for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
-    if(node[i]->type == XML_ELEMENT_NODE){
-      auth_node = node[i];
-      
-      break;
-    }
-  }
+  g_rw_lock_reader_unlock(&(xml_authentication->index_lock));
 
-  g_rec_mutex_unlock(xml_authentication_mutex);
-
-  /* free xpath and return */
-  g_free(xpath);
-
-  return(auth_node);
+  return(session_node);
 }
 
 /**
@@ -53,6 +53,11 @@ struct _AgsXmlAuthentication
 
   xmlDoc *doc;
   xmlNode *root_node;
+
+  GRWLock index_lock;
+  
+  GHashTable *user_uuid_index;
+  GHashTable *security_token_index;
 };
 
 struct _AgsXmlAuthenticationClass
@@ -65,8 +70,12 @@ GType ags_xml_authentication_get_type();
 void ags_xml_authentication_open_filename(AgsXmlAuthentication *xml_authentication,
 					  gchar *filename);
 
+void ags_xml_authentication_reindex(AgsXmlAuthentication *xml_authentication);
+
 xmlNode* ags_xml_authentication_find_user_uuid(AgsXmlAuthentication *xml_authentication,
 					       gchar *user_uuid);
+xmlNode* ags_xml_authentication_find_security_token(AgsXmlAuthentication *xml_authentication,
+						    gchar *security_token);
 
 AgsXmlAuthentication* ags_xml_authentication_new();
 
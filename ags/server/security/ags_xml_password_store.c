@@ -164,6 +164,16 @@ ags_xml_password_store_init(AgsXmlPasswordStore *xml_password_store)
 
   xml_password_store->doc = NULL;
   xml_password_store->root_node = NULL;
+
+  /* index */
+  g_rw_lock_init(&(xml_password_store->index_lock));
+  
+  xml_password_store->user_uuid_index = g_hash_table_new_full(g_str_hash, g_str_equal,
+							      g_free,
+							      NULL);
+  xml_password_store->login_index = g_hash_table_new_full(g_str_hash, g_str_equal,
+							  g_free,
+							  NULL);
 }
 
 void
@@ -180,6 +190,11 @@ ags_xml_password_store_finalize(GObject *gobject)
   if(xml_password_store->doc != NULL){
     xmlFreeDoc(xml_password_store->doc);
   }
+
+  g_hash_table_destroy(xml_password_store->user_uuid_index);
+  g_hash_table_destroy(xml_password_store->login_index);
+
+  g_rw_lock_clear(&(xml_password_store->index_lock));
   
   /* call parent */
   G_OBJECT_CLASS(ags_xml_password_store_parent_class)->finalize(gobject);
@@ -195,17 +210,10 @@ ags_xml_password_store_set_login_name(AgsPasswordStore *password_store,
 {
   AgsXmlPasswordStore *xml_password_store;
   
-  xmlXPathContext *xpath_context; 
-  xmlXPathObject *xpath_object;
-  xmlNode **node;
   xmlNode *user_node;
   xmlNode *login_node;
   xmlNode *child;
   
-  gchar *xpath;
-  
-  guint i;
-  
   GRecMutex *xml_password_store_mutex;
 
   /* authentication */
@@ -232,38 +240,16 @@ ags_xml_password_store_set_login_name(AgsPasswordStore *password_store,
 
   xml_password_store_mutex = AGS_XML_PASSWORD_STORE_GET_OBJ_MUTEX(xml_password_store);
 
-  user_node = NULL;
-
-  xpath = g_strdup_printf("/ags-server-password-store/ags-srv-user-list/ags-srv-user/ags-srv-user-uuid[text() = '%s']",
-			  user_uuid);
-
-  g_rec_mutex_lock(xml_password_store_mutex);
-    
-  xpath_context = xmlXPathNewContext(xml_password_store->doc);
-  xpath_object = xmlXPathEval(xpath,
-			      xpath_context);
-
-  if(xpath_object->nodesetval != NULL){
-    node = xpath_object->nodesetval->nodeTab;
-
-    for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
-      if(node[i]->type == XML_ELEMENT_NODE){
-	user_node = node[i]->parent;
-
-	break;
-      }
-    }
-  }
-
-  g_rec_mutex_unlock(xml_password_store_mutex);
-
-  xmlXPathFreeObject(xpath_object);
-  xmlXPathFreeContext(xpath_context);
-
-  g_free(xpath);
+  user_node = ags_xml_password_store_find_user_uuid(xml_password_store,
+						    user_uuid);
 
   if(user_node != NULL){
+    xmlChar *old_login;
+    
     login_node = NULL;
+    old_login = NULL;
+
+    g_rec_mutex_lock(xml_password_store_mutex);
     
     child = user_node->children;
     
@@ -286,10 +272,36 @@ ags_xml_password_store_set_login_name(AgsPasswordStore *password_store,
 			      "ags-srv-user-login");
       xmlAddChild(user_node,
 		  login_node);
+    }else{
+      old_login = xmlNodeGetContent(login_node);
     }
 
     xmlNodeSetContent(login_node,
 		      login);
+
+    g_rec_mutex_unlock(xml_password_store_mutex);
+
+    /* update login index */
+    g_rw_lock_writer_lock(&(xml_password_store->index_lock));
+
+    if(old_login != NULL &&
+       g_hash_table_lookup(xml_password_store->login_index,
+			   old_login) == user_node){
+      g_hash_table_remove(xml_password_store->login_index,
+			  old_login);
+    }
+    
+    if(login != NULL){
+      g_hash_table_insert(xml_password_store->login_index,
+			  g_strdup(login),
+			  user_node);
+    }
+    
+    g_rw_lock_writer_unlock(&(xml_password_store->index_lock));
+
+    if(old_login != NULL){
+      xmlFree(old_login);
+    }
   }
 }
 
@@ -302,18 +314,12 @@ ags_xml_password_store_get_login_name(AgsPasswordStore *password_store,
 {
   AgsXmlPasswordStore *xml_password_store;
   
-  xmlXPathContext *xpath_context; 
-  xmlXPathObject *xpath_object;
-  xmlNode **node;
   xmlNode *user_node;
   xmlNode *login_node;
   xmlNode *child;
   
-  gchar *xpath;
   gchar *login;
   
-  guint i;
-  
   GRecMutex *xml_password_store_mutex;
 
   if(!AGS_IS_SECURITY_CONTEXT(security_context) ||
@@ -339,35 +345,8 @@ ags_xml_password_store_get_login_name(AgsPasswordStore *password_store,
 
   xml_password_store_mutex = AGS_XML_PASSWORD_STORE_GET_OBJ_MUTEX(xml_password_store);
   
-  user_node = NULL;
-
-  xpath = g_strdup_printf("/ags-server-password-store/ags-srv-user-list/ags-srv-user/ags-srv-user-uuid[text() = '%s']",
-			  user_uuid);
-
-  g_rec_mutex_lock(xml_password_store_mutex);
-    
-  xpath_context = xmlXPathNewContext(xml_password_store->doc);
-  xpath_object = xmlXPathEval(xpath,
-			      xpath_context);
-
-  if(xpath_object->nodesetval != NULL){
-    node = xpath_object->nodesetval->nodeTab;
-
-    for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
-      if(node[i]->type == XML_ELEMENT_NODE){
-	user_node = node[i]->parent;
-
-	break;
-      }
-    }
-  }
-
-  g_rec_mutex_unlock(xml_password_store_mutex);
-
-  xmlXPathFreeObject(xpath_object);
-  xmlXPathFreeContext(xpath_context);
-
-  g_free(xpath);
+  user_node = ags_xml_password_store_find_user_uuid(xml_password_store,
+						    user_uuid);
 
   login = NULL;
   
@@ -414,17 +393,10 @@ ags_xml_password_store_set_password(AgsPasswordStore *password_store,
 {
   AgsXmlPasswordStore *xml_password_store;
   
-  xmlXPathContext *xpath_context; 
-  xmlXPathObject *xpath_object;
-  xmlNode **node;
   xmlNode *user_node;
   xmlNode *password_node;
   xmlNode *child;
   
-  gchar *xpath;
-  
-  guint i;
-  
   GRecMutex *xml_password_store_mutex;
 
   if(!AGS_IS_SECURITY_CONTEXT(security_context) ||
@@ -450,28 +422,10 @@ ags_xml_password_store_set_password(AgsPasswordStore *password_store,
 
   xml_password_store_mutex = AGS_XML_PASSWORD_STORE_GET_OBJ_MUTEX(xml_password_store);
   
-  user_node = NULL;
-
-  xpath = g_strdup_printf("/ags-server-password-store/ags-srv-user-list/ags-srv-user/ags-srv-user-uuid[text() = '%s']",
-			  user_uuid);
+  user_node = ags_xml_password_store_find_user_uuid(xml_password_store,
+						    user_uuid);
 
   g_rec_mutex_lock(xml_password_store_mutex);
-    
-  xpath_context = xmlXPathNewContext(xml_password_store->doc);
-  xpath_object = xmlXPathEval(xpath,
-			      xpath_context);
-
-  if(xpath_object->nodesetval != NULL){
-    node = xpath_object->nodesetval->nodeTab;
-
-    for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
-      if(node[i]->type == XML_ELEMENT_NODE){
-	user_node = node[i]->parent;
-
-	break;
-      }
-    }
-  }
 
   if(user_node != NULL){
     password_node = NULL;
@@ -504,11 +458,6 @@ ags_xml_password_store_set_password(AgsPasswordStore *password_store,
   }
 
   g_rec_mutex_unlock(xml_password_store_mutex);
-
-  xmlXPathFreeObject(xpath_object);
-  xmlXPathFreeContext(xpath_context);
-
-  g_free(xpath);
 }
 
 gchar*
@@ -520,18 +469,12 @@ ags_xml_password_store_get_password(AgsPasswordStore *password_store,
 {
   AgsXmlPasswordStore *xml_password_store;
   
-  xmlXPathContext *xpath_context; 
-  xmlXPathObject *xpath_object;
-  xmlNode **node;
   xmlNode *user_node;
   xmlNode *password_node;
   xmlNode *child;
   
-  gchar *xpath;
   gchar *password;
 
-  guint i;
-  
   GRecMutex *xml_password_store_mutex;
 
   if(!AGS_IS_SECURITY_CONTEXT(security_context) ||
@@ -557,29 +500,10 @@ ags_xml_password_store_get_password(AgsPasswordStore *password_store,
 
   xml_password_store_mutex = AGS_XML_PASSWORD_STORE_GET_OBJ_MUTEX(xml_password_store);
   
-  user_node = NULL;
-
-  xpath = g_strdup_printf("/ags-server-password-store/ags-srv-user-list/ags-srv-user/ags-srv-user-uuid[text() = '%s']",
-			  user_uuid);
+  user_node = ags_xml_password_store_find_user_uuid(xml_password_store,
+						    user_uuid);
 
   g_rec_mutex_lock(xml_password_store_mutex);
-    
-  xpath_context = xmlXPathNewContext(xml_password_store->doc);
-  xpath_object = xmlXPathNodeEval(xml_password_store->root_node,
-				  xpath,
-				  xpath_context);
-
-  if(xpath_object->nodesetval != NULL){
-    node = xpath_object->nodesetval->nodeTab;
-
-    for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
-      if(node[i]->type == XML_ELEMENT_NODE){
-	user_node = node[i]->parent;
-
-	break;
-      }
-    }
-  }
 
   password = NULL;
   
@@ -615,11 +539,6 @@ ags_xml_password_store_get_password(AgsPasswordStore *password_store,
 
   g_rec_mutex_unlock(xml_password_store_mutex);
 
-  xmlXPathFreeObject(xpath_object);
-  xmlXPathFreeContext(xpath_context);
-
-  g_free(xpath);
-
   return(password);
 }
 
@@ -698,88 +617,168 @@ ags_xml_password_store_open_filename(AgsXmlPasswordStore *xml_password_store,
   }
 
   g_rec_mutex_unlock(xml_password_store_mutex);
+
+  ags_xml_password_store_reindex(xml_password_store);
 }
 
 /**
- * ags_xml_password_store_find_login:
+ * ags_xml_password_store_reindex:
  * @xml_password_store: the #AgsXmlPasswordStore
- * @login: the login
  * 
- * Find ags-srv-user xmlNode containing @login.
+ * Rebuild the user UUID and login index of @xml_password_store from its
+ * XML document. Call it after modifying the document directly.
  * 
- * Returns: (transfer none): the matching xmlNode or %NULL
- * 
- * Since: 3.0.0
+ * Since: 3.5.0
  */
-xmlNode*
-ags_xml_password_store_find_login(AgsXmlPasswordStore *xml_password_store,
-				  gchar *login)
+void
+ags_xml_password_store_reindex(AgsXmlPasswordStore *xml_password_store)
 {
-  xmlXPathContext *xpath_context; 
-  xmlXPathObject *xpath_object;
-  xmlNode **node;
+  xmlNode *list_node;
   xmlNode *user_node;
-  
-  gchar *xpath;
+  xmlNode *child;
 
-  guint i;
-  
   GRecMutex *xml_password_store_mutex;
 
-  if(!AGS_IS_XML_PASSWORD_STORE(xml_password_store) ||
-     login == NULL){
-    return(NULL);
-  }    
+  if(!AGS_IS_XML_PASSWORD_STORE(xml_password_store)){
+    return;
+  }
 
   xml_password_store_mutex = AGS_XML_PASSWORD_STORE_GET_OBJ_MUTEX(xml_password_store);
 
   g_rec_mutex_lock(xml_password_store_mutex);
-  
-  /* retrieve user node */
-  xpath = g_strdup_printf("(/ags-server-password-store/ags-srv-user-list/ags-srv-user)/ags-srv-user-login[text() = '%s']",
-			  login);
 
-  /* Create xpath evaluation context */
-  xpath_context = xmlXPathNewContext(xml_password_store->doc);
+  g_rw_lock_writer_lock(&(xml_password_store->index_lock));
 
-  if(xpath_context == NULL) {
-    g_rec_mutex_unlock(xml_password_store_mutex);
-    
-    g_warning("Error: unable to create new XPath context");
+  g_hash_table_remove_all(xml_password_store->user_uuid_index);
+  g_hash_table_remove_all(xml_password_store->login_index);
 
-    return(NULL);
+  list_node = NULL;
+
+  if(xml_password_store->root_node != NULL){
+    list_node = xml_password_store->root_node->children;
   }
+  
+  while(list_node != NULL){
+    if(list_node->type == XML_ELEMENT_NODE &&
+       !g_ascii_strncasecmp(list_node->name,
+			    "ags-srv-user-list",
+			    18)){
+      user_node = list_node->children;
+
+      while(user_node != NULL){
+	if(user_node->type == XML_ELEMENT_NODE &&
+	   !g_ascii_strncasecmp(user_node->name,
+				"ags-srv-user",
+				13)){
+	  child = user_node->children;
+
+	  while(child != NULL){
+	    if(child->type == XML_ELEMENT_NODE){
+	      xmlChar *str;
+	      
+	      if(!g_ascii_strncasecmp(child->name,
+				      "ags-srv-user-uuid",
+				      18)){
+		str = xmlNodeGetContent(child);
+
+		if(str != NULL){
+		  g_hash_table_insert(xml_password_store->user_uuid_index,
+				      g_strdup(str),
+				      user_node);
+
+		  xmlFree(str);
+		}
+	      }else if(!g_ascii_strncasecmp(child->name,
+					    "ags-srv-user-login",
+					    19)){
+		str = xmlNodeGetContent(child);
+
+		if(str != NULL){
+		  g_hash_table_insert(xml_password_store->login_index,
+				      g_strdup(str),
+				      user_node);
+
+		  xmlFree(str);
+		}
+	      }
+	    }
+
+	    child = child->next;
+	  }
+	}
 
-  /* Evaluate xpath expression */
-  xpath_object = xmlXPathEval(xpath,
-			      xpath_context);
+	user_node = user_node->next;
+      }
+    }
 
-  if(xpath_object == NULL) {
-    g_rec_mutex_unlock(xml_password_store_mutex);
+    list_node = list_node->next;
+  }
+  
+  g_rw_lock_writer_unlock(&(xml_password_store->index_lock));
 
-    g_warning("Error: unable to evaluate xpath expression");
+  g_rec_mutex_unlock(xml_password_store_mutex);
+}
 
-    xmlXPathFreeContext(xpath_context); 
+/**
+ * ags_xml_password_store_find_user_uuid:
+ * @xml_password_store: the #AgsXmlPasswordStore
+ * @user_uuid: the user UUID
+ * 
+ * Find ags-srv-user xmlNode containing @user_uuid.
+ * 
+ * Returns: (transfer none): the matching xmlNode or %NULL
+ * 
+ * Since: 3.5.0
+ */
+xmlNode*
+ags_xml_password_store_find_user_uuid(AgsXmlPasswordStore *xml_password_store,
+				      gchar *user_uuid)
+{
+  xmlNode *user_node;
 
+  if(!AGS_IS_XML_PASSWORD_STORE(xml_password_store) ||
+     user_uuid == NULL){
     return(NULL);
-  }
+  }    
+
+  g_rw_lock_reader_lock(&(xml_password_store->index_lock));
 
-  /* find node */
-  node = xpath_object->nodesetval->nodeTab;
-  user_node = NULL;
+  user_node = g_hash_table_lookup(xml_password_store->user_uuid_index,
+				  user_uuid);
   
-  for(i = 0; i < xpath_object->nodesetval->nodeNr; i++){
-    if(node[i]->type == XML_ELEMENT_NODE){
-      user_node = node[i];
-      
-      break;
-    }
-  }
+  g_rw_lock_reader_unlock(&(xml_password_store->index_lock));
 
-  g_rec_mutex_unlock(xml_password_store_mutex);
+  return(user_node);
+}
 
-  /* free xpath and return */
-  g_free(xpath);
+/**
+ * ags_xml_password_store_find_login:
+ * @xml_password_store: the #AgsXmlPasswordStore
+ * @login: the login
+ * 
+ * Find ags-srv-user xmlNode containing @login.
+ * 
+ * Returns: (transfer none): the matching xmlNode or %NULL
+ * 
+ * Since: 3.0.0
+ */
+xmlNode*
+ags_xml_password_store_find_login(AgsXmlPasswordStore *xml_password_store,
+				  gchar *login)
+{
+  xmlNode *user_node;
+
+  if(!AGS_IS_XML_PASSWORD_STORE(xml_password_store) ||
+     login == NULL){
+    return(NULL);
+  }    
+
+  g_rw_lock_reader_lock(&(xml_password_store->index_lock));
+
+  user_node = g_hash_table_lookup(xml_password_store->login_index,
+				  login);
+  
+  g_rw_lock_reader_unlock(&(xml_password_store->index_lock));
 
   return(user_node);
 }
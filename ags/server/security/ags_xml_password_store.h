@@ -51,6 +51,11 @@ struct _AgsXmlPasswordStore
 
   xmlDoc *doc;
   xmlNode *root_node;
+
+  GRWLock index_lock;
+  
+  GHashTable *user_uuid_index;
+  GHashTable *login_index;
 };
 
 struct _AgsXmlPasswordStoreClass
@@ -63,6 +68,10 @@ GType ags_xml_password_store_get_type();
 void ags_xml_password_store_open_filename(AgsXmlPasswordStore *xml_password_store,
 					  gchar *filename);
 
+void ags_xml_password_store_reindex(AgsXmlPasswordStore *xml_password_store);
+
+xmlNode* ags_xml_password_store_find_user_uuid(AgsXmlPasswordStore *xml_password_store,
+					       gchar *user_uuid);
 xmlNode* ags_xml_password_store_find_login(AgsXmlPasswordStore *xml_password_store,
 					   gchar *login);
 
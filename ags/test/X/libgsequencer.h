@@ -89,6 +89,7 @@
 #include <ags/X/ags_midi_preferences_callbacks.h>
 #include <ags/X/ags_navigation.h>
 #include <ags/X/ags_navigation_callbacks.h>
+#include <ags/X/ags_meter_dispatcher.h>
 #include <ags/X/ags_notation_editor.h>
 #include <ags/X/ags_notation_editor_callbacks.h>
 #include <ags/X/ags_output_collection_editor.h>
@@ -30,6 +30,7 @@ int ags_buffer_test_init_suite();
 int ags_buffer_test_clean_suite();
 
 void ags_buffer_test_duplicate();
+void ags_buffer_test_peak();
 
 #define AGS_BUFFER_TEST_DUPLICATE_SAMPLERATE_0 (44100)
 #define AGS_BUFFER_TEST_DUPLICATE_BUFFER_SIZE_0 (1024)
@@ -40,6 +41,8 @@ void ags_buffer_test_duplicate();
 #define AGS_BUFFER_TEST_DUPLICATE_FORMAT_1 (AGS_SOUNDCARD_SIGNED_16_BIT)
 #define AGS_BUFFER_TEST_DUPLICATE_X_1 (17 * AGS_BUFFER_TEST_DUPLICATE_BUFFER_SIZE_1)
 
+#define AGS_BUFFER_TEST_PEAK_BUFFER_SIZE (1024)
+
 /* The suite initialization function.
  * Opens the temporary file used by the tests.
  * Returns zero on success, non-zero otherwise.
@@ -100,6 +103,68 @@ ags_buffer_test_duplicate()
 	    copy_buffer->format == buffer->format);
 }
 
+void
+ags_buffer_test_peak()
+{
+  AgsBuffer *buffer;
+  AgsBufferPeak *peak;
+
+  guint n_peaks;
+  guint decimation;
+  
+  buffer = g_object_new(AGS_TYPE_BUFFER,
+			"buffer-size", AGS_BUFFER_TEST_PEAK_BUFFER_SIZE,
+			"format", AGS_SOUNDCARD_SIGNED_16_BIT,
+			NULL);
+
+  ((gint16 *) buffer->data)[100] = 16384;
+  ((gint16 *) buffer->data)[900] = -32768;
+
+  ags_buffer_invalidate_peak(buffer,
+			     0, AGS_BUFFER_TEST_PEAK_BUFFER_SIZE);
+  
+  /* assert first level */
+  peak = ags_buffer_get_peak(buffer,
+			     0,
+			     &n_peaks,
+			     &decimation);
+
+  CU_ASSERT(peak != NULL);
+  CU_ASSERT(decimation == AGS_BUFFER_PEAK_DECIMATION);
+  CU_ASSERT(n_peaks == AGS_BUFFER_TEST_PEAK_BUFFER_SIZE / AGS_BUFFER_PEAK_DECIMATION);
+  CU_ASSERT(peak[100 / AGS_BUFFER_PEAK_DECIMATION].max == 0.5);
+  CU_ASSERT(peak[900 / AGS_BUFFER_PEAK_DECIMATION].min == -1.0);
+  CU_ASSERT(peak[0].min == 0.0 && peak[0].max == 0.0);
+
+  /* assert top level */
+  CU_ASSERT(ags_buffer_find_peak_level(buffer, 64.0) == 2);
+  CU_ASSERT(ags_buffer_find_peak_level(buffer, 1000000.0) == 6);
+
+  peak = ags_buffer_get_peak(buffer,
+			     6,
+			     &n_peaks,
+			     &decimation);
+
+  CU_ASSERT(n_peaks == 1);
+  CU_ASSERT(decimation == AGS_BUFFER_TEST_PEAK_BUFFER_SIZE);
+  CU_ASSERT(peak[0].min == -1.0 && peak[0].max == 0.5);
+
+  /* assert update of invalidated range */
+  ((gint16 *) buffer->data)[100] = 0;
+
+  ags_buffer_invalidate_peak(buffer,
+			     100, 1);
+
+  peak = ags_buffer_get_peak(buffer,
+			     6,
+			     &n_peaks,
+			     &decimation);
+
+  CU_ASSERT(peak[0].min == -1.0 && peak[0].max == 0.0);
+
+  g_object_unref(buffer);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -120,7 +185,8 @@ main(int argc, char **argv)
   }
 
   /* add the tests to the suite */
-  if((CU_add_test(pSuite, "test of AgsBuffer duplicate", ags_buffer_test_duplicate) == NULL)){
+  if((CU_add_test(pSuite, "test of AgsBuffer duplicate", ags_buffer_test_duplicate) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsBuffer peak", ags_buffer_test_peak) == NULL)){
     CU_cleanup_registry();
     
     return CU_get_error();
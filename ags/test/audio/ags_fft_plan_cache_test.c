@@ -0,0 +1,350 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <fftw3.h>
+
+int ags_fft_plan_cache_test_init_suite();
+int ags_fft_plan_cache_test_clean_suite();
+
+void ags_fft_plan_cache_test_find_r2r();
+void ags_fft_plan_cache_test_execute_r2r();
+void ags_fft_plan_cache_test_execute_dft();
+void ags_fft_plan_cache_test_measure();
+
+#define AGS_FFT_PLAN_CACHE_TEST_N (8)
+#define AGS_FFT_PLAN_CACHE_TEST_HOWMANY (2)
+
+gchar *wisdom_path = NULL;
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_fft_plan_cache_test_init_suite()
+{
+  wisdom_path = g_dir_make_tmp("ags_fft_plan_cache_test-XXXXXX",
+			       NULL);
+  
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_fft_plan_cache_test_clean_suite()
+{
+  g_free(wisdom_path);
+  
+  return(0);
+}
+
+void
+ags_fft_plan_cache_test_find_r2r()
+{
+  AgsFFTPlanCache *fft_plan_cache;
+  AgsFFTPlan *fft_plan, *other_fft_plan;
+
+  double *in;
+  
+  fft_plan_cache = ags_fft_plan_cache_new();
+
+  in = (double *) fftw_malloc(AGS_FFT_PLAN_CACHE_TEST_N * sizeof(double));
+  
+  fft_plan = ags_fft_plan_cache_find_r2r(fft_plan_cache,
+					 AGS_FFT_PLAN_CACHE_TEST_N, 1,
+					 FFTW_R2HC,
+					 fftw_alignment_of(in));
+
+  CU_ASSERT(fft_plan != NULL);
+  CU_ASSERT(fft_plan->n == AGS_FFT_PLAN_CACHE_TEST_N);
+  CU_ASSERT(fft_plan->howmany == 1);
+
+  other_fft_plan = ags_fft_plan_cache_find_r2r(fft_plan_cache,
+					       AGS_FFT_PLAN_CACHE_TEST_N, 1,
+					       FFTW_R2HC,
+					       fftw_alignment_of(in));
+
+  CU_ASSERT(other_fft_plan == fft_plan);
+
+  other_fft_plan = ags_fft_plan_cache_find_r2r(fft_plan_cache,
+					       2 * AGS_FFT_PLAN_CACHE_TEST_N, 1,
+					       FFTW_R2HC,
+					       fftw_alignment_of(in));
+
+  CU_ASSERT(other_fft_plan != NULL);
+  CU_ASSERT(other_fft_plan != fft_plan);
+
+  CU_ASSERT(ags_fft_plan_cache_find_r2r(fft_plan_cache,
+					0, 1,
+					FFTW_R2HC,
+					0) == NULL);
+  
+  fftw_free(in);
+}
+
+void
+ags_fft_plan_cache_test_execute_r2r()
+{
+  AgsFFTPlanCache *fft_plan_cache;
+  AgsFFTPlan *fft_plan;
+
+  double *in, *out;
+
+  guint i, j;
+  gboolean success;
+  
+  fft_plan_cache = ags_fft_plan_cache_new();
+
+  g_free(fft_plan_cache->wisdom_filename);
+  fft_plan_cache->wisdom_filename = g_build_filename(wisdom_path,
+						     AGS_FFT_PLAN_CACHE_DEFAULT_WISDOM_FILENAME,
+						     NULL);
+  
+  in = (double *) fftw_malloc(AGS_FFT_PLAN_CACHE_TEST_HOWMANY * AGS_FFT_PLAN_CACHE_TEST_N * sizeof(double));
+  out = (double *) fftw_malloc(AGS_FFT_PLAN_CACHE_TEST_HOWMANY * AGS_FFT_PLAN_CACHE_TEST_N * sizeof(double));
+
+  /* single */
+  fft_plan = ags_fft_plan_cache_find_r2r(fft_plan_cache,
+					 AGS_FFT_PLAN_CACHE_TEST_N, 1,
+					 FFTW_R2HC,
+					 fftw_alignment_of(in));
+
+  ags_fft_plan_cache_measure(fft_plan_cache);
+
+  CU_ASSERT(fft_plan->plan != NULL);
+  
+  for(i = 0; i < AGS_FFT_PLAN_CACHE_TEST_N; i++){
+    in[i] = 1.0;
+  }
+
+  ags_fft_plan_execute_r2r(fft_plan,
+			   in,
+			   out);
+
+  success = (out[0] == (double) AGS_FFT_PLAN_CACHE_TEST_N) ? TRUE: FALSE;
+  
+  for(i = 1; i < AGS_FFT_PLAN_CACHE_TEST_N; i++){
+    if(out[i] > 0.000001 ||
+       out[i] < -0.000001){
+      success = FALSE;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  /* batched */
+  fft_plan = ags_fft_plan_cache_find_r2r(fft_plan_cache,
+					 AGS_FFT_PLAN_CACHE_TEST_N, AGS_FFT_PLAN_CACHE_TEST_HOWMANY,
+					 FFTW_R2HC,
+					 fftw_alignment_of(in));
+
+  ags_fft_plan_cache_measure(fft_plan_cache);
+
+  for(j = 0; j < AGS_FFT_PLAN_CACHE_TEST_HOWMANY; j++){
+    for(i = 0; i < AGS_FFT_PLAN_CACHE_TEST_N; i++){
+      in[j * AGS_FFT_PLAN_CACHE_TEST_N + i] = (double) (j + 1);
+    }
+  }
+
+  ags_fft_plan_execute_r2r(fft_plan,
+			   in,
+			   out);
+
+  success = TRUE;
+  
+  for(j = 0; j < AGS_FFT_PLAN_CACHE_TEST_HOWMANY; j++){
+    if(out[j * AGS_FFT_PLAN_CACHE_TEST_N] != (double) ((j + 1) * AGS_FFT_PLAN_CACHE_TEST_N)){
+      success = FALSE;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+  
+  fftw_free(in);
+  fftw_free(out);
+}
+
+void
+ags_fft_plan_cache_test_execute_dft()
+{
+  AgsFFTPlanCache *fft_plan_cache;
+  AgsFFTPlan *forward_plan, *backward_plan;
+
+  double *in;
+  fftw_complex *out;
+
+  guint i;
+  gboolean success;
+  
+  fft_plan_cache = ags_fft_plan_cache_new();
+
+  g_free(fft_plan_cache->wisdom_filename);
+  fft_plan_cache->wisdom_filename = g_build_filename(wisdom_path,
+						     AGS_FFT_PLAN_CACHE_DEFAULT_WISDOM_FILENAME,
+						     NULL);
+  
+  in = (double *) fftw_malloc(AGS_FFT_PLAN_CACHE_TEST_N * sizeof(double));
+  out = (fftw_complex *) fftw_malloc((AGS_FFT_PLAN_CACHE_TEST_N / 2 + 1) * sizeof(fftw_complex));
+
+  forward_plan = ags_fft_plan_cache_find_dft_r2c(fft_plan_cache,
+						 AGS_FFT_PLAN_CACHE_TEST_N,
+						 fftw_alignment_of(in));
+  backward_plan = ags_fft_plan_cache_find_dft_c2r(fft_plan_cache,
+						  AGS_FFT_PLAN_CACHE_TEST_N,
+						  fftw_alignment_of(in));
+
+  /* usable before measured */
+  CU_ASSERT(forward_plan != NULL);
+  CU_ASSERT(forward_plan->transform == AGS_FFT_PLAN_DFT_R2C);
+  CU_ASSERT(forward_plan->plan != NULL);
+  CU_ASSERT(backward_plan != NULL);
+  CU_ASSERT(backward_plan != forward_plan);
+  CU_ASSERT(backward_plan->transform == AGS_FFT_PLAN_DFT_C2R);
+  CU_ASSERT(backward_plan->plan != NULL);
+
+  /* not shared with r2r of equal size */
+  CU_ASSERT(ags_fft_plan_cache_find_r2r(fft_plan_cache,
+					AGS_FFT_PLAN_CACHE_TEST_N, 1,
+					FFTW_R2HC,
+					fftw_alignment_of(in)) != forward_plan);
+  
+  for(i = 0; i < AGS_FFT_PLAN_CACHE_TEST_N; i++){
+    in[i] = 1.0;
+  }
+
+  ags_fft_plan_execute_dft_r2c(forward_plan,
+			       in,
+			       out);
+
+  CU_ASSERT(out[0][0] == (double) AGS_FFT_PLAN_CACHE_TEST_N);
+
+  /* round trip is scaled by n */
+  ags_fft_plan_execute_dft_c2r(backward_plan,
+			       out,
+			       in);
+
+  success = TRUE;
+  
+  for(i = 0; i < AGS_FFT_PLAN_CACHE_TEST_N; i++){
+    if(in[i] > (double) AGS_FFT_PLAN_CACHE_TEST_N + 0.000001 ||
+       in[i] < (double) AGS_FFT_PLAN_CACHE_TEST_N - 0.000001){
+      success = FALSE;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  ags_fft_plan_cache_measure(fft_plan_cache);
+
+  CU_ASSERT(forward_plan->measured == TRUE);
+  CU_ASSERT(backward_plan->measured == TRUE);
+  
+  fftw_free(in);
+  fftw_free(out);
+}
+
+void
+ags_fft_plan_cache_test_measure()
+{
+  AgsFFTPlanCache *fft_plan_cache;
+  AgsFFTPlan *fft_plan;
+
+  double *in;
+
+  fft_plan_cache = ags_fft_plan_cache_new();
+
+  g_free(fft_plan_cache->wisdom_filename);
+  fft_plan_cache->wisdom_filename = g_build_filename(wisdom_path,
+						     AGS_FFT_PLAN_CACHE_DEFAULT_WISDOM_FILENAME,
+						     NULL);
+  
+  in = (double *) fftw_malloc(4 * AGS_FFT_PLAN_CACHE_TEST_N * sizeof(double));
+
+  fft_plan = ags_fft_plan_cache_find_r2r(fft_plan_cache,
+					 4 * AGS_FFT_PLAN_CACHE_TEST_N, 1,
+					 FFTW_R2HC,
+					 fftw_alignment_of(in));
+
+  ags_fft_plan_cache_measure(fft_plan_cache);
+
+  CU_ASSERT(fft_plan->measured == TRUE);
+  CU_ASSERT(fft_plan->plan != NULL);
+  CU_ASSERT(fft_plan_cache->pending == NULL);
+
+  CU_ASSERT(g_file_test(fft_plan_cache->wisdom_filename,
+			G_FILE_TEST_EXISTS) == TRUE);
+  CU_ASSERT(ags_fft_plan_cache_load_wisdom(fft_plan_cache) == TRUE);
+  
+  fftw_free(in);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsFFTPlanCacheTest", ags_fft_plan_cache_test_init_suite, ags_fft_plan_cache_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsFFTPlanCache find r2r", ags_fft_plan_cache_test_find_r2r) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsFFTPlanCache execute r2r", ags_fft_plan_cache_test_execute_r2r) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsFFTPlanCache execute dft", ags_fft_plan_cache_test_execute_dft) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsFFTPlanCache measure", ags_fft_plan_cache_test_measure) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
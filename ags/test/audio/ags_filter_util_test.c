@@ -27,6 +27,8 @@
 #include <ags/libags.h>
 #include <ags/libags-audio.h>
 
+#include <math.h>
+
 int ags_filter_util_test_init_suite();
 int ags_filter_util_test_clean_suite();
 
@@ -73,7 +75,8 @@ ags_filter_util_test_pitch_s8()
 {
   gint8 *buffer;
 
-  gboolean success;
+  gdouble input_rms, rms;
+  guint i;
   
   buffer = ags_stream_alloc(AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			    AGS_SOUNDCARD_SIGNED_8_BIT);
@@ -83,17 +86,34 @@ ags_filter_util_test_pitch_s8()
 			AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			AGS_FILTER_UTIL_TEST_OFFSET, AGS_FILTER_UTIL_TEST_FRAME_COUNT);
 
+  /* the unpitched input */
+  input_rms = 0.0;
+
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    input_rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  input_rms = sqrt(input_rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
   ags_filter_util_pitch_s8(buffer,
 			   AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			   AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			   AGS_FILTER_UTIL_TEST_BASE_KEY,
 			   AGS_FILTER_UTIL_TEST_TUNING);
 
-  success = TRUE;
-  
-  //TODO:JK: implement me
+  /* the duration is kept */
+  rms = 0.0;
 
-  CU_ASSERT(success == TRUE);
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  rms = sqrt(rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
+  CU_ASSERT(input_rms > 0.0);
+  CU_ASSERT(rms > input_rms / 4.0);
+
+  ags_stream_free(buffer);
 }
 
 void
@@ -101,7 +121,8 @@ ags_filter_util_test_pitch_s16()
 {
   gint16 *buffer;
 
-  gboolean success;
+  gdouble input_rms, rms;
+  guint i;
   
   buffer = ags_stream_alloc(AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			    AGS_SOUNDCARD_SIGNED_16_BIT);
@@ -111,17 +132,34 @@ ags_filter_util_test_pitch_s16()
 			 AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			 AGS_FILTER_UTIL_TEST_OFFSET, AGS_FILTER_UTIL_TEST_FRAME_COUNT);
 
+  /* the unpitched input */
+  input_rms = 0.0;
+
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    input_rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  input_rms = sqrt(input_rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
   ags_filter_util_pitch_s16(buffer,
 			    AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			    AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			    AGS_FILTER_UTIL_TEST_BASE_KEY,
 			    AGS_FILTER_UTIL_TEST_TUNING);
 
-  success = TRUE;
-  
-  //TODO:JK: implement me
+  /* the duration is kept */
+  rms = 0.0;
 
-  CU_ASSERT(success == TRUE);
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  rms = sqrt(rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
+  CU_ASSERT(input_rms > 0.0);
+  CU_ASSERT(rms > input_rms / 4.0);
+
+  ags_stream_free(buffer);
 }
 
 void
@@ -129,7 +167,8 @@ ags_filter_util_test_pitch_s24()
 {
   gint32 *buffer;
 
-  gboolean success;
+  gdouble input_rms, rms;
+  guint i;
   
   buffer = ags_stream_alloc(AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			    AGS_SOUNDCARD_SIGNED_24_BIT);
@@ -139,17 +178,34 @@ ags_filter_util_test_pitch_s24()
 			 AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			 AGS_FILTER_UTIL_TEST_OFFSET, AGS_FILTER_UTIL_TEST_FRAME_COUNT);
 
+  /* the unpitched input */
+  input_rms = 0.0;
+
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    input_rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  input_rms = sqrt(input_rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
   ags_filter_util_pitch_s24(buffer,
 			    AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			    AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			    AGS_FILTER_UTIL_TEST_BASE_KEY,
 			    AGS_FILTER_UTIL_TEST_TUNING);
 
-  success = TRUE;
-  
-  //TODO:JK: implement me
+  /* the duration is kept */
+  rms = 0.0;
 
-  CU_ASSERT(success == TRUE);
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  rms = sqrt(rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
+  CU_ASSERT(input_rms > 0.0);
+  CU_ASSERT(rms > input_rms / 4.0);
+
+  ags_stream_free(buffer);
 }
 
 void
@@ -157,7 +213,8 @@ ags_filter_util_test_pitch_s32()
 {
   gint32 *buffer;
 
-  gboolean success;
+  gdouble input_rms, rms;
+  guint i;
   
   buffer = ags_stream_alloc(AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			    AGS_SOUNDCARD_SIGNED_32_BIT);
@@ -167,17 +224,34 @@ ags_filter_util_test_pitch_s32()
 			 AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			 AGS_FILTER_UTIL_TEST_OFFSET, AGS_FILTER_UTIL_TEST_FRAME_COUNT);
 
+  /* the unpitched input */
+  input_rms = 0.0;
+
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    input_rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  input_rms = sqrt(input_rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
   ags_filter_util_pitch_s32(buffer,
 			    AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			    AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			    AGS_FILTER_UTIL_TEST_BASE_KEY,
 			    AGS_FILTER_UTIL_TEST_TUNING);
 
-  success = TRUE;
-  
-  //TODO:JK: implement me
+  /* the duration is kept */
+  rms = 0.0;
 
-  CU_ASSERT(success == TRUE);
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  rms = sqrt(rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
+  CU_ASSERT(input_rms > 0.0);
+  CU_ASSERT(rms > input_rms / 4.0);
+
+  ags_stream_free(buffer);
 }
 
 void
@@ -185,7 +259,8 @@ ags_filter_util_test_pitch_s64()
 {
   gint64 *buffer;
 
-  gboolean success;
+  gdouble input_rms, rms;
+  guint i;
   
   buffer = ags_stream_alloc(AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			    AGS_SOUNDCARD_SIGNED_64_BIT);
@@ -195,17 +270,34 @@ ags_filter_util_test_pitch_s64()
 			 AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			 AGS_FILTER_UTIL_TEST_OFFSET, AGS_FILTER_UTIL_TEST_FRAME_COUNT);
 
+  /* the unpitched input */
+  input_rms = 0.0;
+
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    input_rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  input_rms = sqrt(input_rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
   ags_filter_util_pitch_s64(buffer,
 			    AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			    AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			    AGS_FILTER_UTIL_TEST_BASE_KEY,
 			    AGS_FILTER_UTIL_TEST_TUNING);
 
-  success = TRUE;
-  
-  //TODO:JK: implement me
+  /* the duration is kept */
+  rms = 0.0;
 
-  CU_ASSERT(success == TRUE);
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  rms = sqrt(rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
+  CU_ASSERT(input_rms > 0.0);
+  CU_ASSERT(rms > input_rms / 4.0);
+
+  ags_stream_free(buffer);
 }
 
 void
@@ -213,7 +305,8 @@ ags_filter_util_test_pitch_float()
 {
   gfloat *buffer;
 
-  gboolean success;
+  gdouble input_rms, rms;
+  guint i;
   
   buffer = ags_stream_alloc(AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			    AGS_SOUNDCARD_FLOAT);
@@ -223,17 +316,34 @@ ags_filter_util_test_pitch_float()
 			   AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			   AGS_FILTER_UTIL_TEST_OFFSET, AGS_FILTER_UTIL_TEST_FRAME_COUNT);
 
+  /* the unpitched input */
+  input_rms = 0.0;
+
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    input_rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  input_rms = sqrt(input_rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
   ags_filter_util_pitch_float(buffer,
 			      AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			      AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			      AGS_FILTER_UTIL_TEST_BASE_KEY,
 			      AGS_FILTER_UTIL_TEST_TUNING);
 
-  success = TRUE;
-  
-  //TODO:JK: implement me
+  /* the duration is kept */
+  rms = 0.0;
 
-  CU_ASSERT(success == TRUE);
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  rms = sqrt(rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
+  CU_ASSERT(input_rms > 0.0);
+  CU_ASSERT(rms > input_rms / 4.0);
+
+  ags_stream_free(buffer);
 }
 
 void
@@ -241,7 +351,8 @@ ags_filter_util_test_pitch_double()
 {
   gdouble *buffer;
 
-  gboolean success;
+  gdouble input_rms, rms;
+  guint i;
   
   buffer = ags_stream_alloc(AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			    AGS_SOUNDCARD_DOUBLE);
@@ -251,17 +362,34 @@ ags_filter_util_test_pitch_double()
 			    AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			    AGS_FILTER_UTIL_TEST_OFFSET, AGS_FILTER_UTIL_TEST_FRAME_COUNT);
 
+  /* the unpitched input */
+  input_rms = 0.0;
+
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    input_rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  input_rms = sqrt(input_rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
   ags_filter_util_pitch_double(buffer,
 			       AGS_FILTER_UTIL_TEST_FRAME_COUNT,
 			       AGS_FILTER_UTIL_TEST_SAMPLERATE,
 			       AGS_FILTER_UTIL_TEST_BASE_KEY,
 			       AGS_FILTER_UTIL_TEST_TUNING);
 
-  success = TRUE;
-  
-  //TODO:JK: implement me
+  /* the duration is kept */
+  rms = 0.0;
 
-  CU_ASSERT(success == TRUE);
+  for(i = AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i < 3 * AGS_FILTER_UTIL_TEST_FRAME_COUNT / 4; i++){
+    rms += (gdouble) buffer[i] * (gdouble) buffer[i];
+  }
+
+  rms = sqrt(rms / (gdouble) (AGS_FILTER_UTIL_TEST_FRAME_COUNT / 2));
+
+  CU_ASSERT(input_rms > 0.0);
+  CU_ASSERT(rms > input_rms / 4.0);
+
+  ags_stream_free(buffer);
 }
 
 void
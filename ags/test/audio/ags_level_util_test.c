@@ -0,0 +1,254 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <math.h>
+#include <string.h>
+
+int ags_level_util_test_init_suite();
+int ags_level_util_test_clean_suite();
+
+void ags_level_util_test_analyse();
+void ags_level_util_test_true_peak();
+void ags_level_util_test_get_block();
+
+#define AGS_LEVEL_UTIL_TEST_SAMPLERATE (48000)
+#define AGS_LEVEL_UTIL_TEST_BUFFER_SIZE (512)
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_level_util_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_level_util_test_clean_suite()
+{
+  return(0);
+}
+
+void
+ags_level_util_test_analyse()
+{
+  AgsLevelUtil *level_util;
+  AgsLevelUtilBlock *block;
+
+  gdouble *buffer;
+
+  gdouble volume;
+  guint frame_count;
+  guint i;
+
+  level_util = ags_level_util_alloc(2,
+				    AGS_LEVEL_UTIL_TEST_SAMPLERATE);
+
+  /* EBU Tech 3341 - stereo 997 Hz at -23 dBFS reads -23 LUFS */
+  frame_count = 10 * AGS_LEVEL_UTIL_TEST_SAMPLERATE;
+
+  volume = pow(10.0, -23.0 / 20.0);
+
+  buffer = (gdouble *) g_malloc(2 * frame_count * sizeof(gdouble));
+
+  for(i = 0; i < frame_count; i++){
+    buffer[2 * i] =
+      buffer[2 * i + 1] = volume * sin(2.0 * M_PI * 997.0 * (gdouble) i / (gdouble) AGS_LEVEL_UTIL_TEST_SAMPLERATE);
+  }
+
+  for(i = 0; i < frame_count; i += AGS_LEVEL_UTIL_TEST_BUFFER_SIZE){
+    ags_level_util_analyse(level_util,
+			   buffer + 2 * i, ((frame_count - i < AGS_LEVEL_UTIL_TEST_BUFFER_SIZE) ? frame_count - i: AGS_LEVEL_UTIL_TEST_BUFFER_SIZE),
+			   AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+  }
+
+  block = ags_level_util_get_block(level_util,
+				   0);
+
+  CU_ASSERT(block != NULL);
+
+  CU_ASSERT(fabs(block->momentary - -23.0) < 0.1);
+  CU_ASSERT(fabs(block->short_term - -23.0) < 0.1);
+  CU_ASSERT(fabs(block->integrated - -23.0) < 0.1);
+
+  CU_ASSERT(fabs(block->peak[0] - volume) < 0.001);
+  CU_ASSERT(fabs(block->rms[1] - volume / M_SQRT2) < 0.001);
+
+  /* silence is gated */
+  ags_level_util_reset(level_util);
+
+  memset(buffer, 0, 2 * frame_count * sizeof(gdouble));
+
+  ags_level_util_analyse(level_util,
+			 buffer, frame_count,
+			 AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+  CU_ASSERT(ags_level_util_get_integrated(level_util) == AGS_LEVEL_UTIL_SILENCE);
+  CU_ASSERT(ags_level_util_get_momentary(level_util) == AGS_LEVEL_UTIL_SILENCE);
+
+  g_free(buffer);
+
+  ags_level_util_free(level_util);
+}
+
+void
+ags_level_util_test_true_peak()
+{
+  AgsLevelUtil *level_util;
+  AgsLevelUtilBlock *block;
+
+  gdouble *buffer;
+
+  guint i;
+
+  level_util = ags_level_util_alloc(1,
+				    AGS_LEVEL_UTIL_TEST_SAMPLERATE);
+
+  /* quarter samplerate at 45 degree phase - every sample misses the peak */
+  buffer = (gdouble *) g_malloc(2 * AGS_LEVEL_UTIL_TEST_BUFFER_SIZE * sizeof(gdouble));
+
+  for(i = 0; i < 2 * AGS_LEVEL_UTIL_TEST_BUFFER_SIZE; i++){
+    buffer[i] = sin(M_PI / 2.0 * (gdouble) i + M_PI / 4.0);
+  }
+
+  ags_level_util_analyse(level_util,
+			 buffer, AGS_LEVEL_UTIL_TEST_BUFFER_SIZE,
+			 AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+  ags_level_util_analyse(level_util,
+			 buffer + AGS_LEVEL_UTIL_TEST_BUFFER_SIZE, AGS_LEVEL_UTIL_TEST_BUFFER_SIZE,
+			 AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+  block = ags_level_util_get_block(level_util,
+				   0);
+
+  CU_ASSERT(block != NULL);
+
+  CU_ASSERT(fabs(block->peak[0] - M_SQRT1_2) < 0.001);
+  CU_ASSERT(fabs(ags_level_util_to_db(block->true_peak[0])) < 0.1);
+
+  g_free(buffer);
+
+  ags_level_util_free(level_util);
+}
+
+void
+ags_level_util_test_get_block()
+{
+  AgsLevelUtil *level_util;
+  AgsLevelUtilBlock *block;
+
+  gdouble *buffer;
+
+  guint i;
+
+  level_util = ags_level_util_alloc(1,
+				    AGS_LEVEL_UTIL_TEST_SAMPLERATE);
+
+  CU_ASSERT(ags_level_util_get_block(level_util, 0) == NULL);
+
+  buffer = (gdouble *) g_malloc(AGS_LEVEL_UTIL_TEST_BUFFER_SIZE * sizeof(gdouble));
+
+  for(i = 0; i < 3; i++){
+    guint j;
+
+    for(j = 0; j < AGS_LEVEL_UTIL_TEST_BUFFER_SIZE; j++){
+      buffer[j] = 0.25 * (gdouble) (i + 1);
+    }
+
+    ags_level_util_analyse(level_util,
+			   buffer, AGS_LEVEL_UTIL_TEST_BUFFER_SIZE,
+			   AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+  }
+
+  block = ags_level_util_get_block(level_util,
+				   0);
+
+  CU_ASSERT(block != NULL &&
+	    block->serial == 2 &&
+	    block->offset == 2 * AGS_LEVEL_UTIL_TEST_BUFFER_SIZE &&
+	    fabs(block->peak[0] - 0.75) < 0.000001);
+
+  block = ags_level_util_get_block(level_util,
+				   2);
+
+  CU_ASSERT(block != NULL &&
+	    block->serial == 0 &&
+	    fabs(block->peak[0] - 0.25) < 0.000001);
+
+  CU_ASSERT(ags_level_util_get_block(level_util, 3) == NULL);
+
+  g_free(buffer);
+
+  ags_level_util_free(level_util);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsLevelUtilTest", ags_level_util_test_init_suite, ags_level_util_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of ags_level_util.c analyse", ags_level_util_test_analyse) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_level_util.c true-peak", ags_level_util_test_true_peak) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_level_util.c get block", ags_level_util_test_get_block) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
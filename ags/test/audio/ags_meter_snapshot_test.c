@@ -0,0 +1,303 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+int ags_meter_snapshot_test_init_suite();
+int ags_meter_snapshot_test_clean_suite();
+
+void ags_meter_snapshot_test_subscribe();
+void ags_meter_snapshot_test_unsubscribe();
+void ags_meter_snapshot_test_put();
+void ags_meter_snapshot_test_publish();
+
+#define AGS_METER_SNAPSHOT_TEST_PUT_VALUE (16.0)
+#define AGS_METER_SNAPSHOT_TEST_PUBLISH_VALUE (0.5)
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_meter_snapshot_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_meter_snapshot_test_clean_suite()
+{
+  return(0);
+}
+
+void
+ags_meter_snapshot_test_subscribe()
+{
+  AgsMeterSnapshot *meter_snapshot;
+  AgsPort *port;
+
+  guint port_slot, pushed_slot;
+  guint slot;
+  guint subscription_generation;
+
+  meter_snapshot = ags_meter_snapshot_new();
+
+  port = ags_port_new();
+
+  subscription_generation = ags_meter_snapshot_get_subscription_generation(meter_snapshot);
+
+  /* same source, different entry type */
+  port_slot = ags_meter_snapshot_subscribe(meter_snapshot,
+					   (GObject *) port,
+					   AGS_METER_SNAPSHOT_ENTRY_PORT);
+  pushed_slot = ags_meter_snapshot_subscribe(meter_snapshot,
+					     (GObject *) port,
+					     AGS_METER_SNAPSHOT_ENTRY_PUSHED);
+
+  CU_ASSERT(port_slot != AGS_METER_SNAPSHOT_INVALID_SLOT);
+  CU_ASSERT(pushed_slot != AGS_METER_SNAPSHOT_INVALID_SLOT);
+  CU_ASSERT(port_slot != pushed_slot);
+  CU_ASSERT(meter_snapshot->entry[pushed_slot].entry_type == AGS_METER_SNAPSHOT_ENTRY_PUSHED);
+  CU_ASSERT(ags_meter_snapshot_get_subscription_generation(meter_snapshot) == subscription_generation + 2);
+
+  /* same source, same entry type */
+  slot = ags_meter_snapshot_subscribe(meter_snapshot,
+				      (GObject *) port,
+				      AGS_METER_SNAPSHOT_ENTRY_PORT);
+
+  CU_ASSERT(slot == port_slot);
+  CU_ASSERT(meter_snapshot->entry[port_slot].ref_count == 2);
+
+  /* find */
+  CU_ASSERT(ags_meter_snapshot_try_find_slot(meter_snapshot,
+					     (GObject *) port,
+					     AGS_METER_SNAPSHOT_ENTRY_PUSHED,
+					     &slot) == TRUE);
+  CU_ASSERT(slot == pushed_slot);
+
+  CU_ASSERT(ags_meter_snapshot_try_find_slot(meter_snapshot,
+					     (GObject *) port,
+					     AGS_METER_SNAPSHOT_ENTRY_SOUNDCARD,
+					     &slot) == TRUE);
+  CU_ASSERT(slot == AGS_METER_SNAPSHOT_INVALID_SLOT);
+
+  g_object_unref(meter_snapshot);
+  g_object_unref(port);
+}
+
+void
+ags_meter_snapshot_test_unsubscribe()
+{
+  AgsMeterSnapshot *meter_snapshot;
+  AgsPort *port;
+
+  guint port_slot, pushed_slot;
+  guint slot;
+
+  meter_snapshot = ags_meter_snapshot_new();
+
+  port = ags_port_new();
+
+  port_slot = ags_meter_snapshot_subscribe(meter_snapshot,
+					   (GObject *) port,
+					   AGS_METER_SNAPSHOT_ENTRY_PORT);
+  pushed_slot = ags_meter_snapshot_subscribe(meter_snapshot,
+					     (GObject *) port,
+					     AGS_METER_SNAPSHOT_ENTRY_PUSHED);
+
+  /* the other entry type stays subscribed */
+  ags_meter_snapshot_unsubscribe(meter_snapshot,
+				 port_slot);
+
+  CU_ASSERT(meter_snapshot->entry[port_slot].source == NULL);
+  CU_ASSERT(meter_snapshot->entry[pushed_slot].source == (gpointer) port);
+
+  ags_meter_snapshot_try_find_slot(meter_snapshot,
+				   (GObject *) port,
+				   AGS_METER_SNAPSHOT_ENTRY_PORT,
+				   &slot);
+  CU_ASSERT(slot == AGS_METER_SNAPSHOT_INVALID_SLOT);
+
+  ags_meter_snapshot_try_find_slot(meter_snapshot,
+				   (GObject *) port,
+				   AGS_METER_SNAPSHOT_ENTRY_PUSHED,
+				   &slot);
+  CU_ASSERT(slot == pushed_slot);
+
+  /* released slot is reused */
+  slot = ags_meter_snapshot_subscribe(meter_snapshot,
+				      (GObject *) port,
+				      AGS_METER_SNAPSHOT_ENTRY_SOUNDCARD);
+  CU_ASSERT(slot == port_slot);
+
+  g_object_unref(meter_snapshot);
+  g_object_unref(port);
+}
+
+void
+ags_meter_snapshot_test_put()
+{
+  AgsMeterSnapshot *meter_snapshot;
+  AgsPort *port, *other_port;
+
+  guint slot;
+  guint sequence;
+
+  meter_snapshot = ags_meter_snapshot_new();
+
+  port = ags_port_new();
+  other_port = ags_port_new();
+
+  slot = ags_meter_snapshot_subscribe(meter_snapshot,
+				      (GObject *) port,
+				      AGS_METER_SNAPSHOT_ENTRY_PUSHED);
+
+  sequence = meter_snapshot->entry[slot].sequence;
+
+  ags_meter_snapshot_put(meter_snapshot,
+			 slot,
+			 (GObject *) port,
+			 AGS_METER_SNAPSHOT_TEST_PUT_VALUE);
+
+  CU_ASSERT(meter_snapshot->entry[slot].value == AGS_METER_SNAPSHOT_TEST_PUT_VALUE);
+  CU_ASSERT(meter_snapshot->entry[slot].sequence == sequence + 2);
+
+  /* mismatching source is dropped */
+  ags_meter_snapshot_put(meter_snapshot,
+			 slot,
+			 (GObject *) other_port,
+			 0.0);
+
+  CU_ASSERT(meter_snapshot->entry[slot].value == AGS_METER_SNAPSHOT_TEST_PUT_VALUE);
+
+  /* invalid slot is dropped */
+  ags_meter_snapshot_put(meter_snapshot,
+			 AGS_METER_SNAPSHOT_INVALID_SLOT,
+			 (GObject *) port,
+			 0.0);
+
+  CU_ASSERT(meter_snapshot->entry[slot].value == AGS_METER_SNAPSHOT_TEST_PUT_VALUE);
+
+  g_object_unref(meter_snapshot);
+  g_object_unref(port);
+  g_object_unref(other_port);
+}
+
+void
+ags_meter_snapshot_test_publish()
+{
+  AgsMeterSnapshot *meter_snapshot;
+  AgsPort *port;
+
+  guint port_slot, pushed_slot;
+  guint generation;
+
+  meter_snapshot = ags_meter_snapshot_new();
+
+  port = ags_port_new();
+  port->port_value.ags_port_double = AGS_METER_SNAPSHOT_TEST_PUBLISH_VALUE;
+
+  port_slot = ags_meter_snapshot_subscribe(meter_snapshot,
+					   (GObject *) port,
+					   AGS_METER_SNAPSHOT_ENTRY_PORT);
+  pushed_slot = ags_meter_snapshot_subscribe(meter_snapshot,
+					     (GObject *) port,
+					     AGS_METER_SNAPSHOT_ENTRY_PUSHED);
+
+  ags_meter_snapshot_put(meter_snapshot,
+			 pushed_slot,
+			 (GObject *) port,
+			 AGS_METER_SNAPSHOT_TEST_PUT_VALUE);
+
+  /* not visible before publish */
+  CU_ASSERT(ags_meter_snapshot_read(meter_snapshot,
+				    pushed_slot) == 0.0);
+
+  generation = ags_meter_snapshot_get_generation(meter_snapshot);
+
+  ags_meter_snapshot_publish(meter_snapshot);
+
+  CU_ASSERT(ags_meter_snapshot_get_generation(meter_snapshot) == generation + 1);
+  CU_ASSERT(ags_meter_snapshot_read(meter_snapshot,
+				    port_slot) == AGS_METER_SNAPSHOT_TEST_PUBLISH_VALUE);
+  CU_ASSERT(ags_meter_snapshot_read(meter_snapshot,
+				    pushed_slot) == AGS_METER_SNAPSHOT_TEST_PUT_VALUE);
+
+  /* recent value is carried over */
+  ags_meter_snapshot_publish(meter_snapshot);
+
+  CU_ASSERT(ags_meter_snapshot_read(meter_snapshot,
+				    pushed_slot) == AGS_METER_SNAPSHOT_TEST_PUT_VALUE);
+
+  g_object_unref(meter_snapshot);
+  g_object_unref(port);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsMeterSnapshotTest", ags_meter_snapshot_test_init_suite, ags_meter_snapshot_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsMeterSnapshot subscribe", ags_meter_snapshot_test_subscribe) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsMeterSnapshot unsubscribe", ags_meter_snapshot_test_unsubscribe) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsMeterSnapshot put", ags_meter_snapshot_test_put) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsMeterSnapshot publish", ags_meter_snapshot_test_publish) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
@@ -31,6 +31,8 @@ int ags_midiin_test_clean_suite();
 
 void ags_midiin_test_dispose();
 void ags_midiin_test_finalize();
+void ags_midiin_test_ring_append();
+void ags_midiin_test_get_frame_offset();
 
 void ags_midiin_test_finalize_stub(GObject *gobject);
 
@@ -50,6 +52,10 @@ void ags_midiin_test_finalize_stub(GObject *gobject);
   "auto-sense=true\n"				\
   "\n"
 
+#define AGS_MIDIIN_TEST_POLL_START_TIME (1000)
+#define AGS_MIDIIN_TEST_POLL_TIME (2000)
+
+#define AGS_MIDIIN_TEST_BUFFER_SIZE (256)
 
 AgsAudioApplicationContext *audio_application_context;
 gboolean midiin_test_finalized;
@@ -145,6 +151,113 @@ ags_midiin_test_finalize_stub(GObject *gobject)
   midiin_test_finalized = TRUE;
 }
 
+void
+ags_midiin_test_ring_append()
+{
+  AgsMidiin *midiin;
+
+  guchar note_on_status[] = {0x90};
+  guchar timing_clock[] = {0xf8};
+  guchar note_on_data[] = {0x3c, 0x64};
+
+  guchar *buffer;
+  
+  midiin = g_object_new(AGS_TYPE_MIDIIN,
+			NULL);
+
+  midiin->poll_time = AGS_MIDIIN_TEST_POLL_START_TIME;
+  
+  /* timing clock received within note on */
+  ags_midiin_ring_append(midiin,
+			 0,
+			 note_on_status, 1,
+			 1250);
+  ags_midiin_ring_append(midiin,
+			 0,
+			 timing_clock, 1,
+			 1500);
+  ags_midiin_ring_append(midiin,
+			 0,
+			 note_on_data, 2,
+			 1600);
+
+  ags_midiin_ring_commit(midiin,
+			 0, 0,
+			 AGS_MIDIIN_TEST_POLL_TIME);
+
+  buffer = (guchar *) midiin->buffer[0];
+  
+  /* assert */
+  CU_ASSERT(midiin->buffer_size[0] == 4);
+  CU_ASSERT(midiin->event_count[0] == 2);
+  CU_ASSERT(midiin->event_duration[0] == AGS_MIDIIN_TEST_POLL_TIME - AGS_MIDIIN_TEST_POLL_START_TIME);
+
+  CU_ASSERT(midiin->event[0][0].offset == 0);
+  CU_ASSERT(midiin->event[0][0].length == 1);
+  CU_ASSERT(midiin->event[0][0].timestamp == 500);
+  CU_ASSERT(buffer[0] == 0xf8);
+
+  CU_ASSERT(midiin->event[0][1].offset == 1);
+  CU_ASSERT(midiin->event[0][1].length == 3);
+  CU_ASSERT(midiin->event[0][1].timestamp == 250);
+  CU_ASSERT(buffer[1] == 0x90 &&
+	    buffer[2] == 0x3c &&
+	    buffer[3] == 0x64);
+  
+  g_object_run_dispose(midiin);
+  g_object_unref(midiin);
+}
+
+void
+ags_midiin_test_get_frame_offset()
+{
+  AgsMidiin *midiin;
+
+  guchar note_on[] = {0x90, 0x3c, 0x64};
+  guchar note_off[] = {0x80, 0x3c, 0x00};
+
+  midiin = g_object_new(AGS_TYPE_MIDIIN,
+			NULL);
+
+  midiin->poll_time = AGS_MIDIIN_TEST_POLL_START_TIME;
+
+  ags_midiin_ring_append(midiin,
+			 0,
+			 note_on, 3,
+			 1250);
+  ags_midiin_ring_append(midiin,
+			 0,
+			 note_off, 3,
+			 1500);
+
+  ags_midiin_ring_commit(midiin,
+			 0, 1,
+			 AGS_MIDIIN_TEST_POLL_TIME);
+
+  /* no current buffer */
+  midiin->flags &= (~(AGS_MIDIIN_BUFFER0 |
+		      AGS_MIDIIN_BUFFER1 |
+		      AGS_MIDIIN_BUFFER2 |
+		      AGS_MIDIIN_BUFFER3));
+
+  CU_ASSERT(ags_midiin_get_frame_offset(midiin,
+					0,
+					AGS_MIDIIN_TEST_BUFFER_SIZE) == 0);
+
+  /* current buffer */
+  midiin->flags |= AGS_MIDIIN_BUFFER1;
+
+  CU_ASSERT(ags_midiin_get_frame_offset(midiin,
+					0,
+					AGS_MIDIIN_TEST_BUFFER_SIZE) == 64);
+  CU_ASSERT(ags_midiin_get_frame_offset(midiin,
+					4,
+					AGS_MIDIIN_TEST_BUFFER_SIZE) == 128);
+  
+  g_object_run_dispose(midiin);
+  g_object_unref(midiin);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -173,7 +286,9 @@ main(int argc, char **argv)
 
   /* add the tests to the suite */
   if((CU_add_test(pSuite, "test of AgsMidiin doing dispose", ags_midiin_test_dispose) == NULL) ||
-     (CU_add_test(pSuite, "test of AgsMidiin doing finalize", ags_midiin_test_finalize) == NULL)){
+     (CU_add_test(pSuite, "test of AgsMidiin doing finalize", ags_midiin_test_finalize) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsMidiin ring append", ags_midiin_test_ring_append) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsMidiin get frame offset", ags_midiin_test_get_frame_offset) == NULL)){
     CU_cleanup_registry();
       
     return CU_get_error();
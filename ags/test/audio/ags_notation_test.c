@@ -48,6 +48,7 @@ void ags_notation_test_remove_region_from_selection();
 void ags_notation_test_copy_selection();
 void ags_notation_test_cut_selection();
 void ags_notation_test_insert_from_clipboard();
+void ags_notation_test_update_snapshot();
 
 #define AGS_NOTATION_TEST_FIND_NEAR_TIMESTAMP_N_NOTATION (8)
 
@@ -65,6 +66,10 @@ void ags_notation_test_insert_from_clipboard();
 #define AGS_NOTATION_TEST_REMOVE_NOTE_AT_POSITION_COUNT (1024)
 #define AGS_NOTATION_TEST_REMOVE_NOTE_AT_POSITION_REMOVE_COUNT (256)
 
+#define AGS_NOTATION_TEST_UPDATE_SNAPSHOT_WIDTH (1024)
+#define AGS_NOTATION_TEST_UPDATE_SNAPSHOT_HEIGHT (88)
+#define AGS_NOTATION_TEST_UPDATE_SNAPSHOT_COUNT (1024)
+
 #define AGS_NOTATION_TEST_IS_NOTE_SELECTED_WIDTH (1024)
 #define AGS_NOTATION_TEST_IS_NOTE_SELECTED_HEIGHT (88)
 #define AGS_NOTATION_TEST_IS_NOTE_SELECTED_COUNT (1024)
@@ -804,6 +809,111 @@ ags_notation_test_insert_from_clipboard()
   //TODO:JK: implement me
 }
 
+void
+ags_notation_test_update_snapshot()
+{
+  AgsNotation *notation;
+  AgsNote *note;
+
+  AgsNotationSnapshot *snapshot;
+  
+  guint x0, y;
+  guint offset;
+  guint i;
+  gboolean success;
+
+  /* create notation */
+  notation = ags_notation_new(audio,
+			      0);
+
+  for(i = 0; i < AGS_NOTATION_TEST_UPDATE_SNAPSHOT_COUNT; i++){
+    x0 = rand() % AGS_NOTATION_TEST_UPDATE_SNAPSHOT_WIDTH;
+    y = rand() % AGS_NOTATION_TEST_UPDATE_SNAPSHOT_HEIGHT;
+    
+    note = ags_note_new_with_offset(x0, x0 + 1,
+				    y,
+				    0.0, 0.0);
+
+    ags_notation_add_note(notation,
+			  note,
+			  FALSE);
+  }
+
+  ags_notation_update_snapshot(notation);
+
+  /* assert sorted */
+  snapshot = ags_notation_acquire_snapshot(notation);
+
+  CU_ASSERT(snapshot != NULL);
+  CU_ASSERT(snapshot->n_notes == g_list_length(notation->note));
+  CU_ASSERT(snapshot->max_length == 1);
+
+  success = TRUE;
+  
+  for(i = 1; i < snapshot->n_notes; i++){
+    if(!(snapshot->x0[i - 1] < snapshot->x0[i] ||
+	 (snapshot->x0[i - 1] == snapshot->x0[i] &&
+	  snapshot->y[i - 1] <= snapshot->y[i]))){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  /* assert find offset */
+  success = TRUE;
+
+  for(i = 0; i < AGS_NOTATION_TEST_UPDATE_SNAPSHOT_WIDTH; i++){
+    offset = ags_notation_snapshot_find_offset(snapshot,
+					       i);
+
+    if((offset < snapshot->n_notes && snapshot->x0[offset] < i) ||
+       (offset > 0 && snapshot->x0[offset - 1] >= i)){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  ags_notation_release_snapshot(notation);
+
+  /* assert dirty after remove */
+  note = notation->note->data;
+  
+  ags_notation_remove_note_at_position(notation,
+				       note->x[0],
+				       note->y);
+
+  CU_ASSERT(g_atomic_int_get(&(notation->snapshot_dirty)) == TRUE);
+
+  /* acquire doesn't rebuild */
+  snapshot = ags_notation_acquire_snapshot(notation);
+
+  CU_ASSERT(snapshot->n_notes == g_list_length(notation->note) + 1);
+
+  /* retired snapshot is kept while read */
+  ags_notation_update_snapshot(notation);
+
+  CU_ASSERT(g_list_find(notation->retired_snapshot, snapshot) != NULL);
+
+  ags_notation_release_snapshot(notation);
+
+  snapshot = ags_notation_acquire_snapshot(notation);
+
+  CU_ASSERT(snapshot->n_notes == g_list_length(notation->note));
+
+  ags_notation_release_snapshot(notation);
+
+  /* retired snapshot is freed by the next update */
+  ags_notation_update_snapshot(notation);
+
+  CU_ASSERT(notation->retired_snapshot == NULL);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -842,7 +952,8 @@ main(int argc, char **argv)
      (CU_add_test(pSuite, "test of AgsNotation remove region from selection", ags_notation_test_remove_region_from_selection) == NULL) ||
      (CU_add_test(pSuite, "test of AgsNotation copy selection", ags_notation_test_copy_selection) == NULL) ||
      (CU_add_test(pSuite, "test of AgsNotation cut selection", ags_notation_test_cut_selection) == NULL) ||
-     (CU_add_test(pSuite, "test of AgsNotation insert from clipboard", ags_notation_test_insert_from_clipboard) == NULL)){
+     (CU_add_test(pSuite, "test of AgsNotation insert from clipboard", ags_notation_test_insert_from_clipboard) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsNotation update snapshot", ags_notation_test_update_snapshot) == NULL)){
     CU_cleanup_registry();
       
       return CU_get_error();
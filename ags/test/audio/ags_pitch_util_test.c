@@ -0,0 +1,585 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <math.h>
+
+int ags_pitch_util_test_init_suite();
+int ags_pitch_util_test_clean_suite();
+
+void ags_pitch_util_test_resample();
+void ags_pitch_util_test_resample_streaming();
+void ags_pitch_util_test_phase_vocoder();
+void ags_pitch_util_test_resample_at();
+void ags_pitch_util_test_resample_data();
+void ags_pitch_util_test_pitch();
+
+#define AGS_PITCH_UTIL_TEST_FREQ (440.0)
+#define AGS_PITCH_UTIL_TEST_VOLUME (0.5)
+#define AGS_PITCH_UTIL_TEST_SAMPLERATE (48000)
+#define AGS_PITCH_UTIL_TEST_FRAME_COUNT (32768)
+#define AGS_PITCH_UTIL_TEST_BUFFER_SIZE (512)
+#define AGS_PITCH_UTIL_TEST_WINDOW_OFFSET (1000)
+#define AGS_PITCH_UTIL_TEST_RESAMPLE_AT_FRAME (2000)
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_pitch_util_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_pitch_util_test_clean_suite()
+{
+  return(0);
+}
+
+void
+ags_pitch_util_test_resample()
+{
+  AgsPitchUtil *pitch_util;
+
+  gdouble *source;
+  gdouble *buffer;
+
+  guint frame_count;
+  guint i;
+  gboolean success;
+
+  pitch_util = ags_pitch_util_alloc(AGS_PITCH_UTIL_RESAMPLE,
+				    AGS_PITCH_UTIL_TEST_SAMPLERATE);
+
+  source = ags_pitch_util_reserve_source(pitch_util,
+					 AGS_PITCH_UTIL_TEST_FRAME_COUNT);
+
+  for(i = 0; i < AGS_PITCH_UTIL_TEST_FRAME_COUNT; i++){
+    source[i] = AGS_PITCH_UTIL_TEST_VOLUME * sin(2.0 * M_PI * AGS_PITCH_UTIL_TEST_FREQ * (gdouble) i / (gdouble) AGS_PITCH_UTIL_TEST_SAMPLERATE);
+  }
+
+  /* unity */
+  buffer = (gdouble *) ags_stream_alloc(AGS_PITCH_UTIL_TEST_FRAME_COUNT,
+					AGS_SOUNDCARD_DOUBLE);
+
+  CU_ASSERT(ags_pitch_util_get_frame_count(pitch_util) == AGS_PITCH_UTIL_TEST_FRAME_COUNT);
+  CU_ASSERT(ags_pitch_util_resample(pitch_util,
+				    buffer,
+				    AGS_PITCH_UTIL_TEST_FRAME_COUNT,
+				    AGS_AUDIO_BUFFER_UTIL_DOUBLE) == AGS_PITCH_UTIL_TEST_FRAME_COUNT);
+
+  success = TRUE;
+
+  for(i = 0; i < AGS_PITCH_UTIL_TEST_FRAME_COUNT; i++){
+    if(fabs(buffer[i] - source[i]) > 0.000001){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  /* an octave up halves the length */
+  ags_pitch_util_set_pitch(pitch_util,
+			   0.0,
+			   1200.0);
+  ags_pitch_util_reset(pitch_util);
+
+  frame_count = ags_pitch_util_get_frame_count(pitch_util);
+
+  CU_ASSERT(frame_count == AGS_PITCH_UTIL_TEST_FRAME_COUNT / 2);
+
+  ags_audio_buffer_util_clear_double(buffer, 1,
+				     AGS_PITCH_UTIL_TEST_FRAME_COUNT);
+
+  CU_ASSERT(ags_pitch_util_resample(pitch_util,
+				    buffer,
+				    AGS_PITCH_UTIL_TEST_FRAME_COUNT,
+				    AGS_AUDIO_BUFFER_UTIL_DOUBLE) == frame_count);
+
+  success = TRUE;
+
+  for(i = 0; i + 1 < frame_count; i++){
+    if(fabs(buffer[i] - source[2 * i]) > 0.000001){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  ags_stream_free(buffer);
+
+  ags_pitch_util_free(pitch_util);
+}
+
+void
+ags_pitch_util_test_resample_streaming()
+{
+  AgsPitchUtil *pitch_util;
+
+  gdouble *source;
+  gdouble *buffer, *stream_buffer;
+
+  guint frame_count;
+  guint i;
+  gboolean success;
+
+  pitch_util = ags_pitch_util_alloc(AGS_PITCH_UTIL_RESAMPLE,
+				    AGS_PITCH_UTIL_TEST_SAMPLERATE);
+
+  source = ags_pitch_util_reserve_source(pitch_util,
+					 AGS_PITCH_UTIL_TEST_FRAME_COUNT);
+
+  for(i = 0; i < AGS_PITCH_UTIL_TEST_FRAME_COUNT; i++){
+    source[i] = AGS_PITCH_UTIL_TEST_VOLUME * sin(2.0 * M_PI * AGS_PITCH_UTIL_TEST_FREQ * (gdouble) i / (gdouble) AGS_PITCH_UTIL_TEST_SAMPLERATE);
+  }
+
+  ags_pitch_util_set_samplerate(pitch_util,
+				44100, AGS_PITCH_UTIL_TEST_SAMPLERATE);
+  ags_pitch_util_set_pitch(pitch_util,
+			   0.0,
+			   700.0);
+
+  frame_count = ags_pitch_util_get_frame_count(pitch_util);
+
+  buffer = (gdouble *) ags_stream_alloc(frame_count,
+					AGS_SOUNDCARD_DOUBLE);
+  stream_buffer = (gdouble *) ags_stream_alloc(frame_count,
+					       AGS_SOUNDCARD_DOUBLE);
+
+  /* in one go */
+  ags_pitch_util_resample(pitch_util,
+			  buffer,
+			  frame_count,
+			  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+  /* period by period */
+  ags_pitch_util_reset(pitch_util);
+
+  for(i = 0; i < frame_count; i += AGS_PITCH_UTIL_TEST_BUFFER_SIZE){
+    ags_pitch_util_resample(pitch_util,
+			    stream_buffer + i,
+			    ((frame_count - i < AGS_PITCH_UTIL_TEST_BUFFER_SIZE) ? frame_count - i: AGS_PITCH_UTIL_TEST_BUFFER_SIZE),
+			    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+  }
+
+  success = TRUE;
+
+  for(i = 0; i < frame_count; i++){
+    if(fabs(buffer[i] - stream_buffer[i]) > 0.000001){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  ags_stream_free(buffer);
+  ags_stream_free(stream_buffer);
+
+  ags_pitch_util_free(pitch_util);
+}
+
+void
+ags_pitch_util_test_phase_vocoder()
+{
+  AgsPitchUtil *pitch_util;
+
+  gdouble *buffer;
+
+  gdouble rms;
+  gdouble magnitude, current_magnitude;
+  gdouble freq, current_freq;
+  guint offset, count;
+  guint i;
+
+  pitch_util = ags_pitch_util_alloc(AGS_PITCH_UTIL_PHASE_VOCODER,
+				    AGS_PITCH_UTIL_TEST_SAMPLERATE);
+
+  ags_pitch_util_set_pitch(pitch_util,
+			   0.0,
+			   1200.0);
+
+  buffer = (gdouble *) ags_stream_alloc(AGS_PITCH_UTIL_TEST_FRAME_COUNT,
+					AGS_SOUNDCARD_DOUBLE);
+
+  for(i = 0; i < AGS_PITCH_UTIL_TEST_FRAME_COUNT; i++){
+    buffer[i] = AGS_PITCH_UTIL_TEST_VOLUME * sin(2.0 * M_PI * AGS_PITCH_UTIL_TEST_FREQ * (gdouble) i / (gdouble) AGS_PITCH_UTIL_TEST_SAMPLERATE);
+  }
+
+  for(i = 0; i < AGS_PITCH_UTIL_TEST_FRAME_COUNT; i += AGS_PITCH_UTIL_TEST_BUFFER_SIZE){
+    ags_pitch_util_phase_vocoder(pitch_util,
+				 buffer + i, AGS_PITCH_UTIL_TEST_BUFFER_SIZE,
+				 AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+  }
+
+  /* skip latency and settle */
+  offset = AGS_PITCH_UTIL_TEST_FRAME_COUNT / 2;
+  count = AGS_PITCH_UTIL_TEST_FRAME_COUNT / 4;
+
+  rms = 0.0;
+
+  for(i = 0; i < count; i++){
+    rms += buffer[offset + i] * buffer[offset + i];
+  }
+
+  rms = sqrt(rms / (gdouble) count);
+
+  CU_ASSERT(fabs(rms - AGS_PITCH_UTIL_TEST_VOLUME / M_SQRT2) < 0.05);
+
+  /* strongest partial is an octave up */
+  magnitude = 0.0;
+  freq = 0.0;
+
+  for(current_freq = 100.0; current_freq < 2000.0; current_freq += 10.0){
+    gdouble re, im;
+
+    re = 0.0;
+    im = 0.0;
+
+    for(i = 0; i < count; i++){
+      re += buffer[offset + i] * cos(2.0 * M_PI * current_freq * (gdouble) i / (gdouble) AGS_PITCH_UTIL_TEST_SAMPLERATE);
+      im += buffer[offset + i] * sin(2.0 * M_PI * current_freq * (gdouble) i / (gdouble) AGS_PITCH_UTIL_TEST_SAMPLERATE);
+    }
+
+    current_magnitude = re * re + im * im;
+
+    if(current_magnitude > magnitude){
+      magnitude = current_magnitude;
+      freq = current_freq;
+    }
+  }
+
+  CU_ASSERT(fabs(freq - 2.0 * AGS_PITCH_UTIL_TEST_FREQ) <= 10.0);
+
+  ags_stream_free(buffer);
+
+  ags_pitch_util_free(pitch_util);
+}
+
+void
+ags_pitch_util_test_resample_at()
+{
+  AgsPitchUtil *pitch_util;
+
+  gdouble *source;
+  gdouble *buffer;
+
+  guint source_length;
+  guint i;
+  gboolean success;
+
+  pitch_util = ags_pitch_util_alloc(AGS_PITCH_UTIL_RESAMPLE,
+				    AGS_PITCH_UTIL_TEST_SAMPLERATE);
+
+  /* window is bounded */
+  source_length = AGS_PITCH_UTIL_TEST_FRAME_COUNT;
+  
+  source = ags_pitch_util_reserve_window(pitch_util,
+					 pitch_util,
+					 AGS_PITCH_UTIL_TEST_WINDOW_OFFSET,
+					 &source_length);
+
+  CU_ASSERT(source_length == AGS_PITCH_UTIL_DEFAULT_WINDOW_SIZE);
+  CU_ASSERT(pitch_util->source_allocated == AGS_PITCH_UTIL_DEFAULT_WINDOW_SIZE);
+
+  for(i = 0; i < source_length; i++){
+    source[i] = AGS_PITCH_UTIL_TEST_VOLUME * sin(2.0 * M_PI * AGS_PITCH_UTIL_TEST_FREQ * (gdouble) (AGS_PITCH_UTIL_TEST_WINDOW_OFFSET + i) / (gdouble) AGS_PITCH_UTIL_TEST_SAMPLERATE);
+  }
+
+  CU_ASSERT(ags_pitch_util_has_window(pitch_util,
+				      pitch_util,
+				      AGS_PITCH_UTIL_TEST_WINDOW_OFFSET, AGS_PITCH_UTIL_TEST_BUFFER_SIZE) == TRUE);
+  CU_ASSERT(ags_pitch_util_has_window(pitch_util,
+				      pitch_util,
+				      AGS_PITCH_UTIL_TEST_WINDOW_OFFSET - 1, AGS_PITCH_UTIL_TEST_BUFFER_SIZE) == FALSE);
+  CU_ASSERT(ags_pitch_util_has_window(pitch_util,
+				      pitch_util,
+				      AGS_PITCH_UTIL_TEST_WINDOW_OFFSET + source_length - AGS_PITCH_UTIL_TEST_BUFFER_SIZE + 1, AGS_PITCH_UTIL_TEST_BUFFER_SIZE) == FALSE);
+  CU_ASSERT(ags_pitch_util_has_window(pitch_util,
+				      source,
+				      AGS_PITCH_UTIL_TEST_WINDOW_OFFSET, AGS_PITCH_UTIL_TEST_BUFFER_SIZE) == FALSE);
+
+  buffer = (gdouble *) ags_stream_alloc(AGS_PITCH_UTIL_TEST_BUFFER_SIZE,
+					AGS_SOUNDCARD_DOUBLE);
+
+  /* forward */
+  CU_ASSERT(ags_pitch_util_resample_at(pitch_util,
+				       buffer,
+				       AGS_PITCH_UTIL_TEST_RESAMPLE_AT_FRAME, AGS_PITCH_UTIL_TEST_BUFFER_SIZE,
+				       FALSE,
+				       AGS_AUDIO_BUFFER_UTIL_DOUBLE) == AGS_PITCH_UTIL_TEST_BUFFER_SIZE);
+
+  success = TRUE;
+
+  for(i = 0; i < AGS_PITCH_UTIL_TEST_BUFFER_SIZE; i++){
+    if(fabs(buffer[i] - source[AGS_PITCH_UTIL_TEST_RESAMPLE_AT_FRAME - AGS_PITCH_UTIL_TEST_WINDOW_OFFSET + i]) > 0.000001){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  /* reverse */
+  ags_audio_buffer_util_clear_double(buffer, 1,
+				     AGS_PITCH_UTIL_TEST_BUFFER_SIZE);
+
+  ags_pitch_util_resample_at(pitch_util,
+			     buffer,
+			     AGS_PITCH_UTIL_TEST_RESAMPLE_AT_FRAME, AGS_PITCH_UTIL_TEST_BUFFER_SIZE,
+			     TRUE,
+			     AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+  success = TRUE;
+
+  for(i = 0; i < AGS_PITCH_UTIL_TEST_BUFFER_SIZE; i++){
+    if(fabs(buffer[i] - source[AGS_PITCH_UTIL_TEST_RESAMPLE_AT_FRAME - AGS_PITCH_UTIL_TEST_WINDOW_OFFSET - i]) > 0.000001){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  ags_stream_free(buffer);
+
+  ags_pitch_util_free(pitch_util);
+}
+
+void
+ags_pitch_util_test_resample_data()
+{
+  AgsPitchUtil *pitch_util;
+
+  gdouble *data;
+  gdouble *buffer;
+
+  guint frame_count;
+  guint i;
+  gboolean success;
+
+  pitch_util = ags_pitch_util_alloc(AGS_PITCH_UTIL_RESAMPLE,
+				    AGS_PITCH_UTIL_TEST_SAMPLERATE);
+
+  /* interleaved stereo, the second channel is resampled */
+  data = (gdouble *) ags_stream_alloc(2 * AGS_PITCH_UTIL_TEST_FRAME_COUNT,
+				      AGS_SOUNDCARD_DOUBLE);
+
+  for(i = 0; i < AGS_PITCH_UTIL_TEST_FRAME_COUNT; i++){
+    data[2 * i] = 0.0;
+    data[2 * i + 1] = AGS_PITCH_UTIL_TEST_VOLUME * sin(2.0 * M_PI * AGS_PITCH_UTIL_TEST_FREQ * (gdouble) i / (gdouble) AGS_PITCH_UTIL_TEST_SAMPLERATE);
+  }
+
+  buffer = (gdouble *) ags_stream_alloc(AGS_PITCH_UTIL_TEST_FRAME_COUNT,
+					AGS_SOUNDCARD_DOUBLE);
+
+  /* unity - spans several windows */
+  CU_ASSERT(ags_pitch_util_resample_data(pitch_util,
+					 buffer,
+					 data, 2,
+					 1, AGS_SOUNDCARD_DOUBLE,
+					 AGS_PITCH_UTIL_TEST_FRAME_COUNT,
+					 0, AGS_PITCH_UTIL_TEST_FRAME_COUNT,
+					 FALSE,
+					 AGS_AUDIO_BUFFER_UTIL_DOUBLE) == AGS_PITCH_UTIL_TEST_FRAME_COUNT);
+
+  success = TRUE;
+
+  for(i = 0; i < AGS_PITCH_UTIL_TEST_FRAME_COUNT; i++){
+    if(fabs(buffer[i] - data[2 * i + 1]) > 0.000001){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  /* an octave up reads every other frame */
+  ags_pitch_util_set_pitch(pitch_util,
+			   0.0,
+			   1200.0);
+
+  frame_count = AGS_PITCH_UTIL_TEST_FRAME_COUNT / 2;
+  
+  ags_audio_buffer_util_clear_double(buffer, 1,
+				     AGS_PITCH_UTIL_TEST_FRAME_COUNT);
+
+  ags_pitch_util_resample_data(pitch_util,
+			       buffer,
+			       data, 2,
+			       1, AGS_SOUNDCARD_DOUBLE,
+			       AGS_PITCH_UTIL_TEST_FRAME_COUNT,
+			       0, frame_count,
+			       FALSE,
+			       AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+  success = TRUE;
+
+  for(i = 0; i + 1 < frame_count; i++){
+    if(fabs(buffer[i] - data[2 * (2 * i) + 1]) > 0.000001){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  /* invalid audio channel */
+  CU_ASSERT(ags_pitch_util_resample_data(pitch_util,
+					 buffer,
+					 data, 2,
+					 2, AGS_SOUNDCARD_DOUBLE,
+					 AGS_PITCH_UTIL_TEST_FRAME_COUNT,
+					 0, AGS_PITCH_UTIL_TEST_BUFFER_SIZE,
+					 FALSE,
+					 AGS_AUDIO_BUFFER_UTIL_DOUBLE) == 0);
+
+  ags_stream_free(data);
+  ags_stream_free(buffer);
+
+  ags_pitch_util_free(pitch_util);
+}
+
+void
+ags_pitch_util_test_pitch()
+{
+  AgsPitchUtil *pitch_util;
+
+  gdouble *buffer;
+
+  gdouble rms;
+  guint offset, count;
+  guint i;
+
+  pitch_util = ags_pitch_util_alloc(AGS_PITCH_UTIL_PHASE_VOCODER,
+				    AGS_PITCH_UTIL_TEST_SAMPLERATE);
+
+  ags_pitch_util_set_pitch(pitch_util,
+			   0.0,
+			   1200.0);
+
+  buffer = (gdouble *) ags_stream_alloc(AGS_PITCH_UTIL_TEST_FRAME_COUNT,
+					AGS_SOUNDCARD_DOUBLE);
+
+  for(i = 0; i < AGS_PITCH_UTIL_TEST_FRAME_COUNT; i++){
+    buffer[i] = AGS_PITCH_UTIL_TEST_VOLUME * sin(2.0 * M_PI * AGS_PITCH_UTIL_TEST_FREQ * (gdouble) i / (gdouble) AGS_PITCH_UTIL_TEST_SAMPLERATE);
+  }
+
+  ags_pitch_util_pitch(pitch_util,
+		       buffer, AGS_PITCH_UTIL_TEST_FRAME_COUNT,
+		       AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+  /* latency is compensated - signal right after the first hop */
+  offset = AGS_PITCH_UTIL_DEFAULT_FRAME_SIZE / AGS_PITCH_UTIL_DEFAULT_OVERSAMPLING;
+  count = AGS_PITCH_UTIL_DEFAULT_FRAME_SIZE / 2;
+
+  rms = 0.0;
+
+  for(i = 0; i < count; i++){
+    rms += buffer[offset + i] * buffer[offset + i];
+  }
+
+  rms = sqrt(rms / (gdouble) count);
+
+  CU_ASSERT(rms > AGS_PITCH_UTIL_TEST_VOLUME / 4.0);
+
+  /* duration is kept - resampling an octave up would be silent after the first half */
+  offset = AGS_PITCH_UTIL_TEST_FRAME_COUNT - 3 * AGS_PITCH_UTIL_DEFAULT_FRAME_SIZE;
+
+  rms = 0.0;
+
+  for(i = 0; i < count; i++){
+    rms += buffer[offset + i] * buffer[offset + i];
+  }
+
+  rms = sqrt(rms / (gdouble) count);
+
+  CU_ASSERT(fabs(rms - AGS_PITCH_UTIL_TEST_VOLUME / M_SQRT2) < 0.05);
+
+  ags_stream_free(buffer);
+
+  ags_pitch_util_free(pitch_util);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsPitchUtilTest", ags_pitch_util_test_init_suite, ags_pitch_util_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of ags_pitch_util.c resample", ags_pitch_util_test_resample) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_pitch_util.c resample streaming", ags_pitch_util_test_resample_streaming) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_pitch_util.c phase vocoder", ags_pitch_util_test_phase_vocoder) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_pitch_util.c resample at", ags_pitch_util_test_resample_at) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_pitch_util.c resample data", ags_pitch_util_test_resample_data) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_pitch_util.c pitch", ags_pitch_util_test_pitch) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
@@ -0,0 +1,371 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <string.h>
+
+int ags_recall_pool_test_init_suite();
+int ags_recall_pool_test_clean_suite();
+
+void ags_recall_pool_test_prepare();
+void ags_recall_pool_test_take();
+void ags_recall_pool_test_refill();
+void ags_recall_pool_test_clear();
+void ags_recall_pool_test_shrink();
+void ags_recall_pool_test_max_total_instances();
+void ags_recall_pool_test_apply_properties();
+
+#define AGS_RECALL_POOL_TEST_PREPARE_N_INSTANCES (4)
+#define AGS_RECALL_POOL_TEST_SHRINK_N_INSTANCES (16)
+#define AGS_RECALL_POOL_TEST_MAX_TOTAL_INSTANCES (6)
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_recall_pool_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_recall_pool_test_clean_suite()
+{
+  return(0);
+}
+
+void
+ags_recall_pool_test_prepare()
+{
+  AgsRecallPool *recall_pool;
+  AgsRecallPoolRecipe *recipe;
+
+  recall_pool = ags_recall_pool_new();
+
+  ags_recall_pool_prepare(recall_pool,
+			  AGS_TYPE_RECALL,
+			  AGS_RECALL_POOL_TEST_PREPARE_N_INSTANCES);
+
+  recipe = ags_recall_pool_find_recipe(recall_pool,
+				       AGS_TYPE_RECALL);
+
+  CU_ASSERT(recipe != NULL);
+  CU_ASSERT(recipe->target == AGS_RECALL_POOL_TEST_PREPARE_N_INSTANCES);
+  CU_ASSERT(recipe->n_instances == AGS_RECALL_POOL_TEST_PREPARE_N_INSTANCES);
+
+  g_object_unref(recall_pool);
+}
+
+void
+ags_recall_pool_test_take()
+{
+  AgsRecallPool *recall_pool;
+  AgsRecallPoolRecipe *recipe;
+
+  GObject *gobject;
+
+  recall_pool = ags_recall_pool_new();
+
+  /* miss */
+  gobject = ags_recall_pool_take(recall_pool,
+				 AGS_TYPE_RECALL);
+
+  CU_ASSERT(gobject == NULL);
+
+  recipe = ags_recall_pool_find_recipe(recall_pool,
+				       AGS_TYPE_RECALL);
+
+  CU_ASSERT(recipe != NULL);
+  CU_ASSERT(recipe->miss == 1);
+  CU_ASSERT(recipe->demand == 1);
+
+  /* hit */
+  ags_recall_pool_prepare(recall_pool,
+			  AGS_TYPE_RECALL,
+			  1);
+
+  gobject = ags_recall_pool_take(recall_pool,
+				 AGS_TYPE_RECALL);
+
+  CU_ASSERT(AGS_IS_RECALL(gobject));
+  CU_ASSERT(recipe->hit == 1);
+  CU_ASSERT(recipe->n_instances == 0);
+
+  g_object_unref(gobject);
+
+  g_object_unref(recall_pool);
+}
+
+void
+ags_recall_pool_test_refill()
+{
+  AgsRecallPool *recall_pool;
+  AgsRecallPoolRecipe *recipe;
+
+  GObject *gobject;
+
+  guint i;
+
+  recall_pool = ags_recall_pool_new();
+
+  /* the pool learns the demand of a start */
+  for(i = 0; i < 3; i++){
+    gobject = ags_recall_pool_take(recall_pool,
+				   AGS_TYPE_RECALL_CHANNEL);
+
+    CU_ASSERT(gobject == NULL);
+  }
+
+  ags_recall_pool_refill(recall_pool);
+
+  recipe = ags_recall_pool_find_recipe(recall_pool,
+				       AGS_TYPE_RECALL_CHANNEL);
+
+  CU_ASSERT(recipe->target == 3);
+  CU_ASSERT(recipe->demand == 0);
+  CU_ASSERT(recipe->n_instances == 3);
+
+  for(i = 0; i < 3; i++){
+    gobject = ags_recall_pool_take(recall_pool,
+				   AGS_TYPE_RECALL_CHANNEL);
+
+    CU_ASSERT(AGS_IS_RECALL_CHANNEL(gobject));
+
+    g_object_unref(gobject);
+  }
+
+  CU_ASSERT(recipe->hit == 3);
+
+  g_object_unref(recall_pool);
+}
+
+void
+ags_recall_pool_test_clear()
+{
+  AgsRecallPool *recall_pool;
+  AgsRecallPoolRecipe *recipe;
+
+  recall_pool = ags_recall_pool_new();
+
+  ags_recall_pool_prepare(recall_pool,
+			  AGS_TYPE_RECALL,
+			  AGS_RECALL_POOL_TEST_PREPARE_N_INSTANCES);
+
+  ags_recall_pool_clear(recall_pool);
+
+  recipe = ags_recall_pool_find_recipe(recall_pool,
+				       AGS_TYPE_RECALL);
+
+  CU_ASSERT(recipe->n_instances == 0);
+  CU_ASSERT(recipe->target == AGS_RECALL_POOL_TEST_PREPARE_N_INSTANCES);
+
+  ags_recall_pool_refill(recall_pool);
+
+  CU_ASSERT(recipe->n_instances == AGS_RECALL_POOL_TEST_PREPARE_N_INSTANCES);
+
+  g_object_unref(recall_pool);
+}
+
+void
+ags_recall_pool_test_shrink()
+{
+  AgsRecallPool *recall_pool;
+  AgsRecallPoolRecipe *recipe;
+
+  GObject *gobject;
+
+  guint i;
+
+  recall_pool = ags_recall_pool_new();
+
+  ags_recall_pool_prepare(recall_pool,
+			  AGS_TYPE_RECALL,
+			  AGS_RECALL_POOL_TEST_SHRINK_N_INSTANCES);
+
+  recipe = ags_recall_pool_find_recipe(recall_pool,
+				       AGS_TYPE_RECALL);
+
+  CU_ASSERT(recipe->target == AGS_RECALL_POOL_TEST_SHRINK_N_INSTANCES);
+
+  /* lower demand shrinks by half of the difference */
+  gobject = ags_recall_pool_take(recall_pool,
+				 AGS_TYPE_RECALL);
+  g_object_unref(gobject);
+
+  ags_recall_pool_refill(recall_pool);
+
+  CU_ASSERT(recipe->target == 1 + ((AGS_RECALL_POOL_TEST_SHRINK_N_INSTANCES - 1) / 2));
+  CU_ASSERT(recipe->n_instances == recipe->target);
+  CU_ASSERT(recall_pool->n_total_instances == recipe->target);
+
+  /* no demand halves the target after idle refills */
+  for(i = 0; i < AGS_RECALL_POOL_DEFAULT_IDLE_REFILLS; i++){
+    ags_recall_pool_refill(recall_pool);
+  }
+
+  CU_ASSERT(recipe->target == (1 + ((AGS_RECALL_POOL_TEST_SHRINK_N_INSTANCES - 1) / 2)) / 2);
+  CU_ASSERT(recipe->n_instances == recipe->target);
+
+  g_object_unref(recall_pool);
+}
+
+void
+ags_recall_pool_test_max_total_instances()
+{
+  AgsRecallPool *recall_pool;
+  AgsRecallPoolRecipe *recipe, *other_recipe;
+
+  recall_pool = ags_recall_pool_new();
+  recall_pool->max_total_instances = AGS_RECALL_POOL_TEST_MAX_TOTAL_INSTANCES;
+
+  ags_recall_pool_prepare(recall_pool,
+			  AGS_TYPE_RECALL,
+			  AGS_RECALL_POOL_TEST_PREPARE_N_INSTANCES);
+  ags_recall_pool_prepare(recall_pool,
+			  AGS_TYPE_RECALL_CHANNEL,
+			  AGS_RECALL_POOL_TEST_PREPARE_N_INSTANCES);
+
+  recipe = ags_recall_pool_find_recipe(recall_pool,
+				       AGS_TYPE_RECALL);
+  other_recipe = ags_recall_pool_find_recipe(recall_pool,
+					     AGS_TYPE_RECALL_CHANNEL);
+
+  CU_ASSERT(recall_pool->n_total_instances == AGS_RECALL_POOL_TEST_MAX_TOTAL_INSTANCES);
+  CU_ASSERT(recipe->n_instances + other_recipe->n_instances == AGS_RECALL_POOL_TEST_MAX_TOTAL_INSTANCES);
+
+  g_object_unref(recall_pool);
+}
+
+void
+ags_recall_pool_test_apply_properties()
+{
+  AgsRecallPool *recall_pool;
+  AgsRecallPoolRecipe *recipe;
+  AgsRecall *recall;
+
+  gchar *parameter_name[3];
+  GValue value[2];
+
+  recall_pool = ags_recall_pool_new();
+
+  ags_recall_pool_prepare(recall_pool,
+			  AGS_TYPE_RECALL,
+			  1);
+
+  recall = (AgsRecall *) ags_recall_pool_take(recall_pool,
+					      AGS_TYPE_RECALL);
+
+  CU_ASSERT(AGS_IS_RECALL(recall));
+
+  parameter_name[0] = "recall-container";
+  memset(&(value[0]), 0, sizeof(GValue));
+  g_value_init(&(value[0]),
+	       G_TYPE_OBJECT);
+  g_value_set_object(&(value[0]), NULL);
+
+  parameter_name[1] = "output-soundcard-channel";
+  memset(&(value[1]), 0, sizeof(GValue));
+  g_value_init(&(value[1]),
+	       G_TYPE_INT);
+  g_value_set_int(&(value[1]), 3);
+
+  parameter_name[2] = NULL;
+
+  ags_recall_pool_apply_properties(recall_pool,
+				   (GObject *) recall,
+				   2, parameter_name, value);
+
+  recipe = ags_recall_pool_find_recipe(recall_pool,
+				       AGS_TYPE_RECALL);
+
+  /* fresh values are learned once */
+  CU_ASSERT(g_hash_table_size(recipe->fresh_value) == 2);
+  CU_ASSERT(recall->recall_container == NULL);
+  CU_ASSERT(recall->output_soundcard_channel == 3);
+
+  /* clear forgets the fresh values */
+  ags_recall_pool_clear(recall_pool);
+
+  CU_ASSERT(g_hash_table_size(recipe->fresh_value) == 0);
+
+  g_value_unset(&(value[0]));
+  g_value_unset(&(value[1]));
+
+  g_object_unref(recall);
+
+  g_object_unref(recall_pool);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsRecallPoolTest", ags_recall_pool_test_init_suite, ags_recall_pool_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsRecallPool prepare", ags_recall_pool_test_prepare) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsRecallPool take", ags_recall_pool_test_take) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsRecallPool refill", ags_recall_pool_test_refill) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsRecallPool clear", ags_recall_pool_test_clear) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsRecallPool shrink", ags_recall_pool_test_shrink) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsRecallPool max total instances", ags_recall_pool_test_max_total_instances) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsRecallPool apply properties", ags_recall_pool_test_apply_properties) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
@@ -63,6 +63,7 @@ void ags_recall_test_add_handler();
 void ags_recall_test_remove_handler();
 void ags_recall_test_lock_port();
 void ags_recall_test_unlock_port();
+void ags_recall_test_degraded_bypass();
 
 void ags_recall_test_callback(AgsRecall *recall,
 			      gpointer data);
@@ -875,6 +876,53 @@ ags_recall_test_unlock_port()
   //TODO:JK: implement me
 }
 
+void
+ags_recall_test_degraded_bypass()
+{
+  AgsRecall *recall, *non_essential_recall;
+
+  guint data;
+
+  recall = ags_recall_new();
+  g_signal_connect(G_OBJECT(recall), "run-inter",
+		   G_CALLBACK(ags_recall_test_callback), &data);
+
+  non_essential_recall = ags_recall_new();
+  ags_recall_set_flags(non_essential_recall,
+		       AGS_RECALL_NON_ESSENTIAL);
+  g_signal_connect(G_OBJECT(non_essential_recall), "run-inter",
+		   G_CALLBACK(ags_recall_test_callback), &data);
+
+  /* not degraded */
+  ags_recall_global_set_degraded(FALSE);
+
+  CU_ASSERT(ags_recall_global_get_degraded() == FALSE);
+  
+  data = 0;
+  ags_recall_run_inter(recall);
+  ags_recall_run_inter(non_essential_recall);
+
+  CU_ASSERT(data == 2);
+
+  /* degraded */
+  ags_recall_unset_staging_flags(recall,
+				 AGS_SOUND_STAGING_RUN_INTER);
+  ags_recall_unset_staging_flags(non_essential_recall,
+				 AGS_SOUND_STAGING_RUN_INTER);
+
+  ags_recall_global_set_degraded(TRUE);
+
+  CU_ASSERT(ags_recall_global_get_degraded() == TRUE);
+  
+  data = 0;
+  ags_recall_run_inter(recall);
+  ags_recall_run_inter(non_essential_recall);
+
+  CU_ASSERT(data == 1);
+
+  ags_recall_global_set_degraded(FALSE);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -929,7 +977,8 @@ main(int argc, char **argv)
      (CU_add_test(pSuite, "test of AgsRecall add handler", ags_recall_test_add_handler) == NULL) ||
      (CU_add_test(pSuite, "test of AgsRecall remove handler", ags_recall_test_remove_handler) == NULL) ||
      (CU_add_test(pSuite, "test of AgsRecall lock port", ags_recall_test_lock_port) == NULL) ||
-     (CU_add_test(pSuite, "test of AgsRecall unlock port", ags_recall_test_unlock_port) == NULL)){
+     (CU_add_test(pSuite, "test of AgsRecall unlock port", ags_recall_test_unlock_port) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsRecall degraded bypass", ags_recall_test_degraded_bypass) == NULL)){
     CU_cleanup_registry();
     
     return CU_get_error();
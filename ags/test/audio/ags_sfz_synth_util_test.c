@@ -149,6 +149,9 @@ ags_sfz_synth_util_test_copy_s8()
 
   sfz_sample->info->frames = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
 
+  sfz_sample->full_buffer_frame_count = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
+  sfz_sample->full_buffer_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+
   AGS_SOUND_RESOURCE_GET_INTERFACE(sfz_sample)->read = ags_sfz_synth_util_test_stub_read;
   
   buffer = ags_stream_alloc(AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT,
@@ -219,6 +222,9 @@ ags_sfz_synth_util_test_copy_s16()
 
   sfz_sample->info->frames = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
 
+  sfz_sample->full_buffer_frame_count = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
+  sfz_sample->full_buffer_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+
   AGS_SOUND_RESOURCE_GET_INTERFACE(sfz_sample)->read = ags_sfz_synth_util_test_stub_read;
   
   buffer = ags_stream_alloc(AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT,
@@ -289,6 +295,9 @@ ags_sfz_synth_util_test_copy_s24()
 
   sfz_sample->info->frames = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
 
+  sfz_sample->full_buffer_frame_count = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
+  sfz_sample->full_buffer_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+
   AGS_SOUND_RESOURCE_GET_INTERFACE(sfz_sample)->read = ags_sfz_synth_util_test_stub_read;
   
   buffer = ags_stream_alloc(AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT,
@@ -359,6 +368,9 @@ ags_sfz_synth_util_test_copy_s32()
 
   sfz_sample->info->frames = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
 
+  sfz_sample->full_buffer_frame_count = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
+  sfz_sample->full_buffer_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+
   AGS_SOUND_RESOURCE_GET_INTERFACE(sfz_sample)->read = ags_sfz_synth_util_test_stub_read;
   
   buffer = ags_stream_alloc(AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT,
@@ -429,6 +441,9 @@ ags_sfz_synth_util_test_copy_s64()
 
   sfz_sample->info->frames = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
 
+  sfz_sample->full_buffer_frame_count = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
+  sfz_sample->full_buffer_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+
   AGS_SOUND_RESOURCE_GET_INTERFACE(sfz_sample)->read = ags_sfz_synth_util_test_stub_read;
   
   buffer = ags_stream_alloc(AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT,
@@ -499,6 +514,9 @@ ags_sfz_synth_util_test_copy_float()
 
   sfz_sample->info->frames = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
 
+  sfz_sample->full_buffer_frame_count = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
+  sfz_sample->full_buffer_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+
   AGS_SOUND_RESOURCE_GET_INTERFACE(sfz_sample)->read = ags_sfz_synth_util_test_stub_read;
   
   buffer = ags_stream_alloc(AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT,
@@ -569,6 +587,9 @@ ags_sfz_synth_util_test_copy_double()
 
   sfz_sample->info->frames = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
 
+  sfz_sample->full_buffer_frame_count = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
+  sfz_sample->full_buffer_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+
   AGS_SOUND_RESOURCE_GET_INTERFACE(sfz_sample)->read = ags_sfz_synth_util_test_stub_read;
   
   buffer = ags_stream_alloc(AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT,
@@ -639,6 +660,9 @@ ags_sfz_synth_util_test_copy_complex()
 
   sfz_sample->info->frames = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
 
+  sfz_sample->full_buffer_frame_count = AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT;
+  sfz_sample->full_buffer_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+
   AGS_SOUND_RESOURCE_GET_INTERFACE(sfz_sample)->read = ags_sfz_synth_util_test_stub_read;
   
   buffer = ags_stream_alloc(AGS_SFZ_SYNTH_UTIL_TEST_FRAME_COUNT,
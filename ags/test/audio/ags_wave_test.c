@@ -28,6 +28,7 @@
 #include <ags/libags-audio.h>
 
 #include <stdlib.h>
+#include <string.h>
 
 int ags_wave_test_init_suite();
 int ags_wave_test_clean_suite();
@@ -47,6 +48,9 @@ void ags_wave_test_copy_selection();
 void ags_wave_test_cut_selection();
 void ags_wave_test_insert_from_clipboard();
 void ags_wave_test_insert_from_clipboard_extended();
+void ags_wave_test_read_range();
+void ags_wave_test_cursor_read();
+void ags_wave_test_peak();
 
 #define AGS_WAVE_TEST_FIND_NEAR_TIMESTAMP_N_WAVE (8)
 #define AGS_WAVE_TEST_FIND_NEAR_TIMESTAMP_SAMPLERATE (44100)
@@ -78,6 +82,16 @@ void ags_wave_test_insert_from_clipboard_extended();
 #define AGS_WAVE_TEST_ADD_ALL_TO_SELECTION_BUFFER_SIZE (1024)
 #define AGS_WAVE_TEST_ADD_ALL_TO_SELECTION_COUNT (1024)
 
+#define AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE (1024)
+#define AGS_WAVE_TEST_READ_RANGE_COUNT (16)
+
+#define AGS_WAVE_TEST_CURSOR_READ_BUFFER_SIZE (1024)
+#define AGS_WAVE_TEST_CURSOR_READ_COUNT (16)
+#define AGS_WAVE_TEST_CURSOR_READ_FRAME_COUNT (512)
+
+#define AGS_WAVE_TEST_PEAK_BUFFER_SIZE (256)
+#define AGS_WAVE_TEST_PEAK_COUNT (5)
+
 AgsAudio *audio;
 
 /* The suite initialization function.
@@ -172,6 +186,8 @@ ags_wave_test_add_buffer()
   g_object_set(wave,
 	       "buffer-size", AGS_WAVE_TEST_ADD_BUFFER_BUFFER_SIZE,
 	       NULL);
+
+  CU_ASSERT(!ags_wave_test_flags(wave, AGS_WAVE_MODIFIED));
   
   for(i = 0; i < AGS_WAVE_TEST_ADD_BUFFER_COUNT; i++){
     x = i * AGS_WAVE_TEST_ADD_BUFFER_BUFFER_SIZE;
@@ -205,6 +221,8 @@ ags_wave_test_add_buffer()
 
   CU_ASSERT(success == TRUE);
   CU_ASSERT(list == NULL);
+
+  CU_ASSERT(ags_wave_test_flags(wave, AGS_WAVE_MODIFIED));
 }
 
 void
@@ -618,6 +636,278 @@ ags_wave_test_insert_from_clipboard_extended()
   //TODO:JK: implement me
 }
 
+void
+ags_wave_test_read_range()
+{
+  AgsWave *wave;
+  AgsBuffer *buffer;
+
+  gint16 *destination;
+  
+  guint64 x;
+  guint n_read;
+  guint i, j;
+  gboolean success;
+  
+  /* create wave */
+  wave = ags_wave_new(audio,
+		      0);
+  g_object_set(wave,
+	       "buffer-size", AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE,
+	       NULL);
+
+  /* add buffers in reverse order, each filled with its index */
+  for(i = 0; i < AGS_WAVE_TEST_READ_RANGE_COUNT; i++){
+    x = (AGS_WAVE_TEST_READ_RANGE_COUNT - i - 1) * AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE;
+    
+    buffer = ags_buffer_new();
+    g_object_set(buffer,
+		 "format", AGS_SOUNDCARD_SIGNED_16_BIT,
+		 "buffer-size", AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE,
+		 "x", x, 
+		 NULL);
+
+    for(j = 0; j < AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE; j++){
+      ((gint16 *) buffer->data)[j] = (gint16) (AGS_WAVE_TEST_READ_RANGE_COUNT - i);
+    }
+    
+    ags_wave_add_buffer(wave,
+			buffer,
+			FALSE);
+  }
+
+  /* assert contiguous span across buffer boundary */
+  destination = (gint16 *) g_malloc0(AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE * sizeof(gint16));
+  
+  n_read = ags_wave_read_range(wave,
+			       (3 * AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE) + (AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE / 2),
+			       destination, 1,
+			       AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE, AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  CU_ASSERT(n_read == AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE);
+
+  success = TRUE;
+
+  for(j = 0; j < AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE; j++){
+    if((j < AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE / 2 && destination[j] != 4) ||
+       (j >= AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE / 2 && destination[j] != 5)){
+      success = FALSE;
+
+      break;
+    }
+  }
+  
+  CU_ASSERT(success == TRUE);
+
+  /* assert partial coverage at the end */
+  n_read = ags_wave_read_range(wave,
+			       (AGS_WAVE_TEST_READ_RANGE_COUNT * AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE) - (AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE / 4),
+			       destination, 1,
+			       AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE, AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  CU_ASSERT(n_read == AGS_WAVE_TEST_READ_RANGE_BUFFER_SIZE / 4);
+
+  g_free(destination);
+  
+  g_object_unref(wave);
+}
+
+void
+ags_wave_test_cursor_read()
+{
+  AgsAudio *cursor_audio;
+  AgsWave *wave;
+  AgsBuffer *buffer;
+  AgsWaveCursor *wave_cursor;
+
+  gint16 *destination;
+  
+  guint64 x;
+  guint samplerate;
+  guint n_read;
+  guint i, j;
+  gboolean success;
+  
+  cursor_audio = ags_audio_new(NULL);
+
+  samplerate = 0;
+  
+  g_object_get(cursor_audio,
+	       "samplerate", &samplerate,
+	       NULL);
+  
+  /* create wave */
+  wave = ags_wave_new((GObject *) cursor_audio,
+		      0);
+  g_object_set(wave,
+	       "buffer-size", AGS_WAVE_TEST_CURSOR_READ_BUFFER_SIZE,
+	       NULL);
+
+  for(i = 0; i < AGS_WAVE_TEST_CURSOR_READ_COUNT; i++){
+    x = i * AGS_WAVE_TEST_CURSOR_READ_BUFFER_SIZE;
+    
+    buffer = ags_buffer_new();
+    g_object_set(buffer,
+		 "format", AGS_SOUNDCARD_SIGNED_16_BIT,
+		 "buffer-size", AGS_WAVE_TEST_CURSOR_READ_BUFFER_SIZE,
+		 "x", x, 
+		 NULL);
+
+    for(j = 0; j < AGS_WAVE_TEST_CURSOR_READ_BUFFER_SIZE; j++){
+      ((gint16 *) buffer->data)[j] = (gint16) (i + 1);
+    }
+    
+    ags_wave_add_buffer(wave,
+			buffer,
+			FALSE);
+  }
+
+  ags_audio_add_wave(cursor_audio,
+		     (GObject *) wave);
+
+  wave_cursor = ags_wave_cursor_alloc((GObject *) cursor_audio,
+				      0);
+
+  destination = (gint16 *) g_malloc(AGS_WAVE_TEST_CURSOR_READ_FRAME_COUNT * sizeof(gint16));
+
+  /* assert consecutive reads */
+  success = TRUE;
+
+  for(x = 0; x < AGS_WAVE_TEST_CURSOR_READ_COUNT * AGS_WAVE_TEST_CURSOR_READ_BUFFER_SIZE; x += AGS_WAVE_TEST_CURSOR_READ_FRAME_COUNT){
+    memset(destination, 0, AGS_WAVE_TEST_CURSOR_READ_FRAME_COUNT * sizeof(gint16));
+
+    n_read = ags_wave_cursor_read(wave_cursor,
+				  x, samplerate,
+				  destination, 1,
+				  AGS_WAVE_TEST_CURSOR_READ_FRAME_COUNT, AGS_SOUNDCARD_SIGNED_16_BIT);
+
+    if(n_read != AGS_WAVE_TEST_CURSOR_READ_FRAME_COUNT ||
+       destination[0] != (gint16) (x / AGS_WAVE_TEST_CURSOR_READ_BUFFER_SIZE + 1)){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+  CU_ASSERT(wave_cursor->position == AGS_WAVE_TEST_CURSOR_READ_COUNT - 1);
+
+  /* assert seek backwards */
+  memset(destination, 0, AGS_WAVE_TEST_CURSOR_READ_FRAME_COUNT * sizeof(gint16));
+
+  n_read = ags_wave_cursor_read(wave_cursor,
+				2 * AGS_WAVE_TEST_CURSOR_READ_BUFFER_SIZE, samplerate,
+				destination, 1,
+				AGS_WAVE_TEST_CURSOR_READ_FRAME_COUNT, AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  CU_ASSERT(n_read == AGS_WAVE_TEST_CURSOR_READ_FRAME_COUNT);
+  CU_ASSERT(destination[0] == 3);
+  CU_ASSERT(wave_cursor->position == 2);
+  
+  g_free(destination);
+
+  ags_wave_cursor_free(wave_cursor);
+  
+  g_object_unref(cursor_audio);
+}
+
+void
+ags_wave_test_peak()
+{
+  AgsWave *wave;
+  AgsBuffer *buffer, *last_buffer;
+  AgsBufferPeak *peak;
+
+  guint n_peaks;
+  guint buffers_per_peak;
+  guint i;
+
+  wave = ags_wave_new(NULL,
+		      0);
+  g_object_set(wave,
+	       "buffer-size", AGS_WAVE_TEST_PEAK_BUFFER_SIZE,
+	       NULL);
+
+  last_buffer = NULL;
+  
+  for(i = 0; i < AGS_WAVE_TEST_PEAK_COUNT; i++){
+    buffer = ags_buffer_new();
+    g_object_set(buffer,
+		 "format", AGS_SOUNDCARD_SIGNED_16_BIT,
+		 "buffer-size", AGS_WAVE_TEST_PEAK_BUFFER_SIZE,
+		 "x", (guint64) (i * AGS_WAVE_TEST_PEAK_BUFFER_SIZE),
+		 NULL);
+
+    ((gint16 *) buffer->data)[0] = (gint16) (4096 * (i + 1));
+    
+    ags_wave_add_buffer(wave,
+			buffer,
+			FALSE);
+
+    last_buffer = buffer;
+  }
+
+  /* assert a peak per buffer */
+  CU_ASSERT(ags_wave_find_peak_level(wave, (gdouble) AGS_WAVE_TEST_PEAK_BUFFER_SIZE) == 0);
+  
+  peak = ags_wave_get_peak(wave,
+			   0,
+			   &n_peaks,
+			   &buffers_per_peak);
+
+  CU_ASSERT(peak != NULL);
+  CU_ASSERT(n_peaks == AGS_WAVE_TEST_PEAK_COUNT);
+  CU_ASSERT(buffers_per_peak == 1);
+  CU_ASSERT(peak[0].max == 0.125);
+  CU_ASSERT(peak[4].max == 0.625);
+
+  /* assert the top level covers all buffers */
+  CU_ASSERT(ags_wave_find_peak_level(wave, 1000000.0) == 3);
+  
+  peak = ags_wave_get_peak(wave,
+			   3,
+			   &n_peaks,
+			   &buffers_per_peak);
+
+  CU_ASSERT(n_peaks == 1);
+  CU_ASSERT(buffers_per_peak == 8);
+  CU_ASSERT(peak[0].min == 0.0 && peak[0].max == 0.625);
+
+  /* assert update of a modified buffer */
+  ((gint16 *) last_buffer->data)[0] = 0;
+
+  ags_buffer_invalidate_peak(last_buffer,
+			     0, 1);
+
+  peak = ags_wave_get_peak(wave,
+			   3,
+			   &n_peaks,
+			   &buffers_per_peak);
+
+  CU_ASSERT(peak[0].max == 0.5);
+
+  /* assert rebuild after remove */
+  ags_wave_remove_buffer(wave,
+			 last_buffer,
+			 FALSE);
+
+  peak = ags_wave_get_peak(wave,
+			   G_MAXUINT,
+			   &n_peaks,
+			   &buffers_per_peak);
+
+  CU_ASSERT(n_peaks == 1);
+  CU_ASSERT(buffers_per_peak == 4);
+  CU_ASSERT(peak[0].max == 0.5);
+
+  /* assert the first buffer ending after x */
+  CU_ASSERT(ags_wave_find_buffer_index(wave, 0) == 0);
+  CU_ASSERT(ags_wave_find_buffer_index(wave, AGS_WAVE_TEST_PEAK_BUFFER_SIZE) == 1);
+  CU_ASSERT(ags_wave_find_buffer_index(wave, 4 * AGS_WAVE_TEST_PEAK_BUFFER_SIZE) == 4);
+
+  g_object_unref(wave);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -655,7 +945,10 @@ main(int argc, char **argv)
      (CU_add_test(pSuite, "test of AgsWave copy selection", ags_wave_test_copy_selection) == NULL) ||
      (CU_add_test(pSuite, "test of AgsWave cut selection", ags_wave_test_cut_selection) == NULL) ||
      (CU_add_test(pSuite, "test of AgsWave insert from clipboard", ags_wave_test_insert_from_clipboard) == NULL) ||
-     (CU_add_test(pSuite, "test of AgsWave insert from clipboard extended", ags_wave_test_insert_from_clipboard_extended) == NULL)){
+     (CU_add_test(pSuite, "test of AgsWave insert from clipboard extended", ags_wave_test_insert_from_clipboard_extended) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsWave read range", ags_wave_test_read_range) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsWave cursor read", ags_wave_test_cursor_read) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsWave peak", ags_wave_test_peak) == NULL)){
     CU_cleanup_registry();
     
     return CU_get_error();
@@ -0,0 +1,435 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <glib/gstdio.h>
+
+#include <sndfile.h>
+
+#include <unistd.h>
+#include <string.h>
+
+int ags_sfz_sample_test_init_suite();
+int ags_sfz_sample_test_clean_suite();
+
+gint16* ags_sfz_sample_test_expected(guint audio_channel);
+
+void ags_sfz_sample_test_open();
+void ags_sfz_sample_test_get_data();
+void ags_sfz_sample_test_get_data_24_bit();
+void ags_sfz_sample_test_read();
+
+#define AGS_SFZ_SAMPLE_TEST_AUDIO_CHANNELS (2)
+#define AGS_SFZ_SAMPLE_TEST_SAMPLERATE (44100)
+#define AGS_SFZ_SAMPLE_TEST_FRAME_COUNT (8192)
+#define AGS_SFZ_SAMPLE_TEST_READ_OFFSET (1000)
+#define AGS_SFZ_SAMPLE_TEST_READ_COUNT (512)
+
+gchar *filename = NULL;
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_sfz_sample_test_init_suite()
+{
+  AgsSndfile *sndfile;
+
+  gint16 *buffer;
+
+  gint fd;
+  guint buffer_size;
+  guint i, j;
+
+  fd = g_file_open_tmp("ags_sfz_sample_test-XXXXXX.wav",
+		       &filename,
+		       NULL);
+
+  if(fd == -1){
+    return(-1);
+  }
+
+  close(fd);
+
+  /* stereo ramp, falling on the second channel */
+  sndfile = ags_sndfile_new();
+
+  if(!ags_sound_resource_rw_open(AGS_SOUND_RESOURCE(sndfile),
+				 filename,
+				 AGS_SFZ_SAMPLE_TEST_AUDIO_CHANNELS, AGS_SFZ_SAMPLE_TEST_SAMPLERATE,
+				 TRUE)){
+    return(-1);
+  }
+
+  /* write as much as the sound resource buffers */
+  buffer_size = AGS_SFZ_SAMPLE_TEST_READ_COUNT;
+
+  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sndfile),
+				 NULL,
+				 NULL,
+				 &buffer_size,
+				 NULL);
+
+  buffer = (gint16 *) ags_stream_alloc(AGS_SFZ_SAMPLE_TEST_AUDIO_CHANNELS * buffer_size,
+				       AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  for(i = 0; i < AGS_SFZ_SAMPLE_TEST_FRAME_COUNT; i += buffer_size){
+    for(j = 0; j < buffer_size; j++){
+      buffer[AGS_SFZ_SAMPLE_TEST_AUDIO_CHANNELS * j] = (gint16) ((i + j) % 4096);
+      buffer[AGS_SFZ_SAMPLE_TEST_AUDIO_CHANNELS * j + 1] = (gint16) (-1 * (gint) ((i + j) % 4096));
+    }
+
+    for(j = 0; j < AGS_SFZ_SAMPLE_TEST_AUDIO_CHANNELS; j++){
+      ags_sound_resource_write(AGS_SOUND_RESOURCE(sndfile),
+			       buffer, AGS_SFZ_SAMPLE_TEST_AUDIO_CHANNELS,
+			       j,
+			       buffer_size, AGS_SOUNDCARD_SIGNED_16_BIT);
+    }
+  }
+
+  ags_sound_resource_flush(AGS_SOUND_RESOURCE(sndfile));
+  ags_sound_resource_close(AGS_SOUND_RESOURCE(sndfile));
+
+  ags_stream_free(buffer);
+
+  g_object_unref(sndfile);
+
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_sfz_sample_test_clean_suite()
+{
+  if(filename != NULL){
+    g_unlink(filename);
+
+    g_free(filename);
+  }
+
+  return(0);
+}
+
+gint16*
+ags_sfz_sample_test_expected(guint audio_channel)
+{
+  AgsSndfile *sndfile;
+
+  gint16 *expected;
+
+  expected = (gint16 *) ags_stream_alloc(AGS_SFZ_SAMPLE_TEST_FRAME_COUNT,
+					 AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  /* read the channel directly */
+  sndfile = ags_sndfile_new();
+  ags_sound_resource_open(AGS_SOUND_RESOURCE(sndfile),
+			  filename);
+
+  ags_sound_resource_read(AGS_SOUND_RESOURCE(sndfile),
+			  expected, 1,
+			  audio_channel,
+			  AGS_SFZ_SAMPLE_TEST_FRAME_COUNT, AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  ags_sound_resource_close(AGS_SOUND_RESOURCE(sndfile));
+  g_object_unref(sndfile);
+
+  return(expected);
+}
+
+void
+ags_sfz_sample_test_open()
+{
+  AgsSFZSample *sfz_sample;
+
+  sfz_sample = ags_sfz_sample_new();
+
+  CU_ASSERT(ags_sound_resource_open(AGS_SOUND_RESOURCE(sfz_sample),
+				    filename) == TRUE);
+
+  /* decoded by the first get data, not at load */
+  CU_ASSERT(sfz_sample->full_buffer == NULL);
+  CU_ASSERT(sfz_sample->audio_channels == AGS_SFZ_SAMPLE_TEST_AUDIO_CHANNELS);
+
+  ags_sound_resource_close(AGS_SOUND_RESOURCE(sfz_sample));
+
+  g_object_unref(sfz_sample);
+}
+
+void
+ags_sfz_sample_test_get_data()
+{
+  AgsSFZSample *sfz_sample;
+
+  void *data;
+  gint16 *buffer, *expected;
+
+  guint audio_channels;
+  guint frame_count;
+  guint format;
+  guint copy_mode;
+
+  sfz_sample = ags_sfz_sample_new();
+
+  ags_sound_resource_open(AGS_SOUND_RESOURCE(sfz_sample),
+			  filename);
+
+  data = NULL;
+
+  audio_channels = 0;
+  frame_count = 0;
+  format = 0;
+
+  CU_ASSERT(ags_sfz_sample_get_data(sfz_sample,
+				    &data,
+				    &audio_channels,
+				    &frame_count,
+				    &format) == TRUE);
+  CU_ASSERT(data != NULL);
+  CU_ASSERT(data == sfz_sample->full_buffer);
+  CU_ASSERT(audio_channels == AGS_SFZ_SAMPLE_TEST_AUDIO_CHANNELS);
+  CU_ASSERT(frame_count == AGS_SFZ_SAMPLE_TEST_FRAME_COUNT);
+  CU_ASSERT(format == AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  /* the view is interleaved as the file */
+  buffer = (gint16 *) ags_stream_alloc(AGS_SFZ_SAMPLE_TEST_FRAME_COUNT,
+				       AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S16,
+						  ags_audio_buffer_util_format_from_soundcard(format));
+
+  ags_audio_buffer_util_copy_buffer_to_buffer(buffer, 1, 0,
+					      data, audio_channels, 1,
+					      AGS_SFZ_SAMPLE_TEST_FRAME_COUNT, copy_mode);
+
+  expected = ags_sfz_sample_test_expected(1);
+
+  CU_ASSERT(!memcmp(buffer, expected, AGS_SFZ_SAMPLE_TEST_FRAME_COUNT * sizeof(gint16)));
+
+  /* no view if the audio channels don't match the file */
+  g_object_set(sfz_sample,
+	       "audio-channels", 1,
+	       NULL);
+
+  CU_ASSERT(ags_sfz_sample_get_data(sfz_sample,
+				    &data,
+				    &audio_channels,
+				    &frame_count,
+				    &format) == FALSE);
+
+  g_object_set(sfz_sample,
+	       "audio-channels", AGS_SFZ_SAMPLE_TEST_AUDIO_CHANNELS,
+	       NULL);
+
+  CU_ASSERT(ags_sfz_sample_get_data(sfz_sample,
+				    NULL,
+				    NULL,
+				    NULL,
+				    NULL) == TRUE);
+
+  ags_stream_free(buffer);
+  ags_stream_free(expected);
+
+  ags_sound_resource_close(AGS_SOUND_RESOURCE(sfz_sample));
+
+  g_object_unref(sfz_sample);
+}
+
+void
+ags_sfz_sample_test_get_data_24_bit()
+{
+  AgsSFZSample *sfz_sample;
+
+  SNDFILE *file;
+  SF_INFO info;
+
+  void *data;
+  gint32 *buffer;
+  gchar *filename_24_bit;
+
+  gint fd;
+  guint audio_channels;
+  guint frame_count;
+  guint format;
+  guint i;
+  gboolean success;
+  
+  fd = g_file_open_tmp("ags_sfz_sample_test-24-bit-XXXXXX.wav",
+		       &filename_24_bit,
+		       NULL);
+
+  CU_ASSERT(fd != -1);
+  
+  close(fd);
+
+  /* mono ramp, left aligned as libsndfile expects for 32 bit int */
+  memset(&info, 0, sizeof(SF_INFO));
+  
+  info.channels = 1;
+  info.samplerate = AGS_SFZ_SAMPLE_TEST_SAMPLERATE;
+  info.format = SF_FORMAT_WAV | SF_FORMAT_PCM_24;
+
+  file = sf_open(filename_24_bit, SFM_WRITE, &info);
+
+  CU_ASSERT(file != NULL);
+  
+  buffer = (gint32 *) g_malloc(AGS_SFZ_SAMPLE_TEST_FRAME_COUNT * sizeof(gint32));
+
+  for(i = 0; i < AGS_SFZ_SAMPLE_TEST_FRAME_COUNT; i++){
+    buffer[i] = (gint32) (((i * 997) % 0x7fffff) - 0x400000) * 256;
+  }
+
+  sf_writef_int(file, buffer, AGS_SFZ_SAMPLE_TEST_FRAME_COUNT);
+  sf_close(file);
+
+  /* the native width is kept */
+  sfz_sample = ags_sfz_sample_new();
+
+  ags_sound_resource_open(AGS_SOUND_RESOURCE(sfz_sample),
+			  filename_24_bit);
+
+  CU_ASSERT(sfz_sample->full_buffer == NULL);
+  
+  data = NULL;
+
+  audio_channels = 0;
+  frame_count = 0;
+  format = 0;
+
+  CU_ASSERT(ags_sfz_sample_get_data(sfz_sample,
+				    &data,
+				    &audio_channels,
+				    &frame_count,
+				    &format) == TRUE);
+  CU_ASSERT(audio_channels == 1);
+  CU_ASSERT(frame_count == AGS_SFZ_SAMPLE_TEST_FRAME_COUNT);
+  CU_ASSERT(format == AGS_SOUNDCARD_SIGNED_24_BIT);
+
+  success = (data != NULL) ? TRUE: FALSE;
+  
+  for(i = 0; data != NULL && i < AGS_SFZ_SAMPLE_TEST_FRAME_COUNT; i++){
+    if(((gint32 *) data)[i] != buffer[i] / 256){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  g_free(buffer);
+  
+  ags_sound_resource_close(AGS_SOUND_RESOURCE(sfz_sample));
+
+  g_object_unref(sfz_sample);
+
+  g_unlink(filename_24_bit);
+
+  g_free(filename_24_bit);
+}
+
+void
+ags_sfz_sample_test_read()
+{
+  AgsSFZSample *sfz_sample;
+
+  gint16 *buffer, *expected;
+
+  sfz_sample = ags_sfz_sample_new();
+
+  ags_sound_resource_open(AGS_SOUND_RESOURCE(sfz_sample),
+			  filename);
+
+  buffer = (gint16 *) ags_stream_alloc(AGS_SFZ_SAMPLE_TEST_READ_COUNT,
+				       AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  expected = ags_sfz_sample_test_expected(1);
+
+  /* served from the decoded data */
+  ags_sound_resource_seek(AGS_SOUND_RESOURCE(sfz_sample),
+			  AGS_SFZ_SAMPLE_TEST_READ_OFFSET, G_SEEK_SET);
+
+  CU_ASSERT(ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
+				    buffer, 1,
+				    1,
+				    AGS_SFZ_SAMPLE_TEST_READ_COUNT, AGS_SOUNDCARD_SIGNED_16_BIT) == AGS_SFZ_SAMPLE_TEST_READ_COUNT);
+
+  CU_ASSERT(!memcmp(buffer, expected + AGS_SFZ_SAMPLE_TEST_READ_OFFSET, AGS_SFZ_SAMPLE_TEST_READ_COUNT * sizeof(gint16)));
+  CU_ASSERT(sfz_sample->offset == AGS_SFZ_SAMPLE_TEST_READ_OFFSET + AGS_SFZ_SAMPLE_TEST_READ_COUNT);
+
+  ags_stream_free(buffer);
+  ags_stream_free(expected);
+
+  ags_sound_resource_close(AGS_SOUND_RESOURCE(sfz_sample));
+
+  g_object_unref(sfz_sample);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsSFZSampleTest", ags_sfz_sample_test_init_suite, ags_sfz_sample_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsSFZSample open", ags_sfz_sample_test_open) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsSFZSample get data", ags_sfz_sample_test_get_data) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsSFZSample get data 24 bit", ags_sfz_sample_test_get_data_24_bit) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsSFZSample read", ags_sfz_sample_test_read) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
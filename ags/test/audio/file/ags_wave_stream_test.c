@@ -0,0 +1,395 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <glib/gstdio.h>
+
+#include <unistd.h>
+#include <string.h>
+
+int ags_wave_stream_test_init_suite();
+int ags_wave_stream_test_clean_suite();
+
+AgsWaveStream* ags_wave_stream_test_open();
+gboolean ags_wave_stream_test_compare(AgsWaveStream *wave_stream,
+				      guint64 x_offset, guint frame_count);
+
+void ags_wave_stream_test_read();
+void ags_wave_stream_test_prefetch();
+void ags_wave_stream_test_evict();
+
+#define AGS_WAVE_STREAM_TEST_SAMPLERATE (44100)
+#define AGS_WAVE_STREAM_TEST_BUFFER_SIZE (256)
+#define AGS_WAVE_STREAM_TEST_BLOCK_SIZE (256)
+#define AGS_WAVE_STREAM_TEST_N_BLOCKS (64)
+
+gchar *filename = NULL;
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_wave_stream_test_init_suite()
+{
+  AgsSndfile *sndfile;
+
+  gint16 *buffer;
+
+  gint fd;
+  guint buffer_size;
+  guint i, j;
+
+  fd = g_file_open_tmp("ags_wave_stream_test-XXXXXX.wav",
+		       &filename,
+		       NULL);
+
+  if(fd == -1){
+    return(-1);
+  }
+
+  close(fd);
+  
+  /* ramp */
+  sndfile = ags_sndfile_new();
+
+  if(!ags_sound_resource_rw_open(AGS_SOUND_RESOURCE(sndfile),
+				 filename,
+				 1, AGS_WAVE_STREAM_TEST_SAMPLERATE,
+				 TRUE)){
+    return(-1);
+  }
+
+  /* write as much as the sound resource buffers */
+  buffer_size = AGS_WAVE_STREAM_TEST_BUFFER_SIZE;
+  
+  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sndfile),
+				 NULL,
+				 NULL,
+				 &buffer_size,
+				 NULL);
+  
+  buffer = (gint16 *) ags_stream_alloc(buffer_size,
+				       AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  for(i = 0; i < AGS_WAVE_STREAM_TEST_N_BLOCKS * AGS_WAVE_STREAM_TEST_BLOCK_SIZE; i += buffer_size){
+    for(j = 0; j < buffer_size; j++){
+      buffer[j] = (gint16) ((i + j) % 4096);
+    }
+
+    ags_sound_resource_write(AGS_SOUND_RESOURCE(sndfile),
+			     buffer, 1,
+			     0,
+			     buffer_size, AGS_SOUNDCARD_SIGNED_16_BIT);
+  }
+
+  ags_sound_resource_flush(AGS_SOUND_RESOURCE(sndfile));
+  ags_sound_resource_close(AGS_SOUND_RESOURCE(sndfile));
+
+  ags_stream_free(buffer);
+  
+  g_object_unref(sndfile);
+  
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_wave_stream_test_clean_suite()
+{
+  if(filename != NULL){
+    g_unlink(filename);
+
+    g_free(filename);
+  }
+  
+  return(0);
+}
+
+AgsWaveStream*
+ags_wave_stream_test_open()
+{
+  AgsSndfile *sndfile;
+  AgsWaveStream *wave_stream;
+
+  sndfile = ags_sndfile_new();
+  ags_sound_resource_open(AGS_SOUND_RESOURCE(sndfile),
+			  filename);
+
+  wave_stream = ags_wave_stream_new((GObject *) sndfile,
+				    0);
+
+  /* the ring is allocated by the first fill, so these still apply */
+  g_object_set(wave_stream,
+	       "format", AGS_SOUNDCARD_SIGNED_16_BIT,
+	       "block-size", AGS_WAVE_STREAM_TEST_BLOCK_SIZE,
+	       "memory-budget", (guint64) 0,
+	       NULL);
+
+  g_object_unref(sndfile);
+  
+  return(wave_stream);
+}
+
+gboolean
+ags_wave_stream_test_compare(AgsWaveStream *wave_stream,
+			     guint64 x_offset, guint frame_count)
+{
+  AgsSndfile *sndfile;
+
+  gint16 *buffer, *expected;
+
+  guint n_read;
+  gboolean success;
+
+  buffer = (gint16 *) ags_stream_alloc(frame_count,
+				       AGS_SOUNDCARD_SIGNED_16_BIT);
+  expected = (gint16 *) ags_stream_alloc(frame_count,
+					 AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  n_read = ags_wave_stream_read(wave_stream,
+				x_offset,
+				buffer, 1,
+				frame_count, AGS_SOUNDCARD_SIGNED_16_BIT);
+  
+  /* read the same frames directly */
+  sndfile = ags_sndfile_new();
+  ags_sound_resource_open(AGS_SOUND_RESOURCE(sndfile),
+			  filename);
+
+  ags_sound_resource_seek(AGS_SOUND_RESOURCE(sndfile),
+			  (gint64) x_offset, G_SEEK_SET);
+  ags_sound_resource_read(AGS_SOUND_RESOURCE(sndfile),
+			  expected, 1,
+			  0,
+			  frame_count, AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  ags_sound_resource_close(AGS_SOUND_RESOURCE(sndfile));
+  g_object_unref(sndfile);
+  
+  success = (n_read == frame_count &&
+	     !memcmp(buffer, expected, frame_count * sizeof(gint16))) ? TRUE: FALSE;
+
+  ags_stream_free(buffer);
+  ags_stream_free(expected);
+
+  return(success);
+}
+
+void
+ags_wave_stream_test_read()
+{
+  AgsWaveStream *wave_stream;
+
+  gint16 *buffer;
+
+  guint miss;
+  
+  wave_stream = ags_wave_stream_test_open();
+
+  CU_ASSERT(wave_stream->frame_count == AGS_WAVE_STREAM_TEST_N_BLOCKS * AGS_WAVE_STREAM_TEST_BLOCK_SIZE);
+  CU_ASSERT(wave_stream->samplerate == AGS_WAVE_STREAM_TEST_SAMPLERATE);
+
+  /* nothing decoded, read leaves silence */
+  buffer = (gint16 *) ags_stream_alloc(AGS_WAVE_STREAM_TEST_BUFFER_SIZE,
+				       AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  CU_ASSERT(ags_wave_stream_read(wave_stream,
+				 AGS_WAVE_STREAM_TEST_BLOCK_SIZE,
+				 buffer, 1,
+				 AGS_WAVE_STREAM_TEST_BUFFER_SIZE, AGS_SOUNDCARD_SIGNED_16_BIT) == 0);
+  CU_ASSERT(buffer[1] == 0);
+  
+  ags_stream_free(buffer);
+
+  /* decode and read across a block boundary */
+  ags_wave_stream_locate(wave_stream,
+			 0);
+  
+  CU_ASSERT(ags_wave_stream_fill(wave_stream) == AGS_WAVE_STREAM_DEFAULT_READ_AHEAD);
+  CU_ASSERT(wave_stream->ring_size == AGS_WAVE_STREAM_DEFAULT_READ_AHEAD + AGS_WAVE_STREAM_DEFAULT_LOOP_AHEAD);
+
+  miss = g_atomic_int_get(&(wave_stream->miss));
+  
+  CU_ASSERT(ags_wave_stream_test_compare(wave_stream,
+					 AGS_WAVE_STREAM_TEST_BLOCK_SIZE / 2, AGS_WAVE_STREAM_TEST_BLOCK_SIZE) == TRUE);
+  CU_ASSERT(g_atomic_int_get(&(wave_stream->miss)) == miss);
+  
+  /* the ring is fixed now */
+  g_object_set(wave_stream,
+	       "block-size", 2 * AGS_WAVE_STREAM_TEST_BLOCK_SIZE,
+	       NULL);
+
+  CU_ASSERT(wave_stream->block_size == AGS_WAVE_STREAM_TEST_BLOCK_SIZE);
+
+  g_object_unref(wave_stream);
+}
+
+void
+ags_wave_stream_test_prefetch()
+{
+  AgsWaveStream *wave_stream;
+
+  guint miss;
+  
+  wave_stream = ags_wave_stream_test_open();
+
+  /* read ahead of the playhead */
+  ags_wave_stream_locate(wave_stream,
+			 16 * AGS_WAVE_STREAM_TEST_BLOCK_SIZE);
+
+  CU_ASSERT(g_atomic_int_get(&(wave_stream->playhead_block)) == 16);
+  
+  ags_wave_stream_fill(wave_stream);
+
+  miss = g_atomic_int_get(&(wave_stream->miss));
+
+  CU_ASSERT(ags_wave_stream_test_compare(wave_stream,
+					 16 * AGS_WAVE_STREAM_TEST_BLOCK_SIZE, AGS_WAVE_STREAM_DEFAULT_READ_AHEAD * AGS_WAVE_STREAM_TEST_BLOCK_SIZE) == TRUE);
+  CU_ASSERT(g_atomic_int_get(&(wave_stream->miss)) == miss);
+
+  /* the loop start is prefetched and nothing after the loop end */
+  ags_wave_stream_set_loop(wave_stream,
+			   TRUE,
+			   4 * AGS_WAVE_STREAM_TEST_BLOCK_SIZE, 32 * AGS_WAVE_STREAM_TEST_BLOCK_SIZE);
+  ags_wave_stream_locate(wave_stream,
+			 30 * AGS_WAVE_STREAM_TEST_BLOCK_SIZE);
+
+  CU_ASSERT(ags_wave_stream_fill(wave_stream) == 2 + AGS_WAVE_STREAM_DEFAULT_LOOP_AHEAD);
+
+  miss = g_atomic_int_get(&(wave_stream->miss));
+
+  CU_ASSERT(ags_wave_stream_test_compare(wave_stream,
+					 4 * AGS_WAVE_STREAM_TEST_BLOCK_SIZE, AGS_WAVE_STREAM_DEFAULT_LOOP_AHEAD * AGS_WAVE_STREAM_TEST_BLOCK_SIZE) == TRUE);
+  CU_ASSERT(g_atomic_int_get(&(wave_stream->miss)) == miss);
+
+  g_object_unref(wave_stream);
+}
+
+void
+ags_wave_stream_test_evict()
+{
+  AgsWaveStream *wave_stream;
+
+  gint16 *buffer;
+
+  guint miss;
+  guint i;
+  
+  wave_stream = ags_wave_stream_test_open();
+
+  ags_wave_stream_locate(wave_stream,
+			 0);
+  ags_wave_stream_fill(wave_stream);
+
+  /* 2 empty slots left, the least recently used blocks are reused */
+  ags_wave_stream_locate(wave_stream,
+			 40 * AGS_WAVE_STREAM_TEST_BLOCK_SIZE);
+
+  CU_ASSERT(ags_wave_stream_fill(wave_stream) == AGS_WAVE_STREAM_DEFAULT_READ_AHEAD);
+
+  for(i = 0; i < wave_stream->ring_size; i++){
+    CU_ASSERT(g_atomic_int_get(&(wave_stream->ring[i]->state)) == AGS_WAVE_STREAM_BLOCK_READY);
+    CU_ASSERT(g_atomic_int_get(&(wave_stream->ring[i]->readers)) == 0);
+  }
+
+  miss = g_atomic_int_get(&(wave_stream->miss));
+
+  CU_ASSERT(ags_wave_stream_test_compare(wave_stream,
+					 40 * AGS_WAVE_STREAM_TEST_BLOCK_SIZE, AGS_WAVE_STREAM_DEFAULT_READ_AHEAD * AGS_WAVE_STREAM_TEST_BLOCK_SIZE) == TRUE);
+  CU_ASSERT(g_atomic_int_get(&(wave_stream->miss)) == miss);
+
+  /* the first block was evicted */
+  buffer = (gint16 *) ags_stream_alloc(AGS_WAVE_STREAM_TEST_BLOCK_SIZE,
+				       AGS_SOUNDCARD_SIGNED_16_BIT);
+
+  CU_ASSERT(ags_wave_stream_read(wave_stream,
+				 0,
+				 buffer, 1,
+				 AGS_WAVE_STREAM_TEST_BLOCK_SIZE, AGS_SOUNDCARD_SIGNED_16_BIT) == 0);
+  CU_ASSERT(g_atomic_int_get(&(wave_stream->miss)) == miss + 1);
+
+  ags_stream_free(buffer);
+
+  /* a changed audio channel drops all blocks */
+  g_object_set(wave_stream,
+	       "audio-channel", 0,
+	       NULL);
+
+  ags_wave_stream_locate(wave_stream,
+			 0);
+  ags_wave_stream_fill(wave_stream);
+
+  CU_ASSERT(ags_wave_stream_test_compare(wave_stream,
+					 0, AGS_WAVE_STREAM_TEST_BLOCK_SIZE) == TRUE);
+  
+  g_object_unref(wave_stream);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsWaveStreamTest", ags_wave_stream_test_init_suite, ags_wave_stream_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsWaveStream read", ags_wave_stream_test_read) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsWaveStream prefetch", ags_wave_stream_test_prefetch) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsWaveStream evict", ags_wave_stream_test_evict) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
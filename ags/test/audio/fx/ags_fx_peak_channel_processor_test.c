@@ -89,6 +89,10 @@ ags_fx_peak_channel_processor_test_run_inter()
   AgsFxPeakAudioProcessor *fx_peak_audio_processor;
   AgsFxPeakChannel *fx_peak_channel;
   AgsFxPeakChannelProcessor *fx_peak_channel_processor;
+
+  GValue value = G_VALUE_INIT;
+
+  guint i;
   
   /* audio */
   audio = g_object_new(AGS_TYPE_AUDIO,
@@ -156,8 +160,22 @@ ags_fx_peak_channel_processor_test_run_inter()
 
   /* run inter - attempt #1 */
   fx_peak_channel->peak_reseted = FALSE;
+
+  for(i = 0; i < AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE; i++){
+    fx_peak_channel->level_buffer[i] = ((i % 2 == 0) ? 0.5: -0.25);
+  }
   
   ags_recall_run_inter(fx_peak_channel_processor);
+
+  /* peak taken from the level analysis */
+  g_value_init(&value, G_TYPE_FLOAT);
+
+  ags_port_safe_read(fx_peak_channel->peak,
+		     &value);
+
+  CU_ASSERT(g_value_get_float(&value) == 0.5);
+
+  g_value_unset(&value);
 }
 
 int
@@ -0,0 +1,445 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+int ags_osc_address_trie_test_init_suite();
+int ags_osc_address_trie_test_clean_suite();
+
+void ags_osc_address_trie_test_find_port_end();
+void ags_osc_address_trie_test_is_concrete();
+void ags_osc_address_trie_test_insert();
+void ags_osc_address_trie_test_lookup();
+void ags_osc_address_trie_test_invalidate();
+void ags_osc_address_trie_test_audio_rename();
+void ags_osc_address_trie_test_stale_insert();
+void ags_osc_address_trie_test_weak_ref();
+
+#define AGS_OSC_ADDRESS_TRIE_TEST_PATH "/AgsSoundProvider/AgsAudio[\"test-drum\"]/AgsInput[0-15]/AgsVolumeChannel[0]/AgsPort[\"./volume[0]\"]:value"
+#define AGS_OSC_ADDRESS_TRIE_TEST_CONCRETE_PATH "/AgsSoundProvider/AgsAudio[\"test-drum\"]/AgsInput[3]/AgsVolumeChannel[0]/AgsPort[\"./volume[0]\"]:value"
+#define AGS_OSC_ADDRESS_TRIE_TEST_OTHER_PATH "/AgsSoundProvider/AgsAudio[\"test-drum\"]/AgsInput[4]/AgsVolumeChannel[0]/AgsPort[\"./volume[0]\"]:value"
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_osc_address_trie_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_osc_address_trie_test_clean_suite()
+{
+  return(0);
+}
+
+void
+ags_osc_address_trie_test_find_port_end()
+{
+  gchar *path;
+  
+  path = AGS_OSC_ADDRESS_TRIE_TEST_CONCRETE_PATH;
+
+  CU_ASSERT(ags_osc_address_trie_find_port_end(path) == strlen(path) - strlen(":value"));
+
+  CU_ASSERT(ags_osc_address_trie_find_port_end("/AgsSoundProvider/AgsAudio[\"a:b\"]") == 0);
+  CU_ASSERT(ags_osc_address_trie_find_port_end(NULL) == 0);
+}
+
+void
+ags_osc_address_trie_test_is_concrete()
+{
+  gchar *path;
+
+  path = AGS_OSC_ADDRESS_TRIE_TEST_CONCRETE_PATH;
+  
+  CU_ASSERT(ags_osc_address_trie_is_concrete(path, ags_osc_address_trie_find_port_end(path)) == TRUE);
+
+  path = AGS_OSC_ADDRESS_TRIE_TEST_PATH;
+
+  CU_ASSERT(ags_osc_address_trie_is_concrete(path, ags_osc_address_trie_find_port_end(path)) == FALSE);
+
+  CU_ASSERT(ags_osc_address_trie_is_concrete("/AgsSoundProvider/AgsAudio[0]/AgsInput[*]", 41) == FALSE);
+  CU_ASSERT(ags_osc_address_trie_is_concrete("/AgsSoundProvider/AgsAudio[]", 28) == FALSE);
+  CU_ASSERT(ags_osc_address_trie_is_concrete("/AgsSoundProvider/AgsAudio[0]", 29) == TRUE);
+}
+
+void
+ags_osc_address_trie_test_insert()
+{
+  AgsOscAddressTrie *osc_address_trie;
+  AgsRecall *recall;
+  AgsPort *port;
+
+  gchar *path;
+
+  osc_address_trie = ags_osc_address_trie_new();
+
+  recall = ags_recall_new();
+  port = ags_port_new();
+
+  ags_osc_address_trie_begin_resolve(osc_address_trie);
+  
+  /* concrete path */
+  path = AGS_OSC_ADDRESS_TRIE_TEST_CONCRETE_PATH;
+  
+  ags_osc_address_trie_insert(osc_address_trie,
+			      path, ags_osc_address_trie_find_port_end(path),
+			      (GObject *) recall,
+			      (GObject *) port);
+
+  CU_ASSERT(osc_address_trie->n_entries == 1);
+
+  /* range isn't cached */
+  path = AGS_OSC_ADDRESS_TRIE_TEST_PATH;
+  
+  ags_osc_address_trie_insert(osc_address_trie,
+			      path, ags_osc_address_trie_find_port_end(path),
+			      (GObject *) recall,
+			      (GObject *) port);
+
+  CU_ASSERT(osc_address_trie->n_entries == 1);
+
+  ags_osc_address_trie_end_resolve(osc_address_trie);
+
+  g_object_unref(osc_address_trie);
+
+  g_object_unref(recall);
+  g_object_unref(port);
+}
+
+void
+ags_osc_address_trie_test_lookup()
+{
+  AgsOscAddressTrie *osc_address_trie;
+  AgsRecall *recall, *current_recall;
+  AgsPort *port, *current_port;
+
+  gchar *path;
+
+  osc_address_trie = ags_osc_address_trie_new();
+
+  recall = ags_recall_new();
+  port = ags_port_new();
+
+  ags_osc_address_trie_begin_resolve(osc_address_trie);
+
+  path = AGS_OSC_ADDRESS_TRIE_TEST_CONCRETE_PATH;
+  
+  ags_osc_address_trie_insert(osc_address_trie,
+			      path, ags_osc_address_trie_find_port_end(path),
+			      (GObject *) recall,
+			      (GObject *) port);
+
+  /* hit */
+  current_recall = NULL;
+  current_port = (AgsPort *) ags_osc_address_trie_lookup(osc_address_trie,
+							 path, ags_osc_address_trie_find_port_end(path),
+							 (GObject **) &current_recall);
+
+  CU_ASSERT(current_port == port);
+  CU_ASSERT(current_recall == recall);
+
+  g_object_unref(current_port);
+  g_object_unref(current_recall);
+
+  /* miss */
+  path = AGS_OSC_ADDRESS_TRIE_TEST_OTHER_PATH;
+
+  current_recall = NULL;
+  current_port = (AgsPort *) ags_osc_address_trie_lookup(osc_address_trie,
+							 path, ags_osc_address_trie_find_port_end(path),
+							 (GObject **) &current_recall);
+
+  CU_ASSERT(current_port == NULL);
+  CU_ASSERT(current_recall == NULL);
+
+  ags_osc_address_trie_end_resolve(osc_address_trie);
+
+  g_object_unref(osc_address_trie);
+
+  g_object_unref(recall);
+  g_object_unref(port);
+}
+
+void
+ags_osc_address_trie_test_invalidate()
+{
+  AgsOscAddressTrie *osc_address_trie;
+  AgsRecall *recall, *current_recall;
+  AgsPort *port, *current_port;
+
+  gchar *path;
+
+  osc_address_trie = ags_osc_address_trie_new();
+
+  recall = ags_recall_new();
+  port = ags_port_new();
+
+  ags_osc_address_trie_begin_resolve(osc_address_trie);
+
+  path = AGS_OSC_ADDRESS_TRIE_TEST_CONCRETE_PATH;
+  
+  ags_osc_address_trie_insert(osc_address_trie,
+			      path, ags_osc_address_trie_find_port_end(path),
+			      (GObject *) recall,
+			      (GObject *) port);
+
+  ags_osc_address_trie_invalidate();
+  
+  current_recall = NULL;
+  current_port = (AgsPort *) ags_osc_address_trie_lookup(osc_address_trie,
+							 path, ags_osc_address_trie_find_port_end(path),
+							 (GObject **) &current_recall);
+
+  CU_ASSERT(current_port == NULL);
+  CU_ASSERT(current_recall == NULL);
+  CU_ASSERT(osc_address_trie->n_entries == 0);
+
+  ags_osc_address_trie_end_resolve(osc_address_trie);
+
+  g_object_unref(osc_address_trie);
+
+  g_object_unref(recall);
+  g_object_unref(port);
+}
+
+void
+ags_osc_address_trie_test_audio_rename()
+{
+  AgsOscAddressTrie *osc_address_trie;
+  AgsAudio *audio;
+  AgsRecall *recall, *current_recall;
+  AgsPort *port, *current_port;
+
+  gchar *path;
+
+  osc_address_trie = ags_osc_address_trie_new();
+
+  audio = ags_audio_new(NULL);
+  g_object_set(audio,
+	       "audio-name", "test-drum",
+	       NULL);
+  
+  recall = ags_recall_new();
+  port = ags_port_new();
+
+  path = AGS_OSC_ADDRESS_TRIE_TEST_CONCRETE_PATH;
+
+  /* same name keeps the entries */
+  ags_osc_address_trie_begin_resolve(osc_address_trie);
+  
+  ags_osc_address_trie_insert(osc_address_trie,
+			      path, ags_osc_address_trie_find_port_end(path),
+			      (GObject *) recall,
+			      (GObject *) port);
+
+  ags_osc_address_trie_end_resolve(osc_address_trie);
+
+  g_object_set(audio,
+	       "audio-name", "test-drum",
+	       NULL);
+
+  current_recall = NULL;
+  current_port = (AgsPort *) ags_osc_address_trie_lookup(osc_address_trie,
+							 path, ags_osc_address_trie_find_port_end(path),
+							 (GObject **) &current_recall);
+
+  CU_ASSERT(current_port == port);
+
+  if(current_port != NULL){
+    g_object_unref(current_port);
+  }
+
+  if(current_recall != NULL){
+    g_object_unref(current_recall);
+  }
+  
+  /* rename drops them */
+  g_object_set(audio,
+	       "audio-name", "test-renamed-drum",
+	       NULL);
+  
+  current_recall = NULL;
+  current_port = (AgsPort *) ags_osc_address_trie_lookup(osc_address_trie,
+							 path, ags_osc_address_trie_find_port_end(path),
+							 (GObject **) &current_recall);
+
+  CU_ASSERT(current_port == NULL);
+  CU_ASSERT(current_recall == NULL);
+  CU_ASSERT(osc_address_trie->n_entries == 0);
+
+  g_object_unref(osc_address_trie);
+
+  g_object_unref(recall);
+  g_object_unref(port);
+
+  g_object_unref(audio);
+}
+
+void
+ags_osc_address_trie_test_stale_insert()
+{
+  AgsOscAddressTrie *osc_address_trie;
+  AgsRecall *recall;
+  AgsPort *port;
+
+  gchar *path;
+
+  osc_address_trie = ags_osc_address_trie_new();
+
+  recall = ags_recall_new();
+  port = ags_port_new();
+
+  path = AGS_OSC_ADDRESS_TRIE_TEST_CONCRETE_PATH;
+
+  /* not resolving */
+  ags_osc_address_trie_insert(osc_address_trie,
+			      path, ags_osc_address_trie_find_port_end(path),
+			      (GObject *) recall,
+			      (GObject *) port);
+
+  CU_ASSERT(osc_address_trie->n_entries == 0);
+
+  /* invalidated while resolving */
+  ags_osc_address_trie_begin_resolve(osc_address_trie);
+
+  ags_osc_address_trie_invalidate();
+  
+  ags_osc_address_trie_insert(osc_address_trie,
+			      path, ags_osc_address_trie_find_port_end(path),
+			      (GObject *) recall,
+			      (GObject *) port);
+
+  CU_ASSERT(osc_address_trie->n_entries == 0);
+  
+  ags_osc_address_trie_end_resolve(osc_address_trie);
+
+  g_object_unref(osc_address_trie);
+
+  g_object_unref(recall);
+  g_object_unref(port);
+}
+
+void
+ags_osc_address_trie_test_weak_ref()
+{
+  AgsOscAddressTrie *osc_address_trie;
+  AgsRecall *recall, *current_recall;
+  AgsPort *port, *current_port;
+
+  gchar *path;
+
+  osc_address_trie = ags_osc_address_trie_new();
+
+  recall = ags_recall_new();
+  port = ags_port_new();
+
+  path = AGS_OSC_ADDRESS_TRIE_TEST_CONCRETE_PATH;
+
+  ags_osc_address_trie_begin_resolve(osc_address_trie);
+
+  ags_osc_address_trie_insert(osc_address_trie,
+			      path, ags_osc_address_trie_find_port_end(path),
+			      (GObject *) recall,
+			      (GObject *) port);
+
+  ags_osc_address_trie_end_resolve(osc_address_trie);
+
+  /* the trie doesn't own a reference */
+  CU_ASSERT(G_OBJECT(port)->ref_count == 1);
+  CU_ASSERT(G_OBJECT(recall)->ref_count == 1);
+
+  g_object_unref(port);
+
+  current_recall = NULL;
+  current_port = (AgsPort *) ags_osc_address_trie_lookup(osc_address_trie,
+							 path, ags_osc_address_trie_find_port_end(path),
+							 (GObject **) &current_recall);
+
+  CU_ASSERT(current_port == NULL);
+  CU_ASSERT(current_recall == NULL);
+  CU_ASSERT(osc_address_trie->n_entries == 0);
+
+  g_object_unref(osc_address_trie);
+
+  g_object_unref(recall);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsOscAddressTrieTest", ags_osc_address_trie_test_init_suite, ags_osc_address_trie_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of ags_osc_address_trie.c find port end", ags_osc_address_trie_test_find_port_end) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_osc_address_trie.c is concrete", ags_osc_address_trie_test_is_concrete) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_osc_address_trie.c insert", ags_osc_address_trie_test_insert) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_osc_address_trie.c lookup", ags_osc_address_trie_test_lookup) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_osc_address_trie.c invalidate", ags_osc_address_trie_test_invalidate) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_osc_address_trie.c audio rename", ags_osc_address_trie_test_audio_rename) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_osc_address_trie.c stale insert", ags_osc_address_trie_test_stale_insert) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_osc_address_trie.c weak ref", ags_osc_address_trie_test_weak_ref) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
@@ -0,0 +1,488 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <stdlib.h>
+
+int ags_osc_scheduler_test_init_suite();
+int ags_osc_scheduler_test_clean_suite();
+
+void ags_osc_scheduler_test_timetag_to_time();
+void ags_osc_scheduler_test_time_to_frame();
+void ags_osc_scheduler_test_push();
+void ags_osc_scheduler_test_push_dispatched();
+void ags_osc_scheduler_test_drain();
+void ags_osc_scheduler_test_release_retired();
+void ags_osc_scheduler_test_get_offset();
+
+#define AGS_OSC_SCHEDULER_TEST_SAMPLERATE (48000)
+#define AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE (512)
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_osc_scheduler_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_osc_scheduler_test_clean_suite()
+{
+  return(0);
+}
+
+void
+ags_osc_scheduler_test_timetag_to_time()
+{
+  /* unix epoch */
+  CU_ASSERT(ags_osc_scheduler_timetag_to_time((gint32) 2208988800u, 0) == 0);
+
+  /* half a second */
+  CU_ASSERT(ags_osc_scheduler_timetag_to_time((gint32) 2208988801u, (gint32) 0x80000000u) == 3 * G_USEC_PER_SEC / 2);
+}
+
+void
+ags_osc_scheduler_test_time_to_frame()
+{
+  AgsOscScheduler *osc_scheduler;
+
+  guint64 frame;
+  gint64 reference_time;
+
+  osc_scheduler = ags_osc_scheduler_new();
+
+  /* clock not running */
+  CU_ASSERT(ags_osc_scheduler_time_to_frame(osc_scheduler,
+					    g_get_real_time(),
+					    &frame) == FALSE);
+
+  ags_osc_scheduler_drain(osc_scheduler,
+			  AGS_OSC_SCHEDULER_TEST_SAMPLERATE, AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE);
+
+  reference_time = osc_scheduler->reference_time;
+  
+  CU_ASSERT(ags_osc_scheduler_time_to_frame(osc_scheduler,
+					    reference_time + G_USEC_PER_SEC,
+					    &frame) == TRUE);
+  CU_ASSERT(frame == AGS_OSC_SCHEDULER_TEST_SAMPLERATE);
+
+  /* past maps to the current period */
+  CU_ASSERT(ags_osc_scheduler_time_to_frame(osc_scheduler,
+					    reference_time - G_USEC_PER_SEC,
+					    &frame) == TRUE);
+  CU_ASSERT(frame == AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE);
+
+  g_object_unref(osc_scheduler);
+}
+
+void
+ags_osc_scheduler_test_push()
+{
+  AgsOscScheduler *osc_scheduler;
+  AgsPort *port;
+
+  GValue value = G_VALUE_INIT;
+
+  guint i;
+
+  osc_scheduler = ags_osc_scheduler_new();
+
+  port = ags_port_new();
+  
+  g_value_init(&value,
+	       G_TYPE_DOUBLE);
+
+  for(i = 0; i < 8; i++){
+    g_value_set_double(&value,
+		       (gdouble) i);
+    
+    CU_ASSERT(ags_osc_scheduler_push(osc_scheduler,
+				     (guint64) (8 - i) * 100,
+				     port,
+				     &value) == TRUE);
+  }
+
+  CU_ASSERT(osc_scheduler->n_events == 8);
+  CU_ASSERT(osc_scheduler->event[0].frame == 100);
+
+  /* string isn't scheduled */
+  g_value_unset(&value);
+  g_value_init(&value,
+	       G_TYPE_STRING);
+
+  CU_ASSERT(ags_osc_scheduler_push(osc_scheduler,
+				   0,
+				   port,
+				   &value) == FALSE);
+
+  g_value_unset(&value);
+
+  ags_osc_scheduler_clear(osc_scheduler);
+
+  CU_ASSERT(osc_scheduler->n_events == 0);
+
+  g_object_unref(osc_scheduler);
+}
+
+void
+ags_osc_scheduler_test_push_dispatched()
+{
+  AgsOscScheduler *osc_scheduler;
+  AgsPort *port;
+
+  GValue value = G_VALUE_INIT;
+
+  gint64 time_now;
+  guint64 tv_sec;
+  
+  osc_scheduler = ags_osc_scheduler_new();
+
+  port = ags_port_new();
+  
+  g_value_init(&value,
+	       G_TYPE_FLOAT);
+  g_value_set_float(&value,
+		    1.0);
+
+  /* no dispatch */
+  CU_ASSERT(ags_osc_scheduler_push_dispatched(osc_scheduler,
+					      port,
+					      &value) == FALSE);
+
+  /* clock not running */
+  CU_ASSERT(ags_osc_scheduler_begin_dispatch(osc_scheduler,
+					     0, 0) == FALSE);
+
+  ags_osc_scheduler_drain(osc_scheduler,
+			  AGS_OSC_SCHEDULER_TEST_SAMPLERATE, AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE);
+
+  /* one second ahead */
+  time_now = g_get_real_time();
+
+  tv_sec = (guint64) (time_now / G_USEC_PER_SEC) + AGS_OSC_SCHEDULER_NTP_UNIX_OFFSET + 1;
+  
+  CU_ASSERT(ags_osc_scheduler_begin_dispatch(osc_scheduler,
+					     (gint32) tv_sec, 0) == TRUE);
+  CU_ASSERT(ags_osc_scheduler_push_dispatched(osc_scheduler,
+					      port,
+					      &value) == TRUE);
+
+  ags_osc_scheduler_end_dispatch(osc_scheduler);
+
+  CU_ASSERT(ags_osc_scheduler_push_dispatched(osc_scheduler,
+					      port,
+					      &value) == FALSE);
+
+  CU_ASSERT(osc_scheduler->n_events == 1);
+  CU_ASSERT(osc_scheduler->event[0].frame >= AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE);
+  CU_ASSERT(osc_scheduler->event[0].frame <= AGS_OSC_SCHEDULER_TEST_SAMPLERATE + AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE);
+
+  g_value_unset(&value);
+
+  g_object_unref(osc_scheduler);
+}
+
+void
+ags_osc_scheduler_test_drain()
+{
+  AgsOscScheduler *osc_scheduler;
+  AgsPort *port;
+
+  GValue value = G_VALUE_INIT;
+
+  osc_scheduler = ags_osc_scheduler_new();
+
+  port = ags_port_new();
+  g_object_set(port,
+	       "port-value-is-pointer", FALSE,
+	       "port-value-type", G_TYPE_DOUBLE,
+	       NULL);
+
+  port->port_value.ags_port_double = 0.0;
+  
+  g_value_init(&value,
+	       G_TYPE_DOUBLE);
+
+  /* in order of frame, then arrival */
+  g_value_set_double(&value,
+		     3.0);
+  ags_osc_scheduler_push(osc_scheduler,
+			 2 * AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE,
+			 port,
+			 &value);
+
+  g_value_set_double(&value,
+		     1.0);
+  ags_osc_scheduler_push(osc_scheduler,
+			 10,
+			 port,
+			 &value);
+
+  g_value_set_double(&value,
+		     2.0);
+  ags_osc_scheduler_push(osc_scheduler,
+			 10,
+			 port,
+			 &value);
+
+  CU_ASSERT(ags_osc_scheduler_drain(osc_scheduler,
+				    AGS_OSC_SCHEDULER_TEST_SAMPLERATE, AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE) == 2);
+  CU_ASSERT(port->port_value.ags_port_double == 2.0);
+
+  CU_ASSERT(ags_osc_scheduler_drain(osc_scheduler,
+				    AGS_OSC_SCHEDULER_TEST_SAMPLERATE, AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE) == 0);
+  CU_ASSERT(port->port_value.ags_port_double == 2.0);
+
+  CU_ASSERT(ags_osc_scheduler_drain(osc_scheduler,
+				    AGS_OSC_SCHEDULER_TEST_SAMPLERATE, AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE) == 1);
+  CU_ASSERT(port->port_value.ags_port_double == 3.0);
+
+  CU_ASSERT(osc_scheduler->frame == 3 * AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE);
+
+  /* drain doesn't release */
+  CU_ASSERT(osc_scheduler->n_retired_ports == 3);
+  CU_ASSERT(G_OBJECT(port)->ref_count == 4);
+  
+  g_value_unset(&value);
+
+  g_object_unref(osc_scheduler);
+}
+
+void
+ags_osc_scheduler_test_get_offset()
+{
+  AgsOscScheduler *osc_scheduler;
+  AgsPort *port;
+
+  GValue value = G_VALUE_INIT;
+  GValue previous_value = G_VALUE_INIT;
+
+  osc_scheduler = ags_osc_scheduler_new();
+
+  port = ags_port_new();
+  g_object_set(port,
+	       "port-value-is-pointer", FALSE,
+	       "port-value-type", G_TYPE_DOUBLE,
+	       NULL);
+
+  port->port_value.ags_port_double = 0.0;
+  
+  g_value_init(&value,
+	       G_TYPE_DOUBLE);
+  g_value_init(&previous_value,
+	       G_TYPE_DOUBLE);
+
+  /* within the period */
+  g_value_set_double(&value,
+		     1.0);
+  ags_osc_scheduler_push(osc_scheduler,
+			 AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE - 12,
+			 port,
+			 &value);
+
+  g_value_set_double(&value,
+		     2.0);
+  ags_osc_scheduler_push(osc_scheduler,
+			 AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE + 100,
+			 port,
+			 &value);
+
+  CU_ASSERT(ags_osc_scheduler_drain(osc_scheduler,
+				    AGS_OSC_SCHEDULER_TEST_SAMPLERATE, AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE) == 1);
+  CU_ASSERT(port->port_value.ags_port_double == 1.0);
+
+  CU_ASSERT(ags_osc_scheduler_get_offset(osc_scheduler,
+					 port,
+					 &previous_value) == AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE - 12);
+  CU_ASSERT(g_value_get_double(&previous_value) == 0.0);
+
+  /* next period */
+  CU_ASSERT(ags_osc_scheduler_drain(osc_scheduler,
+				    AGS_OSC_SCHEDULER_TEST_SAMPLERATE, AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE) == 1);
+  CU_ASSERT(port->port_value.ags_port_double == 2.0);
+
+  CU_ASSERT(ags_osc_scheduler_get_offset(osc_scheduler,
+					 port,
+					 &previous_value) == 100);
+  CU_ASSERT(g_value_get_double(&previous_value) == 1.0);
+
+  /* applies to the whole period */
+  ags_osc_scheduler_drain(osc_scheduler,
+			  AGS_OSC_SCHEDULER_TEST_SAMPLERATE, AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE);
+  
+  CU_ASSERT(ags_osc_scheduler_get_offset(osc_scheduler,
+					 port,
+					 NULL) == 0);
+
+  /* a plain write takes effect immediately */
+  g_value_set_double(&value,
+		     3.0);
+  ags_osc_scheduler_push(osc_scheduler,
+			 3 * AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE + 10,
+			 port,
+			 &value);
+  
+  ags_osc_scheduler_drain(osc_scheduler,
+			  AGS_OSC_SCHEDULER_TEST_SAMPLERATE, AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE);
+
+  ags_port_safe_write(port,
+		      &value);
+  
+  CU_ASSERT(ags_osc_scheduler_get_offset(osc_scheduler,
+					 port,
+					 NULL) == 0);
+
+  g_value_unset(&value);
+  g_value_unset(&previous_value);
+
+  ags_osc_scheduler_release_retired(osc_scheduler);
+
+  g_object_unref(osc_scheduler);
+
+  g_object_unref(port);
+}
+
+void
+ags_osc_scheduler_test_release_retired()
+{
+  AgsOscScheduler *osc_scheduler;
+  AgsPort *port;
+
+  GValue value = G_VALUE_INIT;
+
+  guint i;
+  gboolean success;
+  
+  osc_scheduler = ags_osc_scheduler_new();
+
+  port = ags_port_new();
+  g_object_set(port,
+	       "port-value-is-pointer", FALSE,
+	       "port-value-type", G_TYPE_DOUBLE,
+	       NULL);
+  
+  g_value_init(&value,
+	       G_TYPE_DOUBLE);
+
+  g_value_set_double(&value,
+		     1.0);
+
+  /* bounded heap */
+  success = TRUE;
+  
+  for(i = 0; i < osc_scheduler->allocated_events; i++){
+    if(!ags_osc_scheduler_push(osc_scheduler,
+			       0,
+			       port,
+			       &value)){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+  CU_ASSERT(ags_osc_scheduler_push(osc_scheduler,
+				   0,
+				   port,
+				   &value) == FALSE);
+
+  /* retired slots count until released */
+  ags_osc_scheduler_drain(osc_scheduler,
+			  AGS_OSC_SCHEDULER_TEST_SAMPLERATE, AGS_OSC_SCHEDULER_TEST_BUFFER_SIZE);
+
+  CU_ASSERT(osc_scheduler->n_events == 0);
+  CU_ASSERT(osc_scheduler->n_retired_ports == osc_scheduler->allocated_events);
+
+  ags_osc_scheduler_release_retired(osc_scheduler);
+  
+  CU_ASSERT(osc_scheduler->n_retired_ports == 0);
+  CU_ASSERT(G_OBJECT(port)->ref_count == 1);
+
+  CU_ASSERT(ags_osc_scheduler_push(osc_scheduler,
+				   0,
+				   port,
+				   &value) == TRUE);
+
+  g_value_unset(&value);
+
+  g_object_unref(osc_scheduler);
+
+  g_object_unref(port);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsOscSchedulerTest", ags_osc_scheduler_test_init_suite, ags_osc_scheduler_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of ags_osc_scheduler.c timetag to time", ags_osc_scheduler_test_timetag_to_time) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_osc_scheduler.c time to frame", ags_osc_scheduler_test_time_to_frame) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_osc_scheduler.c push", ags_osc_scheduler_test_push) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_osc_scheduler.c push dispatched", ags_osc_scheduler_test_push_dispatched) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_osc_scheduler.c drain", ags_osc_scheduler_test_drain) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_osc_scheduler.c release retired", ags_osc_scheduler_test_release_retired) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_osc_scheduler.c get offset", ags_osc_scheduler_test_get_offset) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
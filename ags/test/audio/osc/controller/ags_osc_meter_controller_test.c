@@ -42,6 +42,7 @@ void ags_osc_meter_controller_test_find_path();
 void ags_osc_meter_controller_test_find_port();
 void ags_osc_meter_controller_test_add_monitor();
 void ags_osc_meter_controller_test_remove_monitor();
+void ags_osc_meter_controller_test_monitor_read_value();
 void ags_osc_meter_controller_test_contains_monitor();
 void ags_osc_meter_controller_test_start_monitor();
 void ags_osc_meter_controller_test_stop_monitor();
@@ -357,6 +358,46 @@ ags_osc_meter_controller_test_remove_monitor()
   CU_ASSERT(osc_meter_controller->monitor == NULL);
 }
 
+void
+ags_osc_meter_controller_test_monitor_read_value()
+{
+  AgsPort *port;
+  
+  AgsOscMeterControllerMonitor *monitor;
+
+  port = ags_port_new();
+  g_object_set(port,
+	       "port-value-is-pointer", FALSE,
+	       "port-value-type", G_TYPE_FLOAT,
+	       NULL);
+
+  port->port_value.ags_port_float = 0.5;
+  
+  monitor = ags_osc_meter_controller_monitor_alloc();
+
+  monitor->port = port;
+
+  /* first read */
+  CU_ASSERT(ags_osc_meter_controller_monitor_read_value(monitor,
+							0.01) == TRUE);
+  CU_ASSERT(monitor->value_length == 1);
+  CU_ASSERT(monitor->value[0] == 0.5);
+
+  /* below threshold */
+  port->port_value.ags_port_float = 0.505;
+
+  CU_ASSERT(ags_osc_meter_controller_monitor_read_value(monitor,
+							0.01) == FALSE);
+  CU_ASSERT(monitor->value[0] == 0.5);
+
+  /* above threshold */
+  port->port_value.ags_port_float = 0.25;
+
+  CU_ASSERT(ags_osc_meter_controller_monitor_read_value(monitor,
+							0.01) == TRUE);
+  CU_ASSERT(monitor->value[0] == 0.25);
+}
+
 void
 ags_osc_meter_controller_test_contains_monitor()
 {
@@ -521,6 +562,7 @@ main(int argc, char **argv)
      (CU_add_test(pSuite, "test of AgsOscMeterController find port", ags_osc_meter_controller_test_find_port) == NULL) ||
      (CU_add_test(pSuite, "test of AgsOscMeterController add monitor", ags_osc_meter_controller_test_add_monitor) == NULL) ||
      (CU_add_test(pSuite, "test of AgsOscMeterController remove monitor", ags_osc_meter_controller_test_remove_monitor) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsOscMeterController monitor read value", ags_osc_meter_controller_test_monitor_read_value) == NULL) ||
      (CU_add_test(pSuite, "test of AgsOscMeterController contains monitor", ags_osc_meter_controller_test_contains_monitor) == NULL) ||
      (CU_add_test(pSuite, "test of AgsOscMeterController start monitor", ags_osc_meter_controller_test_start_monitor) == NULL) ||
      (CU_add_test(pSuite, "test of AgsOscMeterController stop monitor", ags_osc_meter_controller_test_stop_monitor) == NULL) ||
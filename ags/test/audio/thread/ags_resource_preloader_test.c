@@ -0,0 +1,288 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+#include <glib/gstdio.h>
+
+#include <unistd.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+int ags_resource_preloader_test_init_suite();
+int ags_resource_preloader_test_clean_suite();
+
+void ags_resource_preloader_test_add();
+void ags_resource_preloader_test_start();
+void ags_resource_preloader_test_take_audio_signal();
+void ags_resource_preloader_test_wait_audio_container();
+
+#define AGS_RESOURCE_PRELOADER_TEST_N_FILES (3)
+
+gchar *test_filename[AGS_RESOURCE_PRELOADER_TEST_N_FILES];
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_resource_preloader_test_init_suite()
+{
+  guint i;
+
+  for(i = 0; i < AGS_RESOURCE_PRELOADER_TEST_N_FILES; i++){
+    gint fd;
+
+    test_filename[i] = NULL;
+
+    fd = g_file_open_tmp("ags_resource_preloader_test-XXXXXX",
+			 &(test_filename[i]),
+			 NULL);
+
+    if(fd == -1){
+      return(-1);
+    }
+
+    /* different sizes */
+    g_file_set_contents(test_filename[i],
+			"0123456789abcdef",
+			(i + 1) * 4,
+			NULL);
+
+    close(fd);
+  }
+
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_resource_preloader_test_clean_suite()
+{
+  guint i;
+
+  for(i = 0; i < AGS_RESOURCE_PRELOADER_TEST_N_FILES; i++){
+    if(test_filename[i] != NULL){
+      g_unlink(test_filename[i]);
+
+      g_free(test_filename[i]);
+    }
+  }
+
+  return(0);
+}
+
+void
+ags_resource_preloader_test_add()
+{
+  AgsResourcePreloader *resource_preloader;
+
+  GList *list;
+
+  guint i;
+
+  resource_preloader = ags_resource_preloader_new(NULL);
+
+  for(i = 0; i < AGS_RESOURCE_PRELOADER_TEST_N_FILES; i++){
+    CU_ASSERT(ags_resource_preloader_add(resource_preloader,
+					 AGS_RESOURCE_PRELOADER_PLUGIN,
+					 test_filename[i]) == TRUE);
+  }
+
+  /* duplicate and missing files */
+  CU_ASSERT(ags_resource_preloader_add(resource_preloader,
+				       AGS_RESOURCE_PRELOADER_PLUGIN,
+				       test_filename[0]) == FALSE);
+  CU_ASSERT(ags_resource_preloader_add(resource_preloader,
+				       AGS_RESOURCE_PRELOADER_PLUGIN,
+				       "/ags-resource-preloader-test/no-such-file") == FALSE);
+
+  CU_ASSERT(g_list_length(resource_preloader->job) == AGS_RESOURCE_PRELOADER_TEST_N_FILES);
+
+  /* largest first */
+  list = resource_preloader->job;
+
+  while(list->next != NULL){
+    CU_ASSERT(AGS_RESOURCE_PRELOADER_JOB(list->data)->size >= AGS_RESOURCE_PRELOADER_JOB(list->next->data)->size);
+
+    list = list->next;
+  }
+
+  g_object_unref(resource_preloader);
+}
+
+void
+ags_resource_preloader_test_start()
+{
+  AgsResourcePreloader *resource_preloader;
+
+  GList *list;
+
+  guint i;
+
+  resource_preloader = ags_resource_preloader_new(NULL);
+
+  g_object_set(resource_preloader,
+	       "max-device-jobs", 1,
+	       NULL);
+
+  for(i = 0; i < AGS_RESOURCE_PRELOADER_TEST_N_FILES; i++){
+    ags_resource_preloader_add(resource_preloader,
+			       AGS_RESOURCE_PRELOADER_PLUGIN,
+			       test_filename[i]);
+  }
+
+  ags_resource_preloader_start(resource_preloader);
+
+  CU_ASSERT(ags_resource_preloader_add(resource_preloader,
+				       AGS_RESOURCE_PRELOADER_PLUGIN,
+				       test_filename[0]) == FALSE);
+
+  ags_resource_preloader_join(resource_preloader);
+
+  CU_ASSERT(ags_resource_preloader_test_flags(resource_preloader, AGS_RESOURCE_PRELOADER_RUNNING) == FALSE);
+  CU_ASSERT(ags_resource_preloader_test_flags(resource_preloader, AGS_RESOURCE_PRELOADER_HAS_COMPLETED) == TRUE);
+
+  CU_ASSERT(resource_preloader->n_pending == 0);
+
+  list = resource_preloader->job;
+
+  while(list != NULL){
+    CU_ASSERT(AGS_RESOURCE_PRELOADER_JOB(list->data)->completed == TRUE);
+
+    /* not a shared object */
+    CU_ASSERT(AGS_RESOURCE_PRELOADER_JOB(list->data)->plugin_so == NULL);
+
+    list = list->next;
+  }
+
+  ags_resource_preloader_release(resource_preloader);
+
+  CU_ASSERT(resource_preloader->job == NULL);
+
+  g_object_unref(resource_preloader);
+}
+
+void
+ags_resource_preloader_test_take_audio_signal()
+{
+  AgsResourcePreloader *resource_preloader;
+
+  resource_preloader = ags_resource_preloader_new(NULL);
+
+  /* not added */
+  CU_ASSERT(ags_resource_preloader_take_audio_signal(resource_preloader,
+						     NULL,
+						     test_filename[0],
+						     0) == NULL);
+
+  /* not completed */
+  ags_resource_preloader_add(resource_preloader,
+			     AGS_RESOURCE_PRELOADER_AUDIO_FILE,
+			     test_filename[0]);
+
+  CU_ASSERT(ags_resource_preloader_take_audio_signal(resource_preloader,
+						     NULL,
+						     test_filename[0],
+						     0) == NULL);
+
+  g_object_unref(resource_preloader);
+}
+
+void
+ags_resource_preloader_test_wait_audio_container()
+{
+  AgsResourcePreloader *resource_preloader;
+
+  resource_preloader = ags_resource_preloader_new(NULL);
+
+  /* not running */
+  ags_resource_preloader_add(resource_preloader,
+			     AGS_RESOURCE_PRELOADER_AUDIO_CONTAINER,
+			     test_filename[0]);
+
+  CU_ASSERT(ags_resource_preloader_wait_audio_container(test_filename[0]) == NULL);
+
+  /* running, no audio container job of filename */
+  ags_resource_preloader_add(resource_preloader,
+			     AGS_RESOURCE_PRELOADER_PLUGIN,
+			     test_filename[1]);
+
+  ags_resource_preloader_start(resource_preloader);
+
+  CU_ASSERT(ags_resource_preloader_wait_audio_container(test_filename[1]) == NULL);
+
+  /* joined, the regular loaders use the audio container manager */
+  ags_resource_preloader_join(resource_preloader);
+
+  CU_ASSERT(ags_resource_preloader_wait_audio_container(test_filename[0]) == NULL);
+
+  ags_resource_preloader_release(resource_preloader);
+
+  g_object_unref(resource_preloader);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsResourcePreloaderTest", ags_resource_preloader_test_init_suite, ags_resource_preloader_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsResourcePreloader add", ags_resource_preloader_test_add) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsResourcePreloader start", ags_resource_preloader_test_start) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsResourcePreloader take audio signal", ags_resource_preloader_test_take_audio_signal) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsResourcePreloader wait audio container", ags_resource_preloader_test_wait_audio_container) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
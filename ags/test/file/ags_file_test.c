@@ -202,7 +202,86 @@ ags_file_test_find_id_ref_by_node()
 void
 ags_file_test_find_id_ref_by_xpath()
 {
-  //TODO:JK: implement me
+  AgsFile *file;
+  AgsFileIdRef *file_id_ref[4], *current;
+
+  xmlDoc *doc;
+  xmlNode *root_node;
+  xmlNode *node[4];
+
+  gchar *id;
+  
+  guint i;
+  
+  file = g_object_new(AGS_TYPE_FILE,
+		      NULL);
+
+  doc = xmlNewDoc("1.0");
+
+  root_node = xmlNewNode(NULL,
+			 "ags");
+  xmlDocSetRootElement(doc,
+		       root_node);
+  
+  g_object_set(file,
+	       "xml-doc", doc,
+	       NULL);
+  
+  /* add some id refs */
+  for(i = 0; i < 3; i++){
+    node[i] = xmlNewChild(root_node,
+			  NULL,
+			  "ags-file-test",
+			  NULL);
+
+    id = g_strdup_printf("ags-file-test-%d", i);
+    xmlNewProp(node[i],
+	       "id",
+	       id);
+    g_free(id);
+    
+    file_id_ref[i] = g_object_new(AGS_TYPE_FILE_ID_REF,
+				  "node", node[i],
+				  NULL);
+    ags_file_add_id_ref(file,
+			file_id_ref[i]);
+  }
+
+  /* id assigned after adding the id ref isn't indexed */
+  node[3] = xmlNewChild(root_node,
+			NULL,
+			"ags-file-test",
+			NULL);
+
+  file_id_ref[3] = g_object_new(AGS_TYPE_FILE_ID_REF,
+				"node", node[3],
+				NULL);
+  ags_file_add_id_ref(file,
+		      file_id_ref[3]);
+
+  xmlNewProp(node[3],
+	     "id",
+	     "ags-file-test-3");
+
+  /* assert find by xpath */
+  CU_ASSERT((current = ags_file_find_id_ref_by_xpath(file,
+						     "xpath=//*[@id='ags-file-test-0']")) != NULL &&
+	    current == file_id_ref[0]);
+
+  CU_ASSERT((current = ags_file_find_id_ref_by_xpath(file,
+						     "xpath=//ags-file-test[@id='ags-file-test-1']")) != NULL &&
+	    current == file_id_ref[1]);
+
+  CU_ASSERT(ags_file_find_id_ref_by_xpath(file,
+					  "xpath=//ags-machine[@id='ags-file-test-2']") == NULL);
+
+  CU_ASSERT((current = ags_file_find_id_ref_by_xpath(file,
+						     "xpath=//ags-file-test[@id='ags-file-test-3']")) != NULL &&
+	    current == file_id_ref[3]);
+
+  CU_ASSERT((current = ags_file_find_id_ref_by_xpath(file,
+						     "xpath=/ags/ags-file-test")) != NULL &&
+	    current == file_id_ref[0]);
 }
 
 void
@@ -38,6 +38,7 @@ void ags_lv2_plugin_test_concat_atom_sequence();
 void ags_lv2_plugin_test_atom_sequence_append_midi();
 void ags_lv2_plugin_test_atom_sequence_remove_midi();
 void ags_lv2_plugin_test_clear_atom_sequence();
+void ags_lv2_plugin_test_atom_sequence_append_midi_at();
 void ags_lv2_plugin_test_find_pname();
 void ags_lv2_plugin_test_change_program();
 
@@ -76,6 +77,14 @@ void ags_lv2_plugin_test_stub_change_program(AgsLv2Plugin *lv2_plugin,
 #define AGS_LV2_PLUGIN_TEST_CLEAR_ATOM_SEQUENCE_NOTE_0 (17)
 #define AGS_LV2_PLUGIN_TEST_CLEAR_ATOM_SEQUENCE_SIZE (1024)
 
+#define AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_NOTE_0 (32)
+#define AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_NOTE_1 (48)
+#define AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_NOTE_2 (64)
+#define AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_FRAME_0 (17)
+#define AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_FRAME_1 (255)
+#define AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_FRAME_2 (128)
+#define AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_SIZE (1024)
+
 #define AGS_LV2_PLUGIN_TEST_FIND_PNAME_SWH "swh"
 #define AGS_LV2_PLUGIN_TEST_FIND_PNAME_INVADA "invada"
 #define AGS_LV2_PLUGIN_TEST_FIND_PNAME_ZYN "zyn"
@@ -493,6 +502,80 @@ ags_lv2_plugin_test_clear_atom_sequence()
   CU_ASSERT(((uint8_t *) (LV2_ATOM_BODY(&(aev->body))))[1] == 0);
 }
 
+void
+ags_lv2_plugin_test_atom_sequence_append_midi_at()
+{
+  LV2_Atom_Sequence *aseq;
+  LV2_Atom_Event *aev;
+
+  snd_seq_event_t seq_event[3];
+
+  guint frame[3];
+  uint32_t id;
+  guint i;
+
+  id = ags_lv2_urid_manager_map(NULL,
+				LV2_MIDI__MidiEvent);
+
+  memset(&seq_event, 0, 3 * sizeof(snd_seq_event_t));
+
+  seq_event[0].type = SND_SEQ_EVENT_NOTEON;
+  seq_event[0].data.note.note = AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_NOTE_0;
+  seq_event[0].data.note.velocity = 127;
+
+  seq_event[1].type = SND_SEQ_EVENT_NOTEON;
+  seq_event[1].data.note.note = AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_NOTE_1;
+  seq_event[1].data.note.velocity = 127;
+
+  seq_event[2].type = SND_SEQ_EVENT_NOTEOFF;
+  seq_event[2].data.note.note = AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_NOTE_2;
+  seq_event[2].data.note.velocity = 0;
+
+  frame[0] = AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_FRAME_0;
+  frame[1] = AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_FRAME_1;
+  frame[2] = AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_FRAME_2;
+  
+  aseq = ags_lv2_plugin_alloc_atom_sequence(AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_SIZE);
+  ags_lv2_plugin_atom_sequence_reset(aseq);
+
+  CU_ASSERT(aseq->atom.size == sizeof(LV2_Atom_Sequence_Body));
+  
+  /* append out of order and assert time order */
+  for(i = 0; i < 3; i++){
+    CU_ASSERT(ags_lv2_plugin_atom_sequence_append_midi_at(aseq,
+							  AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_SIZE,
+							  frame[i],
+							  &(seq_event[i]),
+							  1) == TRUE);
+  }
+
+  CU_ASSERT(aseq->atom.size == sizeof(LV2_Atom_Sequence_Body) + 3 * AGS_LV2_PLUGIN_ATOM_MIDI_STRIDE);
+
+  aev = lv2_atom_sequence_begin(&(aseq->body));
+
+  CU_ASSERT(aev->time.frames == AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_FRAME_0 &&
+	    aev->body.type == id &&
+	    ((uint8_t *) (LV2_ATOM_BODY(&(aev->body))))[1] == AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_NOTE_0);
+  aev = lv2_atom_sequence_next(aev);
+
+  CU_ASSERT(aev->time.frames == AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_FRAME_2 &&
+	    ((uint8_t *) (LV2_ATOM_BODY(&(aev->body))))[1] == AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_NOTE_2);
+  aev = lv2_atom_sequence_next(aev);
+
+  CU_ASSERT(aev->time.frames == AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_FRAME_1 &&
+	    ((uint8_t *) (LV2_ATOM_BODY(&(aev->body))))[1] == AGS_LV2_PLUGIN_TEST_ATOM_SEQUENCE_APPEND_MIDI_AT_NOTE_1);
+  aev = lv2_atom_sequence_next(aev);
+
+  CU_ASSERT(lv2_atom_sequence_is_end(&(aseq->body), aseq->atom.size, aev));
+  
+  /* reset */
+  ags_lv2_plugin_atom_sequence_reset(aseq);
+
+  CU_ASSERT(aseq->atom.size == sizeof(LV2_Atom_Sequence_Body));
+  
+  ags_lv2_plugin_atom_sequence_free(aseq);
+}
+
 void
 ags_lv2_plugin_test_find_pname()
 {
@@ -595,6 +678,7 @@ main(int argc, char **argv)
      (CU_add_test(pSuite, "test of AgsLv2Plugin atom sequence append midi", ags_lv2_plugin_test_atom_sequence_append_midi) == NULL) ||
      (CU_add_test(pSuite, "test of AgsLv2Plugin atom sequence remove midi", ags_lv2_plugin_test_atom_sequence_remove_midi) == NULL) ||
      (CU_add_test(pSuite, "test of AgsLv2Plugin clear atom sequence", ags_lv2_plugin_test_clear_atom_sequence) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsLv2Plugin atom sequence append midi at", ags_lv2_plugin_test_atom_sequence_append_midi_at) == NULL) ||
      (CU_add_test(pSuite, "test of AgsLv2Plugin find pname", ags_lv2_plugin_test_find_pname) == NULL) ||
      (CU_add_test(pSuite, "test of AgsLv2Plugin change program", ags_lv2_plugin_test_change_program) == NULL)){
     CU_cleanup_registry();
@@ -33,9 +33,29 @@ int ags_lv2_worker_manager_test_init_suite();
 int ags_lv2_worker_manager_test_clean_suite();
 
 void ags_lv2_worker_manager_test_pull_worker();
+void ags_lv2_worker_manager_test_remove_worker();
+void ags_lv2_worker_manager_test_wakeup();
+
+LV2_Worker_Status ags_lv2_worker_manager_test_stub_work(LV2_Handle instance,
+							LV2_Worker_Respond_Function respond,
+							LV2_Worker_Respond_Handle handle,
+							uint32_t data_size,
+							const void* data);
 
 #define AGS_LV2_WORKER_MANAGER_TEST_PULL_WORKER_DELAY (5000000)
 
+#define AGS_LV2_WORKER_MANAGER_TEST_WAKEUP_COUNT (16)
+#define AGS_LV2_WORKER_MANAGER_TEST_WAKEUP_DELAY (1000)
+#define AGS_LV2_WORKER_MANAGER_TEST_WAKEUP_TIMEOUT (5000)
+
+LV2_Worker_Interface ags_lv2_worker_manager_test_stub_interface = {
+  ags_lv2_worker_manager_test_stub_work,
+  NULL,
+  NULL,
+};
+
+volatile gint stub_work_count = 0;
+
 AgsApplicationContext *application_context;
 
 /* Opens the temporary file used by the tests.
@@ -65,6 +85,18 @@ ags_lv2_worker_manager_test_clean_suite()
   return(0);
 }
 
+LV2_Worker_Status
+ags_lv2_worker_manager_test_stub_work(LV2_Handle instance,
+				      LV2_Worker_Respond_Function respond,
+				      LV2_Worker_Respond_Handle handle,
+				      uint32_t data_size,
+				      const void* data)
+{
+  g_atomic_int_inc(&stub_work_count);
+
+  return(LV2_WORKER_SUCCESS);
+}
+
 void
 ags_lv2_worker_manager_test_pull_worker()
 {
@@ -90,6 +122,102 @@ ags_lv2_worker_manager_test_pull_worker()
   g_object_unref(lv2_worker_manager);
 }
 
+void
+ags_lv2_worker_manager_test_remove_worker()
+{
+  AgsLv2WorkerManager *lv2_worker_manager;
+  
+  GObject *worker, *other_worker;
+  
+  lv2_worker_manager = ags_lv2_worker_manager_new();
+
+  /* every instance pulls its own worker */
+  worker = ags_lv2_worker_manager_pull_worker(lv2_worker_manager);
+  other_worker = ags_lv2_worker_manager_pull_worker(lv2_worker_manager);
+
+  CU_ASSERT(worker != other_worker);
+  CU_ASSERT(g_list_length((GList *) lv2_worker_manager->worker) == 2);
+
+  ags_lv2_worker_manager_insert_handle(lv2_worker_manager,
+				       GUINT_TO_POINTER(1),
+				       worker);
+
+  /* removing one instance keeps the other */
+  g_object_ref(worker);
+  
+  ags_lv2_worker_manager_remove_handle(lv2_worker_manager,
+				       GUINT_TO_POINTER(1));
+
+  CU_ASSERT(worker->ref_count == 1);
+  CU_ASSERT(g_list_find((GList *) lv2_worker_manager->worker, worker) == NULL);
+  CU_ASSERT(ags_lv2_worker_manager_find_worker(lv2_worker_manager,
+					       GUINT_TO_POINTER(1)) == NULL);
+  CU_ASSERT(g_list_find((GList *) lv2_worker_manager->worker, other_worker) != NULL);
+
+  g_object_unref(worker);
+
+  /* a worker without instance, e.g. instantiate failed */
+  ags_lv2_worker_manager_remove_worker(lv2_worker_manager,
+				       other_worker);
+
+  CU_ASSERT(lv2_worker_manager->worker == NULL);
+
+  ags_lv2_worker_manager_stop_pool(lv2_worker_manager);
+  
+  g_object_unref(lv2_worker_manager);
+}
+
+void
+ags_lv2_worker_manager_test_wakeup()
+{
+  AgsLv2WorkerManager *lv2_worker_manager;
+  
+  GObject *worker;
+
+  guint value;
+  guint i;
+  
+  lv2_worker_manager = ags_lv2_worker_manager_new();
+
+  worker = ags_lv2_worker_manager_pull_worker(lv2_worker_manager);
+
+  AGS_LV2_WORKER(worker)->handle = (LV2_Handle) worker;
+  AGS_LV2_WORKER(worker)->worker_interface = &ags_lv2_worker_manager_test_stub_interface;
+
+  ags_lv2_worker_manager_insert_handle(lv2_worker_manager,
+				       worker,
+				       worker);
+
+  g_atomic_int_set(&stub_work_count,
+		   0);
+  
+  /* posted by the producer, processed by the pool */
+  for(i = 0; i < AGS_LV2_WORKER_MANAGER_TEST_WAKEUP_COUNT; i++){
+    value = i;
+    
+    ags_lv2_worker_schedule_work(worker,
+				 sizeof(guint),
+				 &value);
+  }
+
+  for(i = 0; i < AGS_LV2_WORKER_MANAGER_TEST_WAKEUP_TIMEOUT && g_atomic_int_get(&(lv2_worker_manager->n_pending)) > 0; i++){
+    usleep(AGS_LV2_WORKER_MANAGER_TEST_WAKEUP_DELAY);
+  }
+
+  CU_ASSERT(g_atomic_int_get(&(lv2_worker_manager->n_pending)) == 0);
+  CU_ASSERT(g_atomic_int_get(&stub_work_count) == AGS_LV2_WORKER_MANAGER_TEST_WAKEUP_COUNT);
+
+  ags_lv2_worker_manager_remove_handle(lv2_worker_manager,
+				       worker);
+
+  /* wakes every pool thread */
+  ags_lv2_worker_manager_stop_pool(lv2_worker_manager);
+
+  CU_ASSERT(lv2_worker_manager->pool_thread == NULL);
+  
+  g_object_unref(lv2_worker_manager);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -110,7 +238,9 @@ main(int argc, char **argv)
   }
 
   /* add the tests to the suite */
-  if((CU_add_test(pSuite, "test of AgsLv2WorkerManager pull worker", ags_lv2_worker_manager_test_pull_worker) == NULL)){
+  if((CU_add_test(pSuite, "test of AgsLv2WorkerManager pull worker", ags_lv2_worker_manager_test_pull_worker) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsLv2WorkerManager remove worker", ags_lv2_worker_manager_test_remove_worker) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsLv2WorkerManager wakeup", ags_lv2_worker_manager_test_wakeup) == NULL)){
     CU_cleanup_registry();
     
     return CU_get_error();
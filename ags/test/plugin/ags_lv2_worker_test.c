@@ -0,0 +1,295 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <string.h>
+
+int ags_lv2_worker_test_init_suite();
+int ags_lv2_worker_test_clean_suite();
+
+void ags_lv2_worker_test_schedule_work();
+void ags_lv2_worker_test_respond();
+void ags_lv2_worker_test_deliver_response();
+
+LV2_Worker_Status ags_lv2_worker_test_stub_work(LV2_Handle instance,
+						LV2_Worker_Respond_Function respond,
+						LV2_Worker_Respond_Handle handle,
+						uint32_t data_size,
+						const void* data);
+LV2_Worker_Status ags_lv2_worker_test_stub_work_response(LV2_Handle instance,
+							 uint32_t size,
+							 const void* body);
+LV2_Worker_Status ags_lv2_worker_test_stub_end_run(LV2_Handle instance);
+
+#define AGS_LV2_WORKER_TEST_SCHEDULE_WORK_COUNT (16)
+
+LV2_Worker_Interface ags_lv2_worker_test_stub_interface = {
+  ags_lv2_worker_test_stub_work,
+  ags_lv2_worker_test_stub_work_response,
+  ags_lv2_worker_test_stub_end_run,
+};
+
+guint stub_work_count = 0;
+guint stub_work_response_count = 0;
+guint stub_work_response_sum = 0;
+guint stub_end_run_count = 0;
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_lv2_worker_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_lv2_worker_test_clean_suite()
+{
+  return(0);
+}
+
+LV2_Worker_Status
+ags_lv2_worker_test_stub_work(LV2_Handle instance,
+			      LV2_Worker_Respond_Function respond,
+			      LV2_Worker_Respond_Handle handle,
+			      uint32_t data_size,
+			      const void* data)
+{
+  guint value;
+
+  stub_work_count++;
+
+  value = ((guint *) data)[0];
+
+  /* respond with the doubled value */
+  value *= 2;
+  
+  return(respond(handle,
+		 sizeof(guint),
+		 &value));
+}
+
+LV2_Worker_Status
+ags_lv2_worker_test_stub_work_response(LV2_Handle instance,
+				       uint32_t size,
+				       const void* body)
+{
+  stub_work_response_count++;
+
+  stub_work_response_sum += ((guint *) body)[0];
+  
+  return(LV2_WORKER_SUCCESS);
+}
+
+LV2_Worker_Status
+ags_lv2_worker_test_stub_end_run(LV2_Handle instance)
+{
+  stub_end_run_count++;
+  
+  return(LV2_WORKER_SUCCESS);
+}
+
+void
+ags_lv2_worker_test_schedule_work()
+{
+  AgsLv2Worker *lv2_worker;
+
+  guint8 *data;
+  
+  guint value;
+  guint i;
+  LV2_Worker_Status status;
+  
+  lv2_worker = ags_lv2_worker_new();
+
+  lv2_worker->handle = (LV2_Handle) lv2_worker;
+  lv2_worker->worker_interface = &ags_lv2_worker_test_stub_interface;
+
+  stub_work_count = 0;
+  
+  /* payload is copied */
+  for(i = 0; i < AGS_LV2_WORKER_TEST_SCHEDULE_WORK_COUNT; i++){
+    value = i;
+    
+    status = ags_lv2_worker_schedule_work(lv2_worker,
+					  sizeof(guint),
+					  &value);
+
+    CU_ASSERT(status == LV2_WORKER_SUCCESS);
+  }
+
+  CU_ASSERT(ags_lv2_worker_process(lv2_worker) == AGS_LV2_WORKER_TEST_SCHEDULE_WORK_COUNT);
+  CU_ASSERT(stub_work_count == AGS_LV2_WORKER_TEST_SCHEDULE_WORK_COUNT);
+  
+  CU_ASSERT(ags_lv2_worker_process(lv2_worker) == 0);
+
+  /* bounded capacity */
+  data = (guint8 *) g_malloc(AGS_LV2_WORKER_DEFAULT_RING_SIZE);
+  memset(data, 0, AGS_LV2_WORKER_DEFAULT_RING_SIZE);
+
+  status = ags_lv2_worker_schedule_work(lv2_worker,
+					AGS_LV2_WORKER_DEFAULT_RING_SIZE,
+					data);
+  
+  CU_ASSERT(status == LV2_WORKER_ERR_NO_SPACE);
+
+  status = ags_lv2_worker_schedule_work(lv2_worker,
+					AGS_LV2_WORKER_DEFAULT_RING_SIZE / 2,
+					data);
+  
+  CU_ASSERT(status == LV2_WORKER_SUCCESS);
+
+  status = ags_lv2_worker_schedule_work(lv2_worker,
+					AGS_LV2_WORKER_DEFAULT_RING_SIZE / 2,
+					data);
+  
+  CU_ASSERT(status == LV2_WORKER_ERR_NO_SPACE);
+  
+  g_free(data);
+  
+  g_object_unref(lv2_worker);
+}
+
+void
+ags_lv2_worker_test_respond()
+{
+  AgsLv2Worker *lv2_worker;
+
+  guint value;
+  LV2_Worker_Status status;
+  
+  lv2_worker = ags_lv2_worker_new();
+
+  value = 1;
+  
+  status = ags_lv2_worker_respond(lv2_worker,
+				  sizeof(guint),
+				  &value);
+
+  CU_ASSERT(status == LV2_WORKER_SUCCESS);
+
+  /* copied into the response ring */
+  CU_ASSERT(g_atomic_int_get(&(lv2_worker->response_write)) - g_atomic_int_get(&(lv2_worker->response_read)) == sizeof(uint32_t) + sizeof(guint));
+  
+  g_object_unref(lv2_worker);
+}
+
+void
+ags_lv2_worker_test_deliver_response()
+{
+  AgsLv2Worker *lv2_worker;
+
+  guint value;
+  guint expected_sum;
+  guint i;
+  
+  lv2_worker = ags_lv2_worker_new();
+
+  lv2_worker->handle = (LV2_Handle) lv2_worker;
+  lv2_worker->worker_interface = &ags_lv2_worker_test_stub_interface;
+
+  stub_work_response_count = 0;
+  stub_work_response_sum = 0;
+  stub_end_run_count = 0;
+
+  expected_sum = 0;
+  
+  for(i = 0; i < AGS_LV2_WORKER_TEST_SCHEDULE_WORK_COUNT; i++){
+    value = i;
+    
+    ags_lv2_worker_schedule_work(lv2_worker,
+				 sizeof(guint),
+				 &value);
+
+    expected_sum += (2 * i);
+  }
+
+  /* no response before work was done */
+  CU_ASSERT(ags_lv2_worker_deliver_response(lv2_worker) == 0);
+  
+  ags_lv2_worker_process(lv2_worker);
+
+  /* responses are delivered by the caller's thread */
+  CU_ASSERT(stub_work_response_count == 0);
+  
+  CU_ASSERT(ags_lv2_worker_deliver_response(lv2_worker) == AGS_LV2_WORKER_TEST_SCHEDULE_WORK_COUNT);
+  CU_ASSERT(stub_work_response_count == AGS_LV2_WORKER_TEST_SCHEDULE_WORK_COUNT);
+  CU_ASSERT(stub_work_response_sum == expected_sum);
+
+  ags_lv2_worker_end_run(lv2_worker);
+
+  CU_ASSERT(stub_end_run_count == 1);
+  
+  g_object_unref(lv2_worker);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+  
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsLv2WorkerTest", ags_lv2_worker_test_init_suite, ags_lv2_worker_test_clean_suite);
+  
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsLv2Worker schedule work", ags_lv2_worker_test_schedule_work) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsLv2Worker respond", ags_lv2_worker_test_respond) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsLv2Worker deliver response", ags_lv2_worker_test_deliver_response) == NULL)){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+  
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+  
+  CU_cleanup_registry();
+  
+  return(CU_get_error());
+}
@@ -22,6 +22,10 @@
 
 #include <ags/libags.h>
 
+#include <libxml/parser.h>
+
+#include <string.h>
+
 #include <CUnit/CUnit.h>
 #include <CUnit/Automated.h>
 #include <CUnit/Basic.h>
@@ -53,6 +57,16 @@ void ags_xml_authentication_test_find_user_uuid();
 
 #define AGS_XML_AUTHENTICATION_TEST_OPEN_FILENAME SRCDIR "/" "ags_authentication_test.xml"
 
+#define AGS_XML_AUTHENTICATION_TEST_FIND_USER_UUID_DEFAULT_XML "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" \
+  "<ags-server-authentication>" \
+  "<ags-srv-auth-list>" \
+  "<ags-srv-auth><ags-srv-user-uuid>ags-test-uuid-0</ags-srv-user-uuid></ags-srv-auth>" \
+  "<ags-srv-auth><ags-srv-user-uuid>ags-test-uuid-1</ags-srv-user-uuid>" \
+  "<ags-srv-auth-session-list><ags-srv-auth-session>ags-test-security-token</ags-srv-auth-session></ags-srv-auth-session-list>" \
+  "</ags-srv-auth>" \
+  "</ags-srv-auth-list>" \
+  "</ags-server-authentication>"
+
 AgsServerApplicationContext *server_application_context;
 
 /* The suite initialization time.
@@ -251,7 +265,34 @@ ags_xml_authentication_test_open_filename()
 void
 ags_xml_authentication_test_find_user_uuid()
 {
-  //TODO:JK: implement me
+  AgsXmlAuthentication *xml_authentication;
+
+  xmlNode *auth_node;
+  xmlNode *session_node;
+  
+  xml_authentication = ags_xml_authentication_new();
+
+  xml_authentication->doc = xmlReadMemory(AGS_XML_AUTHENTICATION_TEST_FIND_USER_UUID_DEFAULT_XML,
+					  strlen(AGS_XML_AUTHENTICATION_TEST_FIND_USER_UUID_DEFAULT_XML),
+					  NULL, NULL, 0);
+  xml_authentication->root_node = xmlDocGetRootElement(xml_authentication->doc);
+
+  ags_xml_authentication_reindex(xml_authentication);
+
+  auth_node = ags_xml_authentication_find_user_uuid(xml_authentication,
+						    "ags-test-uuid-1");
+
+  CU_ASSERT(auth_node != NULL);
+  CU_ASSERT(auth_node != ags_xml_authentication_find_user_uuid(xml_authentication,
+							       "ags-test-uuid-0"));
+  CU_ASSERT(ags_xml_authentication_find_user_uuid(xml_authentication,
+						  "ags-test-uuid-2") == NULL);
+
+  session_node = ags_xml_authentication_find_security_token(xml_authentication,
+							    "ags-test-security-token");
+
+  CU_ASSERT(session_node != NULL);
+  CU_ASSERT(session_node != NULL && session_node->parent->parent == auth_node);
 }
 
 int
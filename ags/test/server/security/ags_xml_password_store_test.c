@@ -22,6 +22,10 @@
 
 #include <ags/libags.h>
 
+#include <libxml/parser.h>
+
+#include <string.h>
+
 #include <CUnit/CUnit.h>
 #include <CUnit/Automated.h>
 #include <CUnit/Basic.h>
@@ -56,6 +60,14 @@ void ags_xml_password_store_test_find_login();
 
 #define AGS_XML_PASSWORD_STORE_TEST_OPEN_FILENAME SRCDIR "/" "ags_password_store_test.xml"
 
+#define AGS_XML_PASSWORD_STORE_TEST_FIND_LOGIN_DEFAULT_XML "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" \
+  "<ags-server-password-store>" \
+  "<ags-srv-user-list>" \
+  "<ags-srv-user><ags-srv-user-uuid>ags-test-uuid-0</ags-srv-user-uuid><ags-srv-user-login>ags-test-user-0</ags-srv-user-login></ags-srv-user>" \
+  "<ags-srv-user><ags-srv-user-uuid>ags-test-uuid-1</ags-srv-user-uuid><ags-srv-user-login>ags-test-user-1</ags-srv-user-login></ags-srv-user>" \
+  "</ags-srv-user-list>" \
+  "</ags-server-password-store>"
+
 AgsServerApplicationContext *server_application_context;
 
 /* The suite initialization time.
@@ -232,7 +244,41 @@ ags_xml_password_store_test_open_filename()
 void
 ags_xml_password_store_test_find_login()
 {
-  //TODO:JK: implement me
+  AgsXmlPasswordStore *xml_password_store;
+
+  xmlNode *user_node;
+  
+  xml_password_store = ags_xml_password_store_new();
+
+  xml_password_store->doc = xmlReadMemory(AGS_XML_PASSWORD_STORE_TEST_FIND_LOGIN_DEFAULT_XML,
+					  strlen(AGS_XML_PASSWORD_STORE_TEST_FIND_LOGIN_DEFAULT_XML),
+					  NULL, NULL, 0);
+  xml_password_store->root_node = xmlDocGetRootElement(xml_password_store->doc);
+
+  ags_xml_password_store_reindex(xml_password_store);
+
+  user_node = ags_xml_password_store_find_login(xml_password_store,
+						"ags-test-user-1");
+
+  CU_ASSERT(user_node != NULL);
+  CU_ASSERT(user_node == ags_xml_password_store_find_user_uuid(xml_password_store,
+							       "ags-test-uuid-1"));
+
+  CU_ASSERT(ags_xml_password_store_find_login(xml_password_store,
+					      "ags-test-user-2") == NULL);
+
+  /* rename login */
+  ags_password_store_set_login_name(AGS_PASSWORD_STORE(xml_password_store),
+				    ags_auth_security_context_get_instance(),
+				    "ags-test-uuid-1",
+				    NULL,
+				    "ags-test-user-2",
+				    NULL);
+  
+  CU_ASSERT(ags_xml_password_store_find_login(xml_password_store,
+					      "ags-test-user-1") == NULL);
+  CU_ASSERT(ags_xml_password_store_find_login(xml_password_store,
+					      "ags-test-user-2") == user_node);
 }
 
 int
@@ -0,0 +1,349 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+int ags_message_delivery_test_init_suite();
+int ags_message_delivery_test_clean_suite();
+
+void ags_message_delivery_test_post();
+void ags_message_delivery_test_unsubscribe();
+void ags_message_delivery_test_post_message_queue();
+void ags_message_delivery_test_set_object_list();
+
+#define AGS_MESSAGE_DELIVERY_TEST_METHOD "AgsMessageDeliveryTest::post"
+#define AGS_MESSAGE_DELIVERY_TEST_SENDER_NAMESPACE "libags-test"
+#define AGS_MESSAGE_DELIVERY_TEST_N_MESSAGES (8)
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_message_delivery_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_message_delivery_test_clean_suite()
+{
+  return(0);
+}
+
+void
+ags_message_delivery_test_post()
+{
+  AgsMessageDelivery *message_delivery;
+  AgsMessageSubscriber *message_subscriber, *other_message_subscriber;
+  AgsMessage *start_message, *message;
+
+  GObject *sender, *other_sender;
+
+  guint i;
+  gboolean success;
+
+  message_delivery = ags_message_delivery_new();
+
+  sender = g_object_new(G_TYPE_OBJECT,
+			NULL);
+  other_sender = g_object_new(G_TYPE_OBJECT,
+			      NULL);
+
+  message_subscriber = ags_message_subscriber_alloc(NULL);
+  other_message_subscriber = ags_message_subscriber_alloc(NULL);
+
+  ags_message_delivery_subscribe(message_delivery,
+				 sender,
+				 message_subscriber);
+  ags_message_delivery_subscribe(message_delivery,
+				 other_sender,
+				 other_message_subscriber);
+
+  for(i = 0; i < AGS_MESSAGE_DELIVERY_TEST_N_MESSAGES; i++){
+    message = ags_message_alloc(sender,
+				AGS_MESSAGE_DELIVERY_TEST_METHOD,
+				1);
+    message->value[0].uint_value = i;
+
+    ags_message_delivery_post(message_delivery,
+			      message);
+  }
+
+  /* assert post order */
+  message =
+    start_message = ags_message_subscriber_drain(message_subscriber);
+
+  success = TRUE;
+
+  for(i = 0; i < AGS_MESSAGE_DELIVERY_TEST_N_MESSAGES; i++){
+    if(message == NULL ||
+       message->sender != sender ||
+       message->method != g_intern_static_string(AGS_MESSAGE_DELIVERY_TEST_METHOD) ||
+       message->value[0].uint_value != i){
+      success = FALSE;
+
+      break;
+    }
+
+    message = message->next;
+  }
+
+  CU_ASSERT(success == TRUE);
+  CU_ASSERT(message == NULL);
+
+  ags_message_free_all(start_message);
+
+  /* other sender's subscriber got nothing */
+  CU_ASSERT(ags_message_subscriber_drain(other_message_subscriber) == NULL);
+  CU_ASSERT(ags_message_subscriber_drain(message_subscriber) == NULL);
+
+  ags_message_delivery_unsubscribe(message_delivery,
+				   NULL,
+				   message_subscriber);
+  ags_message_delivery_unsubscribe(message_delivery,
+				   NULL,
+				   other_message_subscriber);
+
+  ags_message_subscriber_free(message_subscriber);
+  ags_message_subscriber_free(other_message_subscriber);
+
+  g_object_unref(sender);
+  g_object_unref(other_sender);
+
+  g_object_unref(message_delivery);
+}
+
+void
+ags_message_delivery_test_unsubscribe()
+{
+  AgsMessageDelivery *message_delivery;
+  AgsMessageSubscriber *message_subscriber;
+  AgsMessage *message;
+
+  GObject *sender;
+
+  message_delivery = ags_message_delivery_new();
+
+  sender = g_object_new(G_TYPE_OBJECT,
+			NULL);
+
+  message_subscriber = ags_message_subscriber_alloc(NULL);
+
+  ags_message_delivery_subscribe(message_delivery,
+				 sender,
+				 message_subscriber);
+  ags_message_delivery_unsubscribe(message_delivery,
+				   sender,
+				   message_subscriber);
+
+  message = ags_message_alloc(sender,
+			      AGS_MESSAGE_DELIVERY_TEST_METHOD,
+			      0);
+  ags_message_delivery_post(message_delivery,
+			    message);
+
+  CU_ASSERT(ags_message_subscriber_drain(message_subscriber) == NULL);
+  CU_ASSERT(g_hash_table_lookup(message_delivery->subscription,
+				sender) == NULL);
+
+  ags_message_subscriber_free(message_subscriber);
+
+  g_object_unref(sender);
+
+  g_object_unref(message_delivery);
+}
+
+void
+ags_message_delivery_test_post_message_queue()
+{
+  AgsMessageDelivery *message_delivery;
+  AgsMessageQueue *message_queue;
+  AgsMessageEnvelope *message_envelope;
+  AgsMessage *message;
+
+  GObject *sender;
+
+  GList *start_list;
+
+  message_delivery = ags_message_delivery_new();
+
+  message_queue = ags_message_queue_new(AGS_MESSAGE_DELIVERY_TEST_SENDER_NAMESPACE);
+  ags_message_delivery_add_message_queue(message_delivery,
+					 (GObject *) message_queue);
+
+  sender = g_object_new(G_TYPE_OBJECT,
+			NULL);
+
+  message = ags_message_alloc(sender,
+			      AGS_MESSAGE_DELIVERY_TEST_METHOD,
+			      1);
+  message->sender_namespace = AGS_MESSAGE_DELIVERY_TEST_SENDER_NAMESPACE;
+
+  message->parameter_name[0] = "count";
+  message->value_type[0] = G_TYPE_UINT;
+  message->value[0].uint_value = AGS_MESSAGE_DELIVERY_TEST_N_MESSAGES;
+
+  ags_message_delivery_post(message_delivery,
+			    message);
+
+  /* no envelope until queried */
+  CU_ASSERT(message_queue->message_envelope == NULL);
+
+  start_list = ags_message_delivery_find_sender(message_delivery,
+						NULL,
+						sender);
+
+  CU_ASSERT(g_list_length(start_list) == 1);
+  CU_ASSERT(g_list_length(message_queue->message_envelope) == 1);
+
+  if(start_list != NULL){
+    message_envelope = AGS_MESSAGE_ENVELOPE(start_list->data);
+
+    CU_ASSERT(message_envelope->sender == sender);
+    CU_ASSERT(message_envelope->doc != NULL);
+    CU_ASSERT(message_envelope->n_params == 1);
+    CU_ASSERT(!g_strcmp0(message_envelope->parameter_name[0], "count"));
+    CU_ASSERT(message_envelope->parameter_name[1] == NULL);
+    CU_ASSERT(g_value_get_uint(&(message_envelope->value[0])) == AGS_MESSAGE_DELIVERY_TEST_N_MESSAGES);
+  }
+
+  g_list_free_full(start_list,
+		   g_object_unref);
+
+  /* discard drops pending messages */
+  message = ags_message_alloc(sender,
+			      AGS_MESSAGE_DELIVERY_TEST_METHOD,
+			      0);
+  message->sender_namespace = AGS_MESSAGE_DELIVERY_TEST_SENDER_NAMESPACE;
+
+  ags_message_delivery_post(message_delivery,
+			    message);
+
+  ags_message_queue_discard_message(message_queue);
+  ags_message_queue_flush_message(message_queue);
+
+  CU_ASSERT(g_list_length(message_queue->message_envelope) == 1);
+
+  ags_message_delivery_remove_message_queue(message_delivery,
+					    (GObject *) message_queue);
+  g_object_unref(message_queue);
+
+  g_object_unref(sender);
+
+  g_object_unref(message_delivery);
+}
+
+void
+ags_message_delivery_test_set_object_list()
+{
+  AgsMessage *message, *copy;
+
+  GObject *sender;
+  GObject *gobject;
+
+  GList *start_list;
+
+  sender = g_object_new(G_TYPE_OBJECT,
+			NULL);
+  gobject = g_object_new(G_TYPE_OBJECT,
+			 NULL);
+
+  start_list = g_list_prepend(NULL,
+			      gobject);
+
+  message = ags_message_alloc(sender,
+			      AGS_MESSAGE_DELIVERY_TEST_METHOD,
+			      1);
+  ags_message_set_object_list(message,
+			      0,
+			      "recall-id",
+			      start_list);
+
+  /* the message owns its own list */
+  CU_ASSERT(message->value[0].pointer_value != start_list);
+  CU_ASSERT(G_OBJECT(gobject)->ref_count == 2);
+
+  g_list_free(start_list);
+
+  copy = ags_message_copy(message);
+
+  CU_ASSERT(copy->value[0].pointer_value != message->value[0].pointer_value);
+  CU_ASSERT(G_OBJECT(gobject)->ref_count == 3);
+
+  ags_message_free(message);
+  ags_message_free(copy);
+
+  CU_ASSERT(G_OBJECT(gobject)->ref_count == 1);
+
+  g_object_unref(gobject);
+  g_object_unref(sender);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsMessageDeliveryTest", ags_message_delivery_test_init_suite, ags_message_delivery_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsMessageDelivery post", ags_message_delivery_test_post) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsMessageDelivery unsubscribe", ags_message_delivery_test_unsubscribe) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsMessageDelivery post message queue", ags_message_delivery_test_post_message_queue) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsMessage set object list", ags_message_delivery_test_set_object_list) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
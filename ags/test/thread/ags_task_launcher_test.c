@@ -0,0 +1,367 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2017 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+int ags_task_launcher_test_init_suite();
+int ags_task_launcher_test_clean_suite();
+
+void ags_task_launcher_test_add_task();
+void ags_task_launcher_test_add_task_coalesced();
+void ags_task_launcher_test_add_func();
+void ags_task_launcher_test_add_func_launcher_thread();
+
+void ags_task_launcher_test_stub_launch(AgsTask *task);
+void ags_task_launcher_test_record_func(gpointer data);
+void ags_task_launcher_test_record_thread_func(gpointer data);
+
+gpointer ags_task_launcher_test_launcher_thread(gpointer data);
+
+guint stub_launch_count = 0;
+
+gint record[8];
+guint n_records = 0;
+
+volatile gpointer record_thread = NULL;
+
+GMainLoop *launcher_main_loop = NULL;
+
+/* The suite initialization time.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_task_launcher_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup time.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_task_launcher_test_clean_suite()
+{
+  return(0);
+}
+
+void
+ags_task_launcher_test_add_task()
+{
+  AgsTaskLauncher *task_launcher;
+  AgsTask *task[2];
+
+  GList *start_list;
+
+  gpointer ptr;
+  
+  task_launcher = ags_task_launcher_new();
+
+  task[0] = g_object_new(AGS_TYPE_TASK,
+			 NULL);
+  task[1] = g_object_new(AGS_TYPE_TASK,
+			 NULL);
+
+  /* stub launch */
+  ptr = AGS_TASK_GET_CLASS(task[0])->launch;
+  AGS_TASK_GET_CLASS(task[0])->launch = ags_task_launcher_test_stub_launch;
+
+  ags_task_launcher_add_task(task_launcher,
+			     task[0]);
+  ags_task_launcher_add_task(task_launcher,
+			     task[1]);
+
+  /* assert queued in order of arrival */
+  g_object_get(task_launcher,
+	       "task", &start_list,
+	       NULL);
+
+  CU_ASSERT(g_list_length(start_list) == 2);
+  CU_ASSERT(start_list->data == task[0]);
+  CU_ASSERT(start_list->next->data == task[1]);
+
+  g_list_free_full(start_list,
+		   g_object_unref);
+  
+  /* run and assert */
+  stub_launch_count = 0;
+  
+  ags_task_launcher_run(task_launcher);
+
+  CU_ASSERT(stub_launch_count == 2);
+
+  g_object_get(task_launcher,
+	       "task", &start_list,
+	       NULL);
+
+  CU_ASSERT(start_list == NULL);
+
+  AGS_TASK_GET_CLASS(task[0])->launch = ptr;
+}
+
+void
+ags_task_launcher_test_add_task_coalesced()
+{
+  AgsTaskLauncher *task_launcher;
+  AgsTask *task;
+
+  AgsTaskClass *task_class;
+
+  GObject *target[2];
+
+  gpointer ptr;
+
+  guint i;
+
+  task_launcher = ags_task_launcher_new();
+
+  target[0] = g_object_new(G_TYPE_OBJECT,
+			   NULL);
+  target[1] = g_object_new(G_TYPE_OBJECT,
+			   NULL);
+
+  task_class = g_type_class_ref(AGS_TYPE_TASK);
+  
+  /* stub launch */
+  ptr = task_class->launch;
+  task_class->launch = ags_task_launcher_test_stub_launch;
+
+  for(i = 0; i < 4; i++){
+    task = g_object_new(AGS_TYPE_TASK,
+			NULL);
+    ags_task_launcher_add_task_coalesced(task_launcher,
+					 task,
+					 target[0]);
+    g_object_unref(task);
+  }
+
+  task = g_object_new(AGS_TYPE_TASK,
+		      NULL);
+  ags_task_launcher_add_task_coalesced(task_launcher,
+				       task,
+				       target[1]);
+  g_object_unref(task);
+
+  /* run and assert */
+  stub_launch_count = 0;
+  
+  ags_task_launcher_run(task_launcher);
+
+  CU_ASSERT(stub_launch_count == 2);
+
+  task_class->launch = ptr;
+
+  g_type_class_unref(task_class);
+}
+
+void
+ags_task_launcher_test_add_func()
+{
+  AgsTaskLauncher *task_launcher;
+
+  static gint target = 0;
+
+  task_launcher = ags_task_launcher_new();
+
+  /* in order of arrival */
+  n_records = 0;
+
+  ags_task_launcher_add_func(task_launcher,
+			     ags_task_launcher_test_record_func,
+			     GINT_TO_POINTER(1),
+			     NULL,
+			     NULL);
+  ags_task_launcher_add_func(task_launcher,
+			     ags_task_launcher_test_record_func,
+			     GINT_TO_POINTER(2),
+			     NULL,
+			     NULL);
+  ags_task_launcher_add_func(task_launcher,
+			     ags_task_launcher_test_record_func,
+			     GINT_TO_POINTER(3),
+			     NULL,
+			     NULL);
+
+  ags_task_launcher_run(task_launcher);
+
+  CU_ASSERT(n_records == 3);
+  CU_ASSERT(record[0] == 1 && record[1] == 2 && record[2] == 3);
+
+  /* newest superseding */
+  n_records = 0;
+
+  ags_task_launcher_add_func(task_launcher,
+			     ags_task_launcher_test_record_func,
+			     GINT_TO_POINTER(4),
+			     NULL,
+			     &target);
+  ags_task_launcher_add_func(task_launcher,
+			     ags_task_launcher_test_record_func,
+			     GINT_TO_POINTER(5),
+			     NULL,
+			     NULL);
+  ags_task_launcher_add_func(task_launcher,
+			     ags_task_launcher_test_record_func,
+			     GINT_TO_POINTER(6),
+			     NULL,
+			     &target);
+
+  ags_task_launcher_run(task_launcher);
+
+  CU_ASSERT(n_records == 2);
+  CU_ASSERT(record[0] == 5 && record[1] == 6);
+}
+
+void
+ags_task_launcher_test_add_func_launcher_thread()
+{
+  AgsTaskLauncher *task_launcher;
+
+  GMainContext *main_context;
+
+  GThread *launcher_thread;
+
+  guint i;
+  
+  task_launcher = ags_task_launcher_new();
+
+  /* launcher thread running its own main context */
+  main_context = g_main_context_new();
+  launcher_main_loop = g_main_loop_new(main_context,
+				       FALSE);
+  
+  ags_task_launcher_attach(task_launcher,
+			   main_context);
+
+  launcher_thread = g_thread_new("ags_task_launcher_test",
+				 ags_task_launcher_test_launcher_thread,
+				 launcher_main_loop);
+
+  g_atomic_pointer_set(&record_thread,
+		       NULL);
+  
+  ags_task_launcher_add_func(task_launcher,
+			     ags_task_launcher_test_record_thread_func,
+			     NULL,
+			     NULL,
+			     NULL);
+
+  ags_task_launcher_sync_run(task_launcher);
+
+  /* wait for the launcher thread to run the func */
+  for(i = 0; i < 1000 && g_atomic_pointer_get(&record_thread) == NULL; i++){
+    g_usleep(G_USEC_PER_SEC / 1000);
+  }
+
+  CU_ASSERT(g_atomic_pointer_get(&record_thread) == launcher_thread);
+  CU_ASSERT(g_atomic_pointer_get(&record_thread) != g_thread_self());
+
+  g_main_loop_quit(launcher_main_loop);
+  g_thread_join(launcher_thread);
+
+  g_main_loop_unref(launcher_main_loop);
+  launcher_main_loop = NULL;
+  
+  g_object_unref(task_launcher);
+  g_main_context_unref(main_context);
+}
+
+void
+ags_task_launcher_test_stub_launch(AgsTask *task)
+{
+  stub_launch_count++;
+}
+
+void
+ags_task_launcher_test_record_func(gpointer data)
+{
+  if(n_records < 8){
+    record[n_records] = GPOINTER_TO_INT(data);
+    n_records++;
+  }
+}
+
+void
+ags_task_launcher_test_record_thread_func(gpointer data)
+{
+  g_atomic_pointer_set(&record_thread,
+		       g_thread_self());
+}
+
+gpointer
+ags_task_launcher_test_launcher_thread(gpointer data)
+{
+  GMainContext *main_context;
+
+  main_context = g_main_loop_get_context((GMainLoop *) data);
+
+  g_main_context_push_thread_default(main_context);
+  
+  g_main_loop_run((GMainLoop *) data);
+
+  g_main_context_pop_thread_default(main_context);
+  
+  return(NULL);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+  
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsTaskLauncherTest\0", ags_task_launcher_test_init_suite, ags_task_launcher_test_clean_suite);
+  
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsTaskLauncher add task\0", ags_task_launcher_test_add_task) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTaskLauncher add task coalesced\0", ags_task_launcher_test_add_task_coalesced) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTaskLauncher add func\0", ags_task_launcher_test_add_func) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTaskLauncher add func on launcher thread\0", ags_task_launcher_test_add_func_launcher_thread) == NULL)){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+  
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+  
+  CU_cleanup_registry();
+  
+  return(CU_get_error());
+}
@@ -38,6 +38,7 @@ void ags_thread_test_remove_child();
 void ags_thread_test_add_child();
 void ags_thread_test_is_current_ready();
 void ags_thread_test_stop();
+void ags_thread_test_tic_barrier();
 
 void* ags_thread_test_lock_assert_locked(void *ptr);
 
@@ -391,6 +392,57 @@ ags_thread_test_stop()
   //TODO:JK: implement me
 }
 
+void
+ags_thread_test_tic_barrier()
+{
+  AgsThread *tic_barrier_main_loop;
+  AgsTicBarrier *tic_barrier;
+
+  AgsConfig *config;
+
+  guint i;
+  
+  config = ags_config_get_instance();
+
+  /* disabled by default */
+  tic_barrier_main_loop = (AgsThread *) ags_generic_main_loop_new();
+
+  CU_ASSERT(!ags_thread_test_flags(tic_barrier_main_loop, AGS_THREAD_TIC_BARRIER));
+
+  g_object_unref(tic_barrier_main_loop);
+
+  /* enabled by config */
+  ags_config_set_value(config,
+		       AGS_CONFIG_THREAD,
+		       "tic-barrier",
+		       "true");
+
+  tic_barrier_main_loop = (AgsThread *) ags_generic_main_loop_new();
+
+  ags_config_set_value(config,
+		       AGS_CONFIG_THREAD,
+		       "tic-barrier",
+		       "false");
+
+  CU_ASSERT(ags_thread_test_flags(tic_barrier_main_loop, AGS_THREAD_TIC_BARRIER));
+
+  /* the clock trips the barrier */
+  ags_thread_start(tic_barrier_main_loop);
+
+  tic_barrier = ags_thread_get_tic_barrier(tic_barrier_main_loop);
+  
+  for(i = 0; i < 1000 && ags_tic_barrier_get_generation(tic_barrier) < 2; i++){
+    g_usleep(G_USEC_PER_SEC / 1000);
+  }
+
+  CU_ASSERT(ags_tic_barrier_get_generation(tic_barrier) >= 2);
+
+  ags_thread_stop(tic_barrier_main_loop);
+
+  g_object_unref(tic_barrier);
+  g_object_unref(tic_barrier_main_loop);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -422,7 +474,8 @@ main(int argc, char **argv)
      (CU_add_test(pSuite, "test of AgsThread remove child", ags_thread_test_remove_child) == NULL) ||
      (CU_add_test(pSuite, "test of AgsThread add child", ags_thread_test_add_child) == NULL) ||
      (CU_add_test(pSuite, "test of AgsThread is current ready", ags_thread_test_is_current_ready) == NULL) ||
-     (CU_add_test(pSuite, "test of AgsThread stop", ags_thread_test_stop) == NULL)){
+     (CU_add_test(pSuite, "test of AgsThread stop", ags_thread_test_stop) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsThread tic barrier", ags_thread_test_tic_barrier) == NULL)){
     CU_cleanup_registry();
       
     return CU_get_error();
@@ -0,0 +1,253 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+int ags_tic_barrier_test_init_suite();
+int ags_tic_barrier_test_clean_suite();
+
+void ags_tic_barrier_test_arrive();
+void ags_tic_barrier_test_leave();
+void ags_tic_barrier_test_latency_histogram();
+
+void ags_tic_barrier_test_trip_func(gpointer data);
+gpointer ags_tic_barrier_test_arrive_thread(gpointer data);
+
+#define AGS_TIC_BARRIER_TEST_ARRIVE_N_THREADS (4)
+#define AGS_TIC_BARRIER_TEST_ARRIVE_N_TICS (64)
+
+volatile gint trip_count = 0;
+
+/* The suite initialization time.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_tic_barrier_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup time.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_tic_barrier_test_clean_suite()
+{
+  return(0);
+}
+
+void
+ags_tic_barrier_test_trip_func(gpointer data)
+{
+  g_atomic_int_inc(&trip_count);
+}
+
+gpointer
+ags_tic_barrier_test_arrive_thread(gpointer data)
+{
+  AgsTicBarrier *tic_barrier;
+
+  guint i;
+
+  tic_barrier = (AgsTicBarrier *) data;
+  
+  for(i = 0; i < AGS_TIC_BARRIER_TEST_ARRIVE_N_TICS; i++){
+    ags_tic_barrier_arrive(tic_barrier);
+  }
+
+  return(NULL);
+}
+
+void
+ags_tic_barrier_test_arrive()
+{
+  AgsTicBarrier *tic_barrier;
+
+  GThread *thread[AGS_TIC_BARRIER_TEST_ARRIVE_N_THREADS];
+  
+  guint i;
+
+  tic_barrier = ags_tic_barrier_new();
+  ags_tic_barrier_set_trip_func(tic_barrier,
+				ags_tic_barrier_test_trip_func,
+				NULL);
+
+  g_atomic_int_set(&trip_count,
+		   0);
+
+  /* join all before any arrives */
+  for(i = 0; i < AGS_TIC_BARRIER_TEST_ARRIVE_N_THREADS; i++){
+    ags_tic_barrier_join(tic_barrier);
+  }
+
+  for(i = 0; i < AGS_TIC_BARRIER_TEST_ARRIVE_N_THREADS; i++){
+    thread[i] = g_thread_new("tic barrier test",
+			     ags_tic_barrier_test_arrive_thread,
+			     tic_barrier);
+  }
+
+  for(i = 0; i < AGS_TIC_BARRIER_TEST_ARRIVE_N_THREADS; i++){
+    g_thread_join(thread[i]);
+  }
+
+  /* assert one trip per tic */
+  CU_ASSERT(g_atomic_int_get(&trip_count) == AGS_TIC_BARRIER_TEST_ARRIVE_N_TICS);
+  CU_ASSERT(ags_tic_barrier_get_generation(tic_barrier) == AGS_TIC_BARRIER_TEST_ARRIVE_N_TICS);
+
+  g_object_unref(tic_barrier);
+}
+
+void
+ags_tic_barrier_test_leave()
+{
+  AgsTicBarrier *tic_barrier;
+
+  GThread *thread;
+  
+  tic_barrier = ags_tic_barrier_new();
+  ags_tic_barrier_set_trip_func(tic_barrier,
+				ags_tic_barrier_test_trip_func,
+				NULL);
+
+  g_atomic_int_set(&trip_count,
+		   0);
+
+  ags_tic_barrier_join(tic_barrier);
+  ags_tic_barrier_join(tic_barrier);
+
+  /* the arriving thread waits for the second participant */
+  thread = g_thread_new("tic barrier test",
+			ags_tic_barrier_test_arrive_thread,
+			tic_barrier);
+
+  while(ags_tic_barrier_get_generation(tic_barrier) == 0){
+    g_usleep(100);
+
+    /* leaving trips the barrier */
+    if(tic_barrier->n_arrived == 1){
+      ags_tic_barrier_leave(tic_barrier);
+    }
+  }
+
+  g_thread_join(thread);
+
+  CU_ASSERT(g_atomic_int_get(&trip_count) == AGS_TIC_BARRIER_TEST_ARRIVE_N_TICS);
+  CU_ASSERT(tic_barrier->n_participants == 1);
+
+  g_object_unref(tic_barrier);
+}
+
+void
+ags_tic_barrier_test_latency_histogram()
+{
+  AgsTicBarrier *tic_barrier;
+
+  guint64 latency_histogram[AGS_TIC_BARRIER_LATENCY_BUCKETS];
+  gint64 max_latency;
+  guint64 count;
+  
+  guint i;
+  
+  tic_barrier = ags_tic_barrier_new();
+  ags_tic_barrier_set_flags(tic_barrier,
+			    AGS_TIC_BARRIER_LATENCY_ACCOUNTING);
+
+  ags_tic_barrier_mark_trip(tic_barrier);
+
+  for(i = 0; i < 8; i++){
+    ags_tic_barrier_account_wakeup(tic_barrier);
+  }
+
+  ags_tic_barrier_get_latency_histogram(tic_barrier,
+					latency_histogram,
+					&max_latency);
+
+  count = 0;
+  
+  for(i = 0; i < AGS_TIC_BARRIER_LATENCY_BUCKETS; i++){
+    count += latency_histogram[i];
+  }
+  
+  CU_ASSERT(count == 8);
+  CU_ASSERT(max_latency >= 0);
+
+  /* reset */
+  ags_tic_barrier_reset_latency_histogram(tic_barrier);
+
+  ags_tic_barrier_get_latency_histogram(tic_barrier,
+					latency_histogram,
+					&max_latency);
+
+  count = 0;
+  
+  for(i = 0; i < AGS_TIC_BARRIER_LATENCY_BUCKETS; i++){
+    count += latency_histogram[i];
+  }
+  
+  CU_ASSERT(count == 0);
+  CU_ASSERT(max_latency == 0);
+
+  g_object_unref(tic_barrier);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+  
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsTicBarrierTest\0", ags_tic_barrier_test_init_suite, ags_tic_barrier_test_clean_suite);
+  
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsTicBarrier arrive\0", ags_tic_barrier_test_arrive) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTicBarrier leave\0", ags_tic_barrier_test_leave) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTicBarrier latency histogram\0", ags_tic_barrier_test_latency_histogram) == NULL)){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+  
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+  
+  CU_cleanup_registry();
+  
+  return(CU_get_error());
+}
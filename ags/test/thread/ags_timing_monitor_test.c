@@ -0,0 +1,401 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+int ags_timing_monitor_test_init_suite();
+int ags_timing_monitor_test_clean_suite();
+
+void ags_timing_monitor_test_bucket_index();
+void ags_timing_monitor_test_histogram_add();
+void ags_timing_monitor_test_histogram_percentile();
+void ags_timing_monitor_test_record();
+void ags_timing_monitor_test_remove();
+void ags_timing_monitor_test_start_stop();
+
+/* The suite initialization time.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_timing_monitor_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup time.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_timing_monitor_test_clean_suite()
+{
+  return(0);
+}
+
+void
+ags_timing_monitor_test_bucket_index()
+{
+  guint64 value;
+  guint bucket_index, previous_index;
+  gboolean success;
+
+  /* exact below sub buckets */
+  for(value = 0; value < AGS_TIMING_HISTOGRAM_SUB_BUCKETS; value++){
+    CU_ASSERT(ags_timing_histogram_bucket_index(value) == value);
+    CU_ASSERT(ags_timing_histogram_bucket_value(value) == value);
+  }
+
+  /* monotonic and lower bound of value */
+  success = TRUE;
+  previous_index = 0;
+  
+  for(value = 1; value < G_MAXUINT32; value = (value * 5) / 4 + 1){
+    bucket_index = ags_timing_histogram_bucket_index(value);
+
+    if(bucket_index < previous_index ||
+       bucket_index >= AGS_TIMING_HISTOGRAM_BUCKETS ||
+       ags_timing_histogram_bucket_value(bucket_index) > value ||
+       (bucket_index + 1 < AGS_TIMING_HISTOGRAM_BUCKETS &&
+	ags_timing_histogram_bucket_value(bucket_index + 1) <= value)){
+      success = FALSE;
+
+      break;
+    }
+
+    previous_index = bucket_index;
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  /* clamped */
+  CU_ASSERT(ags_timing_histogram_bucket_index(G_MAXUINT64) == AGS_TIMING_HISTOGRAM_BUCKETS - 1);
+}
+
+void
+ags_timing_monitor_test_histogram_add()
+{
+  AgsTimingHistogram *timing_histogram;
+
+  timing_histogram = ags_timing_histogram_alloc(NULL,
+						AGS_TIMING_MONITOR_THREAD_RUN,
+						"test");
+
+  CU_ASSERT(timing_histogram->count == 0);
+  CU_ASSERT(timing_histogram->min == G_MAXUINT32);
+  CU_ASSERT(timing_histogram->max == 0);
+
+  ags_timing_histogram_add(timing_histogram,
+			   1000);
+  ags_timing_histogram_add(timing_histogram,
+			   3000);
+  ags_timing_histogram_add(timing_histogram,
+			   2000);
+
+  CU_ASSERT(timing_histogram->count == 3);
+  CU_ASSERT(ags_timing_histogram_get_sum(timing_histogram) == 6000);
+  CU_ASSERT(timing_histogram->min == 1000);
+  CU_ASSERT(timing_histogram->max == 3000);
+  CU_ASSERT(timing_histogram->bucket[ags_timing_histogram_bucket_index(2000)] == 1);
+
+  ags_timing_histogram_reset(timing_histogram);
+
+  CU_ASSERT(timing_histogram->count == 0);
+  CU_ASSERT(ags_timing_histogram_get_sum(timing_histogram) == 0);
+
+  /* the sum carries beyond 32 bit */
+  ags_timing_histogram_add(timing_histogram,
+			   G_MAXUINT32);
+  ags_timing_histogram_add(timing_histogram,
+			   G_MAXUINT32);
+
+  CU_ASSERT(ags_timing_histogram_get_sum(timing_histogram) == 2 * (guint64) G_MAXUINT32);
+  CU_ASSERT(timing_histogram->bucket[ags_timing_histogram_bucket_index(2000)] == 0);
+  
+  ags_timing_histogram_free(timing_histogram);
+}
+
+void
+ags_timing_monitor_test_histogram_percentile()
+{
+  AgsTimingHistogram *timing_histogram;
+
+  guint64 value;
+  guint i;
+
+  timing_histogram = ags_timing_histogram_alloc(NULL,
+						AGS_TIMING_MONITOR_THREAD_RUN,
+						"test");
+
+  CU_ASSERT(ags_timing_histogram_percentile(timing_histogram, 50.0) == 0);
+
+  /* 99 fast and 1 slow sample */
+  for(i = 0; i < 99; i++){
+    ags_timing_histogram_add(timing_histogram,
+			     10000);
+  }
+
+  ags_timing_histogram_add(timing_histogram,
+			   1000000);
+
+  value = ags_timing_histogram_percentile(timing_histogram, 50.0);
+  CU_ASSERT(value <= 10000 &&
+	    value >= (10000 * 7) / 8);
+
+  value = ags_timing_histogram_percentile(timing_histogram, 99.0);
+  CU_ASSERT(value <= 10000);
+
+  value = ags_timing_histogram_percentile(timing_histogram, 100.0);
+  CU_ASSERT(value <= 1000000 &&
+	    value >= (1000000 * 7) / 8);
+  
+  ags_timing_histogram_free(timing_histogram);
+}
+
+void
+ags_timing_monitor_test_record()
+{
+  AgsTimingMonitor *timing_monitor;
+  AgsTimingHistogram *timing_histogram;
+
+  GObject *object;
+
+  gchar **summary;
+
+  timing_monitor = ags_timing_monitor_new();
+
+  object = g_object_new(G_TYPE_OBJECT,
+			NULL);
+
+  CU_ASSERT(ags_timing_monitor_find_histogram(timing_monitor, object, AGS_TIMING_MONITOR_RECALL_RUN_PRE) == NULL);
+
+  ags_timing_monitor_record(timing_monitor,
+			    object,
+			    AGS_TIMING_MONITOR_RECALL_RUN_PRE,
+			    5000);
+  ags_timing_monitor_record(timing_monitor,
+			    object,
+			    AGS_TIMING_MONITOR_RECALL_RUN_PRE,
+			    7000);
+  ags_timing_monitor_record(timing_monitor,
+			    object,
+			    AGS_TIMING_MONITOR_RECALL_RUN_POST,
+			    9000);
+
+  timing_histogram = ags_timing_monitor_find_histogram(timing_monitor, object, AGS_TIMING_MONITOR_RECALL_RUN_PRE);
+
+  CU_ASSERT(timing_histogram != NULL);
+  CU_ASSERT(timing_histogram->count == 2);
+  CU_ASSERT(g_strrstr(timing_histogram->name, "GObject") != NULL);
+  CU_ASSERT(g_strrstr(timing_histogram->name, "run-pre") != NULL);
+
+  timing_histogram = ags_timing_monitor_find_histogram(timing_monitor, object, AGS_TIMING_MONITOR_RECALL_RUN_POST);
+
+  CU_ASSERT(timing_histogram != NULL);
+  CU_ASSERT(timing_histogram->count == 1);
+  
+  /* summary */
+  summary = ags_timing_monitor_get_summary(timing_monitor);
+
+  CU_ASSERT(summary != NULL);
+  CU_ASSERT(g_strv_length(summary) == 2);
+
+  g_strfreev(summary);
+
+  /* reset keeps histograms, but skips them in summary */
+  ags_timing_monitor_reset(timing_monitor);
+
+  CU_ASSERT(ags_timing_monitor_find_histogram(timing_monitor, object, AGS_TIMING_MONITOR_RECALL_RUN_PRE) != NULL);
+
+  summary = ags_timing_monitor_get_summary(timing_monitor);
+
+  CU_ASSERT(summary != NULL);
+  CU_ASSERT(g_strv_length(summary) == 0);
+
+  g_strfreev(summary);
+
+  /* max histograms */
+  timing_monitor->max_histograms = 2;
+
+  ags_timing_monitor_record(timing_monitor,
+			    object,
+			    AGS_TIMING_MONITOR_THREAD_RUN,
+			    1000);
+
+  CU_ASSERT(ags_timing_monitor_find_histogram(timing_monitor, object, AGS_TIMING_MONITOR_THREAD_RUN) == NULL);
+
+  g_object_unref(object);
+  g_object_unref(timing_monitor);
+}
+
+void
+ags_timing_monitor_test_remove()
+{
+  AgsTimingMonitor *timing_monitor;
+  AgsTimingHistogram *timing_histogram;
+
+  GObject *object, *other_object;
+
+  timing_monitor = ags_timing_monitor_new();
+  timing_monitor->max_histograms = 1;
+
+  object = g_object_new(G_TYPE_OBJECT,
+			NULL);
+  other_object = g_object_new(G_TYPE_OBJECT,
+			      NULL);
+
+  ags_timing_monitor_record(timing_monitor,
+			    object,
+			    AGS_TIMING_MONITOR_RECALL_RUN_INTER,
+			    1000);
+
+  CU_ASSERT(timing_monitor->n_histograms == 1);
+
+  /* full */
+  ags_timing_monitor_record(timing_monitor,
+			    other_object,
+			    AGS_TIMING_MONITOR_RECALL_RUN_INTER,
+			    1000);
+
+  CU_ASSERT(ags_timing_monitor_find_histogram(timing_monitor, other_object, AGS_TIMING_MONITOR_RECALL_RUN_INTER) == NULL);
+
+  /* removing releases the slot */
+  ags_timing_monitor_remove(timing_monitor,
+			    object);
+
+  CU_ASSERT(timing_monitor->n_histograms == 0);
+  CU_ASSERT(ags_timing_monitor_find_histogram(timing_monitor, object, AGS_TIMING_MONITOR_RECALL_RUN_INTER) == NULL);
+
+  ags_timing_monitor_record(timing_monitor,
+			    other_object,
+			    AGS_TIMING_MONITOR_RECALL_RUN_INTER,
+			    2000);
+
+  timing_histogram = ags_timing_monitor_find_histogram(timing_monitor, other_object, AGS_TIMING_MONITOR_RECALL_RUN_INTER);
+
+  CU_ASSERT(timing_histogram != NULL);
+  CU_ASSERT(timing_histogram->count == 1);
+  CU_ASSERT(timing_histogram->min == 2000);
+
+  g_object_unref(object);
+  g_object_unref(other_object);
+
+  g_object_unref(timing_monitor);
+}
+
+void
+ags_timing_monitor_test_start_stop()
+{
+  AgsTimingMonitor *timing_monitor;
+  AgsTimingHistogram *timing_histogram;
+
+  GObject *object;
+
+  gint64 start_time;
+
+  timing_monitor = ags_timing_monitor_get_instance();
+
+  object = g_object_new(G_TYPE_OBJECT,
+			NULL);
+
+  /* disabled */
+  ags_timing_monitor_set_enabled(FALSE);
+
+  start_time = ags_timing_monitor_start();
+
+  CU_ASSERT(start_time == 0);
+
+  ags_timing_monitor_stop(object,
+			  AGS_TIMING_MONITOR_THREAD_RUN,
+			  start_time);
+
+  CU_ASSERT(ags_timing_monitor_find_histogram(timing_monitor, object, AGS_TIMING_MONITOR_THREAD_RUN) == NULL);
+
+  /* enabled */
+  ags_timing_monitor_set_enabled(TRUE);
+
+  CU_ASSERT(ags_timing_monitor_is_enabled() == TRUE);
+
+  start_time = ags_timing_monitor_start();
+
+  CU_ASSERT(start_time != 0);
+
+  g_usleep(1000);
+  
+  ags_timing_monitor_stop(object,
+			  AGS_TIMING_MONITOR_THREAD_RUN,
+			  start_time);
+
+  timing_histogram = ags_timing_monitor_find_histogram(timing_monitor, object, AGS_TIMING_MONITOR_THREAD_RUN);
+
+  CU_ASSERT(timing_histogram != NULL);
+  CU_ASSERT(timing_histogram->count == 1);
+  CU_ASSERT(timing_histogram->min >= 1000000);
+
+  ags_timing_monitor_set_enabled(FALSE);
+
+  g_object_unref(object);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+  
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsTimingMonitorTest\0", ags_timing_monitor_test_init_suite, ags_timing_monitor_test_clean_suite);
+  
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsTimingMonitor bucket index\0", ags_timing_monitor_test_bucket_index) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTimingMonitor histogram add\0", ags_timing_monitor_test_histogram_add) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTimingMonitor histogram percentile\0", ags_timing_monitor_test_histogram_percentile) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTimingMonitor record\0", ags_timing_monitor_test_record) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTimingMonitor remove\0", ags_timing_monitor_test_remove) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTimingMonitor start and stop\0", ags_timing_monitor_test_start_stop) == NULL)){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+  
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+  
+  CU_cleanup_registry();
+  
+  return(CU_get_error());
+}
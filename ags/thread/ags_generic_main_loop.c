@@ -20,6 +20,7 @@
 #include <ags/thread/ags_generic_main_loop.h>
 
 #include <ags/object/ags_main_loop.h>
+#include <ags/object/ags_config.h>
 
 #include <ags/i18n.h>
 
@@ -159,6 +160,10 @@ ags_generic_main_loop_init(AgsGenericMainLoop *generic_main_loop)
 {
   AgsThread *thread;
 
+  AgsConfig *config;
+
+  gchar *str;
+  
   guint i;
   
   /* calculate frequency */
@@ -166,6 +171,22 @@ ags_generic_main_loop_init(AgsGenericMainLoop *generic_main_loop)
   
   ags_thread_set_flags(thread, AGS_THREAD_TIME_ACCOUNTING);
 
+  /* synchronize the tree by tic barrier */
+  config = ags_config_get_instance();
+
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_THREAD,
+			     "tic-barrier");
+
+  if(str != NULL &&
+     !g_ascii_strncasecmp(str,
+			  "true",
+			  5)){
+    ags_thread_set_flags(thread, AGS_THREAD_TIC_BARRIER);
+  }
+
+  g_free(str);
+
   g_object_set(thread,
 	       "frequency", AGS_GENERIC_MAIN_LOOP_DEFAULT_JIFFIE,
 	       NULL);
@@ -22,11 +22,15 @@
 #include <ags/thread/ags_message_queue.h>
 #include <ags/thread/ags_message_envelope.h>
 
+#include <string.h>
+
 void ags_message_delivery_class_init(AgsMessageDeliveryClass *message_delivery);
 void ags_message_delivery_init(AgsMessageDelivery *message_delivery);
 void ags_message_delivery_dispose(GObject *gobject);
 void ags_message_delivery_finalize(GObject *gobject);
 
+void ags_message_free_object_list(GList *object_list);
+
 /**
  * SECTION:ags_message_delivery
  * @short_description: message delivery
@@ -35,6 +39,14 @@ void ags_message_delivery_finalize(GObject *gobject);
  * @include: ags/thread/ags_message_delivery.h
  *
  * The #AgsMessageDelivery acts as messages passing system.
+ *
+ * Besides the namespace based #AgsMessageQueue, recipients might subscribe
+ * an #AgsMessageSubscriber-struct to a sender. Messages posted by
+ * ags_message_delivery_post() are pushed to the subscribers of the sender
+ * only, so a recipient drains its own messages instead of scanning all
+ * queues. The #AgsMessageQueue of the message's sender namespace gets
+ * the message, too. Its #AgsMessageEnvelope is created not until the queue
+ * is queried.
  */
 
 AgsMessageDelivery *ags_message_delivery = NULL;
@@ -92,6 +104,13 @@ ags_message_delivery_init(AgsMessageDelivery *message_delivery)
   g_rec_mutex_init(&(message_delivery->obj_mutex));
 
   message_delivery->message_queue = NULL;
+
+  /* sender to subscribers */
+  g_rw_lock_init(&(message_delivery->subscription_lock));
+  
+  message_delivery->subscription = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+							 NULL,
+							 (GDestroyNotify) g_list_free);
 }
 
 void
@@ -125,6 +144,11 @@ ags_message_delivery_finalize(GObject *gobject)
     g_list_free_full(message_delivery->message_queue,
 		     g_object_unref);
   }
+
+  /* subscription */
+  g_hash_table_destroy(message_delivery->subscription);
+
+  g_rw_lock_clear(&(message_delivery->subscription_lock));
   
   /* call parent */
   G_OBJECT_CLASS(ags_message_delivery_parent_class)->finalize(gobject);
@@ -149,6 +173,7 @@ ags_message_delivery_add_message_queue(AgsMessageDelivery *message_delivery,
   }
 
   g_rec_mutex_lock(&(message_delivery->obj_mutex));
+  g_rw_lock_writer_lock(&(message_delivery->subscription_lock));
 
   if(g_list_find(message_delivery->message_queue,
 		 message_queue) == NULL){
@@ -156,7 +181,8 @@ ags_message_delivery_add_message_queue(AgsMessageDelivery *message_delivery,
     message_delivery->message_queue = g_list_prepend(message_delivery->message_queue,
 						     message_queue);
   }
-  
+
+  g_rw_lock_writer_unlock(&(message_delivery->subscription_lock));
   g_rec_mutex_unlock(&(message_delivery->obj_mutex));
 }
 
@@ -179,6 +205,7 @@ ags_message_delivery_remove_message_queue(AgsMessageDelivery *message_delivery,
   }
 
   g_rec_mutex_lock(&(message_delivery->obj_mutex));
+  g_rw_lock_writer_lock(&(message_delivery->subscription_lock));
 
   if(g_list_find(message_delivery->message_queue,
 		 message_queue) != NULL){
@@ -186,7 +213,8 @@ ags_message_delivery_remove_message_queue(AgsMessageDelivery *message_delivery,
 						    message_queue);
     g_object_unref(message_queue);
   }
-  
+
+  g_rw_lock_writer_unlock(&(message_delivery->subscription_lock));
   g_rec_mutex_unlock(&(message_delivery->obj_mutex));
 }
 
@@ -564,7 +592,7 @@ ags_message_delivery_query_message(AgsMessageDelivery *message_delivery,
   start_list = NULL;
   
   while(message_queue != NULL){
-    list = ags_message_queue_query_message(message_queue,
+    list = ags_message_queue_query_message(message_queue->data,
 					   xpath);
 
     if(list != NULL){
@@ -586,6 +614,604 @@ ags_message_delivery_query_message(AgsMessageDelivery *message_delivery,
   return(start_list);
 }
 
+/**
+ * ags_message_alloc:
+ * @sender: the sender #GObject
+ * @method: the method as static string
+ * @n_values: the value count, at most %AGS_MESSAGE_MAX_VALUES
+ *
+ * Allocate #AgsMessage-struct. @method is interned.
+ *
+ * Returns: (transfer full): the new #AgsMessage-struct
+ *
+ * Since: 3.5.0
+ */
+AgsMessage*
+ags_message_alloc(GObject *sender,
+		  const gchar *method,
+		  guint n_values)
+{
+  AgsMessage *message;
+
+  message = (AgsMessage *) g_malloc0(sizeof(AgsMessage));
+
+  message->next = NULL;
+
+  if(sender != NULL){
+    g_object_ref(sender);
+  }
+  
+  message->sender = sender;
+  message->method = g_intern_static_string(method);
+  message->sender_namespace = NULL;
+  
+  message->n_values = MIN(n_values, AGS_MESSAGE_MAX_VALUES);
+
+  return(message);
+}
+
+/**
+ * ags_message_copy:
+ * @message: the #AgsMessage-struct
+ *
+ * Copy @message, the next field is not copied. Owned object lists are
+ * copied deep.
+ *
+ * Returns: (transfer full): the new #AgsMessage-struct
+ *
+ * Since: 3.5.0
+ */
+AgsMessage*
+ags_message_copy(AgsMessage *message)
+{
+  AgsMessage *copy;
+
+  guint i;
+
+  if(message == NULL){
+    return(NULL);
+  }
+  
+  copy = (AgsMessage *) g_malloc(sizeof(AgsMessage));
+
+  memcpy(copy, message, sizeof(AgsMessage));
+
+  copy->next = NULL;
+
+  if(copy->sender != NULL){
+    g_object_ref(copy->sender);
+  }
+
+  for(i = 0; i < copy->n_values; i++){
+    if((AGS_MESSAGE_VALUE_OBJECT_LIST & (copy->value_flags[i])) != 0){
+      copy->value[i].pointer_value = g_list_copy_deep(message->value[i].pointer_value,
+						      (GCopyFunc) g_object_ref,
+						      NULL);
+    }
+  }
+  
+  return(copy);
+}
+
+/**
+ * ags_message_free:
+ * @message: the #AgsMessage-struct
+ *
+ * Free @message.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_message_free(AgsMessage *message)
+{
+  guint i;
+  
+  if(message == NULL){
+    return;
+  }
+
+  if(message->sender != NULL){
+    g_object_unref(message->sender);
+  }
+
+  for(i = 0; i < message->n_values; i++){
+    if((AGS_MESSAGE_VALUE_OBJECT_LIST & (message->value_flags[i])) != 0){
+      ags_message_free_object_list(message->value[i].pointer_value);
+    }
+  }
+
+  g_free(message);
+}
+
+/**
+ * ags_message_free_all:
+ * @message: the first #AgsMessage-struct
+ *
+ * Free @message and all messages following it.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_message_free_all(AgsMessage *message)
+{
+  AgsMessage *next;
+
+  while(message != NULL){
+    next = message->next;
+
+    ags_message_free(message);
+
+    message = next;
+  }
+}
+
+void
+ags_message_free_object_list(GList *object_list)
+{
+  g_list_free_full(object_list,
+		   g_object_unref);
+}
+
+/**
+ * ags_message_set_object_list:
+ * @message: the #AgsMessage-struct
+ * @nth: the nth value
+ * @parameter_name: the static parameter name
+ * @object_list: (element-type GObject) (transfer none): the #GList-struct containing #GObject
+ *
+ * Set the @nth value of @message to a copy of @object_list, the objects
+ * are referenced as long as @message or its #AgsMessageEnvelope lives.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_message_set_object_list(AgsMessage *message,
+			    guint nth,
+			    const gchar *parameter_name,
+			    GList *object_list)
+{
+  if(message == NULL ||
+     nth >= message->n_values){
+    return;
+  }
+
+  if((AGS_MESSAGE_VALUE_OBJECT_LIST & (message->value_flags[nth])) != 0){
+    ags_message_free_object_list(message->value[nth].pointer_value);
+  }
+  
+  message->parameter_name[nth] = parameter_name;
+  message->value_type[nth] = G_TYPE_POINTER;
+  message->value_flags[nth] = AGS_MESSAGE_VALUE_OBJECT_LIST;
+  
+  message->value[nth].pointer_value = g_list_copy_deep(object_list,
+						       (GCopyFunc) g_object_ref,
+						       NULL);
+}
+
+/**
+ * ags_message_create_envelope:
+ * @message: the #AgsMessage-struct
+ *
+ * Create the #AgsMessageEnvelope of @message, containing the ags-command
+ * XML of the method and the parameters of the values.
+ *
+ * Returns: (transfer full): the new #AgsMessageEnvelope
+ *
+ * Since: 3.5.0
+ */
+GObject*
+ags_message_create_envelope(AgsMessage *message)
+{
+  AgsMessageEnvelope *message_envelope;
+
+  xmlDoc *doc;
+  xmlNode *root_node;
+
+  guint i;
+  
+  if(message == NULL){
+    return(NULL);
+  }
+  
+  /* specify message body */
+  doc = xmlNewDoc("1.0");
+
+  root_node = xmlNewNode(NULL,
+			 "ags-command");
+  xmlDocSetRootElement(doc, root_node);    
+
+  xmlNewProp(root_node,
+	     "method",
+	     message->method);
+
+  message_envelope = ags_message_envelope_new(message->sender,
+					      NULL,
+					      doc);
+
+  /* set parameter */
+  message_envelope->n_params = message->n_values;
+
+  message_envelope->parameter_name = (gchar **) g_malloc((message->n_values + 1) * sizeof(gchar *));
+  message_envelope->value = g_new0(GValue,
+				   message->n_values);
+  message_envelope->free_func = g_new0(GDestroyNotify,
+				       message->n_values);
+
+  for(i = 0; i < message->n_values; i++){
+    message_envelope->parameter_name[i] = g_strdup(message->parameter_name[i]);
+
+    g_value_init(&(message_envelope->value[i]),
+		 message->value_type[i]);
+
+    switch(G_TYPE_FUNDAMENTAL(message->value_type[i])){
+    case G_TYPE_BOOLEAN:
+      {
+	g_value_set_boolean(&(message_envelope->value[i]),
+			    (gboolean) message->value[i].int_value);
+      }
+      break;
+    case G_TYPE_INT:
+      {
+	g_value_set_int(&(message_envelope->value[i]),
+			(gint) message->value[i].int_value);
+      }
+      break;
+    case G_TYPE_UINT:
+      {
+	g_value_set_uint(&(message_envelope->value[i]),
+			 (guint) message->value[i].uint_value);
+      }
+      break;
+    case G_TYPE_LONG:
+      {
+	g_value_set_long(&(message_envelope->value[i]),
+			 (glong) message->value[i].int_value);
+      }
+      break;
+    case G_TYPE_ULONG:
+      {
+	g_value_set_ulong(&(message_envelope->value[i]),
+			  (gulong) message->value[i].uint_value);
+      }
+      break;
+    case G_TYPE_INT64:
+      {
+	g_value_set_int64(&(message_envelope->value[i]),
+			  message->value[i].int_value);
+      }
+      break;
+    case G_TYPE_UINT64:
+      {
+	g_value_set_uint64(&(message_envelope->value[i]),
+			   message->value[i].uint_value);
+      }
+      break;
+    case G_TYPE_DOUBLE:
+      {
+	g_value_set_double(&(message_envelope->value[i]),
+			   message->value[i].double_value);
+      }
+      break;
+    case G_TYPE_OBJECT:
+      {
+	g_value_set_object(&(message_envelope->value[i]),
+			   message->value[i].pointer_value);
+      }
+      break;
+    case G_TYPE_POINTER:
+      {
+	if((AGS_MESSAGE_VALUE_OBJECT_LIST & (message->value_flags[i])) != 0){
+	  /* the envelope owns its own copy */
+	  g_value_set_pointer(&(message_envelope->value[i]),
+			      g_list_copy_deep(message->value[i].pointer_value,
+					       (GCopyFunc) g_object_ref,
+					       NULL));
+
+	  message_envelope->free_func[i] = (GDestroyNotify) ags_message_free_object_list;
+	}else{
+	  g_value_set_pointer(&(message_envelope->value[i]),
+			      message->value[i].pointer_value);
+	}
+      }
+      break;
+    }
+  }
+
+  /* terminate string vector */
+  message_envelope->parameter_name[message->n_values] = NULL;
+
+  return((GObject *) message_envelope);
+}
+
+/**
+ * ags_message_subscriber_alloc:
+ * @recipient: the recipient #GObject
+ *
+ * Allocate #AgsMessageSubscriber-struct.
+ *
+ * Returns: (transfer full): the new #AgsMessageSubscriber-struct
+ *
+ * Since: 3.5.0
+ */
+AgsMessageSubscriber*
+ags_message_subscriber_alloc(GObject *recipient)
+{
+  AgsMessageSubscriber *message_subscriber;
+
+  message_subscriber = (AgsMessageSubscriber *) g_malloc(sizeof(AgsMessageSubscriber));
+
+  message_subscriber->recipient = recipient;
+  message_subscriber->head = NULL;
+
+  return(message_subscriber);
+}
+
+/**
+ * ags_message_subscriber_free:
+ * @message_subscriber: the #AgsMessageSubscriber-struct
+ *
+ * Free @message_subscriber and all its pending messages. Be sure it is
+ * unsubscribed from any sender.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_message_subscriber_free(AgsMessageSubscriber *message_subscriber)
+{
+  if(message_subscriber == NULL){
+    return;
+  }
+
+  ags_message_free_all(ags_message_subscriber_drain(message_subscriber));
+  
+  g_free(message_subscriber);
+}
+
+/**
+ * ags_message_subscriber_push:
+ * @message_subscriber: the #AgsMessageSubscriber-struct
+ * @message: (transfer full): the #AgsMessage-struct
+ *
+ * Push @message to @message_subscriber without locking.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_message_subscriber_push(AgsMessageSubscriber *message_subscriber,
+			    AgsMessage *message)
+{
+  gpointer head;
+  
+  if(message_subscriber == NULL ||
+     message == NULL){
+    return;
+  }
+
+  do{
+    head = g_atomic_pointer_get(&(message_subscriber->head));
+
+    message->next = head;
+  }while(!g_atomic_pointer_compare_and_exchange(&(message_subscriber->head),
+						head,
+						message));
+}
+
+/**
+ * ags_message_subscriber_drain:
+ * @message_subscriber: the #AgsMessageSubscriber-struct
+ *
+ * Take all pending messages of @message_subscriber at once. Iterate them
+ * using the next field and free them by ags_message_free_all().
+ *
+ * Returns: (transfer full): the first #AgsMessage-struct in post order or %NULL
+ *
+ * Since: 3.5.0
+ */
+AgsMessage*
+ags_message_subscriber_drain(AgsMessageSubscriber *message_subscriber)
+{
+  AgsMessage *message, *next, *prev;
+  
+  gpointer head;
+
+  if(message_subscriber == NULL){
+    return(NULL);
+  }
+
+  /* detach - cheap if nothing is pending */
+  do{
+    head = g_atomic_pointer_get(&(message_subscriber->head));
+
+    if(head == NULL){
+      return(NULL);
+    }
+  }while(!g_atomic_pointer_compare_and_exchange(&(message_subscriber->head),
+						head,
+						NULL));
+
+  /* reverse to post order */
+  message = head;
+  prev = NULL;
+  
+  while(message != NULL){
+    next = message->next;
+
+    message->next = prev;
+    prev = message;
+
+    message = next;
+  }
+
+  return(prev);
+}
+
+/**
+ * ags_message_delivery_subscribe:
+ * @message_delivery: the #AgsMessageDelivery
+ * @sender: the sender #GObject
+ * @message_subscriber: the #AgsMessageSubscriber-struct
+ *
+ * Subscribe @message_subscriber to messages posted by @sender. The
+ * subscription has to be removed by ags_message_delivery_unsubscribe()
+ * before @sender or @message_subscriber is freed.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_message_delivery_subscribe(AgsMessageDelivery *message_delivery,
+			       GObject *sender,
+			       AgsMessageSubscriber *message_subscriber)
+{
+  GList *subscriber;
+  
+  if(!AGS_IS_MESSAGE_DELIVERY(message_delivery) ||
+     sender == NULL ||
+     message_subscriber == NULL){
+    return;
+  }
+
+  g_rw_lock_writer_lock(&(message_delivery->subscription_lock));
+
+  subscriber = g_hash_table_lookup(message_delivery->subscription,
+				   sender);
+
+  if(g_list_find(subscriber,
+		 message_subscriber) == NULL){
+    g_hash_table_steal(message_delivery->subscription,
+		       sender);
+
+    subscriber = g_list_prepend(subscriber,
+				message_subscriber);
+    
+    g_hash_table_insert(message_delivery->subscription,
+			sender,
+			subscriber);
+  }
+  
+  g_rw_lock_writer_unlock(&(message_delivery->subscription_lock));
+}
+
+/**
+ * ags_message_delivery_unsubscribe:
+ * @message_delivery: the #AgsMessageDelivery
+ * @sender: (nullable): the sender #GObject or %NULL to unsubscribe from all senders
+ * @message_subscriber: the #AgsMessageSubscriber-struct
+ *
+ * Unsubscribe @message_subscriber from messages posted by @sender. As this
+ * function returns no further message is pushed to @message_subscriber.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_message_delivery_unsubscribe(AgsMessageDelivery *message_delivery,
+				 GObject *sender,
+				 AgsMessageSubscriber *message_subscriber)
+{
+  GList *start_sender, *current_sender;
+  GList *subscriber;
+  
+  if(!AGS_IS_MESSAGE_DELIVERY(message_delivery) ||
+     message_subscriber == NULL){
+    return;
+  }
+
+  g_rw_lock_writer_lock(&(message_delivery->subscription_lock));
+
+  if(sender != NULL){
+    current_sender =
+      start_sender = g_list_prepend(NULL,
+				    sender);
+  }else{
+    current_sender =
+      start_sender = g_hash_table_get_keys(message_delivery->subscription);
+  }
+  
+  while(current_sender != NULL){
+    subscriber = g_hash_table_lookup(message_delivery->subscription,
+				     current_sender->data);
+
+    if(g_list_find(subscriber,
+		   message_subscriber) != NULL){
+      g_hash_table_steal(message_delivery->subscription,
+			 current_sender->data);
+
+      subscriber = g_list_remove(subscriber,
+				 message_subscriber);
+
+      if(subscriber != NULL){
+	g_hash_table_insert(message_delivery->subscription,
+			    current_sender->data,
+			    subscriber);
+      }
+    }
+
+    current_sender = current_sender->next;
+  }
+
+  g_rw_lock_writer_unlock(&(message_delivery->subscription_lock));
+
+  g_list_free(start_sender);
+}
+
+/**
+ * ags_message_delivery_post:
+ * @message_delivery: the #AgsMessageDelivery
+ * @message: (transfer full): the #AgsMessage-struct
+ *
+ * Post @message to all subscribers of its sender and to the
+ * #AgsMessageQueue matching its sender namespace. Every recipient gets its
+ * own copy. Posting only takes the subscription lock for reading, so
+ * concurrent posts don't wait for each other.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_message_delivery_post(AgsMessageDelivery *message_delivery,
+			  AgsMessage *message)
+{
+  GList *subscriber;
+  GList *message_queue;
+  
+  if(!AGS_IS_MESSAGE_DELIVERY(message_delivery) ||
+     message == NULL){
+    ags_message_free(message);
+    
+    return;
+  }
+
+  g_rw_lock_reader_lock(&(message_delivery->subscription_lock));
+
+  /* subscribers */
+  subscriber = g_hash_table_lookup(message_delivery->subscription,
+				   message->sender);
+  
+  while(subscriber != NULL){
+    ags_message_subscriber_push(subscriber->data,
+				ags_message_copy(message));
+
+    subscriber = subscriber->next;
+  }
+
+  /* message queue - the envelope is created as queried */
+  if(message->sender_namespace != NULL){
+    message_queue = message_delivery->message_queue;
+
+    while(message_queue != NULL){
+      if(!g_strcmp0(message->sender_namespace,
+		    AGS_MESSAGE_QUEUE(message_queue->data)->sender_namespace)){
+	ags_message_queue_push_message(message_queue->data,
+				       ags_message_copy(message));
+      }
+      
+      message_queue = message_queue->next;
+    }
+  }
+  
+  g_rw_lock_reader_unlock(&(message_delivery->subscription_lock));
+
+  ags_message_free(message);
+}
+
 /**
  * ags_message_delivery_get_instance:
  *
@@ -36,8 +36,15 @@ G_BEGIN_DECLS
 
 #define AGS_MESSAGE_DELIVERY_GET_OBJ_MUTEX(obj) (&(((AgsMessageDelivery *) obj)->obj_mutex))
 
+#define AGS_MESSAGE(ptr) ((AgsMessage *) (ptr))
+#define AGS_MESSAGE_SUBSCRIBER(ptr) ((AgsMessageSubscriber *) (ptr))
+
+#define AGS_MESSAGE_MAX_VALUES (4)
+
 typedef struct _AgsMessageDelivery AgsMessageDelivery;
 typedef struct _AgsMessageDeliveryClass AgsMessageDeliveryClass;
+typedef struct _AgsMessage AgsMessage;
+typedef struct _AgsMessageSubscriber AgsMessageSubscriber;
 
 struct _AgsMessageDelivery
 {
@@ -46,6 +53,84 @@ struct _AgsMessageDelivery
   GRecMutex obj_mutex;
 
   GList *message_queue;
+
+  GRWLock subscription_lock;
+  GHashTable *subscription;
+};
+
+/**
+ * AgsMessageValueFlags:
+ * @AGS_MESSAGE_VALUE_OBJECT_LIST: the pointer value is a #GList-struct of #GObject owned by the message
+ *
+ * Enum values to specify the ownership of an #AgsMessageValue.
+ */
+typedef enum{
+  AGS_MESSAGE_VALUE_OBJECT_LIST     = 1,
+}AgsMessageValueFlags;
+
+/**
+ * AgsMessageValue:
+ * @int_value: signed integer value
+ * @uint_value: unsigned integer value
+ * @double_value: floating point value
+ * @pointer_value: pointer value, owned by the message only if %AGS_MESSAGE_VALUE_OBJECT_LIST is set
+ *
+ * The untagged value of an #AgsMessage-struct, the method implies its type.
+ */
+typedef union{
+  gint64 int_value;
+  guint64 uint_value;
+  gdouble double_value;
+  gpointer pointer_value;
+}AgsMessageValue;
+
+/**
+ * AgsMessage:
+ * @next: the next message in queue
+ * @sender: the sender #GObject
+ * @method: the interned method string
+ * @sender_namespace: the static sender namespace of #AgsMessageQueue to post to or %NULL
+ * @n_values: the value count
+ * @parameter_name: the static parameter names
+ * @value_type: the #GType of the values
+ * @value_flags: the #AgsMessageValueFlags-enum of the values
+ * @value: the #AgsMessageValue array
+ *
+ * The lightweight message posted to subscribers, it doesn't carry any
+ * XML. @method is interned by g_intern_static_string() so it can be
+ * compared by pointer. An #AgsMessageEnvelope is created only as an
+ * #AgsMessageQueue of @sender_namespace is queried.
+ */
+struct _AgsMessage
+{
+  AgsMessage *next;
+  
+  GObject *sender;
+  const gchar *method;
+  const gchar *sender_namespace;
+
+  guint n_values;
+
+  const gchar *parameter_name[AGS_MESSAGE_MAX_VALUES];
+  GType value_type[AGS_MESSAGE_MAX_VALUES];
+  guint value_flags[AGS_MESSAGE_MAX_VALUES];
+  
+  AgsMessageValue value[AGS_MESSAGE_MAX_VALUES];
+};
+
+/**
+ * AgsMessageSubscriber:
+ * @recipient: the recipient #GObject, not referenced
+ * @head: the most recently pushed #AgsMessage-struct
+ *
+ * The per recipient message queue. It is lock-free, any thread might push
+ * and the recipient drains all pending messages at once.
+ */
+struct _AgsMessageSubscriber
+{
+  GObject *recipient;
+
+  volatile gpointer head;
 };
 
 struct _AgsMessageDeliveryClass
@@ -83,6 +168,37 @@ GList* ags_message_delivery_query_message(AgsMessageDelivery *message_delivery,
 					  gchar *recipient_namespace,
 					  gchar *xpath);
 
+AgsMessage* ags_message_alloc(GObject *sender,
+			      const gchar *method,
+			      guint n_values);
+AgsMessage* ags_message_copy(AgsMessage *message);
+void ags_message_free(AgsMessage *message);
+void ags_message_free_all(AgsMessage *message);
+
+void ags_message_set_object_list(AgsMessage *message,
+				 guint nth,
+				 const gchar *parameter_name,
+				 GList *object_list);
+
+GObject* ags_message_create_envelope(AgsMessage *message);
+
+AgsMessageSubscriber* ags_message_subscriber_alloc(GObject *recipient);
+void ags_message_subscriber_free(AgsMessageSubscriber *message_subscriber);
+
+void ags_message_subscriber_push(AgsMessageSubscriber *message_subscriber,
+				 AgsMessage *message);
+AgsMessage* ags_message_subscriber_drain(AgsMessageSubscriber *message_subscriber);
+
+void ags_message_delivery_subscribe(AgsMessageDelivery *message_delivery,
+				    GObject *sender,
+				    AgsMessageSubscriber *message_subscriber);
+void ags_message_delivery_unsubscribe(AgsMessageDelivery *message_delivery,
+				      GObject *sender,
+				      AgsMessageSubscriber *message_subscriber);
+
+void ags_message_delivery_post(AgsMessageDelivery *message_delivery,
+			       AgsMessage *message);
+
 AgsMessageDelivery* ags_message_delivery_get_instance();
 
 AgsMessageDelivery* ags_message_delivery_new();
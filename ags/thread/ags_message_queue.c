@@ -150,6 +150,8 @@ ags_message_queue_init(AgsMessageQueue *message_queue)
   message_queue->recipient_namespace = NULL;
 
   message_queue->message_envelope = NULL;
+
+  message_queue->pending_message = ags_message_subscriber_alloc((GObject *) message_queue);
 }
 
 void
@@ -289,6 +291,8 @@ ags_message_queue_finalize(GObject *gobject)
   g_free(message_queue->sender_namespace);
   g_free(message_queue->recipient_namespace);
 
+  ags_message_subscriber_free(message_queue->pending_message);
+
   /* message */
   if(message_queue->message_envelope != NULL){
     g_list_free_full(message_queue->message_envelope,
@@ -357,6 +361,87 @@ ags_message_queue_remove_message_envelope(AgsMessageQueue *message_queue,
   g_rec_mutex_unlock(&(message_queue->obj_mutex));
 }
 
+/**
+ * ags_message_queue_push_message:
+ * @message_queue: the #AgsMessageQueue
+ * @message: (transfer full): the #AgsMessage-struct
+ * 
+ * Push @message to @message_queue without locking. Its #AgsMessageEnvelope
+ * is created by ags_message_queue_flush_message().
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_message_queue_push_message(AgsMessageQueue *message_queue,
+			       AgsMessage *message)
+{
+  if(!AGS_IS_MESSAGE_QUEUE(message_queue) ||
+     message == NULL){
+    ags_message_free(message);
+    
+    return;
+  }
+
+  ags_message_subscriber_push(message_queue->pending_message,
+			      message);
+}
+
+/**
+ * ags_message_queue_flush_message:
+ * @message_queue: the #AgsMessageQueue
+ * 
+ * Create the #AgsMessageEnvelope of all pending messages of @message_queue
+ * and add them. The find and query functions do it before they look up
+ * the envelopes.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_message_queue_flush_message(AgsMessageQueue *message_queue)
+{
+  AgsMessage *start_message, *message;
+
+  GObject *message_envelope;
+  
+  if(!AGS_IS_MESSAGE_QUEUE(message_queue)){
+    return;
+  }
+
+  message =
+    start_message = ags_message_subscriber_drain(message_queue->pending_message);
+
+  while(message != NULL){
+    message_envelope = ags_message_create_envelope(message);
+
+    ags_message_queue_add_message_envelope(message_queue,
+					   message_envelope);
+    g_object_unref(message_envelope);
+    
+    message = message->next;
+  }
+
+  ags_message_free_all(start_message);
+}
+
+/**
+ * ags_message_queue_discard_message:
+ * @message_queue: the #AgsMessageQueue
+ * 
+ * Free all pending messages of @message_queue without creating their
+ * #AgsMessageEnvelope.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_message_queue_discard_message(AgsMessageQueue *message_queue)
+{
+  if(!AGS_IS_MESSAGE_QUEUE(message_queue)){
+    return;
+  }
+
+  ags_message_free_all(ags_message_subscriber_drain(message_queue->pending_message));
+}
+
 /**
  * ags_message_queue_find_sender:
  * @message_queue: the #AgsMessageQueue
@@ -378,6 +463,8 @@ ags_message_queue_find_sender(AgsMessageQueue *message_queue,
   if(!AGS_IS_MESSAGE_QUEUE(message_queue)){
     return(NULL);
   }
+
+  ags_message_queue_flush_message(message_queue);
   
   g_rec_mutex_lock(&(message_queue->obj_mutex));
  
@@ -436,6 +523,8 @@ ags_message_queue_find_recipient(AgsMessageQueue *message_queue,
     return(NULL);
   }
 
+  ags_message_queue_flush_message(message_queue);
+
   match = NULL;
 
   g_rec_mutex_lock(&(message_queue->obj_mutex));
@@ -493,6 +582,8 @@ ags_message_queue_query_message(AgsMessageQueue *message_queue,
     return(NULL);
   }
 
+  ags_message_queue_flush_message(message_queue);
+
   match = NULL;
 
   g_rec_mutex_lock(&(message_queue->obj_mutex));
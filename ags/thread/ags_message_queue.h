@@ -25,6 +25,8 @@
 
 #include <libxml/tree.h>
 
+#include <ags/thread/ags_message_delivery.h>
+
 G_BEGIN_DECLS
 
 #define AGS_TYPE_MESSAGE_QUEUE                (ags_message_queue_get_type())
@@ -49,6 +51,8 @@ struct _AgsMessageQueue
   gchar *recipient_namespace;
   
   GList *message_envelope;
+
+  AgsMessageSubscriber *pending_message;
 };
 
 struct _AgsMessageQueueClass
@@ -63,6 +67,11 @@ void ags_message_queue_add_message_envelope(AgsMessageQueue *message_queue,
 void ags_message_queue_remove_message_envelope(AgsMessageQueue *message_queue,
 					       GObject *message_envelope);
 
+void ags_message_queue_push_message(AgsMessageQueue *message_queue,
+				    AgsMessage *message);
+void ags_message_queue_flush_message(AgsMessageQueue *message_queue);
+void ags_message_queue_discard_message(AgsMessageQueue *message_queue);
+
 GList* ags_message_queue_find_sender(AgsMessageQueue *message_queue,
 				     GObject *sender);
 GList* ags_message_queue_find_recipient(AgsMessageQueue *message_queue,
@@ -1,5 +1,5 @@
 /* GSequencer - Advanced GTK Sequencer
- * Copyright (C) 2005-2019 Joël Krähemann
+ * Copyright (C) 2005-2020 Joël Krähemann
  *
  * This file is part of GSequencer.
  *
@@ -21,6 +21,8 @@
 
 #include <ags/object/ags_connectable.h>
 
+#include <stdlib.h>
+
 #include <ags/i18n.h>
 
 void ags_task_launcher_class_init(AgsTaskLauncherClass *task_launcher);
@@ -50,6 +52,14 @@ gboolean ags_task_launcher_is_connected(AgsConnectable *connectable);
 void ags_task_launcher_connect(AgsConnectable *connectable);
 void ags_task_launcher_disconnect(AgsConnectable *connectable);
 
+void ags_task_launcher_push(AgsTaskLauncher *task_launcher,
+			    AgsTaskLauncherItem *item);
+AgsTaskLauncherItem* ags_task_launcher_pop_all(AgsTaskLauncher *task_launcher);
+
+guint ags_task_launcher_item_coalesce_hash(gconstpointer ptr);
+gboolean ags_task_launcher_item_coalesce_equal(gconstpointer a,
+					       gconstpointer b);
+
 void ags_task_launcher_real_run(AgsTaskLauncher *task_launcher);
 
 gboolean ags_task_launcher_source_func(AgsTaskLauncher *task_launcher);
@@ -62,6 +72,11 @@ gboolean ags_task_launcher_source_func(AgsTaskLauncher *task_launcher);
  * @include: ags/thread/ags_task_launcher.h
  *
  * The #AgsTaskLauncher acts as task launcher.
+ *
+ * Tasks are queued lock-free by any thread and launched in order of
+ * arrival by ags_task_launcher_run(). Tasks added with a coalesce target
+ * supersede older queued tasks of the same kind and target, so only the
+ * latest is launched.
  */
 
 enum{
@@ -226,7 +241,8 @@ ags_task_launcher_init(AgsTaskLauncher *task_launcher)
 
   task_launcher->main_context = NULL;
 
-  task_launcher->task = NULL;
+  task_launcher->queue = NULL;
+
   task_launcher->cyclic_task = NULL;
 
   /* wait */
@@ -299,13 +315,29 @@ ags_task_launcher_get_property(GObject *gobject,
   switch(prop_id){
   case PROP_TASK:
   {
+    AgsTaskLauncherItem *item;
+
+    GList *start_task;
+
+    start_task = NULL;
+
+    /* producers only prepend, items below the head are released with the mutex held */
     g_rec_mutex_lock(task_launcher_mutex);
 
-    g_value_set_pointer(value, g_list_copy_deep(task_launcher->task,
-						(GCopyFunc) g_object_ref,
-						NULL));
+    item = g_atomic_pointer_get(&(task_launcher->queue));
+
+    while(item != NULL){
+      if(item->task != NULL){
+	start_task = g_list_prepend(start_task,
+				    g_object_ref(item->task));
+      }
+
+      item = item->next;
+    }
 
     g_rec_mutex_unlock(task_launcher_mutex);
+
+    g_value_set_pointer(value, start_task);
   }
   break;
   case PROP_CYCLIC_TASK:
@@ -330,6 +362,8 @@ ags_task_launcher_dispose(GObject *gobject)
 {
   AgsTaskLauncher *task_launcher;
 
+  AgsTaskLauncherItem *item, *next;
+
   task_launcher = AGS_TASK_LAUNCHER(gobject);
 
   if(task_launcher->main_context != NULL){
@@ -338,11 +372,14 @@ ags_task_launcher_dispose(GObject *gobject)
     task_launcher->main_context = NULL;
   }
   
-  if(task_launcher->task != NULL){
-    g_list_free_full(task_launcher->task,
-		     g_object_unref);
-    
-    task_launcher->task = NULL;
+  item = ags_task_launcher_pop_all(task_launcher);
+
+  while(item != NULL){
+    next = item->next;
+
+    ags_task_launcher_item_free(item);
+
+    item = next;
   }
   
   if(task_launcher->cyclic_task != NULL){
@@ -361,6 +398,8 @@ ags_task_launcher_finalize(GObject *gobject)
 {
   AgsTaskLauncher *task_launcher;
 
+  AgsTaskLauncherItem *item, *next;
+
   task_launcher = AGS_TASK_LAUNCHER(gobject);
   
   /* UUID */
@@ -370,8 +409,15 @@ ags_task_launcher_finalize(GObject *gobject)
     g_main_context_unref(task_launcher->main_context);
   }
 
-  g_list_free_full(task_launcher->task,
-		   g_object_unref);
+  item = g_atomic_pointer_get(&(task_launcher->queue));
+
+  while(item != NULL){
+    next = item->next;
+
+    ags_task_launcher_item_free(item);
+
+    item = next;
+  }
 
   g_list_free_full(task_launcher->cyclic_task,
 		   g_object_unref);
@@ -523,6 +569,104 @@ ags_task_launcher_disconnect(AgsConnectable *connectable)
   ags_task_launcher_unset_flags(task_launcher, AGS_TASK_LAUNCHER_CONNECTED);
 }
 
+/**
+ * ags_task_launcher_item_alloc:
+ * @task: the #AgsTask or %NULL
+ * @func: the #AgsTaskLauncherFunc or %NULL
+ * @data: the data passed to @func
+ * @destroy: the #GDestroyNotify of @data or %NULL
+ * @coalesce_target: the target to coalesce or %NULL
+ *
+ * Allocate #AgsTaskLauncherItem-struct, the kind to coalesce is taken
+ * from the #GType of @task or @func. A reference of @task is taken.
+ *
+ * Returns: the new #AgsTaskLauncherItem-struct
+ *
+ * Since: 3.5.0
+ */
+AgsTaskLauncherItem*
+ags_task_launcher_item_alloc(AgsTask *task,
+			     AgsTaskLauncherFunc func,
+			     gpointer data,
+			     GDestroyNotify destroy,
+			     gpointer coalesce_target)
+{
+  AgsTaskLauncherItem *item;
+
+  item = (AgsTaskLauncherItem *) malloc(sizeof(AgsTaskLauncherItem));
+
+  item->next = NULL;
+
+  item->task = task;
+
+  if(task != NULL){
+    g_object_ref(task);
+  }
+
+  item->func = func;
+  item->data = data;
+  item->destroy = destroy;
+
+  if(task != NULL){
+    item->coalesce_kind = GSIZE_TO_POINTER(G_OBJECT_TYPE(task));
+  }else{
+    item->coalesce_kind = (gpointer) func;
+  }
+
+  item->coalesce_target = coalesce_target;
+
+  return(item);
+}
+
+/**
+ * ags_task_launcher_item_free:
+ * @item: the #AgsTaskLauncherItem-struct
+ *
+ * Free @item, unref its task and destroy its data.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_task_launcher_item_free(AgsTaskLauncherItem *item)
+{
+  if(item == NULL){
+    return;
+  }
+
+  if(item->task != NULL){
+    g_object_unref(item->task);
+  }
+
+  if(item->destroy != NULL){
+    item->destroy(item->data);
+  }
+
+  free(item);
+}
+
+guint
+ags_task_launcher_item_coalesce_hash(gconstpointer ptr)
+{
+  AgsTaskLauncherItem *item;
+
+  item = (AgsTaskLauncherItem *) ptr;
+
+  return((31 * g_direct_hash(item->coalesce_kind)) ^ g_direct_hash(item->coalesce_target));
+}
+
+gboolean
+ags_task_launcher_item_coalesce_equal(gconstpointer a,
+				      gconstpointer b)
+{
+  AgsTaskLauncherItem *item_a, *item_b;
+
+  item_a = (AgsTaskLauncherItem *) a;
+  item_b = (AgsTaskLauncherItem *) b;
+
+  return((item_a->coalesce_kind == item_b->coalesce_kind &&
+	  item_a->coalesce_target == item_b->coalesce_target) ? TRUE: FALSE);
+}
+
 /**
  * ags_task_launcher_test_flags:
  * @task_launcher: the #AgsTaskLauncher
@@ -664,23 +808,17 @@ void
 ags_task_launcher_add_task(AgsTaskLauncher *task_launcher,
 			   AgsTask *task)
 {
-  GRecMutex *task_launcher_mutex;
-
   if(!AGS_IS_TASK_LAUNCHER(task_launcher) ||
      !AGS_IS_TASK(task)){
     return;
   }
 
-  /* get task launcher mutex */
-  task_launcher_mutex = AGS_TASK_LAUNCHER_GET_OBJ_MUTEX(task_launcher);
-
-  g_rec_mutex_lock(task_launcher_mutex);
-
-  task_launcher->task = g_list_prepend(task_launcher->task,
-				       task);
-  g_object_ref(task);
-  
-  g_rec_mutex_unlock(task_launcher_mutex);
+  ags_task_launcher_push(task_launcher,
+			 ags_task_launcher_item_alloc(task,
+						      NULL,
+						      NULL,
+						      NULL,
+						      NULL));
 }
 
 /**
@@ -696,30 +834,91 @@ void
 ags_task_launcher_add_task_all(AgsTaskLauncher *task_launcher,
 			       GList *list)
 {
-  GRecMutex *task_launcher_mutex;
-
   if(!AGS_IS_TASK_LAUNCHER(task_launcher) ||
      list == NULL){
     return;
   }
 
-  /* get task launcher mutex */
-  task_launcher_mutex = AGS_TASK_LAUNCHER_GET_OBJ_MUTEX(task_launcher);
+  while(list != NULL){
+    if(AGS_IS_TASK(list->data)){
+      ags_task_launcher_push(task_launcher,
+			     ags_task_launcher_item_alloc(list->data,
+							  NULL,
+							  NULL,
+							  NULL,
+							  NULL));
+    }
+
+    list = list->next;
+  }
+}
 
-  g_rec_mutex_lock(task_launcher_mutex);
+/**
+ * ags_task_launcher_add_task_coalesced:
+ * @task_launcher: the #AgsTaskLauncher
+ * @task: the #AgsTask
+ * @coalesce_target: the target of @task
+ * 
+ * Add @task to @task_launcher. If a task of the same #GType and
+ * @coalesce_target is queued, only the newest of them is launched.
+ * Passing %NULL as @coalesce_target is the same as ags_task_launcher_add_task().
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_task_launcher_add_task_coalesced(AgsTaskLauncher *task_launcher,
+				     AgsTask *task,
+				     gpointer coalesce_target)
+{
+  if(!AGS_IS_TASK_LAUNCHER(task_launcher) ||
+     !AGS_IS_TASK(task)){
+    return;
+  }
 
-  if(task_launcher->task != NULL){
-    task_launcher->task = g_list_concat(task_launcher->task,
-					g_list_copy_deep(list,
-							 (GCopyFunc) g_object_ref,
-							 NULL));
-  }else{
-    task_launcher->task = g_list_copy_deep(list,
-					   (GCopyFunc) g_object_ref,
-					   NULL);
+  ags_task_launcher_push(task_launcher,
+			 ags_task_launcher_item_alloc(task,
+						      NULL,
+						      NULL,
+						      NULL,
+						      coalesce_target));
+}
+
+/**
+ * ags_task_launcher_add_func:
+ * @task_launcher: the #AgsTaskLauncher
+ * @func: (scope notified): the #AgsTaskLauncherFunc
+ * @data: the data passed to @func
+ * @destroy: the #GDestroyNotify of @data or %NULL
+ * @coalesce_target: the target to coalesce or %NULL
+ * 
+ * Add @func to @task_launcher, it is invoked like a one shot task without
+ * instantiating an #AgsTask. If @coalesce_target is not %NULL, a newer
+ * queued @func with equal @coalesce_target supersedes the older one.
+ * 
+ * Since: 3.5.0
+ */
+void
+ags_task_launcher_add_func(AgsTaskLauncher *task_launcher,
+			   AgsTaskLauncherFunc func,
+			   gpointer data,
+			   GDestroyNotify destroy,
+			   gpointer coalesce_target)
+{
+  if(!AGS_IS_TASK_LAUNCHER(task_launcher) ||
+     func == NULL){
+    if(destroy != NULL){
+      destroy(data);
+    }
+    
+    return;
   }
-  
-  g_rec_mutex_unlock(task_launcher_mutex);
+
+  ags_task_launcher_push(task_launcher,
+			 ags_task_launcher_item_alloc(NULL,
+						      func,
+						      data,
+						      destroy,
+						      coalesce_target));
 }
 
 /**
@@ -778,7 +977,7 @@ ags_task_launcher_remove_cyclic_task(AgsTaskLauncher *task_launcher,
 
   g_rec_mutex_lock(task_launcher_mutex);
 
-  if(g_list_find(task_launcher->task, cyclic_task) != NULL){
+  if(g_list_find(task_launcher->cyclic_task, cyclic_task) != NULL){
     task_launcher->cyclic_task = g_list_remove(task_launcher->cyclic_task,
 					       cyclic_task);
     g_object_unref(cyclic_task);
@@ -787,43 +986,125 @@ ags_task_launcher_remove_cyclic_task(AgsTaskLauncher *task_launcher,
   g_rec_mutex_unlock(task_launcher_mutex);
 }
 
+void
+ags_task_launcher_push(AgsTaskLauncher *task_launcher,
+		       AgsTaskLauncherItem *item)
+{
+  AgsTaskLauncherItem *next;
+
+  /* lock-free prepend, the consumer always takes the whole queue */
+  do{
+    next = g_atomic_pointer_get(&(task_launcher->queue));
+
+    item->next = next;
+  }while(!g_atomic_pointer_compare_and_exchange(&(task_launcher->queue),
+						next,
+						item));
+}
+
+AgsTaskLauncherItem*
+ags_task_launcher_pop_all(AgsTaskLauncher *task_launcher)
+{
+  AgsTaskLauncherItem *item;
+
+  GRecMutex *task_launcher_mutex;
+
+  /* get task launcher mutex */
+  task_launcher_mutex = AGS_TASK_LAUNCHER_GET_OBJ_MUTEX(task_launcher);
+
+  /* detach - the mutex only excludes readers of AgsTaskLauncher:task */
+  g_rec_mutex_lock(task_launcher_mutex);
+  
+  do{
+    item = g_atomic_pointer_get(&(task_launcher->queue));
+  }while(item != NULL &&
+	 !g_atomic_pointer_compare_and_exchange(&(task_launcher->queue),
+						item,
+						NULL));
+
+  g_rec_mutex_unlock(task_launcher_mutex);
+
+  return(item);
+}
+
 void
 ags_task_launcher_real_run(AgsTaskLauncher *task_launcher)
 {
-  GList *start_task, *task;
+  AgsTaskLauncherItem *item, *next;
+  AgsTaskLauncherItem *fifo;
+
   GList *start_cyclic_task, *cyclic_task;
 
+  GHashTable *coalesce;
+
   GRecMutex *task_launcher_mutex;
 
   /* get task launcher mutex */
   task_launcher_mutex = AGS_TASK_LAUNCHER_GET_OBJ_MUTEX(task_launcher);
 
-  g_rec_mutex_lock(task_launcher_mutex);
+  item = ags_task_launcher_pop_all(task_launcher);
 
-  g_object_get(task_launcher,
-	       "task", &start_task,
-	       "cyclic-task", &start_cyclic_task,
-	       NULL);
+  g_rec_mutex_lock(task_launcher_mutex);
 
-  g_list_free_full(task_launcher->task,
-		   g_object_unref);
-  
-  task_launcher->task = NULL;
+  start_cyclic_task = g_list_copy_deep(task_launcher->cyclic_task,
+				       (GCopyFunc) g_object_ref,
+				       NULL);
   
   g_rec_mutex_unlock(task_launcher_mutex);
-  
-  /* one shot task */
-  task = start_task;
 
-  while(task != NULL){
-    ags_task_launch(task->data);
-      
-    /* iterate */
-    task = task->next;
+  /* drop superseded items and reverse to arrival order */
+  fifo = NULL;
+  coalesce = NULL;
+
+  while(item != NULL){
+    next = item->next;
+
+    if(item->coalesce_target != NULL){
+      if(coalesce == NULL){
+	coalesce = g_hash_table_new(ags_task_launcher_item_coalesce_hash,
+				    ags_task_launcher_item_coalesce_equal);
+      }
+
+      if(g_hash_table_contains(coalesce,
+			       item)){
+	ags_task_launcher_item_free(item);
+
+	item = next;
+
+	continue;
+      }
+
+      g_hash_table_add(coalesce,
+		       item);
+    }
+
+    item->next = fifo;
+    fifo = item;
+
+    item = next;
   }
 
-  g_list_free_full(start_task,
-		   g_object_unref);
+  if(coalesce != NULL){
+    g_hash_table_destroy(coalesce);
+  }
+
+  /* launch */
+  item = fifo;
+
+  while(item != NULL){
+    next = item->next;
+
+    if(item->task != NULL){
+      ags_task_launch(item->task);
+    }else{
+      item->func(item->data);
+    }
+
+    ags_task_launcher_item_free(item);
+    
+    /* iterate */
+    item = next;
+  }
 
   /* cyclic task */
   cyclic_task = start_cyclic_task;
@@ -38,8 +38,13 @@ G_BEGIN_DECLS
 
 #define AGS_TASK_LAUNCHER_GET_OBJ_MUTEX(obj) (&(((AgsTaskLauncher *) obj)->obj_mutex))
 
+#define AGS_TASK_LAUNCHER_ITEM(ptr) ((AgsTaskLauncherItem *)(ptr))
+
 typedef struct _AgsTaskLauncher AgsTaskLauncher;
 typedef struct _AgsTaskLauncherClass AgsTaskLauncherClass;
+typedef struct _AgsTaskLauncherItem AgsTaskLauncherItem;
+
+typedef void (*AgsTaskLauncherFunc)(gpointer data);
 
 /**
  * AgsTaskLauncherFlags:
@@ -54,6 +59,33 @@ typedef enum{
   AGS_TASK_LAUNCHER_CONNECTED               = 1 <<  1,
 }AgsTaskLauncherFlags;
 
+/**
+ * AgsTaskLauncherItem:
+ * @next: the next, older, item of the queue
+ * @task: the #AgsTask to launch or %NULL
+ * @func: the #AgsTaskLauncherFunc to invoke or %NULL
+ * @data: the data passed to @func
+ * @destroy: the #GDestroyNotify of @data
+ * @coalesce_kind: the kind of the item, either the #GType of @task or @func
+ * @coalesce_target: the target to coalesce or %NULL
+ *
+ * #AgsTaskLauncherItem is a queued task or function of #AgsTaskLauncher. A newer
+ * item with equal @coalesce_kind and @coalesce_target supersedes the older one.
+ */
+struct _AgsTaskLauncherItem
+{
+  AgsTaskLauncherItem *next;
+
+  AgsTask *task;
+
+  AgsTaskLauncherFunc func;
+  gpointer data;
+  GDestroyNotify destroy;
+
+  gpointer coalesce_kind;
+  gpointer coalesce_target;
+};
+
 struct _AgsTaskLauncher
 {
   GObject gobject;
@@ -66,7 +98,8 @@ struct _AgsTaskLauncher
   
   GMainContext *main_context;
   
-  GList *task;
+  volatile gpointer queue;
+
   GList *cyclic_task;
 
   volatile gboolean is_running;
@@ -85,6 +118,13 @@ struct _AgsTaskLauncherClass
 
 GType ags_task_launcher_get_type();
 
+AgsTaskLauncherItem* ags_task_launcher_item_alloc(AgsTask *task,
+						  AgsTaskLauncherFunc func,
+						  gpointer data,
+						  GDestroyNotify destroy,
+						  gpointer coalesce_target);
+void ags_task_launcher_item_free(AgsTaskLauncherItem *item);
+
 gboolean ags_task_launcher_test_flags(AgsTaskLauncher *task_launcher, guint flags);
 void ags_task_launcher_set_flags(AgsTaskLauncher *task_launcher, guint flags);
 void ags_task_launcher_unset_flags(AgsTaskLauncher *task_launcher, guint flags);
@@ -97,6 +137,15 @@ void ags_task_launcher_add_task(AgsTaskLauncher *task_launcher,
 void ags_task_launcher_add_task_all(AgsTaskLauncher *task_launcher,
 				    GList *list);
 
+void ags_task_launcher_add_task_coalesced(AgsTaskLauncher *task_launcher,
+					  AgsTask *task,
+					  gpointer coalesce_target);
+void ags_task_launcher_add_func(AgsTaskLauncher *task_launcher,
+				AgsTaskLauncherFunc func,
+				gpointer data,
+				GDestroyNotify destroy,
+				gpointer coalesce_target);
+
 void ags_task_launcher_add_cyclic_task(AgsTaskLauncher *task_launcher,
 				       AgsTask *cyclic_task);
 void ags_task_launcher_remove_cyclic_task(AgsTaskLauncher *task_launcher,
@@ -27,6 +27,7 @@
 
 #include <ags/thread/ags_concurrency_provider.h>
 #include <ags/thread/ags_task_launcher.h>
+#include <ags/thread/ags_timing_monitor.h>
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -63,6 +64,10 @@ gboolean ags_thread_is_connected(AgsConnectable *connectable);
 void ags_thread_connect(AgsConnectable *connectable);
 void ags_thread_disconnect(AgsConnectable *connectable);
 
+void ags_thread_initial_sync_tic_delay(AgsThread *thread,
+				      AgsThread *main_loop);
+void ags_thread_tic_barrier_trip(AgsThread *main_loop);
+
 guint ags_thread_real_clock(AgsThread *thread);
 
 void ags_thread_real_start(AgsThread *thread);
@@ -379,6 +384,8 @@ ags_thread_init(AgsThread *thread)
 
   g_cond_init(&(thread->tic_cond));
 
+  thread->tic_barrier = NULL;
+
   /* start notify */
   thread->start_queue = NULL;
   
@@ -510,6 +517,10 @@ ags_thread_finalize(GObject *gobject)
 #ifdef AGS_DEBUG
   g_message("fin");
 #endif
+
+  /* timing histograms */
+  ags_timing_monitor_remove(ags_timing_monitor_get_instance(),
+			    thread);
   
   if(thread == ags_thread_self()){
     do_exit = TRUE;
@@ -542,6 +553,11 @@ ags_thread_finalize(GObject *gobject)
 
   /* UUID */
   ags_uuid_free(thread->uuid);
+
+  /* tic barrier */
+  if(thread->tic_barrier != NULL){
+    g_object_unref(thread->tic_barrier);
+  }
     
   /* call parent */
   G_OBJECT_CLASS(ags_thread_parent_class)->finalize(gobject);
@@ -1276,6 +1292,54 @@ ags_thread_get_max_precision(AgsThread *thread)
   return(max_precision);
 }
 
+/**
+ * ags_thread_get_tic_barrier:
+ * @thread: the #AgsThread
+ *
+ * Get the #AgsTicBarrier of @thread, it is created as needed. The tree
+ * is synchronized by the tic barrier of the main loop if
+ * %AGS_THREAD_TIC_BARRIER is set on it. Wakeup latency is accounted if
+ * %AGS_THREAD_TIME_ACCOUNTING is set on @thread.
+ *
+ * Returns: (transfer full): the #AgsTicBarrier
+ *
+ * Since: 3.5.0
+ */
+AgsTicBarrier*
+ags_thread_get_tic_barrier(AgsThread *thread)
+{
+  AgsTicBarrier *tic_barrier;
+  
+  GRecMutex *thread_mutex;
+
+  if(!AGS_IS_THREAD(thread)){
+    return(NULL);
+  }
+
+  thread_mutex = AGS_THREAD_GET_OBJ_MUTEX(thread);
+
+  g_rec_mutex_lock(thread_mutex);
+
+  if(thread->tic_barrier == NULL){
+    thread->tic_barrier = ags_tic_barrier_new();
+    ags_tic_barrier_set_trip_func(thread->tic_barrier,
+				  (AgsTicBarrierFunc) ags_thread_tic_barrier_trip,
+				  thread);
+
+    if((AGS_THREAD_TIME_ACCOUNTING & (thread->my_flags)) != 0){
+      ags_tic_barrier_set_flags(thread->tic_barrier,
+				AGS_TIC_BARRIER_LATENCY_ACCOUNTING);
+    }
+  }
+
+  tic_barrier = thread->tic_barrier;
+  g_object_ref(tic_barrier);
+  
+  g_rec_mutex_unlock(thread_mutex);
+
+  return(tic_barrier);
+}
+
 /**
  * ags_thread_parent:
  * @thread: the #AgsThread
@@ -2126,11 +2190,75 @@ ags_thread_set_tree_sync_recursive(AgsThread *thread, guint current_sync_tic)
   }
 }
 
+void
+ags_thread_initial_sync_tic_delay(AgsThread *thread,
+				  AgsThread *main_loop)
+{
+  gdouble main_delay;
+  gdouble main_tic_delay, next_main_tic_delay, prev_main_tic_delay;
+
+  GRecMutex *main_loop_mutex;
+
+  main_loop_mutex = AGS_THREAD_GET_OBJ_MUTEX(main_loop);
+    
+  g_rec_mutex_lock(main_loop_mutex);
+      
+  main_delay = main_loop->delay;
+  main_tic_delay = main_loop->tic_delay;
+
+  g_rec_mutex_unlock(main_loop_mutex);
+    
+  if(main_tic_delay + 1.0 < main_delay){
+    next_main_tic_delay = main_tic_delay + 1.0;
+  }else{
+    next_main_tic_delay =  0.0; //(main_tic_delay + 1.0) - floor(main_delay); // (main_tic_delay + 1.0) - main_delay;
+  }
+
+  if(main_tic_delay - 1.0 > 0.0){
+    prev_main_tic_delay = main_tic_delay - 1.0;
+  }else{
+    prev_main_tic_delay = main_delay - 1.0; // (floor(main_delay) + 1.0) - (floor(main_delay) + main_tic_delay); // (main_delay + 1.0) - (main_delay + main_tic_delay);
+  }
+  
+  if(ags_thread_test_flags(thread, AGS_THREAD_IMMEDIATE_SYNC)){
+    thread->tic_delay = main_tic_delay;
+  }else if(ags_thread_test_flags(thread, AGS_THREAD_INTERMEDIATE_PRE_SYNC)){
+    thread->tic_delay = next_main_tic_delay;
+  }else if(ags_thread_test_flags(thread, AGS_THREAD_INTERMEDIATE_POST_SYNC)){
+    thread->tic_delay = prev_main_tic_delay;
+  }else{
+    thread->tic_delay = 0.0;
+  }
+}
+
+void
+ags_thread_tic_barrier_trip(AgsThread *main_loop)
+{
+  AgsTaskLauncher *task_launcher;
+  
+  AgsApplicationContext *application_context;
+
+  application_context = ags_application_context_get_instance();
+
+  ags_main_loop_set_syncing(AGS_MAIN_LOOP(main_loop), TRUE);
+
+  /* get task launcher */
+  task_launcher = ags_concurrency_provider_get_task_launcher(AGS_CONCURRENCY_PROVIDER(application_context));
+      
+  /* run task launcher */
+  ags_task_launcher_sync_run(task_launcher);
+
+  g_object_unref(task_launcher);
+  
+  ags_main_loop_set_syncing(AGS_MAIN_LOOP(main_loop), FALSE);
+}
+
 guint
 ags_thread_real_clock(AgsThread *thread)
 {
   AgsThread *main_loop;
   AgsTaskLauncher *task_launcher;
+  AgsTicBarrier *tic_barrier;
   
   AgsApplicationContext *application_context;
 
@@ -2222,6 +2350,42 @@ ags_thread_real_clock(AgsThread *thread)
 
     ags_thread_unset_status_flags(thread, AGS_THREAD_STATUS_IS_CHAOS_TREE);
   }
+
+  /* generation counting barrier */
+  if(ags_thread_test_flags(main_loop, AGS_THREAD_TIC_BARRIER)){
+    g_rec_mutex_unlock(tree_mutex);
+
+    tic_barrier = ags_thread_get_tic_barrier(main_loop);
+
+    if(initial_sync){
+      ags_tic_barrier_join(tic_barrier);
+
+      /* mark synced */
+      ags_thread_initial_sync_tic_delay(thread,
+					main_loop);
+      
+      ags_thread_set_flags(thread, AGS_THREAD_MARK_SYNCED);
+      ags_thread_set_status_flags(thread, (AGS_THREAD_STATUS_SYNCED |
+					   AGS_THREAD_STATUS_SYNCED_FREQ));
+    
+      /* unset status flags */
+      ags_thread_unset_status_flags(thread, AGS_THREAD_STATUS_INITIAL_SYNC);
+
+      /* decrement queued critical region */
+      ags_main_loop_dec_queued_critical_region(AGS_MAIN_LOOP(main_loop));
+    }
+
+    /* synchronize - the last arriving thread runs the task launcher */
+    ags_thread_set_status_flags(thread, AGS_THREAD_STATUS_WAITING);
+
+    ags_tic_barrier_arrive(tic_barrier);
+
+    ags_thread_unset_status_flags(thread, AGS_THREAD_STATUS_WAITING);
+
+    g_object_unref(tic_barrier);
+
+    goto ags_thread_real_clock_SYNC_DONE;
+  }
   
   /* sync tic */
   main_sync_tic = ags_thread_get_current_sync_tic(main_loop);
@@ -2379,41 +2543,12 @@ ags_thread_real_clock(AgsThread *thread)
 
   /* do initial sync */
   if(initial_sync){
-    gdouble main_delay;
-    gdouble main_tic_delay, next_main_tic_delay, prev_main_tic_delay;
-    
-    g_rec_mutex_lock(main_loop_mutex);
-      
-    main_delay = main_loop->delay;
-    main_tic_delay = main_loop->tic_delay;
-
-    g_rec_mutex_unlock(main_loop_mutex);
-    
-    if(main_tic_delay + 1.0 < main_delay){
-      next_main_tic_delay = main_tic_delay + 1.0;
-    }else{
-      next_main_tic_delay =  0.0; //(main_tic_delay + 1.0) - floor(main_delay); // (main_tic_delay + 1.0) - main_delay;
-    }
-
-    if(main_tic_delay - 1.0 > 0.0){
-      prev_main_tic_delay = main_tic_delay - 1.0;
-    }else{
-      prev_main_tic_delay = main_delay - 1.0; // (floor(main_delay) + 1.0) - (floor(main_delay) + main_tic_delay); // (main_delay + 1.0) - (main_delay + main_tic_delay);
-    }
-  
     ags_thread_set_sync_tic_flags(thread, sync_tic_wait);
     ags_thread_unset_sync_tic_flags(thread, sync_tic_done);	
       
     /* mark synced */
-    if(ags_thread_test_flags(thread, AGS_THREAD_IMMEDIATE_SYNC)){
-      thread->tic_delay = main_tic_delay;
-    }else if(ags_thread_test_flags(thread, AGS_THREAD_INTERMEDIATE_PRE_SYNC)){
-      thread->tic_delay = next_main_tic_delay;
-    }else if(ags_thread_test_flags(thread, AGS_THREAD_INTERMEDIATE_POST_SYNC)){
-      thread->tic_delay = prev_main_tic_delay;
-    }else{
-      thread->tic_delay = 0.0;
-    }
+    ags_thread_initial_sync_tic_delay(thread,
+				      main_loop);
       
     ags_thread_set_flags(thread, AGS_THREAD_MARK_SYNCED);
     ags_thread_set_status_flags(thread, (AGS_THREAD_STATUS_SYNCED_FREQ));
@@ -2451,6 +2586,14 @@ ags_thread_real_clock(AgsThread *thread)
 	g_cond_wait(wait_cond,
 		    wait_mutex);
       }
+
+      if(ags_thread_test_flags(main_loop, AGS_THREAD_TIME_ACCOUNTING)){
+	tic_barrier = ags_thread_get_tic_barrier(main_loop);
+
+	ags_tic_barrier_account_wakeup(tic_barrier);
+
+	g_object_unref(tic_barrier);
+      }
     }
 
     ags_thread_unset_status_flags(thread, AGS_THREAD_STATUS_WAITING);
@@ -2489,6 +2632,14 @@ ags_thread_real_clock(AgsThread *thread)
     ags_thread_prepare_tree_sync_recursive(main_loop,
 					   main_sync_tic);
 
+    if(ags_thread_test_flags(main_loop, AGS_THREAD_TIME_ACCOUNTING)){
+      tic_barrier = ags_thread_get_tic_barrier(main_loop);
+
+      ags_tic_barrier_mark_trip(tic_barrier);
+
+      g_object_unref(tic_barrier);
+    }
+
     ags_thread_set_tree_sync_recursive(main_loop,
 				       main_sync_tic);
 #else
@@ -2510,6 +2661,8 @@ ags_thread_real_clock(AgsThread *thread)
     g_rec_mutex_unlock(tree_mutex);
   }
 
+ags_thread_real_clock_SYNC_DONE:
+  
   /* get task launcher */
   task_launcher = ags_concurrency_provider_get_task_launcher(AGS_CONCURRENCY_PROVIDER(application_context));
 
@@ -2745,6 +2898,24 @@ ags_thread_loop(void *ptr)
   main_loop = ags_concurrency_provider_get_main_loop(AGS_CONCURRENCY_PROVIDER(application_context));
 
   tree_mutex = ags_main_loop_get_tree_lock(AGS_MAIN_LOOP(main_loop));  
+
+  /* leave generation counting barrier */
+  if(ags_thread_test_flags(main_loop, AGS_THREAD_TIC_BARRIER)){
+    ags_thread_clear_status_flags(thread);
+    ags_thread_clear_sync_tic_flags(thread);
+
+    if(ags_thread_test_flags(thread, AGS_THREAD_MARK_SYNCED)){
+      AgsTicBarrier *tic_barrier;
+
+      tic_barrier = ags_thread_get_tic_barrier(main_loop);
+
+      ags_tic_barrier_leave(tic_barrier);
+
+      g_object_unref(tic_barrier);
+    }
+
+    goto ags_thread_loop_EXIT;
+  }
   
   g_rec_mutex_lock(tree_mutex);
 
@@ -2803,6 +2974,8 @@ ags_thread_loop(void *ptr)
     g_rec_mutex_unlock(tree_mutex);
   }
   
+ags_thread_loop_EXIT:
+  
   /* exit thread */
   ags_thread_unset_flags(thread, AGS_THREAD_MARK_SYNCED);
 
@@ -2935,12 +3108,20 @@ ags_thread_add_start_queue_all(AgsThread *thread,
 void
 ags_thread_run(AgsThread *thread)
 {
+  gint64 start_time;
+  
   g_return_if_fail(AGS_IS_THREAD(thread));
 
+  start_time = ags_timing_monitor_start();
+
   g_object_ref(thread);
   g_signal_emit(thread,
 		thread_signals[RUN], 0);
   g_object_unref(thread);
+
+  ags_timing_monitor_stop(thread,
+			  AGS_TIMING_MONITOR_THREAD_RUN,
+			  start_time);
 }
 
 
@@ -26,6 +26,8 @@
 #include <ags/lib/ags_uuid.h>
 #include <ags/lib/ags_time.h>
 
+#include <ags/thread/ags_tic_barrier.h>
+
 #include <time.h>
 
 G_BEGIN_DECLS
@@ -72,6 +74,7 @@ typedef struct _AgsThreadClass AgsThreadClass;
  * @AGS_THREAD_START_SYNCED_FREQ: sync frequency as starting thread
  * @AGS_THREAD_MARK_SYNCED: mark thread synced
  * @AGS_THREAD_TIME_ACCOUNTING: time accounting causes to track time
+ * @AGS_THREAD_TIC_BARRIER: synchronize the tree using #AgsTicBarrier instead of sync-tic flags, set on main loop before start by the tic-barrier key of the thread config
  *
  * Enum values to control the behavior or indicate internal state of #AgsThread by
  * enable/disable as flags.
@@ -86,6 +89,7 @@ typedef enum{
   AGS_THREAD_START_SYNCED_FREQ       = 1 <<  6,
   AGS_THREAD_MARK_SYNCED             = 1 <<  7,
   AGS_THREAD_TIME_ACCOUNTING         = 1 <<  8,
+  AGS_THREAD_TIC_BARRIER             = 1 <<  9,
 }AgsThreadFlags;
 
 /**
@@ -199,6 +203,8 @@ struct _AgsThread
   GMutex tic_mutex;
   GCond tic_cond;
 
+  AgsTicBarrier *tic_barrier;
+
   GList *start_queue;
   
   GMutex *start_mutex;
@@ -253,6 +259,8 @@ gdouble ags_thread_get_frequency(AgsThread *thread);
 void ags_thread_set_max_precision(AgsThread *thread, gdouble max_precision);
 gdouble ags_thread_get_max_precision(AgsThread *thread);
 
+AgsTicBarrier* ags_thread_get_tic_barrier(AgsThread *thread);
+
 AgsThread* ags_thread_find_type(AgsThread *thread, GType gtype);
 AgsThread* ags_thread_self(void);
 
@@ -0,0 +1,557 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/thread/ags_tic_barrier.h>
+
+void ags_tic_barrier_class_init(AgsTicBarrierClass *tic_barrier);
+void ags_tic_barrier_init(AgsTicBarrier *tic_barrier);
+void ags_tic_barrier_finalize(GObject *gobject);
+
+void ags_tic_barrier_trip(AgsTicBarrier *tic_barrier);
+void ags_tic_barrier_account_wakeup_unlocked(AgsTicBarrier *tic_barrier);
+
+/**
+ * SECTION:ags_tic_barrier
+ * @short_description: generation counting tic barrier
+ * @title: AgsTicBarrier
+ * @section_id:
+ * @include: ags/thread/ags_tic_barrier.h
+ *
+ * The #AgsTicBarrier synchronizes the participating threads of a tree once
+ * per tic. Every thread calls ags_tic_barrier_arrive() and is parked on a
+ * condition until the generation counter advances. The last arriving thread
+ * invokes the trip function and wakes all others with one broadcast.
+ */
+
+static gpointer ags_tic_barrier_parent_class = NULL;
+
+GType
+ags_tic_barrier_get_type(void)
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_tic_barrier = 0;
+
+    static const GTypeInfo ags_tic_barrier_info = {
+      sizeof (AgsTicBarrierClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_tic_barrier_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof (AgsTicBarrier),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_tic_barrier_init,
+    };
+
+    ags_type_tic_barrier = g_type_register_static(G_TYPE_OBJECT,
+						  "AgsTicBarrier",
+						  &ags_tic_barrier_info,
+						  0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_tic_barrier);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_tic_barrier_class_init(AgsTicBarrierClass *tic_barrier)
+{
+  GObjectClass *gobject;
+
+  ags_tic_barrier_parent_class = g_type_class_peek_parent(tic_barrier);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) tic_barrier;
+
+  gobject->finalize = ags_tic_barrier_finalize;
+}
+
+void
+ags_tic_barrier_init(AgsTicBarrier *tic_barrier)
+{
+  guint i;
+  
+  tic_barrier->flags = 0;
+
+  /* mutex and condition */
+  g_mutex_init(&(tic_barrier->obj_mutex));
+  g_cond_init(&(tic_barrier->generation_cond));
+
+  g_atomic_int_set(&(tic_barrier->generation),
+		   0);
+
+  tic_barrier->n_participants = 0;
+  tic_barrier->n_arrived = 0;
+
+  tic_barrier->trip_func = NULL;
+  tic_barrier->trip_data = NULL;
+
+  tic_barrier->trip_time = 0;
+
+  for(i = 0; i < AGS_TIC_BARRIER_LATENCY_BUCKETS; i++){
+    tic_barrier->latency_histogram[i] = 0;
+  }
+
+  tic_barrier->max_latency = 0;
+}
+
+void
+ags_tic_barrier_finalize(GObject *gobject)
+{
+  AgsTicBarrier *tic_barrier;
+
+  tic_barrier = AGS_TIC_BARRIER(gobject);
+
+  g_mutex_clear(&(tic_barrier->obj_mutex));
+  g_cond_clear(&(tic_barrier->generation_cond));
+  
+  /* call parent */
+  G_OBJECT_CLASS(ags_tic_barrier_parent_class)->finalize(gobject);
+}
+
+/**
+ * ags_tic_barrier_test_flags:
+ * @tic_barrier: the #AgsTicBarrier
+ * @flags: the flags
+ *
+ * Test @flags to be set on @tic_barrier.
+ * 
+ * Returns: %TRUE if flags are set, else %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_tic_barrier_test_flags(AgsTicBarrier *tic_barrier, guint flags)
+{
+  gboolean retval;  
+  
+  if(!AGS_IS_TIC_BARRIER(tic_barrier)){
+    return(FALSE);
+  }
+
+  g_mutex_lock(&(tic_barrier->obj_mutex));
+
+  retval = (flags & (tic_barrier->flags)) ? TRUE: FALSE;
+  
+  g_mutex_unlock(&(tic_barrier->obj_mutex));
+
+  return(retval);
+}
+
+/**
+ * ags_tic_barrier_set_flags:
+ * @tic_barrier: the #AgsTicBarrier
+ * @flags: see #AgsTicBarrierFlags-enum
+ *
+ * Enable a feature of @tic_barrier.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_tic_barrier_set_flags(AgsTicBarrier *tic_barrier, guint flags)
+{
+  if(!AGS_IS_TIC_BARRIER(tic_barrier)){
+    return;
+  }
+
+  g_mutex_lock(&(tic_barrier->obj_mutex));
+
+  tic_barrier->flags |= flags;
+  
+  g_mutex_unlock(&(tic_barrier->obj_mutex));
+}
+
+/**
+ * ags_tic_barrier_unset_flags:
+ * @tic_barrier: the #AgsTicBarrier
+ * @flags: see #AgsTicBarrierFlags-enum
+ *
+ * Disable a feature of @tic_barrier.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_tic_barrier_unset_flags(AgsTicBarrier *tic_barrier, guint flags)
+{
+  if(!AGS_IS_TIC_BARRIER(tic_barrier)){
+    return;
+  }
+
+  g_mutex_lock(&(tic_barrier->obj_mutex));
+
+  tic_barrier->flags &= (~flags);
+  
+  g_mutex_unlock(&(tic_barrier->obj_mutex));
+}
+
+/**
+ * ags_tic_barrier_set_trip_func:
+ * @tic_barrier: the #AgsTicBarrier
+ * @trip_func: (scope notified): the #AgsTicBarrierFunc
+ * @trip_data: the data passed to @trip_func
+ *
+ * Set the function invoked by the last arriving thread, before any waiting
+ * thread is woken up.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_tic_barrier_set_trip_func(AgsTicBarrier *tic_barrier,
+			      AgsTicBarrierFunc trip_func,
+			      gpointer trip_data)
+{
+  if(!AGS_IS_TIC_BARRIER(tic_barrier)){
+    return;
+  }
+
+  g_mutex_lock(&(tic_barrier->obj_mutex));
+
+  tic_barrier->trip_func = trip_func;
+  tic_barrier->trip_data = trip_data;
+  
+  g_mutex_unlock(&(tic_barrier->obj_mutex));
+}
+
+/**
+ * ags_tic_barrier_get_generation:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Get the current generation of @tic_barrier.
+ *
+ * Returns: the generation
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_tic_barrier_get_generation(AgsTicBarrier *tic_barrier)
+{
+  if(!AGS_IS_TIC_BARRIER(tic_barrier)){
+    return(0);
+  }
+
+  return(g_atomic_int_get(&(tic_barrier->generation)));
+}
+
+void
+ags_tic_barrier_trip(AgsTicBarrier *tic_barrier)
+{
+  AgsTicBarrierFunc trip_func;
+
+  gpointer trip_data;
+
+  /* called with obj mutex held */
+  trip_func = tic_barrier->trip_func;
+  trip_data = tic_barrier->trip_data;
+  
+  tic_barrier->flags |= AGS_TIC_BARRIER_TRIPPING;
+
+  if(trip_func != NULL){
+    g_mutex_unlock(&(tic_barrier->obj_mutex));
+    
+    trip_func(trip_data);
+
+    g_mutex_lock(&(tic_barrier->obj_mutex));
+  }
+
+  /* advance generation and wake up all at once */
+  tic_barrier->n_arrived = 0;
+  
+  tic_barrier->trip_time = g_get_monotonic_time();
+
+  g_atomic_int_inc(&(tic_barrier->generation));
+
+  tic_barrier->flags &= (~AGS_TIC_BARRIER_TRIPPING);
+  
+  g_cond_broadcast(&(tic_barrier->generation_cond));
+}
+
+/**
+ * ags_tic_barrier_join:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Join @tic_barrier as participant, the calling thread has to arrive
+ * once per generation until it leaves.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_tic_barrier_join(AgsTicBarrier *tic_barrier)
+{
+  if(!AGS_IS_TIC_BARRIER(tic_barrier)){
+    return;
+  }
+
+  g_mutex_lock(&(tic_barrier->obj_mutex));
+
+  while((AGS_TIC_BARRIER_TRIPPING & (tic_barrier->flags)) != 0){
+    g_cond_wait(&(tic_barrier->generation_cond),
+		&(tic_barrier->obj_mutex));
+  }
+  
+  tic_barrier->n_participants += 1;
+  
+  g_mutex_unlock(&(tic_barrier->obj_mutex));
+}
+
+/**
+ * ags_tic_barrier_leave:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Leave @tic_barrier. If all remaining participants did arrive already,
+ * the calling thread trips the barrier.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_tic_barrier_leave(AgsTicBarrier *tic_barrier)
+{
+  if(!AGS_IS_TIC_BARRIER(tic_barrier)){
+    return;
+  }
+
+  g_mutex_lock(&(tic_barrier->obj_mutex));
+
+  while((AGS_TIC_BARRIER_TRIPPING & (tic_barrier->flags)) != 0){
+    g_cond_wait(&(tic_barrier->generation_cond),
+		&(tic_barrier->obj_mutex));
+  }
+
+  if(tic_barrier->n_participants > 0){
+    tic_barrier->n_participants -= 1;
+  }
+
+  if(tic_barrier->n_arrived > 0 &&
+     tic_barrier->n_arrived >= tic_barrier->n_participants){
+    ags_tic_barrier_trip(tic_barrier);
+  }
+  
+  g_mutex_unlock(&(tic_barrier->obj_mutex));
+}
+
+/**
+ * ags_tic_barrier_arrive:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Arrive at @tic_barrier and wait until all participants did arrive. The
+ * last one invokes the trip function and advances the generation.
+ *
+ * Returns: the generation arrived at
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_tic_barrier_arrive(AgsTicBarrier *tic_barrier)
+{
+  guint generation;
+  
+  if(!AGS_IS_TIC_BARRIER(tic_barrier)){
+    return(0);
+  }
+
+  g_mutex_lock(&(tic_barrier->obj_mutex));
+
+  while((AGS_TIC_BARRIER_TRIPPING & (tic_barrier->flags)) != 0){
+    g_cond_wait(&(tic_barrier->generation_cond),
+		&(tic_barrier->obj_mutex));
+  }
+
+  generation = g_atomic_int_get(&(tic_barrier->generation));
+  
+  tic_barrier->n_arrived += 1;
+
+  if(tic_barrier->n_arrived >= tic_barrier->n_participants){
+    ags_tic_barrier_trip(tic_barrier);
+  }else{
+    while(generation == g_atomic_int_get(&(tic_barrier->generation))){
+      g_cond_wait(&(tic_barrier->generation_cond),
+		  &(tic_barrier->obj_mutex));
+    }
+
+    ags_tic_barrier_account_wakeup_unlocked(tic_barrier);
+  }
+  
+  g_mutex_unlock(&(tic_barrier->obj_mutex));
+
+  return(generation);
+}
+
+/**
+ * ags_tic_barrier_mark_trip:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Mark the time threads are woken up, used to account wakeup latency of
+ * a synchronization not performed by @tic_barrier.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_tic_barrier_mark_trip(AgsTicBarrier *tic_barrier)
+{
+  if(!AGS_IS_TIC_BARRIER(tic_barrier)){
+    return;
+  }
+
+  g_mutex_lock(&(tic_barrier->obj_mutex));
+
+  tic_barrier->trip_time = g_get_monotonic_time();
+  
+  g_mutex_unlock(&(tic_barrier->obj_mutex));
+}
+
+void
+ags_tic_barrier_account_wakeup_unlocked(AgsTicBarrier *tic_barrier)
+{
+  gint64 latency;
+  guint bucket;
+  
+  if((AGS_TIC_BARRIER_LATENCY_ACCOUNTING & (tic_barrier->flags)) == 0 ||
+     tic_barrier->trip_time == 0){
+    return;
+  }
+
+  latency = g_get_monotonic_time() - tic_barrier->trip_time;
+
+  if(latency < 0){
+    latency = 0;
+  }
+  
+  /* power of 2 microseconds buckets */
+  bucket = (latency > 0) ? (g_bit_storage((gulong) latency) - 1): 0;
+
+  if(bucket >= AGS_TIC_BARRIER_LATENCY_BUCKETS){
+    bucket = AGS_TIC_BARRIER_LATENCY_BUCKETS - 1;
+  }
+
+  tic_barrier->latency_histogram[bucket] += 1;
+
+  if(latency > tic_barrier->max_latency){
+    tic_barrier->max_latency = latency;
+  }
+}
+
+/**
+ * ags_tic_barrier_account_wakeup:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Account the wakeup latency of the calling thread relative to the last
+ * trip, if %AGS_TIC_BARRIER_LATENCY_ACCOUNTING is set.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_tic_barrier_account_wakeup(AgsTicBarrier *tic_barrier)
+{
+  if(!AGS_IS_TIC_BARRIER(tic_barrier)){
+    return;
+  }
+
+  g_mutex_lock(&(tic_barrier->obj_mutex));
+
+  ags_tic_barrier_account_wakeup_unlocked(tic_barrier);
+  
+  g_mutex_unlock(&(tic_barrier->obj_mutex));
+}
+
+/**
+ * ags_tic_barrier_get_latency_histogram:
+ * @tic_barrier: the #AgsTicBarrier
+ * @latency_histogram: (out) (array fixed-size=16) (allow-none): return location of the histogram
+ * @max_latency: (out) (allow-none): return location of the maximum latency in microseconds
+ *
+ * Get the wakeup latency histogram. Bucket i counts the latencies of
+ * 2^i up to 2^(i + 1) microseconds, the last bucket counts all above.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_tic_barrier_get_latency_histogram(AgsTicBarrier *tic_barrier,
+				      guint64 *latency_histogram,
+				      gint64 *max_latency)
+{
+  guint i;
+  
+  if(!AGS_IS_TIC_BARRIER(tic_barrier)){
+    return;
+  }
+
+  g_mutex_lock(&(tic_barrier->obj_mutex));
+
+  if(latency_histogram != NULL){
+    for(i = 0; i < AGS_TIC_BARRIER_LATENCY_BUCKETS; i++){
+      latency_histogram[i] = tic_barrier->latency_histogram[i];
+    }
+  }
+
+  if(max_latency != NULL){
+    max_latency[0] = tic_barrier->max_latency;
+  }
+  
+  g_mutex_unlock(&(tic_barrier->obj_mutex));
+}
+
+/**
+ * ags_tic_barrier_reset_latency_histogram:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Reset the wakeup latency histogram.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_tic_barrier_reset_latency_histogram(AgsTicBarrier *tic_barrier)
+{
+  guint i;
+  
+  if(!AGS_IS_TIC_BARRIER(tic_barrier)){
+    return;
+  }
+
+  g_mutex_lock(&(tic_barrier->obj_mutex));
+
+  for(i = 0; i < AGS_TIC_BARRIER_LATENCY_BUCKETS; i++){
+    tic_barrier->latency_histogram[i] = 0;
+  }
+
+  tic_barrier->max_latency = 0;
+  
+  g_mutex_unlock(&(tic_barrier->obj_mutex));
+}
+
+/**
+ * ags_tic_barrier_new:
+ *
+ * Create a new #AgsTicBarrier.
+ *
+ * Returns: the new #AgsTicBarrier
+ *
+ * Since: 3.5.0
+ */
+AgsTicBarrier*
+ags_tic_barrier_new()
+{
+  AgsTicBarrier *tic_barrier;
+
+  tic_barrier = (AgsTicBarrier *) g_object_new(AGS_TYPE_TIC_BARRIER,
+					       NULL);
+
+  return(tic_barrier);
+}
@@ -0,0 +1,114 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_TIC_BARRIER_H__
+#define __AGS_TIC_BARRIER_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_TIC_BARRIER                (ags_tic_barrier_get_type())
+#define AGS_TIC_BARRIER(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_TIC_BARRIER, AgsTicBarrier))
+#define AGS_TIC_BARRIER_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_TIC_BARRIER, AgsTicBarrierClass))
+#define AGS_IS_TIC_BARRIER(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_TIC_BARRIER))
+#define AGS_IS_TIC_BARRIER_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_TIC_BARRIER))
+#define AGS_TIC_BARRIER_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_TIC_BARRIER, AgsTicBarrierClass))
+
+#define AGS_TIC_BARRIER_GET_OBJ_MUTEX(obj) (&(((AgsTicBarrier *) obj)->obj_mutex))
+
+#define AGS_TIC_BARRIER_LATENCY_BUCKETS (16)
+
+typedef struct _AgsTicBarrier AgsTicBarrier;
+typedef struct _AgsTicBarrierClass AgsTicBarrierClass;
+
+typedef void (*AgsTicBarrierFunc)(gpointer data);
+
+/**
+ * AgsTicBarrierFlags:
+ * @AGS_TIC_BARRIER_TRIPPING: the last arriving thread is running the trip function
+ * @AGS_TIC_BARRIER_LATENCY_ACCOUNTING: account wakeup latency of waiting threads
+ * 
+ * Enum values to control the behavior or indicate internal state of #AgsTicBarrier by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_TIC_BARRIER_TRIPPING             = 1,
+  AGS_TIC_BARRIER_LATENCY_ACCOUNTING   = 1 <<  1,
+}AgsTicBarrierFlags;
+
+struct _AgsTicBarrier
+{
+  GObject gobject;
+
+  guint flags;
+
+  GMutex obj_mutex;
+  GCond generation_cond;
+
+  volatile guint generation;
+
+  guint n_participants;
+  guint n_arrived;
+
+  AgsTicBarrierFunc trip_func;
+  gpointer trip_data;
+
+  gint64 trip_time;
+
+  guint64 latency_histogram[AGS_TIC_BARRIER_LATENCY_BUCKETS];
+  gint64 max_latency;
+};
+
+struct _AgsTicBarrierClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_tic_barrier_get_type(void);
+
+gboolean ags_tic_barrier_test_flags(AgsTicBarrier *tic_barrier, guint flags);
+void ags_tic_barrier_set_flags(AgsTicBarrier *tic_barrier, guint flags);
+void ags_tic_barrier_unset_flags(AgsTicBarrier *tic_barrier, guint flags);
+
+void ags_tic_barrier_set_trip_func(AgsTicBarrier *tic_barrier,
+				   AgsTicBarrierFunc trip_func,
+				   gpointer trip_data);
+
+guint ags_tic_barrier_get_generation(AgsTicBarrier *tic_barrier);
+
+void ags_tic_barrier_join(AgsTicBarrier *tic_barrier);
+void ags_tic_barrier_leave(AgsTicBarrier *tic_barrier);
+
+guint ags_tic_barrier_arrive(AgsTicBarrier *tic_barrier);
+
+void ags_tic_barrier_mark_trip(AgsTicBarrier *tic_barrier);
+void ags_tic_barrier_account_wakeup(AgsTicBarrier *tic_barrier);
+
+void ags_tic_barrier_get_latency_histogram(AgsTicBarrier *tic_barrier,
+					   guint64 *latency_histogram,
+					   gint64 *max_latency);
+void ags_tic_barrier_reset_latency_histogram(AgsTicBarrier *tic_barrier);
+
+AgsTicBarrier* ags_tic_barrier_new();
+
+G_END_DECLS
+
+#endif /*__AGS_TIC_BARRIER_H__*/
@@ -0,0 +1,1066 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/thread/ags_timing_monitor.h>
+
+#include <ags/object/ags_config.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+
+#ifndef AGS_W32API
+#include <glib-unix.h>
+#endif
+
+void ags_timing_monitor_class_init(AgsTimingMonitorClass *timing_monitor);
+void ags_timing_monitor_init(AgsTimingMonitor *timing_monitor);
+void ags_timing_monitor_finalize(GObject *gobject);
+
+guint ags_timing_monitor_slot_hash(gpointer object,
+				   guint stage);
+AgsTimingHistogram* ags_timing_monitor_claim_histogram(AgsTimingMonitor *timing_monitor,
+						       gpointer object,
+						       guint stage);
+
+gboolean ags_timing_monitor_signal_func(gpointer data);
+
+/**
+ * SECTION:ags_timing_monitor
+ * @short_description: per object timing histograms
+ * @title: AgsTimingMonitor
+ * @section_id:
+ * @include: ags/thread/ags_timing_monitor.h
+ *
+ * #AgsTimingMonitor records the durations of recall stages and thread runs
+ * into a log-linear histogram per object and stage. Recording is switched
+ * on and off at runtime by ags_timing_monitor_set_enabled(), while off the
+ * cost is a single atomic read per measured call.
+ *
+ * The thread group of #AgsConfig provides the keys "timing-monitor",
+ * "timing-monitor-file" and "timing-monitor-max-histograms".
+ *
+ * The histograms are a fixed table of slots allocated once, the maximum
+ * count of histograms. Samples are added, slots are looked up and claimed
+ * with atomic operations only, so nothing is allocated or locked on the
+ * audio thread. The slots of an object are released again by
+ * ags_timing_monitor_remove() as the object is disposed.
+ */
+
+static gpointer ags_timing_monitor_parent_class = NULL;
+
+AgsTimingMonitor *ags_timing_monitor = NULL;
+
+static volatile gint ags_timing_monitor_enabled = FALSE;
+
+static const gchar *ags_timing_monitor_stage_name[] = {
+  "run-pre",
+  "run-inter",
+  "run-post",
+  "thread-run",
+  NULL,
+};
+
+GType
+ags_timing_monitor_get_type (void)
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_timing_monitor = 0;
+
+    static const GTypeInfo ags_timing_monitor_info = {
+      sizeof (AgsTimingMonitorClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_timing_monitor_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof (AgsTimingMonitor),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_timing_monitor_init,
+    };
+
+    ags_type_timing_monitor = g_type_register_static(G_TYPE_OBJECT,
+						     "AgsTimingMonitor",
+						     &ags_timing_monitor_info,
+						     0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_timing_monitor);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_timing_monitor_class_init(AgsTimingMonitorClass *timing_monitor)
+{
+  GObjectClass *gobject;
+
+  ags_timing_monitor_parent_class = g_type_class_peek_parent(timing_monitor);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) timing_monitor;
+
+  gobject->finalize = ags_timing_monitor_finalize;
+}
+
+void
+ags_timing_monitor_init(AgsTimingMonitor *timing_monitor)
+{
+  AgsConfig *config;
+
+  gchar *str;
+  
+  config = ags_config_get_instance();
+
+  timing_monitor->flags = 0;
+
+  /* timing monitor mutex */
+  g_rec_mutex_init(&(timing_monitor->obj_mutex));
+
+  /* histogram */
+  timing_monitor->max_histograms = AGS_TIMING_MONITOR_DEFAULT_MAX_HISTOGRAMS;
+
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_THREAD,
+			     "timing-monitor-max-histograms");
+
+  if(str != NULL){
+    timing_monitor->max_histograms = g_ascii_strtoull(str,
+						      NULL,
+						      10);
+
+    g_free(str);
+  }
+
+  if(timing_monitor->max_histograms == 0){
+    timing_monitor->max_histograms = 1;
+  }
+
+  timing_monitor->allocated_histograms = timing_monitor->max_histograms;
+  timing_monitor->n_histograms = 0;
+
+  timing_monitor->histogram = (AgsTimingHistogram *) calloc(timing_monitor->allocated_histograms,
+							    sizeof(AgsTimingHistogram));
+  
+  /* dump */
+  timing_monitor->filename = ags_config_get_value(config,
+						  AGS_CONFIG_THREAD,
+						  "timing-monitor-file");
+  timing_monitor->signal_source_id = 0;
+
+  /* enable */
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_THREAD,
+			     "timing-monitor");
+
+  if(str != NULL &&
+     !g_ascii_strncasecmp(str,
+			  "true",
+			  5)){
+    ags_timing_monitor_set_enabled(TRUE);
+  }
+
+  g_free(str);
+}
+
+void
+ags_timing_monitor_finalize(GObject *gobject)
+{
+  AgsTimingMonitor *timing_monitor;
+
+  timing_monitor = AGS_TIMING_MONITOR(gobject);
+
+  if(timing_monitor->signal_source_id != 0){
+    g_source_remove(timing_monitor->signal_source_id);
+  }
+
+  g_free(timing_monitor->filename);
+  
+  free(timing_monitor->histogram);
+
+  if(timing_monitor == ags_timing_monitor){
+    ags_timing_monitor = NULL;
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_timing_monitor_parent_class)->finalize(gobject);
+}
+
+/**
+ * ags_timing_histogram_alloc:
+ * @object: the object
+ * @stage: the #AgsTimingMonitorStage
+ * @name: the name
+ *
+ * Allocate #AgsTimingHistogram-struct.
+ *
+ * Returns: the newly allocated #AgsTimingHistogram-struct
+ *
+ * Since: 3.5.0
+ */
+AgsTimingHistogram*
+ags_timing_histogram_alloc(gpointer object,
+			   guint stage,
+			   gchar *name)
+{
+  AgsTimingHistogram *timing_histogram;
+
+  timing_histogram = (AgsTimingHistogram *) malloc(sizeof(AgsTimingHistogram));
+
+  timing_histogram->state = AGS_TIMING_HISTOGRAM_READY;
+
+  timing_histogram->object = object;
+  timing_histogram->stage = stage;
+
+  g_strlcpy(timing_histogram->name,
+	    ((name != NULL) ? name: ""),
+	    AGS_TIMING_HISTOGRAM_NAME_LENGTH);
+
+  ags_timing_histogram_reset(timing_histogram);
+
+  return(timing_histogram);
+}
+
+/**
+ * ags_timing_histogram_free:
+ * @timing_histogram: the #AgsTimingHistogram-struct
+ *
+ * Free @timing_histogram.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_timing_histogram_free(AgsTimingHistogram *timing_histogram)
+{
+  if(timing_histogram == NULL){
+    return;
+  }
+
+  free(timing_histogram);
+}
+
+guint
+ags_timing_monitor_slot_hash(gpointer object,
+			     guint stage)
+{
+  return((31 * g_direct_hash(object)) ^ stage);
+}
+
+/**
+ * ags_timing_histogram_bucket_index:
+ * @value: the value
+ *
+ * Get the bucket index of @value. Values below the sub bucket count map
+ * to their own bucket, above every power of 2 is split into
+ * %AGS_TIMING_HISTOGRAM_SUB_BUCKETS linear buckets.
+ *
+ * Returns: the bucket index
+ *
+ * Since: 3.5.0
+ */
+guint
+ags_timing_histogram_bucket_index(guint64 value)
+{
+  guint magnitude;
+  guint bucket_index;
+  
+  if(value < AGS_TIMING_HISTOGRAM_SUB_BUCKETS){
+    return((guint) value);
+  }
+
+  if(value > G_MAXUINT32){
+    value = G_MAXUINT32;
+  }
+
+  magnitude = g_bit_storage((gulong) value) - 1;
+
+  bucket_index = (magnitude - AGS_TIMING_HISTOGRAM_SUB_BUCKET_BITS + 1) * AGS_TIMING_HISTOGRAM_SUB_BUCKETS;
+  bucket_index += (guint) ((value >> (magnitude - AGS_TIMING_HISTOGRAM_SUB_BUCKET_BITS)) & (AGS_TIMING_HISTOGRAM_SUB_BUCKETS - 1));
+  
+  return(bucket_index);
+}
+
+/**
+ * ags_timing_histogram_bucket_value:
+ * @bucket_index: the bucket index
+ *
+ * Get the lowest value counted by @bucket_index.
+ *
+ * Returns: the value
+ *
+ * Since: 3.5.0
+ */
+guint64
+ags_timing_histogram_bucket_value(guint bucket_index)
+{
+  guint magnitude;
+  guint sub_bucket;
+  
+  if(bucket_index < AGS_TIMING_HISTOGRAM_SUB_BUCKETS){
+    return((guint64) bucket_index);
+  }
+
+  magnitude = (bucket_index / AGS_TIMING_HISTOGRAM_SUB_BUCKETS) + AGS_TIMING_HISTOGRAM_SUB_BUCKET_BITS - 1;
+  sub_bucket = bucket_index % AGS_TIMING_HISTOGRAM_SUB_BUCKETS;
+
+  return(((guint64) (AGS_TIMING_HISTOGRAM_SUB_BUCKETS + sub_bucket)) << (magnitude - AGS_TIMING_HISTOGRAM_SUB_BUCKET_BITS));
+}
+
+/**
+ * ags_timing_histogram_add:
+ * @timing_histogram: the #AgsTimingHistogram-struct
+ * @value: the duration in nanoseconds
+ *
+ * Add @value to @timing_histogram, lock-free.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_timing_histogram_add(AgsTimingHistogram *timing_histogram,
+			 guint64 value)
+{
+  guint clamped;
+  guint previous_low;
+  guint current;
+  
+  if(timing_histogram == NULL){
+    return;
+  }
+
+  clamped = (value > G_MAXUINT32) ? G_MAXUINT32: (guint) value;
+
+  g_atomic_int_inc(&(timing_histogram->bucket[ags_timing_histogram_bucket_index(value)]));
+
+  g_atomic_int_inc(&(timing_histogram->count));
+
+  /* 64 bit sum of two 32 bit words, the one overflowing the low word carries */
+  previous_low = (guint) g_atomic_int_add((volatile gint *) &(timing_histogram->sum_low),
+					  (gint) clamped);
+
+  if(previous_low + clamped < previous_low){
+    g_atomic_int_inc(&(timing_histogram->sum_high));
+  }
+
+  /* min and max */
+  current = g_atomic_int_get(&(timing_histogram->min));
+
+  while(clamped < current &&
+	!g_atomic_int_compare_and_exchange(&(timing_histogram->min), current, clamped)){
+    current = g_atomic_int_get(&(timing_histogram->min));
+  }
+
+  current = g_atomic_int_get(&(timing_histogram->max));
+
+  while(clamped > current &&
+	!g_atomic_int_compare_and_exchange(&(timing_histogram->max), current, clamped)){
+    current = g_atomic_int_get(&(timing_histogram->max));
+  }
+}
+
+/**
+ * ags_timing_histogram_get_sum:
+ * @timing_histogram: the #AgsTimingHistogram-struct
+ *
+ * Get the sum of all samples of @timing_histogram, it is 64 bit wide on
+ * every platform.
+ *
+ * Returns: the sum in nanoseconds
+ *
+ * Since: 3.5.0
+ */
+guint64
+ags_timing_histogram_get_sum(AgsTimingHistogram *timing_histogram)
+{
+  guint sum_low;
+  guint sum_high, current_high;
+
+  if(timing_histogram == NULL){
+    return(0);
+  }
+
+  current_high = g_atomic_int_get(&(timing_histogram->sum_high));
+
+  do{
+    sum_high = current_high;
+    sum_low = g_atomic_int_get(&(timing_histogram->sum_low));
+
+    current_high = g_atomic_int_get(&(timing_histogram->sum_high));
+  }while(current_high != sum_high);
+
+  return((((guint64) sum_high) << 32) | (guint64) sum_low);
+}
+
+/**
+ * ags_timing_histogram_percentile:
+ * @timing_histogram: the #AgsTimingHistogram-struct
+ * @percentile: the percentile from 0.0 to 100.0
+ *
+ * Get the value at @percentile, it is the lowest value of the bucket
+ * containing it.
+ *
+ * Returns: the value in nanoseconds
+ *
+ * Since: 3.5.0
+ */
+guint64
+ags_timing_histogram_percentile(AgsTimingHistogram *timing_histogram,
+				gdouble percentile)
+{
+  guint64 count, threshold, current;
+  guint i;
+  
+  if(timing_histogram == NULL){
+    return(0);
+  }
+
+  count = g_atomic_int_get(&(timing_histogram->count));
+
+  if(count == 0){
+    return(0);
+  }
+
+  threshold = (guint64) ceil((percentile / 100.0) * (gdouble) count);
+
+  if(threshold == 0){
+    threshold = 1;
+  }
+  
+  current = 0;
+  
+  for(i = 0; i < AGS_TIMING_HISTOGRAM_BUCKETS; i++){
+    current += g_atomic_int_get(&(timing_histogram->bucket[i]));
+
+    if(current >= threshold){
+      return(ags_timing_histogram_bucket_value(i));
+    }
+  }
+
+  return(g_atomic_int_get(&(timing_histogram->max)));
+}
+
+/**
+ * ags_timing_histogram_reset:
+ * @timing_histogram: the #AgsTimingHistogram-struct
+ *
+ * Reset all samples of @timing_histogram.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_timing_histogram_reset(AgsTimingHistogram *timing_histogram)
+{
+  guint i;
+  
+  if(timing_histogram == NULL){
+    return;
+  }
+
+  g_atomic_int_set(&(timing_histogram->count),
+		   0);
+
+  g_atomic_int_set(&(timing_histogram->sum_low),
+		   0);
+  g_atomic_int_set(&(timing_histogram->sum_high),
+		   0);
+
+  g_atomic_int_set(&(timing_histogram->min),
+		   G_MAXUINT32);
+  g_atomic_int_set(&(timing_histogram->max),
+		   0);
+
+  for(i = 0; i < AGS_TIMING_HISTOGRAM_BUCKETS; i++){
+    g_atomic_int_set(&(timing_histogram->bucket[i]),
+		     0);
+  }
+}
+
+/**
+ * ags_timing_monitor_is_enabled:
+ *
+ * Check if timing is recorded.
+ *
+ * Returns: %TRUE if enabled, otherwise %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_timing_monitor_is_enabled()
+{
+  return(g_atomic_int_get(&ags_timing_monitor_enabled));
+}
+
+/**
+ * ags_timing_monitor_set_enabled:
+ * @enabled: %TRUE to record timing
+ *
+ * Switch timing recording on or off.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_timing_monitor_set_enabled(gboolean enabled)
+{
+  g_atomic_int_set(&ags_timing_monitor_enabled,
+		   enabled);
+}
+
+/**
+ * ags_timing_monitor_get_time:
+ *
+ * Get monotonic time in nanoseconds.
+ *
+ * Returns: the time
+ *
+ * Since: 3.5.0
+ */
+gint64
+ags_timing_monitor_get_time()
+{
+#if defined(__APPLE__) || defined(AGS_W32API)
+  return(g_get_monotonic_time() * 1000);
+#else
+  struct timespec time_now;
+  
+  clock_gettime(CLOCK_MONOTONIC, &time_now);
+
+  return(((gint64) time_now.tv_sec * AGS_TIMING_MONITOR_NSEC_PER_SEC) + (gint64) time_now.tv_nsec);
+#endif
+}
+
+/**
+ * ags_timing_monitor_start:
+ *
+ * Start measuring, pass the return value to ags_timing_monitor_stop().
+ *
+ * Returns: the start time or 0 if not enabled
+ *
+ * Since: 3.5.0
+ */
+gint64
+ags_timing_monitor_start()
+{
+  if(!g_atomic_int_get(&ags_timing_monitor_enabled)){
+    return(0);
+  }
+
+  return(ags_timing_monitor_get_time());
+}
+
+/**
+ * ags_timing_monitor_stop:
+ * @object: the measured object
+ * @stage: the #AgsTimingMonitorStage
+ * @start_time: the return value of ags_timing_monitor_start()
+ *
+ * Stop measuring and record the duration of @stage of @object.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_timing_monitor_stop(gpointer object,
+			guint stage,
+			gint64 start_time)
+{
+  AgsTimingMonitor *timing_monitor;
+
+  gint64 end_time;
+  
+  if(start_time == 0){
+    return;
+  }
+
+  end_time = ags_timing_monitor_get_time();
+
+  timing_monitor = g_atomic_pointer_get(&ags_timing_monitor);
+
+  if(timing_monitor == NULL){
+    timing_monitor = ags_timing_monitor_get_instance();
+  }
+  
+  ags_timing_monitor_record(timing_monitor,
+			    object,
+			    stage,
+			    (end_time > start_time) ? (guint64) (end_time - start_time): 0);
+}
+
+/**
+ * ags_timing_monitor_find_histogram:
+ * @timing_monitor: the #AgsTimingMonitor
+ * @object: the object
+ * @stage: the #AgsTimingMonitorStage
+ *
+ * Find the histogram of @stage of @object, lock-free.
+ *
+ * Returns: (transfer none): the #AgsTimingHistogram-struct or %NULL
+ *
+ * Since: 3.5.0
+ */
+AgsTimingHistogram*
+ags_timing_monitor_find_histogram(AgsTimingMonitor *timing_monitor,
+				  gpointer object,
+				  guint stage)
+{
+  AgsTimingHistogram *timing_histogram;
+
+  guint start;
+  guint i;
+  
+  if(!AGS_IS_TIMING_MONITOR(timing_monitor)){
+    return(NULL);
+  }
+
+  start = ags_timing_monitor_slot_hash(object,
+				       stage) % timing_monitor->allocated_histograms;
+
+  for(i = 0; i < timing_monitor->allocated_histograms; i++){
+    gint state;
+    
+    timing_histogram = &(timing_monitor->histogram[(start + i) % timing_monitor->allocated_histograms]);
+
+    state = g_atomic_int_get(&(timing_histogram->state));
+
+    if(state == AGS_TIMING_HISTOGRAM_FREE){
+      break;
+    }
+
+    if(state == AGS_TIMING_HISTOGRAM_READY &&
+       timing_histogram->object == object &&
+       timing_histogram->stage == stage){
+      return(timing_histogram);
+    }
+  }
+
+  return(NULL);
+}
+
+AgsTimingHistogram*
+ags_timing_monitor_claim_histogram(AgsTimingMonitor *timing_monitor,
+				   gpointer object,
+				   guint stage)
+{
+  AgsTimingHistogram *timing_histogram;
+
+  guint start;
+  guint n_histograms;
+  guint i;
+
+  start = ags_timing_monitor_slot_hash(object,
+				       stage) % timing_monitor->allocated_histograms;
+
+  for(i = 0; i < timing_monitor->allocated_histograms; i++){
+    gint state;
+    
+    timing_histogram = &(timing_monitor->histogram[(start + i) % timing_monitor->allocated_histograms]);
+
+    state = g_atomic_int_get(&(timing_histogram->state));
+
+    /* wait for a concurrent claim, it doesn't block */
+    while(state == AGS_TIMING_HISTOGRAM_CLAIMED){
+      state = g_atomic_int_get(&(timing_histogram->state));
+    }
+
+    if(state == AGS_TIMING_HISTOGRAM_READY){
+      if(timing_histogram->object == object &&
+	 timing_histogram->stage == stage){
+	return(timing_histogram);
+      }
+
+      continue;
+    }
+
+    /* reserve a histogram of the maximum count */
+    do{
+      n_histograms = g_atomic_int_get(&(timing_monitor->n_histograms));
+
+      if(n_histograms >= timing_monitor->max_histograms){
+	return(NULL);
+      }
+    }while(!g_atomic_int_compare_and_exchange(&(timing_monitor->n_histograms), n_histograms, n_histograms + 1));
+
+    if(!g_atomic_int_compare_and_exchange(&(timing_histogram->state), state, AGS_TIMING_HISTOGRAM_CLAIMED)){
+      g_atomic_int_add(&(timing_monitor->n_histograms), -1);
+
+      /* examine the slot again */
+      i--;
+      
+      continue;
+    }
+
+    timing_histogram->object = object;
+    timing_histogram->stage = stage;
+
+    if(G_IS_OBJECT(object)){
+      g_snprintf(timing_histogram->name, AGS_TIMING_HISTOGRAM_NAME_LENGTH,
+		 "%s@%p %s",
+		 G_OBJECT_TYPE_NAME(object),
+		 object,
+		 ags_timing_monitor_stage_name[stage]);
+    }else{
+      g_snprintf(timing_histogram->name, AGS_TIMING_HISTOGRAM_NAME_LENGTH,
+		 "%p %s",
+		 object,
+		 ags_timing_monitor_stage_name[stage]);
+    }
+
+    ags_timing_histogram_reset(timing_histogram);
+
+    g_atomic_int_set(&(timing_histogram->state),
+		     AGS_TIMING_HISTOGRAM_READY);
+    
+    return(timing_histogram);
+  }
+
+  return(NULL);
+}
+
+/**
+ * ags_timing_monitor_record:
+ * @timing_monitor: the #AgsTimingMonitor
+ * @object: the object
+ * @stage: the #AgsTimingMonitorStage
+ * @duration: the duration in nanoseconds
+ *
+ * Record @duration of @stage of @object. A slot is claimed the first
+ * time, unless the maximum count of histograms is reached. Neither locks
+ * nor allocates.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_timing_monitor_record(AgsTimingMonitor *timing_monitor,
+			  gpointer object,
+			  guint stage,
+			  guint64 duration)
+{
+  AgsTimingHistogram *timing_histogram;
+  
+  if(!AGS_IS_TIMING_MONITOR(timing_monitor) ||
+     stage >= AGS_TIMING_MONITOR_LAST_STAGE){
+    return;
+  }
+
+  timing_histogram = ags_timing_monitor_find_histogram(timing_monitor,
+						       object,
+						       stage);
+
+  if(timing_histogram == NULL){
+    timing_histogram = ags_timing_monitor_claim_histogram(timing_monitor,
+							  object,
+							  stage);
+  }
+
+  ags_timing_histogram_add(timing_histogram,
+			   duration);
+}
+
+/**
+ * ags_timing_monitor_remove:
+ * @timing_monitor: the #AgsTimingMonitor
+ * @object: the object
+ *
+ * Release the histograms of all stages of @object, call it as @object is
+ * disposed. The slots are claimed again by other objects.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_timing_monitor_remove(AgsTimingMonitor *timing_monitor,
+			  gpointer object)
+{
+  AgsTimingHistogram *timing_histogram;
+
+  guint stage;
+  
+  if(!AGS_IS_TIMING_MONITOR(timing_monitor) ||
+     g_atomic_int_get(&(timing_monitor->n_histograms)) == 0){
+    return;
+  }
+
+  for(stage = 0; stage < AGS_TIMING_MONITOR_LAST_STAGE; stage++){
+    timing_histogram = ags_timing_monitor_find_histogram(timing_monitor,
+							 object,
+							 stage);
+
+    if(timing_histogram != NULL &&
+       g_atomic_int_compare_and_exchange(&(timing_histogram->state), AGS_TIMING_HISTOGRAM_READY, AGS_TIMING_HISTOGRAM_CLAIMED)){
+      timing_histogram->object = NULL;
+      
+      g_atomic_int_set(&(timing_histogram->state),
+		       AGS_TIMING_HISTOGRAM_REMOVED);
+
+      g_atomic_int_add(&(timing_monitor->n_histograms), -1);
+    }
+  }
+}
+
+/**
+ * ags_timing_monitor_reset:
+ * @timing_monitor: the #AgsTimingMonitor
+ *
+ * Reset the samples of all histograms, the histograms are kept.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_timing_monitor_reset(AgsTimingMonitor *timing_monitor)
+{
+  guint i;
+  
+  if(!AGS_IS_TIMING_MONITOR(timing_monitor)){
+    return;
+  }
+
+  for(i = 0; i < timing_monitor->allocated_histograms; i++){
+    if(g_atomic_int_get(&(timing_monitor->histogram[i].state)) == AGS_TIMING_HISTOGRAM_READY){
+      ags_timing_histogram_reset(&(timing_monitor->histogram[i]));
+    }
+  }
+}
+
+/**
+ * ags_timing_monitor_get_summary:
+ * @timing_monitor: the #AgsTimingMonitor
+ *
+ * Get one line per histogram containing name, count, minimum, mean,
+ * 50th, 90th, 99th, 99.9th percentile and maximum in microseconds.
+ * Histograms without samples are skipped.
+ *
+ * Returns: (transfer full): the %NULL terminated string vector
+ *
+ * Since: 3.5.0
+ */
+gchar**
+ags_timing_monitor_get_summary(AgsTimingMonitor *timing_monitor)
+{
+  gchar **summary;
+
+  guint i, j;
+  
+  if(!AGS_IS_TIMING_MONITOR(timing_monitor)){
+    return(NULL);
+  }
+
+  summary = (gchar **) g_malloc((timing_monitor->allocated_histograms + 1) * sizeof(gchar *));
+  
+  for(i = 0, j = 0; i < timing_monitor->allocated_histograms; i++){
+    AgsTimingHistogram *timing_histogram;
+
+    guint count;
+    
+    timing_histogram = &(timing_monitor->histogram[i]);
+
+    if(g_atomic_int_get(&(timing_histogram->state)) != AGS_TIMING_HISTOGRAM_READY){
+      continue;
+    }
+    
+    count = g_atomic_int_get(&(timing_histogram->count));
+
+    if(count == 0){
+      continue;
+    }
+    
+    summary[j] = g_strdup_printf("%s\t%u\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f\t%.3f",
+				 timing_histogram->name,
+				 count,
+				 (gdouble) g_atomic_int_get(&(timing_histogram->min)) / 1000.0,
+				 ((gdouble) ags_timing_histogram_get_sum(timing_histogram) / (gdouble) count) / 1000.0,
+				 (gdouble) ags_timing_histogram_percentile(timing_histogram, 50.0) / 1000.0,
+				 (gdouble) ags_timing_histogram_percentile(timing_histogram, 90.0) / 1000.0,
+				 (gdouble) ags_timing_histogram_percentile(timing_histogram, 99.0) / 1000.0,
+				 (gdouble) ags_timing_histogram_percentile(timing_histogram, 99.9) / 1000.0,
+				 (gdouble) g_atomic_int_get(&(timing_histogram->max)) / 1000.0);
+    j++;
+  }
+
+  summary[j] = NULL;
+  
+  return(summary);
+}
+
+/**
+ * ags_timing_monitor_dump:
+ * @timing_monitor: the #AgsTimingMonitor
+ * @filename: the filename
+ *
+ * Write the summary of all histograms to @filename.
+ *
+ * Returns: %TRUE on success, otherwise %FALSE
+ *
+ * Since: 3.5.0
+ */
+gboolean
+ags_timing_monitor_dump(AgsTimingMonitor *timing_monitor,
+			gchar *filename)
+{
+  FILE *file;
+  
+  gchar **summary, **iter;
+  
+  if(!AGS_IS_TIMING_MONITOR(timing_monitor) ||
+     filename == NULL){
+    return(FALSE);
+  }
+
+  file = fopen(filename, "w");
+
+  if(file == NULL){
+    g_warning("failed to open %s", filename);
+    
+    return(FALSE);
+  }
+
+  summary = ags_timing_monitor_get_summary(timing_monitor);
+  
+  fprintf(file, "# name\tcount\tmin\tmean\tp50\tp90\tp99\tp99.9\tmax [usec]\n");
+
+  for(iter = summary; iter != NULL && iter[0] != NULL; iter++){
+    fprintf(file, "%s\n", iter[0]);
+  }
+
+  fclose(file);
+
+  g_strfreev(summary);
+  
+  return(TRUE);
+}
+
+gboolean
+ags_timing_monitor_signal_func(gpointer data)
+{
+  AgsTimingMonitor *timing_monitor;
+
+  gchar *filename;
+
+  GRecMutex *timing_monitor_mutex;
+  
+  timing_monitor = AGS_TIMING_MONITOR(data);
+  
+  timing_monitor_mutex = AGS_TIMING_MONITOR_GET_OBJ_MUTEX(timing_monitor);
+
+  g_rec_mutex_lock(timing_monitor_mutex);
+
+  filename = g_strdup(timing_monitor->filename);
+  
+  g_rec_mutex_unlock(timing_monitor_mutex);
+
+  ags_timing_monitor_dump(timing_monitor,
+			  filename);
+
+  g_free(filename);
+  
+  return(G_SOURCE_CONTINUE);
+}
+
+/**
+ * ags_timing_monitor_dump_on_signal:
+ * @timing_monitor: the #AgsTimingMonitor
+ * @signum: the signal number, e.g. SIGUSR2
+ * @filename: the filename or %NULL to keep the configured one
+ *
+ * Dump to @filename whenever @signum is received. The dump is done by the
+ * default main context, not within the signal handler.
+ *
+ * Since: 3.5.0
+ */
+void
+ags_timing_monitor_dump_on_signal(AgsTimingMonitor *timing_monitor,
+				  gint signum,
+				  gchar *filename)
+{
+  GRecMutex *timing_monitor_mutex;
+  
+  if(!AGS_IS_TIMING_MONITOR(timing_monitor)){
+    return;
+  }
+  
+  timing_monitor_mutex = AGS_TIMING_MONITOR_GET_OBJ_MUTEX(timing_monitor);
+
+  g_rec_mutex_lock(timing_monitor_mutex);
+
+  if(filename != NULL){
+    g_free(timing_monitor->filename);
+    
+    timing_monitor->filename = g_strdup(filename);
+  }else if(timing_monitor->filename == NULL){
+    timing_monitor->filename = g_build_filename(g_get_tmp_dir(),
+						AGS_TIMING_MONITOR_DEFAULT_FILENAME,
+						NULL);
+  }
+
+#ifndef AGS_W32API
+  if(timing_monitor->signal_source_id != 0){
+    g_source_remove(timing_monitor->signal_source_id);
+  }
+  
+  timing_monitor->signal_source_id = g_unix_signal_add(signum,
+						       ags_timing_monitor_signal_func,
+						       timing_monitor);
+#endif
+  
+  g_rec_mutex_unlock(timing_monitor_mutex);
+}
+
+/**
+ * ags_timing_monitor_get_instance:
+ *
+ * Get instance.
+ *
+ * Returns: (transfer none): the #AgsTimingMonitor
+ *
+ * Since: 3.5.0
+ */
+AgsTimingMonitor*
+ags_timing_monitor_get_instance()
+{
+  static GMutex mutex;
+
+  g_mutex_lock(&mutex);
+
+  if(ags_timing_monitor == NULL){
+    ags_timing_monitor = ags_timing_monitor_new();
+  }
+
+  g_mutex_unlock(&mutex);
+
+  return(ags_timing_monitor);
+}
+
+/**
+ * ags_timing_monitor_new:
+ *
+ * Create a new instance of #AgsTimingMonitor
+ *
+ * Returns: the new #AgsTimingMonitor
+ *
+ * Since: 3.5.0
+ */
+AgsTimingMonitor*
+ags_timing_monitor_new()
+{
+  AgsTimingMonitor *timing_monitor;
+
+  timing_monitor = (AgsTimingMonitor *) g_object_new(AGS_TYPE_TIMING_MONITOR,
+						     NULL);
+
+  return(timing_monitor);
+}
@@ -0,0 +1,197 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_TIMING_MONITOR_H__
+#define __AGS_TIMING_MONITOR_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_TIMING_MONITOR                (ags_timing_monitor_get_type())
+#define AGS_TIMING_MONITOR(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_TIMING_MONITOR, AgsTimingMonitor))
+#define AGS_TIMING_MONITOR_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_TIMING_MONITOR, AgsTimingMonitorClass))
+#define AGS_IS_TIMING_MONITOR(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_TIMING_MONITOR))
+#define AGS_IS_TIMING_MONITOR_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_TIMING_MONITOR))
+#define AGS_TIMING_MONITOR_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_TIMING_MONITOR, AgsTimingMonitorClass))
+
+#define AGS_TIMING_MONITOR_GET_OBJ_MUTEX(obj) (&(((AgsTimingMonitor *) obj)->obj_mutex))
+
+#define AGS_TIMING_HISTOGRAM(ptr) ((AgsTimingHistogram *)(ptr))
+
+#define AGS_TIMING_HISTOGRAM_SUB_BUCKET_BITS (3)
+#define AGS_TIMING_HISTOGRAM_SUB_BUCKETS (1 << AGS_TIMING_HISTOGRAM_SUB_BUCKET_BITS)
+#define AGS_TIMING_HISTOGRAM_BUCKETS ((32 - AGS_TIMING_HISTOGRAM_SUB_BUCKET_BITS + 1) * AGS_TIMING_HISTOGRAM_SUB_BUCKETS)
+
+#define AGS_TIMING_HISTOGRAM_NAME_LENGTH (96)
+
+#define AGS_TIMING_MONITOR_DEFAULT_MAX_HISTOGRAMS (4096)
+
+#define AGS_TIMING_MONITOR_NSEC_PER_SEC (1000000000)
+#define AGS_TIMING_MONITOR_DEFAULT_FILENAME "gsequencer-timing.txt"
+
+typedef struct _AgsTimingMonitor AgsTimingMonitor;
+typedef struct _AgsTimingMonitorClass AgsTimingMonitorClass;
+typedef struct _AgsTimingHistogram AgsTimingHistogram;
+
+/**
+ * AgsTimingMonitorStage:
+ * @AGS_TIMING_MONITOR_RECALL_RUN_PRE: recall run-pre stage
+ * @AGS_TIMING_MONITOR_RECALL_RUN_INTER: recall run-inter stage
+ * @AGS_TIMING_MONITOR_RECALL_RUN_POST: recall run-post stage
+ * @AGS_TIMING_MONITOR_THREAD_RUN: thread run
+ * @AGS_TIMING_MONITOR_LAST_STAGE: the count of stages
+ *
+ * Enum values of the measured stages.
+ */
+typedef enum{
+  AGS_TIMING_MONITOR_RECALL_RUN_PRE,
+  AGS_TIMING_MONITOR_RECALL_RUN_INTER,
+  AGS_TIMING_MONITOR_RECALL_RUN_POST,
+  AGS_TIMING_MONITOR_THREAD_RUN,
+  AGS_TIMING_MONITOR_LAST_STAGE,
+}AgsTimingMonitorStage;
+
+/**
+ * AgsTimingHistogramState:
+ * @AGS_TIMING_HISTOGRAM_FREE: the slot was never used
+ * @AGS_TIMING_HISTOGRAM_CLAIMED: the slot is being set up or removed
+ * @AGS_TIMING_HISTOGRAM_READY: the slot records samples
+ * @AGS_TIMING_HISTOGRAM_REMOVED: the slot was removed and can be claimed again
+ *
+ * Enum values of the slot state of #AgsTimingHistogram.
+ */
+typedef enum{
+  AGS_TIMING_HISTOGRAM_FREE,
+  AGS_TIMING_HISTOGRAM_CLAIMED,
+  AGS_TIMING_HISTOGRAM_READY,
+  AGS_TIMING_HISTOGRAM_REMOVED,
+}AgsTimingHistogramState;
+
+/**
+ * AgsTimingHistogram:
+ * @state: the #AgsTimingHistogramState of the slot
+ * @object: the measured object, used as key only
+ * @stage: the #AgsTimingMonitorStage
+ * @name: the name of object and stage
+ * @count: the count of samples
+ * @sum_low: the low 32 bits of the sum of samples in nanoseconds
+ * @sum_high: the high 32 bits of the sum of samples in nanoseconds
+ * @min: the minimum sample in nanoseconds
+ * @max: the maximum sample in nanoseconds
+ * @bucket: the log-linear buckets
+ *
+ * #AgsTimingHistogram records the durations of one stage of one object.
+ */
+struct _AgsTimingHistogram
+{
+  volatile gint state;
+
+  gpointer object;
+  guint stage;
+
+  gchar name[AGS_TIMING_HISTOGRAM_NAME_LENGTH];
+
+  volatile guint count;
+
+  volatile guint sum_low;
+  volatile guint sum_high;
+
+  volatile guint min;
+  volatile guint max;
+
+  volatile guint bucket[AGS_TIMING_HISTOGRAM_BUCKETS];
+};
+
+struct _AgsTimingMonitor
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  AgsTimingHistogram *histogram;
+  guint allocated_histograms;
+
+  volatile guint n_histograms;
+  guint max_histograms;
+
+  gchar *filename;
+  guint signal_source_id;
+};
+
+struct _AgsTimingMonitorClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_timing_monitor_get_type(void);
+
+AgsTimingHistogram* ags_timing_histogram_alloc(gpointer object,
+					       guint stage,
+					       gchar *name);
+void ags_timing_histogram_free(AgsTimingHistogram *timing_histogram);
+
+guint ags_timing_histogram_bucket_index(guint64 value);
+guint64 ags_timing_histogram_bucket_value(guint bucket_index);
+
+void ags_timing_histogram_add(AgsTimingHistogram *timing_histogram,
+			      guint64 value);
+guint64 ags_timing_histogram_get_sum(AgsTimingHistogram *timing_histogram);
+guint64 ags_timing_histogram_percentile(AgsTimingHistogram *timing_histogram,
+					gdouble percentile);
+void ags_timing_histogram_reset(AgsTimingHistogram *timing_histogram);
+
+gboolean ags_timing_monitor_is_enabled();
+void ags_timing_monitor_set_enabled(gboolean enabled);
+
+gint64 ags_timing_monitor_get_time();
+
+gint64 ags_timing_monitor_start();
+void ags_timing_monitor_stop(gpointer object,
+			     guint stage,
+			     gint64 start_time);
+
+AgsTimingHistogram* ags_timing_monitor_find_histogram(AgsTimingMonitor *timing_monitor,
+						      gpointer object,
+						      guint stage);
+void ags_timing_monitor_record(AgsTimingMonitor *timing_monitor,
+			       gpointer object,
+			       guint stage,
+			       guint64 duration);
+void ags_timing_monitor_remove(AgsTimingMonitor *timing_monitor,
+			       gpointer object);
+
+void ags_timing_monitor_reset(AgsTimingMonitor *timing_monitor);
+
+gchar** ags_timing_monitor_get_summary(AgsTimingMonitor *timing_monitor);
+gboolean ags_timing_monitor_dump(AgsTimingMonitor *timing_monitor,
+				 gchar *filename);
+void ags_timing_monitor_dump_on_signal(AgsTimingMonitor *timing_monitor,
+				       gint signum,
+				       gchar *filename);
+
+AgsTimingMonitor* ags_timing_monitor_get_instance();
+AgsTimingMonitor* ags_timing_monitor_new();
+
+G_END_DECLS
+
+#endif /*__AGS_TIMING_MONITOR_H__*/